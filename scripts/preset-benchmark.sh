@@ -0,0 +1,73 @@
+#!/usr/bin/bash
+
+# Measures the latency and accuracy of each preset of the pipeline, on the circuits of the docs/results folder.
+# The accuracy is the number of components, connections and nodes detected, compared with the segmentation map of
+# reference of each circuit. The results are printed as a Markdown table (see docs/presets.md).
+# This script considers that the project was already compiled (preferably in Release).
+#
+# Usage:
+# ./<script>.sh <executable> <results_folder> [runs]
+#
+# Example:
+# ./<script>.sh build/src/CircuitSegmentation docs/results 10
+
+# Check script usage
+if [ "$#" -lt 2 ] || [ "$#" -gt 3 ]; then
+    echo "Usage:"
+    echo "$0 <executable> <results_folder> [runs]"
+    echo
+    exit -1
+fi
+
+# Executable
+executable=$(realpath $1)
+# Results folder, with the circuits
+results_folder=$(realpath $2)
+# Runs of each circuit, for each preset
+runs=${3:-10}
+# Working folder, where the output files are written
+work_folder=$(mktemp -d)
+
+echo "| Preset | Circuit | Mean latency (ms) | Components | Connections | Nodes |"
+echo "| --- | --- | --- | --- | --- | --- |"
+
+for preset in fast balanced accurate; do
+    for circuit_folder in $results_folder/circuit-*; do
+        circuit=$(basename $circuit_folder)
+        image=$circuit_folder/assets/cs_initial_image.png
+        reference=$circuit_folder/assets/segmentation_map.json
+
+        # Latency, from the start to the end of the process (one run to warm up the caches first)
+        cd $work_folder
+        $executable -P $preset -i $image > /dev/null
+        start=$(date +%s%N)
+        for ((run = 0; run < runs; run++)); do
+            $executable -P $preset -i $image > /dev/null
+        done
+        end=$(date +%s%N)
+        latency=$(( (end - start) / runs / 1000000 ))
+
+        # Elements detected / elements of reference
+        counts=$(python3 - $work_folder/segmentation_map.json $reference << 'EOF'
+import json
+import sys
+
+try:
+    with open(sys.argv[1]) as file:
+        detected = json.load(file)
+except (OSError, ValueError):
+    detected = {}
+with open(sys.argv[2]) as file:
+    reference = json.load(file)
+
+print(" | ".join(f"{len(detected.get(key, []))}/{len(reference[key])}"
+                 for key in ("components", "connections", "nodes")))
+EOF
+)
+        rm -f $work_folder/*
+
+        echo "| $preset | $circuit | $latency | $counts |"
+    done
+done
+
+rm -rf $work_folder
@@ -4,17 +4,36 @@
 
 #include "Application.h"
 #include "CommandLineParser.h"
+#include "Daemon.h"
+#include "FolderWatcher.h"
+#include "SharedMemoryIntake.h"
+#include "common/ThreadBudget.h"
+#include "computerVision/OpenCvWrapper.h"
 #include "imageProcessing/ImageProcManager.h"
+#include "imageProcessing/ImageReceiver.h"
+#include "imageProcessing/ParameterSweep.h"
 #include "logging/Logger.h"
+#include "output/ImageWriter.h"
+#include <csignal>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 namespace circuitSegmentation {
 namespace application {
 
 int Application::exec(int& argc, char const* argv[])
 {
-    std::shared_ptr<logging::Logger> logger{std::make_shared<logging::Logger>(std::cout)};
+    std::shared_ptr<logging::Logger> logger{std::make_shared<logging::Logger>(
+        std::cout, logging::Logger::cLogLevelDefault, logging::Logger::LogMode::ASYNCHRONOUS)};
     std::unique_ptr<CommandLineParser> parser{std::make_unique<CommandLineParser>()};
 
     parser->parse(argc, argv);
@@ -37,6 +56,89 @@ int Application::exec(int& argc, char const* argv[])
         logger->setLogLevel(logging::Logger::LogLevel::NONE);
     }
 
+    // Budget of memory of the images processed concurrently, in bytes (daemon, watch and ring modes)
+    const auto memoryBudget{static_cast<std::size_t>(parser->getMemoryBudget()) * 1024 * 1024};
+
+    // Result cache, shared by all processings
+    mResultCache = openResultCache(
+        parser->getCacheDirectory(), static_cast<std::size_t>(parser->getCacheSize()) * 1024 * 1024, logger);
+
+    // Near-duplicate index of the result cache, shared by all processings
+    if (parser->hasNearDuplicates()) {
+        mNearDuplicateIndex = openNearDuplicateIndex(mResultCache, parser->getCacheDirectory(), logger);
+    }
+
+    // Stage checkpoints, shared by all processings
+    mStageCheckpoints = openStageCheckpoints(parser->getCheckpointsDirectory(), logger);
+
+    // Deterministic IDs of the elements, in all processings
+    mDeterministicIds = parser->hasDeterministicIds();
+
+    // Size of the tiles of the images segmented by tiles, in all processings
+    mTileSize = static_cast<int>(parser->getTileSize());
+
+    // Height of the bands of the images preprocessed by bands, in all processings
+    mBandHeight = static_cast<int>(parser->getBandHeight());
+
+    // Budget of threads of the daemon, watch, ring and sweep modes: one worker for each core, each one with a warm
+    // image processing manager
+    const common::ThreadBudget batchThreadBudget{
+        common::ThreadBudget::RunMode::BATCH, parser->getNumJobs(), parser->hasPinThreads()};
+
+    // Daemon mode
+    const auto daemonSocketPath{parser->getDaemonSocketPath()};
+    if (!daemonSocketPath.empty()) {
+        return runWorkers<Daemon>("daemon",
+                                  daemonSocketPath,
+                                  mDaemon,
+                                  stopDaemon,
+                                  logger,
+                                  hasVerboseLogs,
+                                  batchThreadBudget,
+                                  parser->getPreset(),
+                                  memoryBudget)
+                   ? 0
+                   : 1;
+    }
+
+    // Watch mode
+    const auto watchDirectory{parser->getWatchDirectory()};
+    if (!watchDirectory.empty()) {
+        return runWorkers<FolderWatcher>("watcher",
+                                         watchDirectory,
+                                         mFolderWatcher,
+                                         stopFolderWatcher,
+                                         logger,
+                                         hasVerboseLogs,
+                                         batchThreadBudget,
+                                         parser->getPreset(),
+                                         memoryBudget)
+                   ? 0
+                   : 1;
+    }
+
+    // Shared-memory ring mode
+    const auto ringName{parser->getSharedMemoryRingName()};
+    if (!ringName.empty()) {
+        return runWorkers<SharedMemoryIntake>("shared-memory intake",
+                                              ringName,
+                                              mSharedMemoryIntake,
+                                              stopSharedMemoryIntake,
+                                              logger,
+                                              hasVerboseLogs,
+                                              batchThreadBudget,
+                                              parser->getPreset(),
+                                              memoryBudget)
+                   ? 0
+                   : 1;
+    }
+
+    // Parameter sweep mode
+    const auto sweepConfigPath{parser->getSweepConfigPath()};
+    if (!sweepConfigPath.empty()) {
+        return runParameterSweep(sweepConfigPath, logger, batchThreadBudget, parser->getPreset()) ? 0 : 1;
+    }
+
     // Image path
     const auto imagePath{parser->getImagePath()};
     if (imagePath.empty()) {
@@ -46,19 +148,256 @@ int Application::exec(int& argc, char const* argv[])
     // Save images obtained during the processing
     const auto hasSaveImages{parser->hasSaveImages()};
 
+    // Budget of threads (the number of threads for writing images is the default if the option was not passed)
+    const common::ThreadBudget threadBudget{
+        common::ThreadBudget::RunMode::SINGLE_IMAGE, parser->getNumJobs(), parser->hasPinThreads()};
+
     // Proceed with the application
-    logger->logInfo("Starting " + std::string(cAppName) + ": version " + std::string(cAppVersion));
+    logger->logInfo("Starting {}: version {}", cAppName, cAppVersion);
+    logThreadBudget(logger, threadBudget);
 
     // Image processing manager
-    auto imageProcManager{imageProcessing::ImageProcManager::create(logger, hasVerboseLogs, hasSaveImages)};
+    auto imageProcManager{
+        imageProcessing::ImageProcManager::create(logger, hasVerboseLogs, hasSaveImages, threadBudget)};
+    imageProcManager.setPreset(parser->getPreset());
+    imageProcManager.setResultCache(mResultCache);
+    imageProcManager.setStageCheckpoints(mStageCheckpoints);
+    imageProcManager.setDeterministicIds(mDeterministicIds);
+    imageProcManager.setNearDuplicateIndex(mNearDuplicateIndex);
+
+    // Segmentation by tiles, using all the cores for the tiles of the single application worker (the application
+    // worker itself is not pinned, since the threads of OpenCV, using all the cores, are created from it)
+    imageProcManager.setTileSize(mTileSize, threadBudget.getNumCores(), threadBudget.getWorkerPinning());
+    imageProcManager.setBandHeight(mBandHeight);
+
+    // Initialize processing, with the image from the standard input or from the file
+    if (parser->hasImageFromStandardInput()) {
+#ifdef _WIN32
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+        auto imageBuffer{readImageBuffer(std::cin)};
+        if (imageBuffer.empty()) {
+            logger->logError("No image read from the standard input");
+        } else {
+            imageProcManager.processImageBuffer(std::move(imageBuffer));
+        }
+    } else {
+        imageProcManager.processImagePages(imagePath);
+    }
 
-    // Initialize processing
-    imageProcManager.processImage(imagePath);
+    logResultCacheStatistics(logger);
 
-    logger->logInfo("Ending " + std::string(cAppName) + ": version " + std::string(cAppVersion));
+    logger->logInfo("Ending {}: version {}", cAppName, cAppVersion);
 
     return 0;
 }
 
+template<typename Workers>
+bool Application::runWorkers(const std::string& modeName,
+                             const std::string& source,
+                             std::atomic<Workers*>& runningWorkers,
+                             void (*stopHandler)(int),
+                             const std::shared_ptr<logging::Logger>& logger,
+                             const bool logMode,
+                             const common::ThreadBudget& threadBudget,
+                             const common::Preset preset,
+                             const std::size_t memoryBudget)
+{
+    logger->logInfo("Starting {} {}: version {}", cAppName, modeName, cAppVersion);
+    logThreadBudget(logger, threadBudget);
+    logger->logInfo("Memory budget: {} bytes", memoryBudget);
+
+    Workers workers{source,
+                    createImageProcManagers(logger, logMode, threadBudget, preset),
+                    logger,
+                    memoryBudget,
+                    threadBudget.getWorkerPinning()};
+
+    // Stop the workers on interruption or termination
+    runningWorkers = &workers;
+    std::signal(SIGINT, stopHandler);
+    std::signal(SIGTERM, stopHandler);
+
+    const auto success{workers.run()};
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    runningWorkers = nullptr;
+
+    logResultCacheStatistics(logger);
+    logger->logInfo("Ending {} {}: version {}", cAppName, modeName, cAppVersion);
+
+    return success;
+}
+
+bool Application::runParameterSweep(const std::string& configPath,
+                                    const std::shared_ptr<logging::Logger>& logger,
+                                    const common::ThreadBudget& threadBudget,
+                                    const common::Preset preset)
+{
+    logger->logInfo("Starting {} parameter sweep: version {}", cAppName, cAppVersion);
+    logThreadBudget(logger, threadBudget);
+
+    std::shared_ptr<computerVision::OpenCvWrapper> openCvWrapper{std::make_shared<computerVision::OpenCvWrapper>()};
+    openCvWrapper->setNumThreads(static_cast<int>(threadBudget.getNumOpenCvThreads()));
+    std::shared_ptr<output::ImageWriter> imageWriter{
+        std::make_shared<output::ImageWriter>(openCvWrapper, logger, threadBudget.getNumWriterThreads())};
+
+    // The stages of the combinations run in parallel, one for each core
+    imageProcessing::ParameterSweep parameterSweep{
+        std::make_shared<imageProcessing::ImageReceiver>(openCvWrapper, logger),
+        openCvWrapper,
+        imageWriter,
+        logger,
+        threadBudget.getNumAppWorkers(),
+        threadBudget.getWorkerPinning()};
+    if (!parameterSweep.loadConfig(configPath, preset)) {
+        logger->logError("Invalid parameter sweep configuration {}", configPath);
+        return false;
+    }
+
+    const auto success{parameterSweep.run()};
+
+    logger->logInfo("Ending {} parameter sweep: version {}", cAppName, cAppVersion);
+
+    return success;
+}
+
+void Application::logThreadBudget(const std::shared_ptr<logging::Logger>& logger,
+                                  const common::ThreadBudget& threadBudget)
+{
+    logger->logInfo("Thread budget: cores = {}, application workers = {}, OpenCV threads = {}, writer threads = {}, "
+                    "pinned = {}",
+                    threadBudget.getNumCores(),
+                    threadBudget.getNumAppWorkers(),
+                    threadBudget.getNumOpenCvThreads(),
+                    threadBudget.getNumWriterThreads(),
+                    threadBudget.getPinThreads());
+}
+
+std::vector<std::unique_ptr<imageProcessing::ImageProcManager>>
+    Application::createImageProcManagers(const std::shared_ptr<logging::Logger>& logger,
+                                         const bool logMode,
+                                         const common::ThreadBudget& threadBudget,
+                                         const common::Preset preset) const
+{
+    // The images of all the managers are written by the same threads, within the same budget of memory
+    std::shared_ptr<output::ImageWriter> imageWriter{std::make_shared<output::ImageWriter>(
+        std::make_shared<computerVision::OpenCvWrapper>(), logger, threadBudget.getNumWriterThreads())};
+
+    std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers{};
+    for (unsigned int i{0}; i < threadBudget.getNumAppWorkers(); ++i) {
+        imageProcManagers.push_back(std::make_unique<imageProcessing::ImageProcManager>(
+            imageProcessing::ImageProcManager::create(logger, logMode, false, threadBudget, imageWriter)));
+        imageProcManagers.back()->setPreset(preset);
+        imageProcManagers.back()->setResultCache(mResultCache);
+        imageProcManagers.back()->setStageCheckpoints(mStageCheckpoints);
+        imageProcManagers.back()->setDeterministicIds(mDeterministicIds);
+        imageProcManagers.back()->setNearDuplicateIndex(mNearDuplicateIndex);
+        // Each application worker has a core, so its tiles are segmented serially
+        imageProcManagers.back()->setTileSize(mTileSize, 1);
+        imageProcManagers.back()->setBandHeight(mBandHeight);
+    }
+
+    return imageProcManagers;
+}
+
+std::shared_ptr<imageProcessing::ResultCache> Application::openResultCache(
+    const std::string& directory, const std::size_t maxBytes, const std::shared_ptr<logging::Logger>& logger)
+{
+    if (directory.empty()) {
+        return nullptr;
+    }
+
+    // Without the cache, the images are processed anyway
+    auto resultCache{std::make_shared<imageProcessing::ResultCache>(directory, maxBytes, logger)};
+    if (!resultCache->open()) {
+        logger->logWarning("Failed to open the result cache {}, processing without it", directory);
+        return nullptr;
+    }
+
+    return resultCache;
+}
+
+std::shared_ptr<imageProcessing::NearDuplicateIndex>
+    Application::openNearDuplicateIndex(const std::shared_ptr<imageProcessing::ResultCache>& resultCache,
+                                        const std::string& directory,
+                                        const std::shared_ptr<logging::Logger>& logger)
+{
+    // The index only refers to the results of the cache
+    if (!resultCache) {
+        logger->logWarning("Near-duplicates need the result cache, processing without them");
+        return nullptr;
+    }
+
+    const auto filePath{std::filesystem::path{directory} / imageProcessing::NearDuplicateIndex::cIndexFile};
+    auto nearDuplicateIndex{std::make_shared<imageProcessing::NearDuplicateIndex>(filePath.string(), logger)};
+    if (!nearDuplicateIndex->open()) {
+        logger->logWarning("Failed to open the near-duplicate index {}, processing without it", filePath.string());
+        return nullptr;
+    }
+
+    return nearDuplicateIndex;
+}
+
+std::shared_ptr<imageProcessing::StageCheckpoints>
+    Application::openStageCheckpoints(const std::string& directory, const std::shared_ptr<logging::Logger>& logger)
+{
+    if (directory.empty()) {
+        return nullptr;
+    }
+
+    // Without the checkpoints, the images are processed from the start
+    auto stageCheckpoints{std::make_shared<imageProcessing::StageCheckpoints>(
+        directory, std::make_shared<computerVision::OpenCvWrapper>(), logger)};
+    if (!stageCheckpoints->open()) {
+        logger->logWarning("Failed to open the stage checkpoints {}, processing without them", directory);
+        return nullptr;
+    }
+
+    return stageCheckpoints;
+}
+
+void Application::logResultCacheStatistics(const std::shared_ptr<logging::Logger>& logger) const
+{
+    if (!mResultCache) {
+        return;
+    }
+
+    const auto statistics{mResultCache->getStatistics()};
+    logger->logInfo("Result cache: hits = {}, misses = {}, hit rate = {}, entries = {}, bytes = {}",
+                    statistics.mHits,
+                    statistics.mMisses,
+                    mResultCache->getHitRate(),
+                    statistics.mEntries,
+                    statistics.mBytes);
+}
+
+std::vector<unsigned char> Application::readImageBuffer(std::istream& stream)
+{
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+}
+
+void Application::stopDaemon([[maybe_unused]] int signal)
+{
+    if (auto* daemon{mDaemon.load()}; daemon != nullptr) {
+        daemon->stop();
+    }
+}
+
+void Application::stopFolderWatcher([[maybe_unused]] int signal)
+{
+    if (auto* folderWatcher{mFolderWatcher.load()}; folderWatcher != nullptr) {
+        folderWatcher->stop();
+    }
+}
+
+void Application::stopSharedMemoryIntake([[maybe_unused]] int signal)
+{
+    if (auto* sharedMemoryIntake{mSharedMemoryIntake.load()}; sharedMemoryIntake != nullptr) {
+        sharedMemoryIntake->stop();
+    }
+}
+
 } // namespace application
 } // namespace circuitSegmentation
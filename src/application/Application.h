@@ -4,9 +4,27 @@
 
 #pragma once
 
+#include "common/Preset.h"
+#include "common/ThreadBudget.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "imageProcessing/NearDuplicateIndex.h"
+#include "imageProcessing/ResultCache.h"
+#include "imageProcessing/StageCheckpoints.h"
+#include "logging/Logger.h"
+#include <atomic>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace circuitSegmentation {
 namespace application {
 
+class Daemon;
+class FolderWatcher;
+class SharedMemoryIntake;
+
 /**
  * @brief Application class.
  */
@@ -34,6 +52,175 @@ public:
      * @return Process error: 0 on success, 1 on failure.
      */
     int exec(int& argc, char const* argv[]);
+
+private:
+    /**
+     * @brief Runs the application with a pool of workers serving images until it is stopped: the daemon (requests on
+     * a Unix domain socket), the folder watcher (images arriving in a spool folder) or the shared-memory intake
+     * (frames published in a ring).
+     *
+     * @tparam Workers Type of the workers: @ref Daemon, @ref FolderWatcher or @ref SharedMemoryIntake.
+     *
+     * @param modeName Name of the mode, for the logs.
+     * @param source Source of the images: path of the socket, path of the spool folder or name of the ring.
+     * @param runningWorkers Workers running, to be stopped by the signal handler.
+     * @param stopHandler Handler of the signals to stop the workers.
+     * @param logger Logger.
+     * @param logMode Log mode: verbose = true, silent = false.
+     * @param threadBudget Budget of threads, in batch mode (with a warm image processing manager for each worker).
+     * @param preset Preset of the processings.
+     * @param memoryBudget Budget of memory of the images processed concurrently, in bytes (0 for no budget).
+     *
+     * @return True if the workers ran and stopped successfully, otherwise false.
+     */
+    template<typename Workers>
+    bool runWorkers(const std::string& modeName,
+                    const std::string& source,
+                    std::atomic<Workers*>& runningWorkers,
+                    void (*stopHandler)(int),
+                    const std::shared_ptr<logging::Logger>& logger,
+                    const bool logMode,
+                    const common::ThreadBudget& threadBudget,
+                    const common::Preset preset,
+                    const std::size_t memoryBudget);
+
+    /**
+     * @brief Runs a sweep of the parameters of the pipeline over a corpus of images, writing the results as CSV.
+     *
+     * @param configPath Path of the JSON configuration of the sweep.
+     * @param logger Logger.
+     * @param threadBudget Budget of threads, in batch mode (the stages run in parallel, one for each core).
+     * @param preset Preset whose parameters are the base of the combinations, if the configuration has no preset.
+     *
+     * @return True if the sweep ran over all the images and the results were written, otherwise false.
+     */
+    static bool runParameterSweep(const std::string& configPath,
+                                  const std::shared_ptr<logging::Logger>& logger,
+                                  const common::ThreadBudget& threadBudget,
+                                  const common::Preset preset);
+
+    /**
+     * @brief Logs a budget of threads.
+     *
+     * @param logger Logger.
+     * @param threadBudget Budget of threads.
+     */
+    static void logThreadBudget(const std::shared_ptr<logging::Logger>& logger,
+                                const common::ThreadBudget& threadBudget);
+
+    /**
+     * @brief Creates a warm image processing manager for each application worker of a budget of threads, sharing an
+     * image writer and the result cache, the stage checkpoints and the near-duplicate index of the application.
+     *
+     * @param logger Logger.
+     * @param logMode Log mode: verbose = true, silent = false.
+     * @param threadBudget Budget of threads.
+     * @param preset Preset of the processings.
+     *
+     * @return Image processing managers.
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<imageProcessing::ImageProcManager>>
+        createImageProcManagers(const std::shared_ptr<logging::Logger>& logger,
+                                const bool logMode,
+                                const common::ThreadBudget& threadBudget,
+                                const common::Preset preset) const;
+
+    /**
+     * @brief Opens the result cache of the processings.
+     *
+     * @param directory Folder of the cache (empty for no cache).
+     * @param maxBytes Maximum size of the cache, in bytes.
+     * @param logger Logger.
+     *
+     * @return Result cache, or null if there is no folder or the cache could not be opened.
+     */
+    static std::shared_ptr<imageProcessing::ResultCache>
+        openResultCache(const std::string& directory,
+                        const std::size_t maxBytes,
+                        const std::shared_ptr<logging::Logger>& logger);
+
+    /**
+     * @brief Opens the near-duplicate index of the results in the result cache.
+     *
+     * @param resultCache Result cache (null for none).
+     * @param directory Folder of the cache, where the index is kept.
+     * @param logger Logger.
+     *
+     * @return Near-duplicate index, or null if there is no cache or the index could not be opened.
+     */
+    static std::shared_ptr<imageProcessing::NearDuplicateIndex>
+        openNearDuplicateIndex(const std::shared_ptr<imageProcessing::ResultCache>& resultCache,
+                               const std::string& directory,
+                               const std::shared_ptr<logging::Logger>& logger);
+
+    /**
+     * @brief Logs the statistics of the result cache, if there is one.
+     *
+     * @param logger Logger.
+     */
+    void logResultCacheStatistics(const std::shared_ptr<logging::Logger>& logger) const;
+
+    /**
+     * @brief Opens the checkpoints of the stages of the processings.
+     *
+     * @param directory Folder of the checkpoints (empty for no checkpoints).
+     * @param logger Logger.
+     *
+     * @return Stage checkpoints, or null if there is no folder or the checkpoints could not be opened.
+     */
+    static std::shared_ptr<imageProcessing::StageCheckpoints>
+        openStageCheckpoints(const std::string& directory, const std::shared_ptr<logging::Logger>& logger);
+
+    /**
+     * @brief Reads an encoded image from a stream until its end (e.g. the standard input).
+     *
+     * @param stream Stream, in binary mode.
+     *
+     * @return Buffer with the encoded image, empty if nothing was read.
+     */
+    static std::vector<unsigned char> readImageBuffer(std::istream& stream);
+
+    /**
+     * @brief Handler of the signals to stop the daemon.
+     *
+     * @param signal Signal.
+     */
+    static void stopDaemon(int signal);
+
+    /**
+     * @brief Handler of the signals to stop the folder watcher.
+     *
+     * @param signal Signal.
+     */
+    static void stopFolderWatcher(int signal);
+
+    /**
+     * @brief Handler of the signals to stop the shared-memory intake.
+     *
+     * @param signal Signal.
+     */
+    static void stopSharedMemoryIntake(int signal);
+
+private:
+    /** Daemon running, to be stopped by the signal handler. */
+    static inline std::atomic<Daemon*> mDaemon{nullptr};
+    /** Folder watcher running, to be stopped by the signal handler. */
+    static inline std::atomic<FolderWatcher*> mFolderWatcher{nullptr};
+    /** Shared-memory intake running, to be stopped by the signal handler. */
+    static inline std::atomic<SharedMemoryIntake*> mSharedMemoryIntake{nullptr};
+
+    /** Result cache of the processings (null for none). */
+    std::shared_ptr<imageProcessing::ResultCache> mResultCache{};
+    /** Checkpoints of the stages of the processings (null for none). */
+    std::shared_ptr<imageProcessing::StageCheckpoints> mStageCheckpoints{};
+    /** Flag of the processings assigning deterministic IDs to the elements. */
+    bool mDeterministicIds{false};
+    /** Near-duplicate index of the results in the result cache (null for none). */
+    std::shared_ptr<imageProcessing::NearDuplicateIndex> mNearDuplicateIndex{};
+    /** Size of the tiles of the images segmented by tiles, in pixels (0 for none). */
+    int mTileSize{0};
+    /** Height of the bands of the images preprocessed by bands, in rows (0 for none). */
+    int mBandHeight{0};
 };
 
 } // namespace application
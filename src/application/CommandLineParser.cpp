@@ -4,7 +4,9 @@
 
 #include "CommandLineParser.h"
 #include "Application.h"
+#include <charconv>
 #include <iostream>
+#include <system_error>
 
 namespace circuitSegmentation {
 namespace application {
@@ -21,10 +23,30 @@ void CommandLineParser::parse(const int argc, char const* argv[])
         {"-h, --help", "show help message"},
         {"-v, --version", "show version"},
         {"-V, --verbose", "enable verbose logs"},
-        {"-i, --image", "image file path with the circuit"},
+        {"-i, --image", "image file path with the circuit (- to read it from the standard input)"},
         {"-s, --save-proc", "save images obtained during the processing in the working directory"},
+        {"-j, --jobs", "number of threads for writing images"},
+        {"-p, --pin-threads", "pin the application workers to cores (Linux only)"},
+        {"-d, --daemon", "run as a daemon serving requests on a Unix domain socket"},
+        {"-w, --watch", "watch a spool folder, processing the images as soon as they arrive (Linux only)"},
+        {"-r, --shm-ring", "process the raw frames placed by a producer in a shared-memory ring (Linux only)"},
+        {"-P, --preset", "preset of the pipeline: fast, balanced (default) or accurate"},
+        {"-m, --memory-budget", "budget of memory of the images processed concurrently, in MiB (daemon, watch, ring)"},
+        {"-c, --cache", "folder of the result cache, reused between runs"},
+        {"-C, --cache-size", "maximum size of the result cache, in MiB (default: 1024)"},
+        {"-k, --checkpoints", "folder of the checkpoints of the stages, reused when re-processing an image"},
+        {"-S, --sweep", "JSON configuration of a sweep of the parameters over a corpus of images"},
+        {"-D, --deterministic-ids",
+         "derive the IDs of the elements from the image, so the same image gets the same IDs"},
+        {"-n, --near-duplicates",
+         "reuse the cached result of a near-duplicate image (e.g. re-scanned), with the cache"},
+        {"-t, --tile-size", "segment the images larger than this size, in pixels, by overlapping tiles in parallel"},
+        {"-b, --band-height", "preprocess the images by bands of this height, in rows, into a packed bitmap"},
     };
-    mParser.setAppUsageInfo(Application::cAppExeName, "-i <image_path> [OPTIONS]", options);
+    mParser.setAppUsageInfo(
+        Application::cAppExeName,
+        "-i <image_path> | -d <socket_path> | -w <spool_folder> | -r <ring_name> | -S <sweep_config> [OPTIONS]",
+        options);
 
     // Parse
     mParser.parse(argc, argv);
@@ -79,6 +101,17 @@ std::string CommandLineParser::getImagePath() const
     return option;
 }
 
+bool CommandLineParser::hasImageFromStandardInput() const
+{
+    // Option (help is not shown when it is missing)
+    auto option = mParser.getOption("-i");
+    if (option.empty()) {
+        option = mParser.getOption("--image");
+    }
+
+    return option == cStandardInputImagePath;
+}
+
 bool CommandLineParser::hasSaveImages() const
 {
     // Verbose
@@ -89,5 +122,232 @@ bool CommandLineParser::hasSaveImages() const
     return false;
 }
 
+unsigned int CommandLineParser::getNumJobs() const
+{
+    // Option
+    auto option = mParser.getOption("-j");
+    if (option.empty()) {
+        option = mParser.getOption("--jobs");
+        if (option.empty()) {
+            return 0;
+        }
+    }
+
+    // Number of jobs
+    unsigned int numJobs{0};
+    const auto [ptr, ec]{std::from_chars(option.data(), option.data() + option.size(), numJobs)};
+    if (ec != std::errc{} || ptr != option.data() + option.size()) {
+        std::cout << "Invalid number of jobs: " << option << std::endl;
+        return 0;
+    }
+
+    return numJobs;
+}
+
+bool CommandLineParser::hasPinThreads() const
+{
+    // Pin threads
+    if (mParser.hasOption("-p") || mParser.hasOption("--pin-threads")) {
+        return true;
+    }
+
+    return false;
+}
+
+std::string CommandLineParser::getDaemonSocketPath() const
+{
+    // Option
+    auto option = mParser.getOption("-d");
+    if (option.empty()) {
+        option = mParser.getOption("--daemon");
+    }
+
+    return option;
+}
+
+std::string CommandLineParser::getWatchDirectory() const
+{
+    // Option
+    auto option = mParser.getOption("-w");
+    if (option.empty()) {
+        option = mParser.getOption("--watch");
+    }
+
+    return option;
+}
+
+std::string CommandLineParser::getSharedMemoryRingName() const
+{
+    // Option
+    auto option = mParser.getOption("-r");
+    if (option.empty()) {
+        option = mParser.getOption("--shm-ring");
+    }
+
+    return option;
+}
+
+common::Preset CommandLineParser::getPreset() const
+{
+    // Option
+    auto option = mParser.getOption("-P");
+    if (option.empty()) {
+        option = mParser.getOption("--preset");
+        if (option.empty()) {
+            return common::Preset::BALANCED;
+        }
+    }
+
+    // Preset
+    common::Preset preset{common::Preset::BALANCED};
+    if (!common::parsePreset(option, preset)) {
+        std::cout << "Invalid preset: " << option << std::endl;
+        return common::Preset::BALANCED;
+    }
+
+    return preset;
+}
+
+unsigned int CommandLineParser::getMemoryBudget() const
+{
+    // Option
+    auto option = mParser.getOption("-m");
+    if (option.empty()) {
+        option = mParser.getOption("--memory-budget");
+        if (option.empty()) {
+            return 0;
+        }
+    }
+
+    // Budget of memory, in MiB
+    unsigned int memoryBudget{0};
+    const auto [ptr, ec]{std::from_chars(option.data(), option.data() + option.size(), memoryBudget)};
+    if (ec != std::errc{} || ptr != option.data() + option.size()) {
+        std::cout << "Invalid memory budget: " << option << std::endl;
+        return 0;
+    }
+
+    return memoryBudget;
+}
+
+std::string CommandLineParser::getCacheDirectory() const
+{
+    // Option
+    auto option = mParser.getOption("-c");
+    if (option.empty()) {
+        option = mParser.getOption("--cache");
+    }
+
+    return option;
+}
+
+unsigned int CommandLineParser::getCacheSize() const
+{
+    // Option
+    auto option = mParser.getOption("-C");
+    if (option.empty()) {
+        option = mParser.getOption("--cache-size");
+        if (option.empty()) {
+            return cCacheSizeDefault;
+        }
+    }
+
+    // Maximum size, in MiB
+    unsigned int cacheSize{0};
+    const auto [ptr, ec]{std::from_chars(option.data(), option.data() + option.size(), cacheSize)};
+    if (ec != std::errc{} || ptr != option.data() + option.size() || cacheSize == 0) {
+        std::cout << "Invalid cache size: " << option << std::endl;
+        return cCacheSizeDefault;
+    }
+
+    return cacheSize;
+}
+
+std::string CommandLineParser::getCheckpointsDirectory() const
+{
+    // Option
+    auto option = mParser.getOption("-k");
+    if (option.empty()) {
+        option = mParser.getOption("--checkpoints");
+    }
+
+    return option;
+}
+
+std::string CommandLineParser::getSweepConfigPath() const
+{
+    // Option
+    auto option = mParser.getOption("-S");
+    if (option.empty()) {
+        option = mParser.getOption("--sweep");
+    }
+
+    return option;
+}
+
+bool CommandLineParser::hasDeterministicIds() const
+{
+    // Deterministic IDs
+    if (mParser.hasOption("-D") || mParser.hasOption("--deterministic-ids")) {
+        return true;
+    }
+
+    return false;
+}
+
+bool CommandLineParser::hasNearDuplicates() const
+{
+    // Near-duplicates
+    if (mParser.hasOption("-n") || mParser.hasOption("--near-duplicates")) {
+        return true;
+    }
+
+    return false;
+}
+
+unsigned int CommandLineParser::getTileSize() const
+{
+    // Option
+    auto option = mParser.getOption("-t");
+    if (option.empty()) {
+        option = mParser.getOption("--tile-size");
+        if (option.empty()) {
+            return 0;
+        }
+    }
+
+    // Size of the tiles, in pixels
+    unsigned int tileSize{0};
+    const auto [ptr, ec]{std::from_chars(option.data(), option.data() + option.size(), tileSize)};
+    if (ec != std::errc{} || ptr != option.data() + option.size()) {
+        std::cout << "Invalid tile size: " << option << std::endl;
+        return 0;
+    }
+
+    return tileSize;
+}
+
+unsigned int CommandLineParser::getBandHeight() const
+{
+    // Option
+    auto option = mParser.getOption("-b");
+    if (option.empty()) {
+        option = mParser.getOption("--band-height");
+        if (option.empty()) {
+            return 0;
+        }
+    }
+
+    // Height of the bands, in rows
+    unsigned int bandHeight{0};
+    const auto [ptr, ec]{std::from_chars(option.data(), option.data() + option.size(), bandHeight)};
+    if (ec != std::errc{} || ptr != option.data() + option.size()) {
+        std::cout << "Invalid band height: " << option << std::endl;
+        return 0;
+    }
+
+    return bandHeight;
+}
+
 } // namespace application
 } // namespace circuitSegmentation
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "cmdLineParser/CmdLineParser.h"
+#include "common/Preset.h"
 #include <string>
 
 namespace circuitSegmentation {
@@ -17,12 +18,33 @@ namespace application {
  * - -h, --help: show help message
  * - -v, --version: show application version
  * - -V, --verbose: enable verbose logs
- * - -i, --image: image file path with the circuit
+ * - -i, --image: image file path with the circuit (- to read the encoded image from the standard input)
  * - -s, --save-proc: save images obtained during the processing in the working directory
+ * - -j, --jobs: number of threads for writing images
+ * - -p, --pin-threads: pin the application workers to cores (Linux only)
+ * - -d, --daemon: run as a daemon serving requests on a Unix domain socket
+ * - -w, --watch: watch a spool folder, processing the images as soon as they arrive
+ * - -r, --shm-ring: process the raw frames placed by a producer in a shared-memory ring
+ * - -P, --preset: preset of the pipeline (fast, balanced or accurate)
+ * - -m, --memory-budget: budget of memory of the images processed concurrently, in MiB (daemon, watch and ring
+ *   modes)
+ * - -c, --cache: folder of the result cache, reused between runs
+ * - -C, --cache-size: maximum size of the result cache, in MiB
+ * - -k, --checkpoints: folder of the checkpoints of the stages, so re-processings skip the stages already done
+ * - -S, --sweep: JSON configuration of a sweep of the parameters of the pipeline over a corpus of images
+ * - -D, --deterministic-ids: derive the IDs of the elements from the image and their geometry, instead of random IDs
+ * - -n, --near-duplicates: reuse the cached result of a near-duplicate image (e.g. the same schematic re-scanned)
+ * - -t, --tile-size: segment the images larger than this size, in pixels, by overlapping tiles in parallel
+ * - -b, --band-height: preprocess the images by bands of this height, in rows, into a packed bitmap
  */
 class CommandLineParser
 {
 public:
+    /** Image path to read the encoded image from the standard input. */
+    static constexpr auto cStandardInputImagePath{"-"};
+    /** Default maximum size of the result cache, in MiB. */
+    static constexpr unsigned int cCacheSizeDefault{1024};
+
     /**
      * @brief Destructor.
      */
@@ -64,6 +86,13 @@ public:
      */
     [[nodiscard]] virtual std::string getImagePath() const;
 
+    /**
+     * @brief Checks if the image is read from the standard input (image path passed is "-").
+     *
+     * @return True if the image is read from the standard input, otherwise false.
+     */
+    [[nodiscard]] virtual bool hasImageFromStandardInput() const;
+
     /**
      * @brief Checks if save images option was passed.
      *
@@ -71,6 +100,112 @@ public:
      */
     [[nodiscard]] virtual bool hasSaveImages() const;
 
+    /**
+     * @brief Gets number of jobs option passed.
+     *
+     * @return Number of jobs passed, or 0 if option was not passed or is not a positive number.
+     */
+    [[nodiscard]] virtual unsigned int getNumJobs() const;
+
+    /**
+     * @brief Checks if pin threads option was passed.
+     *
+     * @return True if the option was passed, otherwise false.
+     */
+    [[nodiscard]] virtual bool hasPinThreads() const;
+
+    /**
+     * @brief Gets daemon socket path option passed.
+     *
+     * @return Path of the Unix domain socket passed, or an empty string if option was not passed.
+     */
+    [[nodiscard]] virtual std::string getDaemonSocketPath() const;
+
+    /**
+     * @brief Gets watch spool folder option passed.
+     *
+     * @return Spool folder passed, or an empty string if option was not passed.
+     */
+    [[nodiscard]] virtual std::string getWatchDirectory() const;
+
+    /**
+     * @brief Gets shared-memory ring option passed.
+     *
+     * @return Name of the shared memory object of the ring passed, or an empty string if option was not passed.
+     */
+    [[nodiscard]] virtual std::string getSharedMemoryRingName() const;
+
+    /**
+     * @brief Gets preset option passed.
+     *
+     * @return Preset passed, or the balanced preset if option was not passed or is not a preset.
+     */
+    [[nodiscard]] virtual common::Preset getPreset() const;
+
+    /**
+     * @brief Gets memory budget option passed.
+     *
+     * @return Budget of memory passed, in MiB, or 0 if option was not passed or is not a positive number.
+     */
+    [[nodiscard]] virtual unsigned int getMemoryBudget() const;
+
+    /**
+     * @brief Gets result cache option passed.
+     *
+     * @return Folder of the result cache passed, or an empty string if option was not passed.
+     */
+    [[nodiscard]] virtual std::string getCacheDirectory() const;
+
+    /**
+     * @brief Gets result cache size option passed.
+     *
+     * @return Maximum size of the result cache passed, in MiB, or the default size if option was not passed or is not
+     * a positive number.
+     */
+    [[nodiscard]] virtual unsigned int getCacheSize() const;
+
+    /**
+     * @brief Gets stage checkpoints option passed.
+     *
+     * @return Folder of the checkpoints passed, or an empty string if option was not passed.
+     */
+    [[nodiscard]] virtual std::string getCheckpointsDirectory() const;
+
+    /**
+     * @brief Gets parameter sweep option passed.
+     *
+     * @return Path of the configuration of the sweep passed, or an empty string if option was not passed.
+     */
+    [[nodiscard]] virtual std::string getSweepConfigPath() const;
+
+    /**
+     * @brief Checks if deterministic IDs option was passed.
+     *
+     * @return True if the option was passed, otherwise false.
+     */
+    [[nodiscard]] virtual bool hasDeterministicIds() const;
+
+    /**
+     * @brief Checks if near-duplicates option was passed.
+     *
+     * @return True if the option was passed, otherwise false.
+     */
+    [[nodiscard]] virtual bool hasNearDuplicates() const;
+
+    /**
+     * @brief Gets tile size option passed.
+     *
+     * @return Width and height of the tiles passed, in pixels, or 0 if option was not passed or is not a number.
+     */
+    [[nodiscard]] virtual unsigned int getTileSize() const;
+
+    /**
+     * @brief Gets band height option passed.
+     *
+     * @return Height of the bands passed, in rows, or 0 if option was not passed or is not a number.
+     */
+    [[nodiscard]] virtual unsigned int getBandHeight() const;
+
 private:
     /** Parser of the command line arguments. */
     circuitSegmentation::cmdLineParser::CmdLineParser mParser{};
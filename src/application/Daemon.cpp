@@ -0,0 +1,655 @@
+/**
+ * @file
+ */
+
+#include "Daemon.h"
+#include "imageProcessing/ImageHeader.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DAEMON_SUPPORTED
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace circuitSegmentation {
+namespace application {
+
+Daemon::Daemon(const std::string& socketPath,
+               std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers,
+               const std::shared_ptr<logging::Logger>& logger,
+               const std::size_t memoryBudget,
+               const common::ThreadPool::ThreadStart& workerStart)
+    : mSocketPath{socketPath}
+    , mNumWorkers{static_cast<unsigned int>(std::max<std::size_t>(imageProcManagers.size(), 1))}
+    , mLogger{logger}
+    , mMemoryBudget{memoryBudget}
+    , mManagerPool{std::move(imageProcManagers)}
+    , mThreadPool{mNumWorkers, workerStart}
+{
+}
+
+bool Daemon::run()
+{
+#ifdef DAEMON_SUPPORTED
+    // Create socket
+    const auto listenFd{socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (listenFd < 0) {
+        mLogger->logError("Failed to create socket: {}", std::strerror(errno));
+        return false;
+    }
+    if (!bindSocket(listenFd)) {
+        close(listenFd);
+        return false;
+    }
+    if (listen(listenFd, cBacklog) != 0) {
+        mLogger->logError("Failed to listen on socket {}: {}", mSocketPath, std::strerror(errno));
+        close(listenFd);
+        unlink(mSocketPath.c_str());
+        return false;
+    }
+
+    // Pipe to wake the loop (when stopped, or when a request is replied)
+    std::array<int, 2> wakePipe{};
+    if (pipe(wakePipe.data()) != 0) {
+        mLogger->logError("Failed to create pipe: {}", std::strerror(errno));
+        close(listenFd);
+        unlink(mSocketPath.c_str());
+        return false;
+    }
+    for (const auto fd : wakePipe) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+    mWakeFd = wakePipe[1];
+
+    mLogger->logInfo("Daemon listening on socket {} with {} workers", mSocketPath, mNumWorkers);
+
+    // Multiplex the connections until stopped
+    std::vector<pollfd> pollFds{};
+    while (!mStop) {
+        pollFds.clear();
+        pollFds.push_back({listenFd, POLLIN, 0});
+        pollFds.push_back({wakePipe[0], POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lock{mMutex};
+            dispatchRequests();
+
+            // Connections waiting for requests (the busy ones are read once replied, so their replies are in order)
+            for (const auto& [fd, connection] : mConnections) {
+                if (!connection.mBusy && !connection.mBroken && !connection.mInputClosed) {
+                    pollFds.push_back({fd, POLLIN, 0});
+                }
+            }
+        }
+
+        if (poll(pollFds.data(), pollFds.size(), cPollIntervalMs) <= 0) {
+            continue;
+        }
+
+        // Drain the wake pipe
+        if (pollFds[1].revents != 0) {
+            std::array<char, 64> buffer{};
+            while (read(wakePipe[0], buffer.data(), buffer.size()) > 0) {
+            }
+        }
+
+        // New connection
+        if ((pollFds[0].revents & POLLIN) != 0) {
+            const auto fd{accept(listenFd, nullptr, nullptr)};
+            if (fd >= 0) {
+                std::lock_guard<std::mutex> lock{mMutex};
+                mConnections[fd].mFd = fd;
+            }
+        }
+
+        // Requests
+        for (std::size_t i{2}; i < pollFds.size(); ++i) {
+            if (pollFds[i].revents != 0) {
+                readConnection(mConnections.at(pollFds[i].fd));
+            }
+        }
+    }
+
+    // Stop accepting connections
+    close(listenFd);
+    unlink(mSocketPath.c_str());
+
+    // Drop the queued requests and close the idle connections, then wait for the requests being processed
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        for (auto& [fd, connection] : mConnections) {
+            connection.mRequests.clear();
+            connection.mInputClosed = true;
+        }
+        dispatchRequests();
+    }
+    mThreadPool.waitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        for (const auto& [fd, connection] : mConnections) {
+            close(fd);
+        }
+        mConnections.clear();
+    }
+    mWakeFd = -1;
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+
+    mLogger->logInfo("Daemon stopped");
+
+    return true;
+#else
+    mLogger->logError("Daemon mode is not supported on this platform");
+    return false;
+#endif
+}
+
+void Daemon::stop()
+{
+    mStop = true;
+    wake();
+}
+
+unsigned int Daemon::getNumWorkers() const
+{
+    return mNumWorkers;
+}
+
+std::string Daemon::getSocketPath() const
+{
+    return mSocketPath;
+}
+
+std::size_t Daemon::getMemoryBudget() const
+{
+    return mMemoryBudget.getBudget();
+}
+
+bool Daemon::bindSocket(const int listenFd)
+{
+#ifdef DAEMON_SUPPORTED
+    // Socket address
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (mSocketPath.empty() || mSocketPath.size() >= sizeof(address.sun_path)) {
+        mLogger->logError("Invalid socket path: {}", mSocketPath);
+        return false;
+    }
+    std::memcpy(address.sun_path, mSocketPath.c_str(), mSocketPath.size());
+
+    // Existing path: only a stale socket (refusing connections) is replaced
+    struct stat status{};
+    if (lstat(mSocketPath.c_str(), &status) == 0) {
+        if (!S_ISSOCK(status.st_mode)) {
+            mLogger->logError("Path of socket {} exists and is not a socket", mSocketPath);
+            return false;
+        }
+
+        const auto probeFd{socket(AF_UNIX, SOCK_STREAM, 0)};
+        if (probeFd < 0) {
+            mLogger->logError("Failed to create socket: {}", std::strerror(errno));
+            return false;
+        }
+        const auto connected{connect(probeFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0};
+        const auto connectError{errno};
+        close(probeFd);
+        if (connected) {
+            mLogger->logError("Daemon already running on socket {}", mSocketPath);
+            return false;
+        }
+        if (connectError != ECONNREFUSED) {
+            mLogger->logError("Failed to check socket {}: {}", mSocketPath, std::strerror(connectError));
+            return false;
+        }
+
+        mLogger->logInfo("Replacing stale socket {}", mSocketPath);
+        unlink(mSocketPath.c_str());
+    }
+
+    // Socket only for its owner
+    const auto previousMask{umask(S_IXUSR | S_IRWXG | S_IRWXO)};
+    const auto bound{bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0};
+    const auto bindError{errno};
+    umask(previousMask);
+    if (!bound) {
+        mLogger->logError("Failed to bind socket {}: {}", mSocketPath, std::strerror(bindError));
+        return false;
+    }
+
+    return true;
+#else
+    static_cast<void>(listenFd);
+    return false;
+#endif
+}
+
+void Daemon::readConnection(DaemonConnection& connection)
+{
+#ifdef DAEMON_SUPPORTED
+    std::array<char, 64 * 1024> buffer{};
+    const auto bytesRead{read(connection.mFd, buffer.data(), buffer.size())};
+    if (bytesRead < 0 && (errno == EINTR || errno == EAGAIN)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{mMutex};
+    if (bytesRead <= 0) {
+        connection.mInputClosed = true;
+        return;
+    }
+    connection.mPending.append(buffer.data(), static_cast<std::size_t>(bytesRead));
+
+    // Queue each complete request (one per line)
+    std::size_t lineStart{0};
+    for (auto lineEnd{connection.mPending.find('\n')}; lineEnd != std::string::npos;
+         lineEnd = connection.mPending.find('\n', lineStart)) {
+        auto line{connection.mPending.substr(lineStart, lineEnd - lineStart)};
+        lineStart = lineEnd + 1;
+
+        if (line.find_first_not_of(" \t\r") != std::string::npos) {
+            connection.mRequests.push_back(std::move(line));
+        }
+    }
+    connection.mPending.erase(0, lineStart);
+
+    // Request too big
+    if (connection.mPending.size() > cMaxRequestSize) {
+        nlohmann::ordered_json reply{};
+        reply["success"] = false;
+        reply["error"] = "Request too big";
+        writeAll(connection.mFd, reply.dump() + "\n");
+        connection.mBroken = true;
+    }
+#else
+    static_cast<void>(connection);
+#endif
+}
+
+void Daemon::dispatchRequests()
+{
+#ifdef DAEMON_SUPPORTED
+    for (auto it{mConnections.begin()}; it != mConnections.end();) {
+        auto& connection{it->second};
+        if (connection.mBusy) {
+            ++it;
+            continue;
+        }
+
+        // Close the connections that are done
+        if (connection.mBroken || (connection.mInputClosed && connection.mRequests.empty())) {
+            close(connection.mFd);
+            it = mConnections.erase(it);
+            continue;
+        }
+
+        // Next request of the connection
+        if (!connection.mRequests.empty()) {
+            connection.mBusy = true;
+            auto line{std::move(connection.mRequests.front())};
+            connection.mRequests.pop_front();
+            mThreadPool.submit([this, &connection, line = std::move(line)]() { serveRequest(connection, line); });
+        }
+        ++it;
+    }
+#endif
+}
+
+void Daemon::serveRequest(DaemonConnection& connection, const std::string& line)
+{
+    const auto replied{writeAll(connection.mFd, handleRequest(line) + "\n")};
+
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        connection.mBusy = false;
+        connection.mBroken = connection.mBroken || !replied;
+    }
+    wake();
+}
+
+void Daemon::wake()
+{
+#ifdef DAEMON_SUPPORTED
+    // Only a write, so it can be called from a signal handler
+    const auto fd{mWakeFd.load()};
+    if (fd >= 0) {
+        const char byte{0};
+        static_cast<void>(write(fd, &byte, 1));
+    }
+#endif
+}
+
+std::string Daemon::handleRequest(const std::string& line)
+{
+    nlohmann::ordered_json reply{};
+
+    // Parse request
+    DaemonRequest request{};
+    std::string error{};
+    if (!parseRequest(line, request, error)) {
+        mLogger->logWarning("Invalid request: {}", error);
+        reply["id"] = request.mId;
+        reply["success"] = false;
+        reply["error"] = error;
+        return reply.dump();
+    }
+    reply["id"] = request.mId;
+
+    // Shut down
+    if (request.mShutdown) {
+        mLogger->logInfo("Shutdown requested");
+        stop();
+        reply["success"] = true;
+        return reply.dump();
+    }
+
+    processRequest(request, reply);
+
+    return reply.dump();
+}
+
+void Daemon::processRequest(DaemonRequest& request, nlohmann::ordered_json& reply)
+{
+    const auto startTime{std::chrono::steady_clock::now()};
+
+    // Output directory
+    if (!request.mOutputDirectory.empty()) {
+        std::error_code ec{};
+        std::filesystem::create_directories(request.mOutputDirectory, ec);
+        if (ec) {
+            reply["success"] = false;
+            reply["error"] = "Failed to create output directory: " + ec.message();
+            return;
+        }
+    }
+
+    // Deadline of the request, from its arrival
+    auto cancellationToken{std::make_shared<common::CancellationToken>()};
+    if (request.mTimeoutMs > 0) {
+        cancellationToken->setDeadline(startTime + std::chrono::milliseconds(request.mTimeoutMs));
+    }
+
+    // Process image with an idle manager, once the request fits in the budget of memory
+    auto imageProcManager{mManagerPool.acquire()};
+    auto lowMemoryMode{false};
+    auto reservation{reserveMemory(request, lowMemoryMode)};
+    imageProcManager->setLowMemoryMode(lowMemoryMode);
+    imageProcManager->setOutputDirectory(request.mOutputDirectory);
+    imageProcManager->setSaveImages(request.mSaveImages);
+    imageProcManager->setWriteOutputFiles(request.mWriteFiles);
+    imageProcManager->setCancellationToken(cancellationToken);
+    const auto daemonPreset{imageProcManager->getPreset()};
+    if (request.mPreset.has_value()) {
+        imageProcManager->setPreset(request.mPreset.value());
+    }
+
+    const auto success{request.mImagePath.empty()
+                           ? imageProcManager->processImageBuffer(std::move(request.mImageBuffer))
+                           : imageProcManager->processImage(request.mImagePath)};
+    const auto status{imageProcManager->getLastStatus()};
+
+    reply["success"] = success;
+    reply["status"] = getStatusName(status);
+    reply["timeMs"] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    if (success) {
+        reply["segmentationMap"] = imageProcManager->getSegmentationMap();
+    } else if (status == imageProcessing::ProcessingStatus::DEADLINE_EXCEEDED) {
+        reply["error"] = "Deadline exceeded";
+    } else {
+        reply["error"] = "Failed to process image";
+    }
+
+    imageProcManager->setCancellationToken(nullptr);
+    imageProcManager->setLowMemoryMode(false);
+    if (request.mPreset.has_value()) {
+        imageProcManager->setPreset(daemonPreset);
+    }
+    reservation.release();
+    mManagerPool.release(std::move(imageProcManager));
+}
+
+common::MemoryBudget::Reservation Daemon::reserveMemory(const DaemonRequest& request, bool& lowMemoryMode)
+{
+    lowMemoryMode = false;
+    if (mMemoryBudget.getBudget() == 0) {
+        return {};
+    }
+
+    // Dimensions from the header of the image, before it is decoded
+    imageProcessing::ImageDimensions dimensions{};
+    const auto hasDimensions{request.mImagePath.empty()
+                                 ? imageProcessing::ImageHeader::readBufferDimensions(request.mImageBuffer, dimensions)
+                                 : imageProcessing::ImageHeader::readFileDimensions(request.mImagePath, dimensions)};
+    if (!hasDimensions) {
+        mLogger->logWarning("Image dimensions unknown: request admitted alone, in low-memory mode");
+        lowMemoryMode = true;
+        return mMemoryBudget.reserve(mMemoryBudget.getBudget() + 1);
+    }
+
+    // Estimate, without saving images if it does not fit in the budget
+    const auto encodedBytes{request.mImageBuffer.size()};
+    auto peakMemory{
+        imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, request.mSaveImages, encodedBytes)};
+    if (mMemoryBudget.isOversized(peakMemory)) {
+        lowMemoryMode = true;
+        peakMemory = imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, false, encodedBytes);
+    }
+
+    auto reservation{mMemoryBudget.reserve(peakMemory)};
+    mLogger->logInfo("Request of {}x{} pixels admitted with {} bytes of {} bytes{}{}",
+                     dimensions.mWidth,
+                     dimensions.mHeight,
+                     peakMemory,
+                     mMemoryBudget.getBudget(),
+                     lowMemoryMode ? ", in low-memory mode" : "",
+                     reservation.isOversized() ? ", alone" : "");
+
+    return reservation;
+}
+
+bool Daemon::parseRequest(const std::string& line, DaemonRequest& request, std::string& error)
+{
+    // JSON object (not brace-initialized, which would wrap it in an array)
+    const auto json = nlohmann::ordered_json::parse(line, nullptr, false);
+    if (json.is_discarded() || !json.is_object()) {
+        error = "Request is not a JSON object";
+        return false;
+    }
+
+    if (json.contains("id")) {
+        request.mId = json["id"];
+    }
+
+    // Command
+    if (json.contains("command")) {
+        if (json["command"] != "shutdown") {
+            error = "Unknown command";
+            return false;
+        }
+        request.mShutdown = true;
+        return true;
+    }
+
+    // Image, from a file or inline
+    const auto hasImagePath{json.contains("image")};
+    const auto hasImageData{json.contains("imageData")};
+    if (hasImagePath == hasImageData) {
+        error = "Request must have either \"image\" or \"imageData\"";
+        return false;
+    }
+    if (hasImagePath) {
+        if (!json["image"].is_string() || json["image"].get<std::string>().empty()) {
+            error = "\"image\" must be a non-empty string";
+            return false;
+        }
+        request.mImagePath = json["image"].get<std::string>();
+    } else {
+        if (!json["imageData"].is_string()
+            || !decodeBase64(json["imageData"].get_ref<const std::string&>(), request.mImageBuffer)
+            || request.mImageBuffer.empty()) {
+            error = "\"imageData\" must be a non-empty base64 string";
+            return false;
+        }
+    }
+
+    // Options
+    if (json.contains("outputDir")) {
+        if (!json["outputDir"].is_string()) {
+            error = "\"outputDir\" must be a string";
+            return false;
+        }
+        request.mOutputDirectory = json["outputDir"].get<std::string>();
+    }
+    if (json.contains("saveImages")) {
+        if (!json["saveImages"].is_boolean()) {
+            error = "\"saveImages\" must be a boolean";
+            return false;
+        }
+        request.mSaveImages = json["saveImages"].get<bool>();
+    }
+    if (json.contains("writeFiles")) {
+        if (!json["writeFiles"].is_boolean()) {
+            error = "\"writeFiles\" must be a boolean";
+            return false;
+        }
+        request.mWriteFiles = json["writeFiles"].get<bool>();
+    }
+    if (json.contains("timeoutMs")) {
+        if (!json["timeoutMs"].is_number_unsigned()
+            || json["timeoutMs"].get<std::uint64_t>() > std::numeric_limits<unsigned int>::max()) {
+            error = "\"timeoutMs\" must be a non-negative integer";
+            return false;
+        }
+        request.mTimeoutMs = json["timeoutMs"].get<unsigned int>();
+    }
+    if (json.contains("preset")) {
+        common::Preset preset{};
+        if (!json["preset"].is_string() || !common::parsePreset(json["preset"].get<std::string>(), preset)) {
+            error = "\"preset\" must be \"fast\", \"balanced\" or \"accurate\"";
+            return false;
+        }
+        request.mPreset = preset;
+    }
+
+    return true;
+}
+
+std::string Daemon::getStatusName(const imageProcessing::ProcessingStatus status)
+{
+    switch (status) {
+    case imageProcessing::ProcessingStatus::SUCCESS:
+        return "success";
+    case imageProcessing::ProcessingStatus::CANCELLED:
+        return "cancelled";
+    case imageProcessing::ProcessingStatus::DEADLINE_EXCEEDED:
+        return "deadlineExceeded";
+    case imageProcessing::ProcessingStatus::FAILED:
+        break;
+    }
+
+    return "failed";
+}
+
+bool Daemon::decodeBase64(const std::string& text, std::vector<unsigned char>& data)
+{
+    // Value of each base64 character
+    const auto decodeChar{[](const char c) -> int {
+        if (c >= 'A' && c <= 'Z') {
+            return c - 'A';
+        }
+        if (c >= 'a' && c <= 'z') {
+            return c - 'a' + 26;
+        }
+        if (c >= '0' && c <= '9') {
+            return c - '0' + 52;
+        }
+        if (c == '+') {
+            return 62;
+        }
+        if (c == '/') {
+            return 63;
+        }
+        return -1;
+    }};
+
+    if (text.size() % 4 != 0) {
+        return false;
+    }
+
+    data.clear();
+    data.reserve(text.size() / 4 * 3);
+
+    for (std::size_t i{0}; i < text.size(); i += 4) {
+        // Padding is only allowed at the end
+        const auto isLast{i + 4 == text.size()};
+        const auto padding{isLast ? (text[i + 3] == '=') + (text[i + 2] == '=') : 0};
+        if (padding == 1 && text[i + 2] == '=') {
+            return false;
+        }
+
+        unsigned int bits{0};
+        for (std::size_t j{0}; j < 4; ++j) {
+            const auto value{j < 4U - padding ? decodeChar(text[i + j]) : 0};
+            if (value < 0) {
+                return false;
+            }
+            bits = (bits << 6) | static_cast<unsigned int>(value);
+        }
+
+        data.push_back(static_cast<unsigned char>(bits >> 16));
+        if (padding < 2) {
+            data.push_back(static_cast<unsigned char>(bits >> 8));
+        }
+        if (padding < 1) {
+            data.push_back(static_cast<unsigned char>(bits));
+        }
+    }
+
+    return true;
+}
+
+bool Daemon::writeAll(const int fd, const std::string& data)
+{
+#ifdef DAEMON_SUPPORTED
+#ifdef MSG_NOSIGNAL
+    constexpr auto flags{MSG_NOSIGNAL};
+#else
+    constexpr auto flags{0};
+#endif
+
+    std::size_t written{0};
+    while (written < data.size()) {
+        const auto bytes{send(fd, data.data() + written, data.size() - written, flags)};
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return false;
+        }
+        written += static_cast<std::size_t>(bytes);
+    }
+
+    return true;
+#else
+    static_cast<void>(fd);
+    static_cast<void>(data);
+    return false;
+#endif
+}
+
+} // namespace application
+} // namespace circuitSegmentation
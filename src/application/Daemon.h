@@ -0,0 +1,304 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "common/MemoryBudget.h"
+#include "common/Preset.h"
+#include "common/ThreadPool.h"
+#include "ImageProcManagerPool.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "logging/Logger.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace application {
+
+/**
+ * @brief Request received by the daemon.
+ */
+struct DaemonRequest
+{
+    /** ID of the request, echoed in the reply (null if not given). */
+    nlohmann::ordered_json mId{};
+    /** Flag to shut down the daemon. */
+    bool mShutdown{false};
+    /** Image file path for processing. */
+    std::string mImagePath{};
+    /** Buffer with the encoded image for processing (used when there is no image file path). */
+    std::vector<unsigned char> mImageBuffer{};
+    /** Directory where the output files are written (empty for the working directory). */
+    std::string mOutputDirectory{};
+    /** Save images obtained during the processing. */
+    bool mSaveImages{false};
+    /** Write the output files (segmentation map and images with ROI), otherwise only reply the segmentation map. */
+    bool mWriteFiles{true};
+    /** Timeout of the processing, in milliseconds (0 for no timeout). */
+    unsigned int mTimeoutMs{0};
+    /** Preset of the processing (the preset of the daemon if not given). */
+    std::optional<common::Preset> mPreset{};
+};
+
+/**
+ * @brief Connection of a client of the daemon.
+ */
+struct DaemonConnection
+{
+    /** File descriptor of the connection. */
+    int mFd{-1};
+    /** Data received after the last complete request. */
+    std::string mPending{};
+    /** Complete requests waiting to be processed, in order of arrival. */
+    std::deque<std::string> mRequests{};
+    /** Flag of a request being processed by a worker (only one at a time, so the replies are in order). */
+    bool mBusy{false};
+    /** Flag of the end of the input (closed by the client), so no more requests are read. */
+    bool mInputClosed{false};
+    /** Flag of a broken connection (e.g. a reply not written), closed without processing its requests. */
+    bool mBroken{false};
+};
+
+/**
+ * @brief Daemon that processes images requested through a Unix domain socket.
+ *
+ * The daemon keeps a pool of image processing managers, so the libraries, pipelines and threads are already warm when
+ * a request arrives. The connections are multiplexed by the thread running the daemon, which reads them without
+ * blocking and dispatches only the complete requests to the worker threads, so idle connections do not hold workers.
+ * The requests of a connection are processed one at a time, in order, each one by an idle manager.
+ *
+ * The socket is created with permissions for its owner only. A socket of the same path accepting connections belongs
+ * to a running daemon, so the daemon does not start; a stale socket left by a stopped daemon is replaced.
+ *
+ * The requests and replies are JSON objects, one per line:
+ * - Request: `{"id": <any>, "image": "<path>" | "imageData": "<base64>", "outputDir": "<path>", "saveImages": <bool>,
+ *   "writeFiles": <bool>, "timeoutMs": <number>, "preset": "fast" | "balanced" | "accurate"}`
+ * - Reply: `{"id": <any>, "success": <bool>, "status": "<status>", "timeMs": <number>, "segmentationMap": {...}}`,
+ *   or with `"error"` instead of the segmentation map when the request fails. The status is `success`, `failed`,
+ *   `cancelled` or `deadlineExceeded` (the processing stopped when its timeout expired).
+ * - The request `{"command": "shutdown"}` stops the daemon, after the requests being processed are replied.
+ *
+ * With a budget of memory, each request is admitted only while the estimated peak memory of the requests being
+ * processed stays under the budget (see common::MemoryBudget). The estimate is computed from the dimensions in the
+ * header of the image, before it is decoded. A request larger than the budget is processed alone, in low-memory mode.
+ *
+ * Unix domain sockets are only supported on POSIX systems.
+ */
+class Daemon
+{
+public:
+    /** Maximum size of a request, in bytes (the inline images are encoded in base64). */
+    static constexpr std::size_t cMaxRequestSize{64 * 1024 * 1024};
+    /** Interval to check if the daemon was stopped while waiting for connections, in milliseconds. */
+    static constexpr int cPollIntervalMs{200};
+    /** Maximum number of pending connections. */
+    static constexpr int cBacklog{64};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param socketPath Path of the Unix domain socket.
+     * @param imageProcManagers Image processing managers, one for each worker.
+     * @param logger Logger.
+     * @param memoryBudget Budget of memory of the requests processed concurrently, in bytes (0 for no budget).
+     * @param workerStart Function called by each worker thread when it starts (e.g. to pin it to a core).
+     */
+    explicit Daemon(const std::string& socketPath,
+                    std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers,
+                    const std::shared_ptr<logging::Logger>& logger,
+                    const std::size_t memoryBudget = 0,
+                    const common::ThreadPool::ThreadStart& workerStart = {});
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Daemon() = default;
+
+    /**
+     * @brief Runs the daemon, serving the requests until it is stopped.
+     *
+     * @return True if the daemon ran and stopped successfully, otherwise false (e.g. the socket cannot be created).
+     */
+    virtual bool run();
+
+    /**
+     * @brief Stops the daemon, after the requests being processed are replied (the idle connections are closed).
+     *
+     * It only sets a flag and wakes the daemon, so it can be called from any thread or from a signal handler.
+     */
+    virtual void stop();
+
+    /**
+     * @brief Gets the number of workers.
+     *
+     * @return Number of workers.
+     */
+    [[nodiscard]] virtual unsigned int getNumWorkers() const;
+
+    /**
+     * @brief Gets the path of the Unix domain socket.
+     *
+     * @return Path of the socket.
+     */
+    [[nodiscard]] virtual std::string getSocketPath() const;
+
+    /**
+     * @brief Gets the budget of memory of the requests processed concurrently.
+     *
+     * @return Budget of memory, in bytes (0 for no budget).
+     */
+    [[nodiscard]] virtual std::size_t getMemoryBudget() const;
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Binds the socket, checking that no daemon is running on its path.
+     *
+     * @param listenFd File descriptor of the socket.
+     *
+     * @return True if the socket is bound, otherwise false (e.g. a daemon is already running, or the path exists and
+     * is not a socket).
+     */
+    virtual bool bindSocket(const int listenFd);
+
+    /**
+     * @brief Reads the data available on a connection, queuing its complete requests.
+     *
+     * @param connection Connection, with data to read.
+     */
+    virtual void readConnection(DaemonConnection& connection);
+
+    /**
+     * @brief Dispatches the next request of each idle connection to the worker threads, and closes the connections
+     * that are done. It must be called with the mutex locked.
+     */
+    virtual void dispatchRequests();
+
+    /**
+     * @brief Serves a request of a connection in a worker thread, replying it.
+     *
+     * @param connection Connection.
+     * @param line Request, in JSON.
+     */
+    virtual void serveRequest(DaemonConnection& connection, const std::string& line);
+
+    /**
+     * @brief Wakes the thread multiplexing the connections (e.g. when a request is replied).
+     */
+    virtual void wake();
+
+    /**
+     * @brief Handles a request.
+     *
+     * @param line Request, in JSON.
+     *
+     * @return Reply, in JSON.
+     */
+    virtual std::string handleRequest(const std::string& line);
+
+    /**
+     * @brief Processes the image of a request.
+     *
+     * @param request Request.
+     * @param reply Reply, where the result is added.
+     */
+    virtual void processRequest(DaemonRequest& request, nlohmann::ordered_json& reply);
+
+    /**
+     * @brief Reserves the estimated peak memory of a request, waiting until it is admitted by the budget of memory.
+     *
+     * If the request does not fit in the budget, it is estimated again in low-memory mode, and it is admitted alone if
+     * it is still larger than the budget. A request whose image dimensions cannot be read is admitted alone, in
+     * low-memory mode.
+     *
+     * @param request Request.
+     * @param lowMemoryMode Flag set when the request must be processed in low-memory mode.
+     *
+     * @return Reservation, empty without budget of memory.
+     */
+    virtual common::MemoryBudget::Reservation reserveMemory(const DaemonRequest& request, bool& lowMemoryMode);
+
+    /**
+     * @brief Parses a request.
+     *
+     * @param line Request, in JSON.
+     * @param request Request parsed.
+     * @param error Error message, when the request is invalid.
+     *
+     * @return True if the request is valid, otherwise false.
+     */
+    static bool parseRequest(const std::string& line, DaemonRequest& request, std::string& error);
+
+    /**
+     * @brief Gets the name of a processing status, given in the replies.
+     *
+     * @param status Processing status.
+     *
+     * @return Name of the processing status.
+     */
+    static std::string getStatusName(const imageProcessing::ProcessingStatus status);
+
+    /**
+     * @brief Decodes a text in base64.
+     *
+     * @param text Text in base64, with padding.
+     * @param data Data decoded.
+     *
+     * @return True if the text is valid base64, otherwise false.
+     */
+    static bool decodeBase64(const std::string& text, std::vector<unsigned char>& data);
+
+    /**
+     * @brief Writes all the data to a connection.
+     *
+     * @param fd File descriptor of the connection.
+     * @param data Data.
+     *
+     * @return True if all the data was written, otherwise false.
+     */
+    static bool writeAll(const int fd, const std::string& data);
+
+private:
+    /** Path of the Unix domain socket. */
+    std::string mSocketPath;
+
+    /** Number of workers. */
+    unsigned int mNumWorkers;
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+
+    /** Flag to stop the daemon. */
+    std::atomic<bool> mStop{false};
+
+    /** Budget of memory of the requests processed concurrently. */
+    common::MemoryBudget mMemoryBudget;
+
+    /** Pool of image processing managers. */
+    ImageProcManagerPool mManagerPool;
+
+    /** Mutex for the open connections. */
+    std::mutex mMutex;
+
+    /** Open connections, by file descriptor. */
+    std::map<int, DaemonConnection> mConnections{};
+
+    /** File descriptor to wake the thread multiplexing the connections (-1 when the daemon is not running). */
+    std::atomic<int> mWakeFd{-1};
+
+    /** Pool of worker threads serving the requests. It is declared last, so it is the first member destroyed. */
+    common::ThreadPool mThreadPool;
+};
+
+} // namespace application
+} // namespace circuitSegmentation
@@ -0,0 +1,278 @@
+/**
+ * @file
+ */
+
+#include "FolderWatcher.h"
+#include "imageProcessing/ImageHeader.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#ifdef __linux__
+#define FOLDER_WATCHER_SUPPORTED
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace circuitSegmentation {
+namespace application {
+
+FolderWatcher::FolderWatcher(const std::string& spoolDirectory,
+                             std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers,
+                             const std::shared_ptr<logging::Logger>& logger,
+                             const std::size_t memoryBudget,
+                             const common::ThreadPool::ThreadStart& workerStart)
+    : mSpoolDirectory{spoolDirectory}
+    , mNumWorkers{static_cast<unsigned int>(std::max<std::size_t>(imageProcManagers.size(), 1))}
+    , mLogger{logger}
+    , mMemoryBudget{memoryBudget}
+    , mManagerPool{std::move(imageProcManagers)}
+    , mThreadPool{mNumWorkers, workerStart}
+{
+}
+
+bool FolderWatcher::run()
+{
+#ifdef FOLDER_WATCHER_SUPPORTED
+    if (mSpoolDirectory.empty() || !std::filesystem::is_directory(mSpoolDirectory)) {
+        mLogger->logError("Invalid spool folder: {}", mSpoolDirectory.string());
+        return false;
+    }
+    if (!createDirectories()) {
+        return false;
+    }
+
+    // Watch the files completely written or moved into the spool folder
+    const auto inotifyFd{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)};
+    if (inotifyFd < 0) {
+        mLogger->logError("Failed to initialize inotify: {}", std::strerror(errno));
+        return false;
+    }
+    if (inotify_add_watch(inotifyFd, mSpoolDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR) < 0) {
+        mLogger->logError("Failed to watch folder {}: {}", mSpoolDirectory.string(), std::strerror(errno));
+        close(inotifyFd);
+        return false;
+    }
+
+    mLogger->logInfo("Watching folder {} with {} workers", mSpoolDirectory.string(), mNumWorkers);
+
+    // Files already in the spool folder (after the watch is added, so no file is missed)
+    submitSpoolFiles();
+
+    // Files arriving until stopped
+    alignas(inotify_event) std::array<char, 64 * 1024> buffer{};
+    while (!mStop) {
+        pollfd inotifyPoll{inotifyFd, POLLIN, 0};
+        if (poll(&inotifyPoll, 1, cPollIntervalMs) <= 0) {
+            continue;
+        }
+
+        const auto bytesRead{read(inotifyFd, buffer.data(), buffer.size())};
+        if (bytesRead <= 0) {
+            continue;
+        }
+
+        for (auto offset{0L}; offset < bytesRead;) {
+            const auto* event{reinterpret_cast<const inotify_event*>(buffer.data() + offset)};
+            offset += static_cast<long>(sizeof(inotify_event) + event->len);
+
+            // Events lost: the files arrived meanwhile are found by scanning the folder again
+            if (event->mask & IN_Q_OVERFLOW) {
+                mLogger->logWarning("Events of folder {} lost, scanning it again", mSpoolDirectory.string());
+                submitSpoolFiles();
+            }
+            if (event->len > 0 && !(event->mask & IN_ISDIR)) {
+                submitFile(event->name);
+            }
+        }
+    }
+
+    close(inotifyFd);
+
+    // Wait for the images being processed
+    mThreadPool.waitIdle();
+
+    mLogger->logInfo("Watcher of folder {} stopped", mSpoolDirectory.string());
+
+    return true;
+#else
+    mLogger->logError("Watch mode is not supported on this platform");
+    return false;
+#endif
+}
+
+void FolderWatcher::stop()
+{
+    mStop = true;
+}
+
+unsigned int FolderWatcher::getNumWorkers() const
+{
+    return mNumWorkers;
+}
+
+std::string FolderWatcher::getSpoolDirectory() const
+{
+    return mSpoolDirectory.string();
+}
+
+std::size_t FolderWatcher::getMemoryBudget() const
+{
+    return mMemoryBudget.getBudget();
+}
+
+bool FolderWatcher::createDirectories()
+{
+    for (const auto* directory : {cDoneDirectory, cFailedDirectory, cOutputDirectory}) {
+        std::error_code ec{};
+        std::filesystem::create_directories(mSpoolDirectory / directory, ec);
+        if (ec) {
+            mLogger->logError("Failed to create folder {}: {}", (mSpoolDirectory / directory).string(), ec.message());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FolderWatcher::submitFile(const std::string& fileName)
+{
+    if (!isCandidateFile(fileName)) {
+        return;
+    }
+
+    // A file notified again while it is waiting or being processed is processed once
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        if (!mFilesInFlight.insert(fileName).second) {
+            return;
+        }
+    }
+
+    mThreadPool.submit([this, fileName]() {
+        processFile(fileName);
+
+        std::lock_guard<std::mutex> lock{mMutex};
+        mFilesInFlight.erase(fileName);
+    });
+}
+
+void FolderWatcher::submitSpoolFiles()
+{
+    std::error_code ec{};
+    for (const auto& entry : std::filesystem::directory_iterator{mSpoolDirectory, ec}) {
+        if (entry.is_regular_file(ec)) {
+            submitFile(entry.path().filename().string());
+        }
+    }
+}
+
+bool FolderWatcher::processFile(const std::string& fileName)
+{
+    const auto filePath{mSpoolDirectory / fileName};
+
+    // The file may have been removed or already processed after it was notified
+    std::error_code ec{};
+    if (!std::filesystem::is_regular_file(filePath, ec)) {
+        return false;
+    }
+
+    // Output folder of this image
+    const auto outputDirectory{mSpoolDirectory / cOutputDirectory / filePath.stem()};
+    std::filesystem::create_directories(outputDirectory, ec);
+    if (ec) {
+        mLogger->logError("Failed to create folder {}: {}", outputDirectory.string(), ec.message());
+    }
+
+    // Process image with an idle manager, once the image fits in the budget of memory
+    auto success{false};
+    if (!ec) {
+        auto imageProcManager{mManagerPool.acquire()};
+        auto lowMemoryMode{false};
+        auto reservation{reserveMemory(filePath, imageProcManager->getSaveImages(), lowMemoryMode)};
+        imageProcManager->setLowMemoryMode(lowMemoryMode);
+        imageProcManager->setOutputDirectory(outputDirectory.string());
+        success = imageProcManager->processImage(filePath.string());
+        imageProcManager->setLowMemoryMode(false);
+        reservation.release();
+        mManagerPool.release(std::move(imageProcManager));
+    }
+
+    // Move image to the done or failed folder
+    const auto movedPath{moveFile(filePath, mSpoolDirectory / (success ? cDoneDirectory : cFailedDirectory))};
+    if (movedPath.empty()) {
+        mLogger->logError("Failed to move image {}", filePath.string());
+    } else {
+        mLogger->logInfo("Image {} processed {}successfully", movedPath.string(), success ? "" : "un");
+    }
+
+    return success;
+}
+
+common::MemoryBudget::Reservation
+FolderWatcher::reserveMemory(const std::filesystem::path& filePath, const bool saveImages, bool& lowMemoryMode)
+{
+    lowMemoryMode = false;
+    if (mMemoryBudget.getBudget() == 0) {
+        return {};
+    }
+
+    // Dimensions from the header of the image, before it is decoded
+    imageProcessing::ImageDimensions dimensions{};
+    if (!imageProcessing::ImageHeader::readFileDimensions(filePath.string(), dimensions)) {
+        mLogger->logWarning("Image {} dimensions unknown: admitted alone, in low-memory mode", filePath.string());
+        lowMemoryMode = true;
+        return mMemoryBudget.reserve(mMemoryBudget.getBudget() + 1);
+    }
+
+    // Estimate, without saving images if it does not fit in the budget
+    auto peakMemory{imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, saveImages)};
+    if (mMemoryBudget.isOversized(peakMemory)) {
+        lowMemoryMode = true;
+        peakMemory = imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, false);
+    }
+
+    auto reservation{mMemoryBudget.reserve(peakMemory)};
+    mLogger->logInfo("Image {} of {}x{} pixels admitted with {} bytes of {} bytes{}{}",
+                     filePath.string(),
+                     dimensions.mWidth,
+                     dimensions.mHeight,
+                     peakMemory,
+                     mMemoryBudget.getBudget(),
+                     lowMemoryMode ? ", in low-memory mode" : "",
+                     reservation.isOversized() ? ", alone" : "");
+
+    return reservation;
+}
+
+bool FolderWatcher::isCandidateFile(const std::string& fileName)
+{
+    return !fileName.empty() && fileName.front() != '.';
+}
+
+std::filesystem::path FolderWatcher::moveFile(const std::filesystem::path& filePath,
+                                              const std::filesystem::path& directory)
+{
+    // Name not used yet in the destination folder
+    auto destinationPath{directory / filePath.filename()};
+    for (unsigned int suffix{1}; std::filesystem::exists(destinationPath); ++suffix) {
+        destinationPath = directory
+                          / (filePath.stem().string() + "_" + std::to_string(suffix) + filePath.extension().string());
+    }
+
+    // Rename within the same file system, so the file is never seen partially moved
+    std::error_code ec{};
+    std::filesystem::rename(filePath, destinationPath, ec);
+    if (ec) {
+        return {};
+    }
+
+    return destinationPath;
+}
+
+} // namespace application
+} // namespace circuitSegmentation
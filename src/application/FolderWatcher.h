@@ -0,0 +1,204 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "common/MemoryBudget.h"
+#include "common/ThreadPool.h"
+#include "ImageProcManagerPool.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "logging/Logger.h"
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace application {
+
+/**
+ * @brief Watcher of a spool folder that processes the images as soon as they arrive.
+ *
+ * The watcher is notified by inotify when a file is completely written (closed after writing) or moved into the spool
+ * folder, so each image is processed immediately by an idle manager of a warm pool. The images already in the folder
+ * when the watcher starts are also processed.
+ *
+ * After processing, each image is moved to the `done` or `failed` subfolder, and its output files are written to the
+ * `output/<image_name>` subfolder. The moves are renames within the spool folder, so they are atomic. Hidden files
+ * (starting with '.') are ignored, so the producers can write them and then rename them into the folder.
+ *
+ * With a budget of memory, each image is admitted only while the estimated peak memory of the images being processed
+ * stays under the budget, as in the daemon. An image larger than the budget is processed alone, in low-memory mode.
+ *
+ * inotify is only supported on Linux.
+ */
+class FolderWatcher
+{
+public:
+    /** Subfolder for the images processed successfully. */
+    static constexpr auto cDoneDirectory{"done"};
+    /** Subfolder for the images processed unsuccessfully. */
+    static constexpr auto cFailedDirectory{"failed"};
+    /** Subfolder for the output files, with a folder for each image. */
+    static constexpr auto cOutputDirectory{"output"};
+    /** Interval to check if the watcher was stopped while waiting for files, in milliseconds. */
+    static constexpr int cPollIntervalMs{200};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param spoolDirectory Path of the spool folder.
+     * @param imageProcManagers Image processing managers, one for each worker.
+     * @param logger Logger.
+     * @param memoryBudget Budget of memory of the images processed concurrently, in bytes (0 for no budget).
+     * @param workerStart Function called by each worker thread when it starts (e.g. to pin it to a core).
+     */
+    explicit FolderWatcher(const std::string& spoolDirectory,
+                           std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers,
+                           const std::shared_ptr<logging::Logger>& logger,
+                           const std::size_t memoryBudget = 0,
+                           const common::ThreadPool::ThreadStart& workerStart = {});
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~FolderWatcher() = default;
+
+    /**
+     * @brief Runs the watcher, processing the images arriving until it is stopped.
+     *
+     * @return True if the watcher ran and stopped successfully, otherwise false (e.g. the folder cannot be watched).
+     */
+    virtual bool run();
+
+    /**
+     * @brief Stops the watcher, after the images being processed.
+     *
+     * It only sets a flag, so it can be called from any thread or from a signal handler.
+     */
+    virtual void stop();
+
+    /**
+     * @brief Gets the number of workers.
+     *
+     * @return Number of workers.
+     */
+    [[nodiscard]] virtual unsigned int getNumWorkers() const;
+
+    /**
+     * @brief Gets the path of the spool folder.
+     *
+     * @return Path of the spool folder.
+     */
+    [[nodiscard]] virtual std::string getSpoolDirectory() const;
+
+    /**
+     * @brief Gets the budget of memory of the images processed concurrently.
+     *
+     * @return Budget of memory, in bytes (0 for no budget).
+     */
+    [[nodiscard]] virtual std::size_t getMemoryBudget() const;
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Creates the subfolders of the spool folder.
+     *
+     * @return True if the subfolders exist, otherwise false.
+     */
+    virtual bool createDirectories();
+
+    /**
+     * @brief Submits the processing of a file, unless it is not a candidate or it is already being processed.
+     *
+     * @param fileName File name, in the spool folder.
+     */
+    virtual void submitFile(const std::string& fileName);
+
+    /**
+     * @brief Submits the processing of the files in the spool folder (at startup, or when events of the folder are
+     * lost).
+     */
+    virtual void submitSpoolFiles();
+
+    /**
+     * @brief Processes a file and moves it to the done or failed subfolder.
+     *
+     * @param fileName File name, in the spool folder.
+     *
+     * @return True if the image was processed successfully, otherwise false.
+     */
+    virtual bool processFile(const std::string& fileName);
+
+    /**
+     * @brief Reserves the estimated peak memory of an image, waiting until it is admitted by the budget of memory.
+     *
+     * If the image does not fit in the budget, it is estimated again in low-memory mode, and it is admitted alone if it
+     * is still larger than the budget. An image whose dimensions cannot be read is admitted alone, in low-memory mode.
+     *
+     * @param filePath Image file path.
+     * @param saveImages Save images obtained during the processing.
+     * @param lowMemoryMode Flag set when the image must be processed in low-memory mode.
+     *
+     * @return Reservation, empty without budget of memory.
+     */
+    virtual common::MemoryBudget::Reservation
+    reserveMemory(const std::filesystem::path& filePath, const bool saveImages, bool& lowMemoryMode);
+
+    /**
+     * @brief Checks if a file is a candidate for processing (it is not hidden).
+     *
+     * @param fileName File name.
+     *
+     * @return True if the file is a candidate, otherwise false.
+     */
+    static bool isCandidateFile(const std::string& fileName);
+
+    /**
+     * @brief Moves a file to a folder atomically, adding a suffix to the name if a file with it already exists there.
+     *
+     * @param filePath File path.
+     * @param directory Destination folder, in the same file system.
+     *
+     * @return Path of the file moved, or an empty path on failure.
+     */
+    static std::filesystem::path moveFile(const std::filesystem::path& filePath,
+                                          const std::filesystem::path& directory);
+
+private:
+    /** Path of the spool folder. */
+    std::filesystem::path mSpoolDirectory;
+
+    /** Number of workers. */
+    unsigned int mNumWorkers;
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+
+    /** Flag to stop the watcher. */
+    std::atomic<bool> mStop{false};
+
+    /** Budget of memory of the images processed concurrently. */
+    common::MemoryBudget mMemoryBudget;
+
+    /** Pool of image processing managers. */
+    ImageProcManagerPool mManagerPool;
+
+    /** Mutex for the files being processed. */
+    std::mutex mMutex;
+
+    /** Names of the files submitted and not processed yet, so a file notified twice is processed once. */
+    std::set<std::string> mFilesInFlight{};
+
+    /** Pool of worker threads processing the files. It is declared last, so it is the first member destroyed. */
+    common::ThreadPool mThreadPool;
+};
+
+} // namespace application
+} // namespace circuitSegmentation
@@ -0,0 +1,107 @@
+/**
+ * @file
+ */
+
+#include "ImageProcManagerPool.h"
+#include <utility>
+
+namespace circuitSegmentation {
+namespace application {
+
+ImageProcManagerPool::ImageProcManagerPool(
+    std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers)
+    : mSize{imageProcManagers.size()}
+    , mIdleManagers{std::move(imageProcManagers)}
+{
+}
+
+std::unique_ptr<imageProcessing::ImageProcManager> ImageProcManagerPool::acquire()
+{
+    std::unique_lock<std::mutex> lock{mMutex};
+    mManagerIdle.wait(lock, [this]() { return !mIdleManagers.empty(); });
+
+    auto imageProcManager{std::move(mIdleManagers.back())};
+    mIdleManagers.pop_back();
+
+    return imageProcManager;
+}
+
+#ifdef COROUTINES_SUPPORTED
+ImageProcManagerPool::AcquireAwaiter ImageProcManagerPool::acquireAsync(common::Executor& executor)
+{
+    return AcquireAwaiter{*this, executor};
+}
+
+ImageProcManagerPool::AcquireAwaiter::AcquireAwaiter(ImageProcManagerPool& pool, common::Executor& executor)
+    : mPool{pool}
+    , mExecutor{executor}
+{
+}
+
+bool ImageProcManagerPool::AcquireAwaiter::await_ready()
+{
+    std::lock_guard<std::mutex> lock{mPool.mMutex};
+    if (mPool.mIdleManagers.empty()) {
+        return false;
+    }
+
+    mImageProcManager = std::move(mPool.mIdleManagers.back());
+    mPool.mIdleManagers.pop_back();
+
+    return true;
+}
+
+bool ImageProcManagerPool::AcquireAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    std::lock_guard<std::mutex> lock{mPool.mMutex};
+
+    // A manager may have been released since it was checked
+    if (!mPool.mIdleManagers.empty()) {
+        mImageProcManager = std::move(mPool.mIdleManagers.back());
+        mPool.mIdleManagers.pop_back();
+        return false;
+    }
+
+    mHandle = handle;
+    mPool.mWaitingCoroutines.push_back(this);
+
+    return true;
+}
+
+std::unique_ptr<imageProcessing::ImageProcManager> ImageProcManagerPool::AcquireAwaiter::await_resume()
+{
+    return std::move(mImageProcManager);
+}
+#endif
+
+void ImageProcManagerPool::release(std::unique_ptr<imageProcessing::ImageProcManager> imageProcManager)
+{
+    {
+        std::unique_lock<std::mutex> lock{mMutex};
+
+#ifdef COROUTINES_SUPPORTED
+        // Hand the manager over to the first coroutine waiting, resumed on its executor
+        if (!mWaitingCoroutines.empty()) {
+            auto* awaiter{mWaitingCoroutines.front()};
+            mWaitingCoroutines.pop_front();
+            awaiter->mImageProcManager = std::move(imageProcManager);
+            lock.unlock();
+
+            const auto handle{awaiter->mHandle};
+            awaiter->mExecutor.execute([handle]() { handle.resume(); });
+            return;
+        }
+#endif
+
+        mIdleManagers.push_back(std::move(imageProcManager));
+    }
+    mManagerIdle.notify_one();
+}
+
+std::size_t ImageProcManagerPool::getSize() const
+{
+    return mSize;
+}
+
+} // namespace application
+} // namespace circuitSegmentation
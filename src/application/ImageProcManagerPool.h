@@ -0,0 +1,132 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "common/Executor.h"
+#include "common/Task.h"
+#include "imageProcessing/ImageProcManager.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace application {
+
+/**
+ * @brief Pool of warm image processing managers, shared by the workers of a long-running mode (e.g. the daemon).
+ *
+ * Each manager processes one image at a time, so a worker acquires an idle manager before processing and releases it
+ * afterwards. The coroutines of the asynchronous processing acquire a manager without blocking a thread: they are
+ * suspended while all managers are in use, and resumed on their executor when one is released.
+ */
+class ImageProcManagerPool
+{
+public:
+#ifdef COROUTINES_SUPPORTED
+    /**
+     * @brief Awaitable of the acquisition of an image processing manager.
+     */
+    class AcquireAwaiter
+    {
+    public:
+        /**
+         * @brief Constructor.
+         *
+         * @param pool Pool of image processing managers.
+         * @param executor Executor where the awaiting coroutine is resumed, if it waits for a manager.
+         */
+        AcquireAwaiter(ImageProcManagerPool& pool, common::Executor& executor);
+
+        bool await_ready();
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        std::unique_ptr<imageProcessing::ImageProcManager> await_resume();
+
+    private:
+        friend class ImageProcManagerPool;
+
+        /** Pool of image processing managers. */
+        ImageProcManagerPool& mPool;
+        /** Executor where the awaiting coroutine is resumed. */
+        common::Executor& mExecutor;
+        /** Handle of the awaiting coroutine. */
+        std::coroutine_handle<> mHandle{};
+        /** Image processing manager acquired. */
+        std::unique_ptr<imageProcessing::ImageProcManager> mImageProcManager{};
+    };
+#endif
+
+    /**
+     * @brief Constructor.
+     *
+     * @param imageProcManagers Image processing managers.
+     */
+    explicit ImageProcManagerPool(std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~ImageProcManagerPool() = default;
+
+    /**
+     * @brief Acquires an idle image processing manager, waiting until one is available.
+     *
+     * @return Image processing manager.
+     */
+    virtual std::unique_ptr<imageProcessing::ImageProcManager> acquire();
+
+#ifdef COROUTINES_SUPPORTED
+    /**
+     * @brief Acquires an idle image processing manager asynchronously (co_await).
+     *
+     * If all managers are in use, the awaiting coroutine is suspended until one is released, and then resumed on the
+     * executor. The coroutines waiting are served in order, before the threads waiting in @ref acquire.
+     *
+     * @param executor Executor where the awaiting coroutine is resumed, if it waits for a manager.
+     *
+     * @return Awaitable with the image processing manager.
+     */
+    virtual AcquireAwaiter acquireAsync(common::Executor& executor);
+#endif
+
+    /**
+     * @brief Releases an image processing manager, so it is available for other workers.
+     *
+     * @param imageProcManager Image processing manager.
+     */
+    virtual void release(std::unique_ptr<imageProcessing::ImageProcManager> imageProcManager);
+
+    /**
+     * @brief Gets the number of image processing managers in the pool.
+     *
+     * @return Number of image processing managers.
+     */
+    [[nodiscard]] virtual std::size_t getSize() const;
+
+private:
+    /** Number of image processing managers in the pool. */
+    const std::size_t mSize;
+
+    /** Mutex for the idle managers. */
+    std::mutex mMutex;
+
+    /** Condition signaled when a manager becomes idle. */
+    std::condition_variable mManagerIdle;
+
+    /** Idle image processing managers. */
+    std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> mIdleManagers;
+
+#ifdef COROUTINES_SUPPORTED
+    /** Coroutines waiting for a manager, in order of arrival. */
+    std::deque<AcquireAwaiter*> mWaitingCoroutines{};
+#endif
+};
+
+} // namespace application
+} // namespace circuitSegmentation
@@ -0,0 +1,112 @@
+/**
+ * @file
+ */
+
+#include "SharedMemoryIntake.h"
+#include "imageProcessing/ImageHeader.h"
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace circuitSegmentation {
+namespace application {
+
+SharedMemoryIntake::SharedMemoryIntake(
+    const std::string& ringName,
+    std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers,
+    const std::shared_ptr<logging::Logger>& logger,
+    const std::size_t memoryBudget,
+    const common::ThreadPool::ThreadStart& workerStart)
+    : mRingName{ringName}
+    , mNumWorkers{static_cast<unsigned int>(std::max<std::size_t>(imageProcManagers.size(), 1))}
+    , mLogger{logger}
+    , mRing{logger}
+    , mMemoryBudget{memoryBudget}
+    , mManagerPool{std::move(imageProcManagers)}
+    , mThreadPool{mNumWorkers, workerStart}
+{
+}
+
+bool SharedMemoryIntake::run()
+{
+    if (!mRing.open(mRingName)) {
+        return false;
+    }
+
+    mLogger->logInfo("Reading frames of shared memory ring {} ({} slots of {} bytes) with {} workers",
+                     mRingName,
+                     mRing.getNumSlots(),
+                     mRing.getSlotSize(),
+                     mNumWorkers);
+
+    // Frames published until stopped
+    while (!mStop) {
+        SharedMemoryFrame frame{};
+        if (!mRing.acquireFrame(cPollIntervalMs, frame)) {
+            continue;
+        }
+
+        mThreadPool.submit([this, frame]() { processFrame(frame); });
+    }
+
+    // Wait for the frames being processed, before the ring is unmapped
+    mThreadPool.waitIdle();
+    mRing.close();
+
+    mLogger->logInfo("Intake of shared memory ring {} stopped", mRingName);
+
+    return true;
+}
+
+void SharedMemoryIntake::stop()
+{
+    mStop = true;
+}
+
+unsigned int SharedMemoryIntake::getNumWorkers() const
+{
+    return mNumWorkers;
+}
+
+std::string SharedMemoryIntake::getRingName() const
+{
+    return mRingName;
+}
+
+bool SharedMemoryIntake::processFrame(const SharedMemoryFrame& frame)
+{
+    // Output folder of this frame
+    const auto outputDirectory{std::filesystem::path{cOutputDirectory} / std::to_string(frame.mSequence)};
+    std::error_code ec{};
+    std::filesystem::create_directories(outputDirectory, ec);
+    if (ec) {
+        mLogger->logError("Failed to create folder {}: {}", outputDirectory.string(), ec.message());
+        mRing.releaseFrame(frame.mSlot);
+        return false;
+    }
+
+    // Process frame with an idle manager, once the frame fits in the budget of memory
+    auto imageProcManager{mManagerPool.acquire()};
+    common::MemoryBudget::Reservation reservation{};
+    if (mMemoryBudget.getBudget() > 0) {
+        const imageProcessing::ImageDimensions dimensions{frame.mImageBuffer.mWidth, frame.mImageBuffer.mHeight};
+        reservation = mMemoryBudget.reserve(
+            imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, imageProcManager->getSaveImages()));
+    }
+    imageProcManager->setOutputDirectory(outputDirectory.string());
+
+    // The slot is released by the manager as soon as the pixels are no longer read
+    const auto slot{frame.mSlot};
+    const auto success{
+        imageProcManager->processRawImageBuffer(frame.mImageBuffer, [this, slot]() { mRing.releaseFrame(slot); })};
+    reservation.release();
+    mManagerPool.release(std::move(imageProcManager));
+
+    mLogger->logInfo("Frame {} processed {}successfully", frame.mSequence, success ? "" : "un");
+
+    return success;
+}
+
+} // namespace application
+} // namespace circuitSegmentation
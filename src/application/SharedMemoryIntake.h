@@ -0,0 +1,131 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "common/MemoryBudget.h"
+#include "common/ThreadPool.h"
+#include "ImageProcManagerPool.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "logging/Logger.h"
+#include "SharedMemoryRing.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace application {
+
+/**
+ * @brief Intake of raw frames placed by a producer in a shared-memory ring, processed without copying.
+ *
+ * The producer creates the ring (see @ref SharedMemoryRing) and the intake opens it, so each frame published is
+ * processed by an idle manager of a warm pool, in order of sequence number. The pixels are wrapped in place, and the
+ * slot of each frame is released back to the producer as soon as the processing no longer reads it (see
+ * @ref imageProcessing::ImageProcManager::processRawImageBuffer), before the segmentation map is written.
+ *
+ * The output files of each frame are written to the `frames/<sequence>` folder of the working directory. With a
+ * budget of memory, each frame is admitted only while the estimated peak memory of the frames being processed stays
+ * under the budget, as in the daemon.
+ *
+ * POSIX shared memory is only supported on Linux.
+ */
+class SharedMemoryIntake
+{
+public:
+    /** Folder for the output files, with a folder for each frame. */
+    static constexpr auto cOutputDirectory{"frames"};
+    /** Interval to check if the intake was stopped while waiting for frames, in milliseconds. */
+    static constexpr int cPollIntervalMs{200};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param ringName Name of the shared memory object of the ring, created by the producer.
+     * @param imageProcManagers Image processing managers, one for each worker.
+     * @param logger Logger.
+     * @param memoryBudget Budget of memory of the frames processed concurrently, in bytes (0 for no budget).
+     * @param workerStart Function called by each worker thread when it starts (e.g. to pin it to a core).
+     */
+    explicit SharedMemoryIntake(const std::string& ringName,
+                                std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers,
+                                const std::shared_ptr<logging::Logger>& logger,
+                                const std::size_t memoryBudget = 0,
+                                const common::ThreadPool::ThreadStart& workerStart = {});
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~SharedMemoryIntake() = default;
+
+    /**
+     * @brief Runs the intake, processing the frames published until it is stopped.
+     *
+     * @return True if the intake ran and stopped successfully, otherwise false (e.g. the ring cannot be opened).
+     */
+    virtual bool run();
+
+    /**
+     * @brief Stops the intake, after the frames being processed.
+     *
+     * It only sets a flag, so it can be called from any thread or from a signal handler.
+     */
+    virtual void stop();
+
+    /**
+     * @brief Gets the number of workers.
+     *
+     * @return Number of workers.
+     */
+    [[nodiscard]] virtual unsigned int getNumWorkers() const;
+
+    /**
+     * @brief Gets the name of the ring.
+     *
+     * @return Name of the shared memory object of the ring.
+     */
+    [[nodiscard]] virtual std::string getRingName() const;
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Processes a frame and releases its slot.
+     *
+     * @param frame Frame acquired from the ring.
+     *
+     * @return True if the frame was processed successfully, otherwise false.
+     */
+    virtual bool processFrame(const SharedMemoryFrame& frame);
+
+private:
+    /** Name of the shared memory object of the ring. */
+    std::string mRingName;
+
+    /** Number of workers. */
+    unsigned int mNumWorkers;
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+
+    /** Flag to stop the intake. */
+    std::atomic<bool> mStop{false};
+
+    /** Ring of frames. */
+    SharedMemoryRing mRing;
+
+    /** Budget of memory of the frames processed concurrently. */
+    common::MemoryBudget mMemoryBudget;
+
+    /** Pool of image processing managers. */
+    ImageProcManagerPool mManagerPool;
+
+    /** Pool of worker threads processing the frames. It is declared last, so it is the first member destroyed. */
+    common::ThreadPool mThreadPool;
+};
+
+} // namespace application
+} // namespace circuitSegmentation
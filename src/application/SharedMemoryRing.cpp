@@ -0,0 +1,527 @@
+/**
+ * @file
+ */
+
+#include "SharedMemoryRing.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <limits>
+
+#ifdef __linux__
+#define SHARED_MEMORY_SUPPORTED
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace circuitSegmentation {
+namespace application {
+
+#ifdef SHARED_MEMORY_SUPPORTED
+namespace {
+
+/**
+ * @brief Header of the ring, at the start of the shared memory.
+ */
+struct RingHeader
+{
+    /** Magic number. */
+    std::uint32_t mMagic;
+    /** Version of the layout. */
+    std::uint32_t mVersion;
+    /** Number of slots. */
+    std::uint32_t mNumSlots;
+    /** Reserved. */
+    std::uint32_t mReserved;
+    /** Size of the pixels of each slot, in bytes. */
+    std::uint64_t mSlotSize;
+    /** Number of free slots. */
+    sem_t mFreeSlots;
+    /** Number of ready slots. */
+    sem_t mReadySlots;
+};
+
+/**
+ * @brief Header of a slot.
+ */
+struct SlotHeader
+{
+    /** State of the slot. */
+    std::atomic<std::uint32_t> mState;
+    /** Format of the pixels. */
+    std::uint32_t mFormat;
+    /** Width of the frame, in pixels. */
+    std::int32_t mWidth;
+    /** Height of the frame, in pixels. */
+    std::int32_t mHeight;
+    /** Size of each row, in bytes. */
+    std::uint64_t mStride;
+    /** Sequence number of the frame. */
+    std::uint64_t mSequence;
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "The state of the slots must be lock-free");
+
+/**
+ * @brief Aligns a size to the alignment of the blocks of the ring.
+ *
+ * @param size Size, in bytes.
+ *
+ * @return Size aligned.
+ */
+constexpr std::size_t alignSize(const std::size_t size)
+{
+    return (size + SharedMemoryRing::cAlignment - 1) / SharedMemoryRing::cAlignment * SharedMemoryRing::cAlignment;
+}
+
+/** Offset of the slot headers. */
+constexpr std::size_t cSlotHeadersOffset{alignSize(sizeof(RingHeader))};
+/** Size of each slot header. */
+constexpr std::size_t cSlotHeaderSize{alignSize(sizeof(SlotHeader))};
+
+/**
+ * @brief Gets the header of a slot.
+ *
+ * @param mapping Mapping of the ring.
+ * @param slot Index of the slot.
+ *
+ * @return Header of the slot.
+ */
+SlotHeader* getSlotHeader(unsigned char* mapping, const std::size_t slot)
+{
+    return reinterpret_cast<SlotHeader*>(mapping + cSlotHeadersOffset + slot * cSlotHeaderSize);
+}
+
+/**
+ * @brief Gets the number of channels of a format of pixels.
+ *
+ * @param format Format of the pixels.
+ *
+ * @return Number of channels (0 if the format is unknown).
+ */
+std::size_t getNumChannels(const computerVision::OpenCvWrapper::PixelFormat format)
+{
+    switch (format) {
+    case computerVision::OpenCvWrapper::PixelFormat::GRAY:
+        return 1;
+    case computerVision::OpenCvWrapper::PixelFormat::BGR:
+    case computerVision::OpenCvWrapper::PixelFormat::RGB:
+        return 3;
+    case computerVision::OpenCvWrapper::PixelFormat::BGRA:
+    case computerVision::OpenCvWrapper::PixelFormat::RGBA:
+        return 4;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Checks that a frame is valid and fits in a slot.
+ *
+ * @param width Width of the frame, in pixels.
+ * @param height Height of the frame, in pixels.
+ * @param stride Size of each row, in bytes.
+ * @param format Format of the pixels.
+ * @param slotSize Size of the pixels of the slot, in bytes.
+ *
+ * @return True if the frame is valid, otherwise false.
+ */
+bool isFrameValid(const std::int32_t width,
+                  const std::int32_t height,
+                  const std::uint64_t stride,
+                  const std::uint32_t format,
+                  const std::size_t slotSize)
+{
+    if (format > static_cast<std::uint32_t>(computerVision::OpenCvWrapper::PixelFormat::RGBA) || width <= 0
+        || height <= 0) {
+        return false;
+    }
+
+    const auto numChannels{getNumChannels(static_cast<computerVision::OpenCvWrapper::PixelFormat>(format))};
+    return stride >= static_cast<std::uint64_t>(width) * numChannels
+           && stride <= slotSize / static_cast<std::size_t>(height);
+}
+
+/**
+ * @brief Waits for a semaphore, with a timeout.
+ *
+ * @param semaphore Semaphore.
+ * @param timeoutMs Timeout, in milliseconds.
+ *
+ * @return True if the semaphore was decremented, otherwise false on timeout or error.
+ */
+bool waitSemaphore(sem_t* semaphore, const int timeoutMs)
+{
+    timespec deadline{};
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += static_cast<long>(timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (sem_timedwait(semaphore, &deadline) != 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+#endif
+
+SharedMemoryRing::SharedMemoryRing(const std::shared_ptr<logging::Logger>& logger)
+    : mLogger{logger}
+{
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    close();
+}
+
+bool SharedMemoryRing::create(const std::string& name,
+                              const std::uint32_t numSlots,
+                              const std::size_t slotSize,
+                              const bool replace)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    close();
+
+    if (numSlots == 0 || slotSize == 0) {
+        mLogger->logError("Invalid shared memory ring: {} slots of {} bytes", numSlots, slotSize);
+        return false;
+    }
+
+    // Shared memory object, only replacing an existing one if requested
+    if (replace) {
+        shm_unlink(name.c_str());
+    }
+    const auto fd{shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR)};
+    if (fd < 0 && errno == EEXIST) {
+        mLogger->logError("Shared memory {} already exists", name);
+        return false;
+    }
+    if (fd < 0) {
+        mLogger->logError("Failed to create shared memory {}: {}", name, std::strerror(errno));
+        return false;
+    }
+    const auto size{getRingSize(numSlots, slotSize)};
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0 || !map(fd, size)) {
+        mLogger->logError("Failed to allocate shared memory {}: {}", name, std::strerror(errno));
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    ::close(fd);
+
+    mName = name;
+    mOwner = true;
+    mNumSlots = numSlots;
+    mSlotSize = slotSize;
+
+    // Header (the slots are zero-filled, so they are free), with the magic number last
+    auto* header{reinterpret_cast<RingHeader*>(mMapping)};
+    header->mVersion = cVersion;
+    header->mNumSlots = numSlots;
+    header->mSlotSize = slotSize;
+    sem_init(&header->mFreeSlots, 1, numSlots);
+    sem_init(&header->mReadySlots, 1, 0);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->mMagic = cMagic;
+
+    return true;
+#else
+    static_cast<void>(replace);
+    mLogger->logError("Shared memory ring {} ({} slots of {} bytes) is not supported on this platform",
+                      name,
+                      numSlots,
+                      slotSize);
+    return false;
+#endif
+}
+
+bool SharedMemoryRing::open(const std::string& name)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    close();
+
+    const auto fd{shm_open(name.c_str(), O_RDWR, 0)};
+    if (fd < 0) {
+        mLogger->logError("Failed to open shared memory {}: {}", name, std::strerror(errno));
+        return false;
+    }
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(RingHeader)
+        || !map(fd, static_cast<std::size_t>(status.st_size))) {
+        mLogger->logError("Invalid shared memory {}", name);
+        ::close(fd);
+        return false;
+    }
+    ::close(fd);
+
+    // Layout of the ring
+    const auto* header{reinterpret_cast<const RingHeader*>(mMapping)};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->mMagic != cMagic || header->mVersion != cVersion || header->mNumSlots == 0
+        || getRingSize(header->mNumSlots, header->mSlotSize) > mMappingSize) {
+        mLogger->logError("Shared memory {} is not a ring of version {}", name, cVersion);
+        close();
+        return false;
+    }
+
+    mName = name;
+    mNumSlots = header->mNumSlots;
+    mSlotSize = header->mSlotSize;
+
+    return true;
+#else
+    mLogger->logError("Shared memory ring {} is not supported on this platform", name);
+    return false;
+#endif
+}
+
+void SharedMemoryRing::close()
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    if (mMapping == nullptr) {
+        return;
+    }
+
+    if (mOwner) {
+        auto* header{reinterpret_cast<RingHeader*>(mMapping)};
+        sem_destroy(&header->mFreeSlots);
+        sem_destroy(&header->mReadySlots);
+        shm_unlink(mName.c_str());
+    }
+    munmap(mMapping, mMappingSize);
+
+    mName.clear();
+    mOwner = false;
+    mMapping = nullptr;
+    mMappingSize = 0;
+    mNumSlots = 0;
+    mSlotSize = 0;
+#endif
+}
+
+bool SharedMemoryRing::acquireWriteSlot(const int timeoutMs, std::size_t& slot)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    if (mMapping == nullptr || !waitSemaphore(&reinterpret_cast<RingHeader*>(mMapping)->mFreeSlots, timeoutMs)) {
+        return false;
+    }
+
+    // A free slot exists for each count of the semaphore, so it is found
+    while (true) {
+        for (std::size_t i{0}; i < mNumSlots; i++) {
+            auto* slotHeader{getSlotHeader(mMapping, i)};
+            auto expected{static_cast<std::uint32_t>(SlotState::FREE)};
+            if (slotHeader->mState.compare_exchange_strong(
+                    expected, static_cast<std::uint32_t>(SlotState::WRITING), std::memory_order_acquire)) {
+                slot = i;
+                return true;
+            }
+        }
+    }
+#else
+    static_cast<void>(timeoutMs);
+    static_cast<void>(slot);
+    return false;
+#endif
+}
+
+unsigned char* SharedMemoryRing::getSlotData(const std::size_t slot) const
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    if (mMapping != nullptr && slot < mNumSlots) {
+        return mMapping + cSlotHeadersOffset + mNumSlots * cSlotHeaderSize + slot * alignSize(mSlotSize);
+    }
+#else
+    static_cast<void>(slot);
+#endif
+
+    return nullptr;
+}
+
+bool SharedMemoryRing::publishFrame(const std::size_t slot,
+                                    const std::uint64_t sequence,
+                                    const int width,
+                                    const int height,
+                                    const std::size_t stride,
+                                    const computerVision::OpenCvWrapper::PixelFormat format)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    if (mMapping == nullptr || slot >= mNumSlots) {
+        return false;
+    }
+    auto* header{reinterpret_cast<RingHeader*>(mMapping)};
+    auto* slotHeader{getSlotHeader(mMapping, slot)};
+
+    // Frame fits in the slot, otherwise the slot is released
+    if (!isFrameValid(width, height, stride, static_cast<std::uint32_t>(format), mSlotSize)) {
+        mLogger->logError("Frame of {}x{} pixels and stride {} does not fit in slot of {} bytes",
+                          width,
+                          height,
+                          stride,
+                          mSlotSize);
+        slotHeader->mState.store(static_cast<std::uint32_t>(SlotState::FREE), std::memory_order_release);
+        sem_post(&header->mFreeSlots);
+        return false;
+    }
+
+    slotHeader->mFormat = static_cast<std::uint32_t>(format);
+    slotHeader->mWidth = width;
+    slotHeader->mHeight = height;
+    slotHeader->mStride = stride;
+    slotHeader->mSequence = sequence;
+    slotHeader->mState.store(static_cast<std::uint32_t>(SlotState::READY), std::memory_order_release);
+    sem_post(&header->mReadySlots);
+
+    return true;
+#else
+    static_cast<void>(slot);
+    static_cast<void>(sequence);
+    static_cast<void>(width);
+    static_cast<void>(height);
+    static_cast<void>(stride);
+    static_cast<void>(format);
+    return false;
+#endif
+}
+
+bool SharedMemoryRing::acquireFrame(const int timeoutMs, SharedMemoryFrame& frame)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    if (mMapping == nullptr || !waitSemaphore(&reinterpret_cast<RingHeader*>(mMapping)->mReadySlots, timeoutMs)) {
+        return false;
+    }
+
+    // A ready slot exists for each count of the semaphore: the one with the lowest sequence number is processed first
+    while (true) {
+        SlotHeader* readyHeader{nullptr};
+        auto readySlot{std::numeric_limits<std::size_t>::max()};
+        for (std::size_t i{0}; i < mNumSlots; i++) {
+            auto* slotHeader{getSlotHeader(mMapping, i)};
+            if (slotHeader->mState.load(std::memory_order_acquire) == static_cast<std::uint32_t>(SlotState::READY)
+                && (readyHeader == nullptr || slotHeader->mSequence < readyHeader->mSequence)) {
+                readyHeader = slotHeader;
+                readySlot = i;
+            }
+        }
+
+        auto expected{static_cast<std::uint32_t>(SlotState::READY)};
+        if (readyHeader != nullptr
+            && readyHeader->mState.compare_exchange_strong(
+                expected, static_cast<std::uint32_t>(SlotState::PROCESSING), std::memory_order_acquire)) {
+            // Header written by the producer, read once and validated before the pixels are read
+            const auto sequence{readyHeader->mSequence};
+            const auto width{readyHeader->mWidth};
+            const auto height{readyHeader->mHeight};
+            const auto stride{readyHeader->mStride};
+            const auto format{readyHeader->mFormat};
+            if (!isFrameValid(width, height, stride, format, mSlotSize)) {
+                mLogger->logWarning("Invalid frame {} in slot {} ({}x{} pixels, stride {}, format {}): slot released",
+                                    sequence,
+                                    readySlot,
+                                    width,
+                                    height,
+                                    stride,
+                                    format);
+                releaseFrame(readySlot);
+                return false;
+            }
+
+            frame.mSlot = readySlot;
+            frame.mSequence = sequence;
+            frame.mImageBuffer = {getSlotData(readySlot),
+                                  width,
+                                  height,
+                                  static_cast<std::size_t>(stride),
+                                  static_cast<computerVision::OpenCvWrapper::PixelFormat>(format)};
+            return true;
+        }
+    }
+#else
+    static_cast<void>(timeoutMs);
+    static_cast<void>(frame);
+    return false;
+#endif
+}
+
+void SharedMemoryRing::releaseFrame(const std::size_t slot)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    if (mMapping == nullptr || slot >= mNumSlots) {
+        return;
+    }
+
+    auto* slotHeader{getSlotHeader(mMapping, slot)};
+    slotHeader->mState.store(static_cast<std::uint32_t>(SlotState::FREE), std::memory_order_release);
+    sem_post(&reinterpret_cast<RingHeader*>(mMapping)->mFreeSlots);
+#else
+    static_cast<void>(slot);
+#endif
+}
+
+std::uint32_t SharedMemoryRing::getNumSlots() const
+{
+    return mNumSlots;
+}
+
+std::size_t SharedMemoryRing::getSlotSize() const
+{
+    return mSlotSize;
+}
+
+SharedMemoryRing::SlotState SharedMemoryRing::getSlotState(const std::size_t slot) const
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    if (mMapping != nullptr && slot < mNumSlots) {
+        return static_cast<SlotState>(getSlotHeader(mMapping, slot)->mState.load(std::memory_order_acquire));
+    }
+#else
+    static_cast<void>(slot);
+#endif
+
+    return SlotState::FREE;
+}
+
+std::size_t SharedMemoryRing::getRingSize(const std::uint32_t numSlots, const std::size_t slotSize)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    return cSlotHeadersOffset + numSlots * (cSlotHeaderSize + alignSize(slotSize));
+#else
+    static_cast<void>(numSlots);
+    return slotSize;
+#endif
+}
+
+bool SharedMemoryRing::map(const int fd, const std::size_t size)
+{
+#ifdef SHARED_MEMORY_SUPPORTED
+    auto* mapping{mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)};
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    mMapping = static_cast<unsigned char*>(mapping);
+    mMappingSize = size;
+
+    return true;
+#else
+    static_cast<void>(fd);
+    static_cast<void>(size);
+    return false;
+#endif
+}
+
+} // namespace application
+} // namespace circuitSegmentation
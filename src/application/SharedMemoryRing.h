@@ -0,0 +1,245 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "imageProcessing/ImageReceiver.h"
+#include "logging/Logger.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace circuitSegmentation {
+namespace application {
+
+/**
+ * @brief Frame of raw pixels in a slot of a shared-memory ring.
+ */
+struct SharedMemoryFrame
+{
+    /** Index of the slot. */
+    std::size_t mSlot{0};
+    /** Sequence number of the frame, given by the producer. */
+    std::uint64_t mSequence{0};
+    /** Buffer of raw pixels, in the slot (not copied). */
+    imageProcessing::RawImageBuffer mImageBuffer{};
+};
+
+/**
+ * @brief Ring of slots in POSIX shared memory, where a producer places raw frames that are processed without copying.
+ *
+ * The producer creates the ring (see @ref create) and the consumer opens it by name (see @ref open). Each slot has
+ * a header with the dimensions, stride and format of its frame, followed by the pixels. A slot is free, written by
+ * the producer, ready, or processed by the consumer:
+ * - The producer acquires a free slot (see @ref acquireWriteSlot), writes the pixels directly in it and publishes
+ *   the frame (see @ref publishFrame).
+ * - The consumer acquires the ready frame with the lowest sequence number (see @ref acquireFrame), processes the
+ *   pixels in place and releases the slot back to the producer (see @ref releaseFrame).
+ *
+ * The free and ready slots are counted by two process-shared semaphores, so neither side polls the ring. The layout
+ * in memory (all fields in the native byte order, each block aligned to 64 bytes) is:
+ * - Ring header: magic `CSRG` (uint32), version (uint32), number of slots (uint32), reserved (uint32), size of the
+ *   pixels of each slot (uint64), the semaphores of free and ready slots (sem_t each).
+ * - Slot headers, one for each slot: state (atomic uint32: 0 free, 1 writing, 2 ready, 3 processing), format
+ *   (uint32, as @ref computerVision::OpenCvWrapper::PixelFormat), width (int32), height (int32), stride (uint64),
+ *   sequence number (uint64).
+ * - Pixels of each slot.
+ *
+ * The process that creates the ring unlinks it when it is closed. POSIX shared memory is only supported on Linux.
+ */
+class SharedMemoryRing
+{
+public:
+    /** Magic number of the ring ("CSRG" in little endian). */
+    static constexpr std::uint32_t cMagic{0x47525343};
+    /** Version of the layout of the ring. */
+    static constexpr std::uint32_t cVersion{1};
+    /** Alignment of the blocks of the ring, in bytes. */
+    static constexpr std::size_t cAlignment{64};
+
+    /**
+     * @brief Enumeration of the states of a slot.
+     */
+    enum class SlotState : std::uint32_t {
+        /** Free, for the producer. */
+        FREE = 0,
+        /** Being written by the producer. */
+        WRITING = 1,
+        /** Ready, for the consumer. */
+        READY = 2,
+        /** Being processed by the consumer. */
+        PROCESSING = 3
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param logger Logger.
+     */
+    explicit SharedMemoryRing(const std::shared_ptr<logging::Logger>& logger);
+
+    /**
+     * @brief Destructor, closing the ring.
+     */
+    virtual ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    /**
+     * @brief Creates a ring (producer).
+     *
+     * @param name Name of the shared memory object (e.g. "/circuit-segmentation").
+     * @param numSlots Number of slots.
+     * @param slotSize Size of the pixels of each slot, in bytes.
+     * @param replace Flag to replace a shared memory object with the same name (e.g. left by a previous producer).
+     *
+     * @return True if the ring was created, otherwise false (e.g. a shared memory object with the same name exists
+     * and is not replaced).
+     */
+    virtual bool create(const std::string& name,
+                        const std::uint32_t numSlots,
+                        const std::size_t slotSize,
+                        const bool replace = false);
+
+    /**
+     * @brief Opens a ring created by another process (consumer).
+     *
+     * @param name Name of the shared memory object.
+     *
+     * @return True if the ring was opened and its layout is valid, otherwise false.
+     */
+    virtual bool open(const std::string& name);
+
+    /**
+     * @brief Closes the ring, unlinking it if it was created by this process.
+     */
+    virtual void close();
+
+    /**
+     * @brief Acquires a free slot to write a frame (producer), waiting until one is released.
+     *
+     * @param timeoutMs Timeout, in milliseconds.
+     * @param slot Index of the slot acquired.
+     *
+     * @return True if a slot was acquired, otherwise false on timeout.
+     */
+    virtual bool acquireWriteSlot(const int timeoutMs, std::size_t& slot);
+
+    /**
+     * @brief Gets the pixels of a slot, where the producer writes the frame.
+     *
+     * @param slot Index of the slot.
+     *
+     * @return Pixels of the slot, with the size of the slots (null if the ring is not open or the slot is invalid).
+     */
+    [[nodiscard]] virtual unsigned char* getSlotData(const std::size_t slot) const;
+
+    /**
+     * @brief Publishes the frame written in a slot (producer), so it is ready for the consumer.
+     *
+     * @param slot Index of the slot, acquired with @ref acquireWriteSlot.
+     * @param sequence Sequence number of the frame (the frames are processed in order of sequence number).
+     * @param width Width of the frame, in pixels.
+     * @param height Height of the frame, in pixels.
+     * @param stride Size of each row, in bytes.
+     * @param format Format of the pixels.
+     *
+     * @return True if the frame was published, otherwise false when it does not fit in the slot (which is then
+     * released).
+     */
+    virtual bool publishFrame(const std::size_t slot,
+                              const std::uint64_t sequence,
+                              const int width,
+                              const int height,
+                              const std::size_t stride,
+                              const computerVision::OpenCvWrapper::PixelFormat format);
+
+    /**
+     * @brief Acquires the ready frame with the lowest sequence number (consumer), waiting until one is published.
+     *
+     * The header of the frame, written by the producer, is validated: a frame with invalid dimensions or format, or
+     * that does not fit in its slot, is logged and its slot is released.
+     *
+     * @param timeoutMs Timeout, in milliseconds.
+     * @param frame Frame acquired, whose pixels are in the slot.
+     *
+     * @return True if a valid frame was acquired, otherwise false on timeout or invalid frame.
+     */
+    virtual bool acquireFrame(const int timeoutMs, SharedMemoryFrame& frame);
+
+    /**
+     * @brief Releases the slot of a frame (consumer), so the producer can write another frame in it.
+     *
+     * @param slot Index of the slot.
+     */
+    virtual void releaseFrame(const std::size_t slot);
+
+    /**
+     * @brief Gets the number of slots.
+     *
+     * @return Number of slots (0 if the ring is not open).
+     */
+    [[nodiscard]] virtual std::uint32_t getNumSlots() const;
+
+    /**
+     * @brief Gets the size of the pixels of each slot.
+     *
+     * @return Size of the pixels of each slot, in bytes.
+     */
+    [[nodiscard]] virtual std::size_t getSlotSize() const;
+
+    /**
+     * @brief Gets the state of a slot.
+     *
+     * @param slot Index of the slot.
+     *
+     * @return State of the slot.
+     */
+    [[nodiscard]] virtual SlotState getSlotState(const std::size_t slot) const;
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Gets the size of the ring, in bytes.
+     *
+     * @param numSlots Number of slots.
+     * @param slotSize Size of the pixels of each slot, in bytes.
+     *
+     * @return Size of the ring.
+     */
+    static std::size_t getRingSize(const std::uint32_t numSlots, const std::size_t slotSize);
+
+    /**
+     * @brief Maps the shared memory object.
+     *
+     * @param fd File descriptor of the shared memory object.
+     * @param size Size of the mapping, in bytes.
+     *
+     * @return True if the object was mapped, otherwise false.
+     */
+    virtual bool map(const int fd, const std::size_t size);
+
+private:
+    /** Name of the shared memory object. */
+    std::string mName{};
+    /** Flag of the ring created by this process. */
+    bool mOwner{false};
+    /** Mapping of the ring. */
+    unsigned char* mMapping{nullptr};
+    /** Size of the mapping, in bytes. */
+    std::size_t mMappingSize{0};
+    /** Number of slots. */
+    std::uint32_t mNumSlots{0};
+    /** Size of the pixels of each slot, in bytes. */
+    std::size_t mSlotSize{0};
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+};
+
+} // namespace application
+} // namespace circuitSegmentation
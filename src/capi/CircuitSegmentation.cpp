@@ -0,0 +1,284 @@
+/**
+ * @file
+ */
+
+#include "CircuitSegmentation.h"
+#include "common/CancellationToken.h"
+#include "common/Preset.h"
+#include "common/ThreadBudget.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "logging/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace circuitSegmentation;
+
+/**
+ * @brief Pipeline of the C API.
+ *
+ * It owns the image processing manager and the result of the last processing.
+ */
+struct cs_pipeline
+{
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Image processing manager. */
+    std::unique_ptr<imageProcessing::ImageProcManager> mImageProcManager;
+    /** Cancellation token of the processings, reset at the start of each one. */
+    std::shared_ptr<common::CancellationToken> mCancellationToken;
+    /** Timeout of each processing, in milliseconds (0 for no timeout). */
+    std::atomic<unsigned int> mTimeoutMs{0};
+    /** Result of the last processing. */
+    imageProcessing::ProcessingResult mProcessingResult{};
+    /** Segmentation map of the last processing, in JSON. */
+    std::string mSegmentationMap{};
+    /** Regions of interest of the last processing. */
+    std::vector<cs_roi> mRois{};
+    /** Result of the last processing, given to the caller. */
+    cs_result mResult{};
+    /** Message of the last error. */
+    std::string mLastError{};
+};
+
+namespace {
+
+/**
+ * @brief Sets the result of a pipeline from the result of the last processing.
+ *
+ * The IDs and images of the regions of interest point to the result kept by the pipeline, which is valid until the
+ * next processing.
+ *
+ * @param pipeline Pipeline.
+ */
+void setResult(cs_pipeline& pipeline)
+{
+    pipeline.mProcessingResult = pipeline.mImageProcManager->getResult();
+    pipeline.mSegmentationMap = pipeline.mProcessingResult.mSegmentationMap.dump();
+
+    // Regions of interest of the components and of the labels
+    pipeline.mRois.clear();
+    for (const auto& roiImage : pipeline.mProcessingResult.mRoiImages) {
+        const auto kind{roiImage.mKind == schematicSegmentation::RoiImage::Kind::LABEL ? CS_ROI_LABEL
+                                                                                       : CS_ROI_COMPONENT};
+        const auto& roi{roiImage.mRoi};
+        const auto* image{roiImage.mEncodedImage.empty() ? nullptr : roiImage.mEncodedImage.data()};
+
+        pipeline.mRois.push_back({kind,
+                                  roiImage.mElementId.c_str(),
+                                  roiImage.mIndex,
+                                  roi.x,
+                                  roi.y,
+                                  roi.width,
+                                  roi.height,
+                                  image,
+                                  roiImage.mEncodedImage.size()});
+    }
+
+    pipeline.mResult.segmentation_map = pipeline.mSegmentationMap.c_str();
+    pipeline.mResult.segmentation_map_size = pipeline.mSegmentationMap.size();
+    pipeline.mResult.rois = pipeline.mRois.data();
+    pipeline.mResult.num_rois = pipeline.mRois.size();
+}
+
+/**
+ * @brief Processes an image with a pipeline, converting the outcome to a status.
+ *
+ * No exception crosses the C boundary: any exception is reported as an internal error.
+ *
+ * @tparam Process Type of the function that processes the image.
+ *
+ * @param pipeline Pipeline.
+ * @param result Result of the processing, set on success.
+ * @param process Function that processes the image with the image processing manager.
+ *
+ * @return Status of the processing.
+ */
+template<typename Process>
+cs_status processImage(cs_pipeline& pipeline, const cs_result** result, Process process)
+{
+    try {
+        pipeline.mLastError.clear();
+
+        // Deadline of this processing
+        pipeline.mCancellationToken->reset();
+        pipeline.mCancellationToken->setTimeout(std::chrono::milliseconds(pipeline.mTimeoutMs.load()));
+
+        if (!process(*pipeline.mImageProcManager)) {
+            switch (pipeline.mImageProcManager->getLastStatus()) {
+            case imageProcessing::ProcessingStatus::CANCELLED:
+                pipeline.mLastError = "Processing cancelled";
+                return CS_STATUS_CANCELLED;
+            case imageProcessing::ProcessingStatus::DEADLINE_EXCEEDED:
+                pipeline.mLastError = "Deadline exceeded";
+                return CS_STATUS_DEADLINE_EXCEEDED;
+            default:
+                pipeline.mLastError = "Failed to process image";
+                return CS_STATUS_PROCESSING_FAILED;
+            }
+        }
+
+        setResult(pipeline);
+        *result = &pipeline.mResult;
+
+        return CS_STATUS_OK;
+    } catch (const std::exception& e) {
+        pipeline.mLastError = e.what();
+    } catch (...) {
+        pipeline.mLastError = "Unknown error";
+    }
+
+    return CS_STATUS_INTERNAL_ERROR;
+}
+
+} // namespace
+
+unsigned int cs_api_version(void)
+{
+    return CS_API_VERSION;
+}
+
+void cs_pipeline_options_init(cs_pipeline_options* options)
+{
+    if (options == nullptr) {
+        return;
+    }
+
+    options->run_mode = CS_RUN_MODE_SINGLE_IMAGE;
+    options->num_writer_threads = 0;
+    options->verbose = 0;
+    options->save_images = 0;
+    options->output_directory = nullptr;
+    options->write_files = 1;
+    options->encode_rois = 0;
+}
+
+cs_pipeline* cs_pipeline_create(const cs_pipeline_options* options)
+{
+    try {
+        cs_pipeline_options defaultOptions{};
+        cs_pipeline_options_init(&defaultOptions);
+        if (options == nullptr) {
+            options = &defaultOptions;
+        }
+
+        const auto runMode{options->run_mode == CS_RUN_MODE_BATCH ? common::ThreadBudget::RunMode::BATCH
+                                                                  : common::ThreadBudget::RunMode::SINGLE_IMAGE};
+        const common::ThreadBudget threadBudget{runMode, options->num_writer_threads};
+
+        auto pipeline{std::make_unique<cs_pipeline>()};
+        pipeline->mLogger = std::make_shared<logging::Logger>(std::cerr);
+        pipeline->mImageProcManager = std::make_unique<imageProcessing::ImageProcManager>(
+            imageProcessing::ImageProcManager::create(pipeline->mLogger,
+                                                      options->verbose != 0,
+                                                      options->save_images != 0,
+                                                      threadBudget));
+        if (options->output_directory != nullptr) {
+            pipeline->mImageProcManager->setOutputDirectory(options->output_directory);
+        }
+        pipeline->mImageProcManager->setWriteOutputFiles(options->write_files != 0);
+        pipeline->mImageProcManager->setEncodeRoiImages(options->encode_rois != 0);
+        pipeline->mCancellationToken = std::make_shared<common::CancellationToken>();
+        pipeline->mImageProcManager->setCancellationToken(pipeline->mCancellationToken);
+
+        return pipeline.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void cs_pipeline_destroy(cs_pipeline* pipeline)
+{
+    delete pipeline;
+}
+
+cs_status cs_pipeline_set_timeout(cs_pipeline* pipeline, unsigned int timeout_ms)
+{
+    if (pipeline == nullptr) {
+        return CS_STATUS_INVALID_ARGUMENT;
+    }
+
+    pipeline->mTimeoutMs = timeout_ms;
+
+    return CS_STATUS_OK;
+}
+
+cs_status cs_pipeline_set_preset(cs_pipeline* pipeline, cs_preset preset)
+{
+    if (pipeline == nullptr || preset < CS_PRESET_FAST || preset > CS_PRESET_ACCURATE) {
+        return CS_STATUS_INVALID_ARGUMENT;
+    }
+
+    pipeline->mImageProcManager->setPreset(static_cast<common::Preset>(preset));
+
+    return CS_STATUS_OK;
+}
+
+cs_status cs_pipeline_cancel(cs_pipeline* pipeline)
+{
+    if (pipeline == nullptr) {
+        return CS_STATUS_INVALID_ARGUMENT;
+    }
+
+    // Only reads the pipeline, so it can be called while it is processing
+    pipeline->mCancellationToken->cancel();
+
+    return CS_STATUS_OK;
+}
+
+cs_status cs_pipeline_process_encoded(cs_pipeline* pipeline,
+                                      const void* data,
+                                      size_t size,
+                                      const cs_result** result)
+{
+    if (pipeline == nullptr) {
+        return CS_STATUS_INVALID_ARGUMENT;
+    }
+    if (data == nullptr || size == 0 || result == nullptr) {
+        pipeline->mLastError = "Invalid encoded image or result";
+        return CS_STATUS_INVALID_ARGUMENT;
+    }
+
+    return processImage(*pipeline, result, [data, size](imageProcessing::ImageProcManager& imageProcManager) {
+        const auto bytes{static_cast<const unsigned char*>(data)};
+        return imageProcManager.processImageBuffer(std::vector<unsigned char>(bytes, bytes + size));
+    });
+}
+
+cs_status cs_pipeline_process_raw(cs_pipeline* pipeline,
+                                  const void* pixels,
+                                  int width,
+                                  int height,
+                                  size_t stride,
+                                  cs_pixel_format format,
+                                  const cs_result** result)
+{
+    if (pipeline == nullptr) {
+        return CS_STATUS_INVALID_ARGUMENT;
+    }
+    if (pixels == nullptr || width <= 0 || height <= 0 || format < CS_PIXEL_FORMAT_GRAY
+        || format > CS_PIXEL_FORMAT_RGBA || result == nullptr) {
+        pipeline->mLastError = "Invalid raw image or result";
+        return CS_STATUS_INVALID_ARGUMENT;
+    }
+
+    // The pixel formats of the C API have the same values as the ones of the OpenCV wrapper
+    const imageProcessing::RawImageBuffer buffer{static_cast<const unsigned char*>(pixels),
+                                                 width,
+                                                 height,
+                                                 stride,
+                                                 static_cast<computerVision::OpenCvWrapper::PixelFormat>(format)};
+
+    return processImage(*pipeline, result, [&buffer](imageProcessing::ImageProcManager& imageProcManager) {
+        return imageProcManager.processRawImageBuffer(buffer);
+    });
+}
+
+const char* cs_pipeline_last_error(const cs_pipeline* pipeline)
+{
+    return pipeline != nullptr ? pipeline->mLastError.c_str() : "Invalid pipeline";
+}
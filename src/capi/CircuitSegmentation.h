@@ -0,0 +1,280 @@
+/**
+ * @file
+ *
+ * @brief C API of the circuit segmentation, for use in other processes through a shared library.
+ *
+ * A pipeline is created once and reused for many images. The functions of a pipeline must not be called concurrently
+ * (except @ref cs_pipeline_cancel), but different pipelines can be used by different threads. The C API is stable: new
+ * functions and enumerators may be added, but the existing ones are not changed, and @ref CS_API_VERSION is
+ * incremented with each release that adds to it.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#if defined(CS_API_BUILD)
+#define CS_API __declspec(dllexport)
+#else
+#define CS_API __declspec(dllimport)
+#endif
+#else
+#define CS_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version of the C API. */
+#define CS_API_VERSION 1
+
+/**
+ * @brief Opaque handle of a pipeline.
+ */
+typedef struct cs_pipeline cs_pipeline;
+
+/**
+ * @brief Enumeration of the status codes.
+ */
+typedef enum cs_status {
+    /** Operation occurred successfully. */
+    CS_STATUS_OK = 0,
+    /** Invalid argument (e.g. null pointer or empty buffer). */
+    CS_STATUS_INVALID_ARGUMENT = 1,
+    /** Image cannot be processed (e.g. invalid image or no circuit found). */
+    CS_STATUS_PROCESSING_FAILED = 2,
+    /** Unexpected internal error. */
+    CS_STATUS_INTERNAL_ERROR = 3,
+    /** Processing stopped, because it was cancelled with @ref cs_pipeline_cancel. */
+    CS_STATUS_CANCELLED = 4,
+    /** Processing stopped, because its timeout expired (see @ref cs_pipeline_set_timeout). */
+    CS_STATUS_DEADLINE_EXCEEDED = 5
+} cs_status;
+
+/**
+ * @brief Enumeration of the formats of raw pixels.
+ */
+typedef enum cs_pixel_format {
+    /** 8 bits per pixel, grayscale. */
+    CS_PIXEL_FORMAT_GRAY = 0,
+    /** 24 bits per pixel, in blue, green and red order (wrapped without copying). */
+    CS_PIXEL_FORMAT_BGR = 1,
+    /** 32 bits per pixel, in blue, green, red and alpha order. */
+    CS_PIXEL_FORMAT_BGRA = 2,
+    /** 24 bits per pixel, in red, green and blue order. */
+    CS_PIXEL_FORMAT_RGB = 3,
+    /** 32 bits per pixel, in red, green, blue and alpha order. */
+    CS_PIXEL_FORMAT_RGBA = 4
+} cs_pixel_format;
+
+/**
+ * @brief Enumeration of the run modes, which define how the cores are shared.
+ */
+typedef enum cs_run_mode {
+    /** One pipeline processing at a time: OpenCV uses all the cores. */
+    CS_RUN_MODE_SINGLE_IMAGE = 0,
+    /** Several pipelines processing in parallel: OpenCV runs serially in each one. */
+    CS_RUN_MODE_BATCH = 1
+} cs_run_mode;
+
+/**
+ * @brief Enumeration of the kinds of regions of interest (ROI).
+ */
+typedef enum cs_roi_kind {
+    /** Component. */
+    CS_ROI_COMPONENT = 0,
+    /** Label of a component, connection or node. */
+    CS_ROI_LABEL = 1
+} cs_roi_kind;
+
+/**
+ * @brief Enumeration of the presets of a pipeline, which trade accuracy for latency.
+ */
+typedef enum cs_preset {
+    /** Lowest latency: smaller kernels, fewer iterations and cheaper thresholding. */
+    CS_PRESET_FAST = 0,
+    /** Default parameters. */
+    CS_PRESET_BALANCED = 1,
+    /** Highest accuracy: additional denoising of the image, at a higher latency. */
+    CS_PRESET_ACCURATE = 2
+} cs_preset;
+
+/**
+ * @brief Options of a pipeline.
+ *
+ * The options must be initialized with @ref cs_pipeline_options_init before setting any of them.
+ */
+typedef struct cs_pipeline_options {
+    /** Run mode. */
+    cs_run_mode run_mode;
+    /** Number of threads for writing images (0 to use the default). */
+    unsigned int num_writer_threads;
+    /** Enable verbose logs, written to the standard error (0 = disabled). */
+    int verbose;
+    /** Save images obtained during the processing (0 = disabled). */
+    int save_images;
+    /** Directory where the output files are written (null for the working directory). It must exist. */
+    const char* output_directory;
+    /** Write the output files, i.e. the segmentation map and the images of the regions of interest (0 = disabled). */
+    int write_files;
+    /** Encode the images of the regions of interest to memory, in PNG, given in the result (0 = disabled). */
+    int encode_rois;
+} cs_pipeline_options;
+
+/**
+ * @brief Region of interest (ROI) of an element of the circuit, in pixels of the image processed.
+ */
+typedef struct cs_roi {
+    /** Kind of ROI. */
+    cs_roi_kind kind;
+    /** ID of the element (the component, or the owner of the label). */
+    const char* element_id;
+    /** Index of the label in the element, starting at 1 (0 for components). */
+    unsigned int index;
+    /** Horizontal coordinate of the top-left corner. */
+    int x;
+    /** Vertical coordinate of the top-left corner. */
+    int y;
+    /** Width. */
+    int width;
+    /** Height. */
+    int height;
+    /** Image of the region of interest, encoded in PNG (null if the images are not encoded). */
+    const unsigned char* image;
+    /** Size of the image, in bytes. */
+    size_t image_size;
+} cs_roi;
+
+/**
+ * @brief Result of a processing.
+ *
+ * The result is owned by the pipeline and is valid until the next processing or the destruction of the pipeline.
+ */
+typedef struct cs_result {
+    /** Segmentation map, in JSON, terminated by a null character. */
+    const char* segmentation_map;
+    /** Size of the segmentation map, in bytes, without the null character. */
+    size_t segmentation_map_size;
+    /** Regions of interest of the components and labels. */
+    const cs_roi* rois;
+    /** Number of regions of interest. */
+    size_t num_rois;
+} cs_result;
+
+/**
+ * @brief Gets the version of the C API of the library.
+ *
+ * @return Version of the C API, to be compared with @ref CS_API_VERSION.
+ */
+CS_API unsigned int cs_api_version(void);
+
+/**
+ * @brief Initializes the options of a pipeline with the default values.
+ *
+ * @param options Options.
+ */
+CS_API void cs_pipeline_options_init(cs_pipeline_options* options);
+
+/**
+ * @brief Creates a pipeline.
+ *
+ * @param options Options (null to use the default values).
+ *
+ * @return Pipeline, or null on failure. It must be destroyed with @ref cs_pipeline_destroy.
+ */
+CS_API cs_pipeline* cs_pipeline_create(const cs_pipeline_options* options);
+
+/**
+ * @brief Destroys a pipeline.
+ *
+ * @param pipeline Pipeline (null is ignored).
+ */
+CS_API void cs_pipeline_destroy(cs_pipeline* pipeline);
+
+/**
+ * @brief Sets the timeout of each processing of a pipeline.
+ *
+ * A processing that exceeds its timeout stops promptly, with the status @ref CS_STATUS_DEADLINE_EXCEEDED.
+ *
+ * @param pipeline Pipeline.
+ * @param timeout_ms Timeout, in milliseconds (0 for no timeout, the default).
+ *
+ * @return Status of the operation.
+ */
+CS_API cs_status cs_pipeline_set_timeout(cs_pipeline* pipeline, unsigned int timeout_ms);
+
+/**
+ * @brief Sets the preset of the next processings of a pipeline.
+ *
+ * @param pipeline Pipeline.
+ * @param preset Preset (@ref CS_PRESET_BALANCED by default).
+ *
+ * @return Status of the operation.
+ */
+CS_API cs_status cs_pipeline_set_preset(cs_pipeline* pipeline, cs_preset preset);
+
+/**
+ * @brief Cancels the processing running in a pipeline, if any.
+ *
+ * It can be called from any thread while the pipeline is processing. The processing stops promptly, with the status
+ * @ref CS_STATUS_CANCELLED.
+ *
+ * @param pipeline Pipeline.
+ *
+ * @return Status of the operation.
+ */
+CS_API cs_status cs_pipeline_cancel(cs_pipeline* pipeline);
+
+/**
+ * @brief Processes an encoded image (e.g. the content of a PNG or JPEG file).
+ *
+ * @param pipeline Pipeline.
+ * @param data Encoded image.
+ * @param size Size of the encoded image, in bytes.
+ * @param result Result of the processing, set on success.
+ *
+ * @return Status of the processing.
+ */
+CS_API cs_status cs_pipeline_process_encoded(cs_pipeline* pipeline,
+                                             const void* data,
+                                             size_t size,
+                                             const cs_result** result);
+
+/**
+ * @brief Processes an image of raw pixels.
+ *
+ * The pixels in BGR format are not copied: the buffer is only read, and it is not used after this function returns.
+ *
+ * @param pipeline Pipeline.
+ * @param pixels Pixels, row by row.
+ * @param width Width of the image, in pixels.
+ * @param height Height of the image, in pixels.
+ * @param stride Size of each row, in bytes (it can include padding).
+ * @param format Format of the pixels.
+ * @param result Result of the processing, set on success.
+ *
+ * @return Status of the processing.
+ */
+CS_API cs_status cs_pipeline_process_raw(cs_pipeline* pipeline,
+                                         const void* pixels,
+                                         int width,
+                                         int height,
+                                         size_t stride,
+                                         cs_pixel_format format,
+                                         const cs_result** result);
+
+/**
+ * @brief Gets the message of the last error of a pipeline.
+ *
+ * @param pipeline Pipeline.
+ *
+ * @return Message of the last error, empty if the last operation occurred successfully. It is valid until the next
+ * operation on the pipeline.
+ */
+CS_API const char* cs_pipeline_last_error(const cs_pipeline* pipeline);
+
+#ifdef __cplusplus
+}
+#endif
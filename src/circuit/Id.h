@@ -24,5 +24,19 @@ inline const Id generateId()
     return uuidGen.generateStringUuid();
 }
 
+/**
+ * @brief Generate ID derived from a name, the same for the same namespace and name.
+ *
+ * @param namespaceId Namespace of the name.
+ * @param name Name.
+ *
+ * @return ID of the name.
+ */
+inline const Id generateNameId(const uuids::uuid& namespaceId, const std::string& name)
+{
+    const common::UuidGen uuidGen{};
+    return uuidGen.generateStringNameUuid(namespaceId, name);
+}
+
 } // namespace circuit
 } // namespace circuitSegmentation
@@ -0,0 +1,71 @@
+/**
+ * @file
+ */
+
+#include "CancellationToken.h"
+
+namespace circuitSegmentation {
+namespace common {
+
+void CancellationToken::cancel()
+{
+    mCancelled = true;
+}
+
+void CancellationToken::setDeadline(const Clock::time_point deadline)
+{
+    mDeadline = deadline.time_since_epoch().count();
+}
+
+void CancellationToken::setTimeout(const std::chrono::milliseconds timeout)
+{
+    if (timeout.count() <= 0) {
+        mDeadline = 0;
+        return;
+    }
+
+    setDeadline(Clock::now() + timeout);
+}
+
+void CancellationToken::reset()
+{
+    mCancelled = false;
+    mDeadline = 0;
+}
+
+CancellationToken::State CancellationToken::getState() const
+{
+    if (mCancelled) {
+        return State::CANCELLED;
+    }
+
+    const auto deadline{mDeadline.load()};
+    if (deadline != 0 && Clock::now().time_since_epoch().count() >= deadline) {
+        return State::DEADLINE_EXCEEDED;
+    }
+
+    return State::ACTIVE;
+}
+
+bool CancellationToken::isStopped() const
+{
+    return getState() != State::ACTIVE;
+}
+
+void CancellationToken::setCurrent(const CancellationToken* token)
+{
+    mCurrent = token;
+}
+
+const CancellationToken* CancellationToken::getCurrent()
+{
+    return mCurrent;
+}
+
+bool CancellationToken::isCurrentStopped()
+{
+    return mCurrent != nullptr && mCurrent->isStopped();
+}
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,124 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Token to stop a processing cooperatively, when it is cancelled or when its deadline expires.
+ *
+ * The token of the job running in a thread is set as the current token of that thread (see setCurrent), so the long
+ * loops of the pipeline (e.g. each thinning pass or each contour) check it without it being passed through every
+ * method. A loop that finds it stopped returns early, and the job ends with a status telling why it was stopped.
+ *
+ * The token can be cancelled from any thread, while the job is running.
+ */
+class CancellationToken
+{
+public:
+    /**
+     * @brief Enumeration of the states of a token.
+     */
+    enum class State : unsigned char {
+        /** Not stopped. */
+        ACTIVE = 0,
+        /** Cancelled. */
+        CANCELLED = 1,
+        /** Deadline expired. */
+        DEADLINE_EXCEEDED = 2
+    };
+
+    /** Clock of the deadlines. */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructor, without deadline.
+     */
+    CancellationToken() = default;
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~CancellationToken() = default;
+
+    /**
+     * @brief Cancels the token.
+     */
+    virtual void cancel();
+
+    /**
+     * @brief Sets the deadline, after which the token is stopped.
+     *
+     * @param deadline Deadline.
+     */
+    virtual void setDeadline(const Clock::time_point deadline);
+
+    /**
+     * @brief Sets the deadline as a timeout from now.
+     *
+     * @param timeout Timeout (0 to remove the deadline).
+     */
+    virtual void setTimeout(const std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Resets the token, so it is not cancelled and has no deadline.
+     */
+    virtual void reset();
+
+    /**
+     * @brief Gets the state of the token.
+     *
+     * Cancellation takes precedence over the deadline.
+     *
+     * @return State.
+     */
+    [[nodiscard]] virtual State getState() const;
+
+    /**
+     * @brief Checks if the token is stopped (cancelled or deadline expired).
+     *
+     * @return True if the token is stopped, otherwise false.
+     */
+    [[nodiscard]] virtual bool isStopped() const;
+
+    /**
+     * @brief Sets the token of the job running in the calling thread.
+     *
+     * @param token Token (null when no job is running). It must be valid while it is set.
+     */
+    static void setCurrent(const CancellationToken* token);
+
+    /**
+     * @brief Gets the token of the job running in the calling thread.
+     *
+     * @return Token, or null if not set.
+     */
+    [[nodiscard]] static const CancellationToken* getCurrent();
+
+    /**
+     * @brief Checks if the token of the job running in the calling thread is stopped.
+     *
+     * @return True if the token is set and stopped, otherwise false.
+     */
+    [[nodiscard]] static bool isCurrentStopped();
+
+private:
+    /** Flag of the token cancelled. */
+    std::atomic<bool> mCancelled{false};
+
+    /** Deadline, in ticks of the clock since its epoch (0 without deadline). */
+    std::atomic<Clock::rep> mDeadline{0};
+
+    /** Token of the job running in this thread. */
+    static inline thread_local const CancellationToken* mCurrent{nullptr};
+};
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,100 @@
+/**
+ * @file
+ */
+
+#include "ContentHash.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace circuitSegmentation {
+namespace common {
+
+namespace {
+
+/** Multiplier of the mix (MurmurHash2 64-bit). */
+constexpr std::uint64_t cMultiplier{0xC6A4A7935BD1E995ULL};
+/** Shift of the mix. */
+constexpr int cShift{47};
+
+} // namespace
+
+ContentHash::ContentHash(const std::uint64_t seed)
+    : mState{seed}
+{
+}
+
+void ContentHash::update(const void* data, const std::size_t size)
+{
+    const auto* bytes{static_cast<const unsigned char*>(data)};
+    auto remaining{size};
+    mSize += size;
+
+    // Complete the word of the previous content
+    if (mTailSize > 0) {
+        const auto count{std::min(remaining, mTail.size() - mTailSize)};
+        std::memcpy(mTail.data() + mTailSize, bytes, count);
+        mTailSize += count;
+        bytes += count;
+        remaining -= count;
+        if (mTailSize < mTail.size()) {
+            return;
+        }
+        std::uint64_t word{};
+        std::memcpy(&word, mTail.data(), sizeof(word));
+        mixWord(word);
+        mTailSize = 0;
+    }
+
+    // Whole words (memcpy, so the content does not have to be aligned)
+    for (; remaining >= sizeof(std::uint64_t); bytes += sizeof(std::uint64_t), remaining -= sizeof(std::uint64_t)) {
+        std::uint64_t word{};
+        std::memcpy(&word, bytes, sizeof(word));
+        mixWord(word);
+    }
+
+    // Bytes left for the next content
+    std::memcpy(mTail.data(), bytes, remaining);
+    mTailSize = remaining;
+}
+
+std::uint64_t ContentHash::getDigest() const
+{
+    auto state{mState ^ (mSize * cMultiplier)};
+
+    // Bytes of the last incomplete word
+    if (mTailSize > 0) {
+        std::uint64_t word{};
+        std::memcpy(&word, mTail.data(), mTailSize);
+        state ^= word;
+        state *= cMultiplier;
+    }
+
+    // Final avalanche
+    state ^= state >> cShift;
+    state *= cMultiplier;
+    state ^= state >> cShift;
+
+    return state;
+}
+
+std::string ContentHash::getHexDigest() const
+{
+    std::array<char, 17> hex{};
+    std::snprintf(hex.data(), hex.size(), "%016llx", static_cast<unsigned long long>(getDigest()));
+
+    return std::string{hex.data()};
+}
+
+void ContentHash::mixWord(std::uint64_t word)
+{
+    word *= cMultiplier;
+    word ^= word >> cShift;
+    word *= cMultiplier;
+
+    mState ^= word;
+    mState *= cMultiplier;
+}
+
+} // namespace common
+} // namespace circuitSegmentation
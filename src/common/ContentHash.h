@@ -0,0 +1,82 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Fast, non-cryptographic 64-bit hash of content given in pieces (e.g. the rows of an image).
+ *
+ * The content is mixed 8 bytes at a time (multiply and rotate, as MurmurHash2 64-bit), so hashing an image costs a
+ * fraction of decoding it. The digest only depends on the bytes and their order, not on how they are split in pieces.
+ * It identifies identical content, but it is not suitable against adversarial collisions. The words are read in the
+ * native byte order, so the digests are only meant for the machine that computes them (e.g. a local cache).
+ */
+class ContentHash
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param seed Seed of the hash.
+     */
+    explicit ContentHash(const std::uint64_t seed = 0);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~ContentHash() = default;
+
+    /**
+     * @brief Adds content to the hash.
+     *
+     * @param data Content.
+     * @param size Size of the content, in bytes.
+     */
+    virtual void update(const void* data, const std::size_t size);
+
+    /**
+     * @brief Gets the digest of the content added so far.
+     *
+     * @return Digest.
+     */
+    [[nodiscard]] virtual std::uint64_t getDigest() const;
+
+    /**
+     * @brief Gets the digest of the content added so far, as 16 hexadecimal digits.
+     *
+     * @return Digest, in hexadecimal.
+     */
+    [[nodiscard]] virtual std::string getHexDigest() const;
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Mixes a word of 8 bytes into the state.
+     *
+     * @param word Word.
+     */
+    void mixWord(std::uint64_t word);
+
+private:
+    /** State of the hash. */
+    std::uint64_t mState;
+    /** Size of the content added, in bytes. */
+    std::uint64_t mSize{0};
+    /** Bytes added that do not complete a word yet. */
+    std::array<unsigned char, 8> mTail{};
+    /** Number of bytes in the tail. */
+    std::size_t mTailSize{0};
+};
+
+} // namespace common
+} // namespace circuitSegmentation
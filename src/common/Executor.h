@@ -0,0 +1,37 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Interface of an executor, which runs tasks on threads it owns (e.g. a thread pool or an event loop).
+ *
+ * The asynchronous processing resumes its coroutines through an executor, so the threads that run them are chosen by
+ * the application.
+ */
+class Executor
+{
+public:
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Executor() = default;
+
+    /**
+     * @brief Queues a task for execution.
+     *
+     * The task may be executed on any thread of the executor, but not before this method is called.
+     *
+     * @param task Task.
+     */
+    virtual void execute(std::function<void()> task) = 0;
+};
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,124 @@
+/**
+ * @file
+ */
+
+#include "MemoryBudget.h"
+#include <utility>
+
+namespace circuitSegmentation {
+namespace common {
+
+MemoryBudget::Reservation::Reservation(MemoryBudget* budget, const std::size_t bytes, const bool oversized)
+    : mBudget{budget}
+    , mBytes{bytes}
+    , mOversized{oversized}
+{
+}
+
+MemoryBudget::Reservation::~Reservation()
+{
+    release();
+}
+
+MemoryBudget::Reservation::Reservation(Reservation&& other) noexcept
+    : mBudget{std::exchange(other.mBudget, nullptr)}
+    , mBytes{std::exchange(other.mBytes, 0)}
+    , mOversized{std::exchange(other.mOversized, false)}
+{
+}
+
+MemoryBudget::Reservation& MemoryBudget::Reservation::operator=(Reservation&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        mBudget = std::exchange(other.mBudget, nullptr);
+        mBytes = std::exchange(other.mBytes, 0);
+        mOversized = std::exchange(other.mOversized, false);
+    }
+
+    return *this;
+}
+
+std::size_t MemoryBudget::Reservation::getBytes() const
+{
+    return mBytes;
+}
+
+bool MemoryBudget::Reservation::isOversized() const
+{
+    return mOversized;
+}
+
+void MemoryBudget::Reservation::release()
+{
+    if (mBudget != nullptr) {
+        mBudget->release(mBytes);
+        mBudget = nullptr;
+    }
+}
+
+MemoryBudget::MemoryBudget(const std::size_t budget)
+    : mBudget{budget}
+{
+}
+
+MemoryBudget::Reservation MemoryBudget::reserve(const std::size_t bytes)
+{
+    const auto oversized{isOversized(bytes)};
+
+    std::unique_lock<std::mutex> lock{mMutex};
+
+    // Wait for the turn of this job, and then until it fits in the budget (alone, if it is oversized)
+    const auto ticket{mNextTicket++};
+    mCondition.wait(lock, [this, ticket, bytes, oversized]() {
+        if (ticket != mServingTicket) {
+            return false;
+        }
+        if (mBudget == 0) {
+            return true;
+        }
+
+        return oversized ? mNumAdmitted == 0 : mReservedBytes + bytes <= mBudget;
+    });
+
+    mReservedBytes += bytes;
+    ++mNumAdmitted;
+    ++mServingTicket;
+
+    // The next job may fit too
+    lock.unlock();
+    mCondition.notify_all();
+
+    return Reservation{this, bytes, oversized};
+}
+
+std::size_t MemoryBudget::getBudget() const
+{
+    return mBudget;
+}
+
+std::size_t MemoryBudget::getReservedBytes() const
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    return mReservedBytes;
+}
+
+bool MemoryBudget::isOversized(const std::size_t bytes) const
+{
+    return mBudget != 0 && bytes > mBudget;
+}
+
+void MemoryBudget::release(const std::size_t bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        mReservedBytes -= bytes;
+        --mNumAdmitted;
+    }
+
+    mCondition.notify_all();
+}
+
+} // namespace common
+} // namespace circuitSegmentation
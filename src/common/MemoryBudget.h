@@ -0,0 +1,176 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Budget of memory of the concurrent jobs, for admission control.
+ *
+ * Each job reserves its estimated peak memory before running, and it is admitted only while the total reserved stays
+ * under the budget, otherwise it waits for other jobs to release their reservations. A job larger than the budget is
+ * oversized: it is admitted alone, when no other job is running, and no other job is admitted until it ends.
+ *
+ * The jobs are admitted in the order of arrival, so a large job waiting is not starved by the smaller ones arriving
+ * after it.
+ */
+class MemoryBudget
+{
+public:
+    /**
+     * @brief Reservation of memory of a job, released when destroyed.
+     */
+    class Reservation
+    {
+    public:
+        /**
+         * @brief Constructor, of an empty reservation.
+         */
+        Reservation() = default;
+
+        /**
+         * @brief Destructor, releasing the reservation.
+         */
+        ~Reservation();
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param other Reservation moved, which becomes empty.
+         */
+        Reservation(Reservation&& other) noexcept;
+
+        /**
+         * @brief Move assignment, releasing the current reservation.
+         *
+         * @param other Reservation moved, which becomes empty.
+         *
+         * @return This reservation.
+         */
+        Reservation& operator=(Reservation&& other) noexcept;
+
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        /**
+         * @brief Gets the memory reserved.
+         *
+         * @return Memory reserved, in bytes.
+         */
+        [[nodiscard]] std::size_t getBytes() const;
+
+        /**
+         * @brief Checks if the job is oversized (larger than the budget), so it was admitted alone.
+         *
+         * @return True if the job is oversized, otherwise false.
+         */
+        [[nodiscard]] bool isOversized() const;
+
+        /**
+         * @brief Releases the reservation, before being destroyed.
+         */
+        void release();
+
+    private:
+        friend class MemoryBudget;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param budget Budget of the reservation.
+         * @param bytes Memory reserved, in bytes.
+         * @param oversized Job oversized.
+         */
+        Reservation(MemoryBudget* budget, const std::size_t bytes, const bool oversized);
+
+        /** Budget of the reservation (null when empty). */
+        MemoryBudget* mBudget{nullptr};
+        /** Memory reserved, in bytes. */
+        std::size_t mBytes{0};
+        /** Job oversized. */
+        bool mOversized{false};
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param budget Budget of memory, in bytes (0 for no budget, so all the jobs are admitted immediately).
+     */
+    explicit MemoryBudget(const std::size_t budget = 0);
+
+    /**
+     * @brief Destructor.
+     *
+     * The reservations must be released before the budget is destroyed.
+     */
+    virtual ~MemoryBudget() = default;
+
+    /**
+     * @brief Reserves the memory of a job, waiting until it is admitted.
+     *
+     * @param bytes Estimated peak memory of the job, in bytes.
+     *
+     * @return Reservation, released when destroyed.
+     */
+    [[nodiscard]] virtual Reservation reserve(const std::size_t bytes);
+
+    /**
+     * @brief Gets the budget of memory.
+     *
+     * @return Budget, in bytes (0 for no budget).
+     */
+    [[nodiscard]] virtual std::size_t getBudget() const;
+
+    /**
+     * @brief Gets the memory reserved by the jobs admitted.
+     *
+     * @return Memory reserved, in bytes.
+     */
+    [[nodiscard]] virtual std::size_t getReservedBytes() const;
+
+    /**
+     * @brief Checks if a job is oversized (larger than the budget).
+     *
+     * @param bytes Estimated peak memory of the job, in bytes.
+     *
+     * @return True if the job is oversized, otherwise false.
+     */
+    [[nodiscard]] virtual bool isOversized(const std::size_t bytes) const;
+
+private:
+    /**
+     * @brief Releases the memory of a job.
+     *
+     * @param bytes Memory reserved, in bytes.
+     */
+    void release(const std::size_t bytes);
+
+    /** Budget of memory, in bytes (0 for no budget). */
+    const std::size_t mBudget;
+
+    /** Memory reserved by the jobs admitted, in bytes. */
+    std::size_t mReservedBytes{0};
+    /** Number of jobs admitted and not released. */
+    std::size_t mNumAdmitted{0};
+
+    /** Ticket of the next job arriving. */
+    std::uint64_t mNextTicket{0};
+    /** Ticket of the job to be admitted next. */
+    std::uint64_t mServingTicket{0};
+
+    /** Mutex of the reservations. */
+    mutable std::mutex mMutex;
+    /** Condition of the reservations released or of the next job to be admitted. */
+    std::condition_variable mCondition;
+};
+
+} // namespace common
+} // namespace circuitSegmentation
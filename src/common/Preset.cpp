@@ -0,0 +1,37 @@
+/**
+ * @file
+ */
+
+#include "Preset.h"
+
+namespace circuitSegmentation {
+namespace common {
+
+bool parsePreset(const std::string& name, Preset& preset)
+{
+    for (const auto candidate : {Preset::FAST, Preset::BALANCED, Preset::ACCURATE}) {
+        if (name == getPresetName(candidate)) {
+            preset = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string getPresetName(const Preset preset)
+{
+    switch (preset) {
+    case Preset::FAST:
+        return "fast";
+    case Preset::ACCURATE:
+        return "accurate";
+    case Preset::BALANCED:
+        break;
+    }
+
+    return "balanced";
+}
+
+} // namespace common
+} // namespace circuitSegmentation
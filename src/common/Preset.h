@@ -0,0 +1,47 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <string>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Enumeration of the presets of the pipeline, which trade accuracy for latency.
+ *
+ * Each stage of the pipeline has a coherent set of parameters for each preset (e.g. kernel sizes, iterations of the
+ * morphological operations and thresholding algorithm).
+ */
+enum class Preset : unsigned char {
+    /** Lowest latency: smaller kernels, fewer iterations and cheaper thresholding. */
+    FAST = 0,
+    /** Default parameters of the pipeline. */
+    BALANCED = 1,
+    /** Highest accuracy: additional denoising of the image, at a higher latency. */
+    ACCURATE = 2
+};
+
+/**
+ * @brief Parses the name of a preset (fast, balanced or accurate).
+ *
+ * @param name Name of the preset.
+ * @param preset Preset parsed.
+ *
+ * @return True if the name is of a preset, otherwise false.
+ */
+bool parsePreset(const std::string& name, Preset& preset);
+
+/**
+ * @brief Gets the name of a preset.
+ *
+ * @param preset Preset.
+ *
+ * @return Name of the preset.
+ */
+std::string getPresetName(const Preset preset);
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,66 @@
+/**
+ * @file
+ */
+
+#include "StageProfiler.h"
+#include "ThreadBudget.h"
+#include <ctime>
+
+namespace circuitSegmentation {
+namespace common {
+
+StageProfiler::StageProfiler(const unsigned int numCores)
+    : mNumCores{numCores != 0 ? numCores : ThreadBudget::detectNumCores()}
+{
+    start();
+}
+
+void StageProfiler::start()
+{
+    mWallStart = std::chrono::steady_clock::now();
+    mCpuStartMs = getThreadCpuTimeMs();
+    mProcessCpuStartMs = getProcessCpuTimeMs();
+}
+
+StageUsage StageProfiler::stop(const std::string& name)
+{
+    const auto cpuEndMs{getThreadCpuTimeMs()};
+    const auto processCpuEndMs{getProcessCpuTimeMs()};
+    const auto wallEnd{std::chrono::steady_clock::now()};
+
+    StageUsage usage{};
+    usage.mName = name;
+    usage.mWallTimeMs = std::chrono::duration<double, std::milli>(wallEnd - mWallStart).count();
+    usage.mCpuTimeMs = cpuEndMs - mCpuStartMs;
+    usage.mProcessCpuTimeMs = processCpuEndMs - mProcessCpuStartMs;
+    if (usage.mWallTimeMs > 0) {
+        usage.mProcessUtilization = 100.0 * usage.mProcessCpuTimeMs / (usage.mWallTimeMs * mNumCores);
+    }
+
+    return usage;
+}
+
+unsigned int StageProfiler::getNumCores() const
+{
+    return mNumCores;
+}
+
+double StageProfiler::getThreadCpuTimeMs()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    timespec time{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+        return 1000.0 * static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e6;
+    }
+#endif
+
+    return getProcessCpuTimeMs();
+}
+
+double StageProfiler::getProcessCpuTimeMs()
+{
+    return 1000.0 * static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,105 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Usage of the CPU by a processing stage.
+ */
+struct StageUsage
+{
+    /** Name of the stage. */
+    std::string mName{};
+    /** Wall-clock time, in milliseconds. */
+    double mWallTimeMs{0};
+    /** CPU time of the thread running the stage (the application worker), in milliseconds. */
+    double mCpuTimeMs{0};
+    /** CPU time of the whole process (all threads), in milliseconds. */
+    double mProcessCpuTimeMs{0};
+    /** CPU utilization of the whole process, in percentage of the cores available (100 % means all the cores busy). */
+    double mProcessUtilization{0};
+};
+
+/**
+ * @brief Profiler of the CPU utilization achieved by the processing stages.
+ *
+ * The CPU time of the thread running the stage is its own work only. The CPU time of the process includes the threads
+ * of OpenCV and the threads for writing images that run during the stage, but also the other application workers
+ * (e.g. in the daemon mode), so it is only the work of the stage when a single image is processed.
+ */
+class StageProfiler
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param numCores Number of cores available (0 to detect them).
+     */
+    explicit StageProfiler(const unsigned int numCores = 0);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~StageProfiler() = default;
+
+    /**
+     * @brief Starts the measurement of a stage.
+     */
+    virtual void start();
+
+    /**
+     * @brief Stops the measurement of a stage.
+     *
+     * @param name Name of the stage.
+     *
+     * @return Usage of the CPU by the stage, since the last start.
+     */
+    virtual StageUsage stop(const std::string& name);
+
+    /**
+     * @brief Gets the number of cores considered for the utilization.
+     *
+     * @return Number of cores.
+     */
+    [[nodiscard]] virtual unsigned int getNumCores() const;
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Gets the CPU time of the calling thread.
+     *
+     * @return CPU time, in milliseconds (of the process where the time of a thread is not supported).
+     */
+    static double getThreadCpuTimeMs();
+
+    /**
+     * @brief Gets the CPU time of the process.
+     *
+     * @return CPU time, in milliseconds.
+     */
+    static double getProcessCpuTimeMs();
+
+private:
+    /** Number of cores available. */
+    unsigned int mNumCores;
+
+    /** Wall-clock time at the start of the stage. */
+    std::chrono::steady_clock::time_point mWallStart{};
+
+    /** CPU time of the thread at the start of the stage, in milliseconds. */
+    double mCpuStartMs{0};
+
+    /** CPU time of the process at the start of the stage, in milliseconds. */
+    double mProcessCpuStartMs{0};
+};
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,307 @@
+/**
+ * @file
+ *
+ * @brief Coroutine task and awaitables of the asynchronous processing.
+ *
+ * The coroutines require compiler support (e.g. GCC 10 or later), so everything in this file is only available when
+ * COROUTINES_SUPPORTED is defined.
+ */
+
+#pragma once
+
+#include "Executor.h"
+#include <version>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define COROUTINES_SUPPORTED
+#endif
+
+#ifdef COROUTINES_SUPPORTED
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Coroutine that produces a value.
+ *
+ * The task is lazy: it starts when it is awaited by another coroutine (co_await), or when it is started by
+ * @ref startTask. The awaiting coroutine is resumed, on the same thread, when the task completes. An exception thrown
+ * by the task is rethrown to the awaiting coroutine.
+ *
+ * @tparam T Type of the value.
+ */
+template<typename T>
+class Task
+{
+public:
+    /**
+     * @brief Promise of the coroutine.
+     */
+    class promise_type
+    {
+    public:
+        /**
+         * @brief Awaitable of the end of the coroutine, which resumes the awaiting coroutine.
+         */
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+            {
+                return handle.promise().mContinuation;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        Task get_return_object() noexcept
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_value(T value)
+        {
+            mValue.emplace(std::move(value));
+        }
+
+        void unhandled_exception() noexcept
+        {
+            mException = std::current_exception();
+        }
+
+        /**
+         * @brief Takes the value of the coroutine, rethrowing its exception if it failed.
+         *
+         * @return Value.
+         */
+        T takeValue()
+        {
+            if (mException) {
+                std::rethrow_exception(mException);
+            }
+
+            return std::move(*mValue);
+        }
+
+        /** Coroutine resumed when the coroutine completes. */
+        std::coroutine_handle<> mContinuation{std::noop_coroutine()};
+
+    private:
+        /** Value of the coroutine. */
+        std::optional<T> mValue{};
+        /** Exception thrown by the coroutine. */
+        std::exception_ptr mException{};
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param handle Handle of the coroutine, owned by the task.
+     */
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : mHandle{handle}
+    {
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other Task moved.
+     */
+    Task(Task&& other) noexcept
+        : mHandle{std::exchange(other.mHandle, nullptr)}
+    {
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task& operator=(Task&&) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * The coroutine is destroyed, so the task must not be destroyed while it is running.
+     */
+    ~Task()
+    {
+        if (mHandle) {
+            mHandle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return !mHandle || mHandle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+    {
+        mHandle.promise().mContinuation = continuation;
+
+        // Start the task on the thread of the awaiting coroutine
+        return mHandle;
+    }
+
+    T await_resume()
+    {
+        return mHandle.promise().takeValue();
+    }
+
+private:
+    /** Handle of the coroutine. */
+    std::coroutine_handle<promise_type> mHandle;
+};
+
+/**
+ * @brief Awaitable that resumes the awaiting coroutine on a thread of an executor.
+ */
+class ScheduleAwaiter
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param executor Executor.
+     */
+    explicit ScheduleAwaiter(Executor& executor)
+        : mExecutor{executor}
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const
+    {
+        mExecutor.execute([handle]() { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    /** Executor. */
+    Executor& mExecutor;
+};
+
+/**
+ * @brief Suspends the awaiting coroutine and queues its resumption on an executor.
+ *
+ * It is the point where a coroutine yields its thread, so the tasks queued before it on the executor run first.
+ *
+ * @param executor Executor.
+ *
+ * @return Awaitable.
+ */
+inline ScheduleAwaiter schedule(Executor& executor)
+{
+    return ScheduleAwaiter{executor};
+}
+
+namespace detail {
+
+/**
+ * @brief Coroutine that runs until completion without being awaited, destroying itself at the end.
+ */
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief Awaits a task and calls the callback of its outcome.
+ *
+ * @tparam T Type of the value of the task.
+ *
+ * @param task Task.
+ * @param onCompleted Callback called with the value of the task.
+ * @param onFailed Callback called with the exception thrown by the task.
+ *
+ * @return Detached coroutine.
+ */
+template<typename T>
+DetachedTask runDetached(Task<T> task,
+                         std::function<void(T)> onCompleted,
+                         std::function<void(std::exception_ptr)> onFailed)
+{
+    std::optional<T> value{};
+    try {
+        value.emplace(co_await task);
+    } catch (...) {
+        onFailed(std::current_exception());
+    }
+
+    if (value) {
+        onCompleted(std::move(*value));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Starts a task from code that is not a coroutine (e.g. the callback of an event loop).
+ *
+ * The task runs on the calling thread until its first suspension, and then on the threads that resume it. One of the
+ * callbacks is called, on the thread where the task completes. The task is owned until it completes, so the caller does
+ * not have to keep it.
+ *
+ * @tparam T Type of the value of the task.
+ *
+ * @param task Task.
+ * @param onCompleted Callback called with the value of the task.
+ * @param onFailed Callback called with the exception thrown by the task.
+ */
+template<typename T>
+void startTask(Task<T> task, std::function<void(T)> onCompleted, std::function<void(std::exception_ptr)> onFailed)
+{
+    detail::runDetached(std::move(task), std::move(onCompleted), std::move(onFailed));
+}
+
+} // namespace common
+} // namespace circuitSegmentation
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file
+ */
+
+#include "ThreadBudget.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace circuitSegmentation {
+namespace common {
+
+ThreadBudget::ThreadBudget(const RunMode runMode,
+                           const unsigned int numWriterThreads,
+                           const bool pinThreads,
+                           const unsigned int numCores)
+    : mRunMode{runMode}
+    , mNumCores{numCores != 0 ? numCores : detectNumCores()}
+    , mNumAppWorkers{1}
+    , mNumOpenCvThreads{1}
+    , mNumWriterThreads{numWriterThreads != 0 ? numWriterThreads : cNumWriterThreadsDefault}
+    , mPinThreads{pinThreads}
+{
+    switch (mRunMode) {
+    case RunMode::BATCH:
+        mNumAppWorkers = mNumCores;
+        mNumOpenCvThreads = 1;
+        break;
+    case RunMode::SINGLE_IMAGE:
+    default:
+        mNumAppWorkers = 1;
+        mNumOpenCvThreads = mNumCores;
+        break;
+    }
+}
+
+ThreadBudget::RunMode ThreadBudget::getRunMode() const
+{
+    return mRunMode;
+}
+
+unsigned int ThreadBudget::getNumCores() const
+{
+    return mNumCores;
+}
+
+unsigned int ThreadBudget::getNumAppWorkers() const
+{
+    return mNumAppWorkers;
+}
+
+unsigned int ThreadBudget::getNumOpenCvThreads() const
+{
+    return mNumOpenCvThreads;
+}
+
+unsigned int ThreadBudget::getNumWriterThreads() const
+{
+    return mNumWriterThreads;
+}
+
+bool ThreadBudget::getPinThreads() const
+{
+    return mPinThreads;
+}
+
+bool ThreadBudget::pinCurrentThread(const unsigned int workerIndex) const
+{
+    if (!mPinThreads) {
+        return false;
+    }
+
+#ifdef __linux__
+    cpu_set_t cpuSet{};
+    CPU_ZERO(&cpuSet);
+    CPU_SET(workerIndex % mNumCores, &cpuSet);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    return false;
+#endif
+}
+
+std::function<void(unsigned int)> ThreadBudget::getWorkerPinning() const
+{
+    if (!mPinThreads) {
+        return {};
+    }
+
+    return [threadBudget{*this}](const unsigned int workerIndex) {
+        static_cast<void>(threadBudget.pinCurrentThread(workerIndex));
+    };
+}
+
+unsigned int ThreadBudget::detectNumCores()
+{
+    return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,150 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Budget of threads of the application.
+ *
+ * The cores are shared by the application workers (each one processing an image) and by the internal parallelism of
+ * OpenCV (e.g. in blurring, thresholding and morphological operations). Running both at full width oversubscribes the
+ * cores, so the budget splits them according to the run mode:
+ * - Single image: one application worker, and OpenCV uses all the cores.
+ * - Batch: one application worker per core, and OpenCV runs serially in each worker.
+ *
+ * The threads for writing images are mostly waiting for the file system, so they are not taken from the budget.
+ */
+class ThreadBudget
+{
+public:
+    /**
+     * @brief Enumeration of the run modes.
+     */
+    enum class RunMode : unsigned char {
+        /** One image processed at a time. */
+        SINGLE_IMAGE = 0,
+        /** Several images processed in parallel. */
+        BATCH = 1
+    };
+
+    /** Default number of threads for writing images. */
+    static constexpr unsigned int cNumWriterThreadsDefault{2};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param runMode Run mode.
+     * @param numWriterThreads Number of threads for writing images (0 to use the default).
+     * @param pinThreads Pin the application workers to cores.
+     * @param numCores Number of cores available (0 to detect them).
+     */
+    explicit ThreadBudget(const RunMode runMode = RunMode::SINGLE_IMAGE,
+                          const unsigned int numWriterThreads = 0,
+                          const bool pinThreads = false,
+                          const unsigned int numCores = 0);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~ThreadBudget() = default;
+
+    /**
+     * @brief Gets the run mode.
+     *
+     * @return Run mode.
+     */
+    [[nodiscard]] virtual RunMode getRunMode() const;
+
+    /**
+     * @brief Gets the number of cores available.
+     *
+     * @return Number of cores.
+     */
+    [[nodiscard]] virtual unsigned int getNumCores() const;
+
+    /**
+     * @brief Gets the number of application workers.
+     *
+     * @return Number of application workers.
+     */
+    [[nodiscard]] virtual unsigned int getNumAppWorkers() const;
+
+    /**
+     * @brief Gets the number of threads for the internal parallelism of OpenCV, in each application worker.
+     *
+     * @return Number of OpenCV threads.
+     */
+    [[nodiscard]] virtual unsigned int getNumOpenCvThreads() const;
+
+    /**
+     * @brief Gets the number of threads for writing images.
+     *
+     * @return Number of threads for writing images.
+     */
+    [[nodiscard]] virtual unsigned int getNumWriterThreads() const;
+
+    /**
+     * @brief Checks if the application workers are pinned to cores.
+     *
+     * @return True if the application workers are pinned, otherwise false.
+     */
+    [[nodiscard]] virtual bool getPinThreads() const;
+
+    /**
+     * @brief Pins the calling thread to a core, if pinning is enabled.
+     *
+     * The worker with index i is pinned to the core i modulo the number of cores. Pinning is only supported on Linux.
+     *
+     * @param workerIndex Index of the application worker.
+     *
+     * @return True if the thread was pinned, otherwise false.
+     */
+    virtual bool pinCurrentThread(const unsigned int workerIndex) const;
+
+    /**
+     * @brief Gets the function pinning each thread of a pool of application workers to its own core, to be called
+     * by the threads when they start (see @ref ThreadPool::ThreadStart).
+     *
+     * The threads are pinned from the pool, and not from the thread creating it, so the other threads created later
+     * (e.g. the internal threads of OpenCV) do not inherit the affinity of a single core.
+     *
+     * @return Function pinning the calling thread to the core of its index, or an empty function if pinning is
+     * disabled.
+     */
+    [[nodiscard]] virtual std::function<void(unsigned int)> getWorkerPinning() const;
+
+    /**
+     * @brief Detects the number of cores available.
+     *
+     * @return Number of cores (at least 1).
+     */
+    [[nodiscard]] static unsigned int detectNumCores();
+
+private:
+    /** Run mode. */
+    RunMode mRunMode;
+
+    /** Number of cores available. */
+    unsigned int mNumCores;
+
+    /** Number of application workers. */
+    unsigned int mNumAppWorkers;
+
+    /** Number of OpenCV threads in each application worker. */
+    unsigned int mNumOpenCvThreads;
+
+    /** Number of threads for writing images. */
+    unsigned int mNumWriterThreads;
+
+    /** Flag to pin the application workers to cores. */
+    bool mPinThreads;
+};
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,136 @@
+/**
+ * @file
+ */
+
+#include "ThreadPool.h"
+#include "CancellationToken.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace circuitSegmentation {
+namespace common {
+
+ThreadPool::ThreadPool(const unsigned int numThreads, const ThreadStart& threadStart)
+    : mWorkers{}
+    , mTasks{}
+{
+    const auto workers{std::max(numThreads, 1U)};
+
+    mWorkers.reserve(workers);
+    for (auto i{0U}; i < workers; ++i) {
+        mWorkers.emplace_back([this, i, threadStart]() {
+            if (threadStart) {
+                threadStart(i);
+            }
+            workerLoop();
+        });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        mStop = true;
+    }
+    mTaskAvailable.notify_all();
+
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::execute(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        mTasks.emplace(std::move(task));
+    }
+    mTaskAvailable.notify_one();
+}
+
+void ThreadPool::runAll(const std::size_t numTasks, const std::function<void(std::size_t)>& task)
+{
+    const auto jobId{logging::Logger::getJobId()};
+    const auto* cancellationToken{CancellationToken::getCurrent()};
+
+    std::vector<std::future<void>> futures{};
+    futures.reserve(numTasks);
+    for (std::size_t i{0}; i < numTasks; ++i) {
+        futures.push_back(submit([&task, i, jobId, cancellationToken]() {
+            logging::Logger::setJobId(jobId);
+            CancellationToken::setCurrent(cancellationToken);
+            try {
+                task(i);
+            } catch (...) {
+                logging::Logger::setJobId(0);
+                CancellationToken::setCurrent(nullptr);
+                throw;
+            }
+            logging::Logger::setJobId(0);
+            CancellationToken::setCurrent(nullptr);
+        }));
+    }
+
+    // All the tasks are waited for, since they refer to the task of the caller
+    std::exception_ptr exception{};
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock{mMutex};
+    mIdle.wait(lock, [this]() { return mTasks.empty() && mActiveTasks == 0; });
+}
+
+unsigned int ThreadPool::getNumThreads() const
+{
+    return static_cast<unsigned int>(mWorkers.size());
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true) {
+        std::function<void()> task{};
+
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mTaskAvailable.wait(lock, [this]() { return mStop || !mTasks.empty(); });
+
+            // Queued tasks are always executed before stopping
+            if (mTasks.empty()) {
+                return;
+            }
+
+            task = std::move(mTasks.front());
+            mTasks.pop();
+            ++mActiveTasks;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock{mMutex};
+            --mActiveTasks;
+            if (mTasks.empty() && mActiveTasks == 0) {
+                mIdle.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace common
+} // namespace circuitSegmentation
@@ -0,0 +1,134 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "Executor.h"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace common {
+
+/**
+ * @brief Pool of worker threads that execute tasks in submission order.
+ *
+ * It is also the default executor of the asynchronous processing.
+ */
+class ThreadPool : public Executor
+{
+public:
+    /** Function called by each worker thread when it starts, with the index of the thread (e.g. to pin it). */
+    using ThreadStart = std::function<void(unsigned int)>;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param numThreads Number of worker threads. At least one worker thread is always created.
+     * @param threadStart Function called by each worker thread when it starts (empty for none).
+     */
+    explicit ThreadPool(const unsigned int numThreads, const ThreadStart& threadStart = {});
+
+    /**
+     * @brief Destructor.
+     *
+     * The tasks already submitted are executed before the worker threads are joined.
+     */
+    virtual ~ThreadPool();
+
+    /**
+     * @brief Submits a task for execution by the worker threads.
+     *
+     * @param task Callable without arguments.
+     *
+     * @return Future for the result of the task.
+     */
+    template<typename Task>
+    auto submit(Task&& task) -> std::future<std::invoke_result_t<std::decay_t<Task>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<Task>>;
+
+        // The packaged task is not copyable, so it is shared with the queued function
+        auto packagedTask{std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task))};
+        auto future{packagedTask->get_future()};
+
+        {
+            std::lock_guard<std::mutex> lock{mMutex};
+            mTasks.emplace([packagedTask]() { (*packagedTask)(); });
+        }
+        mTaskAvailable.notify_one();
+
+        return future;
+    }
+
+    /**
+     * @brief Queues a task for execution by the worker threads, without a future for its result.
+     *
+     * @param task Task.
+     */
+    void execute(std::function<void()> task) override;
+
+    /**
+     * @brief Runs tasks in the worker threads, and waits until all of them are executed.
+     *
+     * The tasks run in the job of the calling thread: its job ID and cancellation token are set in the worker threads
+     * while they execute the tasks. It must not be called from a worker thread of the pool.
+     *
+     * @param numTasks Number of tasks.
+     * @param task Task, called with the index of each task. If tasks throw, the first exception is rethrown once all
+     * the tasks are executed.
+     */
+    virtual void runAll(const std::size_t numTasks, const std::function<void(std::size_t)>& task);
+
+    /**
+     * @brief Waits until all the submitted tasks are executed.
+     */
+    virtual void waitIdle();
+
+    /**
+     * @brief Gets the number of worker threads.
+     *
+     * @return Number of worker threads.
+     */
+    [[nodiscard]] virtual unsigned int getNumThreads() const;
+
+private:
+    /**
+     * @brief Loop of a worker thread, executing the queued tasks until the pool is stopped.
+     */
+    void workerLoop();
+
+private:
+    /** Worker threads. */
+    std::vector<std::thread> mWorkers;
+
+    /** Queued tasks. */
+    std::queue<std::function<void()>> mTasks;
+
+    /** Mutex for the queue and state of the pool. */
+    std::mutex mMutex;
+
+    /** Condition signaled when a task is queued or the pool is stopped. */
+    std::condition_variable mTaskAvailable;
+
+    /** Condition signaled when the pool becomes idle. */
+    std::condition_variable mIdle;
+
+    /** Number of tasks being executed. */
+    unsigned int mActiveTasks{0};
+
+    /** Flag to stop the worker threads. */
+    bool mStop{false};
+};
+
+} // namespace common
+} // namespace circuitSegmentation
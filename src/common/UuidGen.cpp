@@ -9,6 +9,9 @@
 namespace circuitSegmentation {
 namespace common {
 
+const uuids::uuid UuidGen::cAppNamespace{
+    uuids::uuid_name_generator{uuids::uuid_namespace_url}("https://github.com/urisolve/circuit-segmentation")};
+
 uuids::uuid UuidGen::generateUuid() const
 {
     const uuids::uuid id = uuids::uuid_system_generator{}();
@@ -22,5 +25,18 @@ std::string UuidGen::generateStringUuid() const
     return uuids::to_string(id);
 }
 
+uuids::uuid UuidGen::generateNameUuid(const uuids::uuid& namespaceId, const std::string& name) const
+{
+    uuids::uuid_name_generator generator{namespaceId};
+    return generator(name);
+}
+
+std::string UuidGen::generateStringNameUuid(const uuids::uuid& namespaceId, const std::string& name) const
+{
+    const auto id = generateNameUuid(namespaceId, name);
+
+    return uuids::to_string(id);
+}
+
 } // namespace common
 } // namespace circuitSegmentation
@@ -39,6 +39,29 @@ public:
      * @return New UUID.
      */
     virtual std::string generateStringUuid() const;
+
+    /**
+     * @brief Generate a UUID derived from a name (version 5, SHA-1), always the same for the same namespace and name.
+     *
+     * @param namespaceId Namespace of the name.
+     * @param name Name.
+     *
+     * @return UUID of the name.
+     */
+    virtual uuids::uuid generateNameUuid(const uuids::uuid& namespaceId, const std::string& name) const;
+
+    /**
+     * @brief Generate a UUID derived from a name as string.
+     *
+     * @param namespaceId Namespace of the name.
+     * @param name Name.
+     *
+     * @return UUID of the name.
+     */
+    virtual std::string generateStringNameUuid(const uuids::uuid& namespaceId, const std::string& name) const;
+
+    /** Namespace of the names of the application (derived from its URL). */
+    static const uuids::uuid cAppNamespace;
 };
 
 } // namespace common
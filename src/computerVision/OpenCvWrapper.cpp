@@ -3,6 +3,9 @@
  */
 
 #include "OpenCvWrapper.h"
+#include "common/CancellationToken.h"
+#include "common/ContentHash.h"
+#include <array>
 #include <opencv2/core/utils/logger.hpp>
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -31,6 +34,16 @@ bool OpenCvWrapper::getLogMode() const
     }
 }
 
+void OpenCvWrapper::setNumThreads(const int numThreads)
+{
+    cv::setNumThreads(numThreads);
+}
+
+int OpenCvWrapper::getNumThreads() const
+{
+    return cv::getNumThreads();
+}
+
 // LCOV_EXCL_START
 // Rationale: It is not worth to test this logic.
 void OpenCvWrapper::showImage(const std::string& windowName, ImageMat& image, int delay)
@@ -65,12 +78,200 @@ ImageMat OpenCvWrapper::readImage(const std::string& fileName)
     return image;
 }
 
+std::size_t OpenCvWrapper::countImagePages(const std::string& fileName)
+{
+    // Count pages
+    std::size_t numPages{0};
+
+    try {
+        numPages = cv::imcount(fileName, cv::IMREAD_COLOR);
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        numPages = 0;
+    }
+
+    return numPages;
+}
+
+ImageMat OpenCvWrapper::readImagePage(const std::string& fileName, const int page)
+{
+    // Read page
+    std::vector<ImageMat> pages{};
+
+    try {
+        if (!cv::imreadmulti(fileName, pages, page, 1, cv::IMREAD_COLOR) || pages.empty()) {
+            return ImageMat{};
+        }
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        return ImageMat{};
+    }
+
+    return pages.front();
+}
+
+ImageMat OpenCvWrapper::decodeImage(const std::vector<unsigned char>& buffer)
+{
+    // Decode image
+    ImageMat image{};
+
+    try {
+        image = cv::imdecode(buffer, cv::IMREAD_COLOR);
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        image = ImageMat{};
+    }
+
+    return image;
+}
+
+bool OpenCvWrapper::encodeImage(const std::string& extension, ImageMat& image, std::vector<unsigned char>& buffer)
+{
+    // Result of the operation
+    auto result{false};
+
+    try {
+        // Encode image
+        result = cv::imencode(extension, image, buffer);
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        result = false;
+    }
+
+    return result;
+}
+
+ImageMat OpenCvWrapper::wrapImageBuffer(const unsigned char* data,
+                                        const int width,
+                                        const int height,
+                                        const std::size_t stride,
+                                        const PixelFormat format)
+{
+    // Type and conversion to BGR of each format
+    int type{CV_8UC3};
+    int conversion{-1};
+    switch (format) {
+    case PixelFormat::GRAY:
+        type = CV_8UC1;
+        conversion = cv::COLOR_GRAY2BGR;
+        break;
+    case PixelFormat::BGRA:
+        type = CV_8UC4;
+        conversion = cv::COLOR_BGRA2BGR;
+        break;
+    case PixelFormat::RGB:
+        type = CV_8UC3;
+        conversion = cv::COLOR_RGB2BGR;
+        break;
+    case PixelFormat::RGBA:
+        type = CV_8UC4;
+        conversion = cv::COLOR_RGBA2BGR;
+        break;
+    case PixelFormat::BGR:
+    default:
+        break;
+    }
+
+    // Check buffer
+    if (data == nullptr || width <= 0 || height <= 0
+        || stride < static_cast<std::size_t>(width) * static_cast<std::size_t>(CV_MAT_CN(type))) {
+        return ImageMat{};
+    }
+
+    ImageMat image{};
+
+    try {
+        // Wrap the pixels (the image is not modified by the processing, so the constness is kept)
+        ImageMat wrapped{height, width, type, const_cast<unsigned char*>(data), stride};
+
+        if (conversion < 0) {
+            image = wrapped;
+        } else {
+            cv::cvtColor(wrapped, image, conversion);
+        }
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        image = ImageMat{};
+    }
+
+    return image;
+}
+
+ImageMat OpenCvWrapper::viewImageBuffer(const unsigned char* data,
+                                        const int width,
+                                        const int height,
+                                        const std::size_t stride,
+                                        const int type)
+{
+    // Check buffer
+    if (data == nullptr || width <= 0 || height <= 0
+        || stride < static_cast<std::size_t>(width) * static_cast<std::size_t>(CV_ELEM_SIZE(type))) {
+        return ImageMat{};
+    }
+
+    ImageMat image{};
+
+    try {
+        // Wrap the pixels (the image is not modified by the processing, so the constness is kept)
+        image = ImageMat{height, width, type, const_cast<unsigned char*>(data), stride};
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        image = ImageMat{};
+    }
+
+    return image;
+}
+
+ImageMat OpenCvWrapper::copyImageBuffer(const unsigned char* data,
+                                        const int width,
+                                        const int height,
+                                        const std::size_t stride,
+                                        const int type)
+{
+    // Check buffer
+    if (data == nullptr || width <= 0 || height <= 0
+        || stride < static_cast<std::size_t>(width) * static_cast<std::size_t>(CV_ELEM_SIZE(type))) {
+        return ImageMat{};
+    }
+
+    ImageMat image{};
+
+    try {
+        // Copy the pixels, so the buffer can be released
+        image = ImageMat{height, width, type, const_cast<unsigned char*>(data), stride}.clone();
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        image = ImageMat{};
+    }
+
+    return image;
+}
+
 ImageMat OpenCvWrapper::cloneImage(ImageMat& image)
 {
     return image.clone();
 }
 
 bool OpenCvWrapper::cropImage(ImageMat& srcImg, ImageMat& dstImg, const Rectangle& roi)
+{
+    // Reference to the image region
+    ImageMat croppedRef{};
+    if (!cropImageView(srcImg, croppedRef, roi)) {
+        return false;
+    }
+
+    try {
+        // Copy the data
+        croppedRef.copyTo(dstImg);
+    }
+    catch ([[maybe_unused]] const cv::Exception& ex) {
+        return false;
+    }
+
+    return true;
+}
+
+bool OpenCvWrapper::cropImageView(ImageMat& srcImg, ImageMat& dstImg, const Rectangle& roi)
 {
     const auto valid{0 <= roi.x && 0 <= roi.width && roi.x + roi.width <= srcImg.cols && 0 <= roi.y && 0 <= roi.height
                      && roi.y + roi.height <= srcImg.rows};
@@ -83,10 +284,7 @@ bool OpenCvWrapper::cropImage(ImageMat& srcImg, ImageMat& dstImg, const Rectangl
         // Crop image
         // Note that this does not copy the data, it only creates a reference to that image region. This means that if
         // the cropped image changes, it also changes the source image.
-        cv::Mat croppedRef = srcImg(roi);
-
-        // Copy the data
-        croppedRef.copyTo(dstImg);
+        dstImg = srcImg(roi);
     }
     catch ([[maybe_unused]] const cv::Exception& ex) {
         return false;
@@ -106,6 +304,26 @@ void OpenCvWrapper::resizeImage(ImageMat& srcImg, ImageMat& dstImg, const double
     cv::resize(srcImg, dstImg, cv::Size(), scale, scale, cv::InterpolationFlags::INTER_LINEAR);
 }
 
+void OpenCvWrapper::thumbnailImage(ImageMat& srcImg, ImageMat& dstImg, const int width, const int height)
+{
+    // Grayscale
+    ImageMat grayImg{};
+    switch (srcImg.channels()) {
+    case 3:
+        cv::cvtColor(srcImg, grayImg, cv::COLOR_BGR2GRAY);
+        break;
+    case 4:
+        cv::cvtColor(srcImg, grayImg, cv::COLOR_BGRA2GRAY);
+        break;
+    default:
+        grayImg = srcImg;
+        break;
+    }
+
+    // Resize image, averaging the pixels of each area
+    cv::resize(grayImg, dstImg, cv::Size(width, height), 0, 0, cv::InterpolationFlags::INTER_AREA);
+}
+
 int OpenCvWrapper::getImageWidth(ImageMat& image) const
 {
     return image.size().width;
@@ -116,8 +334,46 @@ int OpenCvWrapper::getImageHeight(ImageMat& image) const
     return image.size().height;
 }
 
+std::size_t OpenCvWrapper::getImageSizeBytes(ImageMat& image) const
+{
+    return image.total() * image.elemSize();
+}
+
+std::uint64_t OpenCvWrapper::hashImage(ImageMat& image) const
+{
+    common::ContentHash contentHash{};
+
+    // Dimensions and type, so images with the same bytes and different shapes differ
+    const std::array<int, 3> shape{image.cols, image.rows, image.type()};
+    contentHash.update(shape.data(), sizeof(shape));
+
+    // Pixels, row by row
+    const auto rowSize{static_cast<std::size_t>(image.cols) * image.elemSize()};
+    for (int row{0}; row < image.rows; ++row) {
+        contentHash.update(image.ptr(row), rowSize);
+    }
+
+    return contentHash.getDigest();
+}
+
+int OpenCvWrapper::getImageType(ImageMat& image) const
+{
+    return image.type();
+}
+
+const unsigned char* OpenCvWrapper::getImageRow(ImageMat& image, const int row) const
+{
+    return image.ptr(row);
+}
+
 void OpenCvWrapper::convertImageToGray(ImageMat& srcImg, ImageMat& dstImg)
 {
+    // Image already in grayscale (e.g. a PGM file mapped in memory)
+    if (srcImg.channels() == 1) {
+        dstImg = srcImg;
+        return;
+    }
+
     // Convert to grayscale
     cv::cvtColor(srcImg, dstImg, cv::COLOR_BGR2GRAY);
 }
@@ -218,12 +474,13 @@ void OpenCvWrapper::thinning(ImageMat& srcImg, ImageMat& dstImg, const ThinningA
     cv::Mat prev = cv::Mat::zeros(processed.size(), CV_8UC1);
     cv::Mat diff;
 
+    // Each pass is checked for cancellation, so a job stopped returns with the image thinned partially
     do {
         thinningIter(processed, 0, thinningAlg);
         thinningIter(processed, 1, thinningAlg);
         cv::absdiff(processed, prev, diff);
         processed.copyTo(prev);
-    } while (cv::countNonZero(diff) > 0);
+    } while (cv::countNonZero(diff) > 0 && !common::CancellationToken::isCurrentStopped());
 
     processed *= 255;
 
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <opencv2/core.hpp>
 #include <string>
+#include <vector>
 
 namespace circuitSegmentation {
 namespace computerVision {
@@ -33,6 +36,9 @@ using InputOutputArray = cv::InputOutputArray;
 class OpenCvWrapper
 {
 public:
+    /** Type of the pixels of a grayscale image, 8 bits per pixel (see @ref getImageType). */
+    static constexpr int cImageTypeGray{CV_8UC1};
+
     /**
      * @brief Enumeration of the adaptive threshold algorithms.
      *
@@ -167,6 +173,22 @@ public:
         THINNING_GUOHALL = 1
     };
 
+    /**
+     * @brief Enumeration of the formats of raw pixels.
+     */
+    enum class PixelFormat : unsigned char {
+        /** 8 bits per pixel, grayscale. */
+        GRAY = 0,
+        /** 24 bits per pixel, in blue, green and red order. */
+        BGR = 1,
+        /** 32 bits per pixel, in blue, green, red and alpha order. */
+        BGRA = 2,
+        /** 24 bits per pixel, in red, green and blue order. */
+        RGB = 3,
+        /** 32 bits per pixel, in red, green, blue and alpha order. */
+        RGBA = 4
+    };
+
     /**
      * @brief Constructor.
      */
@@ -191,6 +213,22 @@ public:
      */
     [[nodiscard]] virtual bool getLogMode() const;
 
+    /**
+     * @brief Sets the number of threads used by OpenCV for its parallel regions.
+     *
+     * This setting is global to the process, so it applies to all the threads calling OpenCV.
+     *
+     * @param numThreads Number of threads (1 disables the internal parallelism of OpenCV).
+     */
+    virtual void setNumThreads(const int numThreads);
+
+    /**
+     * @brief Gets the number of threads used by OpenCV for its parallel regions.
+     *
+     * @return Number of threads.
+     */
+    [[nodiscard]] virtual int getNumThreads() const;
+
     /**
      * @brief Shows the image in a new window.
      *
@@ -221,6 +259,104 @@ public:
      */
     virtual ImageMat readImage(const std::string& fileName);
 
+    /**
+     * @brief Counts the pages of an image file (e.g. the pages of a multi-page TIFF file), without decoding them.
+     *
+     * @param fileName File name.
+     *
+     * @return Number of pages (1 for the single-page formats), or 0 if the file cannot be read.
+     */
+    [[nodiscard]] virtual std::size_t countImagePages(const std::string& fileName);
+
+    /**
+     * @brief Reads a page of an image file, in the format returned by @ref readImage. Only that page is decoded.
+     *
+     * @param fileName File name.
+     * @param page Index of the page, from 0.
+     *
+     * @return Page read from the specified file, or if the page cannot be read (because of missing file or page,
+     * improper permissions, unsupported or invalid format), an empty matrix.
+     */
+    virtual ImageMat readImagePage(const std::string& fileName, const int page);
+
+    /**
+     * @brief Decodes the image from a buffer in memory, encoded in any format supported by @ref readImage.
+     *
+     * @param buffer Buffer with the encoded image.
+     *
+     * @return Image decoded from the buffer, or if the buffer cannot be decoded (because of unsupported or invalid
+     * format), an empty matrix.
+     */
+    virtual ImageMat decodeImage(const std::vector<unsigned char>& buffer);
+
+    /**
+     * @brief Encodes the image to a buffer in memory, in the same way as @ref writeImage writes it to a file.
+     *
+     * @param extension File extension that defines the format (e.g. ".png").
+     * @param image Image.
+     * @param buffer Buffer with the encoded image.
+     *
+     * @return True if the operation occurred successfully, otherwise false.
+     */
+    virtual bool encodeImage(const std::string& extension, ImageMat& image, std::vector<unsigned char>& buffer);
+
+    /**
+     * @brief Wraps a buffer of raw pixels as a color image, in the format returned by @ref readImage.
+     *
+     * The pixels in BGR format are wrapped without copying, so the buffer must outlive the image and the image must
+     * not be modified. The pixels in any other format are converted to a new image.
+     *
+     * @param data Pixels, row by row.
+     * @param width Width of the image, in pixels.
+     * @param height Height of the image, in pixels.
+     * @param stride Size of each row of the buffer, in bytes (it can include padding).
+     * @param format Format of the pixels.
+     *
+     * @return Color image, or an empty matrix if the buffer is invalid (e.g. null data or stride too small).
+     */
+    virtual ImageMat wrapImageBuffer(const unsigned char* data,
+                                     const int width,
+                                     const int height,
+                                     const std::size_t stride,
+                                     const PixelFormat format);
+
+    /**
+     * @brief Wraps a buffer of raw pixels as an image, keeping their type (see @ref getImageType), without copying
+     * or converting them.
+     *
+     * The buffer must outlive the image and the image must not be modified (e.g. a file mapped read-only).
+     *
+     * @param data Pixels, row by row.
+     * @param width Width of the image, in pixels.
+     * @param height Height of the image, in pixels.
+     * @param stride Size of each row of the buffer, in bytes (it can include padding).
+     * @param type Type of the pixels.
+     *
+     * @return Image, or an empty matrix if the buffer is invalid (e.g. null data or stride too small).
+     */
+    virtual ImageMat viewImageBuffer(const unsigned char* data,
+                                     const int width,
+                                     const int height,
+                                     const std::size_t stride,
+                                     const int type);
+
+    /**
+     * @brief Copies a buffer of raw pixels to a new image, keeping their type (see @ref getImageType).
+     *
+     * @param data Pixels, row by row.
+     * @param width Width of the image, in pixels.
+     * @param height Height of the image, in pixels.
+     * @param stride Size of each row of the buffer, in bytes (it can include padding).
+     * @param type Type of the pixels.
+     *
+     * @return Image, or an empty matrix if the buffer is invalid (e.g. null data or stride too small).
+     */
+    virtual ImageMat copyImageBuffer(const unsigned char* data,
+                                     const int width,
+                                     const int height,
+                                     const std::size_t stride,
+                                     const int type);
+
     /**
      * @brief Clones an image.
      *
@@ -241,6 +377,18 @@ public:
      */
     virtual bool cropImage(ImageMat& srcImg, ImageMat& dstImg, const Rectangle& roi);
 
+    /**
+     * @brief Crops an image from a region of interest (ROI), without copying the data.
+     *
+     * @param srcImg Image to be cropped.
+     * @param dstImg Image with region of interest. It references the data of the source image, so any change in one of
+     * them is visible in the other.
+     * @param roi Region of interest to crop the image.
+     *
+     * @return True if operation occurred successfully, false otherwise.
+     */
+    virtual bool cropImageView(ImageMat& srcImg, ImageMat& dstImg, const Rectangle& roi);
+
     /**
      * @brief Checks if an image is empty.
      *
@@ -259,6 +407,16 @@ public:
      */
     virtual void resizeImage(ImageMat& srcImg, ImageMat& dstImg, const double& scale);
 
+    /**
+     * @brief Downsamples an image to a grayscale thumbnail, averaging the pixels of each area.
+     *
+     * @param srcImg Input image (BGR, BGRA or grayscale).
+     * @param dstImg Output image (grayscale).
+     * @param width Width of the thumbnail.
+     * @param height Height of the thumbnail.
+     */
+    virtual void thumbnailImage(ImageMat& srcImg, ImageMat& dstImg, const int width, const int height);
+
     /**
      * @brief Gets the width of an image.
      *
@@ -277,9 +435,50 @@ public:
      */
     [[nodiscard]] virtual int getImageHeight(ImageMat& image) const;
 
+    /**
+     * @brief Gets the size of the pixel data of an image.
+     *
+     * @param image Image.
+     *
+     * @return Size of the pixel data, in bytes.
+     */
+    [[nodiscard]] virtual std::size_t getImageSizeBytes(ImageMat& image) const;
+
+    /**
+     * @brief Hashes the pixels of an image, with its dimensions and type (see @ref common::ContentHash).
+     *
+     * The rows are hashed without their padding, so an image and its continuous copy have the same hash.
+     *
+     * @param image Image.
+     *
+     * @return Hash of the image.
+     */
+    [[nodiscard]] virtual std::uint64_t hashImage(ImageMat& image) const;
+
+    /**
+     * @brief Gets the type of the pixels of an image (depth and number of channels).
+     *
+     * @param image Image.
+     *
+     * @return Type of the pixels.
+     */
+    [[nodiscard]] virtual int getImageType(ImageMat& image) const;
+
+    /**
+     * @brief Gets the pixels of a row of an image, without its padding.
+     *
+     * @param image Image.
+     * @param row Index of the row.
+     *
+     * @return Pixels of the row, with the width of the image times the size of each pixel.
+     */
+    [[nodiscard]] virtual const unsigned char* getImageRow(ImageMat& image, const int row) const;
+
     /**
      * @brief Converts an image to grayscale.
      *
+     * An image already in grayscale is only referenced by the output image, without copying it.
+     *
      * @param srcImg Input image.
      * @param dstImg Output image.
      */
@@ -477,6 +676,9 @@ public:
      * @param dstImg Destination image of the same size and the same type as source image.
      * @param thinningAlg Thinning algorithm to be used.
      *
+     * The thinning stops early, with the image thinned partially, when the current cancellation token of the thread is
+     * stopped (see common::CancellationToken).
+     *
      * @see Thinning method implemented in OpenCV ximgproc module (opencv_contrib), in the following link:
      * https://github.com/opencv/opencv_contrib/blob/4.x/modules/ximgproc/src/thinning.cpp
      */
@@ -0,0 +1,113 @@
+/**
+ * @file
+ */
+
+#include "BinaryImage.h"
+#include <algorithm>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+BinaryImage::BinaryImage(const int width, const int height)
+{
+    reset(width, height);
+}
+
+void BinaryImage::reset(const int width, const int height)
+{
+    mWidth = width > 0 && height > 0 ? width : 0;
+    mHeight = width > 0 && height > 0 ? height : 0;
+    mRowSize = (static_cast<std::size_t>(mWidth) + 7) / 8;
+    mBits.assign(mRowSize * static_cast<std::size_t>(mHeight), 0);
+}
+
+void BinaryImage::setRow(const int row, const unsigned char* pixels)
+{
+    if (row < 0 || row >= mHeight) {
+        return;
+    }
+
+    auto* bits{mBits.data() + static_cast<std::size_t>(row) * mRowSize};
+    for (std::size_t byte{0}; byte < mRowSize; ++byte) {
+        unsigned char packed{0};
+        const auto first{byte * 8};
+        for (std::size_t bit{0}; bit < 8 && first + bit < static_cast<std::size_t>(mWidth); ++bit) {
+            if (pixels[first + bit] != 0) {
+                packed |= static_cast<unsigned char>(0x80U >> bit);
+            }
+        }
+        bits[byte] = packed;
+    }
+}
+
+void BinaryImage::getRow(const int row, unsigned char* pixels, const unsigned char foreground) const
+{
+    if (row < 0 || row >= mHeight) {
+        return;
+    }
+
+    const auto background{static_cast<unsigned char>(255 - foreground)};
+    const auto* bits{mBits.data() + static_cast<std::size_t>(row) * mRowSize};
+    for (std::size_t column{0}; column < static_cast<std::size_t>(mWidth); ++column) {
+        pixels[column] = (bits[column / 8] & (0x80U >> (column % 8))) != 0 ? foreground : background;
+    }
+}
+
+void BinaryImage::setPackedRows(const unsigned char* bits, const std::size_t stride)
+{
+    if (bits == nullptr || stride < mRowSize) {
+        return;
+    }
+
+    for (std::size_t row{0}; row < static_cast<std::size_t>(mHeight); ++row) {
+        std::copy_n(bits + row * stride, mRowSize, mBits.data() + row * mRowSize);
+    }
+}
+
+bool BinaryImage::getPixel(const int column, const int row) const
+{
+    if (column < 0 || column >= mWidth || row < 0 || row >= mHeight) {
+        return false;
+    }
+
+    const auto byte{mBits[static_cast<std::size_t>(row) * mRowSize + static_cast<std::size_t>(column) / 8]};
+
+    return (byte & (0x80U >> (column % 8))) != 0;
+}
+
+computerVision::ImageMat BinaryImage::unpack(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                             const unsigned char foreground) const
+{
+    if (mBits.empty()) {
+        return computerVision::ImageMat{};
+    }
+
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(mWidth) * static_cast<std::size_t>(mHeight));
+    for (int row{0}; row < mHeight; ++row) {
+        getRow(row, pixels.data() + static_cast<std::size_t>(row) * static_cast<std::size_t>(mWidth), foreground);
+    }
+
+    return openCvWrapper->copyImageBuffer(pixels.data(),
+                                          mWidth,
+                                          mHeight,
+                                          static_cast<std::size_t>(mWidth),
+                                          computerVision::OpenCvWrapper::cImageTypeGray);
+}
+
+int BinaryImage::getWidth() const
+{
+    return mWidth;
+}
+
+int BinaryImage::getHeight() const
+{
+    return mHeight;
+}
+
+std::size_t BinaryImage::getSizeBytes() const
+{
+    return mBits.size();
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
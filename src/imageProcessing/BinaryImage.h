@@ -0,0 +1,132 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "computerVision/OpenCvWrapper.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Binary image packed as a bitmap (a bit for each pixel, set for the foreground), e.g. the skeleton of an image
+ * preprocessed band by band (see @ref ImagePreprocessing::preprocessImageBands).
+ *
+ * The rows are padded to whole bytes, with the first pixel of each byte in its most significant bit (as in PBM).
+ */
+class BinaryImage
+{
+public:
+    /**
+     * @brief Constructor, of an empty image.
+     */
+    BinaryImage() = default;
+
+    /**
+     * @brief Constructor, with all the pixels in the background.
+     *
+     * @param width Width of the image, in pixels.
+     * @param height Height of the image, in pixels.
+     */
+    explicit BinaryImage(const int width, const int height);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~BinaryImage() = default;
+
+    /**
+     * @brief Resets the image to new dimensions, with all the pixels in the background.
+     *
+     * @param width Width of the image, in pixels.
+     * @param height Height of the image, in pixels.
+     */
+    virtual void reset(const int width, const int height);
+
+    /**
+     * @brief Sets a row of the image from 8-bit pixels (the foreground is not zero).
+     *
+     * @param row Index of the row.
+     * @param pixels Pixels of the row, with the width of the image.
+     */
+    virtual void setRow(const int row, const unsigned char* pixels);
+
+    /**
+     * @brief Gets a row of the image as 8-bit pixels.
+     *
+     * @param row Index of the row.
+     * @param pixels Pixels of the row, with the width of the image.
+     * @param foreground Value of the foreground pixels (the background is its inverse).
+     */
+    virtual void getRow(const int row, unsigned char* pixels, const unsigned char foreground = 255) const;
+
+    /**
+     * @brief Checks if a pixel is in the foreground.
+     *
+     * @param column Column of the pixel.
+     * @param row Row of the pixel.
+     *
+     * @return True if the pixel is in the foreground, otherwise false.
+     */
+    [[nodiscard]] virtual bool getPixel(const int column, const int row) const;
+
+    /**
+     * @brief Sets all the rows of the image from packed pixels, in the layout of the image (e.g. the pixels of a PBM
+     * file, whose black pixels are the foreground).
+     *
+     * @param bits Packed pixels, row by row.
+     * @param stride Size of each row of the packed pixels, in bytes (at least the size of a packed row).
+     */
+    virtual void setPackedRows(const unsigned char* bits, const std::size_t stride);
+
+    /**
+     * @brief Unpacks the image to an 8-bit grayscale image.
+     *
+     * @param openCvWrapper OpenCV wrapper.
+     * @param foreground Value of the foreground pixels (the background is its inverse), e.g. 255 for the skeleton of
+     * the preprocessing, or 0 for black lines on a white background.
+     *
+     * @return Image, or an empty matrix if the image is empty.
+     */
+    [[nodiscard]] virtual computerVision::ImageMat
+        unpack(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+               const unsigned char foreground = 255) const;
+
+    /**
+     * @brief Gets the width of the image.
+     *
+     * @return Width, in pixels.
+     */
+    [[nodiscard]] virtual int getWidth() const;
+
+    /**
+     * @brief Gets the height of the image.
+     *
+     * @return Height, in pixels.
+     */
+    [[nodiscard]] virtual int getHeight() const;
+
+    /**
+     * @brief Gets the size of the packed pixels.
+     *
+     * @return Size, in bytes.
+     */
+    [[nodiscard]] virtual std::size_t getSizeBytes() const;
+
+private:
+    /** Width of the image. */
+    int mWidth{0};
+    /** Height of the image. */
+    int mHeight{0};
+    /** Size of each packed row, in bytes. */
+    std::size_t mRowSize{0};
+    /** Packed pixels, row by row. */
+    std::vector<unsigned char> mBits{};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,538 @@
+/**
+ * @file
+ */
+
+#include "ImageHeader.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <streambuf>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+namespace {
+
+/**
+ * @brief Stream buffer reading a buffer in memory, without copying it.
+ */
+class MemoryStreamBuffer : public std::streambuf
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param buffer Buffer, which must be valid while the stream buffer is used.
+     */
+    explicit MemoryStreamBuffer(const std::vector<unsigned char>& buffer)
+    {
+        // The get area is only read
+        auto* data{reinterpret_cast<char*>(const_cast<unsigned char*>(buffer.data()))};
+        setg(data, data, data + buffer.size());
+    }
+
+protected:
+    /**
+     * @brief Sets the position of the get area, relatively.
+     *
+     * @param offset Offset.
+     * @param direction Origin of the offset.
+     * @param which Sequences (only the input is supported).
+     *
+     * @return New position, or an invalid position if it is outside the buffer.
+     */
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+    {
+        if ((which & std::ios_base::in) == 0) {
+            return pos_type(off_type(-1));
+        }
+
+        auto* origin{egptr()};
+        if (direction == std::ios_base::beg) {
+            origin = eback();
+        } else if (direction == std::ios_base::cur) {
+            origin = gptr();
+        }
+        const auto position{(origin - eback()) + offset};
+        if (position < 0 || position > egptr() - eback()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + position, egptr());
+
+        return pos_type(position);
+    }
+
+    /**
+     * @brief Sets the position of the get area, absolutely.
+     *
+     * @param position Position.
+     * @param which Sequences (only the input is supported).
+     *
+     * @return New position, or an invalid position if it is outside the buffer.
+     */
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(position), std::ios_base::beg, which);
+    }
+};
+
+/** Tag of the width of a TIFF page. */
+constexpr std::uint32_t cTiffTagImageWidth{256};
+/** Tag of the height of a TIFF page. */
+constexpr std::uint32_t cTiffTagImageLength{257};
+/** Tag of the bits per sample (depth of each channel) of a TIFF page. */
+constexpr std::uint32_t cTiffTagBitsPerSample{258};
+/** Tag of the samples per pixel (channels) of a TIFF page. */
+constexpr std::uint32_t cTiffTagSamplesPerPixel{277};
+/** Type of the 16 bits values of a TIFF directory entry (SHORT). */
+constexpr std::uint32_t cTiffTypeShort{3};
+/** Size of a TIFF directory entry, in bytes. */
+constexpr std::size_t cTiffEntrySize{12};
+
+/**
+ * @brief Gets a big-endian unsigned integer.
+ *
+ * @param bytes Bytes of the integer.
+ * @param size Number of bytes.
+ *
+ * @return Integer.
+ */
+std::uint32_t getBigEndian(const unsigned char* bytes, const std::size_t size)
+{
+    std::uint32_t value{0};
+    for (std::size_t i{0}; i < size; i++) {
+        value = (value << 8) | bytes[i];
+    }
+
+    return value;
+}
+
+/**
+ * @brief Gets a little-endian unsigned integer.
+ *
+ * @param bytes Bytes of the integer.
+ * @param size Number of bytes.
+ *
+ * @return Integer.
+ */
+std::uint32_t getLittleEndian(const unsigned char* bytes, const std::size_t size)
+{
+    std::uint32_t value{0};
+    for (std::size_t i{size}; i > 0; i--) {
+        value = (value << 8) | bytes[i - 1];
+    }
+
+    return value;
+}
+
+} // namespace
+
+bool ImageHeader::readDimensions(std::istream& stream, ImageDimensions& dimensions)
+{
+    ImageInfo info{};
+    if (!readInfo(stream, info)) {
+        return false;
+    }
+    dimensions = info.mDimensions;
+
+    return true;
+}
+
+bool ImageHeader::readFileDimensions(const std::string& filePath, ImageDimensions& dimensions)
+{
+    ImageInfo info{};
+    if (!readFileInfo(filePath, info)) {
+        return false;
+    }
+    dimensions = info.mDimensions;
+
+    return true;
+}
+
+bool ImageHeader::readBufferDimensions(const std::vector<unsigned char>& buffer, ImageDimensions& dimensions)
+{
+    ImageInfo info{};
+    if (!readBufferInfo(buffer, info)) {
+        return false;
+    }
+    dimensions = info.mDimensions;
+
+    return true;
+}
+
+bool ImageHeader::readInfo(std::istream& stream, ImageInfo& info)
+{
+    std::array<unsigned char, 2> signature{};
+    if (!readBytes(stream, signature.data(), signature.size())) {
+        return false;
+    }
+
+    // The information is only set when read
+    ImageInfo imageInfo{};
+    auto read{false};
+    if (signature[0] == 0x89 && signature[1] == 'P') {
+        read = readPngInfo(stream, imageInfo);
+    } else if (signature[0] == 0xFF && signature[1] == 0xD8) {
+        read = readJpegInfo(stream, imageInfo);
+    } else if (signature[0] == 'B' && signature[1] == 'M') {
+        read = readBmpInfo(stream, imageInfo);
+    } else if (signature[0] == 'P' && signature[1] >= '1' && signature[1] <= '6') {
+        read = readPnmInfo(stream, static_cast<char>(signature[1]), imageInfo);
+    } else if ((signature[0] == 'I' && signature[1] == 'I') || (signature[0] == 'M' && signature[1] == 'M')) {
+        // The offsets of a TIFF are relative to its start, so the stream must be seekable
+        const auto position{stream.tellg()};
+        read = position != std::streampos(-1)
+               && readTiffInfo(stream, position - std::streamoff(signature.size()), signature[0] == 'M', imageInfo);
+    }
+    if (!read) {
+        return false;
+    }
+    info = imageInfo;
+
+    return true;
+}
+
+bool ImageHeader::readFileInfo(const std::string& filePath, ImageInfo& info)
+{
+    std::ifstream file{filePath, std::ios::binary};
+    if (!file.is_open()) {
+        return false;
+    }
+
+    return readInfo(file, info);
+}
+
+bool ImageHeader::readBufferInfo(const std::vector<unsigned char>& buffer, ImageInfo& info)
+{
+    MemoryStreamBuffer streamBuffer{buffer};
+    std::istream stream{&streamBuffer};
+
+    return readInfo(stream, info);
+}
+
+bool ImageHeader::readPngInfo(std::istream& stream, ImageInfo& info)
+{
+    // Rest of the signature, length and type of the IHDR chunk, width and height
+    std::array<unsigned char, 22> header{};
+    if (!readBytes(stream, header.data(), header.size())) {
+        return false;
+    }
+
+    static constexpr std::array<unsigned char, 6> cSignature{'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+    static constexpr std::array<unsigned char, 4> cChunkType{'I', 'H', 'D', 'R'};
+    if (!std::equal(cSignature.begin(), cSignature.end(), header.begin())
+        || !std::equal(cChunkType.begin(), cChunkType.end(), header.begin() + 10)) {
+        return false;
+    }
+
+    if (!setDimensions(getBigEndian(&header[14], 4), getBigEndian(&header[18], 4), info.mDimensions)) {
+        return false;
+    }
+
+    // Bit depth and color type, if in the stream
+    std::array<unsigned char, 2> format{};
+    if (readBytes(stream, format.data(), format.size())) {
+        switch (format[1]) {
+        case 0: // Grayscale
+            info.mChannels = 1;
+            break;
+        case 2: // RGB
+            info.mChannels = 3;
+            break;
+        case 3: // Palette of RGB colors (8 bits per channel)
+            info.mChannels = 3;
+            info.mDepth = 8;
+            break;
+        case 4: // Grayscale and alpha
+            info.mChannels = 2;
+            break;
+        case 6: // RGB and alpha
+            info.mChannels = 4;
+            break;
+        default:
+            break;
+        }
+        if (info.mChannels > 0 && info.mDepth == 0) {
+            info.mDepth = format[0];
+        }
+    }
+
+    return true;
+}
+
+bool ImageHeader::readJpegInfo(std::istream& stream, ImageInfo& info)
+{
+    while (true) {
+        // Marker, after any fill bytes
+        auto byte{stream.get()};
+        if (byte != 0xFF) {
+            return false;
+        }
+        while (byte == 0xFF) {
+            byte = stream.get();
+        }
+        if (byte == std::istream::traits_type::eof()) {
+            return false;
+        }
+        const auto marker{static_cast<unsigned char>(byte)};
+
+        // Markers without segment: restart (RST0 to RST7) and temporary (TEM)
+        if ((marker >= 0xD0 && marker <= 0xD7) || marker == 0x01) {
+            continue;
+        }
+
+        // End of image or start of scan before the start of frame
+        if (marker == 0xD9 || marker == 0xDA) {
+            return false;
+        }
+
+        std::array<unsigned char, 2> length{};
+        if (!readBytes(stream, length.data(), length.size())) {
+            return false;
+        }
+        const auto segmentLength{getBigEndian(length.data(), length.size())};
+        if (segmentLength < length.size()) {
+            return false;
+        }
+
+        // Start of frame (SOF0 to SOF15, except DHT, JPG and DAC): precision, height and width
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+            std::array<unsigned char, 5> frame{};
+            if (!readBytes(stream, frame.data(), frame.size())) {
+                return false;
+            }
+
+            if (!setDimensions(getBigEndian(&frame[3], 2), getBigEndian(&frame[1], 2), info.mDimensions)) {
+                return false;
+            }
+
+            // Number of components, if in the stream
+            const auto components{stream.get()};
+            if (components != std::istream::traits_type::eof()) {
+                info.mChannels = components;
+                info.mDepth = frame[0];
+            }
+
+            return true;
+        }
+
+        // Skip the segment
+        stream.ignore(segmentLength - length.size());
+        if (!stream) {
+            return false;
+        }
+    }
+}
+
+bool ImageHeader::readBmpInfo(std::istream& stream, ImageInfo& info)
+{
+    // File size, reserved, offset of the pixels, size of the DIB header, width and height
+    std::array<unsigned char, 20> header{};
+    if (!readBytes(stream, header.data(), header.size())) {
+        return false;
+    }
+
+    // Core header (OS/2): 16 bits unsigned width and height
+    const auto headerSize{getLittleEndian(&header[12], 4)};
+    if (headerSize == 12) {
+        if (!setDimensions(getLittleEndian(&header[16], 2), getLittleEndian(&header[18], 2), info.mDimensions)) {
+            return false;
+        }
+    } else {
+        // Other headers: 32 bits signed width and height (negative height for top-down pixels)
+        std::array<unsigned char, 4> height{};
+        if (!readBytes(stream, height.data(), height.size())) {
+            return false;
+        }
+        const auto width{static_cast<std::int32_t>(getLittleEndian(&header[16], 4))};
+        const auto signedHeight{static_cast<std::int32_t>(getLittleEndian(height.data(), height.size()))};
+        if (!setDimensions(width, std::llabs(signedHeight), info.mDimensions)) {
+            return false;
+        }
+    }
+
+    // Planes and bits per pixel, if in the stream (up to 8 bits, a palette of BGR colors)
+    std::array<unsigned char, 4> format{};
+    if (readBytes(stream, format.data(), format.size())) {
+        const auto bitsPerPixel{getLittleEndian(&format[2], 2)};
+        info.mChannels = bitsPerPixel == 32 ? 4 : 3;
+        info.mDepth = bitsPerPixel == 16 ? 5 : 8;
+    }
+
+    return true;
+}
+
+bool ImageHeader::readPnmInfo(std::istream& stream, const char type, ImageInfo& info)
+{
+    auto width{0};
+    auto height{0};
+    if (!readPnmValue(stream, width) || !readPnmValue(stream, height)
+        || !setDimensions(width, height, info.mDimensions)) {
+        return false;
+    }
+
+    // PBM: a bit for each pixel, without maximum value
+    if (type == '1' || type == '4') {
+        info.mChannels = 1;
+        info.mDepth = 1;
+
+        return true;
+    }
+
+    // PGM or PPM: maximum value, if in the stream
+    auto maxValue{0};
+    if (readPnmValue(stream, maxValue) && maxValue > 0) {
+        info.mChannels = type == '2' || type == '5' ? 1 : 3;
+        info.mDepth = maxValue < 256 ? 8 : 16;
+    }
+
+    return true;
+}
+
+bool ImageHeader::readTiffInfo(std::istream& stream,
+                               const std::streampos start,
+                               const bool bigEndian,
+                               ImageInfo& info)
+{
+    const auto getValue{[bigEndian](const unsigned char* bytes, const std::size_t size) {
+        return bigEndian ? getBigEndian(bytes, size) : getLittleEndian(bytes, size);
+    }};
+
+    // Magic number (BigTIFF is not supported) and offset of the first directory
+    std::array<unsigned char, 6> header{};
+    if (!readBytes(stream, header.data(), header.size()) || getValue(header.data(), 2) != 42) {
+        return false;
+    }
+
+    // Defaults of a page without the tags: bilevel
+    long long width{0};
+    long long height{0};
+    auto channels{1};
+    auto depth{1};
+    std::uint32_t depthOffset{0};
+
+    // Directories, one per page, linked by their offsets
+    std::size_t numPages{0};
+    auto offset{getValue(&header[2], 4)};
+    while (offset != 0 && numPages < cMaxTiffPages) {
+        stream.clear();
+        stream.seekg(start + std::streamoff(offset));
+        std::array<unsigned char, 2> numEntries{};
+        if (!stream || !readBytes(stream, numEntries.data(), numEntries.size())) {
+            break;
+        }
+        const auto entriesSize{static_cast<std::streamoff>(getValue(numEntries.data(), numEntries.size()))
+                               * static_cast<std::streamoff>(cTiffEntrySize)};
+
+        // Only the tags of the first page are read, the others are skipped
+        if (numPages == 0) {
+            std::vector<unsigned char> entries(static_cast<std::size_t>(entriesSize));
+            if (!readBytes(stream, entries.data(), entries.size())) {
+                break;
+            }
+            for (std::size_t i{0}; i < entries.size(); i += cTiffEntrySize) {
+                const auto* entry{&entries[i]};
+                const auto tag{getValue(entry, 2)};
+                const auto type{getValue(entry + 2, 2)};
+                const auto count{getValue(entry + 4, 4)};
+                // SHORT or LONG value, in the entry
+                const auto value{type == cTiffTypeShort ? getValue(entry + 8, 2) : getValue(entry + 8, 4)};
+
+                if (tag == cTiffTagImageWidth) {
+                    width = value;
+                } else if (tag == cTiffTagImageLength) {
+                    height = value;
+                } else if (tag == cTiffTagSamplesPerPixel) {
+                    channels = static_cast<int>(value);
+                } else if (tag == cTiffTagBitsPerSample) {
+                    // A value per channel, out of the entry when they do not fit in it (the same for all channels)
+                    if (count > 2) {
+                        depthOffset = getValue(entry + 8, 4);
+                    } else {
+                        depth = static_cast<int>(value);
+                    }
+                }
+            }
+        } else {
+            stream.seekg(entriesSize, std::ios::cur);
+        }
+
+        std::array<unsigned char, 4> nextOffset{};
+        if (!stream || !readBytes(stream, nextOffset.data(), nextOffset.size())) {
+            break;
+        }
+        numPages++;
+        offset = getValue(nextOffset.data(), nextOffset.size());
+    }
+
+    if (numPages == 0 || !setDimensions(width, height, info.mDimensions)) {
+        return false;
+    }
+
+    if (depthOffset != 0) {
+        std::array<unsigned char, 2> bitsPerSample{};
+        stream.clear();
+        stream.seekg(start + std::streamoff(depthOffset));
+        depth = stream && readBytes(stream, bitsPerSample.data(), bitsPerSample.size())
+                    ? static_cast<int>(getValue(bitsPerSample.data(), bitsPerSample.size()))
+                    : 0;
+    }
+    info.mChannels = channels;
+    info.mDepth = depth;
+    info.mNumPages = numPages;
+
+    return true;
+}
+
+bool ImageHeader::readPnmValue(std::istream& stream, int& value)
+{
+    // Whitespace and comments, until the end of line
+    auto byte{stream.get()};
+    while (byte == '#' || std::isspace(byte)) {
+        if (byte == '#') {
+            stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        byte = stream.get();
+    }
+    if (!std::isdigit(byte)) {
+        return false;
+    }
+
+    long long number{0};
+    while (std::isdigit(byte)) {
+        number = number * 10 + (byte - '0');
+        if (number > cMaxDimension) {
+            return false;
+        }
+        byte = stream.get();
+    }
+    value = static_cast<int>(number);
+
+    return true;
+}
+
+bool ImageHeader::readBytes(std::istream& stream, unsigned char* bytes, const std::size_t size)
+{
+    stream.read(reinterpret_cast<char*>(bytes), static_cast<std::streamsize>(size));
+
+    return stream.gcount() == static_cast<std::streamsize>(size);
+}
+
+bool ImageHeader::setDimensions(const long long width, const long long height, ImageDimensions& dimensions)
+{
+    if (width <= 0 || height <= 0 || width > cMaxDimension || height > cMaxDimension) {
+        return false;
+    }
+
+    dimensions.mWidth = static_cast<int>(width);
+    dimensions.mHeight = static_cast<int>(height);
+
+    return true;
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,215 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Dimensions of an image.
+ */
+struct ImageDimensions
+{
+    /** Width of the image, in pixels. */
+    int mWidth{0};
+    /** Height of the image, in pixels. */
+    int mHeight{0};
+};
+
+/**
+ * @brief Information of an encoded image, read from its header.
+ */
+struct ImageInfo
+{
+    /** Dimensions of the image (of its first page). */
+    ImageDimensions mDimensions{};
+    /** Number of channels of the pixels (for an image with a palette, of its colors), or 0 if unknown. */
+    int mChannels{0};
+    /** Depth of each channel, in bits, or 0 if unknown. */
+    int mDepth{0};
+    /** Number of pages (e.g. the sheets of a TIFF file). */
+    std::size_t mNumPages{1};
+};
+
+/**
+ * @brief Reader of the header of encoded images, to get their dimensions without decoding them.
+ *
+ * Only the first bytes of the image are read (for JPEG, the markers until the start of frame, and for TIFF, the
+ * directories of its pages), so the dimensions are known before the pixels are allocated. The formats supported are
+ * PNG, JPEG, BMP, PNM (PBM, PGM and PPM) and TIFF.
+ *
+ * The channels and the depth are read when the header has them, otherwise they are unknown but the dimensions are
+ * still read.
+ */
+class ImageHeader
+{
+public:
+    /**
+     * @brief Reads the dimensions of the image encoded in a stream.
+     *
+     * @param stream Stream with the encoded image, at its start.
+     * @param dimensions Dimensions of the image.
+     *
+     * @return True if the dimensions were read, otherwise false when the format is not supported or the header is
+     * invalid.
+     */
+    static bool readDimensions(std::istream& stream, ImageDimensions& dimensions);
+
+    /**
+     * @brief Reads the dimensions of the image encoded in a file.
+     *
+     * @param filePath File path of the image.
+     * @param dimensions Dimensions of the image.
+     *
+     * @return True if the dimensions were read, otherwise false.
+     */
+    static bool readFileDimensions(const std::string& filePath, ImageDimensions& dimensions);
+
+    /**
+     * @brief Reads the dimensions of the image encoded in a buffer in memory, without copying it.
+     *
+     * @param buffer Buffer with the encoded image.
+     * @param dimensions Dimensions of the image.
+     *
+     * @return True if the dimensions were read, otherwise false.
+     */
+    static bool readBufferDimensions(const std::vector<unsigned char>& buffer, ImageDimensions& dimensions);
+
+    /**
+     * @brief Reads the information of the image encoded in a stream.
+     *
+     * @param stream Stream with the encoded image, at its start.
+     * @param info Information of the image.
+     *
+     * @return True if at least the dimensions were read, otherwise false when the format is not supported or the
+     * header is invalid.
+     */
+    static bool readInfo(std::istream& stream, ImageInfo& info);
+
+    /**
+     * @brief Reads the information of the image encoded in a file.
+     *
+     * @param filePath File path of the image.
+     * @param info Information of the image.
+     *
+     * @return True if at least the dimensions were read, otherwise false.
+     */
+    static bool readFileInfo(const std::string& filePath, ImageInfo& info);
+
+    /**
+     * @brief Reads the information of the image encoded in a buffer in memory, without copying it.
+     *
+     * @param buffer Buffer with the encoded image.
+     * @param info Information of the image.
+     *
+     * @return True if at least the dimensions were read, otherwise false.
+     */
+    static bool readBufferInfo(const std::vector<unsigned char>& buffer, ImageInfo& info);
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Reads the information from a PNG header (IHDR chunk), after the signature.
+     *
+     * @param stream Stream, after the first two bytes of the signature.
+     * @param info Information of the image.
+     *
+     * @return True if the dimensions were read, otherwise false.
+     */
+    static bool readPngInfo(std::istream& stream, ImageInfo& info);
+
+    /**
+     * @brief Reads the information from the start of frame of a JPEG, skipping the other segments.
+     *
+     * @param stream Stream, after the start of image marker.
+     * @param info Information of the image.
+     *
+     * @return True if the dimensions were read, otherwise false.
+     */
+    static bool readJpegInfo(std::istream& stream, ImageInfo& info);
+
+    /**
+     * @brief Reads the information from a BMP header (DIB header).
+     *
+     * @param stream Stream, after the signature.
+     * @param info Information of the image.
+     *
+     * @return True if the dimensions were read, otherwise false.
+     */
+    static bool readBmpInfo(std::istream& stream, ImageInfo& info);
+
+    /**
+     * @brief Reads the information from a PNM header (width, height and maximum value in ASCII, with comments).
+     *
+     * @param stream Stream, after the magic number.
+     * @param type Type of the PNM image ('1' to '6').
+     * @param info Information of the image.
+     *
+     * @return True if the dimensions were read, otherwise false.
+     */
+    static bool readPnmInfo(std::istream& stream, const char type, ImageInfo& info);
+
+    /**
+     * @brief Reads the information from the directories (IFD) of a TIFF, counting its pages.
+     *
+     * @param stream Stream, after the byte order.
+     * @param start Position of the start of the TIFF in the stream (the offsets are relative to it).
+     * @param bigEndian Flag of a big-endian TIFF ("MM"), otherwise little-endian ("II").
+     * @param info Information of the image.
+     *
+     * @return True if the dimensions were read from the first directory, otherwise false.
+     */
+    static bool readTiffInfo(std::istream& stream,
+                             const std::streampos start,
+                             const bool bigEndian,
+                             ImageInfo& info);
+
+    /**
+     * @brief Reads an unsigned integer of a PNM header, skipping the whitespace and comments before it.
+     *
+     * @param stream Stream.
+     * @param value Value read.
+     *
+     * @return True if the value was read, otherwise false.
+     */
+    static bool readPnmValue(std::istream& stream, int& value);
+
+    /**
+     * @brief Reads bytes of the stream.
+     *
+     * @param stream Stream.
+     * @param bytes Bytes read.
+     * @param size Number of bytes to read.
+     *
+     * @return True if all the bytes were read, otherwise false.
+     */
+    static bool readBytes(std::istream& stream, unsigned char* bytes, const std::size_t size);
+
+    /**
+     * @brief Checks and sets the dimensions read.
+     *
+     * @param width Width read.
+     * @param height Height read.
+     * @param dimensions Dimensions of the image.
+     *
+     * @return True if the dimensions are valid (positive and within the limits of an image), otherwise false.
+     */
+    static bool setDimensions(const long long width, const long long height, ImageDimensions& dimensions);
+
+private:
+    /** Maximum width and height of an image, in pixels. */
+    static constexpr long long cMaxDimension{1 << 30};
+    /** Maximum number of pages counted in a TIFF (it also stops a loop of directories). */
+    static constexpr std::size_t cMaxTiffPages{1 << 16};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -4,14 +4,18 @@
 
 #include "ImagePreprocessing.h"
 #include "application/Config.h"
+#include "common/CancellationToken.h"
+#include <algorithm>
 
 namespace circuitSegmentation {
 namespace imageProcessing {
 
 ImagePreprocessing::ImagePreprocessing(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                       const std::shared_ptr<output::ImageWriter>& imageWriter,
                                        const std::shared_ptr<logging::Logger>& logger,
                                        const bool saveImages)
     : mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
     , mLogger{logger}
     , mSaveImages{std::move(saveImages)}
 {
@@ -30,6 +34,64 @@ void ImagePreprocessing::preprocessImage(computerVision::ImageMat& image)
     // Apply threshold
     thresholdImage(image);
 
+    // Apply morphological opening
+    if (mParameters.mMorphOpen) {
+        morphologicalOpenImage(image);
+    }
+
+    // Apply morphological dilation
+    morphologicalDilateImage(image);
+
+    // Apply thinning operation
+    thinningImage(image);
+}
+
+void ImagePreprocessing::preprocessImageBands(computerVision::ImageMat& image,
+                                              BinaryImage& imageBinary,
+                                              const int bandHeight)
+{
+    const auto width{mOpenCvWrapper->getImageWidth(image)};
+    const auto height{mOpenCvWrapper->getImageHeight(image)};
+    const auto rows{std::max(bandHeight, 1)};
+
+    mLogger->logInfo("Starting image preprocessing by bands of {} rows", rows);
+
+    imageBinary.reset(width, height);
+
+    for (auto start{0}; start < height && !common::CancellationToken::isCurrentStopped(); start += rows) {
+        const auto end{std::min(start + rows, height)};
+        const auto contextStart{std::max(start - cBandOverlap, 0)};
+        const auto contextEnd{std::min(end + cBandOverlap, height)};
+
+        // Band with its context, copied from a view of the image
+        computerVision::ImageMat view{};
+        if (!mOpenCvWrapper->cropImageView(
+                image, view, computerVision::Rectangle{0, contextStart, width, contextEnd - contextStart})) {
+            mLogger->logError("Failed to get band of rows from {} to {}", contextStart, contextEnd);
+            return;
+        }
+        auto band{mOpenCvWrapper->cloneImage(view)};
+
+        preprocessBand(band);
+
+        // Only the rows of the band, without the context
+        for (auto row{start}; row < end; ++row) {
+            imageBinary.setRow(row, mOpenCvWrapper->getImageRow(band, row - contextStart));
+        }
+    }
+
+    mLogger->logInfo("Image preprocessed by bands: {} bytes of skeleton", imageBinary.getSizeBytes());
+}
+
+void ImagePreprocessing::preprocessBinaryImage(computerVision::ImageMat& image)
+{
+    mLogger->logInfo("Starting binary image preprocessing");
+
+    // Apply morphological opening
+    if (mParameters.mMorphOpen) {
+        morphologicalOpenImage(image);
+    }
+
     // Apply morphological dilation
     morphologicalDilateImage(image);
 
@@ -47,6 +109,53 @@ bool ImagePreprocessing::getSaveImages() const
     return mSaveImages;
 }
 
+void ImagePreprocessing::setPreset(const common::Preset& preset)
+{
+    mPreset = preset;
+    mParameters = getParameters(preset);
+}
+
+common::Preset ImagePreprocessing::getPreset() const
+{
+    return mPreset;
+}
+
+ImagePreprocessing::Parameters ImagePreprocessing::getParameters(const common::Preset& preset)
+{
+    switch (preset) {
+    case common::Preset::FAST:
+        // Smaller blur kernel and thresholding block, and mean thresholding (cheaper than the Gaussian weighted sum)
+        return Parameters{
+            .mFilterKernelSize = 5,
+            .mThresholdMethod = computerVision::OpenCvWrapper::AdaptiveThresholdAlgorithm::ADAPTIVE_THRESH_MEAN,
+            .mThresholdBlockSize = 15,
+            .mThresholdSubConst = 4,
+            .mMorphOpen = false};
+    case common::Preset::ACCURATE:
+        // Larger thresholding block (less sensitive to noise) and removal of the small blobs left by the threshold
+        return Parameters{
+            .mFilterKernelSize = 9,
+            .mThresholdMethod = computerVision::OpenCvWrapper::AdaptiveThresholdAlgorithm::ADAPTIVE_THRESH_GAUSSIAN,
+            .mThresholdBlockSize = 25,
+            .mThresholdSubConst = 4,
+            .mMorphOpen = true};
+    case common::Preset::BALANCED:
+        break;
+    }
+
+    return Parameters{
+        .mFilterKernelSize = 9,
+        .mThresholdMethod = computerVision::OpenCvWrapper::AdaptiveThresholdAlgorithm::ADAPTIVE_THRESH_GAUSSIAN,
+        .mThresholdBlockSize = 21,
+        .mThresholdSubConst = 4,
+        .mMorphOpen = false};
+}
+
+void ImagePreprocessing::setParameters(const Parameters& parameters)
+{
+    mParameters = parameters;
+}
+
 void ImagePreprocessing::resizeImage(computerVision::ImageMat& image)
 {
     /*
@@ -60,8 +169,7 @@ void ImagePreprocessing::resizeImage(computerVision::ImageMat& image)
     // Image height
     const auto heightImg = mOpenCvWrapper->getImageHeight(image);
 
-    mLogger->logInfo("Initial image size: width = " + std::to_string(widthImg)
-                     + ", height = " + std::to_string(heightImg));
+    mLogger->logInfo("Initial image size: width = {}, height = {}", widthImg, heightImg);
 
     // Resize scaling factor to be used for width and height
     double resizeScale{1};
@@ -81,9 +189,10 @@ void ImagePreprocessing::resizeImage(computerVision::ImageMat& image)
     if (doResize) {
         mOpenCvWrapper->resizeImage(image, image, resizeScale);
 
-        mLogger->logInfo("Resize scale = " + std::to_string(resizeScale));
-        mLogger->logInfo("Image resized: width = " + std::to_string(mOpenCvWrapper->getImageWidth(image))
-                         + ", height = " + std::to_string(mOpenCvWrapper->getImageHeight(image)));
+        mLogger->logInfo("Resize scale = {}", resizeScale);
+        mLogger->logInfo("Image resized: width = {}, height = {}",
+                         mOpenCvWrapper->getImageWidth(image),
+                         mOpenCvWrapper->getImageHeight(image));
     }
 }
 
@@ -100,7 +209,8 @@ void ImagePreprocessing::convertImageToGray(computerVision::ImageMat& image)
 
     // Save image
     if (mSaveImages) {
-        mOpenCvWrapper->writeImage("cs_preproc_grayscale.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_preproc_grayscale.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Converted image to grayscale", image, 0);
 #endif
@@ -114,13 +224,14 @@ void ImagePreprocessing::blurImage(computerVision::ImageMat& image)
      * - Reduce noise
      * - Improve edge detection
      */
-    mOpenCvWrapper->gaussianBlurImage(image, image, cFilterKernelSize);
+    mOpenCvWrapper->gaussianBlurImage(image, image, mParameters.mFilterKernelSize);
 
     mLogger->logInfo("Gaussian blurring applied to the image");
 
     // Save image
     if (mSaveImages) {
-        mOpenCvWrapper->writeImage("cs_preproc_blur.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_preproc_blur.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Blurred image", image, 0);
 #endif
@@ -138,14 +249,20 @@ void ImagePreprocessing::thresholdImage(computerVision::ImageMat& image)
      *      - There may be dramatic ranges of pixel intensities and the optimal value of T may change for different
      * parts of the image
      */
-    mOpenCvWrapper->adaptiveThresholdImage(
-        image, image, cThresholdMaxValue, cThresholdMethod, cThresholdOp, cThresholdBlockSize, cThresholdSubConst);
+    mOpenCvWrapper->adaptiveThresholdImage(image,
+                                           image,
+                                           cThresholdMaxValue,
+                                           mParameters.mThresholdMethod,
+                                           cThresholdOp,
+                                           mParameters.mThresholdBlockSize,
+                                           mParameters.mThresholdSubConst);
 
     mLogger->logInfo("Adaptive threshold applied to the image");
 
     // Save image
     if (mSaveImages) {
-        mOpenCvWrapper->writeImage("cs_preproc_threshold.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_preproc_threshold.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Thresholding image", image, 0);
 #endif
@@ -172,7 +289,8 @@ void ImagePreprocessing::morphologicalOpenImage(computerVision::ImageMat& image)
 
     // Save image
     if (mSaveImages) {
-        mOpenCvWrapper->writeImage("cs_preproc_morph_open.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_preproc_morph_open.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Morphological opening image", image, 0);
 #endif
@@ -199,7 +317,7 @@ void ImagePreprocessing::morphologicalDilateImage(computerVision::ImageMat& imag
 
     // Save image
     if (mSaveImages) {
-        mOpenCvWrapper->writeImage("cs_preproc_morph_dilation.png", image);
+        mImageWriter->writeImage("cs_preproc_morph_dilation.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Morphological dilation image", image, 0);
 #endif
@@ -221,13 +339,37 @@ void ImagePreprocessing::thinningImage(computerVision::ImageMat& image)
 
     // Save image
     if (mSaveImages) {
-        mOpenCvWrapper->writeImage("cs_preproc_thinning.png", image);
+        mImageWriter->writeImage("cs_preproc_thinning.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Thinning image", image, 0);
 #endif
     }
 }
 
+void ImagePreprocessing::preprocessBand(computerVision::ImageMat& band)
+{
+    mOpenCvWrapper->convertImageToGray(band, band);
+    mOpenCvWrapper->gaussianBlurImage(band, band, mParameters.mFilterKernelSize);
+    mOpenCvWrapper->adaptiveThresholdImage(band,
+                                           band,
+                                           cThresholdMaxValue,
+                                           mParameters.mThresholdMethod,
+                                           cThresholdOp,
+                                           mParameters.mThresholdBlockSize,
+                                           mParameters.mThresholdSubConst);
+    if (mParameters.mMorphOpen) {
+        const auto kernelOpen = mOpenCvWrapper->getStructuringElement(
+            computerVision::OpenCvWrapper::MorphShapes::MORPH_RECT, cMorphOpenKernelSize);
+        mOpenCvWrapper->morphologyEx(
+            band, band, computerVision::OpenCvWrapper::MorphTypes::MORPH_OPEN, kernelOpen, cMorphOpenIter);
+    }
+    const auto kernelDilate = mOpenCvWrapper->getStructuringElement(
+        computerVision::OpenCvWrapper::MorphShapes::MORPH_RECT, cMorphDilateKernelSize);
+    mOpenCvWrapper->morphologyEx(
+        band, band, computerVision::OpenCvWrapper::MorphTypes::MORPH_DILATE, kernelDilate, cMorphDilateIter);
+    mOpenCvWrapper->thinning(band, band, computerVision::OpenCvWrapper::ThinningAlgorithms::THINNING_ZHANGSUEN);
+}
+
 void ImagePreprocessing::edgesImage(computerVision::ImageMat& image)
 {
     // Detect edges using the Canny Edge Detector
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include "BinaryImage.h"
+#include "common/Preset.h"
 #include "computerVision/OpenCvWrapper.h"
 #include "logging/Logger.h"
+#include "output/ImageWriter.h"
 #include <memory>
 
 namespace circuitSegmentation {
@@ -19,15 +22,47 @@ class ImagePreprocessing
 public:
     /** Maximum dimension of the image (width or height). */
     static constexpr int cResizeDim{800};
+    /** Default height of the bands of an image preprocessed by bands, in rows. */
+    static constexpr int cBandHeightDefault{256};
+    /** Rows of context above and below each band (larger than the neighbourhoods of the blur, threshold and
+     * morphological operations, and the thickness of the lines thinned). */
+    static constexpr int cBandOverlap{32};
+
+    /**
+     * @brief Parameters of the preprocessing, set by the preset.
+     */
+    struct Parameters {
+        /** Size of the kernel for filter (must be odd and positive). */
+        unsigned int mFilterKernelSize;
+        /** Adaptive thresholding algorithm. */
+        computerVision::OpenCvWrapper::AdaptiveThresholdAlgorithm mThresholdMethod;
+        /** Block size for thresholding (must be odd and greater than 1). */
+        int mThresholdBlockSize;
+        /** Constant to subtract from the algorithm for thresholding. */
+        double mThresholdSubConst;
+        /** Apply a morphological opening before the dilation, to remove small blobs. */
+        bool mMorphOpen;
+    };
+
+    /**
+     * @brief Gets the parameters of a preset.
+     *
+     * @param preset Preset.
+     *
+     * @return Parameters of the preset.
+     */
+    [[nodiscard]] static Parameters getParameters(const common::Preset& preset);
 
     /**
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      * @param saveImages Save images obtained during the processing.
      */
     explicit ImagePreprocessing(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                const std::shared_ptr<output::ImageWriter>& imageWriter,
                                 const std::shared_ptr<logging::Logger>& logger,
                                 const bool saveImages = false);
 
@@ -43,6 +78,29 @@ public:
      */
     virtual void preprocessImage(computerVision::ImageMat& image);
 
+    /**
+     * @brief Preprocesses the image band by band, writing the skeleton to a binary image.
+     *
+     * Each band of rows is preprocessed as @ref preprocessImage with the rows of context above and below it, and only
+     * its own rows are packed into the binary image, so the memory of the preprocessing is a few bands instead of
+     * copies of the full image. The image is not changed, and the images of the preprocessing are not saved.
+     *
+     * @param image Image for preprocessing (only read).
+     * @param imageBinary Binary image with the skeleton, with the dimensions of the image.
+     * @param bandHeight Height of the bands, in rows.
+     */
+    virtual void preprocessImageBands(computerVision::ImageMat& image,
+                                      BinaryImage& imageBinary,
+                                      const int bandHeight = cBandHeightDefault);
+
+    /**
+     * @brief Preprocesses an image that is already binary (e.g. a PBM file), skipping the grayscale conversion, the
+     * blur and the threshold.
+     *
+     * @param image Binary image for preprocessing, with the foreground at 255 (see @ref BinaryImage::unpack).
+     */
+    virtual void preprocessBinaryImage(computerVision::ImageMat& image);
+
     /**
      * @brief Sets the flag to save images obtained during the processing.
      *
@@ -57,6 +115,28 @@ public:
      */
     [[nodiscard]] virtual bool getSaveImages() const;
 
+    /**
+     * @brief Sets the preset, which sets the parameters of the preprocessing.
+     *
+     * @param preset Preset.
+     */
+    virtual void setPreset(const common::Preset& preset);
+
+    /**
+     * @brief Gets the preset.
+     *
+     * @return The preset.
+     */
+    [[nodiscard]] virtual common::Preset getPreset() const;
+
+    /**
+     * @brief Sets the parameters of the preprocessing, which replace the parameters of the preset until the preset is
+     * set again (e.g. for a parameter sweep).
+     *
+     * @param parameters Parameters.
+     */
+    virtual void setParameters(const Parameters& parameters);
+
 #ifndef BUILD_TESTS
 private:
 #endif
@@ -116,22 +196,19 @@ private:
      */
     virtual void edgesImage(computerVision::ImageMat& image);
 
-private:
-    /** Size of the kernel for filter (must be odd and positive). */
-    const unsigned int cFilterKernelSize{9};
+    /**
+     * @brief Preprocesses a band of the image, as @ref preprocessImage but without logs and saved images.
+     *
+     * @param band Band of the image (a copy), preprocessed in place.
+     */
+    virtual void preprocessBand(computerVision::ImageMat& band);
 
+private:
     /** Maximum value for thresholding. */
     const double cThresholdMaxValue{255};
-    /** Adaptive thresholding algorithm. */
-    const computerVision::OpenCvWrapper::AdaptiveThresholdAlgorithm cThresholdMethod{
-        computerVision::OpenCvWrapper::AdaptiveThresholdAlgorithm::ADAPTIVE_THRESH_GAUSSIAN};
     /** Threshold operation type. */
     const computerVision::OpenCvWrapper::ThresholdOperations cThresholdOp{
         computerVision::OpenCvWrapper::ThresholdOperations::THRESH_BINARY_INV};
-    /** Block size for thresholding. */
-    const int cThresholdBlockSize{21};
-    /** Constant to subtract from the algorithm for thresholding. */
-    const double cThresholdSubConst{4};
 
     /** Size of the kernel for morphological opening. */
     const unsigned int cMorphOpenKernelSize{3};
@@ -153,11 +230,20 @@ private:
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
 
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
 
     /** Flag to save images obtained during the processing in the working directory. */
     bool mSaveImages{false};
+
+    /** Preset. */
+    common::Preset mPreset{common::Preset::BALANCED};
+
+    /** Parameters of the preset. */
+    Parameters mParameters{getParameters(common::Preset::BALANCED)};
 };
 
 } // namespace imageProcessing
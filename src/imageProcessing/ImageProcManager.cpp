@@ -7,6 +7,13 @@
 #include "schematicSegmentation/ComponentDetection.h"
 #include "schematicSegmentation/ConnectionDetection.h"
 #include "schematicSegmentation/LabelDetection.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <utility>
 
 namespace circuitSegmentation {
 namespace imageProcessing {
@@ -18,6 +25,7 @@ ImageProcManager::ImageProcManager(
     const std::shared_ptr<schematicSegmentation::SchematicSegmentation>& schematicSegmentation,
     const std::shared_ptr<schematicSegmentation::RoiSegmentation>& roiSegmentation,
     const std::shared_ptr<schematicSegmentation::SegmentationMap>& segmentationMap,
+    const std::shared_ptr<output::ImageWriter>& imageWriter,
     const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
     const std::shared_ptr<logging::Logger>& logger,
     const bool logMode,
@@ -28,6 +36,7 @@ ImageProcManager::ImageProcManager(
     , mSchematicSegmentation{schematicSegmentation}
     , mRoiSegmentation{roiSegmentation}
     , mSegmentationMap{segmentationMap}
+    , mImageWriter{imageWriter}
     , mOpenCvWrapper{openCvWrapper}
     , mLogger{logger}
     , mLogMode{std::move(logMode)}
@@ -40,27 +49,38 @@ ImageProcManager::ImageProcManager(
     setSaveImages(mSaveImages);
 }
 
-ImageProcManager
-    ImageProcManager::create(const std::shared_ptr<logging::Logger>& logger, const bool logMode, const bool saveImages)
+ImageProcManager ImageProcManager::create(const std::shared_ptr<logging::Logger>& logger,
+                                          const bool logMode,
+                                          const bool saveImages,
+                                          const common::ThreadBudget& threadBudget,
+                                          const std::shared_ptr<output::ImageWriter>& sharedImageWriter)
 {
     std::shared_ptr<computerVision::OpenCvWrapper> openCvWrapper{std::make_shared<computerVision::OpenCvWrapper>()};
+    std::shared_ptr<output::ImageWriter> imageWriter{sharedImageWriter};
+    if (!imageWriter) {
+        imageWriter = std::make_shared<output::ImageWriter>(openCvWrapper, logger, threadBudget.getNumWriterThreads());
+    }
+
+    // Internal parallelism of OpenCV, within the budget of threads
+    openCvWrapper->setNumThreads(static_cast<int>(threadBudget.getNumOpenCvThreads()));
     std::shared_ptr<schematicSegmentation::ComponentDetection> componentDetection{
-        std::make_shared<schematicSegmentation::ComponentDetection>(openCvWrapper, logger)};
+        std::make_shared<schematicSegmentation::ComponentDetection>(openCvWrapper, imageWriter, logger)};
     std::shared_ptr<schematicSegmentation::ConnectionDetection> connectionDetection{
-        std::make_shared<schematicSegmentation::ConnectionDetection>(openCvWrapper, logger)};
+        std::make_shared<schematicSegmentation::ConnectionDetection>(openCvWrapper, imageWriter, logger)};
     std::shared_ptr<schematicSegmentation::LabelDetection> labelDetection{
-        std::make_shared<schematicSegmentation::LabelDetection>(openCvWrapper, logger)};
+        std::make_shared<schematicSegmentation::LabelDetection>(openCvWrapper, imageWriter, logger)};
     std::shared_ptr<schematicSegmentation::SchematicSegmentation> schematicSegmentation{
-        std::make_shared<schematicSegmentation::SchematicSegmentation>(openCvWrapper, logger)};
+        std::make_shared<schematicSegmentation::SchematicSegmentation>(openCvWrapper, imageWriter, logger)};
 
     return ImageProcManager(
         std::make_shared<ImageReceiver>(openCvWrapper, logger),
-        std::make_shared<ImagePreprocessing>(openCvWrapper, logger),
+        std::make_shared<ImagePreprocessing>(openCvWrapper, imageWriter, logger),
         std::make_shared<ImageSegmentation>(
             openCvWrapper, logger, componentDetection, connectionDetection, labelDetection, schematicSegmentation),
         schematicSegmentation,
-        std::make_shared<schematicSegmentation::RoiSegmentation>(openCvWrapper, logger),
+        std::make_shared<schematicSegmentation::RoiSegmentation>(openCvWrapper, imageWriter, logger),
         std::make_shared<schematicSegmentation::SegmentationMap>(logger),
+        imageWriter,
         openCvWrapper,
         logger,
         logMode,
@@ -69,51 +89,476 @@ ImageProcManager
 
 bool ImageProcManager::processImage(const std::string imageFilePath)
 {
-    mLogger->logInfo("Starting image processing");
+    // Set image file path
+    mImageReceiver->setImageFilePath(imageFilePath);
 
-    // Receive image
-    if (!receiveImage(imageFilePath)) {
-        mLogger->logError("Failed during image reception");
-        return false;
+    return runProcessingJob();
+}
+
+bool ImageProcManager::processImagePages(const std::string imageFilePath)
+{
+    // Set image file path
+    mImageReceiver->setImageFilePath(imageFilePath);
+
+    // A file with a single page is processed as a single image
+    const auto numPages{mImageReceiver->getNumImagePages()};
+    if (numPages <= 1) {
+        return runProcessingJob();
     }
-    mLogger->logInfo("Image received successfully");
 
-    // Save image
-    if (mSaveImages) {
-        mOpenCvWrapper->writeImage("cs_initial_image.png", mImageInitial);
-#ifdef SHOW_IMAGES
-        mOpenCvWrapper->showImage("Initial image", mImageInitial, 0);
+    const auto outputDirectory{getOutputDirectory()};
+    const auto startTime{std::chrono::steady_clock::now()};
+    std::uint64_t jobId{0};
+    std::size_t numPagesSucceeded{0};
+    auto success{true};
+
+    // Pages decoded and processed one at a time, in the same job
+    for (std::size_t page{0}; page < numPages; ++page) {
+        const auto pageStartTime{std::chrono::steady_clock::now()};
+
+        // Output files of the page in its own folder
+        const auto pageDirectory{std::filesystem::path{outputDirectory} / getPageDirectoryName(page)};
+        std::error_code error{};
+        std::filesystem::create_directories(pageDirectory, error);
+        if (error) {
+            mLogger->logError("Failed to create the output folder {}: {}", pageDirectory.string(), error.message());
+            success = false;
+            continue;
+        }
+        setOutputDirectory(pageDirectory.string());
+        mImageReceiver->setImagePage(static_cast<int>(page));
+
+        jobId = beginProcessingJob(jobId);
+        const auto pageSuccess{endProcessingJob(runProcessingStages())};
+
+        const std::chrono::duration<double, std::milli> pageTime{std::chrono::steady_clock::now() - pageStartTime};
+        setJobContext(jobId);
+        mLogger->logInfo("Page {}/{} processed in {} ms: {}",
+                         page + 1,
+                         numPages,
+                         pageTime.count(),
+                         pageSuccess ? "success" : "failure");
+        setJobContext(0);
+
+        if (pageSuccess) {
+            ++numPagesSucceeded;
+            continue;
+        }
+        success = false;
+
+        // The next pages are not processed when the job was stopped
+        if (mLastStatus == ProcessingStatus::CANCELLED || mLastStatus == ProcessingStatus::DEADLINE_EXCEEDED) {
+            break;
+        }
+    }
+
+    setOutputDirectory(outputDirectory);
+
+    const std::chrono::duration<double, std::milli> totalTime{std::chrono::steady_clock::now() - startTime};
+    setJobContext(jobId);
+    mLogger->logInfo("Pages processed in {} ms: {} of {} succeeded", totalTime.count(), numPagesSucceeded, numPages);
+    setJobContext(0);
+
+    // The status of the last page does not tell the failure of the previous pages
+    if (!success && mLastStatus == ProcessingStatus::SUCCESS) {
+        mLastStatus = ProcessingStatus::FAILED;
+    }
+
+    return success;
+}
+
+bool ImageProcManager::processImageBuffer(std::vector<unsigned char> imageBuffer)
+{
+    // Set image buffer
+    mImageReceiver->setImageBuffer(std::move(imageBuffer));
+
+    return runProcessingJob();
+}
+
+bool ImageProcManager::processRawImageBuffer(const RawImageBuffer& imageBuffer)
+{
+    // Set buffer of raw pixels
+    mImageReceiver->setRawImageBuffer(imageBuffer);
+
+    return runProcessingJob();
+}
+
+bool ImageProcManager::processRawImageBuffer(const RawImageBuffer& imageBuffer,
+                                             const std::function<void()>& releaseBuffer)
+{
+    mReleaseRawImageBuffer = releaseBuffer;
+
+    return processRawImageBuffer(imageBuffer);
+}
+
+#ifdef COROUTINES_SUPPORTED
+common::Task<bool> ImageProcManager::processImageAsync(const std::string imageFilePath, common::Executor& executor)
+{
+    // Leave the calling thread
+    co_await common::schedule(executor);
+
+    // Set image file path
+    mImageReceiver->setImageFilePath(imageFilePath);
+
+    const auto jobId{beginProcessingJob()};
+
+    auto success{true};
+    for (const auto stage : cProcessingStages) {
+        if (!runProcessingStage(stage)) {
+            success = false;
+            break;
+        }
+
+        // Yield the thread between stages, so the stages of other processings run in between. The job context is set
+        // in the thread where the coroutine is resumed, which can be another one.
+        setJobContext(0);
+        co_await common::schedule(executor);
+        setJobContext(jobId);
+    }
+
+    // Wait for the images of this processing to be written without holding the thread. The job context is left before
+    // suspending, as between stages, and set again in the thread where the coroutine is resumed.
+    auto imagesFlushed{mImageWriter->flushAsync(executor)};
+    setJobContext(0);
+    const auto imagesWritten{co_await imagesFlushed};
+    setJobContext(jobId);
+
+    co_return finishProcessingJob(success, imagesWritten);
+}
 #endif
+
+const std::vector<circuit::Component>& ImageProcManager::getComponents() const
+{
+    return mSchematicSegmentation->getComponents();
+}
+
+const std::vector<circuit::Connection>& ImageProcManager::getConnections() const
+{
+    return mSchematicSegmentation->getConnections();
+}
+
+const std::vector<circuit::Node>& ImageProcManager::getNodes() const
+{
+    return mSchematicSegmentation->getNodes();
+}
+
+const nlohmann::ordered_json& ImageProcManager::getSegmentationMap() const
+{
+    return mSegmentationMap->getSegmentationMap();
+}
+
+void ImageProcManager::setOutputDirectory(const std::string& outputDirectory)
+{
+    // The image writer takes the directory of each job, since it can be shared with other managers
+    mOutputDirectory = outputDirectory;
+    mSegmentationMap->setOutputDirectory(outputDirectory);
+}
+
+std::string ImageProcManager::getOutputDirectory() const
+{
+    return mOutputDirectory;
+}
+
+ProcessingResult ImageProcManager::getResult() const
+{
+    ProcessingResult result{};
+
+    result.mSuccess = mLastStatus == ProcessingStatus::SUCCESS;
+    result.mStatus = mLastStatus;
+    if (result.mSuccess) {
+        // The elements detected are not kept in the cache, only their segmentation map
+        if (!mResultFromCache) {
+            result.mComponents = mSchematicSegmentation->getComponents();
+            result.mConnections = mSchematicSegmentation->getConnections();
+            result.mNodes = mSchematicSegmentation->getNodes();
+        }
+        result.mSegmentationMap = mSegmentationMap->getSegmentationMap();
+        result.mRoiImages = mRoiSegmentation->getRoiImages();
     }
 
-    // Preprocessing
-    preprocessImage();
-    mLogger->logInfo("Image preprocessing occurred successfully");
+    return result;
+}
 
-    // Segmentation
-    if (!segmentImage()) {
-        mLogger->logError("Failed during image segmentation");
-        return false;
+ProcessingStatus ImageProcManager::getLastStatus() const
+{
+    return mLastStatus;
+}
+
+bool ImageProcManager::isResultFromCache() const
+{
+    return mResultFromCache;
+}
+
+void ImageProcManager::setResultCache(const std::shared_ptr<ResultCache>& resultCache)
+{
+    mResultCache = resultCache;
+}
+
+std::shared_ptr<ResultCache> ImageProcManager::getResultCache() const
+{
+    return mResultCache;
+}
+
+void ImageProcManager::setNearDuplicateIndex(const std::shared_ptr<NearDuplicateIndex>& nearDuplicateIndex)
+{
+    mNearDuplicateIndex = nearDuplicateIndex;
+}
+
+std::shared_ptr<NearDuplicateIndex> ImageProcManager::getNearDuplicateIndex() const
+{
+    return mNearDuplicateIndex;
+}
+
+void ImageProcManager::setStageCheckpoints(const std::shared_ptr<StageCheckpoints>& stageCheckpoints)
+{
+    mStageCheckpoints = stageCheckpoints;
+}
+
+std::shared_ptr<StageCheckpoints> ImageProcManager::getStageCheckpoints() const
+{
+    return mStageCheckpoints;
+}
+
+void ImageProcManager::setCancellationToken(const std::shared_ptr<common::CancellationToken>& cancellationToken)
+{
+    mCancellationToken = cancellationToken;
+}
+
+std::shared_ptr<common::CancellationToken> ImageProcManager::getCancellationToken() const
+{
+    return mCancellationToken;
+}
+
+void ImageProcManager::setWriteOutputFiles(const bool& writeOutputFiles)
+{
+    mWriteOutputFiles = writeOutputFiles;
+
+    mRoiSegmentation->setWriteImages(mWriteOutputFiles);
+}
+
+bool ImageProcManager::getWriteOutputFiles() const
+{
+    return mWriteOutputFiles;
+}
+
+void ImageProcManager::setEncodeRoiImages(const bool& encodeRoiImages)
+{
+    mEncodeRoiImages = encodeRoiImages;
+
+    mRoiSegmentation->setEncodeImages(mEncodeRoiImages);
+}
+
+bool ImageProcManager::getEncodeRoiImages() const
+{
+    return mEncodeRoiImages;
+}
+
+bool ImageProcManager::runProcessingJob()
+{
+    beginProcessingJob();
+
+    return endProcessingJob(runProcessingStages());
+}
+
+std::uint64_t ImageProcManager::beginProcessingJob(const std::uint64_t jobId)
+{
+    // Job of this processing
+    const auto processingJobId{jobId != 0 ? jobId : ++mJobIdCounter};
+    setJobContext(processingJobId);
+    mImageWriter->setOutputDirectory(mOutputDirectory);
+
+    mLogger->logInfo("Starting image processing (preset: {})", common::getPresetName(mPreset));
+
+    mLastStatus = ProcessingStatus::FAILED;
+    mRoiSegmentation->clearRoiImages();
+    mCacheKey.clear();
+    mResultFromCache = false;
+    mImageFingerprint.reset();
+    mImageHash = 0;
+
+    return processingJobId;
+}
+
+void ImageProcManager::setJobContext(const std::uint64_t jobId)
+{
+    logging::Logger::setJobId(jobId);
+    common::CancellationToken::setCurrent(jobId != 0 ? mCancellationToken.get() : nullptr);
+}
+
+bool ImageProcManager::endProcessingJob(bool success)
+{
+    // Wait for all the images of this processing to be written
+    const auto imagesWritten{mImageWriter->flush()};
+
+    return finishProcessingJob(success, imagesWritten);
+}
+
+bool ImageProcManager::finishProcessingJob(bool success, bool imagesWritten)
+{
+    // Reason of the failure, when the stages were stopped by the cancellation token
+    auto status{success ? ProcessingStatus::SUCCESS : ProcessingStatus::FAILED};
+    if (!success && mCancellationToken) {
+        switch (mCancellationToken->getState()) {
+        case common::CancellationToken::State::CANCELLED:
+            status = ProcessingStatus::CANCELLED;
+            break;
+        case common::CancellationToken::State::DEADLINE_EXCEEDED:
+            status = ProcessingStatus::DEADLINE_EXCEEDED;
+            break;
+        case common::CancellationToken::State::ACTIVE:
+            break;
+        }
     }
-    mLogger->logInfo("Image segmentation occurred successfully");
 
-    // Images with regions of interest (ROI) for components and labels
-    if (!generateImageRoi()) {
-        mLogger->logError("Failed during generation of images with ROI");
-        return false;
+    // Images of this processing
+    if (!imagesWritten) {
+        mLogger->logError("Failed during writing of images");
+        if (status == ProcessingStatus::SUCCESS) {
+            status = ProcessingStatus::FAILED;
+        }
     }
-    mLogger->logInfo("Generation of images with ROI occurred successfully");
 
-    // Segmentation map
-    if (!generateSegmentationMap()) {
-        mLogger->logError("Failed during generation of segmentation map file");
+    // Release the images of this job, so an idle manager does not hold them
+    mImageInitial = computerVision::ImageMat{};
+    mImageBorrowed = false;
+    mImageProcessed = computerVision::ImageMat{};
+    mImageBinary.reset(0, 0);
+    mImageReceiver->releaseImage();
+    releaseRawImageBuffer();
+
+    // End of the job
+    setJobContext(0);
+
+    mLastStatus = status;
+
+    return status == ProcessingStatus::SUCCESS;
+}
+
+bool ImageProcManager::runProcessingStages()
+{
+    for (const auto stage : cProcessingStages) {
+        if (!runProcessingStage(stage)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ImageProcManager::runProcessingStage(const ProcessingStage stage)
+{
+    // The stages after the reception are skipped when the result was restored from the cache
+    if (mResultFromCache) {
+        return true;
+    }
+
+    // Stop if the job was cancelled or its deadline expired
+    if (common::CancellationToken::isCurrentStopped()) {
+        mLogger->logWarning("Image processing stopped by its cancellation token");
         return false;
     }
-    mLogger->logInfo("Generation of segmentation map file occurred successfully");
+
+    mStageProfiler.start();
+
+    switch (stage) {
+    case ProcessingStage::RECEPTION:
+        // Receive image
+        if (!receiveImage()) {
+            mLogger->logError("Failed during image reception");
+            return false;
+        }
+        logStageUsage("image reception");
+        mLogger->logInfo("Image received successfully");
+
+        // The pixels converted on reception do not reference the buffer of raw pixels
+        if (!mImageBorrowed) {
+            releaseRawImageBuffer();
+        }
+
+        // Save image (a copy, if its pixels are borrowed from a buffer that is released before it is written)
+        if (mSaveImages && !mLowMemoryMode) {
+            mImageWriter->writeImage("cs_initial_image.png",
+                                     mReleaseRawImageBuffer && mImageBorrowed
+                                         ? mOpenCvWrapper->cloneImage(mImageInitial)
+                                         : mImageInitial);
+#ifdef SHOW_IMAGES
+            mOpenCvWrapper->showImage("Initial image", mImageInitial, 0);
+#endif
+        }
+
+        // Content of the image, for the result cache and the stage checkpoints
+        if (mResultCache || mStageCheckpoints) {
+            mImageHash = mOpenCvWrapper->hashImage(mImageInitial);
+        }
+
+        // Result of the same image, processed before with the same preset
+        if (mResultCache && !findCachedResult()) {
+            mLogger->logError("Failed during restoring of result from the cache");
+            return false;
+        }
+        break;
+
+    case ProcessingStage::PREPROCESSING:
+        // Preprocessing
+        preprocessImage();
+        logStageUsage("preprocessing");
+        mLogger->logInfo("Image preprocessing occurred successfully");
+        break;
+
+    case ProcessingStage::SEGMENTATION:
+        // Segmentation
+        if (!segmentImage()) {
+            mLogger->logError("Failed during image segmentation");
+            return false;
+        }
+        logStageUsage("segmentation");
+        mLogger->logInfo("Image segmentation occurred successfully");
+        break;
+
+    case ProcessingStage::ROI_GENERATION:
+        // Images with regions of interest (ROI) for components and labels
+        if (!generateImageRoi()) {
+            mLogger->logError("Failed during generation of images with ROI");
+            return false;
+        }
+        logStageUsage("generation of images with ROI");
+        mLogger->logInfo("Generation of images with ROI occurred successfully");
+
+        // The initial image is no longer read
+        releaseRawImageBuffer();
+        break;
+
+    case ProcessingStage::SEGMENTATION_MAP_GENERATION:
+        // Segmentation map
+        if (!generateSegmentationMap()) {
+            mLogger->logError("Failed during generation of segmentation map file");
+            return false;
+        }
+        logStageUsage("generation of segmentation map");
+        mLogger->logInfo("Generation of segmentation map file occurred successfully");
+
+        // Result for the next processings of the same image
+        storeCachedResult();
+        break;
+    }
 
     return true;
 }
 
+void ImageProcManager::logStageUsage(const std::string& stage)
+{
+    const auto usage{mStageProfiler.stop(stage)};
+
+    mLogger->logDebug("Stage {}: wall time = {} ms, worker CPU time = {} ms, process-wide CPU time = {} ms, "
+                      "process-wide CPU utilization = {} % of {} cores",
+                      usage.mName,
+                      usage.mWallTimeMs,
+                      usage.mCpuTimeMs,
+                      usage.mProcessCpuTimeMs,
+                      usage.mProcessUtilization,
+                      mStageProfiler.getNumCores());
+}
+
 void ImageProcManager::setLogMode(const bool& logMode)
 {
     mLogMode = logMode;
@@ -140,8 +585,8 @@ void ImageProcManager::setSaveImages(const bool& saveImages)
 {
     mSaveImages = saveImages;
 
-    mImagePreprocessing->setSaveImages(mSaveImages);
-    mImageSegmentation->setSaveImages(mSaveImages);
+    mImagePreprocessing->setSaveImages(mSaveImages && !mLowMemoryMode);
+    mImageSegmentation->setSaveImages(mSaveImages && !mLowMemoryMode);
 }
 
 bool ImageProcManager::getSaveImages() const
@@ -149,11 +594,248 @@ bool ImageProcManager::getSaveImages() const
     return mSaveImages;
 }
 
-bool ImageProcManager::receiveImage(const std::string& filePath)
+void ImageProcManager::setPreset(const common::Preset& preset)
 {
-    // Set image file path
-    mImageReceiver->setImageFilePath(filePath);
+    mPreset = preset;
+
+    mImagePreprocessing->setPreset(mPreset);
+    mImageSegmentation->setPreset(mPreset);
+    if (mTiledSegmentation) {
+        mTiledSegmentation->setPreset(mPreset);
+    }
+}
+
+common::Preset ImageProcManager::getPreset() const
+{
+    return mPreset;
+}
+
+void ImageProcManager::setDeterministicIds(const bool& deterministicIds)
+{
+    mDeterministicIds = deterministicIds;
+
+    mImageSegmentation->setDeterministicIds(mDeterministicIds);
+    if (mTiledSegmentation) {
+        mTiledSegmentation->setDeterministicIds(mDeterministicIds);
+    }
+}
+
+bool ImageProcManager::getDeterministicIds() const
+{
+    return mDeterministicIds;
+}
+
+void ImageProcManager::setLowMemoryMode(const bool& lowMemoryMode)
+{
+    mLowMemoryMode = lowMemoryMode;
+
+    // Images saved only out of low-memory mode
+    setSaveImages(mSaveImages);
+}
+
+bool ImageProcManager::getLowMemoryMode() const
+{
+    return mLowMemoryMode;
+}
+
+void ImageProcManager::setTileSize(const int& tileSize,
+                                   const unsigned int numThreads,
+                                   const common::ThreadPool::ThreadStart& threadStart)
+{
+    if (tileSize <= 0) {
+        mTiledSegmentation.reset();
+        return;
+    }
+
+    mTiledSegmentation = std::make_shared<TiledSegmentation>(
+        mOpenCvWrapper,
+        mImageWriter,
+        mLogger,
+        mSchematicSegmentation,
+        tileSize,
+        numThreads,
+        TiledSegmentation::cOverlapDefault,
+        threadStart);
+    mTiledSegmentation->setPreset(mPreset);
+    mTiledSegmentation->setDeterministicIds(mDeterministicIds);
+}
+
+int ImageProcManager::getTileSize() const
+{
+    return mTiledSegmentation ? mTiledSegmentation->getTileSize() : 0;
+}
+
+void ImageProcManager::setBandHeight(const int& bandHeight)
+{
+    mBandHeight = bandHeight > 0 ? bandHeight : 0;
+}
+
+int ImageProcManager::getBandHeight() const
+{
+    return mBandHeight;
+}
+
+std::string ImageProcManager::getPageDirectoryName(const std::size_t page)
+{
+    std::ostringstream name{};
+    name << "page_" << std::setw(3) << std::setfill('0') << page + 1;
+
+    return name.str();
+}
+
+std::size_t ImageProcManager::estimatePeakMemory(const ImageDimensions& dimensions,
+                                                 const bool saveImages,
+                                                 const std::size_t encodedBytes)
+{
+    const auto numPixels{static_cast<std::size_t>(dimensions.mWidth) * static_cast<std::size_t>(dimensions.mHeight)};
+    const auto bytesPerPixel{cBytesPerPixel + (saveImages ? cSavedImagesBytesPerPixel : 0)};
+
+    return numPixels * bytesPerPixel + encodedBytes;
+}
 
+void ImageProcManager::releaseRawImageBuffer()
+{
+    if (!mReleaseRawImageBuffer) {
+        return;
+    }
+
+    // No image references the pixels of the buffer after it is released
+    if (mImageBorrowed) {
+        mImageInitial = computerVision::ImageMat{};
+        mImageBorrowed = false;
+    }
+    mImageReceiver->releaseImage();
+
+    const auto releaseBuffer{std::move(mReleaseRawImageBuffer)};
+    mReleaseRawImageBuffer = nullptr;
+    releaseBuffer();
+}
+
+int ImageProcManager::getImageTileSize()
+{
+    return mTiledSegmentation && mTiledSegmentation->isTiled(mImageInitial) ? mTiledSegmentation->getTileSize() : 0;
+}
+
+int ImageProcManager::getImageBandHeight()
+{
+    if (getImageTileSize() > 0 || mImageBinary.getSizeBytes() > 0 || (mBandHeight == 0 && !mLowMemoryMode)) {
+        return 0;
+    }
+
+    return mBandHeight > 0 ? mBandHeight : ImagePreprocessing::cBandHeightDefault;
+}
+
+bool ImageProcManager::findCachedResult()
+{
+    mCacheKey = ResultCache::makeKey(mImageHash, mPreset, mDeterministicIds, getImageTileSize(), getImageBandHeight());
+
+    CachedResult cachedResult{};
+    if (!mResultCache->find(mCacheKey, cachedResult)) {
+        return mNearDuplicateIndex ? findNearDuplicateResult() : true;
+    }
+    if (!restoreCachedResult(cachedResult)) {
+        return false;
+    }
+
+    // The image is no longer needed
+    mResultFromCache = true;
+    releaseRawImageBuffer();
+    mLogger->logInfo("Result restored from the cache ({})", mCacheKey);
+
+    return true;
+}
+
+bool ImageProcManager::findNearDuplicateResult()
+{
+    // Fingerprint of the image, also indexed with the result of the processing
+    mImageFingerprint = NearDuplicateIndex::computeFingerprint(mOpenCvWrapper, mImageInitial);
+
+    for (const auto& nearDuplicate : mNearDuplicateIndex->find(*mImageFingerprint, mCacheKey)) {
+        // The result may have been evicted from the cache
+        CachedResult cachedResult{};
+        if (!mResultCache->find(nearDuplicate.mKey, cachedResult)) {
+            mNearDuplicateIndex->remove(nearDuplicate.mKey);
+            continue;
+        }
+
+        // The images with ROI are cropped again from the image, at the ROI transformed
+        NearDuplicateIndex::transformResult(nearDuplicate.mTransform,
+                                            cachedResult,
+                                            mOpenCvWrapper->getImageWidth(mImageInitial),
+                                            mOpenCvWrapper->getImageHeight(mImageInitial));
+        if (!restoreCachedResult(cachedResult, true)) {
+            return false;
+        }
+
+        // The image is no longer needed
+        mResultFromCache = true;
+        releaseRawImageBuffer();
+        mLogger->logInfo("Result restored from the cache, of a near-duplicate ({}, distance: {})",
+                         nearDuplicate.mKey,
+                         nearDuplicate.mDistance);
+
+        return true;
+    }
+
+    return true;
+}
+
+bool ImageProcManager::restoreCachedResult(CachedResult& cachedResult, const bool cropRoiImages)
+{
+    // Images with ROI, cropped again from the image (e.g. of a near-duplicate) or already encoded in the cache
+    if (cropRoiImages) {
+        if (!mRoiSegmentation->generateRoiImages(mImageInitial, std::move(cachedResult.mRoiImages))) {
+            return false;
+        }
+    } else {
+        for (auto& roiImage : cachedResult.mRoiImages) {
+            if (mWriteOutputFiles) {
+                const auto filePath{std::filesystem::path{getOutputDirectory()} / roiImage.mFileName};
+                std::ofstream file{filePath, std::ios::binary};
+                file.write(reinterpret_cast<const char*>(roiImage.mEncodedImage.data()),
+                           static_cast<std::streamsize>(roiImage.mEncodedImage.size()));
+                if (!file) {
+                    mLogger->logError("Failed to write image {}", filePath.string());
+                    return false;
+                }
+            }
+            if (!mEncodeRoiImages) {
+                std::vector<unsigned char>{}.swap(roiImage.mEncodedImage);
+            }
+        }
+        mRoiSegmentation->setRoiImages(std::move(cachedResult.mRoiImages));
+    }
+
+    // Segmentation map
+    mSegmentationMap->setSegmentationMap(cachedResult.mSegmentationMap);
+    if (mWriteOutputFiles && !mSegmentationMap->writeSegmentationMapJsonFile()) {
+        return false;
+    }
+
+    return true;
+}
+
+void ImageProcManager::storeCachedResult()
+{
+    // The images with ROI are stored from their files or from memory, so one of them must exist
+    if (!mResultCache || mCacheKey.empty() || (!mWriteOutputFiles && !mEncodeRoiImages)) {
+        return;
+    }
+
+    if (mResultCache->store(mCacheKey,
+                            mSegmentationMap->getSegmentationMap(),
+                            mRoiSegmentation->getRoiImages(),
+                            getOutputDirectory())) {
+        mLogger->logInfo("Result stored in the cache ({})", mCacheKey);
+
+        if (mNearDuplicateIndex && mImageFingerprint) {
+            mNearDuplicateIndex->add(mCacheKey, *mImageFingerprint);
+        }
+    }
+}
+
+bool ImageProcManager::receiveImage()
+{
     // Receive image from image receiver
     if (!mImageReceiver->receiveImage()) {
         return false;
@@ -161,22 +843,71 @@ bool ImageProcManager::receiveImage(const std::string& filePath)
 
     // Get image received
     mImageInitial = mImageReceiver->getImageReceived();
+    mImageBorrowed = mImageReceiver->isImageBorrowed();
+    mImageBinary = mImageReceiver->getImageBinary();
+
+    // The encoded image is no longer needed (the pixels borrowed are released at the end of the processing)
+    if (mLowMemoryMode && !mImageBorrowed) {
+        mImageReceiver->releaseImage();
+    }
 
     return true;
 }
 
 void ImageProcManager::preprocessImage()
 {
-    // Copy initial image
-    mImageProcessed = mOpenCvWrapper->cloneImage(mImageInitial);
+    // The tiles of an image segmented by tiles are preprocessed by the segmentation
+    if (mTiledSegmentation && mTiledSegmentation->isTiled(mImageInitial)) {
+        mLogger->logInfo("Image larger than a tile, preprocessed by tiles during the segmentation");
+        return;
+    }
+
+    // Image preprocessed before with the same parameters and bands
+    const auto bandHeight{getImageBandHeight()};
+    std::string checkpointKey{};
+    if (mStageCheckpoints) {
+        checkpointKey = StageCheckpoints::makeKey(CheckpointStage::PREPROCESSING,
+                                                  mImageHash,
+                                                  StageCheckpoints::hashPreprocessingParameters(mPreset, bandHeight));
+        if (mStageCheckpoints->loadImage(checkpointKey, mImageProcessed)) {
+            mLogger->logInfo("Image preprocessed restored from checkpoint {}", checkpointKey);
+            return;
+        }
+    }
 
-    // Preprocess the image
-    mImagePreprocessing->preprocessImage(mImageProcessed);
+    if (mImageBinary.getSizeBytes() > 0) {
+        // The binary image received is already thresholded, so only its morphology and thinning are left
+        mImageProcessed = mImageBinary.unpack(mOpenCvWrapper);
+        mImagePreprocessing->preprocessBinaryImage(mImageProcessed);
+    } else if (bandHeight > 0) {
+        // Preprocess the image by bands, unpacking the skeleton only once complete
+        BinaryImage imageBinary{};
+        mImagePreprocessing->preprocessImageBands(mImageInitial, imageBinary, bandHeight);
+        mImageProcessed = imageBinary.unpack(mOpenCvWrapper);
+    } else {
+        // Copy initial image
+        mImageProcessed = mOpenCvWrapper->cloneImage(mImageInitial);
+
+        // Preprocess the image
+        mImagePreprocessing->preprocessImage(mImageProcessed);
+    }
+
+    // A preprocessing stopped by its cancellation token is incomplete
+    if (!checkpointKey.empty() && !common::CancellationToken::isCurrentStopped()) {
+        mStageCheckpoints->storeImage(checkpointKey, mImageProcessed);
+    }
 }
 
 bool ImageProcManager::segmentImage()
 {
-    // Segment the image
+    // Segment the image by tiles, if it is larger than a tile
+    if (mTiledSegmentation && mTiledSegmentation->isTiled(mImageInitial)) {
+        return mTiledSegmentation->segmentImage(mImageInitial);
+    }
+
+    // Segment the image, resuming from the checkpoint of its elements
+    mImageSegmentation->setCheckpoints(mStageCheckpoints, mImageHash, getImageBandHeight());
+
     return mImageSegmentation->segmentImage(mImageInitial, mImageProcessed);
 }
 
@@ -208,7 +939,7 @@ bool ImageProcManager::generateSegmentationMap()
     }
 
     // Write segmentation map file
-    if (!mSegmentationMap->writeSegmentationMapJsonFile()) {
+    if (mWriteOutputFiles && !mSegmentationMap->writeSegmentationMapJsonFile()) {
         return false;
     }
 
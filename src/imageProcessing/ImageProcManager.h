@@ -4,16 +4,38 @@
 
 #pragma once
 
+#include "common/CancellationToken.h"
+#include "common/Executor.h"
+#include "common/Preset.h"
+#include "common/StageProfiler.h"
+#include "common/Task.h"
+#include "common/ThreadBudget.h"
+#include "common/ThreadPool.h"
 #include "computerVision/OpenCvWrapper.h"
+#include "ImageHeader.h"
 #include "ImagePreprocessing.h"
 #include "ImageReceiver.h"
 #include "ImageSegmentation.h"
+#include "NearDuplicateIndex.h"
+#include "ProcessingResult.h"
+#include "ResultCache.h"
+#include "StageCheckpoints.h"
+#include "TiledSegmentation.h"
 #include "logging/Logger.h"
+#include "output/ImageWriter.h"
 #include "schematicSegmentation/RoiSegmentation.h"
 #include "schematicSegmentation/SchematicSegmentation.h"
 #include "schematicSegmentation/SegmentationMap.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace circuitSegmentation {
 namespace imageProcessing {
@@ -33,6 +55,7 @@ public:
      * @param schematicSegmentation Schematic segmentation.
      * @param roiSegmentation ROI segmentation.
      * @param segmentationMap Segmentation map.
+     * @param imageWriter Image writer.
      * @param openCvWrapper OpenCV wrapper.
      * @param logger Logger.
      * @param logMode Log mode: verbose = true, silent = false.
@@ -44,6 +67,7 @@ public:
                      const std::shared_ptr<schematicSegmentation::SchematicSegmentation>& schematicSegmentation,
                      const std::shared_ptr<schematicSegmentation::RoiSegmentation>& roiSegmentation,
                      const std::shared_ptr<schematicSegmentation::SegmentationMap>& segmentationMap,
+                     const std::shared_ptr<output::ImageWriter>& imageWriter,
                      const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
                      const std::shared_ptr<logging::Logger>& logger,
                      const bool logMode = false,
@@ -60,12 +84,18 @@ public:
      * @param logger Logger.
      * @param logMode Log mode: verbose = true, silent = false.
      * @param saveImages Save images obtained during the processing.
+     * @param threadBudget Budget of threads: it defines the number of threads for writing images (e.g. the images with
+     * ROI are encoded in parallel) and for the internal parallelism of OpenCV.
+     * @param sharedImageWriter Image writer shared with other managers (null to create one with the threads of the
+     * budget).
      *
      * @return An instance of an image processing manager.
      */
     static ImageProcManager create(const std::shared_ptr<logging::Logger>& logger,
                                    const bool logMode = false,
-                                   const bool saveImages = false);
+                                   const bool saveImages = false,
+                                   const common::ThreadBudget& threadBudget = common::ThreadBudget{},
+                                   const std::shared_ptr<output::ImageWriter>& sharedImageWriter = nullptr);
 
     /**
      * @brief Processes the image.
@@ -74,12 +104,272 @@ public:
      * - Preprocessing of the image
      * - Segmentation of the image
      *
+     * The images written during the processing are written asynchronously. Before returning, this method waits for
+     * all of them to be written, so a failure to write any image is also reported as a processing failure.
+     *
+     * Each processing is a job with a new job ID, which is carried by the messages logged during the processing.
+     * The wall-clock time, CPU time and CPU utilization of each stage are logged as debug messages.
+     *
+     * With a result cache (see @ref setResultCache), the decoded image is hashed after its reception: if the same
+     * image was processed before with the same preset, the segmentation map and the images with ROI are restored from
+     * the cache and the other stages are skipped. Otherwise, the result is stored in the cache when it succeeds.
+     *
+     * With a near-duplicate index too (see @ref setNearDuplicateIndex), the result of a near-duplicate image (e.g. the
+     * same schematic re-scanned with another exposure or crop) is restored when the image is not in the cache, with
+     * its coordinates transformed to the image.
+     *
+     * With stage checkpoints (see @ref setStageCheckpoints), the image preprocessed and the elements detected before
+     * the labels are restored from their checkpoints when the same image was processed before with the same parameters
+     * of those stages, and checkpointed otherwise.
+     *
      * @param imageFilePath Image file path for processing.
      *
      * @return True if the processing terminated successfully, otherwise false.
      */
     virtual bool processImage(const std::string imageFilePath);
 
+    /**
+     * @brief Processes the pages of an image file (e.g. the sheets of a schematic in a multi-page TIFF file).
+     *
+     * The pages are decoded one at a time, so a single page is in memory, and processed by the same pipeline as
+     * @ref processImage in a single job. The output files of each page are written in its own folder of the output
+     * directory (see @ref getPageDirectoryName). The time of each page and the total time are logged. A file with a
+     * single page is processed as @ref processImage, in the output directory.
+     *
+     * The processing stops at the first page stopped by the cancellation token, while a page that fails does not stop
+     * the next pages. The result of the last page is kept (see @ref getResult).
+     *
+     * @param imageFilePath Image file path for processing.
+     *
+     * @return True if the processing of all the pages terminated successfully, otherwise false.
+     */
+    virtual bool processImagePages(const std::string imageFilePath);
+
+    /**
+     * @brief Processes the image encoded in a buffer in memory (e.g. the content of a PNG file).
+     *
+     * The processing is the same as @ref processImage, but the image is decoded from the buffer instead of read from
+     * a file.
+     *
+     * @param imageBuffer Buffer with the encoded image for processing.
+     *
+     * @return True if the processing terminated successfully, otherwise false.
+     */
+    virtual bool processImageBuffer(std::vector<unsigned char> imageBuffer);
+
+    /**
+     * @brief Processes the image in a buffer of raw pixels.
+     *
+     * The processing is the same as @ref processImage, but the image is wrapped from the buffer instead of read from
+     * a file. The pixels in BGR format are not copied, so the buffer must be kept valid until this method returns.
+     *
+     * @param imageBuffer Buffer of raw pixels for processing.
+     *
+     * @return True if the processing terminated successfully, otherwise false.
+     */
+    virtual bool processRawImageBuffer(const RawImageBuffer& imageBuffer);
+
+    /**
+     * @brief Processes the image in a buffer of raw pixels, releasing the buffer as soon as it is no longer needed.
+     *
+     * The processing is the same as @ref processRawImageBuffer, but the buffer is handed back to its owner (e.g. a
+     * slot of a shared-memory ring) before the processing ends:
+     * - Pixels in BGR format are borrowed without copying, so the buffer is released after the generation of the
+     *   images with ROI, the last stage that reads the initial image. The initial image is copied if it is saved.
+     * - Pixels in other formats are converted to a new image, so the buffer is released right after the reception.
+     *
+     * The release function is called once, in the calling thread, even if the processing fails.
+     *
+     * @param imageBuffer Buffer of raw pixels for processing.
+     * @param releaseBuffer Function that releases the buffer.
+     *
+     * @return True if the processing terminated successfully, otherwise false.
+     */
+    virtual bool processRawImageBuffer(const RawImageBuffer& imageBuffer, const std::function<void()>& releaseBuffer);
+
+#ifdef COROUTINES_SUPPORTED
+    /**
+     * @brief Processes the image asynchronously, in a coroutine driven by an executor.
+     *
+     * The processing is the same as @ref processImage, but the calling thread is not blocked: the coroutine is
+     * resumed on the executor at the start and after each stage (reception, preprocessing, segmentation, generation of
+     * images with ROI and of the segmentation map), so the stages of many requests are interleaved on the few threads
+     * of the executor. The images are still written by the threads of the image writer, and the coroutine is suspended
+     * until they are written instead of blocking the thread.
+     *
+     * The manager processes one image at a time, so it must not be used by other processings (synchronous or
+     * asynchronous) until the task completes. The manager and the executor must outlive the task.
+     *
+     * @param imageFilePath Image file path for processing.
+     * @param executor Executor that runs the stages.
+     *
+     * @return Task with true if the processing terminated successfully, otherwise false.
+     */
+    virtual common::Task<bool> processImageAsync(const std::string imageFilePath, common::Executor& executor);
+#endif
+
+    /**
+     * @brief Gets the components detected by the last processing.
+     *
+     * @return Components.
+     */
+    [[nodiscard]] virtual const std::vector<circuit::Component>& getComponents() const;
+
+    /**
+     * @brief Gets the connections detected by the last processing.
+     *
+     * @return Connections.
+     */
+    [[nodiscard]] virtual const std::vector<circuit::Connection>& getConnections() const;
+
+    /**
+     * @brief Gets the nodes detected by the last processing.
+     *
+     * @return Nodes.
+     */
+    [[nodiscard]] virtual const std::vector<circuit::Node>& getNodes() const;
+
+    /**
+     * @brief Gets the segmentation map generated by the last processing.
+     *
+     * @return Segmentation map.
+     */
+    [[nodiscard]] virtual const nlohmann::ordered_json& getSegmentationMap() const;
+
+    /**
+     * @brief Gets the result of the last processing, kept in memory.
+     *
+     * The result is a copy, so it remains valid after the next processing. A result restored from the cache has the
+     * segmentation map and the images with ROI, but not the elements detected (see @ref isResultFromCache).
+     *
+     * @return Result of the last processing.
+     */
+    [[nodiscard]] virtual ProcessingResult getResult() const;
+
+    /**
+     * @brief Gets the status of the last processing.
+     *
+     * It tells why the last processing failed, e.g. if it was stopped by its cancellation token.
+     *
+     * @return Status of the last processing.
+     */
+    [[nodiscard]] virtual ProcessingStatus getLastStatus() const;
+
+    /**
+     * @brief Checks if the result of the last processing was restored from the result cache.
+     *
+     * @return True if the result was restored from the cache, otherwise false.
+     */
+    [[nodiscard]] virtual bool isResultFromCache() const;
+
+    /**
+     * @brief Sets the result cache of the next processings, which can be shared by many managers.
+     *
+     * @param resultCache Result cache, already open (null for none).
+     */
+    virtual void setResultCache(const std::shared_ptr<ResultCache>& resultCache);
+
+    /**
+     * @brief Gets the result cache of the next processings.
+     *
+     * @return Result cache (null for none).
+     */
+    [[nodiscard]] virtual std::shared_ptr<ResultCache> getResultCache() const;
+
+    /**
+     * @brief Sets the near-duplicate index of the next processings, which can be shared by many managers.
+     *
+     * It is only used with a result cache, whose results it indexes.
+     *
+     * @param nearDuplicateIndex Near-duplicate index, already open (null for none).
+     */
+    virtual void setNearDuplicateIndex(const std::shared_ptr<NearDuplicateIndex>& nearDuplicateIndex);
+
+    /**
+     * @brief Gets the near-duplicate index of the next processings.
+     *
+     * @return Near-duplicate index (null for none).
+     */
+    [[nodiscard]] virtual std::shared_ptr<NearDuplicateIndex> getNearDuplicateIndex() const;
+
+    /**
+     * @brief Sets the stage checkpoints of the next processings, which can be shared by many managers.
+     *
+     * @param stageCheckpoints Stage checkpoints, already open (null for none).
+     */
+    virtual void setStageCheckpoints(const std::shared_ptr<StageCheckpoints>& stageCheckpoints);
+
+    /**
+     * @brief Gets the stage checkpoints of the next processings.
+     *
+     * @return Stage checkpoints (null for none).
+     */
+    [[nodiscard]] virtual std::shared_ptr<StageCheckpoints> getStageCheckpoints() const;
+
+    /**
+     * @brief Sets the cancellation token of the next processings.
+     *
+     * The token is checked before each stage and inside the long loops of the stages, so a processing stops promptly
+     * when the token is cancelled or its deadline expires. The processing then returns false, with the status
+     * @ref ProcessingStatus::CANCELLED or @ref ProcessingStatus::DEADLINE_EXCEEDED. The images already submitted for
+     * writing are still written.
+     *
+     * @param cancellationToken Cancellation token (null for none).
+     */
+    virtual void setCancellationToken(const std::shared_ptr<common::CancellationToken>& cancellationToken);
+
+    /**
+     * @brief Gets the cancellation token of the next processings.
+     *
+     * @return Cancellation token (null for none).
+     */
+    [[nodiscard]] virtual std::shared_ptr<common::CancellationToken> getCancellationToken() const;
+
+    /**
+     * @brief Sets the directory where the output files (segmentation map and images) are written.
+     *
+     * @param outputDirectory Output directory (empty for the working directory). It must exist.
+     */
+    virtual void setOutputDirectory(const std::string& outputDirectory);
+
+    /**
+     * @brief Gets the directory where the output files are written.
+     *
+     * @return Output directory (empty for the working directory).
+     */
+    [[nodiscard]] virtual std::string getOutputDirectory() const;
+
+    /**
+     * @brief Sets the flag to write the output files (segmentation map and images with ROI).
+     *
+     * When disabled, the results are only kept in memory (see @ref getResult). The images obtained during the
+     * processing are still written if they are saved (see @ref setSaveImages).
+     *
+     * @param writeOutputFiles Write the output files.
+     */
+    virtual void setWriteOutputFiles(const bool& writeOutputFiles);
+
+    /**
+     * @brief Gets the flag to write the output files.
+     *
+     * @return The flag to write the output files.
+     */
+    [[nodiscard]] virtual bool getWriteOutputFiles() const;
+
+    /**
+     * @brief Sets the flag to encode the images with ROI to memory, kept in the result of the processing.
+     *
+     * @param encodeRoiImages Encode the images with ROI to memory.
+     */
+    virtual void setEncodeRoiImages(const bool& encodeRoiImages);
+
+    /**
+     * @brief Gets the flag to encode the images with ROI to memory.
+     *
+     * @return The flag to encode the images with ROI to memory.
+     */
+    [[nodiscard]] virtual bool getEncodeRoiImages() const;
+
     /**
      * @brief Sets the log mode.
      *
@@ -108,15 +398,271 @@ public:
      */
     [[nodiscard]] virtual bool getSaveImages() const;
 
+    /**
+     * @brief Sets the preset of the next processings, which sets the parameters of the preprocessing and segmentation.
+     *
+     * @param preset Preset.
+     */
+    virtual void setPreset(const common::Preset& preset);
+
+    /**
+     * @brief Gets the preset of the next processings.
+     *
+     * @return The preset.
+     */
+    [[nodiscard]] virtual common::Preset getPreset() const;
+
+    /**
+     * @brief Sets the flag to assign deterministic IDs to the elements of the next processings, so the same image
+     * always yields the same segmentation map.
+     *
+     * @param deterministicIds Assign deterministic IDs.
+     */
+    virtual void setDeterministicIds(const bool& deterministicIds);
+
+    /**
+     * @brief Gets the flag to assign deterministic IDs to the elements of the next processings.
+     *
+     * @return The flag to assign deterministic IDs.
+     */
+    [[nodiscard]] virtual bool getDeterministicIds() const;
+
+    /**
+     * @brief Sets the low-memory mode of the next processings, for images too large for the budget of memory.
+     *
+     * In low-memory mode, the images obtained during the processing are not saved, even if requested (each one is a
+     * copy of the full image, queued until it is written), the buffer with the encoded image is released as soon as
+     * the image is decoded, and the image is preprocessed by bands (see @ref setBandHeight). The resolution of the
+     * image is not changed, but the skeleton of an image preprocessed by bands can differ for lines thicker than the
+     * context of the bands, so the results can differ from the results of the image preprocessed as a whole.
+     *
+     * @param lowMemoryMode Low-memory mode.
+     */
+    virtual void setLowMemoryMode(const bool& lowMemoryMode);
+
+    /**
+     * @brief Gets the low-memory mode of the next processings.
+     *
+     * @return The low-memory mode.
+     */
+    [[nodiscard]] virtual bool getLowMemoryMode() const;
+
+    /**
+     * @brief Sets the size of the tiles of the next processings, whose images larger than a tile are segmented by
+     * overlapping tiles in parallel (see @ref TiledSegmentation).
+     *
+     * The images segmented by tiles are not preprocessed as a whole (each tile is preprocessed by the segmentation),
+     * so the images of the processing are not saved and the stage checkpoints are not used for them.
+     *
+     * @param tileSize Width and height of the tiles, in pixels (0 to segment the images as a whole).
+     * @param numThreads Number of threads segmenting the tiles.
+     * @param threadStart Function called by each thread segmenting the tiles when it starts (e.g. to pin it).
+     */
+    virtual void setTileSize(const int& tileSize,
+                             const unsigned int numThreads,
+                             const common::ThreadPool::ThreadStart& threadStart = {});
+
+    /**
+     * @brief Gets the size of the tiles of the next processings.
+     *
+     * @return Width and height of the tiles, in pixels (0 if the images are segmented as a whole).
+     */
+    [[nodiscard]] virtual int getTileSize() const;
+
+    /**
+     * @brief Sets the height of the bands of the next processings, whose images are preprocessed band by band into a
+     * packed bitmap (see @ref ImagePreprocessing::preprocessImageBands), instead of as a copy of the full image.
+     *
+     * The images are also preprocessed by bands of the default height in low-memory mode. The images of the
+     * preprocessing are not saved when preprocessed by bands. The skeleton is unpacked to a full image of one byte per
+     * pixel for the detections, so only the full copies of the preprocessing are saved: the peak memory is still the
+     * initial image, the skeleton and the working images of the detections.
+     *
+     * @param bandHeight Height of the bands, in rows (0 to preprocess the images as a whole, except in low-memory
+     * mode).
+     */
+    virtual void setBandHeight(const int& bandHeight);
+
+    /**
+     * @brief Gets the height of the bands of the next processings.
+     *
+     * @return Height of the bands, in rows (0 if the images are preprocessed as a whole, except in low-memory mode).
+     */
+    [[nodiscard]] virtual int getBandHeight() const;
+
+    /**
+     * @brief Gets the name of the folder of the output files of a page, in the output directory.
+     *
+     * @param page Index of the page, from 0.
+     *
+     * @return Name of the folder (e.g. "page_001" for the first page).
+     */
+    [[nodiscard]] static std::string getPageDirectoryName(const std::size_t page);
+
+    /**
+     * @brief Estimates the peak memory of a processing, from the dimensions of the image.
+     *
+     * The estimate is proportional to the number of pixels: the initial image in BGR, its copy being preprocessed and
+     * the single-channel working images of the preprocessing and detectors, plus the images waiting to be written
+     * when the images obtained during the processing are saved. The encoded image is added when it is in memory.
+     *
+     * @param dimensions Dimensions of the image.
+     * @param saveImages Save images obtained during the processing (false in low-memory mode).
+     * @param encodedBytes Size of the encoded image in memory, in bytes (0 when it is read from a file).
+     *
+     * @return Estimate of the peak memory, in bytes.
+     */
+    [[nodiscard]] static std::size_t
+    estimatePeakMemory(const ImageDimensions& dimensions, const bool saveImages, const std::size_t encodedBytes = 0);
+
+    /** Bytes per pixel of the images held by a processing: initial BGR (3), BGR copy (3), working images (4). */
+    static constexpr std::size_t cBytesPerPixel{10};
+
+    /** Bytes per pixel of the images waiting to be written when saved: 10 single-channel and 6 BGR images. */
+    static constexpr std::size_t cSavedImagesBytesPerPixel{28};
+
 private:
     /**
-     * @brief Receives the image for processing.
+     * @brief Enumeration of the processing stages.
+     */
+    enum class ProcessingStage
+    {
+        RECEPTION,
+        PREPROCESSING,
+        SEGMENTATION,
+        ROI_GENERATION,
+        SEGMENTATION_MAP_GENERATION
+    };
+
+    /** Processing stages, in execution order. */
+    static constexpr std::array cProcessingStages{ProcessingStage::RECEPTION,
+                                                  ProcessingStage::PREPROCESSING,
+                                                  ProcessingStage::SEGMENTATION,
+                                                  ProcessingStage::ROI_GENERATION,
+                                                  ProcessingStage::SEGMENTATION_MAP_GENERATION};
+
+    /**
+     * @brief Runs the processing of the image set in the image receiver, as a new job.
+     *
+     * @return True if the processing terminated successfully, otherwise false.
+     */
+    virtual bool runProcessingJob();
+
+    /**
+     * @brief Begins a new processing job, setting its context in the calling thread.
      *
-     * @param filePath Image file path.
+     * @param jobId Job ID to continue with another processing (e.g. the next page of a file), or 0 for a new job.
+     *
+     * @return Job ID.
+     */
+    virtual std::uint64_t beginProcessingJob(const std::uint64_t jobId = 0);
+
+    /**
+     * @brief Sets the context of a processing job (job ID and cancellation token) in the calling thread.
+     *
+     * @param jobId Job ID (0 to clear the context, when the thread leaves the job).
+     */
+    virtual void setJobContext(const std::uint64_t jobId);
+
+    /**
+     * @brief Ends the processing job, waiting for all its images to be written.
+     *
+     * @param success Processing stages terminated successfully.
+     *
+     * @return True if the processing terminated successfully, otherwise false.
+     */
+    virtual bool endProcessingJob(bool success);
+
+    /**
+     * @brief Finishes the processing job, once all its images are written.
+     *
+     * @param success Processing stages terminated successfully.
+     * @param imagesWritten All the images of the job were written successfully.
+     *
+     * @return True if the processing terminated successfully, otherwise false.
+     */
+    virtual bool finishProcessingJob(bool success, bool imagesWritten);
+
+    /**
+     * @brief Runs the processing stages of the image.
+     *
+     * @return True if the processing stages terminated successfully, otherwise false.
+     */
+    virtual bool runProcessingStages();
+
+    /**
+     * @brief Runs a processing stage of the image, unless the job is stopped by its cancellation token.
+     *
+     * @param stage Processing stage.
+     *
+     * @return True if the processing stage terminated successfully, otherwise false.
+     */
+    virtual bool runProcessingStage(const ProcessingStage stage);
+
+    /**
+     * @brief Logs the usage of the CPU by a processing stage, measured since the profiler was started.
+     *
+     * @param stage Name of the stage.
+     */
+    virtual void logStageUsage(const std::string& stage);
+
+    /**
+     * @brief Releases the buffer of raw pixels to its owner, if a release function was given, so no image of the
+     * processing references its pixels afterwards.
+     */
+    virtual void releaseRawImageBuffer();
+
+    /**
+     * @brief Gets the size of the tiles the image received is segmented by.
+     *
+     * @return Size of the tiles, in pixels (0 if the image is segmented as a whole).
+     */
+    [[nodiscard]] virtual int getImageTileSize();
+
+    /**
+     * @brief Gets the height of the bands the image received is preprocessed by.
+     *
+     * @return Height of the bands, in rows (0 if the image is preprocessed as a whole, by tiles, or received binary).
+     */
+    [[nodiscard]] virtual int getImageBandHeight();
+
+    /**
+     * @brief Finds the result of the image received in the result cache, restoring it if it is found.
+     *
+     * @return True if no result was found or the result found was restored, otherwise false.
+     */
+    virtual bool findCachedResult();
+
+    /**
+     * @brief Finds the result of a near-duplicate of the image received in the result cache, restoring it with its
+     * coordinates transformed to the image if it is found.
+     *
+     * @return True if no result was found or the result found was restored, otherwise false.
+     */
+    virtual bool findNearDuplicateResult();
+
+    /**
+     * @brief Restores a result of the cache as the result of the processing, writing its output files.
+     *
+     * @param cachedResult Result of the cache.
+     * @param cropRoiImages Flag to crop the images with ROI again from the image, instead of using the encoded images
+     * of the cache (e.g. for the result of a near-duplicate, whose images are crops of another image).
+     *
+     * @return True if the result was restored, otherwise false.
+     */
+    virtual bool restoreCachedResult(CachedResult& cachedResult, const bool cropRoiImages = false);
+
+    /**
+     * @brief Stores the result of the processing in the result cache.
+     */
+    virtual void storeCachedResult();
+
+    /**
+     * @brief Receives the image for processing.
      *
      * @return True if image is okay, otherwise false.
      */
-    virtual bool receiveImage(const std::string& filePath);
+    virtual bool receiveImage();
 
     /**
      * @brief Preprocesses the image.
@@ -165,6 +711,9 @@ private:
     /** Segmentation map. */
     std::shared_ptr<schematicSegmentation::SegmentationMap> mSegmentationMap;
 
+    /** Image writer (it can be shared with other managers). */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
 
@@ -174,10 +723,60 @@ private:
     /** Processed image. */
     computerVision::ImageMat mImageProcessed{};
 
+    /** Directory where the output files are written (empty for the working directory). */
+    std::string mOutputDirectory{};
+
     /** Log mode: verbose = true, silent = false. */
     bool mLogMode{false};
-    /** Flag to save images obtained during the processing in the working directory. */
+    /** Flag to save images obtained during the processing in the output directory. */
     bool mSaveImages{false};
+    /** Flag to write the output files (segmentation map and images with ROI). */
+    bool mWriteOutputFiles{true};
+    /** Flag to encode the images with ROI to memory. */
+    bool mEncodeRoiImages{false};
+    /** Status of the last processing. */
+    ProcessingStatus mLastStatus{ProcessingStatus::FAILED};
+    /** Preset of the processings. */
+    common::Preset mPreset{common::Preset::BALANCED};
+    /** Flag to assign deterministic IDs to the elements of the processings. */
+    bool mDeterministicIds{false};
+    /** Low-memory mode of the processings. */
+    bool mLowMemoryMode{false};
+    /** Height of the bands of the images preprocessed by bands (0 to preprocess them as a whole). */
+    int mBandHeight{0};
+    /** Binary image received (e.g. a PBM file), preprocessed without threshold (empty if the image is not binary). */
+    BinaryImage mImageBinary{};
+    /** Flag of the initial image borrowing the pixels of the buffer of raw pixels or of the file mapped in memory. */
+    bool mImageBorrowed{false};
+    /** Function that releases the buffer of raw pixels of the current processing (empty if none or released). */
+    std::function<void()> mReleaseRawImageBuffer{};
+
+    /** Tiled segmentation of the images larger than a tile (null if the images are segmented as a whole). */
+    std::shared_ptr<TiledSegmentation> mTiledSegmentation{};
+
+    /** Result cache of the processings. */
+    std::shared_ptr<ResultCache> mResultCache{};
+    /** Key of the image of the current processing in the result cache (empty without cache). */
+    std::string mCacheKey{};
+    /** Flag of the result of the current processing restored from the result cache. */
+    bool mResultFromCache{false};
+    /** Near-duplicate index of the results in the result cache. */
+    std::shared_ptr<NearDuplicateIndex> mNearDuplicateIndex{};
+    /** Fingerprint of the image of the current processing (only with near-duplicate index, if not in the cache). */
+    std::optional<ImageFingerprint> mImageFingerprint{};
+    /** Stage checkpoints of the processings. */
+    std::shared_ptr<StageCheckpoints> mStageCheckpoints{};
+    /** Hash of the image of the current processing (only with result cache or stage checkpoints). */
+    std::uint64_t mImageHash{0};
+
+    /** Cancellation token of the processings. */
+    std::shared_ptr<common::CancellationToken> mCancellationToken{};
+
+    /** Profiler of the processing stages. */
+    common::StageProfiler mStageProfiler{};
+
+    /** Counter to generate the job IDs of the processings. */
+    static inline std::atomic<std::uint64_t> mJobIdCounter{0};
 };
 
 } // namespace imageProcessing
@@ -3,6 +3,8 @@
  */
 
 #include "ImageReceiver.h"
+#include <memory>
+#include <utility>
 
 namespace circuitSegmentation {
 namespace imageProcessing {
@@ -16,15 +18,74 @@ ImageReceiver::ImageReceiver(const std::shared_ptr<computerVision::OpenCvWrapper
 
 bool ImageReceiver::receiveImage()
 {
+    // Pixels of the image received before
+    mImage = computerVision::ImageMat{};
+    mMappedFile.reset();
+    mImageBinary.reset(0, 0);
+
+    // Decode image from buffer
+    if (!mImageBuffer.empty()) {
+        mImage = mOpenCvWrapper->decodeImage(mImageBuffer);
+
+        // Check image
+        if (mOpenCvWrapper->isImageEmpty(mImage)) {
+            mLogger->logWarning("Image cannot be decoded from buffer with {} bytes", mImageBuffer.size());
+            return false;
+        }
+        mLogger->logInfo("Image buffer: {} bytes", mImageBuffer.size());
+
+        return true;
+    }
+
+    // Wrap image from buffer of raw pixels
+    if (mRawImageBuffer.mData != nullptr) {
+        mImage = mOpenCvWrapper->wrapImageBuffer(mRawImageBuffer.mData,
+                                                 mRawImageBuffer.mWidth,
+                                                 mRawImageBuffer.mHeight,
+                                                 mRawImageBuffer.mStride,
+                                                 mRawImageBuffer.mFormat);
+
+        // Check image
+        if (mOpenCvWrapper->isImageEmpty(mImage)) {
+            mLogger->logWarning("Image cannot be wrapped from buffer of raw pixels with {}x{} pixels and stride {}",
+                                mRawImageBuffer.mWidth,
+                                mRawImageBuffer.mHeight,
+                                mRawImageBuffer.mStride);
+            return false;
+        }
+        mLogger->logInfo("Image raw buffer: {}x{} pixels", mRawImageBuffer.mWidth, mRawImageBuffer.mHeight);
+
+        return true;
+    }
+
+    // Read page of image from file, alone
+    if (mImagePage != cNoPage) {
+        mImage = mOpenCvWrapper->readImagePage(mImageFilePath, mImagePage);
+
+        // Check image
+        if (mOpenCvWrapper->isImageEmpty(mImage)) {
+            mLogger->logWarning("Image cannot be open/read with path: {} (page {})", mImageFilePath, mImagePage + 1);
+            return false;
+        }
+        mLogger->logInfo("Image file path: {} (page {})", mImageFilePath, mImagePage + 1);
+
+        return true;
+    }
+
+    // Use the pixels of a raw image file in place
+    if (receiveMappedImage()) {
+        return true;
+    }
+
     // Read image from file
     mImage = mOpenCvWrapper->readImage(mImageFilePath);
 
     // Check image
     if (mOpenCvWrapper->isImageEmpty(mImage)) {
-        mLogger->logWarning("Image cannot be open/read with path: " + mImageFilePath);
+        mLogger->logWarning("Image cannot be open/read with path: {}", mImageFilePath);
         return false;
     }
-    mLogger->logInfo("Image file path: " + mImageFilePath);
+    mLogger->logInfo("Image file path: {}", mImageFilePath);
 
     return true;
 }
@@ -34,9 +95,17 @@ bool ImageReceiver::receiveImage()
     return mImage;
 }
 
+BinaryImage ImageReceiver::getImageBinary() const
+{
+    return mImageBinary;
+}
+
 void ImageReceiver::setImageFilePath(const std::string& filePath)
 {
     mImageFilePath = filePath;
+    mImagePage = cNoPage;
+    mImageBuffer.clear();
+    mRawImageBuffer = RawImageBuffer{};
 }
 
 [[nodiscard]] std::string ImageReceiver::getImageFilePath() const
@@ -44,5 +113,145 @@ void ImageReceiver::setImageFilePath(const std::string& filePath)
     return mImageFilePath;
 }
 
+void ImageReceiver::setImagePage(const int page)
+{
+    mImagePage = page;
+}
+
+int ImageReceiver::getImagePage() const
+{
+    return mImagePage;
+}
+
+std::size_t ImageReceiver::getNumImagePages() const
+{
+    // Pages counted from the header, without OpenCV reading the file
+    ImageInfo info{};
+    if (!mImageFilePath.empty() && ImageHeader::readFileInfo(mImageFilePath, info)) {
+        return info.mNumPages;
+    }
+
+    return mOpenCvWrapper->countImagePages(mImageFilePath);
+}
+
+bool ImageReceiver::probeImage(ImageInfo& info) const
+{
+    if (!mImageBuffer.empty()) {
+        return ImageHeader::readBufferInfo(mImageBuffer, info);
+    }
+
+    if (mRawImageBuffer.mData != nullptr) {
+        if (mRawImageBuffer.mWidth <= 0 || mRawImageBuffer.mHeight <= 0) {
+            return false;
+        }
+
+        info = ImageInfo{};
+        info.mDimensions = ImageDimensions{.mWidth = mRawImageBuffer.mWidth, .mHeight = mRawImageBuffer.mHeight};
+        info.mDepth = 8;
+        switch (mRawImageBuffer.mFormat) {
+        case computerVision::OpenCvWrapper::PixelFormat::GRAY:
+            info.mChannels = 1;
+            break;
+        case computerVision::OpenCvWrapper::PixelFormat::BGRA:
+        case computerVision::OpenCvWrapper::PixelFormat::RGBA:
+            info.mChannels = 4;
+            break;
+        case computerVision::OpenCvWrapper::PixelFormat::BGR:
+        case computerVision::OpenCvWrapper::PixelFormat::RGB:
+            info.mChannels = 3;
+            break;
+        }
+
+        return true;
+    }
+
+    return !mImageFilePath.empty() && ImageHeader::readFileInfo(mImageFilePath, info);
+}
+
+void ImageReceiver::setImageBuffer(std::vector<unsigned char> buffer)
+{
+    mImageBuffer = std::move(buffer);
+    mImageFilePath.clear();
+    mRawImageBuffer = RawImageBuffer{};
+}
+
+const std::vector<unsigned char>& ImageReceiver::getImageBuffer() const
+{
+    return mImageBuffer;
+}
+
+void ImageReceiver::setRawImageBuffer(const RawImageBuffer& buffer)
+{
+    mRawImageBuffer = buffer;
+    mImageFilePath.clear();
+    mImageBuffer.clear();
+}
+
+RawImageBuffer ImageReceiver::getRawImageBuffer() const
+{
+    return mRawImageBuffer;
+}
+
+bool ImageReceiver::isImageBorrowed() const
+{
+    return (mRawImageBuffer.mData != nullptr
+            && mRawImageBuffer.mFormat == computerVision::OpenCvWrapper::PixelFormat::BGR)
+           || mMappedFile != nullptr;
+}
+
+void ImageReceiver::releaseImage()
+{
+    mImage = computerVision::ImageMat{};
+    mRawImageBuffer = RawImageBuffer{};
+    mMappedFile.reset();
+    mImageBinary.reset(0, 0);
+
+    // Free the memory of the buffer, which clear alone keeps
+    std::vector<unsigned char>{}.swap(mImageBuffer);
+}
+
+bool ImageReceiver::receiveMappedImage()
+{
+    auto mappedFile{std::make_unique<MappedImageFile>(mImageFilePath)};
+    if (!mappedFile->isMapped()) {
+        return false;
+    }
+    const auto& layout{mappedFile->getLayout()};
+
+    if (layout.mBinary) {
+        // Binary image for the preprocessing, and black lines on a white background for the other stages
+        mImageBinary.reset(layout.mWidth, layout.mHeight);
+        mImageBinary.setPackedRows(mappedFile->getPixels(), layout.mStride);
+        mImage = mImageBinary.unpack(mOpenCvWrapper, 0);
+    } else if (layout.mFormat == computerVision::OpenCvWrapper::PixelFormat::GRAY) {
+        mImage = mOpenCvWrapper->viewImageBuffer(mappedFile->getPixels(),
+                                                 layout.mWidth,
+                                                 layout.mHeight,
+                                                 layout.mStride,
+                                                 computerVision::OpenCvWrapper::cImageTypeGray);
+    } else {
+        mImage = mOpenCvWrapper->wrapImageBuffer(
+            mappedFile->getPixels(), layout.mWidth, layout.mHeight, layout.mStride, layout.mFormat);
+    }
+
+    // Check image
+    if (mOpenCvWrapper->isImageEmpty(mImage)) {
+        mLogger->logWarning("Image cannot be used in place with path: {}", mImageFilePath);
+        mImageBinary.reset(0, 0);
+        return false;
+    }
+    mLogger->logInfo(
+        "Image file path: {} (mapped in memory, {}x{} pixels)", mImageFilePath, layout.mWidth, layout.mHeight);
+
+    // Only the pixels used in place keep the file mapped
+    if (!layout.mBinary
+        && (layout.mFormat == computerVision::OpenCvWrapper::PixelFormat::GRAY
+            || layout.mFormat == computerVision::OpenCvWrapper::PixelFormat::BGR)) {
+        mMappedFile = std::move(mappedFile);
+    }
+
+    return true;
+}
+
 } // namespace imageProcessing
 } // namespace circuitSegmentation
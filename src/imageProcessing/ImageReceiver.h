@@ -4,20 +4,45 @@
 
 #pragma once
 
+#include "BinaryImage.h"
+#include "ImageHeader.h"
+#include "MappedImageFile.h"
 #include "computerVision/OpenCvWrapper.h"
 #include "logging/Logger.h"
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace circuitSegmentation {
 namespace imageProcessing {
 
+/**
+ * @brief Buffer of raw pixels for processing, owned by the caller.
+ */
+struct RawImageBuffer
+{
+    /** Pixels, row by row. */
+    const unsigned char* mData{nullptr};
+    /** Width of the image, in pixels. */
+    int mWidth{0};
+    /** Height of the image, in pixels. */
+    int mHeight{0};
+    /** Size of each row, in bytes (it can include padding). */
+    std::size_t mStride{0};
+    /** Format of the pixels. */
+    computerVision::OpenCvWrapper::PixelFormat mFormat{computerVision::OpenCvWrapper::PixelFormat::BGR};
+};
+
 /**
  * @brief Image receiver for processing.
  */
 class ImageReceiver
 {
 public:
+    /** Page of the image file when it is read as a single image (the first page of a multi-page file). */
+    static constexpr int cNoPage{-1};
+
     /**
      * @brief Constructor.
      *
@@ -35,6 +60,11 @@ public:
     /**
      * @brief Receives the image for processing.
      *
+     * The image is decoded from the buffer in memory or wrapped from the buffer of raw pixels, if one of them was set,
+     * otherwise it is read from the file path. A file in a raw format (binary PGM, PBM or PPM, or a raw image file,
+     * see @ref MappedImageFile) is mapped in memory and its pixels are used in place, without decoding, and a PBM file
+     * is also received as a binary image (see @ref getImageBinary).
+     *
      * @return True if image is okay, otherwise false when the image cannot be read because of missing file, improper
      * permissions, unsupported or invalid format.
      */
@@ -47,6 +77,14 @@ public:
      */
     [[nodiscard]] virtual computerVision::ImageMat getImageReceived() const;
 
+    /**
+     * @brief Gets the binary image received for processing, from a PBM file.
+     *
+     * @return Binary image, with the black pixels in the foreground, or an empty image if the image received is not
+     * binary.
+     */
+    [[nodiscard]] virtual BinaryImage getImageBinary() const;
+
     /**
      * @brief Sets the image file path for processing.
      *
@@ -61,11 +99,123 @@ public:
      */
     [[nodiscard]] virtual std::string getImageFilePath() const;
 
+    /**
+     * @brief Sets the page of the image file for processing (e.g. a sheet of a multi-page TIFF file), so only that
+     * page is decoded when the image is received.
+     *
+     * The page is reset by @ref setImageFilePath.
+     *
+     * @param page Index of the page, from 0, or @ref cNoPage to read the file as a single image.
+     */
+    virtual void setImagePage(const int page);
+
+    /**
+     * @brief Gets the page of the image file for processing.
+     *
+     * @return Index of the page, from 0, or @ref cNoPage if the file is read as a single image.
+     */
+    [[nodiscard]] virtual int getImagePage() const;
+
+    /**
+     * @brief Counts the pages of the image file for processing, without decoding them.
+     *
+     * The pages are counted from the header of the file (see @ref probeImage), otherwise by OpenCV when its format is
+     * not supported by the header reader.
+     *
+     * @return Number of pages (1 for the single-page formats), or 0 if the file cannot be read.
+     */
+    [[nodiscard]] virtual std::size_t getNumImagePages() const;
+
+    /**
+     * @brief Probes the image for processing, reading only the header of its source (file or buffer), without decoding
+     * it, so the memory of a job can be sized before the image is received.
+     *
+     * The formats of the encoded images supported are those of @ref ImageHeader (PNG, JPEG, BMP, PNM and TIFF). The
+     * information of a buffer of raw pixels is that of the buffer (8 bits per channel).
+     *
+     * @param info Information of the image (of the first page of a multi-page file).
+     *
+     * @return True if the information was read, otherwise false (e.g. no source, or a format not supported).
+     */
+    virtual bool probeImage(ImageInfo& info) const;
+
+    /**
+     * @brief Sets the buffer with the encoded image for processing, replacing the other sources of the image.
+     *
+     * @param buffer Buffer with the encoded image (e.g. the content of a PNG file).
+     */
+    virtual void setImageBuffer(std::vector<unsigned char> buffer);
+
+    /**
+     * @brief Gets the buffer with the encoded image for processing.
+     *
+     * @return Buffer with the encoded image, empty if the image is read from the file path.
+     */
+    [[nodiscard]] virtual const std::vector<unsigned char>& getImageBuffer() const;
+
+    /**
+     * @brief Sets the buffer of raw pixels for processing, replacing the other sources of the image.
+     *
+     * The pixels in BGR format are not copied, so the buffer must be kept valid until the processing terminates.
+     *
+     * @param buffer Buffer of raw pixels.
+     */
+    virtual void setRawImageBuffer(const RawImageBuffer& buffer);
+
+    /**
+     * @brief Gets the buffer of raw pixels for processing.
+     *
+     * @return Buffer of raw pixels, with null data if the image is not received from raw pixels.
+     */
+    [[nodiscard]] virtual RawImageBuffer getRawImageBuffer() const;
+
+    /**
+     * @brief Checks if the image received borrows the pixels of the buffer of raw pixels, without copying them.
+     *
+     * Only the pixels in BGR format are wrapped without conversion, so the buffer must be kept valid while the image
+     * is used. The pixels in other formats are converted to a new image when received. The image of a file mapped in
+     * memory also borrows its pixels (in BGR or grayscale), so the image receiver must not be released while the image
+     * is used.
+     *
+     * @return True if the image borrows the pixels of the buffer of raw pixels or of the file mapped in memory,
+     * otherwise false.
+     */
+    [[nodiscard]] virtual bool isImageBorrowed() const;
+
+    /**
+     * @brief Releases the image received and the buffers of the image, so their memory is freed.
+     *
+     * The image is still valid for the users that hold it (e.g. the image processing manager), unless it borrows the
+     * pixels of the file mapped in memory, which is unmapped. The buffer of raw pixels is only forgotten, since it is
+     * owned by the caller.
+     */
+    virtual void releaseImage();
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Receives the image from the file mapped in memory, if its format is raw.
+     *
+     * @return True if the image was received, otherwise false when the file must be decoded.
+     */
+    virtual bool receiveMappedImage();
+
 private:
     /** Image file path. */
     std::string mImageFilePath{};
+    /** Page of the image file. */
+    int mImagePage{cNoPage};
+    /** Buffer with the encoded image. */
+    std::vector<unsigned char> mImageBuffer{};
+    /** Buffer of raw pixels. */
+    RawImageBuffer mRawImageBuffer{};
     /** Image for processing. */
     computerVision::ImageMat mImage{};
+    /** File of the image mapped in memory, while the image borrows its pixels (null if none). */
+    std::unique_ptr<MappedImageFile> mMappedFile{};
+    /** Binary image for processing (empty if the image is not binary). */
+    BinaryImage mImageBinary{};
 
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
@@ -3,6 +3,9 @@
  */
 
 #include "ImageSegmentation.h"
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace circuitSegmentation {
 namespace imageProcessing {
@@ -29,6 +32,48 @@ bool ImageSegmentation::segmentImage(computerVision::ImageMat imageInitial, comp
 {
     mLogger->logInfo("Starting image segmentation");
 
+    // Elements detected before with the same image and parameters (the labels are always detected)
+    std::string checkpointKey{};
+    if (mStageCheckpoints) {
+        checkpointKey = StageCheckpoints::makeKey(
+            CheckpointStage::DETECTION, mImageHash, StageCheckpoints::hashDetectionParameters(mPreset, mBandHeight));
+    }
+    if (checkpointKey.empty() || !restoreElements(checkpointKey)) {
+        if (!detectElements(imageInitial, imagePreprocessed)) {
+            return false;
+        }
+
+        if (!checkpointKey.empty()) {
+            mStageCheckpoints->storeElements(checkpointKey,
+                                             mSchematicSegmentation->getComponents(),
+                                             mSchematicSegmentation->getConnections(),
+                                             mSchematicSegmentation->getNodes());
+        }
+    }
+
+    // Detect labels
+    if (mLabelDetection->detectLabels(imageInitial,
+                                      imagePreprocessed,
+                                      mSchematicSegmentation->getComponents(),
+                                      mSchematicSegmentation->getConnections(),
+                                      mSaveImages)) {
+        // Associate labels
+        mSchematicSegmentation->associateLabels(
+            imageInitial, imagePreprocessed, mLabelDetection->getDetectedLabels(), mSaveImages);
+    }
+
+    // Assign deterministic IDs, once all the elements and their references are known
+    if (mDeterministicIds) {
+        mSchematicSegmentation->assignDeterministicIds(mOpenCvWrapper->getImageWidth(imageInitial),
+                                                       mOpenCvWrapper->getImageHeight(imageInitial));
+    }
+
+    return true;
+}
+
+bool ImageSegmentation::detectElements(computerVision::ImageMat& imageInitial,
+                                       computerVision::ImageMat& imagePreprocessed)
+{
     // Detect connections
     if (!mConnectionDetection->detectConnections(imageInitial, imagePreprocessed, mSaveImages)) {
         return false;
@@ -61,20 +106,20 @@ bool ImageSegmentation::segmentImage(computerVision::ImageMat imageInitial, comp
                                                        mSaveImages);
 
     // Update list of detected components
-    if (!mSchematicSegmentation->updateDetectedComponents()) {
+    return mSchematicSegmentation->updateDetectedComponents();
+}
+
+bool ImageSegmentation::restoreElements(const std::string& key)
+{
+    std::vector<circuit::Component> components{};
+    std::vector<circuit::Connection> connections{};
+    std::vector<circuit::Node> nodes{};
+    if (!mStageCheckpoints->loadElements(key, components, connections, nodes)) {
         return false;
     }
 
-    // Detect labels
-    if (mLabelDetection->detectLabels(imageInitial,
-                                      imagePreprocessed,
-                                      mSchematicSegmentation->getComponents(),
-                                      mSchematicSegmentation->getConnections(),
-                                      mSaveImages)) {
-        // Associate labels
-        mSchematicSegmentation->associateLabels(
-            imageInitial, imagePreprocessed, mLabelDetection->getDetectedLabels(), mSaveImages);
-    }
+    mSchematicSegmentation->setElements(std::move(components), std::move(connections), std::move(nodes));
+    mLogger->logInfo("Components, connections and nodes restored from checkpoint {}", key);
 
     return true;
 }
@@ -89,5 +134,38 @@ bool ImageSegmentation::getSaveImages() const
     return mSaveImages;
 }
 
+void ImageSegmentation::setPreset(const common::Preset& preset)
+{
+    mPreset = preset;
+
+    mComponentDetection->setPreset(mPreset);
+    mConnectionDetection->setPreset(mPreset);
+    mLabelDetection->setPreset(mPreset);
+}
+
+common::Preset ImageSegmentation::getPreset() const
+{
+    return mPreset;
+}
+
+void ImageSegmentation::setDeterministicIds(const bool& deterministicIds)
+{
+    mDeterministicIds = deterministicIds;
+}
+
+bool ImageSegmentation::getDeterministicIds() const
+{
+    return mDeterministicIds;
+}
+
+void ImageSegmentation::setCheckpoints(const std::shared_ptr<StageCheckpoints>& stageCheckpoints,
+                                       const std::uint64_t imageHash,
+                                       const int bandHeight)
+{
+    mStageCheckpoints = stageCheckpoints;
+    mImageHash = imageHash;
+    mBandHeight = bandHeight;
+}
+
 } // namespace imageProcessing
 } // namespace circuitSegmentation
@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include "StageCheckpoints.h"
+#include "common/Preset.h"
 #include "computerVision/OpenCvWrapper.h"
 #include "logging/Logger.h"
 #include "schematicSegmentation/ComponentDetection.h"
 #include "schematicSegmentation/ConnectionDetection.h"
 #include "schematicSegmentation/LabelDetection.h"
 #include "schematicSegmentation/SchematicSegmentation.h"
+#include <cstdint>
 #include <memory>
 
 namespace circuitSegmentation {
@@ -49,6 +52,10 @@ public:
     /**
      * @brief Segments the image.
      *
+     * With checkpoints (see @ref setCheckpoints), the components, connections and nodes detected before with the same
+     * image and parameters are restored from their checkpoint, so only the labels are detected. Otherwise, they are
+     * detected and checkpointed.
+     *
      * @param imageInitial Initial image without preprocessing.
      * @param imagePreprocessed Image preprocessed for segmentation.
      *
@@ -70,6 +77,69 @@ public:
      */
     [[nodiscard]] virtual bool getSaveImages() const;
 
+    /**
+     * @brief Sets the preset of the detections (components, connections and labels).
+     *
+     * @param preset Preset.
+     */
+    virtual void setPreset(const common::Preset& preset);
+
+    /**
+     * @brief Gets the preset of the detections.
+     *
+     * @return The preset.
+     */
+    [[nodiscard]] virtual common::Preset getPreset() const;
+
+    /**
+     * @brief Sets the flag to assign deterministic IDs to the elements segmented, instead of random IDs.
+     *
+     * See @ref schematicSegmentation::SchematicSegmentation::assignDeterministicIds.
+     *
+     * @param deterministicIds Assign deterministic IDs.
+     */
+    virtual void setDeterministicIds(const bool& deterministicIds);
+
+    /**
+     * @brief Gets the flag to assign deterministic IDs to the elements segmented.
+     *
+     * @return The flag to assign deterministic IDs.
+     */
+    [[nodiscard]] virtual bool getDeterministicIds() const;
+
+    /**
+     * @brief Sets the checkpoints of the next segmentation, with the image segmented.
+     *
+     * @param stageCheckpoints Stage checkpoints (null for none).
+     * @param imageHash Hash of the decoded image (see @ref computerVision::OpenCvWrapper::hashImage).
+     * @param bandHeight Height of the bands the image was preprocessed by, in rows (0 if preprocessed as a whole).
+     */
+    virtual void setCheckpoints(const std::shared_ptr<StageCheckpoints>& stageCheckpoints,
+                                const std::uint64_t imageHash,
+                                const int bandHeight = 0);
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Detects the components, connections and nodes of the circuit, before the labels.
+     *
+     * @param imageInitial Initial image without preprocessing.
+     * @param imagePreprocessed Image preprocessed for segmentation.
+     *
+     * @return True if the elements were detected successfully, otherwise false.
+     */
+    virtual bool detectElements(computerVision::ImageMat& imageInitial, computerVision::ImageMat& imagePreprocessed);
+
+    /**
+     * @brief Restores the components, connections and nodes of the circuit from their checkpoint.
+     *
+     * @param key Key of the checkpoint.
+     *
+     * @return True if the elements were restored, otherwise false.
+     */
+    virtual bool restoreElements(const std::string& key);
+
 private:
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
@@ -91,6 +161,18 @@ private:
 
     /** Flag to save images obtained during the processing in the working directory. */
     bool mSaveImages{false};
+
+    /** Flag to assign deterministic IDs to the elements segmented. */
+    bool mDeterministicIds{false};
+
+    /** Preset of the detections. */
+    common::Preset mPreset{common::Preset::BALANCED};
+    /** Stage checkpoints of the next segmentation. */
+    std::shared_ptr<StageCheckpoints> mStageCheckpoints{};
+    /** Hash of the image of the next segmentation. */
+    std::uint64_t mImageHash{0};
+    /** Height of the bands the image of the next segmentation was preprocessed by (0 if preprocessed as a whole). */
+    int mBandHeight{0};
 };
 
 } // namespace imageProcessing
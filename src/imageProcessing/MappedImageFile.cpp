@@ -0,0 +1,252 @@
+/**
+ * @file
+ */
+
+#include "MappedImageFile.h"
+#include <cstring>
+
+#ifdef __linux__
+#define MEMORY_MAPPING_SUPPORTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+namespace {
+
+/**
+ * @brief Checks if a character of a PNM header is whitespace.
+ *
+ * @param character Character.
+ *
+ * @return True if the character is whitespace, otherwise false.
+ */
+bool isPnmWhitespace(const unsigned char character)
+{
+    return character == ' ' || character == '\t' || character == '\n' || character == '\v' || character == '\f'
+           || character == '\r';
+}
+
+/**
+ * @brief Reads an unsigned integer of a PNM header, skipping the whitespace and comments before it.
+ *
+ * @param data Contents of the file.
+ * @param size Size of the file, in bytes.
+ * @param position Position in the file, after the value when read.
+ * @param value Value read.
+ *
+ * @return True if the value was read, otherwise false.
+ */
+bool readPnmValue(const unsigned char* data, const std::size_t size, std::size_t& position, long long& value)
+{
+    // Whitespace and comments (until the end of the line)
+    while (position < size) {
+        if (data[position] == '#') {
+            while (position < size && data[position] != '\n' && data[position] != '\r') {
+                ++position;
+            }
+        } else if (isPnmWhitespace(data[position])) {
+            ++position;
+        } else {
+            break;
+        }
+    }
+
+    // Digits, limited so the value does not overflow
+    value = 0;
+    const auto start{position};
+    while (position < size && data[position] >= '0' && data[position] <= '9' && position - start < 12) {
+        value = value * 10 + (data[position] - '0');
+        ++position;
+    }
+
+    return position > start;
+}
+
+/**
+ * @brief Gets the number of channels of a format of pixels.
+ *
+ * @param format Format of the pixels.
+ *
+ * @return Number of channels.
+ */
+std::size_t getNumChannels(const computerVision::OpenCvWrapper::PixelFormat format)
+{
+    switch (format) {
+    case computerVision::OpenCvWrapper::PixelFormat::GRAY:
+        return 1;
+    case computerVision::OpenCvWrapper::PixelFormat::BGRA:
+    case computerVision::OpenCvWrapper::PixelFormat::RGBA:
+        return 4;
+    case computerVision::OpenCvWrapper::PixelFormat::BGR:
+    case computerVision::OpenCvWrapper::PixelFormat::RGB:
+        break;
+    }
+
+    return 3;
+}
+
+} // namespace
+
+MappedImageFile::MappedImageFile(const std::string& filePath)
+{
+#ifdef MEMORY_MAPPING_SUPPORTED
+    const auto fd{::open(filePath.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd < 0) {
+        return;
+    }
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+        const auto size{static_cast<std::size_t>(fileStat.st_size)};
+        auto* mapping{mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+        if (mapping != MAP_FAILED) {
+            // Only the files whose pixels are used in place are kept mapped
+            if (readLayout(static_cast<const unsigned char*>(mapping), size, mLayout)) {
+                mData = static_cast<const unsigned char*>(mapping);
+                mSize = size;
+
+                // The pixels are read in order by the preprocessing
+                madvise(mapping, size, MADV_SEQUENTIAL);
+            } else {
+                munmap(mapping, size);
+            }
+        }
+    }
+    ::close(fd);
+#else
+    static_cast<void>(filePath);
+#endif
+}
+
+MappedImageFile::~MappedImageFile()
+{
+#ifdef MEMORY_MAPPING_SUPPORTED
+    if (mData != nullptr) {
+        munmap(const_cast<unsigned char*>(mData), mSize);
+    }
+#endif
+}
+
+bool MappedImageFile::isMapped() const
+{
+    return mData != nullptr;
+}
+
+const unsigned char* MappedImageFile::getPixels() const
+{
+    return mData != nullptr ? mData + mLayout.mOffset : nullptr;
+}
+
+const MappedImageLayout& MappedImageFile::getLayout() const
+{
+    return mLayout;
+}
+
+bool MappedImageFile::readLayout(const unsigned char* data, const std::size_t size, MappedImageLayout& layout)
+{
+    if (data == nullptr || size < 2) {
+        return false;
+    }
+
+    // Binary PNM
+    if (data[0] == 'P' && (data[1] == '4' || data[1] == '5' || data[1] == '6')) {
+        return readPnmLayout(data, size, layout);
+    }
+
+    // Raw image file
+    return readRawLayout(data, size, layout);
+}
+
+bool MappedImageFile::readPnmLayout(const unsigned char* data, const std::size_t size, MappedImageLayout& layout)
+{
+    const auto binary{data[1] == '4'};
+    std::size_t position{2};
+
+    long long width{0};
+    long long height{0};
+    if (!readPnmValue(data, size, position, width) || !readPnmValue(data, size, position, height)) {
+        return false;
+    }
+
+    // Maximum value of the pixels, except for PBM (8 bits per channel only)
+    long long maxValue{1};
+    if (!binary && (!readPnmValue(data, size, position, maxValue) || maxValue <= 0 || maxValue > 255)) {
+        return false;
+    }
+
+    // Dimensions, and a single whitespace before the pixels
+    if (width <= 0 || height <= 0 || width > cMaxDimension || height > cMaxDimension || position >= size
+        || !isPnmWhitespace(data[position])) {
+        return false;
+    }
+    ++position;
+
+    MappedImageLayout pnmLayout{};
+    pnmLayout.mOffset = position;
+    pnmLayout.mWidth = static_cast<int>(width);
+    pnmLayout.mHeight = static_cast<int>(height);
+    pnmLayout.mBinary = binary;
+    if (binary) {
+        pnmLayout.mStride = (static_cast<std::size_t>(width) + 7) / 8;
+    } else if (data[1] == '5') {
+        pnmLayout.mStride = static_cast<std::size_t>(width);
+        pnmLayout.mFormat = computerVision::OpenCvWrapper::PixelFormat::GRAY;
+    } else {
+        pnmLayout.mStride = static_cast<std::size_t>(width) * 3;
+        pnmLayout.mFormat = computerVision::OpenCvWrapper::PixelFormat::RGB;
+    }
+
+    // All the pixels in the file
+    if (size - position < pnmLayout.mStride * static_cast<std::size_t>(height)) {
+        return false;
+    }
+
+    layout = pnmLayout;
+
+    return true;
+}
+
+bool MappedImageFile::readRawLayout(const unsigned char* data, const std::size_t size, MappedImageLayout& layout)
+{
+    if (size < cRawPixelsOffset) {
+        return false;
+    }
+
+    RawImageFileHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.mMagic != cRawMagic || header.mVersion != cRawVersion
+        || header.mFormat > static_cast<std::uint32_t>(computerVision::OpenCvWrapper::PixelFormat::RGBA)
+        || header.mWidth <= 0 || header.mHeight <= 0 || header.mWidth > cMaxDimension
+        || header.mHeight > cMaxDimension) {
+        return false;
+    }
+
+    const auto format{static_cast<computerVision::OpenCvWrapper::PixelFormat>(header.mFormat)};
+    const auto rowSize{static_cast<std::size_t>(header.mWidth) * getNumChannels(format)};
+    if (header.mStride < rowSize || header.mStride > size) {
+        return false;
+    }
+
+    // All the pixels in the file (the last row without its padding)
+    const auto stride{static_cast<std::size_t>(header.mStride)};
+    if (size - cRawPixelsOffset < stride * static_cast<std::size_t>(header.mHeight - 1) + rowSize) {
+        return false;
+    }
+
+    layout = MappedImageLayout{.mOffset = cRawPixelsOffset,
+                               .mWidth = header.mWidth,
+                               .mHeight = header.mHeight,
+                               .mStride = stride,
+                               .mFormat = format,
+                               .mBinary = false};
+
+    return true;
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,162 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "computerVision/OpenCvWrapper.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Layout of the pixels of an image file that can be used in place, without decoding.
+ */
+struct MappedImageLayout
+{
+    /** Offset of the first pixel in the file, in bytes. */
+    std::size_t mOffset{0};
+    /** Width of the image, in pixels. */
+    int mWidth{0};
+    /** Height of the image, in pixels. */
+    int mHeight{0};
+    /** Size of each row, in bytes (it can include padding). */
+    std::size_t mStride{0};
+    /** Format of the pixels (ignored for a binary image). */
+    computerVision::OpenCvWrapper::PixelFormat mFormat{computerVision::OpenCvWrapper::PixelFormat::GRAY};
+    /** Flag of a binary image, with its pixels packed (a bit for each pixel, set for black, as in PBM). */
+    bool mBinary{false};
+};
+
+/**
+ * @brief Header of a raw image file, followed by the pixels at @ref MappedImageFile::cRawPixelsOffset.
+ *
+ * The fields are in the byte order of the host, as the slots of the shared-memory ring, since the files are written
+ * by a local pipeline (e.g. a scanner).
+ */
+struct RawImageFileHeader
+{
+    /** Magic number (@ref MappedImageFile::cRawMagic). */
+    std::uint32_t mMagic;
+    /** Version of the layout (@ref MappedImageFile::cRawVersion). */
+    std::uint32_t mVersion;
+    /** Format of the pixels (@ref computerVision::OpenCvWrapper::PixelFormat). */
+    std::uint32_t mFormat;
+    /** Width of the image, in pixels. */
+    std::int32_t mWidth;
+    /** Height of the image, in pixels. */
+    std::int32_t mHeight;
+    /** Reserved. */
+    std::uint32_t mReserved;
+    /** Size of each row, in bytes. */
+    std::uint64_t mStride;
+};
+
+/**
+ * @brief Image file mapped in memory while the object exists, whose pixels are used in place when their format is
+ * raw (Linux only).
+ *
+ * The formats supported are binary PGM (8 bits per pixel), binary PBM, binary PPM (8 bits per channel) and the raw
+ * image file (see @ref RawImageFileHeader). The other files (e.g. PNG or JPEG) are not kept mapped.
+ *
+ * The file must not be truncated while it is mapped.
+ */
+class MappedImageFile
+{
+public:
+    /** Magic number of a raw image file ("CRAW" in little endian). */
+    static constexpr std::uint32_t cRawMagic{0x57415243};
+    /** Version of the layout of a raw image file. */
+    static constexpr std::uint32_t cRawVersion{1};
+    /** Offset of the pixels of a raw image file, in bytes (the header is padded for the alignment of the rows). */
+    static constexpr std::size_t cRawPixelsOffset{64};
+
+    /**
+     * @brief Constructor, mapping the file if its format is supported.
+     *
+     * @param filePath File path of the image.
+     */
+    explicit MappedImageFile(const std::string& filePath);
+
+    /**
+     * @brief Destructor, unmapping the file.
+     */
+    virtual ~MappedImageFile();
+
+    MappedImageFile(const MappedImageFile&) = delete;
+    MappedImageFile& operator=(const MappedImageFile&) = delete;
+
+    /**
+     * @brief Checks if the file is mapped, so its pixels can be used in place.
+     *
+     * @return True if the file is mapped, otherwise false when it cannot be mapped or its format is not supported.
+     */
+    [[nodiscard]] virtual bool isMapped() const;
+
+    /**
+     * @brief Gets the pixels of the image.
+     *
+     * @return First pixel of the image, in the file (null if the file is not mapped).
+     */
+    [[nodiscard]] virtual const unsigned char* getPixels() const;
+
+    /**
+     * @brief Gets the layout of the pixels of the image.
+     *
+     * @return Layout of the pixels.
+     */
+    [[nodiscard]] virtual const MappedImageLayout& getLayout() const;
+
+    /**
+     * @brief Reads the layout of the pixels of an image file from its header.
+     *
+     * @param data Contents of the file.
+     * @param size Size of the file, in bytes.
+     * @param layout Layout of the pixels.
+     *
+     * @return True if the format is supported and the file has all the pixels, otherwise false.
+     */
+    static bool readLayout(const unsigned char* data, const std::size_t size, MappedImageLayout& layout);
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Reads the layout of the pixels from a binary PNM header (PBM, PGM or PPM).
+     *
+     * @param data Contents of the file.
+     * @param size Size of the file, in bytes.
+     * @param layout Layout of the pixels.
+     *
+     * @return True if the layout was read, otherwise false (e.g. more than 8 bits per channel).
+     */
+    static bool readPnmLayout(const unsigned char* data, const std::size_t size, MappedImageLayout& layout);
+
+    /**
+     * @brief Reads the layout of the pixels from a raw image file header.
+     *
+     * @param data Contents of the file.
+     * @param size Size of the file, in bytes.
+     * @param layout Layout of the pixels.
+     *
+     * @return True if the layout was read, otherwise false.
+     */
+    static bool readRawLayout(const unsigned char* data, const std::size_t size, MappedImageLayout& layout);
+
+private:
+    /** Maximum width and height of an image, in pixels. */
+    static constexpr long long cMaxDimension{1 << 30};
+
+    /** Contents of the file. */
+    const unsigned char* mData{nullptr};
+    /** Size of the file, in bytes. */
+    std::size_t mSize{0};
+    /** Layout of the pixels. */
+    MappedImageLayout mLayout{};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
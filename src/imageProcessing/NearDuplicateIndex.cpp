@@ -0,0 +1,446 @@
+/**
+ * @file
+ */
+
+#include "NearDuplicateIndex.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+namespace {
+
+/** Number of pixels of a thumbnail. */
+constexpr int cThumbnailPixels{ImageFingerprint::cThumbnailSize * ImageFingerprint::cThumbnailSize};
+/** Number of cells of the perceptual hash in each axis. */
+constexpr int cHashCells{8};
+/** Gray levels below the mean of a thumbnail for a pixel to be foreground, so the noise of a blank page is not. */
+constexpr int cForegroundMargin{8};
+/** Scales searched when aligning the thumbnails. */
+constexpr std::array<double, 5> cAlignmentScales{0.94, 0.97, 1.0, 1.03, 1.06};
+/** Maximum shift searched when aligning the thumbnails, in pixels of the thumbnails. */
+constexpr int cAlignmentMaxShift{3};
+
+/**
+ * @brief Gets the part of a key of the result cache after the hash of the image (preset and options).
+ *
+ * @param key Key.
+ *
+ * @return Variant of the key.
+ */
+std::string getKeyVariant(const std::string& key)
+{
+    const auto separator{key.find('_')};
+    return separator == std::string::npos ? std::string{} : key.substr(separator);
+}
+
+/**
+ * @brief Dilates the foreground of a thumbnail by a pixel (4-connectivity).
+ *
+ * @param thumbnail Thumbnail.
+ *
+ * @return Thumbnail dilated.
+ */
+std::bitset<cThumbnailPixels> dilate(const std::bitset<cThumbnailPixels>& thumbnail)
+{
+    constexpr int size{ImageFingerprint::cThumbnailSize};
+
+    // Pixels of the first and the last columns, which must not wrap to the next or the previous row
+    static const auto firstColumn{[]() {
+        std::bitset<cThumbnailPixels> column{};
+        for (int row{0}; row < size; ++row) {
+            column.set(row * size);
+        }
+        return column;
+    }()};
+    static const auto lastColumn{firstColumn << (size - 1)};
+
+    return thumbnail | ((thumbnail << 1) & ~firstColumn) | ((thumbnail >> 1) & ~lastColumn) | (thumbnail << size)
+           | (thumbnail >> size);
+}
+
+/**
+ * @brief Overlap of the foreground of two thumbnails.
+ */
+struct Overlap
+{
+    /** Ratio of the foreground matched within a pixel, from 0 to 1 (to verify the alignment). */
+    double mMatched{0.0};
+    /** Ratio of the foreground matched exactly, from 0 to 1 (to tell apart the alignments within a pixel). */
+    double mExact{0.0};
+};
+
+/**
+ * @brief Gets the overlap of the foreground of the thumbnail of a prior image, scaled and shifted, with a thumbnail.
+ *
+ * The foreground of each thumbnail is matched to the foreground of the other dilated by a pixel, so the thin lines of
+ * a schematic still match when the images are shifted by a fraction of a pixel of the thumbnails.
+ *
+ * @param prior Thumbnail of the prior image.
+ * @param current Thumbnail.
+ * @param currentDilated Thumbnail dilated.
+ * @param scaleX Scale of the x coordinates of the prior thumbnail.
+ * @param scaleY Scale of the y coordinates of the prior thumbnail.
+ * @param shiftX Shift of the x coordinates of the prior thumbnail, after scaled.
+ * @param shiftY Shift of the y coordinates of the prior thumbnail, after scaled.
+ *
+ * @return Overlap.
+ */
+Overlap getOverlap(const std::bitset<cThumbnailPixels>& prior,
+                  const std::bitset<cThumbnailPixels>& current,
+                  const std::bitset<cThumbnailPixels>& currentDilated,
+                  const double scaleX,
+                  const double scaleY,
+                  const int shiftX,
+                  const int shiftY)
+{
+    constexpr int size{ImageFingerprint::cThumbnailSize};
+
+    // Pixel of the prior thumbnail at each column and row of the thumbnail (from their centers)
+    std::array<int, size> priorColumns{};
+    std::array<int, size> priorRows{};
+    for (int i{0}; i < size; ++i) {
+        priorColumns.at(i) = static_cast<int>(std::lround((i + 0.5 - shiftX) / scaleX - 0.5));
+        priorRows.at(i) = static_cast<int>(std::lround((i + 0.5 - shiftY) / scaleY - 0.5));
+    }
+
+    std::bitset<cThumbnailPixels> mapped{};
+    for (int row{0}; row < size; ++row) {
+        const auto priorRow{priorRows.at(row)};
+        if (priorRow < 0 || priorRow >= size) {
+            continue;
+        }
+        for (int column{0}; column < size; ++column) {
+            const auto priorColumn{priorColumns.at(column)};
+            if (priorColumn >= 0 && priorColumn < size && prior[priorRow * size + priorColumn]) {
+                mapped.set(row * size + column);
+            }
+        }
+    }
+
+    const auto foregroundCount{mapped.count() + current.count()};
+    if (foregroundCount == 0) {
+        return Overlap{};
+    }
+    const auto matchedCount{(mapped & currentDilated).count() + (current & dilate(mapped)).count()};
+    const auto exactCount{2 * (mapped & current).count()};
+
+    return Overlap{static_cast<double>(matchedCount) / static_cast<double>(foregroundCount),
+                   static_cast<double>(exactCount) / static_cast<double>(foregroundCount)};
+}
+
+} // namespace
+
+NearDuplicateIndex::NearDuplicateIndex(const std::string& filePath,
+                                       const std::shared_ptr<logging::Logger>& logger,
+                                       const unsigned int maxDistance,
+                                       const double minOverlap)
+    : mFilePath{filePath}
+    , mLogger{logger}
+    , mMaxDistance{maxDistance}
+    , mMinOverlap{minOverlap}
+{
+}
+
+bool NearDuplicateIndex::open()
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    mEntries.clear();
+
+    // Fingerprints added by previous runs (a record left incomplete by an interruption is ignored)
+    std::ifstream file{mFilePath, std::ios::binary};
+    while (file) {
+        std::uint16_t keySize{0};
+        if (!file.read(reinterpret_cast<char*>(&keySize), sizeof(keySize))) {
+            break;
+        }
+        std::string key(keySize, '\0');
+        ImageFingerprint fingerprint{};
+        std::int32_t width{0};
+        std::int32_t height{0};
+        std::array<unsigned char, cThumbnailPixels / 8> thumbnail{};
+        if (!file.read(key.data(), keySize)
+            || !file.read(reinterpret_cast<char*>(&fingerprint.mHash), sizeof(fingerprint.mHash))
+            || !file.read(reinterpret_cast<char*>(&width), sizeof(width))
+            || !file.read(reinterpret_cast<char*>(&height), sizeof(height))
+            || !file.read(reinterpret_cast<char*>(thumbnail.data()), thumbnail.size())) {
+            break;
+        }
+
+        fingerprint.mWidth = width;
+        fingerprint.mHeight = height;
+        for (int i{0}; i < cThumbnailPixels; ++i) {
+            fingerprint.mThumbnail[i] = ((thumbnail.at(i / 8) >> (i % 8)) & 1) != 0;
+        }
+        mEntries[key] = fingerprint;
+    }
+    file.close();
+
+    // The fingerprints of the next results are appended
+    std::ofstream appendFile{mFilePath, std::ios::binary | std::ios::app};
+    if (!appendFile) {
+        mLogger->logError("Invalid near-duplicate index file: {}", mFilePath.string());
+        return false;
+    }
+
+    mLogger->logInfo("Near-duplicate index {}: {} fingerprints", mFilePath.string(), mEntries.size());
+
+    return true;
+}
+
+void NearDuplicateIndex::add(const std::string& key, const ImageFingerprint& fingerprint)
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    if (!appendEntry(key, fingerprint)) {
+        mLogger->logWarning("Failed to append the fingerprint of result {} to the near-duplicate index", key);
+    }
+    mEntries[key] = fingerprint;
+}
+
+void NearDuplicateIndex::remove(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    mEntries.erase(key);
+}
+
+std::vector<NearDuplicate> NearDuplicateIndex::find(const ImageFingerprint& fingerprint,
+                                                    const std::string& key) const
+{
+    // Candidates within the Hamming distance (a linear scan of the hashes is enough for the sizes of the cache)
+    std::vector<std::pair<NearDuplicate, ImageFingerprint>> candidates{};
+    {
+        const auto keyVariant{getKeyVariant(key)};
+
+        std::lock_guard<std::mutex> lock{mMutex};
+        for (const auto& [entryKey, entryFingerprint] : mEntries) {
+            const auto distance{static_cast<unsigned int>(std::popcount(entryFingerprint.mHash ^ fingerprint.mHash))};
+            if (distance <= mMaxDistance && entryKey != key && getKeyVariant(entryKey) == keyVariant) {
+                candidates.emplace_back(NearDuplicate{entryKey, distance, ImageTransform{}}, entryFingerprint);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first.mDistance < rhs.first.mDistance
+               || (lhs.first.mDistance == rhs.first.mDistance && lhs.first.mKey < rhs.first.mKey);
+    });
+
+    // Candidates verified without holding the mutex
+    std::vector<NearDuplicate> nearDuplicates{};
+    for (auto& [nearDuplicate, candidateFingerprint] : candidates) {
+        if (alignFingerprints(candidateFingerprint, fingerprint, mMinOverlap, nearDuplicate.mTransform)) {
+            nearDuplicates.push_back(std::move(nearDuplicate));
+        }
+    }
+
+    return nearDuplicates;
+}
+
+std::size_t NearDuplicateIndex::getNumEntries() const
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    return mEntries.size();
+}
+
+ImageFingerprint NearDuplicateIndex::computeFingerprint(
+    const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper, computerVision::ImageMat& image)
+{
+    constexpr int size{ImageFingerprint::cThumbnailSize};
+
+    computerVision::ImageMat thumbnailImage{};
+    openCvWrapper->thumbnailImage(image, thumbnailImage, size, size);
+
+    // Pixels of the thumbnail, row by row
+    std::vector<unsigned char> thumbnail(cThumbnailPixels);
+    for (int row{0}; row < size; ++row) {
+        const auto* pixels{openCvWrapper->getImageRow(thumbnailImage, row)};
+        if (pixels == nullptr) {
+            return ImageFingerprint{};
+        }
+        std::copy(pixels, pixels + size, thumbnail.begin() + row * size);
+    }
+
+    return makeFingerprint(thumbnail, openCvWrapper->getImageWidth(image), openCvWrapper->getImageHeight(image));
+}
+
+ImageFingerprint NearDuplicateIndex::makeFingerprint(const std::vector<unsigned char>& thumbnail,
+                                                     const int width,
+                                                     const int height)
+{
+    constexpr int size{ImageFingerprint::cThumbnailSize};
+    constexpr int cellSize{size / cHashCells};
+
+    ImageFingerprint fingerprint{};
+    fingerprint.mWidth = width;
+    fingerprint.mHeight = height;
+    if (thumbnail.size() < static_cast<std::size_t>(cThumbnailPixels)) {
+        return fingerprint;
+    }
+
+    // Foreground darker than the mean, so a change of exposure keeps it
+    unsigned int sum{0};
+    for (int i{0}; i < cThumbnailPixels; ++i) {
+        sum += thumbnail.at(i);
+    }
+    const auto mean{static_cast<int>(sum / cThumbnailPixels)};
+
+    std::array<unsigned int, cHashCells * cHashCells> cellCounts{};
+    for (int row{0}; row < size; ++row) {
+        for (int column{0}; column < size; ++column) {
+            if (thumbnail.at(row * size + column) + cForegroundMargin < mean) {
+                fingerprint.mThumbnail.set(row * size + column);
+                ++cellCounts.at((row / cellSize) * cHashCells + column / cellSize);
+            }
+        }
+    }
+
+    // Hash: the cells with more foreground than the average of the cells
+    const auto foregroundCount{fingerprint.mThumbnail.count()};
+    for (std::size_t cell{0}; cell < cellCounts.size(); ++cell) {
+        if (cellCounts.at(cell) * cellCounts.size() > foregroundCount) {
+            fingerprint.mHash |= std::uint64_t{1} << cell;
+        }
+    }
+
+    return fingerprint;
+}
+
+bool NearDuplicateIndex::alignFingerprints(const ImageFingerprint& prior,
+                                           const ImageFingerprint& current,
+                                           const double minOverlap,
+                                           ImageTransform& transform)
+{
+    if (prior.mThumbnail.none() || current.mThumbnail.none() || prior.mWidth <= 0 || prior.mHeight <= 0) {
+        return false;
+    }
+
+    // Scales and shifts of the prior thumbnail with the largest overlap, the identity on ties
+    const auto currentDilated{dilate(current.mThumbnail)};
+    auto bestOverlap{getOverlap(prior.mThumbnail, current.mThumbnail, currentDilated, 1.0, 1.0, 0, 0)};
+    auto bestScaleX{1.0};
+    auto bestScaleY{1.0};
+    auto bestShiftX{0};
+    auto bestShiftY{0};
+    for (const auto scaleX : cAlignmentScales) {
+        for (const auto scaleY : cAlignmentScales) {
+            for (int shiftY{-cAlignmentMaxShift}; shiftY <= cAlignmentMaxShift; ++shiftY) {
+                for (int shiftX{-cAlignmentMaxShift}; shiftX <= cAlignmentMaxShift; ++shiftX) {
+                    const auto overlap{getOverlap(
+                        prior.mThumbnail, current.mThumbnail, currentDilated, scaleX, scaleY, shiftX, shiftY)};
+                    if (overlap.mMatched + overlap.mExact > bestOverlap.mMatched + bestOverlap.mExact) {
+                        bestOverlap = overlap;
+                        bestScaleX = scaleX;
+                        bestScaleY = scaleY;
+                        bestShiftX = shiftX;
+                        bestShiftY = shiftY;
+                    }
+                }
+            }
+        }
+    }
+
+    if (bestOverlap.mMatched < minOverlap) {
+        return false;
+    }
+
+    // From the coordinates of the thumbnails to the coordinates of the images
+    constexpr double size{ImageFingerprint::cThumbnailSize};
+    transform.mScaleX = bestScaleX * current.mWidth / prior.mWidth;
+    transform.mScaleY = bestScaleY * current.mHeight / prior.mHeight;
+    transform.mOffsetX = bestShiftX * current.mWidth / size;
+    transform.mOffsetY = bestShiftY * current.mHeight / size;
+
+    return true;
+}
+
+void NearDuplicateIndex::transformResult(const ImageTransform& transform,
+                                         CachedResult& result,
+                                         const int imageWidth,
+                                         const int imageHeight)
+{
+    const auto transformX = [&transform](const double x) {
+        return static_cast<int>(std::lround(x * transform.mScaleX + transform.mOffsetX));
+    };
+    const auto transformY = [&transform](const double y) {
+        return static_cast<int>(std::lround(y * transform.mScaleY + transform.mOffsetY));
+    };
+
+    // Position of an element of the segmentation map
+    const auto transformPosition = [&](nlohmann::ordered_json& element, const bool keepOrigin) {
+        if (!element.contains("position") || !element["position"].is_object()) {
+            return;
+        }
+        auto& position{element["position"]};
+        const auto x{position.value("x", 0.0)};
+        const auto y{position.value("y", 0.0)};
+        if (keepOrigin && x == 0.0 && y == 0.0) {
+            return;
+        }
+        position["x"] = transformX(x);
+        position["y"] = transformY(y);
+    };
+
+    // Elements of the segmentation map, with their labels
+    auto& segmentationMap{result.mSegmentationMap};
+    for (const auto* elements : {"components", "connections", "nodes"}) {
+        if (!segmentationMap.contains(elements) || !segmentationMap[elements].is_array()) {
+            continue;
+        }
+        for (auto& element : segmentationMap[elements]) {
+            // The connections have no position
+            transformPosition(element, false);
+            if (element.contains("label") && element["label"].is_object()) {
+                transformPosition(element["label"], true);
+            }
+        }
+    }
+
+    // Images with ROI, clipped to the image
+    for (auto& roiImage : result.mRoiImages) {
+        const auto& roi{roiImage.mRoi};
+        const auto left{std::clamp(transformX(roi.x), 0, imageWidth)};
+        const auto top{std::clamp(transformY(roi.y), 0, imageHeight)};
+        const auto right{std::clamp(transformX(roi.x + roi.width), 0, imageWidth)};
+        const auto bottom{std::clamp(transformY(roi.y + roi.height), 0, imageHeight)};
+        roiImage.mRoi = computerVision::Rectangle{left, top, std::max(right - left, 0), std::max(bottom - top, 0)};
+    }
+    std::erase_if(result.mRoiImages, [](const schematicSegmentation::RoiImage& roiImage) {
+        return roiImage.mRoi.width <= 0 || roiImage.mRoi.height <= 0;
+    });
+}
+
+bool NearDuplicateIndex::appendEntry(const std::string& key, const ImageFingerprint& fingerprint)
+{
+    std::array<unsigned char, cThumbnailPixels / 8> thumbnail{};
+    for (int i{0}; i < cThumbnailPixels; ++i) {
+        if (fingerprint.mThumbnail[i]) {
+            thumbnail.at(i / 8) |= static_cast<unsigned char>(1 << (i % 8));
+        }
+    }
+    const auto keySize{static_cast<std::uint16_t>(key.size())};
+    const auto width{static_cast<std::int32_t>(fingerprint.mWidth)};
+    const auto height{static_cast<std::int32_t>(fingerprint.mHeight)};
+
+    // A record in the native byte order, as the index is only read by this machine
+    std::ofstream file{mFilePath, std::ios::binary | std::ios::app};
+    file.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+    file.write(key.data(), keySize);
+    file.write(reinterpret_cast<const char*>(&fingerprint.mHash), sizeof(fingerprint.mHash));
+    file.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    file.write(reinterpret_cast<const char*>(&height), sizeof(height));
+    file.write(reinterpret_cast<const char*>(thumbnail.data()), thumbnail.size());
+
+    return static_cast<bool>(file);
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
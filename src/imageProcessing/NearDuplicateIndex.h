@@ -0,0 +1,237 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "ResultCache.h"
+#include "computerVision/OpenCvWrapper.h"
+#include "logging/Logger.h"
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Perceptual fingerprint of an image, robust to small changes of exposure, crop and scale.
+ */
+struct ImageFingerprint
+{
+    /** Width and height of the thumbnail of the image. */
+    static constexpr int cThumbnailSize{32};
+
+    /** Perceptual hash: a bit for each cell of 8x8 cells of the thumbnail, set if the cell has more foreground. */
+    std::uint64_t mHash{0};
+    /** Thumbnail binarized: a bit for each pixel, set for the foreground (darker than the mean), row by row. */
+    std::bitset<cThumbnailSize * cThumbnailSize> mThumbnail{};
+    /** Width of the image. */
+    int mWidth{0};
+    /** Height of the image. */
+    int mHeight{0};
+};
+
+/**
+ * @brief Transform of the coordinates of an image to the coordinates of another image (scale and then offset).
+ */
+struct ImageTransform
+{
+    /** Scale of the x coordinates. */
+    double mScaleX{1.0};
+    /** Scale of the y coordinates. */
+    double mScaleY{1.0};
+    /** Offset of the x coordinates, in pixels. */
+    double mOffsetX{0.0};
+    /** Offset of the y coordinates, in pixels. */
+    double mOffsetY{0.0};
+};
+
+/**
+ * @brief Near-duplicate of an image found in the index.
+ */
+struct NearDuplicate
+{
+    /** Key of the result of the near-duplicate in the result cache. */
+    std::string mKey{};
+    /** Hamming distance between the perceptual hashes. */
+    unsigned int mDistance{0};
+    /** Transform of the coordinates of the near-duplicate to the coordinates of the image. */
+    ImageTransform mTransform{};
+};
+
+/**
+ * @brief Persistent index of the perceptual fingerprints of the results in the result cache, to reuse the result of
+ * a near-duplicate image (e.g. the same schematic re-scanned with another exposure or crop).
+ *
+ * The candidates are the results whose perceptual hashes are within a Hamming distance of the hash of the image. Each
+ * candidate is verified by aligning the binarized thumbnails (a small search of scales and shifts), which also gives
+ * the transform of the coordinates of its result. The fingerprints are appended to the index file, so the index
+ * survives restarts, and the index can be shared by many managers.
+ */
+class NearDuplicateIndex
+{
+public:
+    /** Name of the index file, in the result cache folder. */
+    static constexpr auto cIndexFile{"near_duplicates.idx"};
+    /** Default maximum Hamming distance between the perceptual hashes of near-duplicates. */
+    static constexpr unsigned int cMaxDistanceDefault{8};
+    /** Default minimum overlap (ratio of the foreground matched) of the thumbnails aligned. */
+    static constexpr double cMinOverlapDefault{0.9};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param filePath Path of the index file (created if it does not exist).
+     * @param logger Logger.
+     * @param maxDistance Maximum Hamming distance between the perceptual hashes of near-duplicates.
+     * @param minOverlap Minimum overlap of the foreground of the thumbnails aligned, from 0 to 1.
+     */
+    explicit NearDuplicateIndex(const std::string& filePath,
+                                const std::shared_ptr<logging::Logger>& logger,
+                                const unsigned int maxDistance = cMaxDistanceDefault,
+                                const double minOverlap = cMinOverlapDefault);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~NearDuplicateIndex() = default;
+
+    /**
+     * @brief Opens the index, reading the fingerprints added by previous runs.
+     *
+     * @return True if the index file can be read and written, otherwise false.
+     */
+    virtual bool open();
+
+    /**
+     * @brief Adds the fingerprint of the image of a result.
+     *
+     * @param key Key of the result in the result cache.
+     * @param fingerprint Fingerprint of the image.
+     */
+    virtual void add(const std::string& key, const ImageFingerprint& fingerprint);
+
+    /**
+     * @brief Removes the fingerprint of a result (e.g. evicted from the result cache).
+     *
+     * @param key Key of the result.
+     */
+    virtual void remove(const std::string& key);
+
+    /**
+     * @brief Finds the near-duplicates of an image, verified by the alignment of their thumbnails.
+     *
+     * Only the results processed as the image (the same key after the hash of the image, see
+     * @ref ResultCache::makeKey) are found, except the result of the key itself.
+     *
+     * @param fingerprint Fingerprint of the image.
+     * @param key Key of the result of the image.
+     *
+     * @return Near-duplicates, from the closest.
+     */
+    [[nodiscard]] virtual std::vector<NearDuplicate> find(const ImageFingerprint& fingerprint,
+                                                          const std::string& key) const;
+
+    /**
+     * @brief Gets the number of fingerprints in the index.
+     *
+     * @return Number of fingerprints.
+     */
+    [[nodiscard]] virtual std::size_t getNumEntries() const;
+
+    /**
+     * @brief Computes the fingerprint of an image.
+     *
+     * @param openCvWrapper OpenCV wrapper.
+     * @param image Image.
+     *
+     * @return Fingerprint.
+     */
+    static ImageFingerprint computeFingerprint(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                               computerVision::ImageMat& image);
+
+    /**
+     * @brief Makes the fingerprint of an image from its grayscale thumbnail.
+     *
+     * @param thumbnail Grayscale thumbnail, with ImageFingerprint::cThumbnailSize rows of as many pixels.
+     * @param width Width of the image.
+     * @param height Height of the image.
+     *
+     * @return Fingerprint.
+     */
+    static ImageFingerprint makeFingerprint(const std::vector<unsigned char>& thumbnail,
+                                            const int width,
+                                            const int height);
+
+    /**
+     * @brief Aligns the thumbnail of a prior image to the thumbnail of an image.
+     *
+     * @param prior Fingerprint of the prior image.
+     * @param current Fingerprint of the image.
+     * @param minOverlap Minimum overlap of the foreground of the thumbnails aligned, from 0 to 1.
+     * @param transform Transform of the coordinates of the prior image to the coordinates of the image.
+     *
+     * @return True if the thumbnails are aligned with the minimum overlap, otherwise false.
+     */
+    static bool alignFingerprints(const ImageFingerprint& prior,
+                                  const ImageFingerprint& current,
+                                  const double minOverlap,
+                                  ImageTransform& transform);
+
+    /**
+     * @brief Transforms the coordinates of a result (positions of the segmentation map and ROI of the images).
+     *
+     * The ports are relative to their components, so they are kept. The labels at the origin were not detected, so
+     * they are kept too. The ROI are clipped to the image, and the images whose ROI is outside the image are removed.
+     * The encoded images with ROI are crops of the other image, so they must be generated again from the image.
+     *
+     * @param transform Transform of the coordinates.
+     * @param result Result.
+     * @param imageWidth Width of the image, in pixels.
+     * @param imageHeight Height of the image, in pixels.
+     */
+    static void transformResult(const ImageTransform& transform,
+                                CachedResult& result,
+                                const int imageWidth,
+                                const int imageHeight);
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Appends the fingerprint of a result to the index file.
+     *
+     * The mutex must be locked by the caller.
+     *
+     * @param key Key of the result.
+     * @param fingerprint Fingerprint.
+     *
+     * @return True if the fingerprint was appended, otherwise false.
+     */
+    virtual bool appendEntry(const std::string& key, const ImageFingerprint& fingerprint);
+
+private:
+    /** Path of the index file. */
+    std::filesystem::path mFilePath;
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Maximum Hamming distance between the perceptual hashes of near-duplicates. */
+    unsigned int mMaxDistance;
+    /** Minimum overlap of the foreground of the thumbnails aligned. */
+    double mMinOverlap;
+
+    /** Mutex for the fingerprints and the index file. */
+    mutable std::mutex mMutex;
+    /** Fingerprints, by key of their results. */
+    std::unordered_map<std::string, ImageFingerprint> mEntries{};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,610 @@
+/**
+ * @file
+ */
+
+#include "ParameterSweep.h"
+#include "schematicSegmentation/SchematicSegmentation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+namespace {
+
+/** Clock of the times of the stages. */
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Parameter that can be swept.
+ */
+struct SweepAxis
+{
+    /** Name of the parameter, in the configuration and in the CSV file. */
+    const char* mName;
+    /** Stage of the parameter. */
+    ParameterSweep::SweepStage mStage;
+    /** Minimum value. */
+    double mMin;
+    /** Flag of an integer parameter. */
+    bool mInteger;
+    /** Flag of a parameter that must be odd (e.g. sizes of kernels centered on a pixel). */
+    bool mOdd;
+    /** Sets the parameter in a combination. */
+    void (*mSet)(SweepCombination&, const double);
+    /** Gets the parameter of a combination. */
+    double (*mGet)(const SweepCombination&);
+};
+
+/** Parameters that can be swept, in the order of the stages. */
+const std::array cSweepAxes{
+    SweepAxis{"filterKernelSize",
+              ParameterSweep::SweepStage::PREPROCESSING,
+              1,
+              true,
+              true,
+              [](SweepCombination& c, const double v) {
+                  c.mPreprocessing.mFilterKernelSize = static_cast<unsigned int>(v);
+              },
+              [](const SweepCombination& c) { return static_cast<double>(c.mPreprocessing.mFilterKernelSize); }},
+    SweepAxis{"thresholdBlockSize",
+              ParameterSweep::SweepStage::PREPROCESSING,
+              3,
+              true,
+              true,
+              [](SweepCombination& c, const double v) { c.mPreprocessing.mThresholdBlockSize = static_cast<int>(v); },
+              [](const SweepCombination& c) { return static_cast<double>(c.mPreprocessing.mThresholdBlockSize); }},
+    SweepAxis{"thresholdSubConst",
+              ParameterSweep::SweepStage::PREPROCESSING,
+              std::numeric_limits<double>::lowest(),
+              false,
+              false,
+              [](SweepCombination& c, const double v) { c.mPreprocessing.mThresholdSubConst = v; },
+              [](const SweepCombination& c) { return c.mPreprocessing.mThresholdSubConst; }},
+    SweepAxis{"connectionMorphCloseKernelSize",
+              ParameterSweep::SweepStage::CONNECTIONS,
+              1,
+              true,
+              false,
+              [](SweepCombination& c, const double v) {
+                  c.mConnectionDetection.mMorphCloseKernelSize = static_cast<unsigned int>(v);
+              },
+              [](const SweepCombination& c) {
+                  return static_cast<double>(c.mConnectionDetection.mMorphCloseKernelSize);
+              }},
+    SweepAxis{"connectionMorphCloseIter",
+              ParameterSweep::SweepStage::CONNECTIONS,
+              1,
+              true,
+              false,
+              [](SweepCombination& c, const double v) {
+                  c.mConnectionDetection.mMorphCloseIter = static_cast<unsigned int>(v);
+              },
+              [](const SweepCombination& c) { return static_cast<double>(c.mConnectionDetection.mMorphCloseIter); }},
+    SweepAxis{"connectionMinLength",
+              ParameterSweep::SweepStage::CONNECTIONS,
+              0,
+              false,
+              false,
+              [](SweepCombination& c, const double v) { c.mConnectionDetection.mConnectionMinLength = v; },
+              [](const SweepCombination& c) { return c.mConnectionDetection.mConnectionMinLength; }},
+    SweepAxis{"componentMorphCloseKernelSize",
+              ParameterSweep::SweepStage::COMPONENTS,
+              1,
+              true,
+              false,
+              [](SweepCombination& c, const double v) {
+                  c.mComponentDetection.mMorphCloseKernelSize = static_cast<unsigned int>(v);
+              },
+              [](const SweepCombination& c) {
+                  return static_cast<double>(c.mComponentDetection.mMorphCloseKernelSize);
+              }},
+    SweepAxis{"componentMorphCloseIter",
+              ParameterSweep::SweepStage::COMPONENTS,
+              1,
+              true,
+              false,
+              [](SweepCombination& c, const double v) {
+                  c.mComponentDetection.mMorphCloseIter = static_cast<unsigned int>(v);
+              },
+              [](const SweepCombination& c) { return static_cast<double>(c.mComponentDetection.mMorphCloseIter); }},
+    SweepAxis{"componentBoxMinArea",
+              ParameterSweep::SweepStage::COMPONENTS,
+              0,
+              true,
+              false,
+              [](SweepCombination& c, const double v) { c.mComponentDetection.mBoxMinArea = static_cast<int>(v); },
+              [](const SweepCombination& c) { return static_cast<double>(c.mComponentDetection.mBoxMinArea); }},
+    SweepAxis{"labelMorphCloseKernelSize",
+              ParameterSweep::SweepStage::LABELS,
+              1,
+              true,
+              false,
+              [](SweepCombination& c, const double v) {
+                  c.mLabelDetection.mMorphCloseKernelSize = static_cast<unsigned int>(v);
+              },
+              [](const SweepCombination& c) { return static_cast<double>(c.mLabelDetection.mMorphCloseKernelSize); }},
+    SweepAxis{"labelMorphCloseIter",
+              ParameterSweep::SweepStage::LABELS,
+              1,
+              true,
+              false,
+              [](SweepCombination& c, const double v) {
+                  c.mLabelDetection.mMorphCloseIter = static_cast<unsigned int>(v);
+              },
+              [](const SweepCombination& c) { return static_cast<double>(c.mLabelDetection.mMorphCloseIter); }},
+    SweepAxis{"labelBoxMinArea",
+              ParameterSweep::SweepStage::LABELS,
+              0,
+              true,
+              false,
+              [](SweepCombination& c, const double v) { c.mLabelDetection.mBoxMinArea = static_cast<int>(v); },
+              [](const SweepCombination& c) { return static_cast<double>(c.mLabelDetection.mBoxMinArea); }},
+};
+
+/**
+ * @brief Preprocessing of a variant, shared by the combinations with its parameters.
+ */
+struct PreprocessingResult
+{
+    /** Image preprocessed (only read by the detections). */
+    computerVision::ImageMat mImage{};
+    /** Wall-clock time, in milliseconds. */
+    double mTimeMs{0};
+};
+
+/**
+ * @brief Detection of connections of a variant, shared by the combinations with its parameters.
+ */
+struct ConnectionsResult
+{
+    /** Detection of connections, copied by each detection of components that updates the connections. */
+    std::unique_ptr<schematicSegmentation::ConnectionDetection> mConnectionDetection{};
+    /** Flag of the connections detected. */
+    bool mSuccess{false};
+    /** Wall-clock time, in milliseconds. */
+    double mTimeMs{0};
+};
+
+/**
+ * @brief Detection of components and nodes of a variant, shared by the combinations with its parameters.
+ */
+struct ComponentsResult
+{
+    /** Elements segmented before the association of labels. */
+    std::unique_ptr<schematicSegmentation::SchematicSegmentation> mSchematicSegmentation{};
+    /** Flag of the components, connections and nodes detected. */
+    bool mSuccess{false};
+    /** Wall-clock time, in milliseconds. */
+    double mTimeMs{0};
+};
+
+/**
+ * @brief Gets the time elapsed since a time point.
+ *
+ * @param start Time point.
+ *
+ * @return Time elapsed, in milliseconds.
+ */
+double getElapsedMs(const Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Escapes a field of a CSV file.
+ *
+ * @param field Field.
+ *
+ * @return Field, quoted if it has a separator, a quote or a line break.
+ */
+std::string escapeCsvField(const std::string& field)
+{
+    if (field.find_first_of(",\"\n") == std::string::npos) {
+        return field;
+    }
+
+    std::string escaped{"\""};
+    for (const auto character : field) {
+        if (character == '"') {
+            escaped += '"';
+        }
+        escaped += character;
+    }
+    escaped += '"';
+
+    return escaped;
+}
+
+} // namespace
+
+ParameterSweep::ParameterSweep(const std::shared_ptr<ImageReceiver>& imageReceiver,
+                               const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                               const std::shared_ptr<output::ImageWriter>& imageWriter,
+                               const std::shared_ptr<logging::Logger>& logger,
+                               const unsigned int numThreads,
+                               const common::ThreadPool::ThreadStart& threadStart)
+    : mImageReceiver{imageReceiver}
+    , mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
+    , mLogger{logger}
+    , mThreadPool{numThreads, threadStart}
+{
+}
+
+bool ParameterSweep::loadConfig(const std::string& configPath, const common::Preset preset)
+{
+    std::ifstream configFile{configPath};
+    if (!configFile) {
+        mLogger->logError("Failed to open the sweep configuration {}", configPath);
+        return false;
+    }
+
+    // JSON object (not brace-initialized, which would wrap it in an array)
+    const auto config = nlohmann::ordered_json::parse(configFile, nullptr, false);
+    if (config.is_discarded()) {
+        mLogger->logError("Sweep configuration {} is not valid JSON", configPath);
+        return false;
+    }
+
+    return parseConfig(config, preset);
+}
+
+bool ParameterSweep::parseConfig(const nlohmann::ordered_json& config, const common::Preset preset)
+{
+    if (!config.is_object()) {
+        mLogger->logError("Sweep configuration is not a JSON object");
+        return false;
+    }
+
+    // Base of the combinations: parameters of the preset
+    auto basePreset{preset};
+    if (config.contains("preset")
+        && (!config["preset"].is_string() || !common::parsePreset(config["preset"].get<std::string>(), basePreset))) {
+        mLogger->logError("Sweep configuration: \"preset\" must be fast, balanced or accurate");
+        return false;
+    }
+    const SweepCombination base{ImagePreprocessing::getParameters(basePreset),
+                                schematicSegmentation::ConnectionDetection::getParameters(basePreset),
+                                schematicSegmentation::ComponentDetection::getParameters(basePreset),
+                                schematicSegmentation::LabelDetection::getParameters(basePreset)};
+    for (auto& variants : mVariants) {
+        variants.assign(1, base);
+    }
+
+    // Images, with the folders expanded to their files
+    mImagePaths.clear();
+    if (!config.contains("images") || !config["images"].is_array()) {
+        mLogger->logError("Sweep configuration: \"images\" must be an array of files or folders");
+        return false;
+    }
+    for (const auto& image : config["images"]) {
+        if (!image.is_string()) {
+            mLogger->logError("Sweep configuration: \"images\" must be an array of files or folders");
+            return false;
+        }
+        const std::filesystem::path path{image.get<std::string>()};
+        std::error_code error{};
+        if (!std::filesystem::is_directory(path, error)) {
+            mImagePaths.push_back(path.string());
+            continue;
+        }
+        std::vector<std::string> files{};
+        for (const auto& entry : std::filesystem::directory_iterator{path, error}) {
+            if (entry.is_regular_file(error)) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        mImagePaths.insert(mImagePaths.end(), files.begin(), files.end());
+    }
+    if (mImagePaths.empty()) {
+        mLogger->logError("Sweep configuration: no images");
+        return false;
+    }
+
+    // CSV file of the results
+    mOutputPath = cDefaultOutputPath;
+    if (config.contains("output")) {
+        if (!config["output"].is_string() || config["output"].get<std::string>().empty()) {
+            mLogger->logError("Sweep configuration: \"output\" must be a non-empty string");
+            return false;
+        }
+        mOutputPath = config["output"].get<std::string>();
+    }
+
+    // Values of the parameters swept, expanding the variants of their stages
+    if (config.contains("parameters")) {
+        if (!config["parameters"].is_object()) {
+            mLogger->logError("Sweep configuration: \"parameters\" must be an object");
+            return false;
+        }
+        for (const auto& [name, values] : config["parameters"].items()) {
+            const auto axis{std::find_if(cSweepAxes.begin(), cSweepAxes.end(), [&name](const SweepAxis& sweepAxis) {
+                return name == sweepAxis.mName;
+            })};
+            if (axis == cSweepAxes.end()) {
+                mLogger->logError("Sweep configuration: unknown parameter {}", name);
+                return false;
+            }
+            if (!values.is_array() || values.empty()) {
+                mLogger->logError("Sweep configuration: parameter {} must be a non-empty array of numbers", name);
+                return false;
+            }
+
+            auto& variants{mVariants[static_cast<std::size_t>(axis->mStage)]};
+            std::vector<SweepCombination> expanded{};
+            expanded.reserve(variants.size() * values.size());
+            for (const auto& variant : variants) {
+                for (const auto& value : values) {
+                    const auto number{value.is_number() ? value.get<double>() : 0.0};
+                    if (!value.is_number() || number < axis->mMin || (axis->mInteger && std::trunc(number) != number)
+                        || (axis->mOdd && static_cast<long long>(number) % 2 == 0)) {
+                        mLogger->logError("Sweep configuration: invalid value {} of parameter {}", value.dump(), name);
+                        return false;
+                    }
+                    auto combination{variant};
+                    axis->mSet(combination, number);
+                    expanded.push_back(combination);
+                }
+            }
+            variants = std::move(expanded);
+        }
+    }
+
+    mResults.clear();
+
+    mLogger->logInfo("Parameter sweep: {} images, {} combinations, preset {}",
+                     mImagePaths.size(),
+                     getNumCombinations(),
+                     common::getPresetName(basePreset));
+
+    return true;
+}
+
+bool ParameterSweep::run()
+{
+    const auto startTime{Clock::now()};
+
+    mResults.clear();
+    auto success{true};
+    for (const auto& imagePath : mImagePaths) {
+        mImageReceiver->setImageFilePath(imagePath);
+        if (!mImageReceiver->receiveImage()) {
+            mLogger->logError("Failed to receive image {}, skipped by the sweep", imagePath);
+            success = false;
+            continue;
+        }
+
+        auto imageInitial{mImageReceiver->getImageReceived()};
+        sweepImage(imagePath, imageInitial);
+    }
+
+    mLogger->logInfo("Parameter sweep of {} images and {} combinations done in {} ms",
+                     mImagePaths.size(),
+                     getNumCombinations(),
+                     getElapsedMs(startTime));
+
+    // Results
+    std::ofstream outputFile{mOutputPath};
+    if (!outputFile) {
+        mLogger->logError("Failed to write the results of the sweep to {}", mOutputPath);
+        return false;
+    }
+    writeCsv(outputFile);
+    mLogger->logInfo("Results of the sweep written to {}", mOutputPath);
+
+    return success && outputFile.good();
+}
+
+void ParameterSweep::sweepImage(const std::string& imagePath, computerVision::ImageMat& imageInitial)
+{
+    const auto& preprocessingVariants{mVariants[static_cast<std::size_t>(SweepStage::PREPROCESSING)]};
+    const auto& connectionVariants{mVariants[static_cast<std::size_t>(SweepStage::CONNECTIONS)]};
+    const auto& componentVariants{mVariants[static_cast<std::size_t>(SweepStage::COMPONENTS)]};
+    const auto& labelVariants{mVariants[static_cast<std::size_t>(SweepStage::LABELS)]};
+    const auto numPreprocessings{getNumVariants(SweepStage::PREPROCESSING)};
+    const auto numConnections{getNumVariants(SweepStage::CONNECTIONS)};
+    const auto numComponents{getNumVariants(SweepStage::COMPONENTS)};
+    const auto numCombinations{getNumCombinations()};
+
+    mLogger->logInfo("Sweeping image {}: {} preprocessings, {} detections of connections, {} detections of components "
+                     "and {} detections of labels",
+                     imagePath,
+                     numPreprocessings,
+                     numConnections,
+                     numComponents,
+                     numCombinations);
+
+    // The initial image is only read by the stages (no images are saved)
+
+    // Preprocessing, once for each variant
+    std::vector<PreprocessingResult> preprocessings(numPreprocessings);
+    mThreadPool.runAll(numPreprocessings, [&](const std::size_t variant) {
+        const auto startTime{Clock::now()};
+        ImagePreprocessing imagePreprocessing{mOpenCvWrapper, mImageWriter, mLogger};
+        imagePreprocessing.setParameters(preprocessingVariants[variant].mPreprocessing);
+        preprocessings[variant].mImage = mOpenCvWrapper->cloneImage(imageInitial);
+        imagePreprocessing.preprocessImage(preprocessings[variant].mImage);
+        preprocessings[variant].mTimeMs = getElapsedMs(startTime);
+    });
+
+    // Detection of connections, once for each variant of the preprocessing and the connections
+    const auto numConnectionVariants{connectionVariants.size()};
+    std::vector<ConnectionsResult> connections(numConnections);
+    mThreadPool.runAll(numConnections, [&](const std::size_t variant) {
+        const auto startTime{Clock::now()};
+        auto& result{connections[variant]};
+        result.mConnectionDetection
+            = std::make_unique<schematicSegmentation::ConnectionDetection>(mOpenCvWrapper, mImageWriter, mLogger);
+        result.mConnectionDetection->setParameters(
+            connectionVariants[variant % numConnectionVariants].mConnectionDetection);
+        result.mSuccess = result.mConnectionDetection->detectConnections(
+            imageInitial, preprocessings[variant / numConnectionVariants].mImage);
+        result.mTimeMs = getElapsedMs(startTime);
+    });
+
+    // Detection of components and nodes, once for each variant of the stages up to the components
+    const auto numComponentVariants{componentVariants.size()};
+    std::vector<ComponentsResult> components(numComponents);
+    mThreadPool.runAll(numComponents, [&](const std::size_t variant) {
+        const auto& connectionsResult{connections[variant / numComponentVariants]};
+        if (!connectionsResult.mSuccess) {
+            return;
+        }
+
+        const auto startTime{Clock::now()};
+        auto& result{components[variant]};
+        auto& imagePreprocessed{preprocessings[variant / numComponentVariants / numConnectionVariants].mImage};
+
+        // The connections are updated with the components, so each variant updates its own copy
+        auto connectionDetection{*connectionsResult.mConnectionDetection};
+        schematicSegmentation::ComponentDetection componentDetection{mOpenCvWrapper, mImageWriter, mLogger};
+        componentDetection.setParameters(componentVariants[variant % numComponentVariants].mComponentDetection);
+        result.mSuccess
+            = componentDetection.detectComponents(
+                  imageInitial, imagePreprocessed, connectionDetection.getDetectedConnections())
+              && connectionDetection.updateConnections(
+                  imageInitial, imagePreprocessed, componentDetection.getDetectedComponents())
+              && connectionDetection.detectNodesUpdateConnections(
+                  imageInitial, imagePreprocessed, componentDetection.getDetectedComponents());
+        if (result.mSuccess) {
+            result.mSchematicSegmentation = std::make_unique<schematicSegmentation::SchematicSegmentation>(
+                mOpenCvWrapper, mImageWriter, mLogger);
+            result.mSchematicSegmentation->detectComponentConnections(imageInitial,
+                                                                      imagePreprocessed,
+                                                                      componentDetection.getDetectedComponents(),
+                                                                      connectionDetection.getDetectedConnections(),
+                                                                      connectionDetection.getDetectedNodes());
+            result.mSuccess = result.mSchematicSegmentation->updateDetectedComponents();
+        }
+        result.mTimeMs = getElapsedMs(startTime);
+    });
+
+    // Detection of labels, for each combination
+    const auto numLabelVariants{labelVariants.size()};
+    std::vector<SweepResult> results(numCombinations);
+    mThreadPool.runAll(numCombinations, [&](const std::size_t combination) {
+        const auto componentsVariant{combination / numLabelVariants};
+        const auto connectionsVariant{componentsVariant / numComponentVariants};
+        const auto preprocessingVariant{connectionsVariant / numConnectionVariants};
+
+        auto& result{results[combination]};
+        result.mImagePath = imagePath;
+        result.mCombination = combination;
+        result.mPreprocessingTimeMs = preprocessings[preprocessingVariant].mTimeMs;
+        result.mConnectionsTimeMs = connections[connectionsVariant].mTimeMs;
+        result.mComponentsTimeMs = components[componentsVariant].mTimeMs;
+        result.mSuccess = components[componentsVariant].mSuccess;
+        if (!result.mSuccess) {
+            return;
+        }
+
+        const auto startTime{Clock::now()};
+        auto& imagePreprocessed{preprocessings[preprocessingVariant].mImage};
+
+        // The labels are associated to the elements, so each combination associates them to its own copy
+        auto schematicSegmentation{*components[componentsVariant].mSchematicSegmentation};
+        schematicSegmentation::LabelDetection labelDetection{mOpenCvWrapper, mImageWriter, mLogger};
+        labelDetection.setParameters(labelVariants[combination % numLabelVariants].mLabelDetection);
+        if (labelDetection.detectLabels(imageInitial,
+                                        imagePreprocessed,
+                                        schematicSegmentation.getComponents(),
+                                        schematicSegmentation.getConnections())) {
+            schematicSegmentation.associateLabels(imageInitial, imagePreprocessed, labelDetection.getDetectedLabels());
+        }
+        result.mLabelsTimeMs = getElapsedMs(startTime);
+
+        result.mNumComponents = schematicSegmentation.getComponents().size();
+        result.mNumConnections = schematicSegmentation.getConnections().size();
+        result.mNumNodes = schematicSegmentation.getNodes().size();
+        result.mNumLabels = labelDetection.getDetectedLabels().size();
+    });
+
+    mResults.insert(mResults.end(), std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
+}
+
+void ParameterSweep::writeCsv(std::ostream& stream) const
+{
+    // Header
+    stream << "image,combination";
+    for (const auto& axis : cSweepAxes) {
+        stream << "," << axis.mName;
+    }
+    stream << ",success,preprocessingMs,connectionsMs,componentsMs,labelsMs,components,connections,nodes,labels\n";
+
+    // Row for each image and combination
+    for (const auto& result : mResults) {
+        const auto combination{getCombination(result.mCombination)};
+        stream << escapeCsvField(result.mImagePath) << "," << result.mCombination;
+        for (const auto& axis : cSweepAxes) {
+            stream << "," << axis.mGet(combination);
+        }
+        stream << "," << (result.mSuccess ? 1 : 0) << "," << result.mPreprocessingTimeMs << ","
+               << result.mConnectionsTimeMs << "," << result.mComponentsTimeMs << "," << result.mLabelsTimeMs << ","
+               << result.mNumComponents << "," << result.mNumConnections << "," << result.mNumNodes << ","
+               << result.mNumLabels << "\n";
+    }
+}
+
+std::size_t ParameterSweep::getNumCombinations() const
+{
+    return getNumVariants(SweepStage::LABELS);
+}
+
+std::size_t ParameterSweep::getNumVariants(const SweepStage stage) const
+{
+    std::size_t numVariants{1};
+    for (std::size_t i{0}; i <= static_cast<std::size_t>(stage); ++i) {
+        numVariants *= mVariants[i].size();
+    }
+
+    return numVariants;
+}
+
+SweepCombination ParameterSweep::getCombination(const std::size_t combination) const
+{
+    const auto variantOf{[this, combination](const SweepStage stage) -> const SweepCombination& {
+        const auto& variants{mVariants[static_cast<std::size_t>(stage)]};
+        return variants[getVariant(combination, stage) % variants.size()];
+    }};
+
+    return SweepCombination{variantOf(SweepStage::PREPROCESSING).mPreprocessing,
+                            variantOf(SweepStage::CONNECTIONS).mConnectionDetection,
+                            variantOf(SweepStage::COMPONENTS).mComponentDetection,
+                            variantOf(SweepStage::LABELS).mLabelDetection};
+}
+
+const std::vector<std::string>& ParameterSweep::getImagePaths() const
+{
+    return mImagePaths;
+}
+
+std::string ParameterSweep::getOutputPath() const
+{
+    return mOutputPath;
+}
+
+const std::vector<SweepResult>& ParameterSweep::getResults() const
+{
+    return mResults;
+}
+
+std::size_t ParameterSweep::getVariant(const std::size_t combination, const SweepStage stage) const
+{
+    // The combinations are ordered by the stages, so the variants of the stages after it vary first
+    auto variant{combination};
+    for (auto i{static_cast<std::size_t>(stage) + 1}; i < cNumStages; ++i) {
+        variant /= mVariants[i].size();
+    }
+
+    return variant;
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,279 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "ImagePreprocessing.h"
+#include "ImageReceiver.h"
+#include "common/Preset.h"
+#include "common/ThreadPool.h"
+#include "computerVision/OpenCvWrapper.h"
+#include "logging/Logger.h"
+#include "output/ImageWriter.h"
+#include "schematicSegmentation/ComponentDetection.h"
+#include "schematicSegmentation/ConnectionDetection.h"
+#include "schematicSegmentation/LabelDetection.h"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Parameters of the stages of the pipeline, for a combination of a parameter sweep.
+ */
+struct SweepCombination
+{
+    /** Parameters of the preprocessing. */
+    ImagePreprocessing::Parameters mPreprocessing{};
+    /** Parameters of the detection of connections and nodes. */
+    schematicSegmentation::ConnectionDetection::Parameters mConnectionDetection{};
+    /** Parameters of the detection of components. */
+    schematicSegmentation::ComponentDetection::Parameters mComponentDetection{};
+    /** Parameters of the detection of labels. */
+    schematicSegmentation::LabelDetection::Parameters mLabelDetection{};
+};
+
+/**
+ * @brief Result of a combination of a parameter sweep for an image.
+ */
+struct SweepResult
+{
+    /** Image path. */
+    std::string mImagePath{};
+    /** Index of the combination. */
+    std::size_t mCombination{0};
+    /** Flag of the components, connections and nodes detected. */
+    bool mSuccess{false};
+    /** Wall-clock time of the preprocessing, in milliseconds. */
+    double mPreprocessingTimeMs{0};
+    /** Wall-clock time of the detection of connections, in milliseconds. */
+    double mConnectionsTimeMs{0};
+    /** Wall-clock time of the detection of components and nodes, in milliseconds. */
+    double mComponentsTimeMs{0};
+    /** Wall-clock time of the detection and association of labels, in milliseconds. */
+    double mLabelsTimeMs{0};
+    /** Number of components detected. */
+    std::size_t mNumComponents{0};
+    /** Number of connections detected. */
+    std::size_t mNumConnections{0};
+    /** Number of nodes detected. */
+    std::size_t mNumNodes{0};
+    /** Number of labels detected. */
+    std::size_t mNumLabels{0};
+};
+
+/**
+ * @brief Sweep of the parameters of the pipeline over a corpus of images, which computes each upstream result shared
+ * by many combinations only once.
+ *
+ * The sweep is loaded from a JSON configuration (see @ref loadConfig), with the images (files or folders), the preset
+ * whose parameters are the base of the combinations, the CSV file of the results, and the values of each parameter
+ * swept:
+ *
+ * ```json
+ * {
+ *     "images": ["validation/"],
+ *     "preset": "balanced",
+ *     "output": "sweep.csv",
+ *     "parameters": {
+ *         "thresholdBlockSize": [15, 21, 25],
+ *         "connectionMinLength": [10, 20],
+ *         "componentBoxMinArea": [200, 300, 400]
+ *     }
+ * }
+ * ```
+ *
+ * The combinations are the cartesian product of the values, ordered by the stages of the pipeline: preprocessing,
+ * detection of connections, detection of components (with the update of the connections and the nodes) and detection
+ * of labels. So the combinations that share the parameters of a stage and of the stages before it share its result:
+ * for each image, each distinct preprocessing runs once, each distinct detection of connections runs once on its
+ * preprocessed image, and so on. The results of each stage are computed in parallel by a pool of threads, and the
+ * upstream results are only read by the stages after them.
+ *
+ * The CSV file has a row for each image and combination, with the parameters, the time of each stage (a stage shared
+ * by many combinations is measured once) and the number of elements detected.
+ */
+class ParameterSweep
+{
+public:
+    /**
+     * @brief Enumeration of the stages of the pipeline whose parameters are swept.
+     */
+    enum class SweepStage : unsigned char {
+        /** Preprocessing. */
+        PREPROCESSING = 0,
+        /** Detection of connections. */
+        CONNECTIONS = 1,
+        /** Detection of components, and update of the connections and nodes. */
+        COMPONENTS = 2,
+        /** Detection and association of labels. */
+        LABELS = 3
+    };
+
+    /** Number of stages whose parameters are swept. */
+    static constexpr std::size_t cNumStages{4};
+    /** Default path of the CSV file of the results. */
+    static constexpr auto cDefaultOutputPath{"sweep.csv"};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param imageReceiver Image receiver.
+     * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
+     * @param logger Logger.
+     * @param numThreads Number of threads for the stages.
+     * @param threadStart Function called by each thread for the stages when it starts (e.g. to pin it to a core).
+     */
+    explicit ParameterSweep(const std::shared_ptr<ImageReceiver>& imageReceiver,
+                            const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                            const std::shared_ptr<output::ImageWriter>& imageWriter,
+                            const std::shared_ptr<logging::Logger>& logger,
+                            const unsigned int numThreads,
+                            const common::ThreadPool::ThreadStart& threadStart = {});
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~ParameterSweep() = default;
+
+    /**
+     * @brief Loads the sweep from a JSON configuration file.
+     *
+     * @param configPath Path of the configuration file.
+     * @param preset Preset whose parameters are the base of the combinations, if the configuration has no preset.
+     *
+     * @return True if the configuration is valid, otherwise false.
+     */
+    virtual bool loadConfig(const std::string& configPath, const common::Preset preset);
+
+    /**
+     * @brief Parses the sweep from a JSON configuration.
+     *
+     * @param config Configuration.
+     * @param preset Preset whose parameters are the base of the combinations, if the configuration has no preset.
+     *
+     * @return True if the configuration is valid, otherwise false.
+     */
+    virtual bool parseConfig(const nlohmann::ordered_json& config, const common::Preset preset);
+
+    /**
+     * @brief Runs the sweep over the images, and writes the CSV file of the results.
+     *
+     * @return True if all the images were received and the results were written, otherwise false.
+     */
+    virtual bool run();
+
+    /**
+     * @brief Writes the results as CSV.
+     *
+     * @param stream Stream.
+     */
+    virtual void writeCsv(std::ostream& stream) const;
+
+    /**
+     * @brief Gets the number of combinations.
+     *
+     * @return Number of combinations.
+     */
+    [[nodiscard]] virtual std::size_t getNumCombinations() const;
+
+    /**
+     * @brief Gets the number of distinct parameters of a stage and of the stages before it, i.e. the number of times
+     * the stage runs for each image.
+     *
+     * @param stage Stage.
+     *
+     * @return Number of distinct parameters.
+     */
+    [[nodiscard]] virtual std::size_t getNumVariants(const SweepStage stage) const;
+
+    /**
+     * @brief Gets a combination.
+     *
+     * @param combination Index of the combination.
+     *
+     * @return Parameters of the combination.
+     */
+    [[nodiscard]] virtual SweepCombination getCombination(const std::size_t combination) const;
+
+    /**
+     * @brief Gets the image paths of the sweep, with the folders expanded to their files.
+     *
+     * @return Image paths.
+     */
+    [[nodiscard]] virtual const std::vector<std::string>& getImagePaths() const;
+
+    /**
+     * @brief Gets the path of the CSV file of the results.
+     *
+     * @return Path of the CSV file.
+     */
+    [[nodiscard]] virtual std::string getOutputPath() const;
+
+    /**
+     * @brief Gets the results of the sweep.
+     *
+     * @return Results, for each image in the order of the combinations.
+     */
+    [[nodiscard]] virtual const std::vector<SweepResult>& getResults() const;
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Sweeps the combinations for an image.
+     *
+     * @param imagePath Image path.
+     * @param imageInitial Image received.
+     */
+    virtual void sweepImage(const std::string& imagePath, computerVision::ImageMat& imageInitial);
+
+    /**
+     * @brief Gets the index of the variant of a stage used by a combination.
+     *
+     * @param combination Index of the combination.
+     * @param stage Stage.
+     *
+     * @return Index of the variant of the stage, among the variants of the stage and of the stages before it.
+     */
+    [[nodiscard]] virtual std::size_t getVariant(const std::size_t combination, const SweepStage stage) const;
+
+private:
+    /** Variants of the parameters of each stage (only the parameters of the stage are set in each variant). */
+    std::array<std::vector<SweepCombination>, cNumStages> mVariants{};
+
+    /** Image paths. */
+    std::vector<std::string> mImagePaths{};
+
+    /** Path of the CSV file of the results. */
+    std::string mOutputPath{cDefaultOutputPath};
+
+    /** Results of the sweep. */
+    std::vector<SweepResult> mResults{};
+
+    /** Image receiver. */
+    std::shared_ptr<ImageReceiver> mImageReceiver;
+
+    /** OpenCV wrapper. */
+    std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
+
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+
+    /** Pool of threads for the stages. */
+    common::ThreadPool mThreadPool;
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
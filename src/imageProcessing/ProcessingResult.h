@@ -0,0 +1,53 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "circuit/Component.h"
+#include "circuit/Connection.h"
+#include "circuit/Node.h"
+#include "schematicSegmentation/RoiSegmentation.h"
+#include <nlohmann/json.hpp>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Enumeration of the status codes of a processing.
+ */
+enum class ProcessingStatus : unsigned char {
+    /** Processing terminated successfully. */
+    SUCCESS = 0,
+    /** Processing failed (e.g. invalid image or no circuit found). */
+    FAILED = 1,
+    /** Processing stopped, because it was cancelled. */
+    CANCELLED = 2,
+    /** Processing stopped, because its deadline expired. */
+    DEADLINE_EXCEEDED = 3
+};
+
+/**
+ * @brief Result of the processing of an image, kept in memory.
+ */
+struct ProcessingResult
+{
+    /** Flag of processing terminated successfully. */
+    bool mSuccess{false};
+    /** Status of the processing. */
+    ProcessingStatus mStatus{ProcessingStatus::FAILED};
+    /** Components detected. */
+    std::vector<circuit::Component> mComponents{};
+    /** Connections detected. */
+    std::vector<circuit::Connection> mConnections{};
+    /** Nodes detected. */
+    std::vector<circuit::Node> mNodes{};
+    /** Segmentation map. */
+    nlohmann::ordered_json mSegmentationMap{};
+    /** Images with ROI of components and labels (encoded only if enabled in the manager). */
+    std::vector<schematicSegmentation::RoiImage> mRoiImages{};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,339 @@
+/**
+ * @file
+ */
+
+#include "ResultCache.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+#include <tuple>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+ResultCache::ResultCache(const std::string& directory,
+                         const std::size_t maxBytes,
+                         const std::shared_ptr<logging::Logger>& logger)
+    : mDirectory{directory}
+    , mMaxBytes{maxBytes}
+    , mLogger{logger}
+{
+}
+
+bool ResultCache::open()
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    std::error_code ec{};
+    std::filesystem::create_directories(mDirectory, ec);
+    if (ec || !std::filesystem::is_directory(mDirectory)) {
+        mLogger->logError("Invalid cache folder: {}", mDirectory.string());
+        return false;
+    }
+
+    mOrderOfUse.clear();
+    mEntries.clear();
+    mStatistics.mBytes = 0;
+
+    // Results stored by previous runs, with the time of their last use
+    std::vector<std::tuple<std::filesystem::file_time_type, std::string, std::size_t>> results{};
+    for (const auto& entry : std::filesystem::directory_iterator{mDirectory, ec}) {
+        const auto key{entry.path().filename().string()};
+        if (!entry.is_directory(ec)) {
+            continue;
+        }
+
+        // Results left incomplete by an interrupted store
+        const auto segmentationMapPath{entry.path() / cSegmentationMapFile};
+        if (key.front() == '.' || !std::filesystem::is_regular_file(segmentationMapPath)) {
+            std::filesystem::remove_all(entry.path(), ec);
+            continue;
+        }
+
+        results.emplace_back(
+            std::filesystem::last_write_time(segmentationMapPath, ec), key, getDirectorySize(entry.path()));
+    }
+
+    // Index, from the most to the least recently used
+    std::sort(results.begin(), results.end());
+    for (const auto& [lastUse, key, bytes] : results) {
+        mOrderOfUse.push_front(key);
+        mEntries[key] = Entry{bytes, mOrderOfUse.begin()};
+        mStatistics.mBytes += bytes;
+    }
+    evict(0);
+
+    mLogger->logInfo("Cache folder {}: {} results, {} bytes of {} bytes",
+                     mDirectory.string(),
+                     mEntries.size(),
+                     mStatistics.mBytes,
+                     mMaxBytes);
+
+    return true;
+}
+
+bool ResultCache::find(const std::string& key, CachedResult& result)
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    const auto entry{mEntries.find(key)};
+    if (entry == mEntries.end()) {
+        ++mStatistics.mMisses;
+        return false;
+    }
+
+    // A result that cannot be read is no longer useful
+    const auto directory{mDirectory / key};
+    if (!readResult(directory, result)) {
+        mLogger->logWarning("Invalid result {} removed from the cache", key);
+        remove(key);
+        ++mStatistics.mMisses;
+        return false;
+    }
+
+    // Most recently used, also for the next runs
+    mOrderOfUse.splice(mOrderOfUse.begin(), mOrderOfUse, entry->second.mPosition);
+    std::error_code ec{};
+    std::filesystem::last_write_time(
+        directory / cSegmentationMapFile, std::filesystem::file_time_type::clock::now(), ec);
+    ++mStatistics.mHits;
+
+    return true;
+}
+
+bool ResultCache::store(const std::string& key,
+                        const nlohmann::ordered_json& segmentationMap,
+                        const std::vector<schematicSegmentation::RoiImage>& roiImages,
+                        const std::string& sourceDirectory)
+{
+    // Hidden folder of this store, unless the result was already stored
+    std::filesystem::path temporaryDirectory{};
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        if (mEntries.count(key) > 0) {
+            return true;
+        }
+        temporaryDirectory = mDirectory / ("." + key + "." + std::to_string(++mTemporaryCounter));
+    }
+
+    // Result written without holding the mutex, so the lookups are not blocked
+    std::error_code ec{};
+    if (!writeResult(temporaryDirectory, segmentationMap, roiImages, sourceDirectory)) {
+        mLogger->logWarning("Failed to store result {} in the cache", key);
+        std::filesystem::remove_all(temporaryDirectory, ec);
+        return false;
+    }
+    const auto bytes{getDirectorySize(temporaryDirectory)};
+    if (bytes > mMaxBytes) {
+        mLogger->logWarning("Result {} of {} bytes is larger than the cache", key, bytes);
+        std::filesystem::remove_all(temporaryDirectory, ec);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    // Result stored meanwhile by another manager
+    if (mEntries.count(key) > 0) {
+        std::filesystem::remove_all(temporaryDirectory, ec);
+        return true;
+    }
+
+    // Room for the result, which then appears complete
+    evict(bytes);
+    std::filesystem::rename(temporaryDirectory, mDirectory / key, ec);
+    if (ec) {
+        mLogger->logWarning("Failed to store result {} in the cache: {}", key, ec.message());
+        std::filesystem::remove_all(temporaryDirectory, ec);
+        return false;
+    }
+
+    mOrderOfUse.push_front(key);
+    mEntries[key] = Entry{bytes, mOrderOfUse.begin()};
+    mStatistics.mBytes += bytes;
+    ++mStatistics.mStores;
+
+    return true;
+}
+
+ResultCacheStatistics ResultCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    auto statistics{mStatistics};
+    statistics.mEntries = mEntries.size();
+
+    return statistics;
+}
+
+double ResultCache::getHitRate() const
+{
+    const auto statistics{getStatistics()};
+    const auto lookups{statistics.mHits + statistics.mMisses};
+
+    return lookups > 0 ? static_cast<double>(statistics.mHits) / static_cast<double>(lookups) : 0.0;
+}
+
+std::string ResultCache::getDirectory() const
+{
+    return mDirectory.string();
+}
+
+std::size_t ResultCache::getMaxBytes() const
+{
+    return mMaxBytes;
+}
+
+std::string ResultCache::makeKey(const std::uint64_t imageHash,
+                                 const common::Preset preset,
+                                 const bool deterministicIds,
+                                 const int tileSize,
+                                 const int bandHeight)
+{
+    std::ostringstream key{};
+    key << std::hex << std::setw(16) << std::setfill('0') << imageHash << "_" << common::getPresetName(preset);
+    // The results with random IDs are not reused when deterministic IDs are requested
+    if (deterministicIds) {
+        key << "_deterministic";
+    }
+    // The segmentation by tiles and the preprocessing by bands give different elements than the whole image
+    if (tileSize > 0) {
+        key << "_tile" << std::dec << tileSize;
+    }
+    if (bandHeight > 0) {
+        key << "_band" << std::dec << bandHeight;
+    }
+
+    return key.str();
+}
+
+bool ResultCache::writeResult(const std::filesystem::path& directory,
+                              const nlohmann::ordered_json& segmentationMap,
+                              const std::vector<schematicSegmentation::RoiImage>& roiImages,
+                              const std::filesystem::path& sourceDirectory)
+{
+    std::error_code ec{};
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Images with ROI: the encoded image, or a copy of its file
+    nlohmann::ordered_json jsonRoiImages = nlohmann::ordered_json::array();
+    for (const auto& roiImage : roiImages) {
+        const auto filePath{directory / roiImage.mFileName};
+        if (!roiImage.mEncodedImage.empty()) {
+            std::ofstream file{filePath, std::ios::binary};
+            file.write(reinterpret_cast<const char*>(roiImage.mEncodedImage.data()),
+                       static_cast<std::streamsize>(roiImage.mEncodedImage.size()));
+            if (!file) {
+                return false;
+            }
+        } else if (!std::filesystem::copy_file(sourceDirectory / roiImage.mFileName, filePath, ec) || ec) {
+            return false;
+        }
+
+        nlohmann::ordered_json jsonRoiImage{};
+        jsonRoiImage["kind"] = roiImage.mKind == schematicSegmentation::RoiImage::Kind::LABEL ? "label" : "component";
+        jsonRoiImage["elementId"] = roiImage.mElementId;
+        jsonRoiImage["index"] = roiImage.mIndex;
+        jsonRoiImage["roi"]["x"] = roiImage.mRoi.x;
+        jsonRoiImage["roi"]["y"] = roiImage.mRoi.y;
+        jsonRoiImage["roi"]["width"] = roiImage.mRoi.width;
+        jsonRoiImage["roi"]["height"] = roiImage.mRoi.height;
+        jsonRoiImage["file"] = roiImage.mFileName;
+        jsonRoiImages.push_back(jsonRoiImage);
+    }
+
+    std::ofstream roiImagesFile{directory / cRoiImagesFile};
+    roiImagesFile << jsonRoiImages << std::endl;
+
+    // Segmentation map last, since it marks a complete result
+    std::ofstream segmentationMapFile{directory / cSegmentationMapFile};
+    segmentationMapFile << std::setw(4) << segmentationMap << std::endl;
+
+    return roiImagesFile && segmentationMapFile;
+}
+
+bool ResultCache::readResult(const std::filesystem::path& directory, CachedResult& result)
+{
+    try {
+        std::ifstream segmentationMapFile{directory / cSegmentationMapFile};
+        std::ifstream roiImagesFile{directory / cRoiImagesFile};
+        if (!segmentationMapFile || !roiImagesFile) {
+            return false;
+        }
+        result.mSegmentationMap = nlohmann::ordered_json::parse(segmentationMapFile);
+
+        result.mRoiImages.clear();
+        for (const auto& jsonRoiImage : nlohmann::ordered_json::parse(roiImagesFile)) {
+            schematicSegmentation::RoiImage roiImage{};
+            roiImage.mKind = jsonRoiImage.at("kind") == "label" ? schematicSegmentation::RoiImage::Kind::LABEL
+                                                                 : schematicSegmentation::RoiImage::Kind::COMPONENT;
+            roiImage.mElementId = jsonRoiImage.at("elementId").get<std::string>();
+            roiImage.mIndex = jsonRoiImage.at("index").get<unsigned int>();
+            roiImage.mRoi = computerVision::Rectangle{jsonRoiImage.at("roi").at("x").get<int>(),
+                                                      jsonRoiImage.at("roi").at("y").get<int>(),
+                                                      jsonRoiImage.at("roi").at("width").get<int>(),
+                                                      jsonRoiImage.at("roi").at("height").get<int>()};
+            roiImage.mFileName = jsonRoiImage.at("file").get<std::string>();
+
+            std::ifstream file{directory / roiImage.mFileName, std::ios::binary};
+            if (!file) {
+                return false;
+            }
+            roiImage.mEncodedImage.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+
+            result.mRoiImages.push_back(std::move(roiImage));
+        }
+    }
+    catch (const nlohmann::ordered_json::exception& ex) {
+        mLogger->logError("An exception occurred while reading result of the cache: {}", ex.what());
+        return false;
+    }
+
+    return true;
+}
+
+void ResultCache::evict(const std::size_t bytes)
+{
+    while (!mOrderOfUse.empty() && mStatistics.mBytes + bytes > mMaxBytes) {
+        const auto key{mOrderOfUse.back()};
+        mLogger->logDebug("Result {} evicted from the cache", key);
+        remove(key);
+        ++mStatistics.mEvictions;
+    }
+}
+
+void ResultCache::remove(const std::string& key)
+{
+    const auto entry{mEntries.find(key)};
+    if (entry == mEntries.end()) {
+        return;
+    }
+
+    mStatistics.mBytes -= entry->second.mBytes;
+    mOrderOfUse.erase(entry->second.mPosition);
+    mEntries.erase(entry);
+
+    std::error_code ec{};
+    std::filesystem::remove_all(mDirectory / key, ec);
+}
+
+std::size_t ResultCache::getDirectorySize(const std::filesystem::path& directory)
+{
+    std::size_t size{0};
+    std::error_code ec{};
+    for (const auto& entry : std::filesystem::directory_iterator{directory, ec}) {
+        if (entry.is_regular_file(ec)) {
+            size += static_cast<std::size_t>(entry.file_size(ec));
+        }
+    }
+
+    return size;
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,265 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "common/Preset.h"
+#include "logging/Logger.h"
+#include "schematicSegmentation/RoiSegmentation.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Result of a processing stored in the cache.
+ */
+struct CachedResult
+{
+    /** Segmentation map. */
+    nlohmann::ordered_json mSegmentationMap{};
+    /** Images with ROI of components and labels, always with their encoded image. */
+    std::vector<schematicSegmentation::RoiImage> mRoiImages{};
+};
+
+/**
+ * @brief Statistics of the cache.
+ */
+struct ResultCacheStatistics
+{
+    /** Number of lookups that found a result. */
+    std::uint64_t mHits{0};
+    /** Number of lookups that did not find a result. */
+    std::uint64_t mMisses{0};
+    /** Number of results stored. */
+    std::uint64_t mStores{0};
+    /** Number of results evicted to keep the cache under its maximum size. */
+    std::uint64_t mEvictions{0};
+    /** Number of results in the cache. */
+    std::size_t mEntries{0};
+    /** Size of the results in the cache, in bytes. */
+    std::size_t mBytes{0};
+};
+
+/**
+ * @brief Persistent cache of the results of the processings, keyed by the content of the images.
+ *
+ * Each result is a folder of the cache folder, named by its key, with the segmentation map, the metadata of the images
+ * with ROI and the encoded images with ROI. The key is a hash of the decoded pixels and the settings of the processing
+ * that change its result (see @ref makeKey), so an image received again (e.g. resubmitted, or in another file
+ * format) skips the preprocessing and the detection.
+ *
+ * The size of the cache is bounded: the least recently used results are evicted when a new result does not fit. The
+ * order of use is kept in the modification time of the segmentation maps, so it survives restarts. A result is first
+ * written to a hidden folder and then renamed, so an interrupted store is never found. The cache can be shared by
+ * many managers, but the cache folder must not be shared by many processes.
+ */
+class ResultCache
+{
+public:
+    /** Name of the segmentation map file of a result. */
+    static constexpr auto cSegmentationMapFile{"segmentation_map.json"};
+    /** Name of the file with the metadata of the images with ROI of a result. */
+    static constexpr auto cRoiImagesFile{"roi_images.json"};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param directory Cache folder (created if it does not exist).
+     * @param maxBytes Maximum size of the results in the cache, in bytes.
+     * @param logger Logger.
+     */
+    explicit ResultCache(const std::string& directory,
+                         const std::size_t maxBytes,
+                         const std::shared_ptr<logging::Logger>& logger);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~ResultCache() = default;
+
+    /**
+     * @brief Opens the cache, indexing the results stored by previous runs.
+     *
+     * The results left incomplete are removed, and the least recently used results are evicted if the cache is larger
+     * than its maximum size.
+     *
+     * @return True if the cache folder exists and can be read, otherwise false.
+     */
+    virtual bool open();
+
+    /**
+     * @brief Finds the result of a key, marking it as the most recently used.
+     *
+     * @param key Key of the result.
+     * @param result Result found.
+     *
+     * @return True if the result was found, otherwise false.
+     */
+    virtual bool find(const std::string& key, CachedResult& result);
+
+    /**
+     * @brief Stores the result of a key, evicting the least recently used results if it does not fit.
+     *
+     * @param key Key of the result.
+     * @param segmentationMap Segmentation map.
+     * @param roiImages Images with ROI. The encoded image of each one is used, or its file in the source folder if
+     * it is not encoded.
+     * @param sourceDirectory Folder with the files of the images with ROI that are not encoded.
+     *
+     * @return True if the result was stored, otherwise false (e.g. larger than the cache or files missing).
+     */
+    virtual bool store(const std::string& key,
+                       const nlohmann::ordered_json& segmentationMap,
+                       const std::vector<schematicSegmentation::RoiImage>& roiImages,
+                       const std::string& sourceDirectory);
+
+    /**
+     * @brief Gets the statistics of the cache.
+     *
+     * @return Statistics.
+     */
+    [[nodiscard]] virtual ResultCacheStatistics getStatistics() const;
+
+    /**
+     * @brief Gets the ratio of lookups that found a result.
+     *
+     * @return Hit rate, from 0 to 1 (0 without lookups).
+     */
+    [[nodiscard]] virtual double getHitRate() const;
+
+    /**
+     * @brief Gets the cache folder.
+     *
+     * @return Cache folder.
+     */
+    [[nodiscard]] virtual std::string getDirectory() const;
+
+    /**
+     * @brief Gets the maximum size of the results in the cache.
+     *
+     * @return Maximum size, in bytes.
+     */
+    [[nodiscard]] virtual std::size_t getMaxBytes() const;
+
+    /**
+     * @brief Makes the key of the result of an image.
+     *
+     * @param imageHash Hash of the decoded pixels of the image (see @ref computerVision::OpenCvWrapper::hashImage).
+     * @param preset Preset of the processing, which sets all its parameters.
+     * @param deterministicIds Flag of the processing assigning deterministic IDs to the elements.
+     * @param tileSize Size of the tiles of the segmentation, in pixels (0 if the image is segmented as a whole).
+     * @param bandHeight Height of the bands of the preprocessing, in rows (0 if the image is preprocessed as a whole).
+     *
+     * @return Key.
+     */
+    static std::string makeKey(const std::uint64_t imageHash,
+                               const common::Preset preset,
+                               const bool deterministicIds = false,
+                               const int tileSize = 0,
+                               const int bandHeight = 0);
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Writes a result to a folder.
+     *
+     * @param directory Folder of the result.
+     * @param segmentationMap Segmentation map.
+     * @param roiImages Images with ROI.
+     * @param sourceDirectory Folder with the files of the images with ROI that are not encoded.
+     *
+     * @return True if the result was written, otherwise false.
+     */
+    virtual bool writeResult(const std::filesystem::path& directory,
+                             const nlohmann::ordered_json& segmentationMap,
+                             const std::vector<schematicSegmentation::RoiImage>& roiImages,
+                             const std::filesystem::path& sourceDirectory);
+
+    /**
+     * @brief Reads a result from a folder.
+     *
+     * @param directory Folder of the result.
+     * @param result Result read.
+     *
+     * @return True if the result was read, otherwise false (e.g. files missing or invalid).
+     */
+    virtual bool readResult(const std::filesystem::path& directory, CachedResult& result);
+
+    /**
+     * @brief Evicts the least recently used results until a size fits in the cache.
+     *
+     * The mutex must be locked by the caller.
+     *
+     * @param bytes Size to fit, in bytes.
+     */
+    virtual void evict(const std::size_t bytes);
+
+    /**
+     * @brief Removes a result from the index and from the cache folder.
+     *
+     * The mutex must be locked by the caller.
+     *
+     * @param key Key of the result.
+     */
+    virtual void remove(const std::string& key);
+
+    /**
+     * @brief Gets the size of the files of a folder.
+     *
+     * @param directory Folder.
+     *
+     * @return Size of the files, in bytes.
+     */
+    static std::size_t getDirectorySize(const std::filesystem::path& directory);
+
+private:
+    /**
+     * @brief Result in the index of the cache.
+     */
+    struct Entry
+    {
+        /** Size of the result, in bytes. */
+        std::size_t mBytes{0};
+        /** Position of the result in the order of use. */
+        std::list<std::string>::iterator mPosition{};
+    };
+
+    /** Cache folder. */
+    std::filesystem::path mDirectory;
+
+    /** Maximum size of the results in the cache, in bytes. */
+    std::size_t mMaxBytes;
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+
+    /** Mutex for the index and the cache folder. */
+    mutable std::mutex mMutex;
+
+    /** Keys of the results, from the most to the least recently used. */
+    std::list<std::string> mOrderOfUse{};
+
+    /** Results in the cache, by key. */
+    std::unordered_map<std::string, Entry> mEntries{};
+
+    /** Statistics of the cache. */
+    ResultCacheStatistics mStatistics{};
+
+    /** Counter to name the hidden folders of the results being stored. */
+    std::uint64_t mTemporaryCounter{0};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
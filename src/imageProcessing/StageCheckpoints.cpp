@@ -0,0 +1,767 @@
+/**
+ * @file
+ */
+
+#include "StageCheckpoints.h"
+#include "ImagePreprocessing.h"
+#include "common/ContentHash.h"
+#include "schematicSegmentation/ComponentDetection.h"
+#include "schematicSegmentation/ConnectionDetection.h"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#define MEMORY_MAPPING_SUPPORTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+namespace {
+
+/**
+ * @brief Checkpoint file, mapped in memory (or read to memory, without memory mapping) while the object exists.
+ */
+class CheckpointFile
+{
+public:
+    /**
+     * @brief Constructor, mapping the file.
+     *
+     * @param path Path of the file.
+     */
+    explicit CheckpointFile(const std::filesystem::path& path)
+    {
+#ifdef MEMORY_MAPPING_SUPPORTED
+        const auto fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (fd < 0) {
+            return;
+        }
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+            const auto size{static_cast<std::size_t>(fileStat.st_size)};
+            auto* mapping{mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+            if (mapping != MAP_FAILED) {
+                mData = static_cast<const unsigned char*>(mapping);
+                mSize = size;
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream file{path, std::ios::binary};
+        mBuffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+        mData = mBuffer.data();
+        mSize = mBuffer.size();
+#endif
+    }
+
+    /**
+     * @brief Destructor, unmapping the file.
+     */
+    ~CheckpointFile()
+    {
+#ifdef MEMORY_MAPPING_SUPPORTED
+        if (mData != nullptr) {
+            munmap(const_cast<unsigned char*>(mData), mSize);
+        }
+#endif
+    }
+
+    CheckpointFile(const CheckpointFile&) = delete;
+    CheckpointFile& operator=(const CheckpointFile&) = delete;
+
+    /**
+     * @brief Gets the contents of the file.
+     *
+     * @return Contents of the file (null if it could not be read).
+     */
+    [[nodiscard]] const unsigned char* data() const
+    {
+        return mData;
+    }
+
+    /**
+     * @brief Gets the size of the file.
+     *
+     * @return Size of the file, in bytes.
+     */
+    [[nodiscard]] std::size_t size() const
+    {
+        return mSize;
+    }
+
+private:
+#ifndef MEMORY_MAPPING_SUPPORTED
+    /** Contents of the file, read to memory. */
+    std::vector<unsigned char> mBuffer{};
+#endif
+    /** Contents of the file. */
+    const unsigned char* mData{nullptr};
+    /** Size of the file, in bytes. */
+    std::size_t mSize{0};
+};
+
+/**
+ * @brief Writer of the payload of a checkpoint.
+ */
+class PayloadWriter
+{
+public:
+    /**
+     * @brief Writes a value with a fixed size.
+     *
+     * @param value Value.
+     */
+    template<typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes{reinterpret_cast<const unsigned char*>(&value)};
+        mPayload.insert(mPayload.end(), bytes, bytes + sizeof(T));
+    }
+
+    /**
+     * @brief Writes a string, after its size.
+     *
+     * @param value String.
+     */
+    void write(const std::string& value)
+    {
+        write(static_cast<std::uint32_t>(value.size()));
+        mPayload.insert(mPayload.end(), value.begin(), value.end());
+    }
+
+    /**
+     * @brief Writes a list, after its number of elements.
+     *
+     * @param values List.
+     * @param writeValue Function to write each element.
+     */
+    template<typename T, typename Function>
+    void writeList(const std::vector<T>& values, Function writeValue)
+    {
+        write(static_cast<std::uint32_t>(values.size()));
+        for (const auto& value : values) {
+            writeValue(*this, value);
+        }
+    }
+
+    /** Payload written. */
+    std::vector<unsigned char> mPayload{};
+};
+
+/**
+ * @brief Reader of the payload of a checkpoint, which fails instead of reading past its end.
+ */
+class PayloadReader
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param data Payload.
+     * @param size Size of the payload, in bytes.
+     */
+    PayloadReader(const unsigned char* data, const std::size_t size)
+        : mData{data}
+        , mRemaining{size}
+    {
+    }
+
+    /**
+     * @brief Reads a value with a fixed size.
+     *
+     * @param value Value read.
+     *
+     * @return True if the value was read, otherwise false.
+     */
+    template<typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (mRemaining < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, mData, sizeof(T));
+        mData += sizeof(T);
+        mRemaining -= sizeof(T);
+
+        return true;
+    }
+
+    /**
+     * @brief Reads a string, after its size.
+     *
+     * @param value String read.
+     *
+     * @return True if the string was read, otherwise false.
+     */
+    bool read(std::string& value)
+    {
+        std::uint32_t size{0};
+        if (!read(size) || mRemaining < size) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(mData), size);
+        mData += size;
+        mRemaining -= size;
+
+        return true;
+    }
+
+    /**
+     * @brief Reads a list, after its number of elements.
+     *
+     * @param values List read.
+     * @param readValue Function to read each element.
+     *
+     * @return True if the list was read, otherwise false.
+     */
+    template<typename T, typename Function>
+    bool readList(std::vector<T>& values, Function readValue)
+    {
+        // Each element has at least one byte, so a corrupted number of elements is not allocated
+        std::uint32_t size{0};
+        if (!read(size) || mRemaining < size) {
+            return false;
+        }
+        values.assign(size, T{});
+        for (auto& value : values) {
+            if (!readValue(*this, value)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Checks if the payload was entirely read.
+     *
+     * @return True if there is nothing left to read, otherwise false.
+     */
+    [[nodiscard]] bool isEnd() const
+    {
+        return mRemaining == 0;
+    }
+
+private:
+    /** Payload left to read. */
+    const unsigned char* mData;
+    /** Size of the payload left to read, in bytes. */
+    std::size_t mRemaining;
+};
+
+/**
+ * @brief Writes a position.
+ *
+ * @param writer Writer.
+ * @param position Position.
+ */
+template<typename T>
+void writePosition(PayloadWriter& writer, const circuit::Position<T>& position)
+{
+    writer.write(position.mX);
+    writer.write(position.mY);
+    writer.write(position.mAngle);
+}
+
+/**
+ * @brief Reads a position.
+ *
+ * @param reader Reader.
+ * @param position Position read.
+ *
+ * @return True if the position was read, otherwise false.
+ */
+template<typename T>
+bool readPosition(PayloadReader& reader, circuit::Position<T>& position)
+{
+    return reader.read(position.mX) && reader.read(position.mY) && reader.read(position.mAngle);
+}
+
+/**
+ * @brief Writes a rectangle.
+ *
+ * @param writer Writer.
+ * @param rectangle Rectangle.
+ */
+void writeRectangle(PayloadWriter& writer, const computerVision::Rectangle& rectangle)
+{
+    writer.write(rectangle.x);
+    writer.write(rectangle.y);
+    writer.write(rectangle.width);
+    writer.write(rectangle.height);
+}
+
+/**
+ * @brief Reads a rectangle.
+ *
+ * @param reader Reader.
+ * @param rectangle Rectangle read.
+ *
+ * @return True if the rectangle was read, otherwise false.
+ */
+bool readRectangle(PayloadReader& reader, computerVision::Rectangle& rectangle)
+{
+    return reader.read(rectangle.x) && reader.read(rectangle.y) && reader.read(rectangle.width)
+           && reader.read(rectangle.height);
+}
+
+/**
+ * @brief Writes a label.
+ *
+ * @param writer Writer.
+ * @param label Label.
+ */
+void writeLabel(PayloadWriter& writer, const circuit::Label& label)
+{
+    writer.write(label.mId);
+    writer.write(label.mOwnerId);
+    writer.write(label.mName);
+    writer.write(label.mValue);
+    writer.write(label.mUnit);
+    writePosition(writer, label.mPosition);
+    writer.write(static_cast<std::uint8_t>(label.mIsNameHidden));
+    writer.write(static_cast<std::uint8_t>(label.mIsValueHidden));
+    writeRectangle(writer, label.mBoundingBox);
+}
+
+/**
+ * @brief Reads a label.
+ *
+ * @param reader Reader.
+ * @param label Label read.
+ *
+ * @return True if the label was read, otherwise false.
+ */
+bool readLabel(PayloadReader& reader, circuit::Label& label)
+{
+    std::uint8_t isNameHidden{0};
+    std::uint8_t isValueHidden{0};
+    if (!reader.read(label.mId) || !reader.read(label.mOwnerId) || !reader.read(label.mName)
+        || !reader.read(label.mValue) || !reader.read(label.mUnit) || !readPosition(reader, label.mPosition)
+        || !reader.read(isNameHidden) || !reader.read(isValueHidden) || !readRectangle(reader, label.mBoundingBox)) {
+        return false;
+    }
+    label.mIsNameHidden = isNameHidden != 0;
+    label.mIsValueHidden = isValueHidden != 0;
+
+    return true;
+}
+
+/**
+ * @brief Writes a port.
+ *
+ * @param writer Writer.
+ * @param port Port.
+ */
+void writePort(PayloadWriter& writer, const circuit::Port& port)
+{
+    writer.write(port.mId);
+    writer.write(port.mOwnerId);
+    writer.write(port.mType);
+    writePosition(writer, port.mPosition);
+    writer.write(port.mConnectionId);
+}
+
+/**
+ * @brief Reads a port.
+ *
+ * @param reader Reader.
+ * @param port Port read.
+ *
+ * @return True if the port was read, otherwise false.
+ */
+bool readPort(PayloadReader& reader, circuit::Port& port)
+{
+    return reader.read(port.mId) && reader.read(port.mOwnerId) && reader.read(port.mType)
+           && readPosition(reader, port.mPosition) && reader.read(port.mConnectionId);
+}
+
+/**
+ * @brief Writes a point.
+ *
+ * @param writer Writer.
+ * @param point Point.
+ */
+void writePoint(PayloadWriter& writer, const computerVision::Point& point)
+{
+    writer.write(point.x);
+    writer.write(point.y);
+}
+
+/**
+ * @brief Reads a point.
+ *
+ * @param reader Reader.
+ * @param point Point read.
+ *
+ * @return True if the point was read, otherwise false.
+ */
+bool readPoint(PayloadReader& reader, computerVision::Point& point)
+{
+    return reader.read(point.x) && reader.read(point.y);
+}
+
+/**
+ * @brief Writes a component.
+ *
+ * @param writer Writer.
+ * @param component Component.
+ */
+void writeComponent(PayloadWriter& writer, const circuit::Component& component)
+{
+    writer.write(component.mId);
+    writer.write(component.mType);
+    writer.write(component.mFullName);
+    writePosition(writer, component.mPosition);
+    writeLabel(writer, component.mLabel);
+    writer.writeList(component.mPorts, writePort);
+    writeRectangle(writer, component.mBoundingBox);
+    writer.writeList(component.mLabels, writeLabel);
+}
+
+/**
+ * @brief Reads a component.
+ *
+ * @param reader Reader.
+ * @param component Component read.
+ *
+ * @return True if the component was read, otherwise false.
+ */
+bool readComponent(PayloadReader& reader, circuit::Component& component)
+{
+    return reader.read(component.mId) && reader.read(component.mType) && reader.read(component.mFullName)
+           && readPosition(reader, component.mPosition) && readLabel(reader, component.mLabel)
+           && reader.readList(component.mPorts, readPort) && readRectangle(reader, component.mBoundingBox)
+           && reader.readList(component.mLabels, readLabel);
+}
+
+/**
+ * @brief Writes a connection.
+ *
+ * @param writer Writer.
+ * @param connection Connection.
+ */
+void writeConnection(PayloadWriter& writer, const circuit::Connection& connection)
+{
+    writer.write(connection.mId);
+    writer.write(connection.mStartId);
+    writer.write(connection.mEndId);
+    writeLabel(writer, connection.mLabel);
+    writer.writeList(connection.mWire, writePoint);
+    writer.writeList(connection.mLabels, writeLabel);
+}
+
+/**
+ * @brief Reads a connection.
+ *
+ * @param reader Reader.
+ * @param connection Connection read.
+ *
+ * @return True if the connection was read, otherwise false.
+ */
+bool readConnection(PayloadReader& reader, circuit::Connection& connection)
+{
+    return reader.read(connection.mId) && reader.read(connection.mStartId) && reader.read(connection.mEndId)
+           && readLabel(reader, connection.mLabel) && reader.readList(connection.mWire, readPoint)
+           && reader.readList(connection.mLabels, readLabel);
+}
+
+/**
+ * @brief Writes a node.
+ *
+ * @param writer Writer.
+ * @param node Node.
+ */
+void writeNode(PayloadWriter& writer, const circuit::Node& node)
+{
+    writer.write(node.mId);
+    writer.write(node.mType);
+    writePosition(writer, node.mPosition);
+    writer.writeList(node.mConnectionIds, [](PayloadWriter& writer, const circuit::Id& id) { writer.write(id); });
+    writeLabel(writer, node.mLabel);
+    writer.writeList(node.mLabels, writeLabel);
+}
+
+/**
+ * @brief Reads a node.
+ *
+ * @param reader Reader.
+ * @param node Node read.
+ *
+ * @return True if the node was read, otherwise false.
+ */
+bool readNode(PayloadReader& reader, circuit::Node& node)
+{
+    return reader.read(node.mId) && reader.read(node.mType) && readPosition(reader, node.mPosition)
+           && reader.readList(node.mConnectionIds,
+                              [](PayloadReader& reader, circuit::Id& id) { return reader.read(id); })
+           && readLabel(reader, node.mLabel) && reader.readList(node.mLabels, readLabel);
+}
+
+/**
+ * @brief Validates a checkpoint file, getting its header.
+ *
+ * @param file Checkpoint file.
+ * @param stage Stage expected.
+ * @param header Header of the checkpoint.
+ *
+ * @return True if the header and the payload are valid, otherwise false.
+ */
+template<typename Header>
+bool validateCheckpoint(const CheckpointFile& file, const CheckpointStage stage, Header& header)
+{
+    if (file.data() == nullptr || file.size() < StageCheckpoints::cHeaderSize) {
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (header.mMagic != StageCheckpoints::cMagic || header.mVersion != StageCheckpoints::cVersion
+        || header.mStage != static_cast<std::uint32_t>(stage)
+        || header.mPayloadSize != file.size() - StageCheckpoints::cHeaderSize) {
+        return false;
+    }
+
+    common::ContentHash payloadHash{};
+    payloadHash.update(file.data() + StageCheckpoints::cHeaderSize, header.mPayloadSize);
+
+    return payloadHash.getDigest() == header.mPayloadHash;
+}
+
+} // namespace
+
+StageCheckpoints::StageCheckpoints(const std::string& directory,
+                                   const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                   const std::shared_ptr<logging::Logger>& logger)
+    : mDirectory{directory}
+    , mOpenCvWrapper{openCvWrapper}
+    , mLogger{logger}
+{
+    static_assert(sizeof(Header) <= cHeaderSize);
+}
+
+bool StageCheckpoints::open()
+{
+    std::error_code ec{};
+    std::filesystem::create_directories(mDirectory, ec);
+    if (ec || !std::filesystem::is_directory(mDirectory)) {
+        mLogger->logError("Invalid checkpoints folder: {}", mDirectory.string());
+        return false;
+    }
+
+    // Checkpoints left incomplete by an interrupted write
+    std::size_t numCheckpoints{0};
+    for (const auto& entry : std::filesystem::directory_iterator{mDirectory, ec}) {
+        const auto fileName{entry.path().filename().string()};
+        if (fileName.front() == '.') {
+            std::filesystem::remove(entry.path(), ec);
+        } else if (entry.path().extension() == cExtension) {
+            ++numCheckpoints;
+        }
+    }
+
+    mLogger->logInfo("Checkpoints folder {}: {} checkpoints", mDirectory.string(), numCheckpoints);
+
+    return true;
+}
+
+bool StageCheckpoints::storeImage(const std::string& key, computerVision::ImageMat& image)
+{
+    if (mOpenCvWrapper->isImageEmpty(image)) {
+        return false;
+    }
+
+    Header header{};
+    header.mStage = static_cast<std::uint32_t>(CheckpointStage::PREPROCESSING);
+    header.mWidth = mOpenCvWrapper->getImageWidth(image);
+    header.mHeight = mOpenCvWrapper->getImageHeight(image);
+    if (header.mWidth <= 0 || header.mHeight <= 0) {
+        return false;
+    }
+    header.mType = mOpenCvWrapper->getImageType(image);
+    header.mRowSize = mOpenCvWrapper->getImageSizeBytes(image) / static_cast<std::size_t>(header.mHeight);
+
+    // Pixels, row by row, without padding
+    std::vector<unsigned char> payload(header.mRowSize * static_cast<std::size_t>(header.mHeight));
+    for (std::int32_t row{0}; row < header.mHeight; ++row) {
+        std::memcpy(payload.data() + static_cast<std::size_t>(row) * header.mRowSize,
+                    mOpenCvWrapper->getImageRow(image, row),
+                    header.mRowSize);
+    }
+
+    return writeCheckpoint(key, header, payload);
+}
+
+bool StageCheckpoints::loadImage(const std::string& key, computerVision::ImageMat& image)
+{
+    const CheckpointFile file{getCheckpointPath(key)};
+
+    Header header{};
+    if (!validateCheckpoint(file, CheckpointStage::PREPROCESSING, header) || header.mHeight <= 0
+        || header.mRowSize * static_cast<std::uint64_t>(header.mHeight) != header.mPayloadSize) {
+        return false;
+    }
+
+    // Pixels copied from the mapping, which is released at the end
+    auto loadedImage{mOpenCvWrapper->copyImageBuffer(
+        file.data() + cHeaderSize, header.mWidth, header.mHeight, header.mRowSize, header.mType)};
+    if (mOpenCvWrapper->isImageEmpty(loadedImage)) {
+        return false;
+    }
+    image = loadedImage;
+
+    return true;
+}
+
+bool StageCheckpoints::storeElements(const std::string& key,
+                                     const std::vector<circuit::Component>& components,
+                                     const std::vector<circuit::Connection>& connections,
+                                     const std::vector<circuit::Node>& nodes)
+{
+    PayloadWriter writer{};
+    writer.writeList(components, writeComponent);
+    writer.writeList(connections, writeConnection);
+    writer.writeList(nodes, writeNode);
+
+    Header header{};
+    header.mStage = static_cast<std::uint32_t>(CheckpointStage::DETECTION);
+
+    return writeCheckpoint(key, header, writer.mPayload);
+}
+
+bool StageCheckpoints::loadElements(const std::string& key,
+                                    std::vector<circuit::Component>& components,
+                                    std::vector<circuit::Connection>& connections,
+                                    std::vector<circuit::Node>& nodes)
+{
+    const CheckpointFile file{getCheckpointPath(key)};
+
+    Header header{};
+    if (!validateCheckpoint(file, CheckpointStage::DETECTION, header)) {
+        return false;
+    }
+
+    PayloadReader reader{file.data() + cHeaderSize, header.mPayloadSize};
+    std::vector<circuit::Component> loadedComponents{};
+    std::vector<circuit::Connection> loadedConnections{};
+    std::vector<circuit::Node> loadedNodes{};
+    if (!reader.readList(loadedComponents, readComponent) || !reader.readList(loadedConnections, readConnection)
+        || !reader.readList(loadedNodes, readNode) || !reader.isEnd()) {
+        return false;
+    }
+
+    components = std::move(loadedComponents);
+    connections = std::move(loadedConnections);
+    nodes = std::move(loadedNodes);
+
+    return true;
+}
+
+std::string StageCheckpoints::getDirectory() const
+{
+    return mDirectory.string();
+}
+
+std::string StageCheckpoints::makeKey(const CheckpointStage stage,
+                                      const std::uint64_t imageHash,
+                                      const std::uint64_t parametersHash)
+{
+    std::ostringstream key{};
+    key << (stage == CheckpointStage::PREPROCESSING ? "preprocessing" : "detection") << "_" << std::hex
+        << std::setfill('0') << std::setw(16) << imageHash << "_" << std::setw(16) << parametersHash;
+
+    return key.str();
+}
+
+std::uint64_t StageCheckpoints::hashPreprocessingParameters(const common::Preset& preset, const int bandHeight)
+{
+    const auto parameters{ImagePreprocessing::getParameters(preset)};
+
+    // Each field, so the padding of the structure is not hashed
+    common::ContentHash contentHash{};
+    contentHash.update(&parameters.mFilterKernelSize, sizeof(parameters.mFilterKernelSize));
+    const auto thresholdMethod{static_cast<int>(parameters.mThresholdMethod)};
+    contentHash.update(&thresholdMethod, sizeof(thresholdMethod));
+    contentHash.update(&parameters.mThresholdBlockSize, sizeof(parameters.mThresholdBlockSize));
+    contentHash.update(&parameters.mThresholdSubConst, sizeof(parameters.mThresholdSubConst));
+    contentHash.update(&parameters.mMorphOpen, sizeof(parameters.mMorphOpen));
+    contentHash.update(&ImagePreprocessing::cResizeDim, sizeof(ImagePreprocessing::cResizeDim));
+    // Only hashed by bands, so the checkpoints of the images preprocessed as a whole stay valid
+    if (bandHeight > 0) {
+        contentHash.update(&bandHeight, sizeof(bandHeight));
+    }
+
+    return contentHash.getDigest();
+}
+
+std::uint64_t StageCheckpoints::hashDetectionParameters(const common::Preset& preset, const int bandHeight)
+{
+    const auto connectionParameters{schematicSegmentation::ConnectionDetection::getParameters(preset)};
+    const auto componentParameters{schematicSegmentation::ComponentDetection::getParameters(preset)};
+
+    common::ContentHash contentHash{hashPreprocessingParameters(preset, bandHeight)};
+    contentHash.update(&connectionParameters.mMorphCloseKernelSize, sizeof(connectionParameters.mMorphCloseKernelSize));
+    contentHash.update(&connectionParameters.mMorphCloseIter, sizeof(connectionParameters.mMorphCloseIter));
+    contentHash.update(&connectionParameters.mConnectionMinLength, sizeof(connectionParameters.mConnectionMinLength));
+    contentHash.update(&componentParameters.mMorphCloseKernelSize, sizeof(componentParameters.mMorphCloseKernelSize));
+    contentHash.update(&componentParameters.mMorphCloseIter, sizeof(componentParameters.mMorphCloseIter));
+    contentHash.update(&componentParameters.mBoxMinArea, sizeof(componentParameters.mBoxMinArea));
+
+    return contentHash.getDigest();
+}
+
+bool StageCheckpoints::writeCheckpoint(const std::string& key, Header header, const std::vector<unsigned char>& payload)
+{
+    common::ContentHash payloadHash{};
+    payloadHash.update(payload.data(), payload.size());
+    header.mPayloadSize = payload.size();
+    header.mPayloadHash = payloadHash.getDigest();
+
+    std::array<unsigned char, cHeaderSize> headerBytes{};
+    std::memcpy(headerBytes.data(), &header, sizeof(Header));
+
+    // Hidden file, renamed when complete
+    const auto path{getCheckpointPath(key)};
+    const auto temporaryPath{mDirectory / ("." + key + "." + std::to_string(++mTemporaryCounter))};
+    {
+        std::ofstream file{temporaryPath, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(headerBytes.data()), static_cast<std::streamsize>(cHeaderSize));
+        file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!file) {
+            mLogger->logWarning("Failed to write checkpoint {}", key);
+            std::error_code ec{};
+            std::filesystem::remove(temporaryPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec{};
+    std::filesystem::rename(temporaryPath, path, ec);
+    if (ec) {
+        mLogger->logWarning("Failed to write checkpoint {}: {}", key, ec.message());
+        std::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+std::filesystem::path StageCheckpoints::getCheckpointPath(const std::string& key) const
+{
+    return mDirectory / (key + cExtension);
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
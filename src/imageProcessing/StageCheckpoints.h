@@ -0,0 +1,248 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "circuit/Component.h"
+#include "circuit/Connection.h"
+#include "circuit/Node.h"
+#include "common/Preset.h"
+#include "computerVision/OpenCvWrapper.h"
+#include "logging/Logger.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Enumeration of the stages of the pipeline whose outputs are checkpointed.
+ */
+enum class CheckpointStage : std::uint32_t {
+    /** Image preprocessed (binary skeleton of the circuit). */
+    PREPROCESSING = 1,
+    /** Components, connections and nodes detected, before the detection of labels. */
+    DETECTION = 2
+};
+
+/**
+ * @brief Checkpoints of the outputs of the stages of the pipeline, so a processing of the same image with the same
+ * upstream parameters resumes after the last stage checkpointed.
+ *
+ * Each checkpoint is a file of the checkpoints folder, named by its key (see @ref makeKey), which combines the hash of
+ * the decoded image with the hash of the parameters of the stage and of the stages before it. So, when only the
+ * parameters of the detection of labels change, the preprocessing and the detection of the other elements are
+ * restored from their checkpoints, and only the labels are detected again.
+ *
+ * The files have a fixed header of 64 bytes (all fields in the native byte order), followed by the payload:
+ * - Magic `CSCK` (uint32), version (uint32), stage (uint32, as @ref CheckpointStage), reserved (uint32), size of the
+ *   payload (uint64) and hash of the payload (uint64, see @ref common::ContentHash).
+ * - For images: width (int32), height (int32), type (int32), reserved (int32) and size of each row (uint64). The
+ *   payload has the pixels, row by row, without padding.
+ * - For elements: the payload has the components, connections and nodes, each list with its number of elements
+ *   (uint32) followed by the fields of each element (strings with their size as uint32).
+ *
+ * The files are read through a memory mapping (Linux only, otherwise they are read to memory), and a checkpoint whose
+ * header or payload is invalid (e.g. truncated, or of an older version) is ignored. A checkpoint is first written to a
+ * hidden file and then renamed, so an interrupted write is never read. The checkpoints can be shared by many
+ * managers.
+ */
+class StageCheckpoints
+{
+public:
+    /** Magic number of the checkpoints ("CSCK" in little endian). */
+    static constexpr std::uint32_t cMagic{0x4B435343};
+    /** Version of the format of the checkpoints. */
+    static constexpr std::uint32_t cVersion{1};
+    /** Size of the header of the checkpoints, in bytes. */
+    static constexpr std::size_t cHeaderSize{64};
+    /** Extension of the checkpoint files. */
+    static constexpr auto cExtension{".ckpt"};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param directory Checkpoints folder (created if it does not exist).
+     * @param openCvWrapper OpenCV wrapper.
+     * @param logger Logger.
+     */
+    explicit StageCheckpoints(const std::string& directory,
+                              const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                              const std::shared_ptr<logging::Logger>& logger);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~StageCheckpoints() = default;
+
+    /**
+     * @brief Opens the checkpoints, creating their folder and removing the checkpoints left incomplete.
+     *
+     * @return True if the checkpoints were opened, otherwise false.
+     */
+    virtual bool open();
+
+    /**
+     * @brief Stores an image as a checkpoint.
+     *
+     * @param key Key of the checkpoint.
+     * @param image Image.
+     *
+     * @return True if the checkpoint was stored, otherwise false.
+     */
+    virtual bool storeImage(const std::string& key, computerVision::ImageMat& image);
+
+    /**
+     * @brief Loads an image from a checkpoint.
+     *
+     * @param key Key of the checkpoint.
+     * @param image Image loaded (a copy of the pixels of the checkpoint).
+     *
+     * @return True if a valid checkpoint was found and loaded, otherwise false.
+     */
+    virtual bool loadImage(const std::string& key, computerVision::ImageMat& image);
+
+    /**
+     * @brief Stores the elements of the circuit as a checkpoint.
+     *
+     * @param key Key of the checkpoint.
+     * @param components Components.
+     * @param connections Connections.
+     * @param nodes Nodes.
+     *
+     * @return True if the checkpoint was stored, otherwise false.
+     */
+    virtual bool storeElements(const std::string& key,
+                               const std::vector<circuit::Component>& components,
+                               const std::vector<circuit::Connection>& connections,
+                               const std::vector<circuit::Node>& nodes);
+
+    /**
+     * @brief Loads the elements of the circuit from a checkpoint.
+     *
+     * @param key Key of the checkpoint.
+     * @param components Components loaded.
+     * @param connections Connections loaded.
+     * @param nodes Nodes loaded.
+     *
+     * @return True if a valid checkpoint was found and loaded, otherwise false.
+     */
+    virtual bool loadElements(const std::string& key,
+                              std::vector<circuit::Component>& components,
+                              std::vector<circuit::Connection>& connections,
+                              std::vector<circuit::Node>& nodes);
+
+    /**
+     * @brief Gets the checkpoints folder.
+     *
+     * @return Checkpoints folder.
+     */
+    [[nodiscard]] virtual std::string getDirectory() const;
+
+    /**
+     * @brief Makes the key of a checkpoint.
+     *
+     * @param stage Stage checkpointed.
+     * @param imageHash Hash of the decoded image (see @ref computerVision::OpenCvWrapper::hashImage).
+     * @param parametersHash Hash of the parameters of the stage and of the stages before it.
+     *
+     * @return Key of the checkpoint.
+     */
+    [[nodiscard]] static std::string
+        makeKey(const CheckpointStage stage, const std::uint64_t imageHash, const std::uint64_t parametersHash);
+
+    /**
+     * @brief Hashes the parameters of the preprocessing of a preset.
+     *
+     * @param preset Preset.
+     * @param bandHeight Height of the bands of the preprocessing, in rows (0 if the image is preprocessed as a whole),
+     * since the skeleton of an image preprocessed by bands can differ.
+     *
+     * @return Hash of the parameters.
+     */
+    [[nodiscard]] static std::uint64_t hashPreprocessingParameters(const common::Preset& preset,
+                                                                   const int bandHeight = 0);
+
+    /**
+     * @brief Hashes the parameters of the detection of components, connections and nodes of a preset, with the
+     * parameters of the preprocessing (the parameters of the detection of labels are not included).
+     *
+     * @param preset Preset.
+     * @param bandHeight Height of the bands of the preprocessing, in rows (0 if the image is preprocessed as a whole).
+     *
+     * @return Hash of the parameters.
+     */
+    [[nodiscard]] static std::uint64_t hashDetectionParameters(const common::Preset& preset,
+                                                               const int bandHeight = 0);
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Header of a checkpoint file.
+     */
+    struct Header
+    {
+        /** Magic number. */
+        std::uint32_t mMagic{cMagic};
+        /** Version of the format. */
+        std::uint32_t mVersion{cVersion};
+        /** Stage checkpointed. */
+        std::uint32_t mStage{0};
+        /** Reserved. */
+        std::uint32_t mReserved{0};
+        /** Size of the payload, in bytes. */
+        std::uint64_t mPayloadSize{0};
+        /** Hash of the payload. */
+        std::uint64_t mPayloadHash{0};
+        /** Width of the image, in pixels. */
+        std::int32_t mWidth{0};
+        /** Height of the image, in pixels. */
+        std::int32_t mHeight{0};
+        /** Type of the pixels of the image. */
+        std::int32_t mType{0};
+        /** Reserved. */
+        std::int32_t mReservedImage{0};
+        /** Size of each row of the image, in bytes. */
+        std::uint64_t mRowSize{0};
+    };
+
+    /**
+     * @brief Writes a checkpoint file, first to a hidden file that is then renamed.
+     *
+     * @param key Key of the checkpoint.
+     * @param header Header (the size and hash of the payload are set).
+     * @param payload Payload.
+     *
+     * @return True if the checkpoint was written, otherwise false.
+     */
+    virtual bool writeCheckpoint(const std::string& key, Header header, const std::vector<unsigned char>& payload);
+
+    /**
+     * @brief Gets the path of a checkpoint file.
+     *
+     * @param key Key of the checkpoint.
+     *
+     * @return Path of the checkpoint file.
+     */
+    [[nodiscard]] virtual std::filesystem::path getCheckpointPath(const std::string& key) const;
+
+private:
+    /** Checkpoints folder. */
+    std::filesystem::path mDirectory;
+    /** OpenCV wrapper. */
+    std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Counter of the hidden files, so concurrent writes of the same checkpoint do not collide. */
+    std::atomic<std::uint64_t> mTemporaryCounter{0};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,568 @@
+/**
+ * @file
+ */
+
+#include "TiledSegmentation.h"
+#include "ImagePreprocessing.h"
+#include "common/CancellationToken.h"
+#include "schematicSegmentation/ComponentDetection.h"
+#include "schematicSegmentation/ConnectionDetection.h"
+#include "schematicSegmentation/LabelDetection.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+namespace {
+
+/**
+ * @brief Disjoint sets of indexes (union-find), to group the elements detected in many tiles.
+ */
+class DisjointSets
+{
+public:
+    /**
+     * @brief Constructor, with a set for each index.
+     *
+     * @param size Number of indexes.
+     */
+    explicit DisjointSets(const std::size_t size)
+        : mParents(size)
+    {
+        std::iota(mParents.begin(), mParents.end(), std::size_t{0});
+    }
+
+    /**
+     * @brief Finds the representative of the set of an index (the smallest index of the set).
+     *
+     * @param index Index.
+     *
+     * @return Representative.
+     */
+    std::size_t find(std::size_t index)
+    {
+        while (mParents[index] != index) {
+            mParents[index] = mParents[mParents[index]];
+            index = mParents[index];
+        }
+
+        return index;
+    }
+
+    /**
+     * @brief Joins the sets of two indexes.
+     *
+     * @param first First index.
+     * @param second Second index.
+     */
+    void join(const std::size_t first, const std::size_t second)
+    {
+        const auto firstRoot{find(first)};
+        const auto secondRoot{find(second)};
+        mParents[std::max(firstRoot, secondRoot)] = std::min(firstRoot, secondRoot);
+    }
+
+    /**
+     * @brief Groups the indexes by set.
+     *
+     * @return Indexes of each set, in the order of their representatives.
+     */
+    std::vector<std::vector<std::size_t>> getGroups()
+    {
+        std::vector<std::vector<std::size_t>> groups{};
+        std::vector<std::size_t> groupOfRoot(mParents.size(), std::numeric_limits<std::size_t>::max());
+        for (std::size_t i{0}; i < mParents.size(); ++i) {
+            const auto root{find(i)};
+            if (groupOfRoot[root] == std::numeric_limits<std::size_t>::max()) {
+                groupOfRoot[root] = groups.size();
+                groups.emplace_back();
+            }
+            groups[groupOfRoot[root]].push_back(i);
+        }
+
+        return groups;
+    }
+
+private:
+    /** Parent of each index. */
+    std::vector<std::size_t> mParents;
+};
+
+/**
+ * @brief Gets the area of the intersection of two rectangles.
+ *
+ * @param first First rectangle.
+ * @param second Second rectangle.
+ *
+ * @return Area of the intersection (0 if they do not intersect).
+ */
+std::int64_t intersectionArea(const computerVision::Rectangle& first, const computerVision::Rectangle& second)
+{
+    const auto width{std::min(first.x + first.width, second.x + second.width) - std::max(first.x, second.x)};
+    const auto height{std::min(first.y + first.height, second.y + second.height) - std::max(first.y, second.y)};
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+
+    return static_cast<std::int64_t>(width) * height;
+}
+
+/**
+ * @brief Gets the smallest rectangle with two rectangles.
+ *
+ * @param first First rectangle.
+ * @param second Second rectangle.
+ *
+ * @return Union of the rectangles.
+ */
+computerVision::Rectangle unionRectangle(const computerVision::Rectangle& first,
+                                         const computerVision::Rectangle& second)
+{
+    const auto x{std::min(first.x, second.x)};
+    const auto y{std::min(first.y, second.y)};
+
+    return computerVision::Rectangle{x,
+                                     y,
+                                     std::max(first.x + first.width, second.x + second.width) - x,
+                                     std::max(first.y + first.height, second.y + second.height) - y};
+}
+
+/**
+ * @brief Translates a rectangle.
+ *
+ * @param rectangle Rectangle.
+ * @param offsetX Offset of the x coordinate.
+ * @param offsetY Offset of the y coordinate.
+ *
+ * @return Rectangle translated.
+ */
+computerVision::Rectangle
+    translateRectangle(const computerVision::Rectangle& rectangle, const int offsetX, const int offsetY)
+{
+    return computerVision::Rectangle{rectangle.x + offsetX, rectangle.y + offsetY, rectangle.width, rectangle.height};
+}
+
+/**
+ * @brief Gets the bounding rectangle of a wire, with a margin.
+ *
+ * @param wire Wire (not empty).
+ * @param margin Margin added to each side, in pixels.
+ *
+ * @return Bounding rectangle.
+ */
+computerVision::Rectangle boundingRectangle(const circuit::Wire& wire, const int margin)
+{
+    auto minX{wire.front().x};
+    auto maxX{wire.front().x};
+    auto minY{wire.front().y};
+    auto maxY{wire.front().y};
+    for (const auto& point : wire) {
+        minX = std::min(minX, point.x);
+        maxX = std::max(maxX, point.x);
+        minY = std::min(minY, point.y);
+        maxY = std::max(maxY, point.y);
+    }
+
+    return computerVision::Rectangle{
+        minX - margin, minY - margin, maxX - minX + 1 + 2 * margin, maxY - minY + 1 + 2 * margin};
+}
+
+/**
+ * @brief Gets the squared distance between a point and a segment.
+ *
+ * @param point Point.
+ * @param start Start of the segment.
+ * @param end End of the segment.
+ *
+ * @return Squared distance.
+ */
+double squaredDistance(const computerVision::Point& point,
+                       const computerVision::Point& start,
+                       const computerVision::Point& end)
+{
+    const double segmentX{static_cast<double>(end.x - start.x)};
+    const double segmentY{static_cast<double>(end.y - start.y)};
+    const double pointX{static_cast<double>(point.x - start.x)};
+    const double pointY{static_cast<double>(point.y - start.y)};
+
+    // Projection of the point on the segment, clamped to its ends
+    const auto squaredLength{segmentX * segmentX + segmentY * segmentY};
+    const auto t{squaredLength > 0 ? std::clamp((pointX * segmentX + pointY * segmentY) / squaredLength, 0.0, 1.0)
+                                   : 0.0};
+    const auto distanceX{pointX - t * segmentX};
+    const auto distanceY{pointY - t * segmentY};
+
+    return distanceX * distanceX + distanceY * distanceY;
+}
+
+/**
+ * @brief Checks if a point of a wire is within a distance of the segments of another wire (a closed contour).
+ *
+ * @param first Wire whose points are checked.
+ * @param second Wire whose segments are checked.
+ * @param maxDistance Maximum distance.
+ *
+ * @return True if a point is within the distance, otherwise false.
+ */
+bool isWireNear(const circuit::Wire& first, const circuit::Wire& second, const int maxDistance)
+{
+    const auto maxSquaredDistance{static_cast<double>(maxDistance) * maxDistance};
+    for (const auto& point : first) {
+        for (std::size_t i{0}; i < second.size(); ++i) {
+            if (squaredDistance(point, second[i], second[(i + 1) % second.size()]) <= maxSquaredDistance) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+TiledSegmentation::TiledSegmentation(
+    const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+    const std::shared_ptr<output::ImageWriter>& imageWriter,
+    const std::shared_ptr<logging::Logger>& logger,
+    const std::shared_ptr<schematicSegmentation::SchematicSegmentation>& schematicSegmentation,
+    const int tileSize,
+    const unsigned int numThreads,
+    const int overlap,
+    const common::ThreadPool::ThreadStart& threadStart)
+    : mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
+    , mLogger{logger}
+    , mSchematicSegmentation{schematicSegmentation}
+    , mTileSize{tileSize}
+    , mOverlap{overlap}
+    , mThreadPool{numThreads, threadStart}
+{
+}
+
+bool TiledSegmentation::segmentImage(computerVision::ImageMat& imageInitial)
+{
+    const auto width{mOpenCvWrapper->getImageWidth(imageInitial)};
+    const auto height{mOpenCvWrapper->getImageHeight(imageInitial)};
+    const auto tiles{makeTiles(width, height, mTileSize, mOverlap)};
+
+    mLogger->logInfo("Starting tiled image segmentation: {} tiles of {} pixels, with an overlap of {} pixels",
+                     tiles.size(),
+                     mTileSize,
+                     std::min(mOverlap, mTileSize / 2));
+
+    // The tiles run in parallel, so OpenCV runs serially in each one
+    const auto numOpenCvThreads{mOpenCvWrapper->getNumThreads()};
+    if (mThreadPool.getNumThreads() > 1) {
+        mOpenCvWrapper->setNumThreads(1);
+    }
+
+    // Components, merged across the tiles
+    auto components{detectComponents(imageInitial, tiles)};
+    mLogger->logInfo("Components detected in the tiles: {}", components.size());
+
+    // Connections and labels, stitched and merged across the tiles
+    std::vector<circuit::Connection> connections{};
+    std::vector<circuit::Label> labels{};
+    if (!components.empty() && !common::CancellationToken::isCurrentStopped()) {
+        detectConnectionsLabels(imageInitial, tiles, components, connections, labels);
+        mLogger->logInfo("Connections stitched from the tiles: {}", connections.size());
+        mLogger->logInfo("Labels detected in the tiles: {}", labels.size());
+    }
+
+    mOpenCvWrapper->setNumThreads(numOpenCvThreads);
+
+    if (components.empty() || connections.empty() || common::CancellationToken::isCurrentStopped()) {
+        return false;
+    }
+
+    // Nodes, for the whole image (the image is only read for its dimensions)
+    schematicSegmentation::ConnectionDetection connectionDetection{mOpenCvWrapper, mImageWriter, mLogger};
+    connectionDetection.setDetectedConnections(connections);
+    if (!connectionDetection.detectNodesUpdateConnections(imageInitial, imageInitial, components)) {
+        return false;
+    }
+
+    // Component connections
+    mSchematicSegmentation->detectComponentConnections(imageInitial,
+                                                       imageInitial,
+                                                       components,
+                                                       connectionDetection.getDetectedConnections(),
+                                                       connectionDetection.getDetectedNodes());
+    if (!mSchematicSegmentation->updateDetectedComponents()) {
+        return false;
+    }
+
+    // Associate labels
+    if (!labels.empty()) {
+        mSchematicSegmentation->associateLabels(imageInitial, imageInitial, labels);
+    }
+
+    // Assign deterministic IDs, once all the elements and their references are known
+    if (mDeterministicIds) {
+        mSchematicSegmentation->assignDeterministicIds(width, height);
+    }
+
+    return true;
+}
+
+bool TiledSegmentation::isTiled(computerVision::ImageMat& image) const
+{
+    return mOpenCvWrapper->getImageWidth(image) > mTileSize || mOpenCvWrapper->getImageHeight(image) > mTileSize;
+}
+
+int TiledSegmentation::getTileSize() const
+{
+    return mTileSize;
+}
+
+void TiledSegmentation::setPreset(const common::Preset& preset)
+{
+    mPreset = preset;
+}
+
+common::Preset TiledSegmentation::getPreset() const
+{
+    return mPreset;
+}
+
+void TiledSegmentation::setDeterministicIds(const bool& deterministicIds)
+{
+    mDeterministicIds = deterministicIds;
+}
+
+std::vector<computerVision::Rectangle>
+    TiledSegmentation::makeTiles(const int width, const int height, const int tileSize, const int overlap)
+{
+    std::vector<computerVision::Rectangle> tiles{};
+    if (width <= 0 || height <= 0 || tileSize <= 0) {
+        return tiles;
+    }
+
+    // Positions of the tiles along an axis, the last one aligned to the border
+    const auto step{tileSize - std::clamp(overlap, 0, tileSize / 2)};
+    const auto getPositions = [&](const int length) {
+        std::vector<int> positions{0};
+        while (positions.back() + tileSize < length) {
+            positions.push_back(std::min(positions.back() + step, length - tileSize));
+        }
+        return positions;
+    };
+
+    for (const auto y : getPositions(height)) {
+        for (const auto x : getPositions(width)) {
+            tiles.push_back(computerVision::Rectangle{x, y, std::min(tileSize, width), std::min(tileSize, height)});
+        }
+    }
+
+    return tiles;
+}
+
+std::vector<computerVision::Rectangle> TiledSegmentation::mergeBoxes(const std::vector<TileBox>& boxes,
+                                                                     const double minOverlap)
+{
+    DisjointSets sets{boxes.size()};
+    for (std::size_t i{0}; i < boxes.size(); ++i) {
+        const auto areaFirst{static_cast<std::int64_t>(boxes[i].mBox.width) * boxes[i].mBox.height};
+        for (std::size_t j{i + 1}; j < boxes.size(); ++j) {
+            if (boxes[i].mTile == boxes[j].mTile) {
+                continue;
+            }
+            const auto areaSecond{static_cast<std::int64_t>(boxes[j].mBox.width) * boxes[j].mBox.height};
+            const auto area{intersectionArea(boxes[i].mBox, boxes[j].mBox)};
+            const auto minArea{static_cast<double>(std::min(areaFirst, areaSecond))};
+            if (area > 0 && static_cast<double>(area) >= minOverlap * minArea) {
+                sets.join(i, j);
+            }
+        }
+    }
+
+    std::vector<computerVision::Rectangle> merged{};
+    for (const auto& group : sets.getGroups()) {
+        auto box{boxes[group.front()].mBox};
+        for (const auto index : group) {
+            box = unionRectangle(box, boxes[index].mBox);
+        }
+        merged.push_back(box);
+    }
+
+    return merged;
+}
+
+std::vector<circuit::Wire> TiledSegmentation::stitchWires(const std::vector<TileWire>& wires, const int maxDistance)
+{
+    std::vector<computerVision::Rectangle> bounds{};
+    bounds.reserve(wires.size());
+    for (const auto& wire : wires) {
+        bounds.push_back(wire.mWire.empty() ? computerVision::Rectangle{}
+                                            : boundingRectangle(wire.mWire, maxDistance));
+    }
+
+    DisjointSets sets{wires.size()};
+    for (std::size_t i{0}; i < wires.size(); ++i) {
+        for (std::size_t j{i + 1}; j < wires.size(); ++j) {
+            if (wires[i].mTile == wires[j].mTile || sets.find(i) == sets.find(j)
+                || intersectionArea(bounds[i], bounds[j]) == 0) {
+                continue;
+            }
+            if (isWireNear(wires[i].mWire, wires[j].mWire, maxDistance)
+                || isWireNear(wires[j].mWire, wires[i].mWire, maxDistance)) {
+                sets.join(i, j);
+            }
+        }
+    }
+
+    std::vector<circuit::Wire> stitched{};
+    for (const auto& group : sets.getGroups()) {
+        circuit::Wire wire{};
+        for (const auto index : group) {
+            wire.insert(wire.end(), wires[index].mWire.begin(), wires[index].mWire.end());
+        }
+        if (!wire.empty()) {
+            stitched.push_back(std::move(wire));
+        }
+    }
+
+    return stitched;
+}
+
+void TiledSegmentation::preprocessTile(computerVision::ImageMat& imageInitial,
+                                       const computerVision::Rectangle& tile,
+                                       computerVision::ImageMat& imageTile,
+                                       computerVision::ImageMat& imagePreprocessed)
+{
+    // The operations of the preprocessing are local, so the tile is preprocessed as a part of the image
+    mOpenCvWrapper->cropImage(imageInitial, imageTile, tile);
+    imagePreprocessed = mOpenCvWrapper->cloneImage(imageTile);
+
+    ImagePreprocessing imagePreprocessing{mOpenCvWrapper, mImageWriter, mLogger};
+    imagePreprocessing.setPreset(mPreset);
+    imagePreprocessing.preprocessImage(imagePreprocessed);
+}
+
+std::vector<circuit::Component> TiledSegmentation::detectComponents(computerVision::ImageMat& imageInitial,
+                                                                    const std::vector<computerVision::Rectangle>& tiles)
+{
+    // Boxes of the components of each tile, in the coordinates of the image
+    std::vector<std::vector<TileBox>> tileBoxes(tiles.size());
+    mThreadPool.runAll(tiles.size(), [&](const std::size_t index) {
+        if (common::CancellationToken::isCurrentStopped()) {
+            return;
+        }
+
+        const auto& tile{tiles[index]};
+        computerVision::ImageMat imageTile{};
+        computerVision::ImageMat imagePreprocessed{};
+        preprocessTile(imageInitial, tile, imageTile, imagePreprocessed);
+
+        schematicSegmentation::ConnectionDetection connectionDetection{mOpenCvWrapper, mImageWriter, mLogger};
+        connectionDetection.setPreset(mPreset);
+        schematicSegmentation::ComponentDetection componentDetection{mOpenCvWrapper, mImageWriter, mLogger};
+        componentDetection.setPreset(mPreset);
+        if (!connectionDetection.detectConnections(imageTile, imagePreprocessed)
+            || !componentDetection.detectComponents(
+                imageTile, imagePreprocessed, connectionDetection.getDetectedConnections())) {
+            return;
+        }
+
+        for (const auto& component : componentDetection.getDetectedComponents()) {
+            tileBoxes[index].push_back(TileBox{index, translateRectangle(component.mBoundingBox, tile.x, tile.y)});
+        }
+    });
+
+    std::vector<TileBox> boxes{};
+    for (const auto& tileBox : tileBoxes) {
+        boxes.insert(boxes.end(), tileBox.begin(), tileBox.end());
+    }
+
+    std::vector<circuit::Component> components{};
+    for (const auto& box : mergeBoxes(boxes, cBoxMinOverlap)) {
+        circuit::Component component{};
+        component.mBoundingBox = box;
+        components.push_back(component);
+    }
+
+    return components;
+}
+
+void TiledSegmentation::detectConnectionsLabels(computerVision::ImageMat& imageInitial,
+                                                const std::vector<computerVision::Rectangle>& tiles,
+                                                const std::vector<circuit::Component>& components,
+                                                std::vector<circuit::Connection>& connections,
+                                                std::vector<circuit::Label>& labels)
+{
+    // Wires and boxes of the labels of each tile, in the coordinates of the image
+    std::vector<std::vector<TileWire>> tileWires(tiles.size());
+    std::vector<std::vector<TileBox>> tileBoxes(tiles.size());
+    mThreadPool.runAll(tiles.size(), [&](const std::size_t index) {
+        if (common::CancellationToken::isCurrentStopped()) {
+            return;
+        }
+
+        // Components of the image in the tile, in the coordinates of the tile
+        const auto& tile{tiles[index]};
+        std::vector<circuit::Component> tileComponents{};
+        for (const auto& component : components) {
+            if (intersectionArea(component.mBoundingBox, tile) > 0) {
+                auto tileComponent{component};
+                tileComponent.mBoundingBox = translateRectangle(component.mBoundingBox, -tile.x, -tile.y);
+                tileComponents.push_back(tileComponent);
+            }
+        }
+
+        computerVision::ImageMat imageTile{};
+        computerVision::ImageMat imagePreprocessed{};
+        preprocessTile(imageInitial, tile, imageTile, imagePreprocessed);
+
+        schematicSegmentation::ConnectionDetection connectionDetection{mOpenCvWrapper, mImageWriter, mLogger};
+        connectionDetection.setPreset(mPreset);
+        if (!connectionDetection.updateConnections(imageTile, imagePreprocessed, tileComponents)) {
+            return;
+        }
+
+        for (const auto& connection : connectionDetection.getDetectedConnections()) {
+            TileWire tileWire{index, connection.mWire};
+            for (auto& point : tileWire.mWire) {
+                point.x += tile.x;
+                point.y += tile.y;
+            }
+            tileWires[index].push_back(std::move(tileWire));
+        }
+
+        schematicSegmentation::LabelDetection labelDetection{mOpenCvWrapper, mImageWriter, mLogger};
+        labelDetection.setPreset(mPreset);
+        if (labelDetection.detectLabels(
+                imageTile, imagePreprocessed, tileComponents, connectionDetection.getDetectedConnections())) {
+            for (const auto& label : labelDetection.getDetectedLabels()) {
+                tileBoxes[index].push_back(TileBox{index, translateRectangle(label.mBoundingBox, tile.x, tile.y)});
+            }
+        }
+    });
+
+    std::vector<TileWire> wires{};
+    for (auto& tileWire : tileWires) {
+        std::move(tileWire.begin(), tileWire.end(), std::back_inserter(wires));
+    }
+    for (auto& wire : stitchWires(wires, cWireMaxDistance)) {
+        circuit::Connection connection{};
+        connection.mWire = std::move(wire);
+        connections.push_back(std::move(connection));
+    }
+
+    std::vector<TileBox> boxes{};
+    for (const auto& tileBox : tileBoxes) {
+        boxes.insert(boxes.end(), tileBox.begin(), tileBox.end());
+    }
+    for (const auto& box : mergeBoxes(boxes, cBoxMinOverlap)) {
+        circuit::Label label{};
+        label.mBoundingBox = box;
+        labels.push_back(label);
+    }
+}
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
@@ -0,0 +1,256 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "common/Preset.h"
+#include "common/ThreadPool.h"
+#include "computerVision/OpenCvWrapper.h"
+#include "logging/Logger.h"
+#include "output/ImageWriter.h"
+#include "schematicSegmentation/SchematicSegmentation.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace imageProcessing {
+
+/**
+ * @brief Box of an element detected in a tile, in the coordinates of the image.
+ */
+struct TileBox
+{
+    /** Index of the tile. */
+    std::size_t mTile{0};
+    /** Bounding box. */
+    computerVision::Rectangle mBox{};
+};
+
+/**
+ * @brief Wire of a connection detected in a tile, in the coordinates of the image.
+ */
+struct TileWire
+{
+    /** Index of the tile. */
+    std::size_t mTile{0};
+    /** Wire. */
+    circuit::Wire mWire{};
+};
+
+/**
+ * @brief Segmentation of a very large image (e.g. a scan of an A0 sheet at 600 dpi) by overlapping tiles, segmented
+ * independently and in parallel.
+ *
+ * The tiles are segmented in two passes, each one preprocessing the tile again instead of keeping it, so the memory
+ * is bounded by the size of the tiles and the number of threads:
+ * - Components: the components of each tile are detected, and the boxes of the same component detected in more than
+ *   one tile (in their overlap, or cut by the border of a tile) are merged.
+ * - Connections and labels: the wires of each tile are found without the components merged, and the labels of each
+ *   tile are detected. The fragments of the same wire in different tiles (crossing the border of a tile) are stitched,
+ *   and the boxes of the same label are merged as the components.
+ *
+ * Then the nodes, the ports of the components and the association of labels are computed for the whole image, as in
+ * @ref ImageSegmentation. The images of the processing are not saved, and the stage checkpoints are not used.
+ */
+class TiledSegmentation
+{
+public:
+    /** Default overlap of adjacent tiles, in pixels (larger than the components and labels detected). */
+    static constexpr int cOverlapDefault{256};
+    /** Maximum distance between the fragments of a wire in adjacent tiles, in pixels. */
+    static constexpr int cWireMaxDistance{2};
+    /** Minimum overlap of the boxes of an element detected in different tiles (ratio of the smaller box). */
+    static constexpr double cBoxMinOverlap{0.5};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
+     * @param logger Logger.
+     * @param schematicSegmentation Schematic segmentation, with the elements segmented.
+     * @param tileSize Width and height of the tiles, in pixels.
+     * @param numThreads Number of threads segmenting the tiles.
+     * @param overlap Overlap of adjacent tiles, in pixels.
+     * @param threadStart Function called by each thread segmenting the tiles when it starts (e.g. to pin it).
+     */
+    explicit TiledSegmentation(
+        const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+        const std::shared_ptr<output::ImageWriter>& imageWriter,
+        const std::shared_ptr<logging::Logger>& logger,
+        const std::shared_ptr<schematicSegmentation::SchematicSegmentation>& schematicSegmentation,
+        const int tileSize,
+        const unsigned int numThreads,
+        const int overlap = cOverlapDefault,
+        const common::ThreadPool::ThreadStart& threadStart = {});
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~TiledSegmentation() = default;
+
+    /**
+     * @brief Segments the image by tiles.
+     *
+     * @param imageInitial Initial image without preprocessing (only read).
+     *
+     * @return True if segmentation occurred successfully, otherwise false.
+     */
+    virtual bool segmentImage(computerVision::ImageMat& imageInitial);
+
+    /**
+     * @brief Checks if an image is larger than a tile, so it is segmented by tiles.
+     *
+     * @param image Image.
+     *
+     * @return True if the image is larger than a tile, otherwise false.
+     */
+    [[nodiscard]] virtual bool isTiled(computerVision::ImageMat& image) const;
+
+    /**
+     * @brief Gets the size of the tiles.
+     *
+     * @return Width and height of the tiles, in pixels.
+     */
+    [[nodiscard]] virtual int getTileSize() const;
+
+    /**
+     * @brief Sets the preset of the preprocessing and the detections.
+     *
+     * @param preset Preset.
+     */
+    virtual void setPreset(const common::Preset& preset);
+
+    /**
+     * @brief Gets the preset of the preprocessing and the detections.
+     *
+     * @return The preset.
+     */
+    [[nodiscard]] virtual common::Preset getPreset() const;
+
+    /**
+     * @brief Sets the flag to assign deterministic IDs to the elements segmented, instead of random IDs.
+     *
+     * @param deterministicIds Assign deterministic IDs.
+     */
+    virtual void setDeterministicIds(const bool& deterministicIds);
+
+    /**
+     * @brief Splits an image in overlapping tiles, row by row.
+     *
+     * The tiles have the size given (except for an image smaller than a tile), and the last tile of each row and
+     * column is aligned to the border of the image, so its overlap may be larger.
+     *
+     * @param width Width of the image.
+     * @param height Height of the image.
+     * @param tileSize Width and height of the tiles.
+     * @param overlap Overlap of adjacent tiles (at most half of the tile size).
+     *
+     * @return Tiles.
+     */
+    static std::vector<computerVision::Rectangle>
+        makeTiles(const int width, const int height, const int tileSize, const int overlap);
+
+    /**
+     * @brief Merges the boxes of the same elements detected in different tiles.
+     *
+     * Boxes of different tiles are of the same element if their intersection covers a minimum ratio of the smaller
+     * box (e.g. an element detected in the overlap of the tiles, or cut by the border of a tile). The boxes of the
+     * same tile are different elements.
+     *
+     * @param boxes Boxes detected in the tiles.
+     * @param minOverlap Minimum overlap of the boxes of the same element, from 0 to 1.
+     *
+     * @return Boxes of the elements (the union of their boxes), in the order of their first box.
+     */
+    static std::vector<computerVision::Rectangle> mergeBoxes(const std::vector<TileBox>& boxes,
+                                                             const double minOverlap);
+
+    /**
+     * @brief Stitches the fragments of the same wires detected in different tiles.
+     *
+     * Fragments of different tiles are of the same wire if a point of one is within the maximum distance of the
+     * other (e.g. a wire crossing the border of a tile, found in both tiles in their overlap).
+     *
+     * @param wires Wires detected in the tiles.
+     * @param maxDistance Maximum distance between the fragments of a wire, in pixels.
+     *
+     * @return Wires (the points of their fragments), in the order of their first fragment.
+     */
+    static std::vector<circuit::Wire> stitchWires(const std::vector<TileWire>& wires, const int maxDistance);
+
+#ifndef BUILD_TESTS
+private:
+#endif
+    /**
+     * @brief Preprocesses a tile of the image.
+     *
+     * @param imageInitial Initial image.
+     * @param tile Tile.
+     * @param imageTile Tile of the initial image (a copy).
+     * @param imagePreprocessed Tile preprocessed.
+     */
+    virtual void preprocessTile(computerVision::ImageMat& imageInitial,
+                                const computerVision::Rectangle& tile,
+                                computerVision::ImageMat& imageTile,
+                                computerVision::ImageMat& imagePreprocessed);
+
+    /**
+     * @brief Detects the components of the tiles.
+     *
+     * @param imageInitial Initial image.
+     * @param tiles Tiles.
+     *
+     * @return Components of the image.
+     */
+    virtual std::vector<circuit::Component> detectComponents(computerVision::ImageMat& imageInitial,
+                                                             const std::vector<computerVision::Rectangle>& tiles);
+
+    /**
+     * @brief Detects the connections and labels of the tiles, without the components of the image.
+     *
+     * @param imageInitial Initial image.
+     * @param tiles Tiles.
+     * @param components Components of the image.
+     * @param connections Connections of the image.
+     * @param labels Labels of the image.
+     */
+    virtual void detectConnectionsLabels(computerVision::ImageMat& imageInitial,
+                                         const std::vector<computerVision::Rectangle>& tiles,
+                                         const std::vector<circuit::Component>& components,
+                                         std::vector<circuit::Connection>& connections,
+                                         std::vector<circuit::Label>& labels);
+
+private:
+    /** OpenCV wrapper. */
+    std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
+
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+
+    /** Schematic segmentation. */
+    std::shared_ptr<schematicSegmentation::SchematicSegmentation> mSchematicSegmentation;
+
+    /** Width and height of the tiles. */
+    int mTileSize;
+
+    /** Overlap of adjacent tiles. */
+    int mOverlap;
+
+    /** Pool of threads segmenting the tiles. */
+    common::ThreadPool mThreadPool;
+
+    /** Preset of the preprocessing and the detections. */
+    common::Preset mPreset{common::Preset::BALANCED};
+
+    /** Flag to assign deterministic IDs to the elements segmented. */
+    bool mDeterministicIds{false};
+};
+
+} // namespace imageProcessing
+} // namespace circuitSegmentation
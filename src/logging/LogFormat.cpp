@@ -0,0 +1,33 @@
+/**
+ * @file
+ */
+
+#include "LogFormat.h"
+
+namespace circuitSegmentation {
+namespace logging {
+
+std::size_t appendLogText(std::string& msg, const std::string_view format, const std::size_t pos)
+{
+    for (auto i{pos}; i < format.size(); ++i) {
+        const auto c{format[i]};
+        const auto hasNext{i + 1 < format.size()};
+
+        if (c == '{' && hasNext && format[i + 1] == '}') {
+            // Placeholder
+            return i + 2;
+        }
+
+        if ((c == '{' || c == '}') && hasNext && format[i + 1] == c) {
+            // Escaped brace
+            ++i;
+        }
+
+        msg += c;
+    }
+
+    return std::string_view::npos;
+}
+
+} // namespace logging
+} // namespace circuitSegmentation
@@ -0,0 +1,97 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace circuitSegmentation {
+namespace logging {
+
+/**
+ * @brief Appends the text of a format string to the message, until the next placeholder.
+ *
+ * The placeholder is "{}". The escaped braces "{{" and "}}" are appended as "{" and "}".
+ *
+ * @param msg Message.
+ * @param format Format string.
+ * @param pos Position in the format string to start from.
+ *
+ * @return Position in the format string after the placeholder, or std::string_view::npos if there are no more
+ * placeholders (the remaining text is appended).
+ */
+std::size_t appendLogText(std::string& msg, const std::string_view format, const std::size_t pos);
+
+/**
+ * @brief Appends an argument to the message.
+ *
+ * @tparam Arg Type of the argument: strings, characters, booleans, arithmetic types and types with the stream
+ * insertion operator are supported.
+ * @param msg Message.
+ * @param arg Argument.
+ */
+template<typename Arg>
+void appendLogArg(std::string& msg, const Arg& arg)
+{
+    if constexpr (std::is_same_v<Arg, bool>) {
+        msg += arg ? "true" : "false";
+    } else if constexpr (std::is_same_v<Arg, char>) {
+        msg += arg;
+    } else if constexpr (std::is_convertible_v<const Arg&, std::string_view>) {
+        msg += std::string_view{arg};
+    } else if constexpr (std::is_arithmetic_v<Arg>) {
+        msg += std::to_string(arg);
+    } else {
+        std::ostringstream ss{};
+        ss << arg;
+        msg += ss.str();
+    }
+}
+
+/**
+ * @brief Formats a message, replacing each placeholder "{}" of the format string by the next argument.
+ *
+ * The placeholders without arguments are kept and the arguments without placeholders are ignored.
+ *
+ * @tparam Args Types of the arguments.
+ * @param format Format string.
+ * @param args Arguments.
+ *
+ * @return Message.
+ */
+template<typename... Args>
+std::string formatLog(const std::string_view format, const Args&... args)
+{
+    std::string msg{};
+    msg.reserve(format.size() + 16 * sizeof...(Args));
+
+    auto pos{std::size_t{0}};
+    const auto append{[&msg, &format, &pos](const auto& arg) {
+        if (pos == std::string_view::npos) {
+            return;
+        }
+        pos = appendLogText(msg, format, pos);
+        if (pos != std::string_view::npos) {
+            appendLogArg(msg, arg);
+        }
+    }};
+    (append(args), ...);
+
+    // Remaining text
+    while (pos != std::string_view::npos) {
+        pos = appendLogText(msg, format, pos);
+        if (pos != std::string_view::npos) {
+            msg += "{}";
+        }
+    }
+
+    return msg;
+}
+
+} // namespace logging
+} // namespace circuitSegmentation
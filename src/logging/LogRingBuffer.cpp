@@ -0,0 +1,61 @@
+/**
+ * @file
+ */
+
+#include "LogRingBuffer.h"
+#include <utility>
+
+namespace circuitSegmentation {
+namespace logging {
+
+LogRingBuffer::LogRingBuffer(const std::size_t capacity)
+    : mSlots(capacity + 1)
+{
+}
+
+bool LogRingBuffer::push(LogRecord& record)
+{
+    const auto tail{mTail.load(std::memory_order_relaxed)};
+    const auto next{(tail + 1) % mSlots.size()};
+
+    // Full
+    if (next == mHead.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    mSlots[tail] = std::move(record);
+    mTail.store(next, std::memory_order_release);
+
+    return true;
+}
+
+bool LogRingBuffer::pop(LogRecord& record)
+{
+    const auto head{mHead.load(std::memory_order_relaxed)};
+
+    // Empty
+    if (head == mTail.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    record = std::move(mSlots[head]);
+    mHead.store((head + 1) % mSlots.size(), std::memory_order_release);
+
+    return true;
+}
+
+std::size_t LogRingBuffer::getSize() const
+{
+    const auto head{mHead.load(std::memory_order_acquire)};
+    const auto tail{mTail.load(std::memory_order_acquire)};
+
+    return (tail + mSlots.size() - head) % mSlots.size();
+}
+
+std::size_t LogRingBuffer::getCapacity() const
+{
+    return mSlots.size() - 1;
+}
+
+} // namespace logging
+} // namespace circuitSegmentation
@@ -0,0 +1,106 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace logging {
+
+/**
+ * @brief Record of a log message, waiting to be formatted and written.
+ */
+struct LogRecord
+{
+    /** Log level of the message, as the value of Logger::LogLevel. */
+    unsigned char mLevel{0};
+    /** ID of the job that logged the message (0 when there is no job). */
+    std::uint64_t mJobId{0};
+    /** Time point when the message was logged. */
+    std::chrono::system_clock::time_point mTime{};
+    /** Message. */
+    std::string mMsg{};
+};
+
+/**
+ * @brief Lock-free ring buffer of log records, for a single producer and a single consumer.
+ *
+ * The producer is the thread that logs the messages and the consumer is the thread that writes them, so neither of
+ * them blocks the other.
+ */
+class LogRingBuffer
+{
+public:
+    /** Default capacity of the ring buffer, in records. */
+    static constexpr std::size_t cCapacityDefault{1024};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param capacity Capacity of the ring buffer, in records.
+     */
+    explicit LogRingBuffer(const std::size_t capacity = cCapacityDefault);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~LogRingBuffer() = default;
+
+    /**
+     * @brief Pushes a record to the ring buffer.
+     *
+     * This method must only be called by the producer.
+     *
+     * @param record Record. It is moved only if the operation occurred successfully.
+     *
+     * @return True if the record was pushed, or false if the ring buffer is full.
+     */
+    virtual bool push(LogRecord& record);
+
+    /**
+     * @brief Pops the oldest record from the ring buffer.
+     *
+     * This method must only be called by the consumer.
+     *
+     * @param record Record popped.
+     *
+     * @return True if a record was popped, or false if the ring buffer is empty.
+     */
+    virtual bool pop(LogRecord& record);
+
+    /**
+     * @brief Gets the number of records in the ring buffer.
+     *
+     * The value is exact only when called by the producer or by the consumer while the other is not running.
+     *
+     * @return Number of records.
+     */
+    [[nodiscard]] virtual std::size_t getSize() const;
+
+    /**
+     * @brief Gets the capacity of the ring buffer.
+     *
+     * @return Capacity, in records.
+     */
+    [[nodiscard]] virtual std::size_t getCapacity() const;
+
+private:
+    /** Slots of the ring buffer (one more than the capacity, to distinguish full from empty). */
+    std::vector<LogRecord> mSlots;
+
+    /** Index of the next slot to be popped, written by the consumer. */
+    std::atomic<std::size_t> mHead{0};
+
+    /** Index of the next slot to be pushed, written by the producer. */
+    std::atomic<std::size_t> mTail{0};
+};
+
+} // namespace logging
+} // namespace circuitSegmentation
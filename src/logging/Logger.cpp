@@ -3,24 +3,44 @@
  */
 
 #include "Logger.h"
-#include <chrono>
-#include <ctime>
 #include <iomanip>
 #include <sstream>
-#include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace circuitSegmentation {
 namespace logging {
 
-Logger::Logger(std::ostream& ostream, LogLevel level)
+Logger::Logger(std::ostream& ostream, LogLevel level, LogMode mode)
     : mOstream{ostream}
-    , mLogLevel{std::move(level)}
+    , mLogLevel{level}
+    , mLogMode{mode}
+    , mId{++mIdCounter}
 {
+    if (mLogMode == LogMode::ASYNCHRONOUS) {
+        mDrainThread = std::thread{&Logger::drainLoop, this};
+    }
+}
+
+Logger::~Logger()
+{
+    if (mDrainThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock{mMutex};
+            mStop = true;
+        }
+        mDrainRequested.notify_one();
+        mDrainThread.join();
+    }
+
+    // Write the messages waiting to be written
+    std::lock_guard<std::mutex> lock{mMutex};
+    drain();
 }
 
 void Logger::setLogLevel(LogLevel level)
 {
-    mLogLevel = std::move(level);
+    mLogLevel = level;
 }
 
 Logger::LogLevel Logger::getLogLevel() const
@@ -28,67 +48,212 @@ Logger::LogLevel Logger::getLogLevel() const
     return mLogLevel;
 }
 
+Logger::LogMode Logger::getLogMode() const
+{
+    return mLogMode;
+}
+
+void Logger::flush()
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+    drain();
+}
+
+void Logger::setJobId(const std::uint64_t jobId)
+{
+    mJobId = jobId;
+}
+
+std::uint64_t Logger::getJobId()
+{
+    return mJobId;
+}
+
 void Logger::logFatal(const std::string& msg)
 {
-    if (mLogLevel >= LogLevel::FATAL) {
-        log("FATAL", msg);
+    if (isLogLevelEnabled(LogLevel::FATAL)) {
+        log(LogLevel::FATAL, msg);
     }
 }
 
 void Logger::logError(const std::string& msg)
 {
-    if (mLogLevel >= LogLevel::ERROR) {
-        log("ERROR", msg);
+    if (isLogLevelEnabled(LogLevel::ERROR)) {
+        log(LogLevel::ERROR, msg);
     }
 }
 
 void Logger::logWarning(const std::string& msg)
 {
-    if (mLogLevel >= LogLevel::WARNING) {
-        log("WARNING", msg);
+    if (isLogLevelEnabled(LogLevel::WARNING)) {
+        log(LogLevel::WARNING, msg);
     }
 }
 
 void Logger::logInfo(const std::string& msg)
 {
-    if (mLogLevel >= LogLevel::INFO) {
-        log("INFO", msg);
+    if (isLogLevelEnabled(LogLevel::INFO)) {
+        log(LogLevel::INFO, msg);
     }
 }
 
 void Logger::logDebug(const std::string& msg)
 {
-    if (mLogLevel >= LogLevel::DEBUG) {
-        log("DEBUG", msg);
+    if constexpr (cDebugLogsEnabled) {
+        if (isLogLevelEnabled(LogLevel::DEBUG)) {
+            log(LogLevel::DEBUG, msg);
+        }
     }
 }
 
 void Logger::logVerbose(const std::string& msg)
 {
-    if (mLogLevel >= LogLevel::VERBOSE) {
-        log("VERBOSE", msg);
+    if constexpr (cDebugLogsEnabled) {
+        if (isLogLevelEnabled(LogLevel::VERBOSE)) {
+            log(LogLevel::VERBOSE, msg);
+        }
     }
 }
 
-void Logger::log(const std::string& level, const std::string& msg)
+void Logger::log(const LogLevel level, const std::string& msg)
 {
-    mOstream << getDateTime() << "[" << level << "] " << msg << std::endl;
+    LogRecord record{static_cast<unsigned char>(level), mJobId, std::chrono::system_clock::now(), msg};
+
+    // Synchronous mode
+    if (mLogMode == LogMode::SYNCHRONOUS) {
+        std::lock_guard<std::mutex> lock{mMutex};
+        format(record);
+        mOstream << mBatch << std::flush;
+        mBatch.clear();
+        return;
+    }
+
+    // Asynchronous mode
+    const auto ringBuffer{getRingBuffer()};
+    while (!ringBuffer->push(record)) {
+        // Ring buffer full, so wait for the background thread to write the records
+        mDrainRequested.notify_one();
+        std::this_thread::yield();
+    }
+
+    // Request the records to be written before the ring buffer is full
+    if (ringBuffer->getSize() >= ringBuffer->getCapacity() / 2) {
+        mDrainRequested.notify_one();
+    }
 }
 
-const std::string Logger::getDateTime() const
+std::shared_ptr<LogRingBuffer> Logger::getRingBuffer()
 {
-    // Time point representing the current point in time
-    auto now = std::chrono::system_clock::now();
+    // Ring buffers of the calling thread, for each logger
+    thread_local std::unordered_map<std::uint64_t, std::shared_ptr<LogRingBuffer>> ringBuffersOfThread{};
 
+    const auto it{ringBuffersOfThread.find(mId)};
+    if (it != ringBuffersOfThread.end()) {
+        return it->second;
+    }
+
+    // Remove the ring buffers of loggers already destroyed
+    std::erase_if(ringBuffersOfThread, [](const auto& entry) { return entry.second.use_count() == 1; });
+
+    // Create the ring buffer of the calling thread
+    auto ringBuffer{std::make_shared<LogRingBuffer>()};
+    ringBuffersOfThread.emplace(mId, ringBuffer);
+    {
+        std::lock_guard<std::mutex> lock{mRingBuffersMutex};
+        mRingBuffers.push_back(ringBuffer);
+    }
+
+    return ringBuffer;
+}
+
+void Logger::drain()
+{
+    std::vector<std::shared_ptr<LogRingBuffer>> ringBuffers{};
+    {
+        std::lock_guard<std::mutex> lock{mRingBuffersMutex};
+        ringBuffers = mRingBuffers;
+    }
+
+    // Format the records of all the ring buffers
+    LogRecord record{};
+    for (const auto& ringBuffer : ringBuffers) {
+        while (ringBuffer->pop(record)) {
+            format(record);
+        }
+    }
+
+    // Write the batch
+    if (!mBatch.empty()) {
+        mOstream << mBatch << std::flush;
+        mBatch.clear();
+    }
+
+    // Remove the ring buffers of threads already finished (only the copy above and this logger have a reference)
+    std::lock_guard<std::mutex> lock{mRingBuffersMutex};
+    std::erase_if(mRingBuffers, [](const auto& ringBuffer) {
+        return ringBuffer.use_count() == 2 && ringBuffer->getSize() == 0;
+    });
+}
+
+void Logger::drainLoop()
+{
+    std::unique_lock<std::mutex> lock{mMutex};
+    while (!mStop) {
+        mDrainRequested.wait_for(lock, cDrainInterval);
+        drain();
+    }
+}
+
+void Logger::format(const LogRecord& record)
+{
+    mBatch += getDateTime(record.mTime);
+    mBatch += "[";
+    mBatch += getLevelName(static_cast<LogLevel>(record.mLevel));
+    mBatch += "] ";
+    if (record.mJobId != 0) {
+        mBatch += "[job " + std::to_string(record.mJobId) + "] ";
+    }
+    mBatch += record.mMsg;
+    mBatch += "\n";
+}
+
+const std::string& Logger::getDateTime(const std::chrono::system_clock::time_point& time)
+{
     // Time converted to std::time_t
-    auto nowConv = std::chrono::system_clock::to_time_t(now);
+    const auto timeConv{std::chrono::system_clock::to_time_t(time)};
 
-    std::stringstream ss{};
-    ss << "[";
-    ss << std::put_time(std::localtime(&nowConv), "%Y-%m-%d %X");
-    ss << "]";
+    // The date and time only change once per second
+    if (timeConv != mCachedSecond) {
+        std::stringstream ss{};
+        ss << "[";
+        ss << std::put_time(std::localtime(&timeConv), "%Y-%m-%d %X");
+        ss << "]";
 
-    return ss.str();
+        mCachedSecond = timeConv;
+        mCachedDateTime = ss.str();
+    }
+
+    return mCachedDateTime;
+}
+
+const char* Logger::getLevelName(const LogLevel level)
+{
+    switch (level) {
+    case LogLevel::FATAL:
+        return "FATAL";
+    case LogLevel::ERROR:
+        return "ERROR";
+    case LogLevel::WARNING:
+        return "WARNING";
+    case LogLevel::INFO:
+        return "INFO";
+    case LogLevel::DEBUG:
+        return "DEBUG";
+    case LogLevel::VERBOSE:
+        return "VERBOSE";
+    default:
+        return "";
+    }
 }
 
 } // namespace logging
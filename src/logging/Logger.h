@@ -4,13 +4,40 @@
 
 #pragma once
 
+#include "LogFormat.h"
+#include "LogRingBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace circuitSegmentation {
 namespace logging {
 
 /**
  * @brief Simple logger.
+ *
+ * The logger can be used by multiple threads: each message is written to the output stream as a whole.
+ *
+ * The logger has two modes:
+ * - Synchronous: the message is written and flushed to the output stream by the thread that logs it.
+ * - Asynchronous: the message is appended to a lock-free ring buffer of the thread that logs it, and a background
+ * thread formats and writes the messages of all the ring buffers in batches, flushing the output stream once per batch.
+ * The order of the messages is kept for each thread, but not between threads.
+ *
+ * Each message carries the job ID of the thread that logs it (see setJobId), which is written if it is not 0.
+ *
+ * The messages can be given already built or as a format string with arguments (e.g. logDebug("Contours: {}", n)).
+ * In the latter case, the message is only formatted if its level is enabled. When the project is built with the
+ * LOG_STRIP_DEBUG definition, the debug and verbose messages are removed at compile time.
  */
 class Logger
 {
@@ -38,21 +65,47 @@ public:
         VERBOSE = 6
     };
 
+    /**
+     * @brief Enumeration of the log modes.
+     */
+    enum class LogMode : unsigned char {
+        /** Messages are written by the thread that logs them. */
+        SYNCHRONOUS = 0,
+        /** Messages are written by a background thread. */
+        ASYNCHRONOUS = 1
+    };
+
     /** Default log level. */
     static constexpr auto cLogLevelDefault{LogLevel::VERBOSE};
 
+    /** Default log mode. */
+    static constexpr auto cLogModeDefault{LogMode::SYNCHRONOUS};
+
+    /** Flag for the debug and verbose messages being compiled. */
+#ifdef LOG_STRIP_DEBUG
+    static constexpr bool cDebugLogsEnabled{false};
+#else
+    static constexpr bool cDebugLogsEnabled{true};
+#endif
+
+    /** Interval for the background thread to write the messages, in asynchronous mode. */
+    static constexpr std::chrono::milliseconds cDrainInterval{10};
+
     /**
      * @brief Constructor.
      *
      * @param ostream Output stream.
      * @param level Log level.
+     * @param mode Log mode.
      */
-    explicit Logger(std::ostream& ostream, LogLevel level = cLogLevelDefault);
+    explicit Logger(std::ostream& ostream, LogLevel level = cLogLevelDefault, LogMode mode = cLogModeDefault);
 
     /**
      * @brief Destructor.
+     *
+     * In asynchronous mode, the messages waiting to be written are written before destruction.
      */
-    virtual ~Logger() = default;
+    virtual ~Logger();
 
     /**
      * @brief Sets the log level.
@@ -68,6 +121,48 @@ public:
      */
     [[nodiscard]] virtual LogLevel getLogLevel() const;
 
+    /**
+     * @brief Checks if messages of a log level are logged.
+     *
+     * @param level Log level of the messages.
+     *
+     * @return True if the messages are logged, otherwise false.
+     */
+    [[nodiscard]] bool isLogLevelEnabled(const LogLevel level) const
+    {
+        return mLogLevel.load(std::memory_order_relaxed) >= level;
+    }
+
+    /**
+     * @brief Gets the log mode.
+     *
+     * @return Log mode.
+     */
+    [[nodiscard]] virtual LogMode getLogMode() const;
+
+    /**
+     * @brief Writes the messages waiting to be written and flushes the output stream.
+     *
+     * In asynchronous mode, the messages logged by any thread before this call are written when it returns.
+     */
+    virtual void flush();
+
+    /**
+     * @brief Sets the job ID of the calling thread.
+     *
+     * The job ID is carried by the messages logged by the calling thread, until it is changed.
+     *
+     * @param jobId Job ID (0 when there is no job).
+     */
+    static void setJobId(const std::uint64_t jobId);
+
+    /**
+     * @brief Gets the job ID of the calling thread.
+     *
+     * @return Job ID (0 when there is no job).
+     */
+    [[nodiscard]] static std::uint64_t getJobId();
+
     /**
      * @brief Logs fatal messages.
      *
@@ -75,6 +170,21 @@ public:
      */
     virtual void logFatal(const std::string& msg);
 
+    /**
+     * @brief Logs fatal messages, formatted only if the fatal level is enabled.
+     *
+     * @param format Format string, where each placeholder "{}" is replaced by the next argument.
+     * @param arg First argument.
+     * @param args Other arguments.
+     */
+    template<typename Arg, typename... Args>
+    void logFatal(const std::string_view format, const Arg& arg, const Args&... args)
+    {
+        if (isLogLevelEnabled(LogLevel::FATAL)) {
+            logFatal(formatLog(format, arg, args...));
+        }
+    }
+
     /**
      * @brief Logs error messages.
      *
@@ -82,6 +192,21 @@ public:
      */
     virtual void logError(const std::string& msg);
 
+    /**
+     * @brief Logs error messages, formatted only if the error level is enabled.
+     *
+     * @param format Format string, where each placeholder "{}" is replaced by the next argument.
+     * @param arg First argument.
+     * @param args Other arguments.
+     */
+    template<typename Arg, typename... Args>
+    void logError(const std::string_view format, const Arg& arg, const Args&... args)
+    {
+        if (isLogLevelEnabled(LogLevel::ERROR)) {
+            logError(formatLog(format, arg, args...));
+        }
+    }
+
     /**
      * @brief Logs warning messages.
      *
@@ -89,6 +214,21 @@ public:
      */
     virtual void logWarning(const std::string& msg);
 
+    /**
+     * @brief Logs warning messages, formatted only if the warning level is enabled.
+     *
+     * @param format Format string, where each placeholder "{}" is replaced by the next argument.
+     * @param arg First argument.
+     * @param args Other arguments.
+     */
+    template<typename Arg, typename... Args>
+    void logWarning(const std::string_view format, const Arg& arg, const Args&... args)
+    {
+        if (isLogLevelEnabled(LogLevel::WARNING)) {
+            logWarning(formatLog(format, arg, args...));
+        }
+    }
+
     /**
      * @brief Logs information messages.
      *
@@ -96,6 +236,21 @@ public:
      */
     virtual void logInfo(const std::string& msg);
 
+    /**
+     * @brief Logs information messages, formatted only if the information level is enabled.
+     *
+     * @param format Format string, where each placeholder "{}" is replaced by the next argument.
+     * @param arg First argument.
+     * @param args Other arguments.
+     */
+    template<typename Arg, typename... Args>
+    void logInfo(const std::string_view format, const Arg& arg, const Args&... args)
+    {
+        if (isLogLevelEnabled(LogLevel::INFO)) {
+            logInfo(formatLog(format, arg, args...));
+        }
+    }
+
     /**
      * @brief Logs debug messages.
      *
@@ -103,6 +258,23 @@ public:
      */
     virtual void logDebug(const std::string& msg);
 
+    /**
+     * @brief Logs debug messages, formatted only if the debug level is enabled.
+     *
+     * @param format Format string, where each placeholder "{}" is replaced by the next argument.
+     * @param arg First argument.
+     * @param args Other arguments.
+     */
+    template<typename Arg, typename... Args>
+    void logDebug(const std::string_view format, const Arg& arg, const Args&... args)
+    {
+        if constexpr (cDebugLogsEnabled) {
+            if (isLogLevelEnabled(LogLevel::DEBUG)) {
+                logDebug(formatLog(format, arg, args...));
+            }
+        }
+    }
+
     /**
      * @brief Logs verbose messages.
      *
@@ -110,6 +282,23 @@ public:
      */
     virtual void logVerbose(const std::string& msg);
 
+    /**
+     * @brief Logs verbose messages, formatted only if the verbose level is enabled.
+     *
+     * @param format Format string, where each placeholder "{}" is replaced by the next argument.
+     * @param arg First argument.
+     * @param args Other arguments.
+     */
+    template<typename Arg, typename... Args>
+    void logVerbose(const std::string_view format, const Arg& arg, const Args&... args)
+    {
+        if constexpr (cDebugLogsEnabled) {
+            if (isLogLevelEnabled(LogLevel::VERBOSE)) {
+                logVerbose(formatLog(format, arg, args...));
+            }
+        }
+    }
+
 private:
     /**
      * @brief Logs the message.
@@ -117,23 +306,100 @@ private:
      * @param level Log level of the message.
      * @param msg Message to log.
      */
-    virtual void log(const std::string& level, const std::string& msg);
+    virtual void log(const LogLevel level, const std::string& msg);
+
+    /**
+     * @brief Gets the ring buffer of the calling thread, creating it when the thread logs for the first time.
+     *
+     * @return Ring buffer.
+     */
+    virtual std::shared_ptr<LogRingBuffer> getRingBuffer();
+
+    /**
+     * @brief Writes the records of all the ring buffers to the output stream, as a batch.
+     *
+     * The mutex for writing to the output stream must be locked by the caller.
+     */
+    virtual void drain();
+
+    /**
+     * @brief Loop of the background thread, which writes the records periodically or when requested.
+     */
+    virtual void drainLoop();
+
+    /**
+     * @brief Formats the record and appends it to the batch to be written.
+     *
+     * @param record Record.
+     */
+    virtual void format(const LogRecord& record);
 
     /**
-     * @brief Gets the current date and time.
+     * @brief Gets the date and time of a time point.
+     *
+     * Format of the output: [YYYY-MM-DD HH:MM:SS].
+     * The string is only computed when the second changes, as the messages are logged much more often than that.
      *
-     * Format of the output: YYYY-MM-DD HH:MM:SS.
+     * @param time Time point.
      *
-     * @return String with the current date and time.
+     * @return String with the date and time.
      */
-    virtual const std::string getDateTime() const;
+    virtual const std::string& getDateTime(const std::chrono::system_clock::time_point& time);
+
+    /**
+     * @brief Gets the name of a log level.
+     *
+     * @param level Log level.
+     *
+     * @return Name of the log level.
+     */
+    static const char* getLevelName(const LogLevel level);
 
 private:
     /** Output stream. */
     std::ostream& mOstream;
 
+    /** Mutex for writing to the output stream (it also protects the batch and the date and time). */
+    std::mutex mMutex;
+
     /** Log level. */
-    LogLevel mLogLevel{cLogLevelDefault};
+    std::atomic<LogLevel> mLogLevel{cLogLevelDefault};
+
+    /** Log mode. */
+    const LogMode mLogMode;
+
+    /** ID of this logger, to find the ring buffers of the threads. */
+    const std::uint64_t mId;
+
+    /** Batch of formatted messages to be written. */
+    std::string mBatch{};
+
+    /** Second of the cached date and time. */
+    std::time_t mCachedSecond{-1};
+
+    /** Cached date and time. */
+    std::string mCachedDateTime{};
+
+    /** Mutex for the ring buffers. */
+    std::mutex mRingBuffersMutex;
+
+    /** Ring buffers of the threads that logged messages. */
+    std::vector<std::shared_ptr<LogRingBuffer>> mRingBuffers{};
+
+    /** Condition signaled to request the records to be written. */
+    std::condition_variable mDrainRequested;
+
+    /** Flag to stop the background thread. */
+    bool mStop{false};
+
+    /** Background thread, in asynchronous mode. It is declared last, so it starts after the other members. */
+    std::thread mDrainThread{};
+
+    /** Job ID of the thread. */
+    static inline thread_local std::uint64_t mJobId{0};
+
+    /** Counter to generate the IDs of the loggers. */
+    static inline std::atomic<std::uint64_t> mIdCounter{0};
 };
 
 } // namespace logging
@@ -0,0 +1,247 @@
+/**
+ * @file
+ */
+
+#include "ImageWriter.h"
+#include <filesystem>
+#include <utility>
+
+namespace circuitSegmentation {
+namespace output {
+
+ImageWriter::ImageWriter(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                         const std::shared_ptr<logging::Logger>& logger,
+                         const unsigned int numThreads,
+                         const std::size_t memoryBudget)
+    : mOpenCvWrapper{openCvWrapper}
+    , mLogger{logger}
+    , mMemoryBudget{memoryBudget}
+    , mThreadPool{numThreads}
+{
+}
+
+ImageWriter::~ImageWriter()
+{
+    // Wait for the images of all the jobs
+    std::unique_lock<std::mutex> lock{mMutex};
+    mImageWritten.wait(lock, [this]() { return mImagesInFlight == 0; });
+}
+
+std::shared_future<bool> ImageWriter::writeImage(const std::string& fileName, computerVision::ImageMat image)
+{
+    // The image belongs to the job of the caller, and the messages logged while writing it carry its job ID
+    const auto jobId{logging::Logger::getJobId()};
+
+    // File path in the output directory
+    const auto outputDirectory{getOutputDirectory()};
+    const auto filePath{outputDirectory.empty() ? fileName
+                                                : (std::filesystem::path{outputDirectory} / fileName).string()};
+
+    // Wait for memory available
+    const auto bytes{mOpenCvWrapper->getImageSizeBytes(image)};
+    reserveMemory(bytes, jobId);
+
+    auto future{mThreadPool.submit([this, filePath, bytes, jobId, image{std::move(image)}]() mutable {
+        logging::Logger::setJobId(jobId);
+
+        // Write image
+        const auto success{mOpenCvWrapper->writeImage(filePath, image)};
+        if (!success) {
+            mLogger->logError("Failed to write image {}", filePath);
+        }
+
+        // Release the image before signaling the memory available
+        image = computerVision::ImageMat{};
+        releaseMemory(bytes, jobId, success);
+
+        return success;
+    })};
+
+    return future.share();
+}
+
+std::shared_future<std::vector<unsigned char>> ImageWriter::encodeImage(computerVision::ImageMat image)
+{
+    // The image belongs to the job of the caller, and the messages logged while encoding it carry its job ID
+    const auto jobId{logging::Logger::getJobId()};
+
+    // Wait for memory available
+    const auto bytes{mOpenCvWrapper->getImageSizeBytes(image)};
+    reserveMemory(bytes, jobId);
+
+    auto future{mThreadPool.submit([this, bytes, jobId, image{std::move(image)}]() mutable {
+        logging::Logger::setJobId(jobId);
+
+        // Encode image
+        std::vector<unsigned char> buffer{};
+        const auto success{mOpenCvWrapper->encodeImage(cEncodedImageExtension, image, buffer)};
+        if (!success) {
+            mLogger->logError("Failed to encode image");
+            buffer.clear();
+        }
+
+        // Release the image before signaling the memory available
+        image = computerVision::ImageMat{};
+        releaseMemory(bytes, jobId, success);
+
+        return buffer;
+    })};
+
+    return future.share();
+}
+
+bool ImageWriter::flush()
+{
+    const auto jobId{logging::Logger::getJobId()};
+
+    std::unique_lock<std::mutex> lock{mMutex};
+    mImageWritten.wait(lock, [this, jobId]() {
+        const auto job{mJobs.find(jobId)};
+        return job == mJobs.end() || job->second.mImagesInFlight == 0;
+    });
+
+    // End of the job
+    const auto job{mJobs.find(jobId)};
+    if (job == mJobs.end()) {
+        return true;
+    }
+    const auto success{job->second.mFailures == 0};
+    mJobs.erase(job);
+
+    return success;
+}
+
+void ImageWriter::whenFlushed(const std::uint64_t jobId, std::function<void(bool)> onFlushed)
+{
+    auto success{true};
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        const auto job{mJobs.find(jobId)};
+        if (job != mJobs.end()) {
+            // Called by the thread that writes the last image
+            if (job->second.mImagesInFlight > 0) {
+                job->second.mFlushCallbacks.push_back(std::move(onFlushed));
+                return;
+            }
+
+            // End of the job
+            success = job->second.mFailures == 0;
+            mJobs.erase(job);
+        }
+    }
+
+    onFlushed(success);
+}
+
+#ifdef COROUTINES_SUPPORTED
+ImageWriter::FlushAwaiter ImageWriter::flushAsync(common::Executor& executor)
+{
+    return FlushAwaiter{*this, executor, logging::Logger::getJobId()};
+}
+
+ImageWriter::FlushAwaiter::FlushAwaiter(ImageWriter& imageWriter,
+                                        common::Executor& executor,
+                                        const std::uint64_t jobId)
+    : mImageWriter{imageWriter}
+    , mExecutor{executor}
+    , mJobId{jobId}
+{
+}
+
+bool ImageWriter::FlushAwaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+void ImageWriter::FlushAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    // The coroutine may be resumed before this method returns, so the awaiter is not used after the callback
+    mImageWriter.whenFlushed(mJobId, [this, handle](const bool success) {
+        mSuccess = success;
+        mExecutor.execute([handle]() { handle.resume(); });
+    });
+}
+
+bool ImageWriter::FlushAwaiter::await_resume() const noexcept
+{
+    return mSuccess;
+}
+#endif
+
+unsigned int ImageWriter::getNumThreads() const
+{
+    return mThreadPool.getNumThreads();
+}
+
+std::size_t ImageWriter::getMemoryBudget() const
+{
+    return mMemoryBudget;
+}
+
+void ImageWriter::setOutputDirectory(const std::string& outputDirectory)
+{
+    const auto jobId{logging::Logger::getJobId()};
+
+    std::lock_guard<std::mutex> lock{mMutex};
+    if (jobId == 0) {
+        mOutputDirectory = outputDirectory;
+    } else {
+        mJobs[jobId].mOutputDirectory = outputDirectory;
+    }
+}
+
+std::string ImageWriter::getOutputDirectory() const
+{
+    const auto jobId{logging::Logger::getJobId()};
+
+    std::lock_guard<std::mutex> lock{mMutex};
+    const auto job{mJobs.find(jobId)};
+    if (job != mJobs.end() && job->second.mOutputDirectory) {
+        return *job->second.mOutputDirectory;
+    }
+
+    return mOutputDirectory;
+}
+
+void ImageWriter::reserveMemory(const std::size_t bytes, const std::uint64_t jobId)
+{
+    std::unique_lock<std::mutex> lock{mMutex};
+    mImageWritten.wait(lock,
+                       [this, bytes]() { return mImagesInFlight == 0 || mBytesInFlight + bytes <= mMemoryBudget; });
+
+    mBytesInFlight += bytes;
+    ++mImagesInFlight;
+    ++mJobs[jobId].mImagesInFlight;
+}
+
+void ImageWriter::releaseMemory(const std::size_t bytes, const std::uint64_t jobId, const bool success)
+{
+    std::vector<std::function<void(bool)>> flushCallbacks{};
+    auto flushSuccess{true};
+    {
+        std::lock_guard<std::mutex> lock{mMutex};
+        mBytesInFlight -= bytes;
+        --mImagesInFlight;
+
+        auto& job{mJobs[jobId]};
+        --job.mImagesInFlight;
+        if (!success) {
+            ++job.mFailures;
+        }
+
+        // End of the job, when its flush is awaited
+        if (job.mImagesInFlight == 0 && !job.mFlushCallbacks.empty()) {
+            flushCallbacks = std::move(job.mFlushCallbacks);
+            flushSuccess = job.mFailures == 0;
+            mJobs.erase(jobId);
+        }
+    }
+    mImageWritten.notify_all();
+
+    for (const auto& onFlushed : flushCallbacks) {
+        onFlushed(flushSuccess);
+    }
+}
+
+} // namespace output
+} // namespace circuitSegmentation
@@ -0,0 +1,268 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "common/Executor.h"
+#include "common/Task.h"
+#include "common/ThreadBudget.h"
+#include "common/ThreadPool.h"
+#include "computerVision/OpenCvWrapper.h"
+#include "logging/Logger.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace circuitSegmentation {
+namespace output {
+
+/**
+ * @brief Asynchronous writer of image files.
+ *
+ * The images are encoded and written by a dedicated pool of threads, so the encoding is kept out of the processing
+ * path. The images can also be encoded to memory only, without writing files. The memory of the images waiting to be
+ * written is bounded by a budget: when the budget is exhausted, the writing of a new image blocks until enough images
+ * are written.
+ *
+ * The writer can be shared by the processings running in parallel: the images are tracked by the job ID of the thread
+ * that writes them (see logging::Logger::setJobId), so each job has its own output directory and flushes only its own
+ * images.
+ */
+class ImageWriter
+{
+public:
+#ifdef COROUTINES_SUPPORTED
+    /**
+     * @brief Awaitable of the writing of the images of a job.
+     */
+    class FlushAwaiter
+    {
+    public:
+        /**
+         * @brief Constructor.
+         *
+         * @param imageWriter Image writer.
+         * @param executor Executor where the awaiting coroutine is resumed.
+         * @param jobId Job ID of the images.
+         */
+        FlushAwaiter(ImageWriter& imageWriter, common::Executor& executor, const std::uint64_t jobId);
+
+        bool await_ready() const noexcept;
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        bool await_resume() const noexcept;
+
+    private:
+        /** Image writer. */
+        ImageWriter& mImageWriter;
+        /** Executor where the awaiting coroutine is resumed. */
+        common::Executor& mExecutor;
+        /** Job ID of the images. */
+        const std::uint64_t mJobId;
+        /** Result of the writing of the images. */
+        bool mSuccess{false};
+    };
+#endif
+
+    /** Default number of threads for writing images. */
+    static constexpr unsigned int cNumThreadsDefault{common::ThreadBudget::cNumWriterThreadsDefault};
+    /** Default budget of memory for images waiting to be written, in bytes. */
+    static constexpr std::size_t cMemoryBudgetDefault{256 * 1024 * 1024};
+    /** Extension that defines the format of the images encoded to memory. */
+    static constexpr auto cEncodedImageExtension{".png"};
+
+    /**
+     * @brief Constructor.
+     *
+     * @param openCvWrapper OpenCV wrapper.
+     * @param logger Logger.
+     * @param numThreads Number of threads for writing images.
+     * @param memoryBudget Budget of memory for images waiting to be written, in bytes.
+     */
+    explicit ImageWriter(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                         const std::shared_ptr<logging::Logger>& logger,
+                         const unsigned int numThreads = cNumThreadsDefault,
+                         const std::size_t memoryBudget = cMemoryBudgetDefault);
+
+    /**
+     * @brief Destructor.
+     *
+     * The images waiting to be written are written before destruction.
+     */
+    virtual ~ImageWriter();
+
+    /**
+     * @brief Writes the image to the file asynchronously.
+     *
+     * The writer takes ownership of the image: the pixel data must not be modified after this call. If the image
+     * is still processed in place by the caller, a clone must be given instead.
+     *
+     * @param fileName File name, relative to the output directory.
+     * @param image Image.
+     *
+     * @return Future for the result of the writing: true if the operation occurred successfully, otherwise false.
+     */
+    virtual std::shared_future<bool> writeImage(const std::string& fileName, computerVision::ImageMat image);
+
+    /**
+     * @brief Encodes the image to memory asynchronously, in the format defined by @ref cEncodedImageExtension.
+     *
+     * The writer takes ownership of the image, as in @ref writeImage, and the image counts for the same budget of
+     * memory and for the failures reported by @ref flush.
+     *
+     * @param image Image.
+     *
+     * @return Future for the encoded image, which is empty if the operation failed.
+     */
+    virtual std::shared_future<std::vector<unsigned char>> encodeImage(computerVision::ImageMat image);
+
+    /**
+     * @brief Waits until all the images of the job of the calling thread are written.
+     *
+     * The failures are reported once, so the next flush only reports the failures of images written after this call.
+     * The job ends with its flush, so its output directory is cleared.
+     *
+     * @return True if all the images written since the last flush were written successfully, otherwise false.
+     */
+    virtual bool flush();
+
+    /**
+     * @brief Calls a callback when all the images of a job are written, without waiting.
+     *
+     * The callback is called with the result that @ref flush would return for the job. It is called on the calling
+     * thread when there are no images waiting to be written, otherwise on the thread that writes the last image of the
+     * job, so it must not block.
+     *
+     * @param jobId Job ID of the images.
+     * @param onFlushed Callback called with true if all the images were written successfully, otherwise false.
+     */
+    virtual void whenFlushed(const std::uint64_t jobId, std::function<void(bool)> onFlushed);
+
+#ifdef COROUTINES_SUPPORTED
+    /**
+     * @brief Flushes the images of the job of the calling thread, suspending the awaiting coroutine instead of
+     * blocking its thread.
+     *
+     * The job is taken when this method is called, so the coroutine can leave its job context before awaiting. The
+     * coroutine is resumed on the executor when the images are written (see @ref whenFlushed), and the awaitable gives
+     * the result of @ref flush.
+     *
+     * @param executor Executor where the awaiting coroutine is resumed.
+     *
+     * @return Awaitable.
+     */
+    [[nodiscard]] virtual FlushAwaiter flushAsync(common::Executor& executor);
+#endif
+
+    /**
+     * @brief Gets the number of threads for writing images.
+     *
+     * @return Number of threads for writing images.
+     */
+    [[nodiscard]] virtual unsigned int getNumThreads() const;
+
+    /**
+     * @brief Gets the budget of memory for images waiting to be written.
+     *
+     * @return Budget of memory, in bytes.
+     */
+    [[nodiscard]] virtual std::size_t getMemoryBudget() const;
+
+    /**
+     * @brief Sets the directory where the images of the job of the calling thread are written.
+     *
+     * The directory only applies to the images written after this call, and it must exist. The directory set without
+     * a job (job ID 0) applies to the jobs without their own.
+     *
+     * @param outputDirectory Output directory (empty for the working directory).
+     */
+    virtual void setOutputDirectory(const std::string& outputDirectory);
+
+    /**
+     * @brief Gets the directory where the images of the job of the calling thread are written.
+     *
+     * @return Output directory (empty for the working directory).
+     */
+    [[nodiscard]] virtual std::string getOutputDirectory() const;
+
+private:
+    /**
+     * @brief State of the images of a job.
+     */
+    struct Job
+    {
+        /** Number of images waiting to be written. */
+        unsigned int mImagesInFlight{0};
+        /** Number of images that failed to be written since the last flush. */
+        unsigned int mFailures{0};
+        /** Directory where the images are written, if the job has its own. */
+        std::optional<std::string> mOutputDirectory{};
+        /** Callbacks called when the images are written. */
+        std::vector<std::function<void(bool)>> mFlushCallbacks{};
+    };
+
+    /**
+     * @brief Reserves the memory for an image of a job, waiting until the budget allows it.
+     *
+     * An image bigger than the budget is only accepted when there are no images waiting to be written.
+     *
+     * @param bytes Size of the image, in bytes.
+     * @param jobId Job ID of the image.
+     */
+    void reserveMemory(const std::size_t bytes, const std::uint64_t jobId);
+
+    /**
+     * @brief Releases the memory of a written image and records the result of the writing.
+     *
+     * The callbacks of the flush of the job are called when it was its last image.
+     *
+     * @param bytes Size of the image, in bytes.
+     * @param jobId Job ID of the image.
+     * @param success Result of the writing.
+     */
+    void releaseMemory(const std::size_t bytes, const std::uint64_t jobId, const bool success);
+
+private:
+    /** OpenCV wrapper. */
+    std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+
+    /** Budget of memory for images waiting to be written, in bytes. */
+    const std::size_t mMemoryBudget;
+
+    /** Directory where the images of the jobs without their own are written (empty for the working directory). */
+    std::string mOutputDirectory{};
+
+    /** Mutex for the state of the writer. */
+    mutable std::mutex mMutex;
+
+    /** Condition signaled when an image is written. */
+    std::condition_variable mImageWritten;
+
+    /** Memory of the images waiting to be written, in bytes. */
+    std::size_t mBytesInFlight{0};
+
+    /** Number of images waiting to be written, of all the jobs. */
+    unsigned int mImagesInFlight{0};
+
+    /** State of the jobs with images written, or with their own output directory, by job ID. */
+    std::unordered_map<std::uint64_t, Job> mJobs;
+
+    /** Pool of threads for writing images. It is declared last, so it is the first member to be destroyed. */
+    common::ThreadPool mThreadPool;
+};
+
+} // namespace output
+} // namespace circuitSegmentation
@@ -4,14 +4,17 @@
 
 #include "ComponentDetection.h"
 #include "application/Config.h"
+#include "common/CancellationToken.h"
 #include "SegmentationUtils.h"
 
 namespace circuitSegmentation {
 namespace schematicSegmentation {
 
 ComponentDetection::ComponentDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                       const std::shared_ptr<output::ImageWriter>& imageWriter,
                                        const std::shared_ptr<logging::Logger>& logger)
     : mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
     , mLogger{logger}
     , mComponents{}
 {
@@ -47,7 +50,8 @@ bool ComponentDetection::detectComponents(computerVision::ImageMat& imageInitial
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_components_remove_connections.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_segment_components_remove_connections.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Removing the connections from the preprocessed image", image, 0);
 #endif
@@ -55,15 +59,15 @@ bool ComponentDetection::detectComponents(computerVision::ImageMat& imageInitial
 
     // Morphological closing for dilation of circuit elements
     auto kernelMorph{mOpenCvWrapper->getStructuringElement(computerVision::OpenCvWrapper::MorphShapes::MORPH_RECT,
-                                                           cMorphCloseKernelSize)};
+                                                           mParameters.mMorphCloseKernelSize)};
     mOpenCvWrapper->morphologyEx(
-        image, image, computerVision::OpenCvWrapper::MorphTypes::MORPH_CLOSE, kernelMorph, cMorphCloseIter);
+        image, image, computerVision::OpenCvWrapper::MorphTypes::MORPH_CLOSE, kernelMorph, mParameters.mMorphCloseIter);
 
     mLogger->logInfo("Morphological closing applied to the image");
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_components_morph_close.png", image);
+        mImageWriter->writeImage("cs_segment_components_morph_close.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Morphological closing to detect components", image, 0);
 #endif
@@ -74,9 +78,17 @@ bool ComponentDetection::detectComponents(computerVision::ImageMat& imageInitial
     computerVision::ContoursHierarchy hierarchy{};
     mOpenCvWrapper->findContours(image, contours, hierarchy, cFindContourMode, cFindContourMethod);
 
-    mLogger->logDebug("Contours found in the image, to detect components: " + std::to_string(contours.size()));
+    mLogger->logDebug("Contours found in the image, to detect components: {}", contours.size());
 
+    // Component for each contour (the components of a previous image are discarded)
+    mComponents.clear();
     for (const auto& contour : contours) {
+        // Stop if the job was cancelled or its deadline expired
+        if (common::CancellationToken::isCurrentStopped()) {
+            mLogger->logWarning("Detection of components stopped");
+            return false;
+        }
+
         // Check contour
         const auto box{checkContour(imagePreprocessed, contour, connections)};
 
@@ -88,7 +100,7 @@ bool ComponentDetection::detectComponents(computerVision::ImageMat& imageInitial
         }
     }
 
-    mLogger->logInfo("Components found in the circuit: " + std::to_string(mComponents.size()));
+    mLogger->logInfo("Components found in the circuit: {}", mComponents.size());
 
     // If there are no components detected, it makes no sense to continue
     if (mComponents.empty()) {
@@ -106,7 +118,7 @@ bool ComponentDetection::detectComponents(computerVision::ImageMat& imageInitial
                                       computerVision::OpenCvWrapper::LineTypes::LINE_8);
         }
 
-        mOpenCvWrapper->writeImage("cs_segment_components_detected.png", image);
+        mImageWriter->writeImage("cs_segment_components_detected.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Detecting components", image, 0);
 #endif
@@ -120,6 +132,33 @@ const std::vector<circuit::Component>& ComponentDetection::getDetectedComponents
     return mComponents;
 }
 
+void ComponentDetection::setPreset(const common::Preset& preset)
+{
+    mPreset = preset;
+    mParameters = getParameters(preset);
+}
+
+common::Preset ComponentDetection::getPreset() const
+{
+    return mPreset;
+}
+
+ComponentDetection::Parameters ComponentDetection::getParameters(const common::Preset& preset)
+{
+    // Fewer iterations of the morphological closing, the most expensive operation of the detection
+    if (preset == common::Preset::FAST) {
+        return Parameters{
+            .mMorphCloseKernelSize = cMorphCloseKernelSize, .mMorphCloseIter = 2, .mBoxMinArea = cBoxMinArea};
+    }
+
+    return Parameters{.mMorphCloseKernelSize = cMorphCloseKernelSize, .mMorphCloseIter = 3, .mBoxMinArea = cBoxMinArea};
+}
+
+void ComponentDetection::setParameters(const Parameters& parameters)
+{
+    mParameters = parameters;
+}
+
 void ComponentDetection::removeConnectionsFromImage(computerVision::ImageMat& image,
                                                     const std::vector<circuit::Connection>& connections)
 {
@@ -147,15 +186,15 @@ std::optional<computerVision::Rectangle>
     auto intersect{false};
 
     // Check bounding box area
-    if (mOpenCvWrapper->rectangleArea(box) >= cBoxMinArea) {
+    if (mOpenCvWrapper->rectangleArea(box) >= mParameters.mBoxMinArea) {
         // Check if the box has intersection points with connections
         for (const auto& connection : connections) {
             for (const auto& point : connection.mWire) {
                 // Intersection
                 intersect = mOpenCvWrapper->contains(box, point);
                 if (intersect) {
-                    mLogger->logDebug("Intersection point between contour and connection at {" + std::to_string(point.x)
-                                      + ", " + std::to_string(point.y) + "}");
+                    mLogger->logDebug(
+                        "Intersection point between contour and connection at {{{}, {}}}", point.x, point.y);
 
                     // There is at least one intersection point, so no need to check other points of this wire
                     break;
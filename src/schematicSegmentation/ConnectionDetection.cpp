@@ -4,14 +4,17 @@
 
 #include "ConnectionDetection.h"
 #include "application/Config.h"
+#include "common/CancellationToken.h"
 #include "SegmentationUtils.h"
 
 namespace circuitSegmentation {
 namespace schematicSegmentation {
 
 ConnectionDetection::ConnectionDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                         const std::shared_ptr<output::ImageWriter>& imageWriter,
                                          const std::shared_ptr<logging::Logger>& logger)
     : mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
     , mLogger{logger}
     , mConnections{}
     , mNodes{}
@@ -46,15 +49,19 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
 
     // Morphological closing for dilation of circuit elements
     auto kernelMorph{mOpenCvWrapper->getStructuringElement(computerVision::OpenCvWrapper::MorphShapes::MORPH_RECT,
-                                                           cMorphCloseKernelSize)};
-    mOpenCvWrapper->morphologyEx(
-        imagePreprocessed, image, computerVision::OpenCvWrapper::MorphTypes::MORPH_CLOSE, kernelMorph, cMorphCloseIter);
+                                                           mParameters.mMorphCloseKernelSize)};
+    mOpenCvWrapper->morphologyEx(imagePreprocessed,
+                                 image,
+                                 computerVision::OpenCvWrapper::MorphTypes::MORPH_CLOSE,
+                                 kernelMorph,
+                                 mParameters.mMorphCloseIter);
 
     mLogger->logInfo("Morphological closing applied to the image");
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_connections_morph_close.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_segment_connections_morph_close.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Morphological closing to detect connections", image, 0);
 #endif
@@ -70,7 +77,8 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_connections_morph_open.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_segment_connections_morph_open.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Morphological opening to detect connections", image, 0);
 #endif
@@ -83,7 +91,7 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_connections_intersection.png", image);
+        mImageWriter->writeImage("cs_segment_connections_intersection.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Intersection between images to detect connections", image, 0);
 #endif
@@ -94,7 +102,7 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
     computerVision::ContoursHierarchy hierarchy{};
     mOpenCvWrapper->findContours(image, contours, hierarchy, cFindContourMode, cFindContourMethod);
 
-    mLogger->logDebug("Contours found in the intersection image: " + std::to_string(contours.size()));
+    mLogger->logDebug("Contours found in the intersection image: {}", contours.size());
 
     // Generate bounding box for each contour and remove it from the image
     image = mOpenCvWrapper->cloneImage(imagePreprocessed);
@@ -113,7 +121,7 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_connections_only_conn.png", image);
+        mImageWriter->writeImage("cs_segment_connections_only_conn.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Image with only the circuit connections to detect connections", image, 0);
 #endif
@@ -123,13 +131,13 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
     computerVision::Contours wires{};
     mOpenCvWrapper->findContours(image, wires, hierarchy, cFindContourMode, cFindContourMethod);
 
-    mLogger->logDebug("Contours found in the image, to detect connections: " + std::to_string(wires.size()));
+    mLogger->logDebug("Contours found in the image, to detect connections: {}", wires.size());
 
     // Wire for each connection
     mConnections.clear();
     for (const auto& wire : wires) {
         // Check wire length
-        if (mOpenCvWrapper->arcLength(wire, false) >= cConnectionMinLength) {
+        if (mOpenCvWrapper->arcLength(wire, false) >= mParameters.mConnectionMinLength) {
             // Add connection
             circuit::Connection connection{};
             connection.mWire = wire;
@@ -137,7 +145,7 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
         }
     }
 
-    mLogger->logInfo("Connections found in the circuit: " + std::to_string(mConnections.size()));
+    mLogger->logInfo("Connections found in the circuit: {}", mConnections.size());
 
     // If there are no connections detected, it makes no sense to continue
     if (mConnections.empty()) {
@@ -159,7 +167,7 @@ bool ConnectionDetection::detectConnections(computerVision::ImageMat& imageIniti
                                      computerVision::OpenCvWrapper::LineTypes::LINE_8,
                                      {});
 
-        mOpenCvWrapper->writeImage("cs_segment_connections_detected.png", image);
+        mImageWriter->writeImage("cs_segment_connections_detected.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Detecting connections", image, 0);
 #endif
@@ -196,7 +204,7 @@ bool ConnectionDetection::updateConnections(computerVision::ImageMat& imageIniti
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_connections_remove_components.png", image);
+        mImageWriter->writeImage("cs_segment_connections_remove_components.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Remove components", image, 0);
 #endif
@@ -207,13 +215,13 @@ bool ConnectionDetection::updateConnections(computerVision::ImageMat& imageIniti
     computerVision::ContoursHierarchy hierarchy{};
     mOpenCvWrapper->findContours(image, wires, hierarchy, cFindContourMode, cFindContourMethod);
 
-    mLogger->logDebug("Contours found in the image, to update connections: " + std::to_string(wires.size()));
+    mLogger->logDebug("Contours found in the image, to update connections: {}", wires.size());
 
     // Wire for each connection
     mConnections.clear();
     for (const auto& wire : wires) {
         // Check wire length
-        if (mOpenCvWrapper->arcLength(wire, false) >= cConnectionMinLength) {
+        if (mOpenCvWrapper->arcLength(wire, false) >= mParameters.mConnectionMinLength) {
             // Add connection
             circuit::Connection connection{};
             connection.mWire = wire;
@@ -221,7 +229,7 @@ bool ConnectionDetection::updateConnections(computerVision::ImageMat& imageIniti
         }
     }
 
-    mLogger->logInfo("Connections found in the circuit: " + std::to_string(mConnections.size()));
+    mLogger->logInfo("Connections found in the circuit: {}", mConnections.size());
 
     // If there are no connections detected, it makes no sense to continue
     if (mConnections.empty()) {
@@ -243,7 +251,7 @@ bool ConnectionDetection::updateConnections(computerVision::ImageMat& imageIniti
                                      computerVision::OpenCvWrapper::LineTypes::LINE_8,
                                      {});
 
-        mOpenCvWrapper->writeImage("cs_segment_connections_updated.png", image);
+        mImageWriter->writeImage("cs_segment_connections_updated.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Updating connections", image, 0);
 #endif
@@ -296,6 +304,12 @@ bool ConnectionDetection::detectNodesUpdateConnections(computerVision::ImageMat&
     mNodes.clear();
 
     for (const auto& connection : connectionsCopy) {
+        // Stop if the job was cancelled or its deadline expired
+        if (common::CancellationToken::isCurrentStopped()) {
+            mLogger->logWarning("Detection of nodes stopped");
+            return false;
+        }
+
         std::vector<computerVision::Point> intersectionPoints{};
 
         for (const auto& component : componentsCopy) {
@@ -305,8 +319,8 @@ bool ConnectionDetection::detectNodesUpdateConnections(computerVision::ImageMat&
                 // Intersection
                 intersect = mOpenCvWrapper->contains(component.mBoundingBox, point);
                 if (intersect) {
-                    mLogger->logDebug("Intersection point between component and connection at {"
-                                      + std::to_string(point.x) + ", " + std::to_string(point.y) + "}");
+                    mLogger->logDebug(
+                        "Intersection point between component and connection at {{{}, {}}}", point.x, point.y);
 
                     intersectionPoints.push_back(point);
                     // There is at least one intersection point, so no need to check other points of this wire
@@ -316,7 +330,7 @@ bool ConnectionDetection::detectNodesUpdateConnections(computerVision::ImageMat&
         }
 
         const auto numIntersections{intersectionPoints.size()};
-        mLogger->logDebug("Number of intersection points for this connection = " + std::to_string(numIntersections));
+        mLogger->logDebug("Number of intersection points for this connection = {}", numIntersections);
 
         if (numIntersections > 0 && numIntersections <= 2) {
             // Add connection
@@ -337,8 +351,7 @@ bool ConnectionDetection::detectNodesUpdateConnections(computerVision::ImageMat&
             pos.mAngle = 0;
             node.mPosition = pos;
 
-            mLogger->logDebug("Node position = {" + std::to_string(node.mPosition.mX) + ", "
-                              + std::to_string(node.mPosition.mY) + "}");
+            mLogger->logDebug("Node position = {{{}, {}}}", node.mPosition.mX, node.mPosition.mY);
 
             // Create new connections
             for (size_t i{0}; i < numIntersections; ++i) {
@@ -366,8 +379,8 @@ bool ConnectionDetection::detectNodesUpdateConnections(computerVision::ImageMat&
         }
     }
 
-    mLogger->logInfo("Connections detected in the circuit: " + std::to_string(mConnections.size()));
-    mLogger->logInfo("Nodes detected in the circuit: " + std::to_string(mNodes.size()));
+    mLogger->logInfo("Connections detected in the circuit: {}", mConnections.size());
+    mLogger->logInfo("Nodes detected in the circuit: {}", mNodes.size());
 
     // If there are no connections detected, it makes no sense to continue
     if (mConnections.empty()) {
@@ -402,7 +415,7 @@ bool ConnectionDetection::detectNodesUpdateConnections(computerVision::ImageMat&
                 image, nodePoints, -1, cNodeColor, cNodeThickness, computerVision::OpenCvWrapper::LineTypes::LINE_8, {});
         }
 
-        mOpenCvWrapper->writeImage("cs_segment_nodes_detected_connections_updated.png", image);
+        mImageWriter->writeImage("cs_segment_nodes_detected_connections_updated.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Detecting nodes and updating connections", image, 0);
 #endif
@@ -421,12 +434,40 @@ const std::vector<circuit::Node>& ConnectionDetection::getDetectedNodes() const
     return mNodes;
 }
 
-#ifdef BUILD_TESTS
+void ConnectionDetection::setPreset(const common::Preset& preset)
+{
+    mPreset = preset;
+    mParameters = getParameters(preset);
+}
+
+common::Preset ConnectionDetection::getPreset() const
+{
+    return mPreset;
+}
+
+ConnectionDetection::Parameters ConnectionDetection::getParameters(const common::Preset& preset)
+{
+    // Fewer iterations of the morphological closing, the most expensive operation of the detection
+    if (preset == common::Preset::FAST) {
+        return Parameters{.mMorphCloseKernelSize = cMorphCloseKernelSize,
+                          .mMorphCloseIter = 3,
+                          .mConnectionMinLength = cConnectionMinLength};
+    }
+
+    return Parameters{.mMorphCloseKernelSize = cMorphCloseKernelSize,
+                      .mMorphCloseIter = 4,
+                      .mConnectionMinLength = cConnectionMinLength};
+}
+
+void ConnectionDetection::setParameters(const Parameters& parameters)
+{
+    mParameters = parameters;
+}
+
 void ConnectionDetection::setDetectedConnections(const std::vector<circuit::Connection>& connections)
 {
     mConnections = connections;
 }
-#endif
 
 } // namespace schematicSegmentation
 } // namespace circuitSegmentation
@@ -7,8 +7,10 @@
 #include "circuit/Component.h"
 #include "circuit/Connection.h"
 #include "circuit/Node.h"
+#include "common/Preset.h"
 #include "computerVision/OpenCvWrapper.h"
 #include "logging/Logger.h"
+#include "output/ImageWriter.h"
 #include <memory>
 #include <vector>
 
@@ -26,13 +28,36 @@ public:
     // /** Contour maximum length to consider as a eventual connection after morphological opening. */
     // static constexpr double cContourMaxLength{100};
 
+    /**
+     * @brief Parameters of the detection, set by the preset.
+     */
+    struct Parameters {
+        /** Size of the kernel for morphological closing. */
+        unsigned int mMorphCloseKernelSize;
+        /** Iterations for morphological closing. */
+        unsigned int mMorphCloseIter;
+        /** Connection minimum length. */
+        double mConnectionMinLength;
+    };
+
+    /**
+     * @brief Gets the parameters of a preset.
+     *
+     * @param preset Preset.
+     *
+     * @return Parameters of the preset.
+     */
+    [[nodiscard]] static Parameters getParameters(const common::Preset& preset);
+
     /**
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit ConnectionDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                 const std::shared_ptr<output::ImageWriter>& imageWriter,
                                  const std::shared_ptr<logging::Logger>& logger);
 
     /**
@@ -76,7 +101,8 @@ public:
      * @param components Components detected.
      * @param saveImages Save images obtained during the processing.
      *
-     * @return True if there are nodes and/or connections detected, otherwise false.
+     * @return True if there are nodes and/or connections detected, otherwise false (also when the job is stopped, see
+     * common::CancellationToken).
      */
     virtual bool detectNodesUpdateConnections(computerVision::ImageMat& imageInitial,
                                               computerVision::ImageMat& imagePreprocessed,
@@ -90,6 +116,14 @@ public:
      */
     [[nodiscard]] virtual const std::vector<circuit::Connection>& getDetectedConnections() const;
 
+    /**
+     * @brief Sets the detected connections (e.g. the connections stitched from the tiles of an image), to detect their
+     * nodes.
+     *
+     * @param connections Detected connections.
+     */
+    virtual void setDetectedConnections(const std::vector<circuit::Connection>& connections);
+
     /**
      * @brief Gets the detected nodes.
      *
@@ -97,21 +131,31 @@ public:
      */
     [[nodiscard]] virtual const std::vector<circuit::Node>& getDetectedNodes() const;
 
-#ifdef BUILD_TESTS
-public:
     /**
-     * @brief Sets the detected connections.
+     * @brief Sets the preset, which sets the parameters of the detection.
      *
-     * @param connections Detected connections.
+     * @param preset Preset.
      */
-    void setDetectedConnections(const std::vector<circuit::Connection>& connections);
-#endif
+    virtual void setPreset(const common::Preset& preset);
+
+    /**
+     * @brief Gets the preset.
+     *
+     * @return The preset.
+     */
+    [[nodiscard]] virtual common::Preset getPreset() const;
+
+    /**
+     * @brief Sets the parameters of the detection, which replace the parameters of the preset until the preset is set
+     * again (e.g. for a parameter sweep).
+     *
+     * @param parameters Parameters.
+     */
+    virtual void setParameters(const Parameters& parameters);
 
 private:
-    /** Size of the kernel for morphological closing. */
-    const unsigned int cMorphCloseKernelSize{11};
-    /** Iterations for morphological closing. */
-    const unsigned int cMorphCloseIter{4};
+    /** Default size of the kernel for morphological closing. */
+    static constexpr unsigned int cMorphCloseKernelSize{11};
 
     /** Size of the kernel for morphological opening. */
     const unsigned int cMorphOpenKernelSize{3};
@@ -138,6 +182,9 @@ private:
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
 
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
 
@@ -145,6 +192,12 @@ private:
     std::vector<circuit::Connection> mConnections;
     /** Nodes detected. */
     std::vector<circuit::Node> mNodes;
+
+    /** Preset. */
+    common::Preset mPreset{common::Preset::BALANCED};
+
+    /** Parameters of the preset. */
+    Parameters mParameters{getParameters(common::Preset::BALANCED)};
 };
 
 } // namespace schematicSegmentation
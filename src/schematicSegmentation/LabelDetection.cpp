@@ -10,8 +10,10 @@ namespace circuitSegmentation {
 namespace schematicSegmentation {
 
 LabelDetection::LabelDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                               const std::shared_ptr<output::ImageWriter>& imageWriter,
                                const std::shared_ptr<logging::Logger>& logger)
     : mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
     , mLogger{logger}
     , mLabels{}
 {
@@ -47,7 +49,8 @@ bool LabelDetection::detectLabels(computerVision::ImageMat& imageInitial,
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_labels_remove_elements.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_segment_labels_remove_elements.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Removing the elements from the preprocessed image", image, 0);
 #endif
@@ -55,15 +58,16 @@ bool LabelDetection::detectLabels(computerVision::ImageMat& imageInitial,
 
     // Morphological closing for dilation of labels
     auto kernelMorph{mOpenCvWrapper->getStructuringElement(computerVision::OpenCvWrapper::MorphShapes::MORPH_RECT,
-                                                           cMorphCloseKernelSize)};
+                                                           mParameters.mMorphCloseKernelSize)};
     mOpenCvWrapper->morphologyEx(
-        image, image, computerVision::OpenCvWrapper::MorphTypes::MORPH_CLOSE, kernelMorph, cMorphCloseIter);
+        image, image, computerVision::OpenCvWrapper::MorphTypes::MORPH_CLOSE, kernelMorph, mParameters.mMorphCloseIter);
 
     mLogger->logInfo("Morphological closing applied to the image");
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_labels_morph_close.png", image);
+        // The image is processed further in place, so a copy is written
+        mImageWriter->writeImage("cs_segment_labels_morph_close.png", mOpenCvWrapper->cloneImage(image));
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Morphological closing to detect labels", image, 0);
 #endif
@@ -79,7 +83,7 @@ bool LabelDetection::detectLabels(computerVision::ImageMat& imageInitial,
 
     // Save image
     if (saveImages) {
-        mOpenCvWrapper->writeImage("cs_segment_labels_morph_open.png", image);
+        mImageWriter->writeImage("cs_segment_labels_morph_open.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Morphological opening to detect labels", image, 0);
 #endif
@@ -90,8 +94,10 @@ bool LabelDetection::detectLabels(computerVision::ImageMat& imageInitial,
     computerVision::ContoursHierarchy hierarchy{};
     mOpenCvWrapper->findContours(image, contours, hierarchy, cFindContourMode, cFindContourMethod);
 
-    mLogger->logDebug("Contours found in the image, to detect labels: " + std::to_string(contours.size()));
+    mLogger->logDebug("Contours found in the image, to detect labels: {}", contours.size());
 
+    // Label for each contour (the labels of a previous image are discarded)
+    mLabels.clear();
     for (const auto& contour : contours) {
         // Check contour
         const auto box{checkContour(imagePreprocessed, contour)};
@@ -104,7 +110,7 @@ bool LabelDetection::detectLabels(computerVision::ImageMat& imageInitial,
         }
     }
 
-    mLogger->logInfo("Labels found in the circuit: " + std::to_string(mLabels.size()));
+    mLogger->logInfo("Labels found in the circuit: {}", mLabels.size());
 
     // If there are no labels detected, it makes no sense to continue
     if (mLabels.empty()) {
@@ -119,7 +125,7 @@ bool LabelDetection::detectLabels(computerVision::ImageMat& imageInitial,
                 image, label.mBoundingBox, cBoxColor, cBoxThickness, computerVision::OpenCvWrapper::LineTypes::LINE_8);
         }
 
-        mOpenCvWrapper->writeImage("cs_segment_labels_detected.png", image);
+        mImageWriter->writeImage("cs_segment_labels_detected.png", image);
 #ifdef SHOW_IMAGES
         mOpenCvWrapper->showImage("Detecting labels", image, 0);
 #endif
@@ -133,6 +139,33 @@ const std::vector<circuit::Label>& LabelDetection::getDetectedLabels() const
     return mLabels;
 }
 
+void LabelDetection::setPreset(const common::Preset& preset)
+{
+    mPreset = preset;
+    mParameters = getParameters(preset);
+}
+
+common::Preset LabelDetection::getPreset() const
+{
+    return mPreset;
+}
+
+LabelDetection::Parameters LabelDetection::getParameters(const common::Preset& preset)
+{
+    // Fewer iterations of the morphological closing, the most expensive operation of the detection
+    if (preset == common::Preset::FAST) {
+        return Parameters{
+            .mMorphCloseKernelSize = cMorphCloseKernelSize, .mMorphCloseIter = 2, .mBoxMinArea = cBoxMinArea};
+    }
+
+    return Parameters{.mMorphCloseKernelSize = cMorphCloseKernelSize, .mMorphCloseIter = 3, .mBoxMinArea = cBoxMinArea};
+}
+
+void LabelDetection::setParameters(const Parameters& parameters)
+{
+    mParameters = parameters;
+}
+
 void LabelDetection::removeElementsFromImage(computerVision::ImageMat& image,
                                              const std::vector<circuit::Component>& components,
                                              const std::vector<circuit::Connection>& connections)
@@ -164,7 +197,7 @@ std::optional<computerVision::Rectangle>
     const auto box{generateBoundingBox(mOpenCvWrapper, contour, imagePreprocessed, widthIncr, heightIncr)};
 
     // Check bounding box area
-    if (mOpenCvWrapper->rectangleArea(box) >= cBoxMinArea) {
+    if (mOpenCvWrapper->rectangleArea(box) >= mParameters.mBoxMinArea) {
         return box;
     }
 
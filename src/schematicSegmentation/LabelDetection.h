@@ -6,8 +6,10 @@
 
 #include "circuit/Component.h"
 #include "circuit/Connection.h"
+#include "common/Preset.h"
 #include "computerVision/OpenCvWrapper.h"
 #include "logging/Logger.h"
+#include "output/ImageWriter.h"
 #include <memory>
 #include <optional>
 #include <vector>
@@ -24,13 +26,36 @@ public:
     /** Minimum area for bounding boxes. */
     static constexpr int cBoxMinArea{50};
 
+    /**
+     * @brief Parameters of the detection, set by the preset.
+     */
+    struct Parameters {
+        /** Size of the kernel for morphological closing. */
+        unsigned int mMorphCloseKernelSize;
+        /** Iterations for morphological closing. */
+        unsigned int mMorphCloseIter;
+        /** Minimum area for bounding boxes. */
+        int mBoxMinArea;
+    };
+
+    /**
+     * @brief Gets the parameters of a preset.
+     *
+     * @param preset Preset.
+     *
+     * @return Parameters of the preset.
+     */
+    [[nodiscard]] static Parameters getParameters(const common::Preset& preset);
+
     /**
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit LabelDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                            const std::shared_ptr<output::ImageWriter>& imageWriter,
                             const std::shared_ptr<logging::Logger>& logger);
 
     /**
@@ -62,6 +87,28 @@ public:
      */
     [[nodiscard]] virtual const std::vector<circuit::Label>& getDetectedLabels() const;
 
+    /**
+     * @brief Sets the preset, which sets the parameters of the detection.
+     *
+     * @param preset Preset.
+     */
+    virtual void setPreset(const common::Preset& preset);
+
+    /**
+     * @brief Gets the preset.
+     *
+     * @return The preset.
+     */
+    [[nodiscard]] virtual common::Preset getPreset() const;
+
+    /**
+     * @brief Sets the parameters of the detection, which replace the parameters of the preset until the preset is set
+     * again (e.g. for a parameter sweep).
+     *
+     * @param parameters Parameters.
+     */
+    virtual void setParameters(const Parameters& parameters);
+
 #ifndef BUILD_TESTS
 private:
 #endif
@@ -100,10 +147,8 @@ private:
     /** Bounding box thickness. */
     const int cBoxThickness{2};
 
-    /** Size of the kernel for morphological closing. */
-    const unsigned int cMorphCloseKernelSize{9};
-    /** Iterations for morphological closing. */
-    const unsigned int cMorphCloseIter{3};
+    /** Default size of the kernel for morphological closing. */
+    static constexpr unsigned int cMorphCloseKernelSize{9};
 
     /** Size of the kernel for morphological opening. */
     const unsigned int cMorphOpenKernelSize{3};
@@ -113,11 +158,20 @@ private:
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
 
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
 
     /** Labels detected. */
     std::vector<circuit::Label> mLabels;
+
+    /** Preset. */
+    common::Preset mPreset{common::Preset::BALANCED};
+
+    /** Parameters of the preset. */
+    Parameters mParameters{getParameters(common::Preset::BALANCED)};
 };
 
 } // namespace schematicSegmentation
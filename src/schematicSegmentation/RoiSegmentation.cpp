@@ -3,13 +3,16 @@
  */
 
 #include "RoiSegmentation.h"
+#include <utility>
 
 namespace circuitSegmentation {
 namespace schematicSegmentation {
 
 RoiSegmentation::RoiSegmentation(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                 const std::shared_ptr<output::ImageWriter>& imageWriter,
                                  const std::shared_ptr<logging::Logger>& logger)
     : mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
     , mLogger{logger}
 {
 }
@@ -22,17 +25,28 @@ bool RoiSegmentation::generateRoiComponents(computerVision::ImageMat& imageIniti
     // Success for all images
     auto success{true};
 
+    // Images being written
+    std::vector<RoiWrite> roiWrites{};
+
     for (const auto& component : components) {
-        // Get ROI
-        const auto roi{component.mBoundingBox};
+        // Image with ROI
+        RoiImage roiImage{};
+        roiImage.mKind = RoiImage::Kind::COMPONENT;
+        roiImage.mElementId = component.mId;
+        roiImage.mRoi = component.mBoundingBox;
+        roiImage.mFileName = "roi_component_" + component.mId + ".png";
 
         // Generate image
-        const std::string filePath{"roi_component_" + component.mId + ".png"};
-        if (!generateRoi(imageInitial, roi, component.mId, filePath)) {
+        if (!generateRoi(imageInitial, std::move(roiImage), roiWrites)) {
             success = false;
         }
     }
 
+    // Wait for the images to be written
+    if (!waitRoiWrites(roiWrites)) {
+        success = false;
+    }
+
     return success;
 }
 
@@ -46,20 +60,27 @@ bool RoiSegmentation::generateRoiLabels(computerVision::ImageMat& imageInitial,
     // Success for all images
     auto success{true};
 
+    // Images being written
+    std::vector<RoiWrite> roiWrites{};
+
     // Labels associated to components
     for (const auto& component : components) {
         // Get labels
-        const auto labels{component.mLabels};
+        const auto& labels{component.mLabels};
 
         for (auto it{labels.begin()}; it != labels.end(); ++it) {
             const auto index{it - labels.begin()};
 
-            // Get ROI
-            const auto roi{labels.at(index).mBoundingBox};
+            // Image with ROI
+            RoiImage roiImage{};
+            roiImage.mKind = RoiImage::Kind::LABEL;
+            roiImage.mElementId = component.mId;
+            roiImage.mIndex = static_cast<unsigned int>(index + 1);
+            roiImage.mRoi = labels.at(index).mBoundingBox;
+            roiImage.mFileName = "roi_label_" + component.mId + "_" + std::to_string(index + 1) + ".png";
 
             // Generate image
-            const std::string filePath{"roi_label_" + component.mId + "_" + std::to_string(index + 1) + ".png"};
-            if (!generateRoi(imageInitial, roi, component.mId, filePath)) {
+            if (!generateRoi(imageInitial, std::move(roiImage), roiWrites)) {
                 success = false;
             }
         }
@@ -68,17 +89,21 @@ bool RoiSegmentation::generateRoiLabels(computerVision::ImageMat& imageInitial,
     // Labels associated to connections
     for (const auto& connection : connections) {
         // Get labels
-        const auto labels{connection.mLabels};
+        const auto& labels{connection.mLabels};
 
         for (auto it{labels.begin()}; it != labels.end(); ++it) {
             const auto index{it - labels.begin()};
 
-            // Get ROI
-            const auto roi{labels.at(index).mBoundingBox};
+            // Image with ROI
+            RoiImage roiImage{};
+            roiImage.mKind = RoiImage::Kind::LABEL;
+            roiImage.mElementId = connection.mId;
+            roiImage.mIndex = static_cast<unsigned int>(index + 1);
+            roiImage.mRoi = labels.at(index).mBoundingBox;
+            roiImage.mFileName = "roi_label_" + connection.mId + "_" + std::to_string(index + 1) + ".png";
 
             // Generate image
-            const std::string filePath{"roi_label_" + connection.mId + "_" + std::to_string(index + 1) + ".png"};
-            if (!generateRoi(imageInitial, roi, connection.mId, filePath)) {
+            if (!generateRoi(imageInitial, std::move(roiImage), roiWrites)) {
                 success = false;
             }
         }
@@ -87,45 +112,147 @@ bool RoiSegmentation::generateRoiLabels(computerVision::ImageMat& imageInitial,
     // Labels associated to nodes
     for (const auto& node : nodes) {
         // Get labels
-        const auto labels{node.mLabels};
+        const auto& labels{node.mLabels};
 
         for (auto it{labels.begin()}; it != labels.end(); ++it) {
             const auto index{it - labels.begin()};
 
-            // Get ROI
-            const auto roi{labels.at(index).mBoundingBox};
+            // Image with ROI
+            RoiImage roiImage{};
+            roiImage.mKind = RoiImage::Kind::LABEL;
+            roiImage.mElementId = node.mId;
+            roiImage.mIndex = static_cast<unsigned int>(index + 1);
+            roiImage.mRoi = labels.at(index).mBoundingBox;
+            roiImage.mFileName = "roi_label_" + node.mId + "_" + std::to_string(index + 1) + ".png";
 
             // Generate image
-            const std::string filePath{"roi_label_" + node.mId + "_" + std::to_string(index + 1) + ".png"};
-            if (!generateRoi(imageInitial, roi, node.mId, filePath)) {
+            if (!generateRoi(imageInitial, std::move(roiImage), roiWrites)) {
                 success = false;
             }
         }
     }
 
+    // Wait for the images to be written
+    if (!waitRoiWrites(roiWrites)) {
+        success = false;
+    }
+
+    return success;
+}
+
+const std::vector<RoiImage>& RoiSegmentation::getRoiImages() const
+{
+    return mRoiImages;
+}
+
+bool RoiSegmentation::generateRoiImages(computerVision::ImageMat& imageInitial, std::vector<RoiImage> roiImages)
+{
+    mLogger->logInfo("Generating images with ROI given");
+
+    // Success for all images
+    auto success{true};
+
+    // Images being written
+    std::vector<RoiWrite> roiWrites{};
+
+    mRoiImages.clear();
+    for (auto& roiImage : roiImages) {
+        std::vector<unsigned char>{}.swap(roiImage.mEncodedImage);
+
+        // Generate image
+        if (!generateRoi(imageInitial, std::move(roiImage), roiWrites)) {
+            success = false;
+        }
+    }
+
+    // Wait for the images to be written
+    if (!waitRoiWrites(roiWrites)) {
+        success = false;
+    }
+
     return success;
 }
 
+void RoiSegmentation::setRoiImages(std::vector<RoiImage> roiImages)
+{
+    mRoiImages = std::move(roiImages);
+}
+
+void RoiSegmentation::clearRoiImages()
+{
+    mRoiImages.clear();
+}
+
+void RoiSegmentation::setWriteImages(const bool& writeImages)
+{
+    mWriteImages = writeImages;
+}
+
+bool RoiSegmentation::getWriteImages() const
+{
+    return mWriteImages;
+}
+
+void RoiSegmentation::setEncodeImages(const bool& encodeImages)
+{
+    mEncodeImages = encodeImages;
+}
+
+bool RoiSegmentation::getEncodeImages() const
+{
+    return mEncodeImages;
+}
+
 bool RoiSegmentation::generateRoi(computerVision::ImageMat& imageInitial,
-                                  const computerVision::Rectangle& roi,
-                                  const std::string& elementId,
-                                  const std::string& filePath)
+                                  RoiImage roiImage,
+                                  std::vector<RoiWrite>& roiWrites)
 {
-    // Crop image
+    // Crop image (the ROI references the data of the initial image, so it is encoded without copying the pixels)
     computerVision::ImageMat image{};
-    if (!mOpenCvWrapper->cropImage(imageInitial, image, roi)) {
-        mLogger->logError("Failed to crop image with ROI for element " + elementId);
+    if (!mOpenCvWrapper->cropImageView(imageInitial, image, roiImage.mRoi)) {
+        mLogger->logError("Failed to crop image with ROI for element {}", roiImage.mElementId);
         return false;
     }
 
-    // Save image
-    if (!mOpenCvWrapper->writeImage(filePath, image)) {
-        mLogger->logError("Failed to write image with ROI for element " + elementId);
-        return false;
+    // Save and/or encode image (the initial image is not modified until all images with ROI are written)
+    RoiWrite roiWrite{mRoiImages.size(), {}, {}};
+    if (mWriteImages) {
+        roiWrite.mWritten = mImageWriter->writeImage(roiImage.mFileName, image);
+    }
+    if (mEncodeImages) {
+        roiWrite.mEncoded = mImageWriter->encodeImage(std::move(image));
     }
 
+    mRoiImages.push_back(std::move(roiImage));
+    roiWrites.push_back(std::move(roiWrite));
+
     return true;
 }
 
+bool RoiSegmentation::waitRoiWrites(std::vector<RoiWrite>& roiWrites)
+{
+    // Success for all images
+    auto success{true};
+
+    for (auto& roiWrite : roiWrites) {
+        auto& roiImage{mRoiImages.at(roiWrite.mRoiImageIndex)};
+
+        if (roiWrite.mWritten.valid() && !roiWrite.mWritten.get()) {
+            mLogger->logError("Failed to write image with ROI for element {}", roiImage.mElementId);
+            success = false;
+        }
+
+        if (roiWrite.mEncoded.valid()) {
+            roiImage.mEncodedImage = roiWrite.mEncoded.get();
+            if (roiImage.mEncodedImage.empty()) {
+                mLogger->logError("Failed to encode image with ROI for element {}", roiImage.mElementId);
+                success = false;
+            }
+        }
+    }
+
+    return success;
+}
+
 } // namespace schematicSegmentation
 } // namespace circuitSegmentation
@@ -9,12 +9,45 @@
 #include "circuit/Node.h"
 #include "computerVision/OpenCvWrapper.h"
 #include "logging/Logger.h"
+#include "output/ImageWriter.h"
+#include <cstddef>
+#include <future>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace circuitSegmentation {
 namespace schematicSegmentation {
 
+/**
+ * @brief Image with ROI (region of interest) of a circuit element.
+ */
+struct RoiImage
+{
+    /**
+     * @brief Enumeration of the kinds of ROI.
+     */
+    enum class Kind : unsigned char {
+        /** Component. */
+        COMPONENT = 0,
+        /** Label associated to a circuit element. */
+        LABEL = 1
+    };
+
+    /** Kind of ROI. */
+    Kind mKind{Kind::COMPONENT};
+    /** ID of the circuit element (the component, or the element associated to the label). */
+    std::string mElementId{};
+    /** Label number in the associated element, starting at 1 (0 for components). */
+    unsigned int mIndex{0};
+    /** ROI in the initial image. */
+    computerVision::Rectangle mRoi{};
+    /** File name of the image, relative to the output directory of the image writer. */
+    std::string mFileName{};
+    /** Encoded image (empty if the images are not encoded to memory). */
+    std::vector<unsigned char> mEncodedImage{};
+};
+
 /**
  * @brief Class responsible for generation of images with ROI (regions of interest) from image segmentation.
  */
@@ -25,9 +58,11 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit RoiSegmentation(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                             const std::shared_ptr<output::ImageWriter>& imageWriter,
                              const std::shared_ptr<logging::Logger>& logger);
 
     /**
@@ -41,8 +76,8 @@ public:
      * @param imageInitial Initial image without preprocessing.
      * @param components Components.
      *
-     * @note The image files are written to the working directory and have the following format for naming:
-     * "roi_component_<component_id>.png".
+     * @note The image files are written to the output directory of the image writer, if enabled, and have the
+     * following format for naming: "roi_component_<component_id>.png".
      *
      * @return True if all images generation occurred successfully, otherwise false.
      */
@@ -57,8 +92,8 @@ public:
      * @param connections Connections.
      * @param nodes Nodes.
      *
-     * @note The image files are written to the working directory and have the following format for naming:
-     * "roi_label_<associated_element_id>_<n>.png". Meaning of fields:
+     * @note The image files are written to the output directory of the image writer, if enabled, and have the
+     * following format for naming: "roi_label_<associated_element_id>_<n>.png". Meaning of fields:
      * - associated_element_id: ID of the associated element to this label. Note that this is not the ID of the label.
      * - n: label number. As the element can have more than one label associated, this just specifies a number for the
      * label.
@@ -70,28 +105,121 @@ public:
                                    const std::vector<circuit::Connection>& connections,
                                    const std::vector<circuit::Node>& nodes);
 
+    /**
+     * @brief Generates images with ROI given, replacing the images with ROI generated (e.g. for the ROI of a result of
+     * another image, transformed to this image).
+     *
+     * @param imageInitial Initial image without preprocessing.
+     * @param roiImages Images with ROI, whose ROI are in the initial image (their encoded images are replaced).
+     *
+     * @return True if all images generation occurred successfully, otherwise false.
+     */
+    virtual bool generateRoiImages(computerVision::ImageMat& imageInitial, std::vector<RoiImage> roiImages);
+
+    /**
+     * @brief Gets the images with ROI generated since the last clear.
+     *
+     * @return Images with ROI.
+     */
+    [[nodiscard]] virtual const std::vector<RoiImage>& getRoiImages() const;
+
+    /**
+     * @brief Sets the images with ROI generated before (e.g. by a processing of the same image).
+     *
+     * @param roiImages Images with ROI.
+     */
+    virtual void setRoiImages(std::vector<RoiImage> roiImages);
+
+    /**
+     * @brief Clears the images with ROI generated, before a new processing.
+     */
+    virtual void clearRoiImages();
+
+    /**
+     * @brief Sets the flag to write the images with ROI to files.
+     *
+     * @param writeImages Write the images with ROI to files.
+     */
+    virtual void setWriteImages(const bool& writeImages);
+
+    /**
+     * @brief Gets the flag to write the images with ROI to files.
+     *
+     * @return The flag to write the images with ROI to files.
+     */
+    [[nodiscard]] virtual bool getWriteImages() const;
+
+    /**
+     * @brief Sets the flag to encode the images with ROI to memory, kept in @ref getRoiImages.
+     *
+     * @param encodeImages Encode the images with ROI to memory.
+     */
+    virtual void setEncodeImages(const bool& encodeImages);
+
+    /**
+     * @brief Gets the flag to encode the images with ROI to memory.
+     *
+     * @return The flag to encode the images with ROI to memory.
+     */
+    [[nodiscard]] virtual bool getEncodeImages() const;
+
 private:
+    /**
+     * @brief Image with ROI being written.
+     */
+    struct RoiWrite
+    {
+        /** Index of the image in the images with ROI. */
+        std::size_t mRoiImageIndex;
+        /** Result of the writing of the image (not valid if the image is not written). */
+        std::shared_future<bool> mWritten;
+        /** Encoded image (not valid if the image is not encoded). */
+        std::shared_future<std::vector<unsigned char>> mEncoded;
+    };
+
     /**
      * @brief Generates image with ROI.
      *
+     * The image is cropped without copying the data and handed to the image writer, so it is encoded directly from the
+     * initial image, asynchronously and in parallel with the other images with ROI.
+     *
      * @param imageInitial Initial image without preprocessing.
-     * @param roi ROI.
-     * @param elementId Circuit element ID.
-     * @param filePath File path to save image.
+     * @param roiImage Image with ROI, without the encoded image. It is added to the images with ROI.
+     * @param roiWrites Images being written, where the image generated is added.
      *
      * @return True if image generation occurred successfully, otherwise false.
      */
     virtual bool generateRoi(computerVision::ImageMat& imageInitial,
-                             const computerVision::Rectangle& roi,
-                             const std::string& elementId,
-                             const std::string& filePath);
+                             RoiImage roiImage,
+                             std::vector<RoiWrite>& roiWrites);
+
+    /**
+     * @brief Waits for the images with ROI to be written.
+     *
+     * @param roiWrites Images being written.
+     *
+     * @return True if all images were written successfully, otherwise false.
+     */
+    virtual bool waitRoiWrites(std::vector<RoiWrite>& roiWrites);
 
 private:
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
 
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
+
+    /** Write the images with ROI to files. */
+    bool mWriteImages{true};
+
+    /** Encode the images with ROI to memory. */
+    bool mEncodeImages{false};
+
+    /** Images with ROI generated since the last clear. */
+    std::vector<RoiImage> mRoiImages{};
 };
 
 } // namespace schematicSegmentation
@@ -4,14 +4,23 @@
 
 #include "SchematicSegmentation.h"
 #include "application/Config.h"
+#include "common/CancellationToken.h"
+#include "common/UuidGen.h"
 #include "SegmentationUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <utility>
 
 namespace circuitSegmentation {
 namespace schematicSegmentation {
 
 SchematicSegmentation::SchematicSegmentation(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                             const std::shared_ptr<output::ImageWriter>& imageWriter,
                                              const std::shared_ptr<logging::Logger>& logger)
     : mOpenCvWrapper{openCvWrapper}
+    , mImageWriter{imageWriter}
     , mLogger{logger}
     , mComponents{}
     , mConnections{}
@@ -57,7 +66,7 @@ void SchematicSegmentation::detectComponentConnections(computerVision::ImageMat&
 
         std::vector<circuit::Connection> componentConnections{};
 
-        mLogger->logDebug("Checking component with ID " + component.mId);
+        mLogger->logDebug("Checking component with ID {}", component.mId);
 
         for (auto& connection : mConnections) {
             auto intersect{false};
@@ -67,8 +76,7 @@ void SchematicSegmentation::detectComponentConnections(computerVision::ImageMat&
                 // Intersection
                 intersect = mOpenCvWrapper->contains(box, point);
                 if (intersect) {
-                    mLogger->logDebug("Component connected to a connection wire at point {" + std::to_string(point.x)
-                                      + ", " + std::to_string(point.y) + "}");
+                    mLogger->logDebug("Component connected to a connection wire at point {{{}, {}}}", point.x, point.y);
 
                     intersectionPoint.x = point.x;
                     intersectionPoint.y = point.y;
@@ -89,8 +97,7 @@ void SchematicSegmentation::detectComponentConnections(computerVision::ImageMat&
 
                 // Set port position
                 port.mPosition = calcPortPosition(intersectionPoint, component.mBoundingBox, widthIncr, heightIncr);
-                mLogger->logDebug("Port position at {" + std::to_string(port.mPosition.mX) + ", "
-                                  + std::to_string(port.mPosition.mY) + "}");
+                mLogger->logDebug("Port position at {{{}, {}}}", port.mPosition.mX, port.mPosition.mY);
 
                 // Add component port
                 component.mPorts.push_back(port);
@@ -123,7 +130,7 @@ void SchematicSegmentation::detectComponentConnections(computerVision::ImageMat&
             mOpenCvWrapper->drawContours(
                 image, portPoints, -1, cPortColor, cPortThickness, computerVision::OpenCvWrapper::LineTypes::LINE_8, {});
 
-            mOpenCvWrapper->writeImage("cs_segment_components_ports_detected.png", image);
+            mImageWriter->writeImage("cs_segment_components_ports_detected.png", image);
 #ifdef SHOW_IMAGES
             mOpenCvWrapper->showImage("Detecting components ports", image, 0);
 #endif
@@ -151,7 +158,7 @@ bool SchematicSegmentation::updateDetectedComponents()
     mComponents.erase(std::remove_if(mComponents.begin(), mComponents.end(), isComponentWithoutPorts),
                       mComponents.end());
 
-    mLogger->logInfo("Detected components in the image: " + std::to_string(mComponents.size()));
+    mLogger->logInfo("Detected components in the image: {}", mComponents.size());
 
     for (auto& component : mComponents) {
         // Set component position
@@ -164,6 +171,16 @@ bool SchematicSegmentation::updateDetectedComponents()
     return !mComponents.empty();
 }
 
+void SchematicSegmentation::setElements(std::vector<circuit::Component> components,
+                                        std::vector<circuit::Connection> connections,
+                                        std::vector<circuit::Node> nodes)
+{
+    mComponents = std::move(components);
+    mConnections = std::move(connections);
+    mNodes = std::move(nodes);
+    mLabels.clear();
+}
+
 void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageInitial,
                                             computerVision::ImageMat& imagePreprocessed,
                                             const std::vector<circuit::Label>& labelsDetected,
@@ -223,7 +240,7 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
                     image, box, cBoxColor, cBoxThickness, computerVision::OpenCvWrapper::LineTypes::LINE_8);
             }
 
-            mOpenCvWrapper->writeImage("cs_segment_labels_associate_boxes_connections_nodes.png", image);
+            mImageWriter->writeImage("cs_segment_labels_associate_boxes_connections_nodes.png", image);
 #ifdef SHOW_IMAGES
             mOpenCvWrapper->showImage("Associating labels (boxes for connections and nodes)", image, 0);
 #endif
@@ -231,6 +248,12 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
     }
 
     for (auto& label : mLabels) {
+        // Stop if the job was cancelled or its deadline expired (the labels not associated yet have no owner)
+        if (common::CancellationToken::isCurrentStopped()) {
+            mLogger->logWarning("Association of labels stopped");
+            break;
+        }
+
         // Distance between label and components
         double minDistanceToComponent{0};
         auto componentIndex{0};
@@ -248,8 +271,10 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
             }
         }
 
-        mLogger->logDebug("Minimum distance between label " + label.mId + " and component "
-                          + mComponents.at(componentIndex).mId + " = " + std::to_string(minDistanceToComponent));
+        mLogger->logDebug("Minimum distance between label {} and component {} = {}",
+                          label.mId,
+                          mComponents.at(componentIndex).mId,
+                          minDistanceToComponent);
 
         // Distance between label and connections
         double minDistanceToConnection{0};
@@ -269,8 +294,10 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
             }
         }
 
-        mLogger->logDebug("Minimum distance between label " + label.mId + " and connection "
-                          + mConnections.at(connectionIndex).mId + " = " + std::to_string(minDistanceToConnection));
+        mLogger->logDebug("Minimum distance between label {} and connection {} = {}",
+                          label.mId,
+                          mConnections.at(connectionIndex).mId,
+                          minDistanceToConnection);
 
         // Distance between label and nodes
         double minDistanceToNode{0};
@@ -291,8 +318,10 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
 
         // The circuit can have no nodes, so we need to check if nodes are empty
         if (!mNodes.empty()) {
-            mLogger->logDebug("Minimum distance between label " + label.mId + " and node " + mNodes.at(nodeIndex).mId
-                              + " = " + std::to_string(minDistanceToNode));
+            mLogger->logDebug("Minimum distance between label {} and node {} = {}",
+                              label.mId,
+                              mNodes.at(nodeIndex).mId,
+                              minDistanceToNode);
         }
 
         // Compare the minimum distances
@@ -324,8 +353,7 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
             mComponents.at(elemIndex).mLabels.push_back(label);
             // Set label of the element
             mComponents.at(elemIndex).mLabel = label;
-            mLogger->logDebug("Label " + label.mId + " is associated to the component "
-                              + mComponents.at(elemIndex).mId);
+            mLogger->logDebug("Label {} is associated to the component {}", label.mId, mComponents.at(elemIndex).mId);
             break;
         case ElemTypeEnum::CONNECTION:
             // Set label owner ID
@@ -334,8 +362,7 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
             mConnections.at(elemIndex).mLabels.push_back(label);
             // Set label of the element
             mConnections.at(elemIndex).mLabel = label;
-            mLogger->logDebug("Label " + label.mId + " is associated to the connection "
-                              + mConnections.at(elemIndex).mId);
+            mLogger->logDebug("Label {} is associated to the connection {}", label.mId, mConnections.at(elemIndex).mId);
             break;
         case ElemTypeEnum::NODE:
             // Set label owner ID
@@ -344,7 +371,7 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
             mNodes.at(elemIndex).mLabels.push_back(label);
             // Set label of the element
             mNodes.at(elemIndex).mLabel = label;
-            mLogger->logDebug("Label " + label.mId + " is associated to the node " + mNodes.at(elemIndex).mId);
+            mLogger->logDebug("Label {} is associated to the node {}", label.mId, mNodes.at(elemIndex).mId);
             break;
         default:
             // Set label owner ID
@@ -353,13 +380,147 @@ void SchematicSegmentation::associateLabels(computerVision::ImageMat& imageIniti
             mComponents.at(elemIndex).mLabels.push_back(label);
             // Set label of the element
             mComponents.at(elemIndex).mLabel = label;
-            mLogger->logDebug("Label " + label.mId + " is associated to the component "
-                              + mComponents.at(elemIndex).mId);
+            mLogger->logDebug("Label {} is associated to the component {}", label.mId, mComponents.at(elemIndex).mId);
             break;
         }
     }
 }
 
+void SchematicSegmentation::assignDeterministicIds(const int imageWidth, const int imageHeight)
+{
+    /*
+     * Assignment of deterministic IDs
+     * - Namespace of the IDs derived from the dimensions of the image
+     * - Name of each element with its role and its geometry snapped to a grid:
+     *      - Component: type and bounding box
+     *      - Port: ID of the component and relative position
+     *      - Connection: bounding box of the wire
+     *      - Node: position
+     *      - Label: bounding box, or ID of the owner if the element has no label associated
+     * - Elements with the same name get the number of the occurrence appended to the name, in order
+     * - ID of each element derived from its name
+     * - Replace the references to the previous IDs
+     */
+
+    mLogger->logInfo("Assigning deterministic IDs to the circuit elements");
+
+    const common::UuidGen uuidGen{};
+    const auto namespaceId{uuidGen.generateNameUuid(
+        common::UuidGen::cAppNamespace, "image:" + std::to_string(imageWidth) + "x" + std::to_string(imageHeight))};
+
+    // Previous IDs mapped to the new IDs
+    std::map<circuit::Id, circuit::Id> ids{};
+    std::map<std::string, unsigned int> nameOccurrences{};
+
+    // Assigns the ID of a name, unique among the names already assigned
+    const auto assignId = [&](const circuit::Id& previousId, const std::string& name) {
+        const auto occurrence{nameOccurrences[name]++};
+        const auto uniqueName{occurrence == 0 ? name : name + "#" + std::to_string(occurrence)};
+        const auto id{circuit::generateNameId(namespaceId, uniqueName)};
+        ids[previousId] = id;
+        return id;
+    };
+
+    // Gets the new ID of a previous ID (the same ID if it was not assigned, e.g. empty)
+    const auto mapId = [&ids](const circuit::Id& previousId) {
+        const auto it{ids.find(previousId)};
+        return it != ids.end() ? it->second : previousId;
+    };
+
+    // Snaps a coordinate to the grid
+    const auto snap = [](const int coordinate) {
+        return std::to_string(static_cast<int>(std::lround(static_cast<double>(coordinate) / cIdGridSize)));
+    };
+    const auto snapRectangle = [&snap](const computerVision::Rectangle& box) {
+        return snap(box.x) + "," + snap(box.y) + "," + snap(box.width) + "," + snap(box.height);
+    };
+
+    // Bounding box of a wire, without the OpenCV wrapper
+    const auto wireBox = [](const circuit::Wire& wire) {
+        if (wire.empty()) {
+            return computerVision::Rectangle{};
+        }
+        auto xMin{wire.front().x};
+        auto xMax{wire.front().x};
+        auto yMin{wire.front().y};
+        auto yMax{wire.front().y};
+        for (const auto& point : wire) {
+            xMin = std::min(xMin, point.x);
+            xMax = std::max(xMax, point.x);
+            yMin = std::min(yMin, point.y);
+            yMax = std::max(yMax, point.y);
+        }
+        return computerVision::Rectangle{xMin, yMin, xMax - xMin + 1, yMax - yMin + 1};
+    };
+
+    // Assign IDs of the elements
+    for (auto& component : mComponents) {
+        const auto componentId{
+            assignId(component.mId, "component:" + component.mType + ":" + snapRectangle(component.mBoundingBox))};
+        for (const auto& port : component.mPorts) {
+            // Relative position with the precision of the segmentation map
+            assignId(port.mId,
+                     "port:" + componentId + ":" + std::to_string(std::lround(port.mPosition.mX * 10)) + ","
+                         + std::to_string(std::lround(port.mPosition.mY * 10)));
+        }
+    }
+    for (const auto& connection : mConnections) {
+        assignId(connection.mId, "connection:" + snapRectangle(wireBox(connection.mWire)));
+    }
+    for (const auto& node : mNodes) {
+        assignId(node.mId, "node:" + snap(node.mPosition.mX) + "," + snap(node.mPosition.mY));
+    }
+    for (const auto& label : mLabels) {
+        assignId(label.mId, "label:" + snapRectangle(label.mBoundingBox));
+    }
+
+    // Replaces the IDs of a label (the label of an element without labels associated is named by its owner)
+    const auto replaceLabelIds = [&](circuit::Label& label) {
+        label.mOwnerId = mapId(label.mOwnerId);
+        if (ids.contains(label.mId)) {
+            label.mId = ids.at(label.mId);
+        } else {
+            label.mId = assignId(label.mId, "label:owner:" + label.mOwnerId);
+        }
+    };
+
+    // Replace the IDs and the references
+    for (auto& component : mComponents) {
+        component.mId = mapId(component.mId);
+        replaceLabelIds(component.mLabel);
+        for (auto& label : component.mLabels) {
+            replaceLabelIds(label);
+        }
+        for (auto& port : component.mPorts) {
+            port.mId = mapId(port.mId);
+            port.mOwnerId = mapId(port.mOwnerId);
+            port.mConnectionId = mapId(port.mConnectionId);
+        }
+    }
+    for (auto& connection : mConnections) {
+        connection.mId = mapId(connection.mId);
+        connection.mStartId = mapId(connection.mStartId);
+        connection.mEndId = mapId(connection.mEndId);
+        replaceLabelIds(connection.mLabel);
+        for (auto& label : connection.mLabels) {
+            replaceLabelIds(label);
+        }
+    }
+    for (auto& node : mNodes) {
+        node.mId = mapId(node.mId);
+        for (auto& connectionId : node.mConnectionIds) {
+            connectionId = mapId(connectionId);
+        }
+        replaceLabelIds(node.mLabel);
+        for (auto& label : node.mLabels) {
+            replaceLabelIds(label);
+        }
+    }
+    for (auto& label : mLabels) {
+        replaceLabelIds(label);
+    }
+}
+
 const std::vector<circuit::Component>& SchematicSegmentation::getComponents() const
 {
     return mComponents;
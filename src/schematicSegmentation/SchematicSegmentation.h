@@ -10,6 +10,7 @@
 #include "circuit/Position.h"
 #include "computerVision/OpenCvWrapper.h"
 #include "logging/Logger.h"
+#include "output/ImageWriter.h"
 #include <memory>
 #include <vector>
 
@@ -28,9 +29,11 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit SchematicSegmentation(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                   const std::shared_ptr<output::ImageWriter>& imageWriter,
                                    const std::shared_ptr<logging::Logger>& logger);
 
     /**
@@ -65,9 +68,24 @@ public:
      */
     virtual bool updateDetectedComponents();
 
+    /**
+     * @brief Sets the elements of the circuit segmented before the association of labels (e.g. from a checkpoint),
+     * as after @ref updateDetectedComponents.
+     *
+     * @param components Components segmented.
+     * @param connections Connections segmented.
+     * @param nodes Nodes segmented.
+     */
+    virtual void setElements(std::vector<circuit::Component> components,
+                             std::vector<circuit::Connection> connections,
+                             std::vector<circuit::Node> nodes);
+
     /**
      * @brief Associates labels to the elements of the circuit.
      *
+     * The association stops early when the job is stopped (see common::CancellationToken), so the remaining labels
+     * have no owner.
+     *
      * @param imageInitial Initial image without preprocessing.
      * @param imagePreprocessed Image preprocessed for segmentation.
      * @param labelsDetected Labels detected.
@@ -78,6 +96,19 @@ public:
                                  const std::vector<circuit::Label>& labelsDetected,
                                  const bool saveImages = false);
 
+    /**
+     * @brief Assigns deterministic IDs to the elements of the circuit, instead of their random IDs.
+     *
+     * The ID of each element is derived from the dimensions of the image, its role and its geometry, snapped to a
+     * grid, so the same image always yields the same IDs and the elements not changed by a small edit of the image
+     * keep theirs. The references between the elements (owners, ports, start and end of connections, connections of
+     * nodes) are updated with the new IDs.
+     *
+     * @param imageWidth Width of the image segmented.
+     * @param imageHeight Height of the image segmented.
+     */
+    virtual void assignDeterministicIds(const int imageWidth, const int imageHeight);
+
     /**
      * @brief Gets the segmented components.
      *
@@ -125,6 +156,9 @@ private:
                                                        const int heightIncr);
 
 private:
+    /** Size of the grid the geometry of the elements is snapped to, for their deterministic IDs (pixels). */
+    static constexpr int cIdGridSize{8};
+
     /** Port contour color. */
     const computerVision::Scalar cPortColor{0, 0, 255};
     /** Port contour thickness. */
@@ -138,6 +172,9 @@ private:
     /** OpenCV wrapper. */
     std::shared_ptr<computerVision::OpenCvWrapper> mOpenCvWrapper;
 
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
 
@@ -5,6 +5,7 @@
 #include "SegmentationMap.h"
 #include "SegmentationUtils.h"
 #include <cmath>
+#include <filesystem>
 #include <fstream>
 
 namespace circuitSegmentation {
@@ -41,7 +42,8 @@ bool SegmentationMap::writeSegmentationMapJsonFile()
     mLogger->logInfo("Writing segmentation map JSON file");
 
     // Create and open file
-    std::ofstream file(cSegmentationMapFile, std::ios_base::out);
+    const auto filePath{std::filesystem::path{mOutputDirectory} / cSegmentationMapFile};
+    std::ofstream file(filePath, std::ios_base::out);
     if (!file) {
         mLogger->logError("Failed to create and open JSON file");
         return false;
@@ -62,6 +64,11 @@ const nlohmann::ordered_json& SegmentationMap::getSegmentationMap() const
     return mJsonMap;
 }
 
+void SegmentationMap::setSegmentationMap(const nlohmann::ordered_json& segmentationMap)
+{
+    mJsonMap = segmentationMap;
+}
+
 bool SegmentationMap::addComponentsMap(const std::vector<circuit::Component>& components)
 {
     mJsonMap["components"] = nlohmann::ordered_json::array();
@@ -117,7 +124,7 @@ bool SegmentationMap::addComponentsMap(const std::vector<circuit::Component>& co
             mJsonMap["components"].push_back(jsonComponent);
         }
         catch (const std::exception& ex) {
-            mLogger->logError("An exception occurred while generating segmentation map: " + std::string(ex.what()));
+            mLogger->logError("An exception occurred while generating segmentation map: {}", ex.what());
             success = false;
             break;
         }
@@ -159,7 +166,7 @@ bool SegmentationMap::addConnectionsMap(const std::vector<circuit::Connection>&
             mJsonMap["connections"].push_back(jsonConnection);
         }
         catch (const std::exception& ex) {
-            mLogger->logError("An exception occurred while generating segmentation map: " + std::string(ex.what()));
+            mLogger->logError("An exception occurred while generating segmentation map: {}", ex.what());
             success = false;
             break;
         }
@@ -211,7 +218,7 @@ bool SegmentationMap::addNodesMap(const std::vector<circuit::Node>& nodes)
             mJsonMap["nodes"].push_back(jsonNode);
         }
         catch (const std::exception& ex) {
-            mLogger->logError("An exception occurred while generating segmentation map: " + std::string(ex.what()));
+            mLogger->logError("An exception occurred while generating segmentation map: {}", ex.what());
             success = false;
             break;
         }
@@ -220,5 +227,15 @@ bool SegmentationMap::addNodesMap(const std::vector<circuit::Node>& nodes)
     return success;
 }
 
+void SegmentationMap::setOutputDirectory(const std::string& outputDirectory)
+{
+    mOutputDirectory = outputDirectory;
+}
+
+std::string SegmentationMap::getOutputDirectory() const
+{
+    return mOutputDirectory;
+}
+
 } // namespace schematicSegmentation
 } // namespace circuitSegmentation
@@ -53,7 +53,7 @@ public:
     /**
      * @brief Writes the segmentation map to a JSON file.
      *
-     * @note The JSON file is written to the working directory and have the following name: @ref cSegmentationMapFile.
+     * @note The JSON file is written to the output directory and have the following name: @ref cSegmentationMapFile.
      *
      * @return True if segmentation map was written successfully, otherwise false.
      */
@@ -66,6 +66,27 @@ public:
      */
     [[nodiscard]] virtual const nlohmann::ordered_json& getSegmentationMap() const;
 
+    /**
+     * @brief Sets the segmentation map generated before (e.g. by a processing of the same image).
+     *
+     * @param segmentationMap Segmentation map.
+     */
+    virtual void setSegmentationMap(const nlohmann::ordered_json& segmentationMap);
+
+    /**
+     * @brief Sets the directory where the segmentation map file is written.
+     *
+     * @param outputDirectory Output directory (empty for the working directory). It must exist.
+     */
+    virtual void setOutputDirectory(const std::string& outputDirectory);
+
+    /**
+     * @brief Gets the directory where the segmentation map file is written.
+     *
+     * @return Output directory (empty for the working directory).
+     */
+    [[nodiscard]] virtual std::string getOutputDirectory() const;
+
 private:
     /**
      * @brief Adds the map for components to the segmentation map, in JSON format.
@@ -100,6 +121,9 @@ private:
 
     /** Segmentation map, in JSON. */
     nlohmann::ordered_json mJsonMap;
+
+    /** Directory where the segmentation map file is written (empty for the working directory). */
+    std::string mOutputDirectory{};
 };
 
 } // namespace schematicSegmentation
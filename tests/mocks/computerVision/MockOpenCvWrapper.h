@@ -20,24 +20,63 @@ public:
     MOCK_METHOD(void, setLogMode, (const bool&), (override));
     /** Mocks method getLogMode. */
     MOCK_METHOD(bool, getLogMode, (), (const, override));
+    /** Mocks method setNumThreads. */
+    MOCK_METHOD(void, setNumThreads, (const int), (override));
+    /** Mocks method getNumThreads. */
+    MOCK_METHOD(int, getNumThreads, (), (const, override));
     /** Mocks method showImage. */
     MOCK_METHOD(void, showImage, (const std::string&, ImageMat&, int), (override));
     /** Mocks method writeImage. */
     MOCK_METHOD(bool, writeImage, (const std::string&, ImageMat&), (override));
     /** Mocks method readImage. */
     MOCK_METHOD(ImageMat, readImage, (const std::string&), (override));
+    /** Mocks method countImagePages. */
+    MOCK_METHOD(std::size_t, countImagePages, (const std::string&), (override));
+    /** Mocks method readImagePage. */
+    MOCK_METHOD(ImageMat, readImagePage, (const std::string&, const int), (override));
+    /** Mocks method decodeImage. */
+    MOCK_METHOD(ImageMat, decodeImage, (const std::vector<unsigned char>&), (override));
+    /** Mocks method encodeImage. */
+    MOCK_METHOD(bool, encodeImage, (const std::string&, ImageMat&, std::vector<unsigned char>&), (override));
+    /** Mocks method wrapImageBuffer. */
+    MOCK_METHOD(ImageMat,
+                wrapImageBuffer,
+                (const unsigned char*, const int, const int, const std::size_t, const PixelFormat),
+                (override));
+    /** Mocks method viewImageBuffer. */
+    MOCK_METHOD(ImageMat,
+                viewImageBuffer,
+                (const unsigned char*, const int, const int, const std::size_t, const int),
+                (override));
+    /** Mocks method copyImageBuffer. */
+    MOCK_METHOD(ImageMat,
+                copyImageBuffer,
+                (const unsigned char*, const int, const int, const std::size_t, const int),
+                (override));
     /** Mocks method cloneImage. */
     MOCK_METHOD(ImageMat, cloneImage, (ImageMat&), (override));
     /** Mocks method cropImage. */
     MOCK_METHOD(bool, cropImage, (ImageMat&, ImageMat&, const Rectangle&), (override));
+    /** Mocks method cropImageView. */
+    MOCK_METHOD(bool, cropImageView, (ImageMat&, ImageMat&, const Rectangle&), (override));
     /** Mocks method isImageEmpty. */
     MOCK_METHOD(bool, isImageEmpty, (ImageMat&), (override));
     /** Mocks method resizeImage. */
     MOCK_METHOD(void, resizeImage, (ImageMat&, ImageMat&, const double&), (override));
+    /** Mocks method thumbnailImage. */
+    MOCK_METHOD(void, thumbnailImage, (ImageMat&, ImageMat&, const int, const int), (override));
     /** Mocks method getImageWidth. */
     MOCK_METHOD(int, getImageWidth, (ImageMat&), (const, override));
     /** Mocks method getImageHeight. */
     MOCK_METHOD(int, getImageHeight, (ImageMat&), (const, override));
+    /** Mocks method getImageSizeBytes. */
+    MOCK_METHOD(std::size_t, getImageSizeBytes, (ImageMat&), (const, override));
+    /** Mocks method hashImage. */
+    MOCK_METHOD(std::uint64_t, hashImage, (ImageMat&), (const, override));
+    /** Mocks method getImageType. */
+    MOCK_METHOD(int, getImageType, (ImageMat&), (const, override));
+    /** Mocks method getImageRow. */
+    MOCK_METHOD(const unsigned char*, getImageRow, (ImageMat&, const int), (const, override));
     /** Mocks method convertImageToGray. */
     MOCK_METHOD(void, convertImageToGray, (ImageMat&, ImageMat&), (override));
     /** Mocks method gaussianBlurImage. */
@@ -20,22 +20,32 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      * @param saveImages Save images obtained during the processing.
      */
     explicit MockImagePreprocessing(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                    const std::shared_ptr<output::ImageWriter>& imageWriter,
                                     const std::shared_ptr<logging::Logger>& logger,
                                     const bool saveImages = false)
-        : ImagePreprocessing(openCvWrapper, logger, saveImages)
+        : ImagePreprocessing(openCvWrapper, imageWriter, logger, saveImages)
     {
     }
 
     /** Mocks method preprocessImage. */
     MOCK_METHOD(void, preprocessImage, (computerVision::ImageMat&), (override));
+    /** Mocks method preprocessImageBands. */
+    MOCK_METHOD(void, preprocessImageBands, (computerVision::ImageMat&, BinaryImage&, const int), (override));
+    /** Mocks method preprocessBinaryImage. */
+    MOCK_METHOD(void, preprocessBinaryImage, (computerVision::ImageMat&), (override));
     /** Mocks method setSaveImages. */
     MOCK_METHOD(void, setSaveImages, (const bool&), (override));
     /** Mocks method getSaveImages. */
     MOCK_METHOD(bool, getSaveImages, (), (const, override));
+    /** Mocks method setPreset. */
+    MOCK_METHOD(void, setPreset, (const common::Preset&), (override));
+    /** Mocks method getPreset. */
+    MOCK_METHOD(common::Preset, getPreset, (), (const, override));
     /** Mocks method resizeImage. */
     MOCK_METHOD(void, resizeImage, (computerVision::ImageMat&), (override));
     /** Mocks method convertImageToGray. */
@@ -52,6 +62,8 @@ public:
     MOCK_METHOD(void, thinningImage, (computerVision::ImageMat&), (override));
     /** Mocks method edgesImage. */
     MOCK_METHOD(void, edgesImage, (computerVision::ImageMat&), (override));
+    /** Mocks method preprocessBand. */
+    MOCK_METHOD(void, preprocessBand, (computerVision::ImageMat&), (override));
 };
 
 } // namespace imageProcessing
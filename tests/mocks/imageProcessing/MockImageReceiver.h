@@ -32,10 +32,34 @@ public:
     MOCK_METHOD(bool, receiveImage, (), (override));
     /** Mocks method getImageReceived. */
     MOCK_METHOD(computerVision::ImageMat, getImageReceived, (), (const, override));
+    /** Mocks method getImageBinary. */
+    MOCK_METHOD(BinaryImage, getImageBinary, (), (const, override));
     /** Mocks method setImageFilePath. */
     MOCK_METHOD(void, setImageFilePath, (const std::string&), (override));
     /** Mocks method getImageFilePath. */
     MOCK_METHOD(std::string, getImageFilePath, (), (const, override));
+    /** Mocks method setImagePage. */
+    MOCK_METHOD(void, setImagePage, (const int), (override));
+    /** Mocks method getImagePage. */
+    MOCK_METHOD(int, getImagePage, (), (const, override));
+    /** Mocks method getNumImagePages. */
+    MOCK_METHOD(std::size_t, getNumImagePages, (), (const, override));
+    /** Mocks method probeImage. */
+    MOCK_METHOD(bool, probeImage, (ImageInfo&), (const, override));
+    /** Mocks method setImageBuffer. */
+    MOCK_METHOD(void, setImageBuffer, (std::vector<unsigned char>), (override));
+    /** Mocks method getImageBuffer. */
+    MOCK_METHOD(const std::vector<unsigned char>&, getImageBuffer, (), (const, override));
+    /** Mocks method setRawImageBuffer. */
+    MOCK_METHOD(void, setRawImageBuffer, (const RawImageBuffer&), (override));
+    /** Mocks method getRawImageBuffer. */
+    MOCK_METHOD(RawImageBuffer, getRawImageBuffer, (), (const, override));
+    /** Mocks method isImageBorrowed. */
+    MOCK_METHOD(bool, isImageBorrowed, (), (const, override));
+    /** Mocks method releaseImage. */
+    MOCK_METHOD(void, releaseImage, (), (override));
+    /** Mocks method receiveMappedImage. */
+    MOCK_METHOD(bool, receiveMappedImage, (), (override));
 };
 
 } // namespace imageProcessing
@@ -51,6 +51,14 @@ public:
     MOCK_METHOD(void, setSaveImages, (const bool&), (override));
     /** Mocks method getSaveImages. */
     MOCK_METHOD(bool, getSaveImages, (), (const, override));
+    /** Mocks method setPreset. */
+    MOCK_METHOD(void, setPreset, (const common::Preset&), (override));
+    /** Mocks method getPreset. */
+    MOCK_METHOD(common::Preset, getPreset, (), (const, override));
+    /** Mocks method setDeterministicIds. */
+    MOCK_METHOD(void, setDeterministicIds, (const bool&), (override));
+    /** Mocks method getDeterministicIds. */
+    MOCK_METHOD(bool, getDeterministicIds, (), (const, override));
 };
 
 } // namespace imageProcessing
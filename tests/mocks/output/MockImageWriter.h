@@ -0,0 +1,50 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "output/ImageWriter.h"
+#include <gmock/gmock.h>
+
+namespace circuitSegmentation {
+namespace output {
+
+/**
+ * @brief Mock of the ImageWriter class.
+ */
+class MockImageWriter : public ImageWriter
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param openCvWrapper OpenCV wrapper.
+     * @param logger Logger.
+     */
+    explicit MockImageWriter(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                             const std::shared_ptr<logging::Logger>& logger)
+        : ImageWriter(openCvWrapper, logger, 1)
+    {
+    }
+
+    /** Mocks method writeImage. */
+    MOCK_METHOD(std::shared_future<bool>, writeImage, (const std::string&, computerVision::ImageMat), (override));
+    /** Mocks method encodeImage. */
+    MOCK_METHOD(std::shared_future<std::vector<unsigned char>>, encodeImage, (computerVision::ImageMat), (override));
+    /** Mocks method flush. */
+    MOCK_METHOD(bool, flush, (), (override));
+    /** Mocks method whenFlushed. */
+    MOCK_METHOD(void, whenFlushed, (const std::uint64_t, std::function<void(bool)>), (override));
+    /** Mocks method getNumThreads. */
+    MOCK_METHOD(unsigned int, getNumThreads, (), (const, override));
+    /** Mocks method getMemoryBudget. */
+    MOCK_METHOD(std::size_t, getMemoryBudget, (), (const, override));
+    /** Mocks method setOutputDirectory. */
+    MOCK_METHOD(void, setOutputDirectory, (const std::string&), (override));
+    /** Mocks method getOutputDirectory. */
+    MOCK_METHOD(std::string, getOutputDirectory, (), (const, override));
+};
+
+} // namespace output
+} // namespace circuitSegmentation
@@ -20,11 +20,13 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit MockComponentDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                    const std::shared_ptr<output::ImageWriter>& imageWriter,
                                     const std::shared_ptr<logging::Logger>& logger)
-        : ComponentDetection(openCvWrapper, logger)
+        : ComponentDetection(openCvWrapper, imageWriter, logger)
     {
     }
 
@@ -36,6 +38,10 @@ public:
         (override));
     /** Mocks method getDetectedComponents. */
     MOCK_METHOD(const std::vector<circuit::Component>&, getDetectedComponents, (), (const, override));
+    /** Mocks method setPreset. */
+    MOCK_METHOD(void, setPreset, (const common::Preset&), (override));
+    /** Mocks method getPreset. */
+    MOCK_METHOD(common::Preset, getPreset, (), (const, override));
     /** Mocks method removeConnectionsFromImage. */
     MOCK_METHOD(void,
                 removeConnectionsFromImage,
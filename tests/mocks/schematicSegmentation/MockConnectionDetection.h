@@ -20,11 +20,13 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit MockConnectionDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                     const std::shared_ptr<output::ImageWriter>& imageWriter,
                                      const std::shared_ptr<logging::Logger>& logger)
-        : ConnectionDetection(openCvWrapper, logger)
+        : ConnectionDetection(openCvWrapper, imageWriter, logger)
     {
     }
 
@@ -44,8 +46,14 @@ public:
         (override));
     /** Mocks method getDetectedConnections. */
     MOCK_METHOD(const std::vector<circuit::Connection>&, getDetectedConnections, (), (const, override));
+    /** Mocks method setDetectedConnections. */
+    MOCK_METHOD(void, setDetectedConnections, (const std::vector<circuit::Connection>&), (override));
     /** Mocks method getDetectedNodes. */
     MOCK_METHOD(const std::vector<circuit::Node>&, getDetectedNodes, (), (const, override));
+    /** Mocks method setPreset. */
+    MOCK_METHOD(void, setPreset, (const common::Preset&), (override));
+    /** Mocks method getPreset. */
+    MOCK_METHOD(common::Preset, getPreset, (), (const, override));
 };
 
 } // namespace schematicSegmentation
@@ -20,11 +20,13 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit MockLabelDetection(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                const std::shared_ptr<output::ImageWriter>& imageWriter,
                                 const std::shared_ptr<logging::Logger>& logger)
-        : LabelDetection(openCvWrapper, logger)
+        : LabelDetection(openCvWrapper, imageWriter, logger)
     {
     }
 
@@ -39,6 +41,10 @@ public:
                 (override));
     /** Mocks method getDetectedLabels. */
     MOCK_METHOD(const std::vector<circuit::Label>&, getDetectedLabels, (), (const, override));
+    /** Mocks method setPreset. */
+    MOCK_METHOD(void, setPreset, (const common::Preset&), (override));
+    /** Mocks method getPreset. */
+    MOCK_METHOD(common::Preset, getPreset, (), (const, override));
     /** Mocks method removeElementsFromImage. */
     MOCK_METHOD(void,
                 removeElementsFromImage,
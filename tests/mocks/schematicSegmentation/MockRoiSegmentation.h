@@ -20,11 +20,13 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit MockRoiSegmentation(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                 const std::shared_ptr<output::ImageWriter>& imageWriter,
                                  const std::shared_ptr<logging::Logger>& logger)
-        : RoiSegmentation(openCvWrapper, logger)
+        : RoiSegmentation(openCvWrapper, imageWriter, logger)
     {
     }
 
@@ -41,6 +43,14 @@ public:
                  const std::vector<circuit::Connection>&,
                  const std::vector<circuit::Node>&),
                 (override));
+    /** Mocks method generateRoiImages. */
+    MOCK_METHOD(bool, generateRoiImages, (computerVision::ImageMat&, std::vector<RoiImage>), (override));
+    /** Mocks method clearRoiImages. */
+    MOCK_METHOD(void, clearRoiImages, (), (override));
+    /** Mocks method setWriteImages. */
+    MOCK_METHOD(void, setWriteImages, (const bool&), (override));
+    /** Mocks method setEncodeImages. */
+    MOCK_METHOD(void, setEncodeImages, (const bool&), (override));
 };
 
 } // namespace schematicSegmentation
@@ -20,11 +20,13 @@ public:
      * @brief Constructor.
      *
      * @param openCvWrapper OpenCV wrapper.
+     * @param imageWriter Image writer.
      * @param logger Logger.
      */
     explicit MockSchematicSegmentation(const std::shared_ptr<computerVision::OpenCvWrapper>& openCvWrapper,
+                                       const std::shared_ptr<output::ImageWriter>& imageWriter,
                                        const std::shared_ptr<logging::Logger>& logger)
-        : SchematicSegmentation(openCvWrapper, logger)
+        : SchematicSegmentation(openCvWrapper, imageWriter, logger)
     {
     }
 
@@ -40,11 +42,18 @@ public:
                 (override));
     /** Mocks method updateDetectedComponents. */
     MOCK_METHOD(bool, updateDetectedComponents, (), (override));
+    /** Mocks method setElements. */
+    MOCK_METHOD(void,
+                setElements,
+                (std::vector<circuit::Component>, std::vector<circuit::Connection>, std::vector<circuit::Node>),
+                (override));
     /** Mocks method associateLabels. */
     MOCK_METHOD(void,
                 associateLabels,
                 (computerVision::ImageMat&, computerVision::ImageMat&, const std::vector<circuit::Label>&, const bool),
                 (override));
+    /** Mocks method assignDeterministicIds. */
+    MOCK_METHOD(void, assignDeterministicIds, (const int, const int), (override));
     /** Mocks method getComponents. */
     MOCK_METHOD(const std::vector<circuit::Component>&, getComponents, (), (const, override));
     /** Mocks method getConnections. */
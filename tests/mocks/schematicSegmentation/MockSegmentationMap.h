@@ -37,6 +37,12 @@ public:
     MOCK_METHOD(bool, writeSegmentationMapJsonFile, (), (override));
     /** Mocks method getSegmentationMap. */
     MOCK_METHOD(const nlohmann::ordered_json&, getSegmentationMap, (), (override, const));
+    /** Mocks method setSegmentationMap. */
+    MOCK_METHOD(void, setSegmentationMap, (const nlohmann::ordered_json&), (override));
+    /** Mocks method setOutputDirectory. */
+    MOCK_METHOD(void, setOutputDirectory, (const std::string&), (override));
+    /** Mocks method getOutputDirectory. */
+    MOCK_METHOD(std::string, getOutputDirectory, (), (override, const));
 };
 
 } // namespace schematicSegmentation
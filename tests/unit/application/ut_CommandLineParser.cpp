@@ -218,6 +218,38 @@ TEST_F(CommandLineParserTest, getsImagePathNoOption)
     EXPECT_EQ("", value);
 }
 
+/**
+ * @brief Tests if parser reads the image from the standard input.
+ */
+TEST_F(CommandLineParserTest, hasImageFromStandardInput)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--image", "-"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify option
+    const auto hasStandardInput = mCommandLineParser.hasImageFromStandardInput();
+
+    EXPECT_TRUE(hasStandardInput);
+}
+
+/**
+ * @brief Tests if parser does not read the image from the standard input when an image file path is passed.
+ */
+TEST_F(CommandLineParserTest, doesNotHaveImageFromStandardInput)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-i", "image.png"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify option
+    const auto hasStandardInput = mCommandLineParser.hasImageFromStandardInput();
+
+    EXPECT_FALSE(hasStandardInput);
+}
+
 /**
  * @brief Tests if parser has the save images option passed (short option).
  */
@@ -265,3 +297,659 @@ TEST_F(CommandLineParserTest, doesNotHaveSaveImagesOption)
 
     EXPECT_FALSE(hasSaveImagesOption);
 }
+
+/**
+ * @brief Tests if parser gets the number of jobs (short option).
+ */
+TEST_F(CommandLineParserTest, getsNumJobsShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-j", "4"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get number of jobs
+    const auto numJobs = mCommandLineParser.getNumJobs();
+
+    EXPECT_EQ(numJobs, 4U);
+}
+
+/**
+ * @brief Tests if parser gets the number of jobs (long option).
+ */
+TEST_F(CommandLineParserTest, getsNumJobsLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--jobs", "8"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get number of jobs
+    const auto numJobs = mCommandLineParser.getNumJobs();
+
+    EXPECT_EQ(numJobs, 8U);
+}
+
+/**
+ * @brief Tests if parser does not get the number of jobs when the option is not passed or is invalid.
+ */
+TEST_F(CommandLineParserTest, getsNumJobsNoOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-j", "four"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get number of jobs
+    const auto numJobs = mCommandLineParser.getNumJobs();
+
+    EXPECT_EQ(numJobs, 0U);
+}
+
+/**
+ * @brief Tests if parser has the pin threads option passed (short option).
+ */
+TEST_F(CommandLineParserTest, hasPinThreadsShortOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "-p"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is present
+    const bool hasPinThreadsOption = mCommandLineParser.hasPinThreads();
+
+    EXPECT_TRUE(hasPinThreadsOption);
+}
+
+/**
+ * @brief Tests if parser has the pin threads option passed (long option).
+ */
+TEST_F(CommandLineParserTest, hasPinThreadsLongOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "--pin-threads"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is present
+    const bool hasPinThreadsOption = mCommandLineParser.hasPinThreads();
+
+    EXPECT_TRUE(hasPinThreadsOption);
+}
+
+/**
+ * @brief Tests if parser does not have the pin threads option.
+ */
+TEST_F(CommandLineParserTest, doesNotHavePinThreadsOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--p", "-pin-threads"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is not present
+    const bool hasPinThreadsOption = mCommandLineParser.hasPinThreads();
+
+    EXPECT_FALSE(hasPinThreadsOption);
+}
+
+/**
+ * @brief Tests if parser gets the daemon socket path (short option).
+ */
+TEST_F(CommandLineParserTest, getsDaemonSocketPathShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-d", "/tmp/cs.sock"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get daemon socket path
+    const auto socketPath = mCommandLineParser.getDaemonSocketPath();
+
+    EXPECT_EQ(socketPath, "/tmp/cs.sock");
+}
+
+/**
+ * @brief Tests if parser gets the daemon socket path (long option).
+ */
+TEST_F(CommandLineParserTest, getsDaemonSocketPathLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--daemon", "/tmp/cs.sock"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get daemon socket path
+    const auto socketPath = mCommandLineParser.getDaemonSocketPath();
+
+    EXPECT_EQ(socketPath, "/tmp/cs.sock");
+}
+
+/**
+ * @brief Tests if parser does not get the daemon socket path when the option is not passed.
+ */
+TEST_F(CommandLineParserTest, getsDaemonSocketPathNoOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-i", "image.png"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get daemon socket path
+    const auto socketPath = mCommandLineParser.getDaemonSocketPath();
+
+    EXPECT_TRUE(socketPath.empty());
+}
+
+/**
+ * @brief Tests if parser gets the watch spool folder (short option).
+ */
+TEST_F(CommandLineParserTest, getsWatchDirectoryShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-w", "/var/spool/cs"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get watch spool folder
+    const auto watchDirectory = mCommandLineParser.getWatchDirectory();
+
+    EXPECT_EQ(watchDirectory, "/var/spool/cs");
+}
+
+/**
+ * @brief Tests if parser gets the watch spool folder (long option).
+ */
+TEST_F(CommandLineParserTest, getsWatchDirectoryLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--watch", "/var/spool/cs"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get watch spool folder
+    const auto watchDirectory = mCommandLineParser.getWatchDirectory();
+
+    EXPECT_EQ(watchDirectory, "/var/spool/cs");
+}
+
+/**
+ * @brief Tests if parser does not get the watch spool folder when the option is not passed.
+ */
+TEST_F(CommandLineParserTest, getsWatchDirectoryNoOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-i", "image.png"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get watch spool folder
+    const auto watchDirectory = mCommandLineParser.getWatchDirectory();
+
+    EXPECT_TRUE(watchDirectory.empty());
+}
+
+/**
+ * @brief Tests if parser gets the shared-memory ring name (short option).
+ */
+TEST_F(CommandLineParserTest, getsSharedMemoryRingNameShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-r", "/cs-frames"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get shared-memory ring name
+    const auto ringName = mCommandLineParser.getSharedMemoryRingName();
+
+    EXPECT_EQ(ringName, "/cs-frames");
+}
+
+/**
+ * @brief Tests if parser gets the shared-memory ring name (long option).
+ */
+TEST_F(CommandLineParserTest, getsSharedMemoryRingNameLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--shm-ring", "/cs-frames"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get shared-memory ring name
+    const auto ringName = mCommandLineParser.getSharedMemoryRingName();
+
+    EXPECT_EQ(ringName, "/cs-frames");
+}
+
+/**
+ * @brief Tests if parser does not get the shared-memory ring name when the option is not passed.
+ */
+TEST_F(CommandLineParserTest, getsSharedMemoryRingNameNoOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-i", "image.png"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get shared-memory ring name
+    const auto ringName = mCommandLineParser.getSharedMemoryRingName();
+
+    EXPECT_TRUE(ringName.empty());
+}
+
+/**
+ * @brief Tests if parser gets the preset (short option).
+ */
+TEST_F(CommandLineParserTest, getsPresetShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-P", "fast"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get preset
+    const auto preset = mCommandLineParser.getPreset();
+
+    EXPECT_EQ(preset, circuitSegmentation::common::Preset::FAST);
+}
+
+/**
+ * @brief Tests if parser gets the preset (long option).
+ */
+TEST_F(CommandLineParserTest, getsPresetLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--preset", "accurate"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get preset
+    const auto preset = mCommandLineParser.getPreset();
+
+    EXPECT_EQ(preset, circuitSegmentation::common::Preset::ACCURATE);
+}
+
+/**
+ * @brief Tests if parser gets the balanced preset when the option is not passed or is invalid.
+ */
+TEST_F(CommandLineParserTest, getsPresetNoOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-P", "fastest"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get preset
+    const auto preset = mCommandLineParser.getPreset();
+
+    EXPECT_EQ(preset, circuitSegmentation::common::Preset::BALANCED);
+}
+
+/**
+ * @brief Tests if parser gets the memory budget (short option).
+ */
+TEST_F(CommandLineParserTest, getsMemoryBudgetShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-m", "512"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get memory budget
+    const auto memoryBudget = mCommandLineParser.getMemoryBudget();
+
+    EXPECT_EQ(memoryBudget, 512U);
+}
+
+/**
+ * @brief Tests if parser gets the memory budget (long option).
+ */
+TEST_F(CommandLineParserTest, getsMemoryBudgetLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--memory-budget", "2048"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get memory budget
+    const auto memoryBudget = mCommandLineParser.getMemoryBudget();
+
+    EXPECT_EQ(memoryBudget, 2048U);
+}
+
+/**
+ * @brief Tests if parser does not get the memory budget when the option is invalid.
+ */
+TEST_F(CommandLineParserTest, getsMemoryBudgetInvalidOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-m", "512MiB"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get memory budget
+    const auto memoryBudget = mCommandLineParser.getMemoryBudget();
+
+    EXPECT_EQ(memoryBudget, 0U);
+}
+
+/**
+ * @brief Tests if parser gets the folder of the result cache (short option).
+ */
+TEST_F(CommandLineParserTest, getsCacheDirectoryShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-c", "cache"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get folder of the result cache
+    const auto cacheDirectory = mCommandLineParser.getCacheDirectory();
+
+    EXPECT_EQ(cacheDirectory, "cache");
+}
+
+/**
+ * @brief Tests if parser gets the folder of the result cache (long option).
+ */
+TEST_F(CommandLineParserTest, getsCacheDirectoryLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--cache", "cache"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get folder of the result cache
+    const auto cacheDirectory = mCommandLineParser.getCacheDirectory();
+
+    EXPECT_EQ(cacheDirectory, "cache");
+}
+
+/**
+ * @brief Tests if parser gets the maximum size of the result cache.
+ */
+TEST_F(CommandLineParserTest, getsCacheSizeLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--cache-size", "256"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get maximum size of the result cache
+    const auto cacheSize = mCommandLineParser.getCacheSize();
+
+    EXPECT_EQ(cacheSize, 256U);
+}
+
+/**
+ * @brief Tests if parser gets the default maximum size of the result cache when the option is invalid.
+ */
+TEST_F(CommandLineParserTest, getsCacheSizeInvalidOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-C", "0"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get maximum size of the result cache
+    const auto cacheSize = mCommandLineParser.getCacheSize();
+
+    EXPECT_EQ(cacheSize, circuitSegmentation::application::CommandLineParser::cCacheSizeDefault);
+}
+
+/**
+ * @brief Tests if parser gets the folder of the stage checkpoints (short option).
+ */
+TEST_F(CommandLineParserTest, getsCheckpointsDirectoryShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-k", "checkpoints"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get folder of the stage checkpoints
+    const auto checkpointsDirectory = mCommandLineParser.getCheckpointsDirectory();
+
+    EXPECT_EQ(checkpointsDirectory, "checkpoints");
+}
+
+/**
+ * @brief Tests if parser gets the folder of the stage checkpoints (long option).
+ */
+TEST_F(CommandLineParserTest, getsCheckpointsDirectoryLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--checkpoints", "checkpoints"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get folder of the stage checkpoints
+    const auto checkpointsDirectory = mCommandLineParser.getCheckpointsDirectory();
+
+    EXPECT_EQ(checkpointsDirectory, "checkpoints");
+}
+
+/**
+ * @brief Tests if parser gets the configuration of the parameter sweep (short option).
+ */
+TEST_F(CommandLineParserTest, getsSweepConfigPathShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-S", "sweep.json"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get configuration of the parameter sweep
+    const auto sweepConfigPath = mCommandLineParser.getSweepConfigPath();
+
+    EXPECT_EQ(sweepConfigPath, "sweep.json");
+}
+
+/**
+ * @brief Tests if parser gets the configuration of the parameter sweep (long option).
+ */
+TEST_F(CommandLineParserTest, getsSweepConfigPathLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--sweep", "sweep.json"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get configuration of the parameter sweep
+    const auto sweepConfigPath = mCommandLineParser.getSweepConfigPath();
+
+    EXPECT_EQ(sweepConfigPath, "sweep.json");
+}
+
+/**
+ * @brief Tests if parser has the deterministic IDs option passed (short option).
+ */
+TEST_F(CommandLineParserTest, hasDeterministicIdsShortOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "-D"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is present
+    const bool hasDeterministicIdsOption = mCommandLineParser.hasDeterministicIds();
+
+    EXPECT_TRUE(hasDeterministicIdsOption);
+}
+
+/**
+ * @brief Tests if parser has the deterministic IDs option passed (long option).
+ */
+TEST_F(CommandLineParserTest, hasDeterministicIdsLongOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "--deterministic-ids"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is present
+    const bool hasDeterministicIdsOption = mCommandLineParser.hasDeterministicIds();
+
+    EXPECT_TRUE(hasDeterministicIdsOption);
+}
+
+/**
+ * @brief Tests if parser does not have the deterministic IDs option.
+ */
+TEST_F(CommandLineParserTest, doesNotHaveDeterministicIdsOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "-V"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is not present
+    const bool hasDeterministicIdsOption = mCommandLineParser.hasDeterministicIds();
+
+    EXPECT_FALSE(hasDeterministicIdsOption);
+}
+
+/**
+ * @brief Tests if parser has the near-duplicates option passed (short option).
+ */
+TEST_F(CommandLineParserTest, hasNearDuplicatesShortOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "-n"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is present
+    const bool hasNearDuplicatesOption = mCommandLineParser.hasNearDuplicates();
+
+    EXPECT_TRUE(hasNearDuplicatesOption);
+}
+
+/**
+ * @brief Tests if parser has the near-duplicates option passed (long option).
+ */
+TEST_F(CommandLineParserTest, hasNearDuplicatesLongOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "--near-duplicates"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is present
+    const bool hasNearDuplicatesOption = mCommandLineParser.hasNearDuplicates();
+
+    EXPECT_TRUE(hasNearDuplicatesOption);
+}
+
+/**
+ * @brief Tests if parser does not have the near-duplicates option.
+ */
+TEST_F(CommandLineParserTest, doesNotHaveNearDuplicatesOption)
+{
+    const int argc = 2;
+    const char* argv[] = {"exe", "-V"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Verify if option is not present
+    const bool hasNearDuplicatesOption = mCommandLineParser.hasNearDuplicates();
+
+    EXPECT_FALSE(hasNearDuplicatesOption);
+}
+
+/**
+ * @brief Tests if parser gets the tile size (short option).
+ */
+TEST_F(CommandLineParserTest, getsTileSizeShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-t", "8192"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get tile size
+    const auto tileSize = mCommandLineParser.getTileSize();
+
+    EXPECT_EQ(tileSize, 8192U);
+}
+
+/**
+ * @brief Tests if parser gets the tile size (long option).
+ */
+TEST_F(CommandLineParserTest, getsTileSizeLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--tile-size", "4096"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get tile size
+    const auto tileSize = mCommandLineParser.getTileSize();
+
+    EXPECT_EQ(tileSize, 4096U);
+}
+
+/**
+ * @brief Tests if parser does not get the tile size when the option is invalid.
+ */
+TEST_F(CommandLineParserTest, getsTileSizeInvalidOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-t", "4096px"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get tile size
+    const auto tileSize = mCommandLineParser.getTileSize();
+
+    EXPECT_EQ(tileSize, 0U);
+}
+
+/**
+ * @brief Tests if parser gets the band height (short option).
+ */
+TEST_F(CommandLineParserTest, getsBandHeightShortOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-b", "512"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get band height
+    const auto bandHeight = mCommandLineParser.getBandHeight();
+
+    EXPECT_EQ(bandHeight, 512U);
+}
+
+/**
+ * @brief Tests if parser gets the band height (long option).
+ */
+TEST_F(CommandLineParserTest, getsBandHeightLongOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "--band-height", "128"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get band height
+    const auto bandHeight = mCommandLineParser.getBandHeight();
+
+    EXPECT_EQ(bandHeight, 128U);
+}
+
+/**
+ * @brief Tests if parser does not get the band height when the option is invalid.
+ */
+TEST_F(CommandLineParserTest, getsBandHeightInvalidOption)
+{
+    const int argc = 3;
+    const char* argv[] = {"exe", "-b", "-1"};
+
+    mCommandLineParser.parse(argc, argv);
+
+    // Get band height
+    const auto bandHeight = mCommandLineParser.getBandHeight();
+
+    EXPECT_EQ(bandHeight, 0U);
+}
@@ -0,0 +1,524 @@
+/**
+ * @file
+ */
+
+#include "application/Daemon.h"
+#include "logging/Logger.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::application;
+
+/**
+ * @brief Test class of Daemon.
+ */
+class DaemonTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+        mSocketPath = (std::filesystem::temp_directory_path() / "cs_ut_daemon.sock").string();
+
+        // No managers: the tests only send requests that are not processed
+        mDaemon = std::make_unique<Daemon>(
+            mSocketPath, std::vector<std::unique_ptr<imageProcessing::ImageProcManager>>{}, mLogger);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+#if defined(__unix__) || defined(__APPLE__)
+    /**
+     * @brief Connects to the daemon, retrying until it is listening.
+     *
+     * @return File descriptor of the connection, or -1 on failure.
+     */
+    int connectToDaemon()
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        mSocketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+        for (int attempt{0}; attempt < 100; ++attempt) {
+            const auto fd{socket(AF_UNIX, SOCK_STREAM, 0)};
+            if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+                return fd;
+            }
+            close(fd);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        return -1;
+    }
+
+    /**
+     * @brief Sends a request to the daemon and reads the reply.
+     *
+     * @param fd File descriptor of the connection.
+     * @param request Request, in JSON.
+     *
+     * @return Reply, in JSON.
+     */
+    static nlohmann::ordered_json sendRequest(const int fd, const std::string& request)
+    {
+        const auto line{request + "\n"};
+        EXPECT_EQ(write(fd, line.data(), line.size()), static_cast<ssize_t>(line.size()));
+
+        return readReply(fd);
+    }
+
+    /**
+     * @brief Reads a reply of the daemon.
+     *
+     * @param fd File descriptor of the connection.
+     *
+     * @return Reply, in JSON.
+     */
+    static nlohmann::ordered_json readReply(const int fd)
+    {
+        std::string reply{};
+        char c{};
+        while (read(fd, &c, 1) == 1 && c != '\n') {
+            reply.push_back(c);
+        }
+
+        return nlohmann::ordered_json::parse(reply, nullptr, false);
+    }
+#endif
+
+protected:
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Path of the socket. */
+    std::string mSocketPath;
+    /** Daemon. */
+    std::unique_ptr<Daemon> mDaemon;
+};
+
+/**
+ * @brief Tests that the daemon has at least one worker.
+ */
+TEST_F(DaemonTest, hasWorkers)
+{
+    EXPECT_EQ(mDaemon->getNumWorkers(), 1U);
+    EXPECT_EQ(mDaemon->getSocketPath(), mSocketPath);
+}
+
+/**
+ * @brief Tests that without budget of memory the requests are admitted without reservation.
+ */
+TEST_F(DaemonTest, reservesNoMemoryWithoutBudget)
+{
+    DaemonRequest request{};
+    request.mImagePath = "image.png";
+    auto lowMemoryMode{true};
+
+    const auto reservation{mDaemon->reserveMemory(request, lowMemoryMode)};
+
+    EXPECT_EQ(mDaemon->getMemoryBudget(), 0U);
+    EXPECT_EQ(reservation.getBytes(), 0U);
+    EXPECT_FALSE(lowMemoryMode);
+}
+
+/**
+ * @brief Tests that the memory of a request is estimated from the header of its image, in low-memory mode when it
+ * does not fit in the budget otherwise.
+ */
+TEST_F(DaemonTest, reservesMemoryOfRequest)
+{
+    // PNG image with 640x480 pixels
+    DaemonRequest request{};
+    request.mImageBuffer = {0x89, 'P', 'N',  'G', 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D,
+                            'I',  'H', 'D',  'R', 0x00, 0x00, 0x02, 0x80, 0x00, 0x00, 0x01, 0xE0};
+    request.mSaveImages = true;
+    const imageProcessing::ImageDimensions dimensions{640, 480};
+    const auto peakMemory{
+        imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, true, request.mImageBuffer.size())};
+    const auto lowPeakMemory{
+        imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, false, request.mImageBuffer.size())};
+    auto lowMemoryMode{false};
+
+    // Fits in the budget
+    Daemon daemon{mSocketPath, {}, mLogger, peakMemory};
+    auto reservation{daemon.reserveMemory(request, lowMemoryMode)};
+    EXPECT_EQ(reservation.getBytes(), peakMemory);
+    EXPECT_FALSE(lowMemoryMode);
+    reservation.release();
+
+    // Fits in the budget only in low-memory mode
+    Daemon lowMemoryDaemon{mSocketPath, {}, mLogger, lowPeakMemory};
+    reservation = lowMemoryDaemon.reserveMemory(request, lowMemoryMode);
+    EXPECT_EQ(reservation.getBytes(), lowPeakMemory);
+    EXPECT_FALSE(reservation.isOversized());
+    EXPECT_TRUE(lowMemoryMode);
+    reservation.release();
+
+    // Larger than the budget: admitted alone
+    Daemon smallDaemon{mSocketPath, {}, mLogger, 1024};
+    reservation = smallDaemon.reserveMemory(request, lowMemoryMode);
+    EXPECT_TRUE(reservation.isOversized());
+    EXPECT_TRUE(lowMemoryMode);
+    reservation.release();
+
+    // Unknown dimensions: admitted alone
+    request.mImageBuffer = {'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'};
+    reservation = daemon.reserveMemory(request, lowMemoryMode);
+    EXPECT_TRUE(reservation.isOversized());
+    EXPECT_TRUE(lowMemoryMode);
+}
+
+/**
+ * @brief Tests that a request with an image file path is parsed.
+ */
+TEST_F(DaemonTest, parsesRequestWithImagePath)
+{
+    DaemonRequest request{};
+    std::string error{};
+
+    ASSERT_TRUE(Daemon::parseRequest(
+        R"({"id": 7, "image": "circuit.png", "outputDir": "out", "saveImages": true, "writeFiles": false})",
+        request,
+        error));
+
+    EXPECT_EQ(request.mId, 7);
+    EXPECT_FALSE(request.mShutdown);
+    EXPECT_EQ(request.mImagePath, "circuit.png");
+    EXPECT_TRUE(request.mImageBuffer.empty());
+    EXPECT_EQ(request.mOutputDirectory, "out");
+    EXPECT_TRUE(request.mSaveImages);
+    EXPECT_FALSE(request.mWriteFiles);
+    EXPECT_EQ(request.mTimeoutMs, 0U);
+}
+
+/**
+ * @brief Tests that a request with a timeout is parsed.
+ */
+TEST_F(DaemonTest, parsesRequestWithTimeout)
+{
+    DaemonRequest request{};
+    std::string error{};
+
+    ASSERT_TRUE(Daemon::parseRequest(R"({"image": "circuit.png", "timeoutMs": 250})", request, error));
+
+    EXPECT_EQ(request.mTimeoutMs, 250U);
+}
+
+/**
+ * @brief Tests that a request with a preset is parsed, and that the preset is not set when not given.
+ */
+TEST_F(DaemonTest, parsesRequestWithPreset)
+{
+    DaemonRequest request{};
+    std::string error{};
+
+    ASSERT_TRUE(Daemon::parseRequest(R"({"image": "circuit.png", "preset": "fast"})", request, error));
+    EXPECT_EQ(request.mPreset, common::Preset::FAST);
+
+    DaemonRequest requestWithoutPreset{};
+    ASSERT_TRUE(Daemon::parseRequest(R"({"image": "circuit.png"})", requestWithoutPreset, error));
+    EXPECT_FALSE(requestWithoutPreset.mPreset.has_value());
+}
+
+/**
+ * @brief Tests that a request with an inline image is parsed.
+ */
+TEST_F(DaemonTest, parsesRequestWithImageData)
+{
+    DaemonRequest request{};
+    std::string error{};
+
+    ASSERT_TRUE(Daemon::parseRequest(R"({"id": "a", "imageData": "iVBORw=="})", request, error));
+
+    const std::vector<unsigned char> expectedBuffer{0x89, 'P', 'N', 'G'};
+    EXPECT_EQ(request.mId, "a");
+    EXPECT_TRUE(request.mImagePath.empty());
+    EXPECT_EQ(request.mImageBuffer, expectedBuffer);
+    EXPECT_TRUE(request.mOutputDirectory.empty());
+    EXPECT_FALSE(request.mSaveImages);
+    EXPECT_TRUE(request.mWriteFiles);
+}
+
+/**
+ * @brief Tests that a shutdown request is parsed.
+ */
+TEST_F(DaemonTest, parsesShutdownRequest)
+{
+    DaemonRequest request{};
+    std::string error{};
+
+    ASSERT_TRUE(Daemon::parseRequest(R"({"command": "shutdown"})", request, error));
+
+    EXPECT_TRUE(request.mShutdown);
+}
+
+/**
+ * @brief Tests that invalid requests are not parsed.
+ */
+TEST_F(DaemonTest, parsesInvalidRequests)
+{
+    const std::vector<std::string> lines{
+        "not json",
+        "[1, 2]",
+        R"({"command": "restart"})",
+        R"({"id": 1})",
+        R"({"image": "circuit.png", "imageData": "iVBORw=="})",
+        R"({"image": ""})",
+        R"({"image": 1})",
+        R"({"imageData": "not base64"})",
+        R"({"image": "circuit.png", "outputDir": 1})",
+        R"({"image": "circuit.png", "saveImages": "yes"})",
+        R"({"image": "circuit.png", "writeFiles": 0})",
+        R"({"image": "circuit.png", "timeoutMs": -1})",
+        R"({"image": "circuit.png", "timeoutMs": 1.5})",
+        R"({"image": "circuit.png", "timeoutMs": 5000000000})",
+        R"({"image": "circuit.png", "preset": "fastest"})",
+        R"({"image": "circuit.png", "preset": 0})",
+    };
+
+    for (const auto& line : lines) {
+        DaemonRequest request{};
+        std::string error{};
+
+        EXPECT_FALSE(Daemon::parseRequest(line, request, error)) << line;
+        EXPECT_FALSE(error.empty()) << line;
+    }
+}
+
+/**
+ * @brief Tests the names of the processing statuses given in the replies.
+ */
+TEST_F(DaemonTest, getsStatusNames)
+{
+    EXPECT_EQ(Daemon::getStatusName(imageProcessing::ProcessingStatus::SUCCESS), "success");
+    EXPECT_EQ(Daemon::getStatusName(imageProcessing::ProcessingStatus::FAILED), "failed");
+    EXPECT_EQ(Daemon::getStatusName(imageProcessing::ProcessingStatus::CANCELLED), "cancelled");
+    EXPECT_EQ(Daemon::getStatusName(imageProcessing::ProcessingStatus::DEADLINE_EXCEEDED), "deadlineExceeded");
+}
+
+/**
+ * @brief Tests that base64 text is decoded, with and without padding.
+ */
+TEST_F(DaemonTest, decodesBase64)
+{
+    std::vector<unsigned char> data{};
+
+    ASSERT_TRUE(Daemon::decodeBase64("TWFu", data));
+    EXPECT_EQ(std::string(data.begin(), data.end()), "Man");
+
+    ASSERT_TRUE(Daemon::decodeBase64("TWE=", data));
+    EXPECT_EQ(std::string(data.begin(), data.end()), "Ma");
+
+    ASSERT_TRUE(Daemon::decodeBase64("TQ==", data));
+    EXPECT_EQ(std::string(data.begin(), data.end()), "M");
+
+    ASSERT_TRUE(Daemon::decodeBase64("", data));
+    EXPECT_TRUE(data.empty());
+}
+
+/**
+ * @brief Tests that invalid base64 text is not decoded.
+ */
+TEST_F(DaemonTest, decodesInvalidBase64)
+{
+    std::vector<unsigned char> data{};
+
+    EXPECT_FALSE(Daemon::decodeBase64("TWF", data));
+    EXPECT_FALSE(Daemon::decodeBase64("TW=u", data));
+    EXPECT_FALSE(Daemon::decodeBase64("TQ==TWFu", data));
+    EXPECT_FALSE(Daemon::decodeBase64("TW#u", data));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+/**
+ * @brief Tests that the daemon replies to requests on the socket and stops on a shutdown request.
+ */
+TEST_F(DaemonTest, servesRequestsUntilShutdown)
+{
+    auto running{std::async(std::launch::async, [this]() { return mDaemon->run(); })};
+
+    const auto fd{connectToDaemon()};
+    ASSERT_GE(fd, 0);
+
+    // Invalid request
+    const auto reply = sendRequest(fd, R"({"id": 1, "image": ""})");
+    EXPECT_EQ(reply["id"], 1);
+    EXPECT_FALSE(reply["success"].get<bool>());
+    EXPECT_TRUE(reply.contains("error"));
+
+    // Shutdown
+    const auto shutdownReply = sendRequest(fd, R"({"id": 2, "command": "shutdown"})");
+    EXPECT_EQ(shutdownReply["id"], 2);
+    EXPECT_TRUE(shutdownReply["success"].get<bool>());
+
+    EXPECT_TRUE(running.get());
+    EXPECT_FALSE(std::filesystem::exists(mSocketPath));
+
+    close(fd);
+}
+
+/**
+ * @brief Tests that the daemon stops when requested.
+ */
+TEST_F(DaemonTest, stopsWhenRequested)
+{
+    auto running{std::async(std::launch::async, [this]() { return mDaemon->run(); })};
+
+    const auto fd{connectToDaemon()};
+    ASSERT_GE(fd, 0);
+
+    mDaemon->stop();
+
+    // The idle connection is closed
+    EXPECT_TRUE(running.get());
+    char c{};
+    EXPECT_EQ(read(fd, &c, 1), 0);
+
+    close(fd);
+}
+
+/**
+ * @brief Tests that an idle connection does not hold the only worker.
+ */
+TEST_F(DaemonTest, servesRequestsWithIdleConnection)
+{
+    auto running{std::async(std::launch::async, [this]() { return mDaemon->run(); })};
+
+    const auto idleFd{connectToDaemon()};
+    ASSERT_GE(idleFd, 0);
+    const auto fd{connectToDaemon()};
+    ASSERT_GE(fd, 0);
+
+    const auto reply = sendRequest(fd, R"({"id": 1, "image": ""})");
+    EXPECT_EQ(reply["id"], 1);
+
+    mDaemon->stop();
+    EXPECT_TRUE(running.get());
+
+    close(fd);
+    close(idleFd);
+}
+
+/**
+ * @brief Tests that the requests sent together on a connection are replied in order.
+ */
+TEST_F(DaemonTest, repliesPipelinedRequestsInOrder)
+{
+    auto running{std::async(std::launch::async, [this]() { return mDaemon->run(); })};
+
+    const auto fd{connectToDaemon()};
+    ASSERT_GE(fd, 0);
+
+    const std::string requests{"{\"id\": 1, \"image\": \"\"}\n{\"id\": 2, \"image\": \"\"}\n{\"id\": 3,"};
+    ASSERT_EQ(write(fd, requests.data(), requests.size()), static_cast<ssize_t>(requests.size()));
+
+    EXPECT_EQ(readReply(fd)["id"], 1);
+    EXPECT_EQ(readReply(fd)["id"], 2);
+
+    // Rest of the last request
+    EXPECT_EQ(sendRequest(fd, R"( "image": ""})")["id"], 3);
+
+    mDaemon->stop();
+    EXPECT_TRUE(running.get());
+
+    close(fd);
+}
+
+/**
+ * @brief Tests that the daemon does not run on the socket of a running daemon.
+ */
+TEST_F(DaemonTest, runsUnsuccessfullyWhenAlreadyRunning)
+{
+    auto running{std::async(std::launch::async, [this]() { return mDaemon->run(); })};
+
+    const auto fd{connectToDaemon()};
+    ASSERT_GE(fd, 0);
+
+    Daemon daemon{mSocketPath, std::vector<std::unique_ptr<imageProcessing::ImageProcManager>>{}, mLogger};
+    EXPECT_FALSE(daemon.run());
+
+    // The running daemon still serves its socket
+    const auto reply = sendRequest(fd, R"({"id": 1, "image": ""})");
+    EXPECT_EQ(reply["id"], 1);
+    const auto otherFd{connectToDaemon()};
+    EXPECT_GE(otherFd, 0);
+
+    mDaemon->stop();
+    EXPECT_TRUE(running.get());
+
+    close(otherFd);
+    close(fd);
+}
+
+/**
+ * @brief Tests that the daemon does not replace a path that is not a socket.
+ */
+TEST_F(DaemonTest, runsUnsuccessfullyWhenPathIsNotSocket)
+{
+    std::ofstream{mSocketPath} << "data";
+
+    EXPECT_FALSE(mDaemon->run());
+    EXPECT_TRUE(std::filesystem::is_regular_file(mSocketPath));
+
+    std::filesystem::remove(mSocketPath);
+}
+
+/**
+ * @brief Tests that the daemon replaces a stale socket, and creates its socket only for its owner.
+ */
+TEST_F(DaemonTest, replacesStaleSocket)
+{
+    // Socket bound and closed without listening (refusing connections)
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    mSocketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    const auto staleFd{socket(AF_UNIX, SOCK_STREAM, 0)};
+    ASSERT_EQ(bind(staleFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    close(staleFd);
+
+    auto running{std::async(std::launch::async, [this]() { return mDaemon->run(); })};
+
+    const auto fd{connectToDaemon()};
+    ASSERT_GE(fd, 0);
+    const auto reply = sendRequest(fd, R"({"id": 1, "image": ""})");
+    EXPECT_EQ(reply["id"], 1);
+
+    const auto permissions{std::filesystem::status(mSocketPath).permissions()};
+    EXPECT_EQ(permissions & (std::filesystem::perms::group_all | std::filesystem::perms::others_all),
+              std::filesystem::perms::none);
+
+    mDaemon->stop();
+    EXPECT_TRUE(running.get());
+
+    close(fd);
+}
+#endif
+
+/**
+ * @brief Tests that the daemon does not run with an invalid socket path.
+ */
+TEST_F(DaemonTest, runsUnsuccessfullyWithInvalidSocketPath)
+{
+    Daemon daemon{"", std::vector<std::unique_ptr<imageProcessing::ImageProcManager>>{}, mLogger};
+
+    EXPECT_FALSE(daemon.run());
+}
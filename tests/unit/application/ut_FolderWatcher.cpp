@@ -0,0 +1,219 @@
+/**
+ * @file
+ */
+
+#include "application/FolderWatcher.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "logging/Logger.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::application;
+
+/**
+ * @brief Test class of FolderWatcher.
+ */
+class FolderWatcherTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+        mSpoolDirectory = std::filesystem::temp_directory_path() / "cs_ut_folder_watcher";
+        std::filesystem::remove_all(mSpoolDirectory);
+        std::filesystem::create_directories(mSpoolDirectory);
+
+        std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers{};
+        imageProcManagers.push_back(
+            std::make_unique<imageProcessing::ImageProcManager>(imageProcessing::ImageProcManager::create(mLogger)));
+
+        mFolderWatcher
+            = std::make_unique<FolderWatcher>(mSpoolDirectory.string(), std::move(imageProcManagers), mLogger);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        mFolderWatcher.reset();
+        std::filesystem::remove_all(mSpoolDirectory);
+    }
+
+    /**
+     * @brief Writes a file.
+     *
+     * @param filePath File path.
+     * @param content Content of the file.
+     */
+    static void writeFile(const std::filesystem::path& filePath, const std::string& content)
+    {
+        std::ofstream file{filePath, std::ios::binary};
+        file << content;
+    }
+
+    /**
+     * @brief Waits until a file exists.
+     *
+     * @param filePath File path.
+     *
+     * @return True if the file exists before the timeout, otherwise false.
+     */
+    static bool waitForFile(const std::filesystem::path& filePath)
+    {
+        for (int attempt{0}; attempt < 1000; ++attempt) {
+            if (std::filesystem::exists(filePath)) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        return false;
+    }
+
+protected:
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Spool folder. */
+    std::filesystem::path mSpoolDirectory;
+    /** Folder watcher. */
+    std::unique_ptr<FolderWatcher> mFolderWatcher;
+};
+
+/**
+ * @brief Tests that the watcher has a worker for each manager.
+ */
+TEST_F(FolderWatcherTest, hasWorkers)
+{
+    EXPECT_EQ(mFolderWatcher->getNumWorkers(), 1U);
+    EXPECT_EQ(mFolderWatcher->getSpoolDirectory(), mSpoolDirectory.string());
+}
+
+/**
+ * @brief Tests which files are candidates for processing.
+ */
+TEST_F(FolderWatcherTest, checksCandidateFiles)
+{
+    EXPECT_TRUE(FolderWatcher::isCandidateFile("circuit.png"));
+    EXPECT_FALSE(FolderWatcher::isCandidateFile(".circuit.png.part"));
+    EXPECT_FALSE(FolderWatcher::isCandidateFile(""));
+}
+
+/**
+ * @brief Tests that a file is moved, with a suffix when the name already exists in the destination folder.
+ */
+TEST_F(FolderWatcherTest, movesFile)
+{
+    const auto directory{mSpoolDirectory / "moved"};
+    std::filesystem::create_directories(directory);
+    writeFile(directory / "circuit.png", "first");
+    writeFile(mSpoolDirectory / "circuit.png", "second");
+
+    const auto movedPath{FolderWatcher::moveFile(mSpoolDirectory / "circuit.png", directory)};
+
+    EXPECT_EQ(movedPath, directory / "circuit_1.png");
+    EXPECT_TRUE(std::filesystem::exists(directory / "circuit.png"));
+    EXPECT_FALSE(std::filesystem::exists(mSpoolDirectory / "circuit.png"));
+    EXPECT_TRUE(FolderWatcher::moveFile(mSpoolDirectory / "nonexistent.png", directory).empty());
+}
+
+/**
+ * @brief Tests that the memory of an image is estimated from its header, in low-memory mode when it does not fit in
+ * the budget otherwise.
+ */
+TEST_F(FolderWatcherTest, reservesMemoryOfImage)
+{
+    const std::filesystem::path imageFilePath{std::string(TESTS_DATA_PATH) + "circuit-1.png"};
+    const imageProcessing::ImageDimensions dimensions{1100, 490};
+    const auto lowPeakMemory{imageProcessing::ImageProcManager::estimatePeakMemory(dimensions, false)};
+    auto lowMemoryMode{false};
+
+    FolderWatcher folderWatcher{mSpoolDirectory.string(),
+                                std::vector<std::unique_ptr<imageProcessing::ImageProcManager>>{},
+                                mLogger,
+                                lowPeakMemory};
+    EXPECT_EQ(folderWatcher.getMemoryBudget(), lowPeakMemory);
+
+    auto reservation{folderWatcher.reserveMemory(imageFilePath, false, lowMemoryMode)};
+    EXPECT_EQ(reservation.getBytes(), lowPeakMemory);
+    EXPECT_FALSE(lowMemoryMode);
+    reservation.release();
+
+    reservation = folderWatcher.reserveMemory(imageFilePath, true, lowMemoryMode);
+    EXPECT_EQ(reservation.getBytes(), lowPeakMemory);
+    EXPECT_FALSE(reservation.isOversized());
+    EXPECT_TRUE(lowMemoryMode);
+    reservation.release();
+
+    reservation = folderWatcher.reserveMemory(mSpoolDirectory / "nonexistent.png", false, lowMemoryMode);
+    EXPECT_TRUE(reservation.isOversized());
+    EXPECT_TRUE(lowMemoryMode);
+}
+
+/**
+ * @brief Tests that the watcher does not run with an invalid spool folder.
+ */
+TEST_F(FolderWatcherTest, runsUnsuccessfullyWithInvalidDirectory)
+{
+    FolderWatcher folderWatcher{(mSpoolDirectory / "nonexistent").string(),
+                                std::vector<std::unique_ptr<imageProcessing::ImageProcManager>>{},
+                                mLogger};
+
+    EXPECT_FALSE(folderWatcher.run());
+}
+
+/**
+ * @brief Tests that the candidate files of the spool folder are submitted once, when the folder is scanned again.
+ */
+TEST_F(FolderWatcherTest, submitsSpoolFiles)
+{
+    ASSERT_TRUE(mFolderWatcher->createDirectories());
+    writeFile(mSpoolDirectory / "invalid.png", "not an image");
+    writeFile(mSpoolDirectory / ".hidden.png", "not an image");
+
+    mFolderWatcher->submitSpoolFiles();
+    mFolderWatcher->submitSpoolFiles();
+
+    EXPECT_TRUE(waitForFile(mSpoolDirectory / FolderWatcher::cFailedDirectory / "invalid.png"));
+    mFolderWatcher.reset();
+    EXPECT_FALSE(std::filesystem::exists(mSpoolDirectory / FolderWatcher::cFailedDirectory / "invalid_1.png"));
+    EXPECT_TRUE(std::filesystem::exists(mSpoolDirectory / ".hidden.png"));
+}
+
+#ifdef __linux__
+/**
+ * @brief Tests that the images already in the folder and the images arriving are processed and moved.
+ */
+TEST_F(FolderWatcherTest, processesImagesArriving)
+{
+    // Image already in the folder
+    std::filesystem::copy_file(std::string(TESTS_DATA_PATH) + "circuit-1.png", mSpoolDirectory / "existing.png");
+
+    auto running{std::async(std::launch::async, [this]() { return mFolderWatcher->run(); })};
+
+    EXPECT_TRUE(waitForFile(mSpoolDirectory / FolderWatcher::cDoneDirectory / "existing.png"));
+    EXPECT_FALSE(std::filesystem::is_empty(mSpoolDirectory / FolderWatcher::cOutputDirectory / "existing"));
+
+    // Invalid image written with a hidden name and moved into the folder
+    writeFile(mSpoolDirectory / ".invalid.png", "not an image");
+    std::filesystem::rename(mSpoolDirectory / ".invalid.png", mSpoolDirectory / "invalid.png");
+
+    EXPECT_TRUE(waitForFile(mSpoolDirectory / FolderWatcher::cFailedDirectory / "invalid.png"));
+    EXPECT_FALSE(std::filesystem::exists(mSpoolDirectory / "invalid.png"));
+
+    mFolderWatcher->stop();
+
+    EXPECT_TRUE(running.get());
+}
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file
+ */
+
+#include "application/ImageProcManagerPool.h"
+#include "common/Task.h"
+#include "common/ThreadPool.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "logging/Logger.h"
+#include <chrono>
+#include <exception>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::application;
+
+/**
+ * @brief Test class of ImageProcManagerPool.
+ */
+class ImageProcManagerPoolTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+
+        std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers{};
+        for (std::size_t i{0}; i < cNumManagers; ++i) {
+            imageProcManagers.push_back(std::make_unique<imageProcessing::ImageProcManager>(
+                imageProcessing::ImageProcManager::create(mLogger)));
+        }
+
+        mPool = std::make_unique<ImageProcManagerPool>(std::move(imageProcManagers));
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+protected:
+    /** Number of managers in the pool. */
+    static constexpr std::size_t cNumManagers{2};
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Pool of image processing managers. */
+    std::unique_ptr<ImageProcManagerPool> mPool;
+};
+
+/**
+ * @brief Tests the size of the pool.
+ */
+TEST_F(ImageProcManagerPoolTest, hasSize)
+{
+    EXPECT_EQ(mPool->getSize(), cNumManagers);
+}
+
+/**
+ * @brief Tests that each manager is acquired by one worker at a time.
+ */
+TEST_F(ImageProcManagerPoolTest, acquiresDifferentManagers)
+{
+    auto manager1{mPool->acquire()};
+    auto manager2{mPool->acquire()};
+
+    ASSERT_NE(manager1, nullptr);
+    ASSERT_NE(manager2, nullptr);
+    EXPECT_NE(manager1.get(), manager2.get());
+
+    mPool->release(std::move(manager1));
+    mPool->release(std::move(manager2));
+}
+
+/**
+ * @brief Tests that acquiring waits until a manager is released when all are in use.
+ */
+TEST_F(ImageProcManagerPoolTest, acquireWaitsForRelease)
+{
+    auto manager1{mPool->acquire()};
+    auto manager2{mPool->acquire()};
+    const auto* releasedManager{manager2.get()};
+
+    auto acquiring{std::async(std::launch::async, [this]() { return mPool->acquire(); })};
+    EXPECT_EQ(acquiring.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+
+    mPool->release(std::move(manager2));
+
+    auto manager3{acquiring.get()};
+    EXPECT_EQ(manager3.get(), releasedManager);
+
+    mPool->release(std::move(manager1));
+    mPool->release(std::move(manager3));
+}
+
+#ifdef COROUTINES_SUPPORTED
+/**
+ * @brief Tests that a coroutine acquires an idle manager without being suspended.
+ */
+TEST_F(ImageProcManagerPoolTest, acquiresAsyncIdleManager)
+{
+    common::ThreadPool executor{1};
+
+    std::unique_ptr<imageProcessing::ImageProcManager> manager{};
+    const auto acquire{[this, &executor, &manager]() -> common::Task<bool> {
+        manager = co_await mPool->acquireAsync(executor);
+        co_return true;
+    }};
+
+    // Started and completed on this thread, as a manager is idle
+    common::startTask<bool>(
+        acquire(), [](bool) {}, [](std::exception_ptr) {});
+
+    ASSERT_NE(manager, nullptr);
+    mPool->release(std::move(manager));
+}
+
+/**
+ * @brief Tests that a coroutine acquiring asynchronously is suspended until a manager is released.
+ */
+TEST_F(ImageProcManagerPoolTest, acquireAsyncWaitsForRelease)
+{
+    common::ThreadPool executor{1};
+
+    auto manager1{mPool->acquire()};
+    auto manager2{mPool->acquire()};
+    const auto* releasedManager{manager2.get()};
+
+    // Coroutine that acquires a manager and gives it to the test
+    std::promise<std::unique_ptr<imageProcessing::ImageProcManager>> acquired{};
+    auto acquiredFuture{acquired.get_future()};
+    const auto acquire{[this, &executor, &acquired]() -> common::Task<bool> {
+        acquired.set_value(co_await mPool->acquireAsync(executor));
+        co_return true;
+    }};
+
+    common::startTask<bool>(
+        acquire(), [](bool) {}, [](std::exception_ptr) {});
+    EXPECT_EQ(acquiredFuture.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+
+    mPool->release(std::move(manager2));
+
+    auto manager3{acquiredFuture.get()};
+    EXPECT_EQ(manager3.get(), releasedManager);
+
+    mPool->release(std::move(manager1));
+    mPool->release(std::move(manager3));
+    executor.waitIdle();
+}
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file
+ */
+
+#include "application/SharedMemoryIntake.h"
+#include "application/SharedMemoryRing.h"
+#include "imageProcessing/ImageProcManager.h"
+#include "logging/Logger.h"
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::application;
+
+/**
+ * @brief Test class of SharedMemoryIntake.
+ */
+class SharedMemoryIntakeTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+
+        // The output files of the frames are written to the working directory
+        mInitialDirectory = std::filesystem::current_path();
+        mWorkingDirectory = std::filesystem::temp_directory_path() / "cs_ut_shared_memory_intake";
+        std::filesystem::remove_all(mWorkingDirectory);
+        std::filesystem::create_directories(mWorkingDirectory);
+        std::filesystem::current_path(mWorkingDirectory);
+
+        std::vector<std::unique_ptr<imageProcessing::ImageProcManager>> imageProcManagers{};
+        imageProcManagers.push_back(
+            std::make_unique<imageProcessing::ImageProcManager>(imageProcessing::ImageProcManager::create(mLogger)));
+
+        mSharedMemoryIntake = std::make_unique<SharedMemoryIntake>(cRingName, std::move(imageProcManagers), mLogger);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        mSharedMemoryIntake.reset();
+        std::filesystem::current_path(mInitialDirectory);
+        std::filesystem::remove_all(mWorkingDirectory);
+    }
+
+protected:
+    /** Name of the ring. */
+    static constexpr auto cRingName{"/cs_ut_shared_memory_intake"};
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Initial working directory. */
+    std::filesystem::path mInitialDirectory;
+    /** Working directory of the test. */
+    std::filesystem::path mWorkingDirectory;
+    /** Shared-memory intake. */
+    std::unique_ptr<SharedMemoryIntake> mSharedMemoryIntake;
+};
+
+/**
+ * @brief Tests that the intake has a worker for each manager.
+ */
+TEST_F(SharedMemoryIntakeTest, hasWorkers)
+{
+    EXPECT_EQ(mSharedMemoryIntake->getNumWorkers(), 1U);
+    EXPECT_EQ(mSharedMemoryIntake->getRingName(), cRingName);
+}
+
+/**
+ * @brief Tests that the intake does not run when the ring was not created by a producer.
+ */
+TEST_F(SharedMemoryIntakeTest, runsUnsuccessfullyWithoutRing)
+{
+    EXPECT_FALSE(mSharedMemoryIntake->run());
+}
+
+#ifdef __linux__
+/**
+ * @brief Tests that the frames published are processed, and that their slots are released back to the producer.
+ */
+TEST_F(SharedMemoryIntakeTest, processesFramesPublished)
+{
+    constexpr int width{200};
+    constexpr int height{100};
+    constexpr std::size_t stride{width * 3};
+
+    SharedMemoryRing producer{mLogger};
+    ASSERT_TRUE(producer.create(cRingName, 1, stride * height));
+
+    auto running{std::async(std::launch::async, [this]() { return mSharedMemoryIntake->run(); })};
+
+    // White frame with a black line, in the only slot
+    std::size_t slot{0};
+    ASSERT_TRUE(producer.acquireWriteSlot(1000, slot));
+    auto* pixels{producer.getSlotData(slot)};
+    std::memset(pixels, 0xFF, stride * height);
+    std::memset(pixels + stride * (height / 2), 0x00, stride);
+    ASSERT_TRUE(producer.publishFrame(slot, 7, width, height, stride, computerVision::OpenCvWrapper::PixelFormat::BGR));
+
+    // The slot is free again once the frame is no longer read
+    EXPECT_TRUE(producer.acquireWriteSlot(20000, slot));
+    EXPECT_TRUE(std::filesystem::is_directory(mWorkingDirectory / SharedMemoryIntake::cOutputDirectory / "7"));
+
+    mSharedMemoryIntake->stop();
+
+    EXPECT_TRUE(running.get());
+}
+#endif
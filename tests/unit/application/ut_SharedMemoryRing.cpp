@@ -0,0 +1,272 @@
+/**
+ * @file
+ */
+
+#include "application/SharedMemoryRing.h"
+#include "logging/Logger.h"
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::application;
+
+/**
+ * @brief Test class of SharedMemoryRing.
+ */
+class SharedMemoryRingTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+        mProducer = std::make_unique<SharedMemoryRing>(mLogger);
+        mConsumer = std::make_unique<SharedMemoryRing>(mLogger);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        mConsumer.reset();
+        mProducer.reset();
+    }
+
+protected:
+    /** Name of the ring. */
+    static constexpr auto cRingName{"/cs_ut_shared_memory_ring"};
+    /** Width of the frames. */
+    static constexpr int cWidth{4};
+    /** Height of the frames. */
+    static constexpr int cHeight{2};
+    /** Size of each row of the frames, in bytes (BGR with padding). */
+    static constexpr std::size_t cStride{16};
+
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Ring of the producer. */
+    std::unique_ptr<SharedMemoryRing> mProducer;
+    /** Ring of the consumer. */
+    std::unique_ptr<SharedMemoryRing> mConsumer;
+};
+
+/**
+ * @brief Tests that a ring that is not open has no slots.
+ */
+TEST_F(SharedMemoryRingTest, hasNoSlotsWhenNotOpen)
+{
+    EXPECT_EQ(mConsumer->getNumSlots(), 0U);
+    EXPECT_EQ(mConsumer->getSlotData(0), nullptr);
+}
+
+#ifdef __linux__
+/**
+ * @brief Tests that the ring size includes the aligned headers and slots.
+ */
+TEST_F(SharedMemoryRingTest, getsRingSize)
+{
+    const auto size{SharedMemoryRing::getRingSize(2, 100)};
+
+    EXPECT_EQ(size % SharedMemoryRing::cAlignment, 0U);
+    EXPECT_GE(size, 2 * 128 + 2 * 100);
+    EXPECT_LT(SharedMemoryRing::getRingSize(2, 100), SharedMemoryRing::getRingSize(3, 100));
+}
+
+/**
+ * @brief Tests that the consumer opens the ring created by the producer, with its layout.
+ */
+TEST_F(SharedMemoryRingTest, opensRingCreated)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 3, 1024));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+
+    EXPECT_EQ(mConsumer->getNumSlots(), 3U);
+    EXPECT_EQ(mConsumer->getSlotSize(), 1024U);
+    for (std::size_t slot{0}; slot < 3; ++slot) {
+        EXPECT_EQ(mConsumer->getSlotState(slot), SharedMemoryRing::SlotState::FREE);
+    }
+    EXPECT_EQ(mConsumer->getSlotData(3), nullptr);
+}
+
+/**
+ * @brief Tests that an invalid ring is not created, and that a ring that does not exist is not opened.
+ */
+TEST_F(SharedMemoryRingTest, failsWithInvalidRing)
+{
+    EXPECT_FALSE(mProducer->create(cRingName, 0, 1024));
+    EXPECT_FALSE(mProducer->create(cRingName, 3, 0));
+    EXPECT_FALSE(mConsumer->open(cRingName));
+}
+
+/**
+ * @brief Tests that an existing ring is only replaced when requested.
+ */
+TEST_F(SharedMemoryRingTest, replacesExistingRingOnlyWhenRequested)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 1, 64));
+
+    SharedMemoryRing other{mLogger};
+    EXPECT_FALSE(other.create(cRingName, 2, 64));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+    EXPECT_EQ(mConsumer->getNumSlots(), 1U);
+    mConsumer->close();
+
+    ASSERT_TRUE(other.create(cRingName, 2, 64, true));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+    EXPECT_EQ(mConsumer->getNumSlots(), 2U);
+}
+
+/**
+ * @brief Tests that the ring is unlinked when the producer closes it.
+ */
+TEST_F(SharedMemoryRingTest, unlinksRingWhenClosed)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 1, 64));
+    mProducer->close();
+
+    EXPECT_FALSE(mConsumer->open(cRingName));
+}
+
+/**
+ * @brief Tests that a frame published is acquired by the consumer in place, and that its slot is free once released.
+ */
+TEST_F(SharedMemoryRingTest, acquiresFrameWithoutCopying)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 2, cStride * cHeight));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+
+    // Producer
+    std::size_t writeSlot{0};
+    ASSERT_TRUE(mProducer->acquireWriteSlot(100, writeSlot));
+    EXPECT_EQ(mProducer->getSlotState(writeSlot), SharedMemoryRing::SlotState::WRITING);
+    std::memset(mProducer->getSlotData(writeSlot), 0x7F, cStride * cHeight);
+    ASSERT_TRUE(mProducer->publishFrame(
+        writeSlot, 42, cWidth, cHeight, cStride, computerVision::OpenCvWrapper::PixelFormat::BGR));
+
+    // Consumer
+    SharedMemoryFrame frame{};
+    ASSERT_TRUE(mConsumer->acquireFrame(100, frame));
+    EXPECT_EQ(frame.mSlot, writeSlot);
+    EXPECT_EQ(frame.mSequence, 42U);
+    EXPECT_EQ(frame.mImageBuffer.mData, mConsumer->getSlotData(writeSlot));
+    EXPECT_EQ(frame.mImageBuffer.mWidth, cWidth);
+    EXPECT_EQ(frame.mImageBuffer.mHeight, cHeight);
+    EXPECT_EQ(frame.mImageBuffer.mStride, cStride);
+    EXPECT_EQ(frame.mImageBuffer.mFormat, computerVision::OpenCvWrapper::PixelFormat::BGR);
+    EXPECT_EQ(frame.mImageBuffer.mData[cStride * cHeight - 1], 0x7F);
+    EXPECT_EQ(mConsumer->getSlotState(writeSlot), SharedMemoryRing::SlotState::PROCESSING);
+
+    mConsumer->releaseFrame(frame.mSlot);
+    EXPECT_EQ(mProducer->getSlotState(writeSlot), SharedMemoryRing::SlotState::FREE);
+}
+
+/**
+ * @brief Tests that the frames are acquired in order of sequence number.
+ */
+TEST_F(SharedMemoryRingTest, acquiresFramesInSequenceOrder)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 2, cStride * cHeight));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+
+    std::size_t firstSlot{0};
+    std::size_t secondSlot{0};
+    ASSERT_TRUE(mProducer->acquireWriteSlot(100, firstSlot));
+    ASSERT_TRUE(mProducer->acquireWriteSlot(100, secondSlot));
+    EXPECT_NE(firstSlot, secondSlot);
+    ASSERT_TRUE(mProducer->publishFrame(
+        firstSlot, 2, cWidth, cHeight, cStride, computerVision::OpenCvWrapper::PixelFormat::GRAY));
+    ASSERT_TRUE(mProducer->publishFrame(
+        secondSlot, 1, cWidth, cHeight, cStride, computerVision::OpenCvWrapper::PixelFormat::GRAY));
+
+    SharedMemoryFrame frame{};
+    ASSERT_TRUE(mConsumer->acquireFrame(100, frame));
+    EXPECT_EQ(frame.mSequence, 1U);
+    EXPECT_EQ(frame.mSlot, secondSlot);
+    ASSERT_TRUE(mConsumer->acquireFrame(100, frame));
+    EXPECT_EQ(frame.mSequence, 2U);
+    EXPECT_EQ(frame.mSlot, firstSlot);
+}
+
+/**
+ * @brief Tests that the producer and the consumer time out when no slot is free or ready.
+ */
+TEST_F(SharedMemoryRingTest, timesOutWithoutSlots)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 1, cStride * cHeight));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+
+    SharedMemoryFrame frame{};
+    EXPECT_FALSE(mConsumer->acquireFrame(10, frame));
+
+    std::size_t slot{0};
+    ASSERT_TRUE(mProducer->acquireWriteSlot(10, slot));
+    EXPECT_FALSE(mProducer->acquireWriteSlot(10, slot));
+}
+
+/**
+ * @brief Tests that a frame that does not fit in its slot is not published, and that the slot is released.
+ */
+TEST_F(SharedMemoryRingTest, rejectsFrameLargerThanSlot)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 1, cStride * cHeight));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+
+    std::size_t slot{0};
+    ASSERT_TRUE(mProducer->acquireWriteSlot(100, slot));
+    EXPECT_FALSE(mProducer->publishFrame(
+        slot, 0, cWidth, cHeight + 1, cStride, computerVision::OpenCvWrapper::PixelFormat::BGR));
+    EXPECT_EQ(mProducer->getSlotState(slot), SharedMemoryRing::SlotState::FREE);
+
+    // Row larger than the stride
+    ASSERT_TRUE(mProducer->acquireWriteSlot(100, slot));
+    EXPECT_FALSE(mProducer->publishFrame(
+        slot, 0, cWidth * 2, cHeight, cStride, computerVision::OpenCvWrapper::PixelFormat::BGR));
+    EXPECT_EQ(mProducer->getSlotState(slot), SharedMemoryRing::SlotState::FREE);
+
+    SharedMemoryFrame frame{};
+    EXPECT_FALSE(mConsumer->acquireFrame(10, frame));
+    EXPECT_TRUE(mProducer->acquireWriteSlot(100, slot));
+    EXPECT_FALSE(mProducer->acquireWriteSlot(10, slot));
+}
+
+/**
+ * @brief Tests that the consumer does not acquire a frame whose header is invalid, and that the slot is released.
+ */
+TEST_F(SharedMemoryRingTest, rejectsFrameWithInvalidHeader)
+{
+    ASSERT_TRUE(mProducer->create(cRingName, 1, cStride * cHeight));
+    ASSERT_TRUE(mConsumer->open(cRingName));
+
+    // Header of the only slot, just before its pixels (see the layout of the ring)
+    const auto publishCorruptFrame{[this](const std::size_t offset, const std::uint64_t value, const std::size_t size) {
+        std::size_t slot{0};
+        ASSERT_TRUE(mProducer->acquireWriteSlot(100, slot));
+        ASSERT_TRUE(mProducer->publishFrame(
+            slot, 0, cWidth, cHeight, cStride, computerVision::OpenCvWrapper::PixelFormat::BGR));
+        auto* slotHeader{mProducer->getSlotData(slot) - SharedMemoryRing::cAlignment};
+        std::memcpy(slotHeader + offset, &value, size);
+    }};
+    const std::vector<std::tuple<std::size_t, std::uint64_t, std::size_t>> corruptions{
+        {4, 5, 4},                                // Format out of range
+        {8, 0, 4},                                // No width
+        {12, static_cast<std::uint32_t>(-1), 4},  // Negative height
+        {12, cHeight + 1, 4},                     // Pixels larger than the slot
+        {16, cWidth * 3 - 1, 8},                  // Row larger than the stride
+        {16, cStride * cHeight * 1000000ULL, 8}}; // Stride larger than the slot
+
+    for (const auto& [offset, value, size] : corruptions) {
+        publishCorruptFrame(offset, value, size);
+
+        SharedMemoryFrame frame{};
+        EXPECT_FALSE(mConsumer->acquireFrame(100, frame));
+        EXPECT_EQ(mProducer->getSlotState(0), SharedMemoryRing::SlotState::FREE);
+    }
+}
+#endif
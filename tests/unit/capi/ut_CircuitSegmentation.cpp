@@ -0,0 +1,220 @@
+/**
+ * @file
+ */
+
+#include "CircuitSegmentation.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Test class of the C API.
+ */
+class CircuitSegmentationTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        std::filesystem::create_directories(mOutputDirectory);
+
+        cs_pipeline_options options{};
+        cs_pipeline_options_init(&options);
+        options.output_directory = mOutputDirectory.c_str();
+
+        mPipeline = cs_pipeline_create(&options);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        cs_pipeline_destroy(mPipeline);
+        std::filesystem::remove_all(mOutputDirectory);
+    }
+
+protected:
+    /** Existent image file path to be used in tests. */
+    const std::string cExistentImageFilePath{std::string(TESTS_DATA_PATH) + "circuit-1.png"};
+
+    /** Directory where the output files are written. */
+    const std::string mOutputDirectory{(std::filesystem::temp_directory_path() / "cs_ut_capi").string()};
+    /** Pipeline. */
+    cs_pipeline* mPipeline{nullptr};
+};
+
+/**
+ * @brief Tests the version of the C API.
+ */
+TEST_F(CircuitSegmentationTest, hasApiVersion)
+{
+    EXPECT_EQ(cs_api_version(), static_cast<unsigned int>(CS_API_VERSION));
+}
+
+/**
+ * @brief Tests the default options.
+ */
+TEST_F(CircuitSegmentationTest, initializesOptions)
+{
+    cs_pipeline_options options{};
+    options.run_mode = CS_RUN_MODE_BATCH;
+    options.verbose = 1;
+
+    cs_pipeline_options_init(&options);
+
+    EXPECT_EQ(options.run_mode, CS_RUN_MODE_SINGLE_IMAGE);
+    EXPECT_EQ(options.num_writer_threads, 0U);
+    EXPECT_EQ(options.verbose, 0);
+    EXPECT_EQ(options.save_images, 0);
+    EXPECT_EQ(options.output_directory, nullptr);
+    EXPECT_EQ(options.write_files, 1);
+    EXPECT_EQ(options.encode_rois, 0);
+}
+
+/**
+ * @brief Tests that a pipeline is created with the default options.
+ */
+TEST_F(CircuitSegmentationTest, createsPipelineWithDefaultOptions)
+{
+    ASSERT_NE(mPipeline, nullptr);
+
+    auto pipeline{cs_pipeline_create(nullptr)};
+
+    EXPECT_NE(pipeline, nullptr);
+
+    cs_pipeline_destroy(pipeline);
+    cs_pipeline_destroy(nullptr);
+}
+
+/**
+ * @brief Tests that invalid arguments are rejected.
+ */
+TEST_F(CircuitSegmentationTest, rejectsInvalidArguments)
+{
+    const std::vector<unsigned char> pixels(3, 0);
+    const cs_result* result{nullptr};
+
+    EXPECT_EQ(cs_pipeline_process_encoded(nullptr, pixels.data(), pixels.size(), &result),
+              CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(cs_pipeline_process_encoded(mPipeline, nullptr, pixels.size(), &result), CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(cs_pipeline_process_encoded(mPipeline, pixels.data(), 0, &result), CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(cs_pipeline_process_encoded(mPipeline, pixels.data(), pixels.size(), nullptr),
+              CS_STATUS_INVALID_ARGUMENT);
+
+    EXPECT_EQ(cs_pipeline_process_raw(mPipeline, nullptr, 1, 1, 3, CS_PIXEL_FORMAT_BGR, &result),
+              CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(cs_pipeline_process_raw(mPipeline, pixels.data(), 0, 1, 3, CS_PIXEL_FORMAT_BGR, &result),
+              CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(
+        cs_pipeline_process_raw(mPipeline, pixels.data(), 1, 1, 3, static_cast<cs_pixel_format>(9), &result),
+        CS_STATUS_INVALID_ARGUMENT);
+
+    EXPECT_EQ(cs_pipeline_set_timeout(nullptr, 100), CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(cs_pipeline_cancel(nullptr), CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(cs_pipeline_set_preset(nullptr, CS_PRESET_FAST), CS_STATUS_INVALID_ARGUMENT);
+    EXPECT_EQ(cs_pipeline_set_preset(mPipeline, static_cast<cs_preset>(9)), CS_STATUS_INVALID_ARGUMENT);
+
+    EXPECT_EQ(result, nullptr);
+    EXPECT_STRNE(cs_pipeline_last_error(mPipeline), "");
+}
+
+/**
+ * @brief Tests that an image is processed successfully within its timeout, and that a cancellation requested before
+ * the processing does not stop it.
+ */
+TEST_F(CircuitSegmentationTest, processesEncodedImageWithinTimeout)
+{
+    std::ifstream file{cExistentImageFilePath, std::ios::binary};
+    const std::vector<unsigned char> data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    const cs_result* result{nullptr};
+
+    ASSERT_EQ(cs_pipeline_set_timeout(mPipeline, 60000), CS_STATUS_OK);
+    ASSERT_EQ(cs_pipeline_cancel(mPipeline), CS_STATUS_OK);
+
+    EXPECT_EQ(cs_pipeline_process_encoded(mPipeline, data.data(), data.size(), &result), CS_STATUS_OK);
+    EXPECT_NE(result, nullptr);
+}
+
+/**
+ * @brief Tests that the presets are set.
+ */
+TEST_F(CircuitSegmentationTest, setsPresets)
+{
+    EXPECT_EQ(cs_pipeline_set_preset(mPipeline, CS_PRESET_FAST), CS_STATUS_OK);
+    EXPECT_EQ(cs_pipeline_set_preset(mPipeline, CS_PRESET_ACCURATE), CS_STATUS_OK);
+    EXPECT_EQ(cs_pipeline_set_preset(mPipeline, CS_PRESET_BALANCED), CS_STATUS_OK);
+}
+
+/**
+ * @brief Tests that an invalid encoded image is not processed.
+ */
+TEST_F(CircuitSegmentationTest, processesEncodedImageUnsuccessfully)
+{
+    const std::vector<unsigned char> data{'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'};
+    const cs_result* result{nullptr};
+
+    EXPECT_EQ(cs_pipeline_process_encoded(mPipeline, data.data(), data.size(), &result),
+              CS_STATUS_PROCESSING_FAILED);
+    EXPECT_EQ(result, nullptr);
+    EXPECT_STRNE(cs_pipeline_last_error(mPipeline), "");
+}
+
+/**
+ * @brief Tests that an encoded image is processed.
+ */
+TEST_F(CircuitSegmentationTest, processesEncodedImageSuccessfully)
+{
+    std::ifstream file{cExistentImageFilePath, std::ios::binary};
+    const std::vector<unsigned char> data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    const cs_result* result{nullptr};
+
+    ASSERT_EQ(cs_pipeline_process_encoded(mPipeline, data.data(), data.size(), &result), CS_STATUS_OK);
+    ASSERT_NE(result, nullptr);
+    EXPECT_STREQ(cs_pipeline_last_error(mPipeline), "");
+
+    EXPECT_EQ(std::string(result->segmentation_map).size(), result->segmentation_map_size);
+    EXPECT_GT(result->num_rois, 0U);
+    for (std::size_t i{0}; i < result->num_rois; ++i) {
+        EXPECT_NE(result->rois[i].element_id, nullptr);
+        EXPECT_GT(result->rois[i].width, 0);
+        EXPECT_GT(result->rois[i].height, 0);
+        EXPECT_EQ(result->rois[i].image, nullptr);
+    }
+}
+
+/**
+ * @brief Tests that an encoded image is processed in memory, with the images of the regions of interest encoded and
+ * without writing files.
+ */
+TEST_F(CircuitSegmentationTest, processesEncodedImageInMemory)
+{
+    cs_pipeline_options options{};
+    cs_pipeline_options_init(&options);
+    options.output_directory = mOutputDirectory.c_str();
+    options.write_files = 0;
+    options.encode_rois = 1;
+    auto pipeline{cs_pipeline_create(&options)};
+    ASSERT_NE(pipeline, nullptr);
+
+    std::ifstream file{cExistentImageFilePath, std::ios::binary};
+    const std::vector<unsigned char> data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    const cs_result* result{nullptr};
+
+    ASSERT_EQ(cs_pipeline_process_encoded(pipeline, data.data(), data.size(), &result), CS_STATUS_OK);
+    ASSERT_NE(result, nullptr);
+
+    EXPECT_GT(result->num_rois, 0U);
+    for (std::size_t i{0}; i < result->num_rois; ++i) {
+        EXPECT_NE(result->rois[i].image, nullptr);
+        EXPECT_GT(result->rois[i].image_size, 0U);
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(mOutputDirectory));
+
+    cs_pipeline_destroy(pipeline);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file
+ */
+
+#include "common/CancellationToken.h"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of CancellationToken.
+ */
+class CancellationTokenTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override {}
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        common::CancellationToken::setCurrent(nullptr);
+    }
+
+protected:
+    /** Cancellation token. */
+    common::CancellationToken mToken{};
+};
+
+/**
+ * @brief Tests that a new token is active.
+ */
+TEST_F(CancellationTokenTest, isActiveWhenCreated)
+{
+    EXPECT_EQ(mToken.getState(), common::CancellationToken::State::ACTIVE);
+    EXPECT_FALSE(mToken.isStopped());
+}
+
+/**
+ * @brief Tests that a cancelled token is stopped.
+ */
+TEST_F(CancellationTokenTest, isStoppedWhenCancelled)
+{
+    mToken.cancel();
+
+    EXPECT_EQ(mToken.getState(), common::CancellationToken::State::CANCELLED);
+    EXPECT_TRUE(mToken.isStopped());
+}
+
+/**
+ * @brief Tests that a token is stopped when its deadline expires, and not before.
+ */
+TEST_F(CancellationTokenTest, isStoppedWhenDeadlineExpires)
+{
+    mToken.setTimeout(std::chrono::hours(1));
+    EXPECT_EQ(mToken.getState(), common::CancellationToken::State::ACTIVE);
+
+    mToken.setDeadline(common::CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+    EXPECT_EQ(mToken.getState(), common::CancellationToken::State::DEADLINE_EXCEEDED);
+    EXPECT_TRUE(mToken.isStopped());
+}
+
+/**
+ * @brief Tests that cancellation takes precedence over the deadline.
+ */
+TEST_F(CancellationTokenTest, reportsCancellationBeforeDeadline)
+{
+    mToken.setDeadline(common::CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+    mToken.cancel();
+
+    EXPECT_EQ(mToken.getState(), common::CancellationToken::State::CANCELLED);
+}
+
+/**
+ * @brief Tests that a token is active after being reset, and that a zero timeout removes the deadline.
+ */
+TEST_F(CancellationTokenTest, isActiveWhenReset)
+{
+    mToken.cancel();
+    mToken.reset();
+    EXPECT_EQ(mToken.getState(), common::CancellationToken::State::ACTIVE);
+
+    mToken.setDeadline(common::CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+    mToken.setTimeout(std::chrono::milliseconds(0));
+    EXPECT_EQ(mToken.getState(), common::CancellationToken::State::ACTIVE);
+}
+
+/**
+ * @brief Tests that the current token is set per thread.
+ */
+TEST_F(CancellationTokenTest, setsCurrentTokenPerThread)
+{
+    EXPECT_FALSE(common::CancellationToken::isCurrentStopped());
+
+    mToken.cancel();
+    common::CancellationToken::setCurrent(&mToken);
+    EXPECT_EQ(common::CancellationToken::getCurrent(), &mToken);
+    EXPECT_TRUE(common::CancellationToken::isCurrentStopped());
+
+    auto otherThreadStopped{true};
+    std::thread thread{[&otherThreadStopped]() {
+        otherThreadStopped = common::CancellationToken::isCurrentStopped();
+    }};
+    thread.join();
+    EXPECT_FALSE(otherThreadStopped);
+}
+
+/**
+ * @brief Tests that a token cancelled by another thread is seen stopped.
+ */
+TEST_F(CancellationTokenTest, isCancelledByOtherThread)
+{
+    std::thread thread{[this]() { mToken.cancel(); }};
+    thread.join();
+
+    EXPECT_TRUE(mToken.isStopped());
+}
@@ -0,0 +1,108 @@
+/**
+ * @file
+ */
+
+#include "common/ContentHash.h"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of ContentHash.
+ */
+class ContentHashTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mContent.resize(1000);
+        std::iota(mContent.begin(), mContent.end(), static_cast<unsigned char>(0));
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+    /**
+     * @brief Hashes content in one piece.
+     *
+     * @param content Content.
+     *
+     * @return Digest.
+     */
+    static std::uint64_t hash(const std::vector<unsigned char>& content)
+    {
+        common::ContentHash contentHash{};
+        contentHash.update(content.data(), content.size());
+
+        return contentHash.getDigest();
+    }
+
+protected:
+    /** Content to hash. */
+    std::vector<unsigned char> mContent{};
+};
+
+/**
+ * @brief Tests that the digest does not depend on how the content is split in pieces.
+ */
+TEST_F(ContentHashTest, hashesContentInPieces)
+{
+    for (const std::size_t pieceSize : {1U, 3U, 8U, 13U, 100U}) {
+        common::ContentHash contentHash{};
+        for (std::size_t offset{0}; offset < mContent.size(); offset += pieceSize) {
+            contentHash.update(mContent.data() + offset, std::min(pieceSize, mContent.size() - offset));
+        }
+
+        EXPECT_EQ(contentHash.getDigest(), hash(mContent));
+    }
+}
+
+/**
+ * @brief Tests that different content has different digests, including content of different sizes.
+ */
+TEST_F(ContentHashTest, hashesDifferentContentDifferently)
+{
+    const auto digest{hash(mContent)};
+
+    auto changedContent{mContent};
+    changedContent[500] ^= 0x01;
+    EXPECT_NE(hash(changedContent), digest);
+
+    auto longerContent{mContent};
+    longerContent.push_back(0);
+    EXPECT_NE(hash(longerContent), digest);
+
+    EXPECT_NE(hash(std::vector<unsigned char>(7, 0)), hash(std::vector<unsigned char>(8, 0)));
+}
+
+/**
+ * @brief Tests that the seed changes the digest.
+ */
+TEST_F(ContentHashTest, hashesWithSeed)
+{
+    common::ContentHash contentHash{1};
+    contentHash.update(mContent.data(), mContent.size());
+
+    EXPECT_NE(contentHash.getDigest(), hash(mContent));
+}
+
+/**
+ * @brief Tests that the digest in hexadecimal has 16 digits.
+ */
+TEST_F(ContentHashTest, getsHexDigest)
+{
+    common::ContentHash contentHash{};
+
+    const auto hexDigest{contentHash.getHexDigest()};
+
+    EXPECT_EQ(hexDigest.size(), 16U);
+    EXPECT_EQ(std::stoull(hexDigest, nullptr, 16), contentHash.getDigest());
+}
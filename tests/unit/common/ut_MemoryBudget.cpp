@@ -0,0 +1,188 @@
+/**
+ * @file
+ */
+
+#include "common/MemoryBudget.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <utility>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of MemoryBudget.
+ */
+class MemoryBudgetTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override {}
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+protected:
+    /** Budget of memory, in bytes. */
+    static constexpr std::size_t cBudget{1000};
+
+    /** Time to wait for a job that should not be admitted. */
+    static constexpr std::chrono::milliseconds cWaitTime{50};
+
+    /** Memory budget. */
+    common::MemoryBudget mMemoryBudget{cBudget};
+};
+
+/**
+ * @brief Tests that the jobs fitting in the budget are admitted, and that their memory is released.
+ */
+TEST_F(MemoryBudgetTest, admitsJobsWithinBudget)
+{
+    {
+        const auto first{mMemoryBudget.reserve(400)};
+        const auto second{mMemoryBudget.reserve(600)};
+
+        EXPECT_EQ(mMemoryBudget.getReservedBytes(), 1000U);
+        EXPECT_FALSE(first.isOversized());
+        EXPECT_EQ(second.getBytes(), 600U);
+    }
+
+    EXPECT_EQ(mMemoryBudget.getReservedBytes(), 0U);
+}
+
+/**
+ * @brief Tests that a job exceeding the remaining budget waits until memory is released.
+ */
+TEST_F(MemoryBudgetTest, waitsForMemoryReleased)
+{
+    auto first{mMemoryBudget.reserve(800)};
+    std::atomic<bool> admitted{false};
+
+    std::thread thread{[this, &admitted]() {
+        const auto second{mMemoryBudget.reserve(400)};
+        admitted = true;
+    }};
+
+    std::this_thread::sleep_for(cWaitTime);
+    EXPECT_FALSE(admitted);
+
+    first.release();
+    thread.join();
+    EXPECT_TRUE(admitted);
+    EXPECT_EQ(mMemoryBudget.getReservedBytes(), 0U);
+}
+
+/**
+ * @brief Tests that an oversized job is admitted alone.
+ */
+TEST_F(MemoryBudgetTest, admitsOversizedJobAlone)
+{
+    EXPECT_TRUE(mMemoryBudget.isOversized(cBudget + 1));
+    EXPECT_FALSE(mMemoryBudget.isOversized(cBudget));
+
+    auto small{mMemoryBudget.reserve(100)};
+    std::atomic<bool> oversizedAdmitted{false};
+
+    std::thread thread{[this, &oversizedAdmitted]() {
+        const auto oversized{mMemoryBudget.reserve(cBudget * 2)};
+        EXPECT_TRUE(oversized.isOversized());
+        oversizedAdmitted = true;
+    }};
+
+    std::this_thread::sleep_for(cWaitTime);
+    EXPECT_FALSE(oversizedAdmitted);
+
+    small.release();
+    thread.join();
+    EXPECT_TRUE(oversizedAdmitted);
+}
+
+/**
+ * @brief Tests that no job is admitted while an oversized job is running.
+ */
+TEST_F(MemoryBudgetTest, admitsNoJobWithOversizedJob)
+{
+    auto oversized{mMemoryBudget.reserve(cBudget * 2)};
+    std::atomic<bool> admitted{false};
+
+    std::thread thread{[this, &admitted]() {
+        const auto small{mMemoryBudget.reserve(1)};
+        admitted = true;
+    }};
+
+    std::this_thread::sleep_for(cWaitTime);
+    EXPECT_FALSE(admitted);
+
+    oversized.release();
+    thread.join();
+    EXPECT_TRUE(admitted);
+}
+
+/**
+ * @brief Tests that the jobs are admitted in the order of arrival, so a waiting job is not overtaken by smaller ones.
+ */
+TEST_F(MemoryBudgetTest, admitsJobsInOrderOfArrival)
+{
+    auto first{mMemoryBudget.reserve(600)};
+    std::atomic<bool> largeAdmitted{false};
+    std::atomic<bool> smallAdmitted{false};
+
+    std::thread largeThread{[this, &largeAdmitted]() {
+        const auto large{mMemoryBudget.reserve(800)};
+        largeAdmitted = true;
+    }};
+    std::this_thread::sleep_for(cWaitTime);
+
+    // Fits in the remaining budget, but arrives after the large job
+    std::thread smallThread{[this, &smallAdmitted]() {
+        const auto small{mMemoryBudget.reserve(100)};
+        smallAdmitted = true;
+    }};
+    std::this_thread::sleep_for(cWaitTime);
+    EXPECT_FALSE(largeAdmitted);
+    EXPECT_FALSE(smallAdmitted);
+
+    first.release();
+    largeThread.join();
+    smallThread.join();
+    EXPECT_TRUE(largeAdmitted);
+    EXPECT_TRUE(smallAdmitted);
+}
+
+/**
+ * @brief Tests that all the jobs are admitted immediately without budget.
+ */
+TEST_F(MemoryBudgetTest, admitsAllJobsWithoutBudget)
+{
+    common::MemoryBudget memoryBudget{};
+
+    const auto first{memoryBudget.reserve(1'000'000'000)};
+    const auto second{memoryBudget.reserve(1'000'000'000)};
+
+    EXPECT_FALSE(first.isOversized());
+    EXPECT_EQ(memoryBudget.getReservedBytes(), 2'000'000'000U);
+}
+
+/**
+ * @brief Tests that a reservation moved is released once.
+ */
+TEST_F(MemoryBudgetTest, movesReservation)
+{
+    auto first{mMemoryBudget.reserve(300)};
+    auto second{std::move(first)};
+    EXPECT_EQ(mMemoryBudget.getReservedBytes(), 300U);
+
+    common::MemoryBudget::Reservation third{};
+    third = std::move(second);
+    EXPECT_EQ(third.getBytes(), 300U);
+    EXPECT_EQ(mMemoryBudget.getReservedBytes(), 300U);
+
+    third.release();
+    EXPECT_EQ(mMemoryBudget.getReservedBytes(), 0U);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file
+ */
+
+#include "common/Preset.h"
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Tests that the names of the presets are parsed.
+ */
+TEST(PresetTest, parsesPresetNames)
+{
+    auto preset{common::Preset::BALANCED};
+
+    EXPECT_TRUE(common::parsePreset("fast", preset));
+    EXPECT_EQ(preset, common::Preset::FAST);
+    EXPECT_TRUE(common::parsePreset("accurate", preset));
+    EXPECT_EQ(preset, common::Preset::ACCURATE);
+    EXPECT_TRUE(common::parsePreset("balanced", preset));
+    EXPECT_EQ(preset, common::Preset::BALANCED);
+}
+
+/**
+ * @brief Tests that invalid names of presets are not parsed, and the preset is not changed.
+ */
+TEST(PresetTest, failsParsingInvalidNames)
+{
+    auto preset{common::Preset::FAST};
+
+    EXPECT_FALSE(common::parsePreset("", preset));
+    EXPECT_FALSE(common::parsePreset("Fast", preset));
+    EXPECT_FALSE(common::parsePreset("fastest", preset));
+    EXPECT_EQ(preset, common::Preset::FAST);
+}
+
+/**
+ * @brief Tests that the name of each preset is parsed back to the preset.
+ */
+TEST(PresetTest, getsPresetNames)
+{
+    for (const auto expected : {common::Preset::FAST, common::Preset::BALANCED, common::Preset::ACCURATE}) {
+        auto preset{common::Preset::BALANCED};
+        EXPECT_TRUE(common::parsePreset(common::getPresetName(expected), preset));
+        EXPECT_EQ(preset, expected);
+    }
+}
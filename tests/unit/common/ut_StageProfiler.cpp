@@ -0,0 +1,70 @@
+/**
+ * @file
+ */
+
+#include "common/StageProfiler.h"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Tests that the usage of a stage has its name and non-negative times.
+ */
+TEST(StageProfilerTest, measuresStage)
+{
+    common::StageProfiler profiler{1};
+
+    profiler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    const auto usage{profiler.stop("stage")};
+
+    EXPECT_EQ("stage", usage.mName);
+    EXPECT_GE(usage.mWallTimeMs, 20.0);
+    EXPECT_GE(usage.mCpuTimeMs, 0.0);
+    EXPECT_GE(usage.mProcessCpuTimeMs, 0.0);
+    EXPECT_GE(usage.mProcessUtilization, 0.0);
+}
+
+/**
+ * @brief Tests that a stage that keeps one core busy has a CPU utilization close to one core.
+ */
+TEST(StageProfilerTest, measuresBusyStage)
+{
+    constexpr unsigned int numCores{2};
+    common::StageProfiler profiler{numCores};
+
+    profiler.start();
+    const auto end{std::chrono::steady_clock::now() + std::chrono::milliseconds{100}};
+    while (std::chrono::steady_clock::now() < end) {
+    }
+    const auto usage{profiler.stop("busy")};
+
+    EXPECT_EQ(numCores, profiler.getNumCores());
+    EXPECT_GT(usage.mCpuTimeMs, 0.0);
+    EXPECT_GE(usage.mProcessCpuTimeMs, usage.mCpuTimeMs - 1.0);
+    EXPECT_LE(usage.mProcessUtilization, 100.0 / numCores + 10.0);
+}
+
+/**
+ * @brief Tests that the CPU time of the stage excludes the work of the other threads, which is only in the CPU time
+ * of the process.
+ */
+TEST(StageProfilerTest, measuresOnlyThreadOfStage)
+{
+    common::StageProfiler profiler{2};
+
+    profiler.start();
+    std::thread otherThread{[]() {
+        const auto end{std::chrono::steady_clock::now() + std::chrono::milliseconds{100}};
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }};
+    otherThread.join();
+    const auto usage{profiler.stop("waiting")};
+
+    EXPECT_LT(usage.mCpuTimeMs, 50.0);
+    EXPECT_GT(usage.mProcessCpuTimeMs, 50.0);
+}
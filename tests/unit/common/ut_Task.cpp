@@ -0,0 +1,168 @@
+/**
+ * @file
+ */
+
+#include "common/Task.h"
+#include "common/ThreadPool.h"
+#include <gtest/gtest.h>
+
+#ifdef COROUTINES_SUPPORTED
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of Task.
+ */
+class TaskTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mThreadPool = std::make_unique<common::ThreadPool>(cNumThreads);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+    /**
+     * @brief Starts a task and waits for its value.
+     *
+     * @param task Task.
+     *
+     * @return Value of the task.
+     */
+    static int runTask(common::Task<int> task)
+    {
+        std::promise<int> result{};
+
+        common::startTask<int>(
+            std::move(task),
+            [&result](int value) { result.set_value(value); },
+            [&result](std::exception_ptr exception) { result.set_exception(exception); });
+
+        return result.get_future().get();
+    }
+
+    /**
+     * @brief Coroutine that resumes on the thread pool and returns a value.
+     *
+     * @param executor Executor.
+     * @param value Value.
+     * @param threadId ID of the thread where the coroutine is resumed.
+     *
+     * @return Task with the value.
+     */
+    static common::Task<int> scheduledValue(common::Executor& executor, int value, std::thread::id& threadId)
+    {
+        co_await common::schedule(executor);
+        threadId = std::this_thread::get_id();
+
+        co_return value;
+    }
+
+protected:
+    /** Number of threads of the pool. */
+    static constexpr unsigned int cNumThreads{2};
+
+    /** Thread pool, used as executor. */
+    std::unique_ptr<common::ThreadPool> mThreadPool;
+};
+
+/**
+ * @brief Tests that the value of a task is given to the completion callback.
+ */
+TEST_F(TaskTest, completesWithValue)
+{
+    const auto task{[]() -> common::Task<int> { co_return 42; }};
+
+    EXPECT_EQ(runTask(task()), 42);
+}
+
+/**
+ * @brief Tests that a task is resumed on a thread of the executor after scheduling.
+ */
+TEST_F(TaskTest, resumesOnExecutor)
+{
+    std::thread::id threadId{};
+
+    EXPECT_EQ(runTask(scheduledValue(*mThreadPool, 7, threadId)), 7);
+    EXPECT_NE(threadId, std::this_thread::get_id());
+}
+
+/**
+ * @brief Tests that a task awaits the value of other tasks.
+ */
+TEST_F(TaskTest, awaitsNestedTasks)
+{
+    std::thread::id threadId{};
+    const auto task{[&threadId](common::Executor& executor) -> common::Task<int> {
+        const auto first{co_await scheduledValue(executor, 1, threadId)};
+        const auto second{co_await scheduledValue(executor, 2, threadId)};
+        co_return first + second;
+    }};
+
+    EXPECT_EQ(runTask(task(*mThreadPool)), 3);
+}
+
+/**
+ * @brief Tests that an exception thrown by a task is given to the failure callback.
+ */
+TEST_F(TaskTest, failsWithException)
+{
+    const auto task{[](common::Executor& executor) -> common::Task<int> {
+        co_await common::schedule(executor);
+        throw std::runtime_error{"failure"};
+        co_return 0;
+    }};
+
+    EXPECT_THROW(runTask(task(*mThreadPool)), std::runtime_error);
+}
+
+/**
+ * @brief Tests that many tasks are multiplexed over the few threads of the executor.
+ */
+TEST_F(TaskTest, multiplexesTasksOnExecutor)
+{
+    constexpr auto numTasks{1000};
+    std::atomic<int> sum{0};
+    std::atomic<int> completedTasks{0};
+    std::promise<void> allCompleted{};
+
+    const auto task{[](common::Executor& executor, int value) -> common::Task<int> {
+        for (auto i{0}; i < 3; ++i) {
+            co_await common::schedule(executor);
+        }
+        co_return value;
+    }};
+
+    for (auto i{0}; i < numTasks; ++i) {
+        common::startTask<int>(
+            task(*mThreadPool, i),
+            [&](int value) {
+                sum += value;
+                if (++completedTasks == numTasks) {
+                    allCompleted.set_value();
+                }
+            },
+            [](std::exception_ptr) {});
+    }
+
+    allCompleted.get_future().wait();
+    EXPECT_EQ(sum, numTasks * (numTasks - 1) / 2);
+}
+
+#endif
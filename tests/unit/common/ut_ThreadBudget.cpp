@@ -0,0 +1,140 @@
+/**
+ * @file
+ */
+
+#include "common/ThreadBudget.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of ThreadBudget.
+ */
+class ThreadBudgetTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override {}
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+protected:
+    /** Number of cores for the tests. */
+    static constexpr unsigned int cNumCores{8};
+};
+
+/**
+ * @brief Tests that in single image mode there is one application worker and OpenCV uses all the cores.
+ */
+TEST_F(ThreadBudgetTest, splitsCoresInSingleImageMode)
+{
+    const common::ThreadBudget threadBudget{common::ThreadBudget::RunMode::SINGLE_IMAGE, 0, false, cNumCores};
+
+    EXPECT_EQ(common::ThreadBudget::RunMode::SINGLE_IMAGE, threadBudget.getRunMode());
+    EXPECT_EQ(cNumCores, threadBudget.getNumCores());
+    EXPECT_EQ(1U, threadBudget.getNumAppWorkers());
+    EXPECT_EQ(cNumCores, threadBudget.getNumOpenCvThreads());
+}
+
+/**
+ * @brief Tests that in batch mode there is one application worker per core and OpenCV runs serially.
+ */
+TEST_F(ThreadBudgetTest, splitsCoresInBatchMode)
+{
+    const common::ThreadBudget threadBudget{common::ThreadBudget::RunMode::BATCH, 0, false, cNumCores};
+
+    EXPECT_EQ(common::ThreadBudget::RunMode::BATCH, threadBudget.getRunMode());
+    EXPECT_EQ(cNumCores, threadBudget.getNumAppWorkers());
+    EXPECT_EQ(1U, threadBudget.getNumOpenCvThreads());
+}
+
+/**
+ * @brief Tests that the number of threads for writing images is the default when it is not specified.
+ */
+TEST_F(ThreadBudgetTest, hasNumWriterThreads)
+{
+    constexpr unsigned int numWriterThreads{4};
+    const common::ThreadBudget threadBudgetDefault{};
+    const common::ThreadBudget threadBudget{common::ThreadBudget::RunMode::SINGLE_IMAGE, numWriterThreads};
+
+    EXPECT_EQ(common::ThreadBudget::cNumWriterThreadsDefault, threadBudgetDefault.getNumWriterThreads());
+    EXPECT_EQ(numWriterThreads, threadBudget.getNumWriterThreads());
+}
+
+/**
+ * @brief Tests that the cores are detected when the number of cores is not specified.
+ */
+TEST_F(ThreadBudgetTest, detectsNumCores)
+{
+    const common::ThreadBudget threadBudget{};
+
+    EXPECT_GE(threadBudget.getNumCores(), 1U);
+    EXPECT_EQ(common::ThreadBudget::detectNumCores(), threadBudget.getNumCores());
+}
+
+/**
+ * @brief Tests that the calling thread is not pinned when pinning is disabled.
+ */
+TEST_F(ThreadBudgetTest, doesNotPinWhenDisabled)
+{
+    const common::ThreadBudget threadBudget{common::ThreadBudget::RunMode::BATCH, 0, false};
+
+    EXPECT_FALSE(threadBudget.getPinThreads());
+    EXPECT_FALSE(threadBudget.pinCurrentThread(0));
+    EXPECT_FALSE(threadBudget.getWorkerPinning());
+}
+
+#ifdef __linux__
+/**
+ * @brief Tests that the calling thread is pinned when pinning is enabled.
+ */
+TEST_F(ThreadBudgetTest, pinsWhenEnabled)
+{
+    const common::ThreadBudget threadBudget{common::ThreadBudget::RunMode::BATCH, 0, true};
+
+    // Pin a new thread, so the affinity of the test thread is not changed
+    auto pinned{false};
+    std::thread thread{[&threadBudget, &pinned]() { pinned = threadBudget.pinCurrentThread(0); }};
+    thread.join();
+
+    EXPECT_TRUE(threadBudget.getPinThreads());
+    EXPECT_TRUE(pinned);
+}
+
+/**
+ * @brief Tests that the worker pinning pins each thread to the core of its index, without pinning the creator.
+ */
+TEST_F(ThreadBudgetTest, pinsWorkersToOwnCores)
+{
+    const common::ThreadBudget threadBudget{common::ThreadBudget::RunMode::BATCH, 0, true, 2};
+    const auto workerPinning{threadBudget.getWorkerPinning()};
+    ASSERT_TRUE(workerPinning);
+
+    auto core{-1};
+    std::thread thread{[&workerPinning, &core]() {
+        workerPinning(1);
+        cpu_set_t cpuSet{};
+        if (pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0 && CPU_COUNT(&cpuSet) == 1) {
+            core = CPU_ISSET(1, &cpuSet) ? 1 : 0;
+        }
+    }};
+    thread.join();
+
+    // Only if the machine has a second core to pin to
+    if (common::ThreadBudget::detectNumCores() > 1) {
+        EXPECT_EQ(core, 1);
+    }
+}
+#endif
@@ -0,0 +1,229 @@
+/**
+ * @file
+ */
+
+#include "common/CancellationToken.h"
+#include "common/ThreadPool.h"
+#include "logging/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of ThreadPool.
+ */
+class ThreadPoolTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mThreadPool = std::make_unique<common::ThreadPool>(cNumThreads);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+protected:
+    /** Number of threads of the pool. */
+    static constexpr unsigned int cNumThreads{2};
+
+    /** Thread pool. */
+    std::unique_ptr<common::ThreadPool> mThreadPool;
+};
+
+/**
+ * @brief Tests that the pool has the number of threads requested.
+ */
+TEST_F(ThreadPoolTest, hasNumThreads)
+{
+    EXPECT_EQ(mThreadPool->getNumThreads(), cNumThreads);
+}
+
+/**
+ * @brief Tests that the pool has at least one thread, even when zero threads are requested.
+ */
+TEST_F(ThreadPoolTest, hasAtLeastOneThread)
+{
+    common::ThreadPool threadPool{0};
+
+    EXPECT_EQ(threadPool.getNumThreads(), 1U);
+}
+
+/**
+ * @brief Tests that the result of a submitted task is available through its future.
+ */
+TEST_F(ThreadPoolTest, returnsResultOfTask)
+{
+    auto future{mThreadPool->submit([]() { return 42; })};
+
+    EXPECT_EQ(future.get(), 42);
+}
+
+/**
+ * @brief Tests that all the submitted tasks are executed when waiting for the pool to be idle.
+ */
+TEST_F(ThreadPoolTest, executesAllTasksWhenWaitingIdle)
+{
+    constexpr auto numTasks{100};
+    std::atomic<int> executedTasks{0};
+
+    for (auto i{0}; i < numTasks; ++i) {
+        mThreadPool->submit([&executedTasks]() { ++executedTasks; });
+    }
+
+    mThreadPool->waitIdle();
+
+    EXPECT_EQ(executedTasks, numTasks);
+}
+
+/**
+ * @brief Tests that the tasks are executed concurrently by the threads of the pool.
+ *
+ * Scenario: two tasks wait for each other, which is only possible if they run at the same time.
+ * Expected: both tasks complete.
+ */
+TEST_F(ThreadPoolTest, executesTasksConcurrently)
+{
+    std::promise<void> firstStarted{};
+    std::promise<void> secondStarted{};
+    auto firstStartedFuture{firstStarted.get_future().share()};
+    auto secondStartedFuture{secondStarted.get_future().share()};
+
+    constexpr std::chrono::seconds timeout{5};
+    auto first{mThreadPool->submit([&]() {
+        firstStarted.set_value();
+        return secondStartedFuture.wait_for(timeout) == std::future_status::ready;
+    })};
+    auto second{mThreadPool->submit([&]() {
+        secondStarted.set_value();
+        return firstStartedFuture.wait_for(timeout) == std::future_status::ready;
+    })};
+
+    EXPECT_TRUE(first.get());
+    EXPECT_TRUE(second.get());
+}
+
+/**
+ * @brief Tests that the queued tasks are executed before the pool is destroyed.
+ */
+TEST_F(ThreadPoolTest, executesQueuedTasksOnDestruction)
+{
+    constexpr auto numTasks{50};
+    std::atomic<int> executedTasks{0};
+
+    {
+        common::ThreadPool threadPool{1};
+        for (auto i{0}; i < numTasks; ++i) {
+            threadPool.submit([&executedTasks]() { ++executedTasks; });
+        }
+    }
+
+    EXPECT_EQ(executedTasks, numTasks);
+}
+
+/**
+ * @brief Tests that an exception thrown by a task is propagated through its future.
+ */
+TEST_F(ThreadPoolTest, propagatesExceptionOfTask)
+{
+    auto future{mThreadPool->submit([]() -> int { throw std::runtime_error{"failure"}; })};
+
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+/**
+ * @brief Tests that the tasks queued as an executor are executed.
+ */
+TEST_F(ThreadPoolTest, executesTasksAsExecutor)
+{
+    constexpr auto numTasks{100};
+    std::atomic<int> executedTasks{0};
+
+    common::Executor& executor{*mThreadPool};
+    for (auto i{0}; i < numTasks; ++i) {
+        executor.execute([&executedTasks]() { ++executedTasks; });
+    }
+    mThreadPool->waitIdle();
+
+    EXPECT_EQ(executedTasks, numTasks);
+}
+
+/**
+ * @brief Tests that each worker thread calls the start function with its own index before executing tasks.
+ */
+TEST_F(ThreadPoolTest, callsThreadStartWithIndex)
+{
+    std::atomic<unsigned int> startedIndexes{0};
+
+    {
+        common::ThreadPool threadPool{3, [&startedIndexes](const unsigned int index) {
+                                          startedIndexes |= 1U << index;
+                                      }};
+        threadPool.submit([]() {}).get();
+    }
+
+    EXPECT_EQ(startedIndexes, 0b111U);
+}
+
+/**
+ * @brief Tests that all the tasks run in the job of the caller, and that the worker threads leave it afterwards.
+ */
+TEST_F(ThreadPoolTest, runsAllTasksInJobOfCaller)
+{
+    constexpr std::size_t numTasks{10};
+    common::CancellationToken cancellationToken{};
+    std::vector<std::uint64_t> jobIds(numTasks);
+    std::vector<const common::CancellationToken*> cancellationTokens(numTasks);
+
+    logging::Logger::setJobId(42);
+    common::CancellationToken::setCurrent(&cancellationToken);
+    mThreadPool->runAll(numTasks, [&](const std::size_t index) {
+        jobIds[index] = logging::Logger::getJobId();
+        cancellationTokens[index] = common::CancellationToken::getCurrent();
+    });
+    logging::Logger::setJobId(0);
+    common::CancellationToken::setCurrent(nullptr);
+
+    for (std::size_t i{0}; i < numTasks; ++i) {
+        EXPECT_EQ(jobIds[i], 42U);
+        EXPECT_EQ(cancellationTokens[i], &cancellationToken);
+    }
+    mThreadPool->submit([]() {
+                   EXPECT_EQ(logging::Logger::getJobId(), 0U);
+                   EXPECT_EQ(common::CancellationToken::getCurrent(), nullptr);
+               })
+        .get();
+}
+
+/**
+ * @brief Tests that the exception of a task is rethrown once all the tasks are executed.
+ */
+TEST_F(ThreadPoolTest, runsAllTasksBeforeRethrowing)
+{
+    constexpr std::size_t numTasks{10};
+    std::atomic<std::size_t> executedTasks{0};
+
+    EXPECT_THROW(mThreadPool->runAll(numTasks,
+                                     [&executedTasks](const std::size_t index) {
+                                         ++executedTasks;
+                                         if (index == 0) {
+                                             throw std::runtime_error("Task failed");
+                                         }
+                                     }),
+                 std::runtime_error);
+
+    EXPECT_EQ(executedTasks, numTasks);
+}
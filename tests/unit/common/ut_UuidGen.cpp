@@ -81,3 +81,21 @@ TEST_F(UuidGenTest, generatesMultipleIds)
     EXPECT_TRUE(id2 != id4);
     EXPECT_TRUE(id3 != id4);
 }
+
+/**
+ * @brief Tests that the generation of a UUID from a name is the same for the same name.
+ */
+TEST_F(UuidGenTest, generatesSameNameId)
+{
+    const auto id1{mUuidGen->generateStringNameUuid(common::UuidGen::cAppNamespace, "name")};
+    const auto id2{mUuidGen->generateStringNameUuid(common::UuidGen::cAppNamespace, "name")};
+    const auto id3{mUuidGen->generateStringNameUuid(common::UuidGen::cAppNamespace, "other name")};
+    std::cout << "id1 = " << id1 << std::endl;
+    std::cout << "id3 = " << id3 << std::endl;
+
+    EXPECT_EQ(id1.size(), cNumCharsId);
+    EXPECT_EQ(id1, id2);
+    EXPECT_NE(id1, id3);
+    EXPECT_EQ(mUuidGen->generateNameUuid(common::UuidGen::cAppNamespace, "name").version(),
+              uuids::uuid_version::name_based_sha1);
+}
@@ -2,8 +2,12 @@
  * @file
  */
 
+#include "common/CancellationToken.h"
 #include "computerVision/OpenCvWrapper.h"
+#include <filesystem>
 #include <gtest/gtest.h>
+#include <opencv2/imgcodecs.hpp>
+#include <utility>
 #include <vector>
 
 using namespace circuitSegmentation::computerVision;
@@ -62,6 +66,21 @@ TEST_F(OpenCvWrapperTest, setsLogMode)
     EXPECT_EQ(silent, mOpenCvWrapper->getLogMode());
 }
 
+/**
+ * @brief Tests the number of threads setted for OpenCV.
+ */
+TEST_F(OpenCvWrapperTest, setsNumThreads)
+{
+    const auto numThreadsInitial{mOpenCvWrapper->getNumThreads()};
+
+    constexpr auto numThreads{1};
+    mOpenCvWrapper->setNumThreads(numThreads);
+    EXPECT_EQ(numThreads, mOpenCvWrapper->getNumThreads());
+
+    // Restore the number of threads, as it is global to the process
+    mOpenCvWrapper->setNumThreads(numThreadsInitial);
+}
+
 /**
  * @brief Tests if image is written successfully.
  */
@@ -116,6 +135,221 @@ TEST_F(OpenCvWrapperTest, readsImageUnsuccessfully)
     EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(image));
 }
 
+/**
+ * @brief Tests if the pages of a multi-page image are counted and read one by one.
+ */
+TEST_F(OpenCvWrapperTest, readsImagePages)
+{
+    const auto fileName{"test_image_pages.tiff"};
+    ASSERT_TRUE(cv::imwritemulti(fileName, std::vector<ImageMat>{mTestImage3chn, mTestImage3chn}));
+
+    // Count and read pages
+    const auto numPages = mOpenCvWrapper->countImagePages(fileName);
+    auto page = mOpenCvWrapper->readImagePage(fileName, 1);
+    auto missingPage = mOpenCvWrapper->readImagePage(fileName, 2);
+
+    EXPECT_EQ(numPages, 2);
+    EXPECT_FALSE(mOpenCvWrapper->isImageEmpty(page));
+    EXPECT_EQ(mOpenCvWrapper->getImageWidth(page), mOpenCvWrapper->getImageWidth(mTestImage3chn));
+    EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(missingPage));
+
+    std::filesystem::remove(fileName);
+}
+
+/**
+ * @brief Tests if the pages of an image are not counted when it is used an incorrect file name.
+ */
+TEST_F(OpenCvWrapperTest, countsImagePagesUnsuccessfully)
+{
+    const auto filePath{cNonExistentImageFilePath};
+
+    // Count pages
+    const auto numPages = mOpenCvWrapper->countImagePages(filePath);
+
+    EXPECT_EQ(numPages, 0);
+}
+
+/**
+ * @brief Tests if image is decoded successfully from a buffer in memory.
+ */
+TEST_F(OpenCvWrapperTest, decodesImageSuccessfully)
+{
+    // Encode image
+    std::vector<unsigned char> buffer{};
+    ASSERT_TRUE(cv::imencode(".png", mTestImage3chn, buffer));
+
+    // Decode image
+    auto image = mOpenCvWrapper->decodeImage(buffer);
+
+    // Image cannot be empty
+    EXPECT_FALSE(mOpenCvWrapper->isImageEmpty(image));
+    EXPECT_EQ(image.cols, mTestImage3chn.cols);
+    EXPECT_EQ(image.rows, mTestImage3chn.rows);
+}
+
+/**
+ * @brief Tests if image is decoded unsuccessfully when the buffer is not an encoded image.
+ */
+TEST_F(OpenCvWrapperTest, decodesImageUnsuccessfully)
+{
+    const std::vector<unsigned char> buffer{'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'};
+
+    // Decode image
+    auto image = mOpenCvWrapper->decodeImage(buffer);
+
+    // Image is empty
+    EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(image));
+}
+
+/**
+ * @brief Tests if image is encoded successfully.
+ */
+TEST_F(OpenCvWrapperTest, encodesImageSuccessfully)
+{
+    std::vector<unsigned char> buffer{};
+
+    // Encode image
+    ASSERT_TRUE(mOpenCvWrapper->encodeImage(".png", mTestImage3chn, buffer));
+
+    // Image decoded from the buffer is the same
+    auto image = mOpenCvWrapper->decodeImage(buffer);
+    EXPECT_EQ(image.cols, mTestImage3chn.cols);
+    EXPECT_EQ(image.rows, mTestImage3chn.rows);
+}
+
+/**
+ * @brief Tests if image is encoded unsuccessfully when the format is not supported.
+ */
+TEST_F(OpenCvWrapperTest, encodesImageUnsuccessfully)
+{
+    std::vector<unsigned char> buffer{};
+
+    // Encode image
+    EXPECT_FALSE(mOpenCvWrapper->encodeImage(".unsupported", mTestImage3chn, buffer));
+}
+
+/**
+ * @brief Tests that a buffer of BGR pixels is wrapped without copying.
+ */
+TEST_F(OpenCvWrapperTest, wrapsImageBufferWithoutCopy)
+{
+    constexpr auto width{4};
+    constexpr auto height{2};
+    constexpr std::size_t stride{16};
+    std::vector<unsigned char> buffer(stride * height, 128);
+
+    // Wrap buffer
+    auto image = mOpenCvWrapper->wrapImageBuffer(
+        buffer.data(), width, height, stride, OpenCvWrapper::PixelFormat::BGR);
+
+    ASSERT_FALSE(mOpenCvWrapper->isImageEmpty(image));
+    EXPECT_EQ(image.cols, width);
+    EXPECT_EQ(image.rows, height);
+    EXPECT_EQ(image.channels(), 3);
+    EXPECT_EQ(image.data, buffer.data());
+    EXPECT_EQ(image.step[0], stride);
+}
+
+/**
+ * @brief Tests that a buffer of pixels in other formats is converted to a color image.
+ */
+TEST_F(OpenCvWrapperTest, wrapsImageBufferWithConversion)
+{
+    constexpr auto width{4};
+    constexpr auto height{2};
+    const std::vector<std::pair<OpenCvWrapper::PixelFormat, std::size_t>> formats{
+        {OpenCvWrapper::PixelFormat::GRAY, 1},
+        {OpenCvWrapper::PixelFormat::BGRA, 4},
+        {OpenCvWrapper::PixelFormat::RGB, 3},
+        {OpenCvWrapper::PixelFormat::RGBA, 4},
+    };
+
+    for (const auto& [format, channels] : formats) {
+        std::vector<unsigned char> buffer(width * height * channels, 128);
+
+        // Wrap buffer
+        auto image = mOpenCvWrapper->wrapImageBuffer(buffer.data(), width, height, width * channels, format);
+
+        ASSERT_FALSE(mOpenCvWrapper->isImageEmpty(image));
+        EXPECT_EQ(image.cols, width);
+        EXPECT_EQ(image.rows, height);
+        EXPECT_EQ(image.channels(), 3);
+    }
+}
+
+/**
+ * @brief Tests that an invalid buffer of pixels is not wrapped.
+ */
+TEST_F(OpenCvWrapperTest, wrapsImageBufferUnsuccessfully)
+{
+    constexpr auto width{4};
+    constexpr auto height{2};
+    std::vector<unsigned char> buffer(width * height * 3, 128);
+
+    // Null data
+    auto image = mOpenCvWrapper->wrapImageBuffer(nullptr, width, height, width * 3, OpenCvWrapper::PixelFormat::BGR);
+    EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(image));
+
+    // Stride smaller than a row
+    image = mOpenCvWrapper->wrapImageBuffer(buffer.data(), width, height, width, OpenCvWrapper::PixelFormat::BGR);
+    EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(image));
+
+    // Invalid dimensions
+    image = mOpenCvWrapper->wrapImageBuffer(buffer.data(), 0, height, width * 3, OpenCvWrapper::PixelFormat::BGR);
+    EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(image));
+}
+
+/**
+ * @brief Tests that a buffer of pixels is copied to an image with the same type, and an invalid buffer is not.
+ */
+TEST_F(OpenCvWrapperTest, copiesImageBuffer)
+{
+    constexpr auto width{4};
+    constexpr auto height{2};
+    constexpr std::size_t stride{8};
+    std::vector<unsigned char> buffer(stride * height, 255);
+
+    // Copy buffer
+    auto image = mOpenCvWrapper->copyImageBuffer(buffer.data(), width, height, stride, CV_8UC1);
+
+    ASSERT_FALSE(mOpenCvWrapper->isImageEmpty(image));
+    EXPECT_EQ(image.cols, width);
+    EXPECT_EQ(image.rows, height);
+    EXPECT_EQ(mOpenCvWrapper->getImageType(image), CV_8UC1);
+    EXPECT_NE(image.data, buffer.data());
+    EXPECT_EQ(image.at<unsigned char>(1, 3), 255);
+
+    // Stride smaller than a row
+    image = mOpenCvWrapper->copyImageBuffer(buffer.data(), width, height, width, CV_8UC3);
+    EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(image));
+}
+
+/**
+ * @brief Tests that a buffer of pixels is wrapped keeping their type, without copying or converting them.
+ */
+TEST_F(OpenCvWrapperTest, viewsImageBuffer)
+{
+    constexpr auto width{4};
+    constexpr auto height{2};
+    constexpr std::size_t stride{8};
+    std::vector<unsigned char> buffer(stride * height, 128);
+
+    // View buffer
+    auto image
+        = mOpenCvWrapper->viewImageBuffer(buffer.data(), width, height, stride, OpenCvWrapper::cImageTypeGray);
+
+    ASSERT_FALSE(mOpenCvWrapper->isImageEmpty(image));
+    EXPECT_EQ(image.cols, width);
+    EXPECT_EQ(image.rows, height);
+    EXPECT_EQ(mOpenCvWrapper->getImageType(image), CV_8UC1);
+    EXPECT_EQ(image.data, buffer.data());
+    EXPECT_EQ(image.step[0], stride);
+
+    // Stride smaller than a row
+    image = mOpenCvWrapper->viewImageBuffer(buffer.data(), width, height, width, CV_8UC3);
+    EXPECT_TRUE(mOpenCvWrapper->isImageEmpty(image));
+}
+
 /**
  * @brief Tests that the method to clone image does not throw an exception.
  */
@@ -216,6 +450,115 @@ TEST_F(OpenCvWrapperTest, cropsImageUpdateSize)
     EXPECT_EQ(height, expectHeight);
 }
 
+/**
+ * @brief Tests that an image is cropped without copying the data when the region of interest has valid dimensions.
+ */
+TEST_F(OpenCvWrapperTest, cropsImageViewSuccessfully)
+{
+    constexpr auto widthImg{300};
+    constexpr auto heightImg{300};
+    ImageMat src{heightImg, widthImg, CV_8UC3, cv::Scalar(128, 128, 128)};
+
+    ImageMat dst{};
+
+    constexpr auto x{50};
+    constexpr auto y{50};
+    constexpr auto widthRoi{100};
+    constexpr auto heightRoi{100};
+    const Rectangle roi{x, y, widthRoi, heightRoi};
+
+    // Crop image
+    ASSERT_TRUE(mOpenCvWrapper->cropImageView(src, dst, roi));
+
+    // Dimensions of destination image are equal to the ROI
+    const auto width{mOpenCvWrapper->getImageWidth(dst)};
+    const auto height{mOpenCvWrapper->getImageHeight(dst)};
+    const auto expectWidth{roi.width};
+    const auto expectHeight{roi.height};
+    EXPECT_EQ(width, expectWidth);
+    EXPECT_EQ(height, expectHeight);
+
+    // Destination image references the data of the source image
+    EXPECT_EQ(dst.ptr(0), src.ptr(y) + x * src.elemSize());
+}
+
+/**
+ * @brief Tests that an image is cropped unsuccessfully, without copying the data, when the region of interest has
+ * invalid dimensions.
+ */
+TEST_F(OpenCvWrapperTest, cropsImageViewUnsuccessfully)
+{
+    constexpr auto widthImg{300};
+    constexpr auto heightImg{300};
+    ImageMat src{heightImg, widthImg, CV_8UC3, cv::Scalar(128, 128, 128)};
+
+    ImageMat dst{};
+
+    // Case when ROI occupies area that is outside of the source image
+    constexpr auto x{100};
+    constexpr auto y{100};
+    constexpr auto widthRoi{201};
+    constexpr auto heightRoi{201};
+    const Rectangle roi{x, y, widthRoi, heightRoi};
+
+    // Crop image
+    ASSERT_FALSE(mOpenCvWrapper->cropImageView(src, dst, roi));
+}
+
+/**
+ * @brief Tests that the size of the pixel data of an image is correct.
+ */
+TEST_F(OpenCvWrapperTest, getsImageSizeBytes)
+{
+    constexpr auto widthImg{300};
+    constexpr auto heightImg{200};
+    constexpr auto channels{3};
+    ImageMat image{heightImg, widthImg, CV_8UC3, cv::Scalar(128, 128, 128)};
+
+    constexpr std::size_t expectBytes{widthImg * heightImg * channels};
+    EXPECT_EQ(mOpenCvWrapper->getImageSizeBytes(image), expectBytes);
+
+    // Empty image has no pixel data
+    ImageMat emptyImage{};
+    EXPECT_EQ(mOpenCvWrapper->getImageSizeBytes(emptyImage), 0U);
+}
+
+/**
+ * @brief Tests that the hash of an image depends on its pixels and shape, and not on the padding of its rows.
+ */
+TEST_F(OpenCvWrapperTest, hashesImage)
+{
+    ImageMat image{4, 6, CV_8UC3, cv::Scalar(128, 128, 128)};
+    const auto hash{mOpenCvWrapper->hashImage(image)};
+
+    // Same pixels, in a view of a larger image (rows with padding)
+    ImageMat largerImage{4, 8, CV_8UC3, cv::Scalar(128, 128, 128)};
+    ImageMat view{largerImage(cv::Rect(0, 0, 6, 4))};
+    EXPECT_EQ(mOpenCvWrapper->hashImage(view), hash);
+
+    // Different pixel
+    ImageMat changedImage{image.clone()};
+    changedImage.at<cv::Vec3b>(2, 3)[1] = 0;
+    EXPECT_NE(mOpenCvWrapper->hashImage(changedImage), hash);
+
+    // Same bytes, different shape
+    ImageMat reshapedImage{image.reshape(3, 6)};
+    EXPECT_NE(mOpenCvWrapper->hashImage(reshapedImage), hash);
+}
+
+/**
+ * @brief Tests that the rows of an image are got without their padding.
+ */
+TEST_F(OpenCvWrapperTest, getsImageRow)
+{
+    ImageMat largerImage{4, 8, CV_8UC1, cv::Scalar(0)};
+    ImageMat view{largerImage(cv::Rect(2, 0, 6, 4))};
+
+    EXPECT_EQ(mOpenCvWrapper->getImageType(view), CV_8UC1);
+    EXPECT_EQ(mOpenCvWrapper->getImageRow(view, 0), largerImage.ptr(0) + 2);
+    EXPECT_EQ(mOpenCvWrapper->getImageRow(view, 3), largerImage.ptr(3) + 2);
+}
+
 /**
  * @brief Tests if an image is empty when it is empty.
  */
@@ -266,6 +609,29 @@ TEST_F(OpenCvWrapperTest, resizesImage)
     EXPECT_EQ(resizedHeight, expectHeight);
 }
 
+/**
+ * @brief Tests the downsampling of an image to a grayscale thumbnail.
+ */
+TEST_F(OpenCvWrapperTest, thumbnailsImage)
+{
+    constexpr auto thumbnailSize{8};
+
+    // Thumbnails of color and grayscale images
+    ImageMat thumbnail3chn{};
+    mOpenCvWrapper->thumbnailImage(mTestImage3chn, thumbnail3chn, thumbnailSize, thumbnailSize);
+    ImageMat thumbnail1chn{};
+    mOpenCvWrapper->thumbnailImage(mTestImage1chn, thumbnail1chn, thumbnailSize, thumbnailSize);
+
+    // Expect grayscale thumbnails with the size and the gray level of the images
+    EXPECT_EQ(thumbnail3chn.type(), CV_8UC1);
+    EXPECT_EQ(thumbnail3chn.cols, thumbnailSize);
+    EXPECT_EQ(thumbnail3chn.rows, thumbnailSize);
+    EXPECT_EQ(thumbnail3chn.at<unsigned char>(0, 0), 128);
+    EXPECT_EQ(thumbnail1chn.type(), CV_8UC1);
+    EXPECT_EQ(thumbnail1chn.cols, thumbnailSize);
+    EXPECT_EQ(thumbnail1chn.at<unsigned char>(thumbnailSize - 1, thumbnailSize - 1), 128);
+}
+
 /**
  * @brief Tests if the image dimensions (width and height) are correct.
  */
@@ -283,6 +649,19 @@ TEST_F(OpenCvWrapperTest, convertImageToGrayNoThrow)
     EXPECT_NO_THROW(mOpenCvWrapper->convertImageToGray(mTestImage3chn, mTestImage3chn));
 }
 
+/**
+ * @brief Tests that an image already in grayscale is referenced, without conversion.
+ */
+TEST_F(OpenCvWrapperTest, convertsGrayImageToGray)
+{
+    ImageMat image{};
+
+    mOpenCvWrapper->convertImageToGray(mTestImage1chn, image);
+
+    EXPECT_EQ(image.data, mTestImage1chn.data);
+    EXPECT_EQ(image.channels(), 1);
+}
+
 /**
  * @brief Tests that the method for Gaussian blur image does not throw an exception.
  */
@@ -544,6 +923,32 @@ TEST_F(OpenCvWrapperTest, thinningNoThrow)
     EXPECT_NO_THROW(mOpenCvWrapper->thinning(mTestImage1chn, img, thinningAlg2));
 }
 
+/**
+ * @brief Tests that the thinning operation stops after one pass when the current cancellation token is stopped.
+ */
+TEST_F(OpenCvWrapperTest, thinningStopsWhenCancelled)
+{
+    const OpenCvWrapper::ThinningAlgorithms thinningAlg{OpenCvWrapper::ThinningAlgorithms::THINNING_ZHANGSUEN};
+
+    // Thick square, which needs several passes to be thinned
+    ImageMat square{100, 100, CV_8UC1, cv::Scalar(0)};
+    square(cv::Rect(20, 20, 40, 40)).setTo(255);
+
+    ImageMat thinned{};
+    mOpenCvWrapper->thinning(square, thinned, thinningAlg);
+
+    circuitSegmentation::common::CancellationToken token{};
+    token.cancel();
+    circuitSegmentation::common::CancellationToken::setCurrent(&token);
+    ImageMat stopped{};
+    mOpenCvWrapper->thinning(square, stopped, thinningAlg);
+    circuitSegmentation::common::CancellationToken::setCurrent(nullptr);
+
+    // Thinned partially: more pixels than the skeleton, fewer than the square
+    EXPECT_GT(cv::countNonZero(stopped), cv::countNonZero(thinned));
+    EXPECT_LT(cv::countNonZero(stopped), cv::countNonZero(square));
+}
+
 /**
  * @brief Tests that the method for "bitwise and" operation does not throw an exception.
  */
@@ -0,0 +1,96 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/BinaryImage.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Tests that the rows set are packed a bit for each pixel, and unpacked as 8-bit pixels.
+ */
+TEST(BinaryImageTest, packsAndUnpacksRows)
+{
+    imageProcessing::BinaryImage imageBinary{11, 2};
+    const std::vector<unsigned char> row{0, 255, 0, 0, 0, 0, 0, 1, 9, 0, 255};
+
+    imageBinary.setRow(1, row.data());
+
+    // Rows of 11 pixels padded to 2 bytes
+    EXPECT_EQ(imageBinary.getSizeBytes(), 4);
+    EXPECT_FALSE(imageBinary.getPixel(0, 1));
+    EXPECT_TRUE(imageBinary.getPixel(1, 1));
+    EXPECT_TRUE(imageBinary.getPixel(7, 1));
+    EXPECT_TRUE(imageBinary.getPixel(8, 1));
+    EXPECT_TRUE(imageBinary.getPixel(10, 1));
+    EXPECT_FALSE(imageBinary.getPixel(1, 0));
+
+    std::vector<unsigned char> unpacked(11, 0);
+    imageBinary.getRow(1, unpacked.data());
+
+    EXPECT_EQ(unpacked, (std::vector<unsigned char>{0, 255, 0, 0, 0, 0, 0, 255, 255, 0, 255}));
+}
+
+/**
+ * @brief Tests that the pixels out of the image are in the background, and the rows out of the image are ignored.
+ */
+TEST(BinaryImageTest, ignoresPixelsOutOfImage)
+{
+    imageProcessing::BinaryImage imageBinary{8, 1};
+    const std::vector<unsigned char> row(8, 255);
+
+    imageBinary.setRow(1, row.data());
+    imageBinary.setRow(-1, row.data());
+
+    EXPECT_FALSE(imageBinary.getPixel(0, 0));
+    EXPECT_FALSE(imageBinary.getPixel(8, 0));
+    EXPECT_FALSE(imageBinary.getPixel(0, 1));
+}
+
+/**
+ * @brief Tests that an image is reset to new dimensions, in the background.
+ */
+TEST(BinaryImageTest, resetsImage)
+{
+    imageProcessing::BinaryImage imageBinary{8, 1};
+    const std::vector<unsigned char> row(8, 255);
+    imageBinary.setRow(0, row.data());
+
+    imageBinary.reset(16, 3);
+
+    EXPECT_EQ(imageBinary.getWidth(), 16);
+    EXPECT_EQ(imageBinary.getHeight(), 3);
+    EXPECT_EQ(imageBinary.getSizeBytes(), 6);
+    EXPECT_FALSE(imageBinary.getPixel(0, 0));
+
+    imageBinary.reset(0, 3);
+
+    EXPECT_EQ(imageBinary.getWidth(), 0);
+    EXPECT_EQ(imageBinary.getHeight(), 0);
+    EXPECT_EQ(imageBinary.getSizeBytes(), 0);
+}
+
+/**
+ * @brief Tests that packed rows are set with their stride, and unpacked with the foreground given.
+ */
+TEST(BinaryImageTest, setsPackedRows)
+{
+    imageProcessing::BinaryImage imageBinary{10, 2};
+    // Rows of 2 bytes, padded to 4 bytes
+    const std::vector<unsigned char> bits{0x80, 0x40, 0xFF, 0xFF, 0x00, 0x80, 0xFF, 0xFF};
+
+    imageBinary.setPackedRows(bits.data(), 4);
+
+    EXPECT_TRUE(imageBinary.getPixel(0, 0));
+    EXPECT_TRUE(imageBinary.getPixel(9, 0));
+    EXPECT_FALSE(imageBinary.getPixel(1, 0));
+    EXPECT_TRUE(imageBinary.getPixel(8, 1));
+
+    std::vector<unsigned char> unpacked(10, 128);
+    imageBinary.getRow(0, unpacked.data(), 0);
+
+    EXPECT_EQ(unpacked, (std::vector<unsigned char>{0, 255, 255, 255, 255, 255, 255, 255, 255, 0}));
+}
@@ -0,0 +1,332 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/ImageHeader.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+namespace {
+
+/**
+ * @brief Entry of a TIFF directory.
+ */
+struct TiffEntry
+{
+    /** Tag. */
+    std::uint16_t mTag;
+    /** Type of the values (3 for SHORT, 4 for LONG). */
+    std::uint16_t mType;
+    /** Number of values. */
+    std::uint32_t mCount;
+    /** Value, or offset of the values. */
+    std::uint32_t mValue;
+};
+
+/**
+ * @brief Appends an unsigned integer to a TIFF.
+ *
+ * @param tiff TIFF.
+ * @param value Integer.
+ * @param size Number of bytes.
+ * @param bigEndian Flag of a big-endian TIFF.
+ */
+void appendTiffValue(std::vector<unsigned char>& tiff,
+                     const std::uint32_t value,
+                     const std::size_t size,
+                     const bool bigEndian)
+{
+    for (std::size_t i{0}; i < size; i++) {
+        const auto shift{bigEndian ? (size - 1 - i) * 8 : i * 8};
+        tiff.push_back(static_cast<unsigned char>(value >> shift));
+    }
+}
+
+/**
+ * @brief Makes the header of a TIFF, with a directory for each page, one after the other.
+ *
+ * @param bigEndian Flag of a big-endian TIFF.
+ * @param pages Entries of the directory of each page.
+ *
+ * @return TIFF (without pixels).
+ */
+std::vector<unsigned char> makeTiff(const bool bigEndian, const std::vector<std::vector<TiffEntry>>& pages)
+{
+    std::vector<unsigned char> tiff{};
+    tiff.push_back(bigEndian ? 'M' : 'I');
+    tiff.push_back(bigEndian ? 'M' : 'I');
+    appendTiffValue(tiff, 42, 2, bigEndian);
+    appendTiffValue(tiff, 8, 4, bigEndian);
+
+    for (std::size_t page{0}; page < pages.size(); page++) {
+        appendTiffValue(tiff, static_cast<std::uint32_t>(pages[page].size()), 2, bigEndian);
+        for (const auto& entry : pages[page]) {
+            appendTiffValue(tiff, entry.mTag, 2, bigEndian);
+            appendTiffValue(tiff, entry.mType, 2, bigEndian);
+            appendTiffValue(tiff, entry.mCount, 4, bigEndian);
+            // SHORT values are at the start of the entry
+            if (entry.mType == 3 && entry.mCount == 1) {
+                appendTiffValue(tiff, entry.mValue, 2, bigEndian);
+                appendTiffValue(tiff, 0, 2, bigEndian);
+            } else {
+                appendTiffValue(tiff, entry.mValue, 4, bigEndian);
+            }
+        }
+        const auto nextOffset{page + 1 < pages.size() ? tiff.size() + 4 : 0};
+        appendTiffValue(tiff, static_cast<std::uint32_t>(nextOffset), 4, bigEndian);
+    }
+
+    return tiff;
+}
+
+} // namespace
+
+/**
+ * @brief Test class of ImageHeader.
+ */
+class ImageHeaderTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override {}
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+protected:
+    /** Existent image file path (1100x490 pixels). */
+    const std::string cExistentImageFilePath{std::string(TESTS_DATA_PATH) + "circuit-1.png"};
+
+    /** Header of a PNG image with 640x480 pixels. */
+    const std::vector<unsigned char> cPngHeader{0x89, 'P',  'N',  'G',  0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D,
+                                                'I',  'H',  'D',  'R',  0x00, 0x00, 0x02, 0x80, 0x00, 0x00, 0x01, 0xE0};
+
+    /** Header of a JPEG image with 640x480 pixels, with an APP0 segment before the start of frame. */
+    const std::vector<unsigned char> cJpegHeader{0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x06, 'J',  'F',  'I',  'F',
+                                                 0xFF, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x01, 0xE0, 0x02, 0x80};
+
+    /** Header of a BMP image with 640x480 pixels, with top-down pixels (negative height). */
+    const std::vector<unsigned char> cBmpHeader{'B',  'M',  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x36, 0x00,
+                                                0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x80, 0x02, 0x00, 0x00, 0x20, 0xFE,
+                                                0xFF, 0xFF};
+
+    /** Dimensions read. */
+    imageProcessing::ImageDimensions mDimensions{};
+    /** Information read. */
+    imageProcessing::ImageInfo mInfo{};
+};
+
+/**
+ * @brief Tests that the dimensions are read from a PNG header.
+ */
+TEST_F(ImageHeaderTest, readsPngDimensions)
+{
+    EXPECT_TRUE(imageProcessing::ImageHeader::readBufferDimensions(cPngHeader, mDimensions));
+    EXPECT_EQ(mDimensions.mWidth, 640);
+    EXPECT_EQ(mDimensions.mHeight, 480);
+}
+
+/**
+ * @brief Tests that the dimensions are read from the start of frame of a JPEG, after other segments.
+ */
+TEST_F(ImageHeaderTest, readsJpegDimensions)
+{
+    EXPECT_TRUE(imageProcessing::ImageHeader::readBufferDimensions(cJpegHeader, mDimensions));
+    EXPECT_EQ(mDimensions.mWidth, 640);
+    EXPECT_EQ(mDimensions.mHeight, 480);
+}
+
+/**
+ * @brief Tests that the dimensions are read from a BMP header.
+ */
+TEST_F(ImageHeaderTest, readsBmpDimensions)
+{
+    EXPECT_TRUE(imageProcessing::ImageHeader::readBufferDimensions(cBmpHeader, mDimensions));
+    EXPECT_EQ(mDimensions.mWidth, 640);
+    EXPECT_EQ(mDimensions.mHeight, 480);
+}
+
+/**
+ * @brief Tests that the dimensions are read from a PNM header, with comments.
+ */
+TEST_F(ImageHeaderTest, readsPnmDimensions)
+{
+    std::istringstream stream{"P4\n# Comment\n640 # Width\n480\n"};
+
+    EXPECT_TRUE(imageProcessing::ImageHeader::readDimensions(stream, mDimensions));
+    EXPECT_EQ(mDimensions.mWidth, 640);
+    EXPECT_EQ(mDimensions.mHeight, 480);
+}
+
+/**
+ * @brief Tests that the dimensions are read from an image file.
+ */
+TEST_F(ImageHeaderTest, readsFileDimensions)
+{
+    EXPECT_TRUE(imageProcessing::ImageHeader::readFileDimensions(cExistentImageFilePath, mDimensions));
+    EXPECT_EQ(mDimensions.mWidth, 1100);
+    EXPECT_EQ(mDimensions.mHeight, 490);
+}
+
+/**
+ * @brief Tests that the dimensions are not read from a nonexistent file.
+ */
+TEST_F(ImageHeaderTest, readFailsWithNonexistentFile)
+{
+    EXPECT_FALSE(imageProcessing::ImageHeader::readFileDimensions("nonexistent.png", mDimensions));
+}
+
+/**
+ * @brief Tests that the dimensions are not read from an unsupported format or a truncated header.
+ */
+TEST_F(ImageHeaderTest, readFailsWithInvalidHeader)
+{
+    const std::vector<unsigned char> unsupported{'G', 'I', 'F', '8', '9', 'a'};
+    const std::vector<unsigned char> truncated{cPngHeader.begin(), cPngHeader.begin() + 20};
+    const std::vector<unsigned char> empty{};
+
+    EXPECT_FALSE(imageProcessing::ImageHeader::readBufferDimensions(unsupported, mDimensions));
+    EXPECT_FALSE(imageProcessing::ImageHeader::readBufferDimensions(truncated, mDimensions));
+    EXPECT_FALSE(imageProcessing::ImageHeader::readBufferDimensions(empty, mDimensions));
+}
+
+/**
+ * @brief Tests that the dimensions are not read when they are zero.
+ */
+TEST_F(ImageHeaderTest, readFailsWithZeroDimensions)
+{
+    std::istringstream stream{"P5 0 480 255\n"};
+
+    EXPECT_FALSE(imageProcessing::ImageHeader::readDimensions(stream, mDimensions));
+}
+
+/**
+ * @brief Tests that the channels and the depth are read from a PNG header, and are unknown when it is truncated.
+ */
+TEST_F(ImageHeaderTest, readsPngInfo)
+{
+    auto header{cPngHeader};
+    EXPECT_TRUE(imageProcessing::ImageHeader::readBufferInfo(header, mInfo));
+    EXPECT_EQ(mInfo.mChannels, 0);
+    EXPECT_EQ(mInfo.mDepth, 0);
+
+    // 16 bits grayscale and alpha
+    header.insert(header.end(), {0x10, 0x04});
+    EXPECT_TRUE(imageProcessing::ImageHeader::readBufferInfo(header, mInfo));
+    EXPECT_EQ(mInfo.mDimensions.mWidth, 640);
+    EXPECT_EQ(mInfo.mChannels, 2);
+    EXPECT_EQ(mInfo.mDepth, 16);
+    EXPECT_EQ(mInfo.mNumPages, 1);
+}
+
+/**
+ * @brief Tests that the channels and the depth are read from the start of frame of a JPEG.
+ */
+TEST_F(ImageHeaderTest, readsJpegInfo)
+{
+    auto header{cJpegHeader};
+    header.push_back(0x03);
+
+    EXPECT_TRUE(imageProcessing::ImageHeader::readBufferInfo(header, mInfo));
+    EXPECT_EQ(mInfo.mDimensions.mHeight, 480);
+    EXPECT_EQ(mInfo.mChannels, 3);
+    EXPECT_EQ(mInfo.mDepth, 8);
+}
+
+/**
+ * @brief Tests that the channels and the depth are read from PNM headers.
+ */
+TEST_F(ImageHeaderTest, readsPnmInfo)
+{
+    std::istringstream pgm{"P5 640 480 65535\n"};
+    EXPECT_TRUE(imageProcessing::ImageHeader::readInfo(pgm, mInfo));
+    EXPECT_EQ(mInfo.mChannels, 1);
+    EXPECT_EQ(mInfo.mDepth, 16);
+
+    std::istringstream pbm{"P4 640 480\n"};
+    EXPECT_TRUE(imageProcessing::ImageHeader::readInfo(pbm, mInfo));
+    EXPECT_EQ(mInfo.mChannels, 1);
+    EXPECT_EQ(mInfo.mDepth, 1);
+}
+
+/**
+ * @brief Tests that the information is read from the first directory of a little-endian TIFF, counting its pages.
+ */
+TEST_F(ImageHeaderTest, readsTiffInfo)
+{
+    const std::vector<TiffEntry> firstPage{
+        {256, 3, 1, 640}, {257, 4, 1, 480}, {258, 3, 1, 8}, {277, 3, 1, 1}};
+    const std::vector<TiffEntry> otherPage{{256, 3, 1, 320}, {257, 3, 1, 240}};
+    const auto tiff{makeTiff(false, {firstPage, otherPage, otherPage})};
+
+    ASSERT_TRUE(imageProcessing::ImageHeader::readBufferInfo(tiff, mInfo));
+    EXPECT_EQ(mInfo.mDimensions.mWidth, 640);
+    EXPECT_EQ(mInfo.mDimensions.mHeight, 480);
+    EXPECT_EQ(mInfo.mChannels, 1);
+    EXPECT_EQ(mInfo.mDepth, 8);
+    EXPECT_EQ(mInfo.mNumPages, 3);
+
+    // The dimensions only
+    EXPECT_TRUE(imageProcessing::ImageHeader::readBufferDimensions(tiff, mDimensions));
+    EXPECT_EQ(mDimensions.mWidth, 640);
+}
+
+/**
+ * @brief Tests that the depth of a big-endian TIFF is read out of its directory, for several channels.
+ */
+TEST_F(ImageHeaderTest, readsBigEndianTiffInfo)
+{
+    // Bits per sample after the directory (8 + 2 + 4 * 12 + 4)
+    auto tiff{makeTiff(true, {{{256, 3, 1, 640}, {257, 3, 1, 480}, {258, 3, 3, 62}, {277, 3, 1, 3}}})};
+    ASSERT_EQ(tiff.size(), 62);
+    tiff.insert(tiff.end(), {0x00, 0x10, 0x00, 0x10, 0x00, 0x10});
+
+    ASSERT_TRUE(imageProcessing::ImageHeader::readBufferInfo(tiff, mInfo));
+    EXPECT_EQ(mInfo.mDimensions.mWidth, 640);
+    EXPECT_EQ(mInfo.mChannels, 3);
+    EXPECT_EQ(mInfo.mDepth, 16);
+    EXPECT_EQ(mInfo.mNumPages, 1);
+}
+
+/**
+ * @brief Tests that the information is not read from an invalid TIFF, and that a loop of directories is stopped.
+ */
+TEST_F(ImageHeaderTest, readFailsWithInvalidTiff)
+{
+    // Directory out of the TIFF
+    auto tiff{makeTiff(false, {{{256, 3, 1, 640}, {257, 3, 1, 480}}})};
+    tiff[4] = 0xFF;
+    EXPECT_FALSE(imageProcessing::ImageHeader::readBufferInfo(tiff, mInfo));
+
+    // Dimensions missing
+    tiff = makeTiff(false, {{{256, 3, 1, 640}}});
+    EXPECT_FALSE(imageProcessing::ImageHeader::readBufferInfo(tiff, mInfo));
+
+    // Next directory being the first one
+    tiff = makeTiff(false, {{{256, 3, 1, 640}, {257, 3, 1, 480}}});
+    tiff[tiff.size() - 4] = 8;
+    ASSERT_TRUE(imageProcessing::ImageHeader::readBufferInfo(tiff, mInfo));
+    EXPECT_GT(mInfo.mNumPages, 1);
+}
+
+/**
+ * @brief Tests that the information is read from an image file.
+ */
+TEST_F(ImageHeaderTest, readsFileInfo)
+{
+    EXPECT_TRUE(imageProcessing::ImageHeader::readFileInfo(cExistentImageFilePath, mInfo));
+    EXPECT_EQ(mInfo.mDimensions.mWidth, 1100);
+    EXPECT_EQ(mInfo.mChannels, 4);
+    EXPECT_EQ(mInfo.mDepth, 8);
+    EXPECT_EQ(mInfo.mNumPages, 1);
+}
@@ -5,9 +5,11 @@
 #include "imageProcessing/ImagePreprocessing.h"
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "output/ImageWriter.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
 
 using namespace testing;
 using namespace circuitSegmentation;
@@ -25,8 +27,10 @@ protected:
     {
         mMockOpenCvWrapper = std::make_shared<NiceMock<computerVision::MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
+        mImageWriter = std::make_shared<output::ImageWriter>(mMockOpenCvWrapper, mLogger);
 
-        mImagePreprocessing = std::make_unique<imageProcessing::ImagePreprocessing>(mMockOpenCvWrapper, mLogger, false);
+        mImagePreprocessing
+            = std::make_unique<imageProcessing::ImagePreprocessing>(mMockOpenCvWrapper, mImageWriter, mLogger, false);
     }
 
     /**
@@ -41,6 +45,8 @@ protected:
     std::shared_ptr<NiceMock<computerVision::MockOpenCvWrapper>> mMockOpenCvWrapper;
     /** Logger. */
     std::shared_ptr<circuitSegmentation::logging::Logger> mLogger;
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
 
     /** Image to be used in tests. */
     computerVision::ImageMat mTestImage{};
@@ -59,6 +65,9 @@ TEST_F(ImagePreprocessingTest, preprocessImageSave)
 
     // Preprocess image
     mImagePreprocessing->preprocessImage(mTestImage);
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -242,3 +251,134 @@ TEST_F(ImagePreprocessingTest, detectsImageEdges)
     // Detect edges
     mImagePreprocessing->edgesImage(mTestImage);
 }
+
+/**
+ * @brief Tests that the parameters of the balanced preset are the default parameters of the preprocessing.
+ */
+TEST_F(ImagePreprocessingTest, getsBalancedParameters)
+{
+    const auto parameters{imageProcessing::ImagePreprocessing::getParameters(common::Preset::BALANCED)};
+
+    EXPECT_EQ(mImagePreprocessing->getPreset(), common::Preset::BALANCED);
+    EXPECT_EQ(parameters.mFilterKernelSize, 9);
+    EXPECT_EQ(parameters.mThresholdMethod,
+              computerVision::OpenCvWrapper::AdaptiveThresholdAlgorithm::ADAPTIVE_THRESH_GAUSSIAN);
+    EXPECT_EQ(parameters.mThresholdBlockSize, 21);
+    EXPECT_EQ(parameters.mThresholdSubConst, 4);
+    EXPECT_FALSE(parameters.mMorphOpen);
+}
+
+/**
+ * @brief Tests that the parameters of the presets are valid for the OpenCV operations.
+ */
+TEST_F(ImagePreprocessingTest, getsValidParameters)
+{
+    for (const auto preset : {common::Preset::FAST, common::Preset::BALANCED, common::Preset::ACCURATE}) {
+        const auto parameters{imageProcessing::ImagePreprocessing::getParameters(preset)};
+
+        EXPECT_EQ(parameters.mFilterKernelSize % 2, 1);
+        EXPECT_EQ(parameters.mThresholdBlockSize % 2, 1);
+        EXPECT_GT(parameters.mThresholdBlockSize, 1);
+    }
+}
+
+/**
+ * @brief Tests that the image is blurred and thresholded with the parameters of the preset.
+ */
+TEST_F(ImagePreprocessingTest, preprocessesImageWithFastPreset)
+{
+    mImagePreprocessing->setPreset(common::Preset::FAST);
+    const auto parameters{imageProcessing::ImagePreprocessing::getParameters(common::Preset::FAST)};
+
+    // Setup expectations
+    EXPECT_CALL(*mMockOpenCvWrapper, gaussianBlurImage(_, _, parameters.mFilterKernelSize)).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper,
+                adaptiveThresholdImage(_, _, _, parameters.mThresholdMethod, _, parameters.mThresholdBlockSize, _))
+        .Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, morphologyEx).Times(1);
+
+    // Preprocess image
+    mImagePreprocessing->preprocessImage(mTestImage);
+
+    EXPECT_EQ(mImagePreprocessing->getPreset(), common::Preset::FAST);
+}
+
+/**
+ * @brief Tests that the image is thresholded with the parameters set, instead of the parameters of the preset.
+ */
+TEST_F(ImagePreprocessingTest, preprocessesImageWithParametersSet)
+{
+    auto parameters{imageProcessing::ImagePreprocessing::getParameters(common::Preset::BALANCED)};
+    parameters.mThresholdBlockSize = 31;
+    parameters.mThresholdSubConst = 7;
+    mImagePreprocessing->setParameters(parameters);
+
+    // Setup expectations
+    EXPECT_CALL(*mMockOpenCvWrapper, adaptiveThresholdImage(_, _, _, _, _, 31, 7)).Times(1);
+
+    // Preprocess image
+    mImagePreprocessing->preprocessImage(mTestImage);
+}
+
+/**
+ * @brief Tests that the image is opened before the dilation with the accurate preset.
+ */
+TEST_F(ImagePreprocessingTest, preprocessesImageWithAccuratePreset)
+{
+    mImagePreprocessing->setPreset(common::Preset::ACCURATE);
+
+    // Setup expectations
+    {
+        InSequence sequence{};
+        EXPECT_CALL(*mMockOpenCvWrapper,
+                    morphologyEx(_, _, computerVision::OpenCvWrapper::MorphTypes::MORPH_OPEN, _, _))
+            .Times(1);
+        EXPECT_CALL(*mMockOpenCvWrapper,
+                    morphologyEx(_, _, computerVision::OpenCvWrapper::MorphTypes::MORPH_DILATE, _, _))
+            .Times(1);
+    }
+
+    // Preprocess image
+    mImagePreprocessing->preprocessImage(mTestImage);
+}
+
+/**
+ * @brief Tests that the image is preprocessed by bands with their context, and only the rows of each band are packed.
+ */
+TEST_F(ImagePreprocessingTest, preprocessesImageBands)
+{
+    constexpr int width{10};
+    constexpr int height{600};
+    std::vector<unsigned char> row(width, 0);
+    row.at(3) = 255;
+    std::vector<int> bandStarts{};
+    std::vector<int> bandHeights{};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageWidth).WillRepeatedly(Return(width));
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageHeight).WillRepeatedly(Return(height));
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView)
+        .Times(3)
+        .WillRepeatedly([&bandStarts, &bandHeights](computerVision::ImageMat&,
+                                                    computerVision::ImageMat&,
+                                                    const computerVision::Rectangle& roi) {
+            bandStarts.push_back(roi.y);
+            bandHeights.push_back(roi.height);
+            return true;
+        });
+    EXPECT_CALL(*mMockOpenCvWrapper, thinning).Times(3);
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageRow).Times(height).WillRepeatedly(Return(row.data()));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(0);
+
+    // Preprocess image by bands of 256 rows, with 32 rows of context
+    imageProcessing::BinaryImage imageBinary{};
+    mImagePreprocessing->preprocessImageBands(mTestImage, imageBinary, 256);
+
+    EXPECT_EQ(bandStarts, (std::vector<int>{0, 224, 480}));
+    EXPECT_EQ(bandHeights, (std::vector<int>{288, 320, 120}));
+    ASSERT_EQ(imageBinary.getHeight(), height);
+    EXPECT_EQ(imageBinary.getSizeBytes(), 2 * height);
+    EXPECT_TRUE(imageBinary.getPixel(3, 0));
+    EXPECT_TRUE(imageBinary.getPixel(3, height - 1));
+    EXPECT_FALSE(imageBinary.getPixel(4, height - 1));
+}
@@ -2,23 +2,37 @@
  * @file
  */
 
+#include "common/CancellationToken.h"
+#include "common/Task.h"
+#include "common/ThreadPool.h"
 #include "imageProcessing/ImageProcManager.h"
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
 #include "mocks/imageProcessing/MockImagePreprocessing.h"
 #include "mocks/imageProcessing/MockImageReceiver.h"
 #include "mocks/imageProcessing/MockImageSegmentation.h"
+#include "mocks/output/MockImageWriter.h"
 #include "mocks/schematicSegmentation/MockRoiSegmentation.h"
 #include "mocks/schematicSegmentation/MockSchematicSegmentation.h"
 #include "mocks/schematicSegmentation/MockSegmentationMap.h"
 #include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace testing;
 using namespace circuitSegmentation;
 using namespace circuitSegmentation::computerVision;
 using namespace circuitSegmentation::imageProcessing;
+using namespace circuitSegmentation::output;
 using namespace circuitSegmentation::schematicSegmentation;
 
 /**
@@ -33,12 +47,13 @@ protected:
     void SetUp() override
     {
         mMockImageReceiver = std::make_shared<NiceMock<MockImageReceiver>>(nullptr, nullptr);
-        mMockImagePreprocessing = std::make_shared<NiceMock<MockImagePreprocessing>>(nullptr, nullptr);
+        mMockImagePreprocessing = std::make_shared<NiceMock<MockImagePreprocessing>>(nullptr, nullptr, nullptr);
         mMockImageSegmentation
             = std::make_shared<NiceMock<MockImageSegmentation>>(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
-        mMockSchematicSegmentation = std::make_shared<NiceMock<MockSchematicSegmentation>>(nullptr, nullptr);
-        mMockRoiSegmentation = std::make_shared<NiceMock<MockRoiSegmentation>>(nullptr, nullptr);
+        mMockSchematicSegmentation = std::make_shared<NiceMock<MockSchematicSegmentation>>(nullptr, nullptr, nullptr);
+        mMockRoiSegmentation = std::make_shared<NiceMock<MockRoiSegmentation>>(nullptr, nullptr, nullptr);
         mMockSegmentationMap = std::make_shared<NiceMock<MockSegmentationMap>>(nullptr);
+        mMockImageWriter = std::make_shared<NiceMock<MockImageWriter>>(nullptr, nullptr);
         mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
 
@@ -55,12 +70,14 @@ protected:
                                                                mMockSchematicSegmentation,
                                                                mMockRoiSegmentation,
                                                                mMockSegmentationMap,
+                                                               mMockImageWriter,
                                                                mMockOpenCvWrapper,
                                                                mLogger,
                                                                logMode,
                                                                saveImages);
 
         onGetElements();
+        onFlushImages();
     }
 
     /**
@@ -96,18 +113,17 @@ protected:
      */
     void onGetElements()
     {
-        const std::vector<circuit::Component> emptyComponents{};
-        const std::vector<circuit::Connection> emptyConnections{};
-        const std::vector<circuit::Node> emptyNodes{};
-
-        ON_CALL(*mMockSchematicSegmentation, getComponents)
-            .WillByDefault(
-                Invoke([&emptyComponents]() -> const std::vector<circuit::Component>& { return emptyComponents; }));
-        ON_CALL(*mMockSchematicSegmentation, getConnections)
-            .WillByDefault(
-                Invoke([&emptyConnections]() -> const std::vector<circuit::Connection>& { return emptyConnections; }));
-        ON_CALL(*mMockSchematicSegmentation, getNodes)
-            .WillByDefault(Invoke([&emptyNodes]() -> const std::vector<circuit::Node>& { return emptyNodes; }));
+        ON_CALL(*mMockSchematicSegmentation, getComponents).WillByDefault(ReturnRef(mEmptyComponents));
+        ON_CALL(*mMockSchematicSegmentation, getConnections).WillByDefault(ReturnRef(mEmptyConnections));
+        ON_CALL(*mMockSchematicSegmentation, getNodes).WillByDefault(ReturnRef(mEmptyNodes));
+    }
+
+    /**
+     * @brief Sets the behaviour when waiting for the images to be written.
+     */
+    void onFlushImages()
+    {
+        ON_CALL(*mMockImageWriter, flush).WillByDefault(Return(true));
     }
 
 protected:
@@ -125,10 +141,18 @@ protected:
     std::shared_ptr<NiceMock<MockRoiSegmentation>> mMockRoiSegmentation;
     /** Segmentation map. */
     std::shared_ptr<NiceMock<MockSegmentationMap>> mMockSegmentationMap;
+    /** Image writer. */
+    std::shared_ptr<NiceMock<MockImageWriter>> mMockImageWriter;
     /** OpenCV wrapper. */
     std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
+    /** Empty components, returned by the schematic segmentation. */
+    const std::vector<circuit::Component> mEmptyComponents{};
+    /** Empty connections, returned by the schematic segmentation. */
+    const std::vector<circuit::Connection> mEmptyConnections{};
+    /** Empty nodes, returned by the schematic segmentation. */
+    const std::vector<circuit::Node> mEmptyNodes{};
 };
 
 /**
@@ -164,12 +188,446 @@ TEST_F(ImageProcManagerTest, processesSuccessfully)
     EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
 
     // Process image
     const std::string imageFilePath{""};
     ASSERT_TRUE(mImageProcManager->processImage(imageFilePath));
 }
 
+/**
+ * @brief Tests that a binary image received (e.g. a PBM file) is preprocessed without threshold, and that the image
+ * borrowed from a file mapped in memory is not released before the end of the processing, even in low-memory mode.
+ */
+TEST_F(ImageProcManagerTest, processesBinaryImage)
+{
+    ImageMat image{};
+    BinaryImage imageBinary{8, 2};
+    const std::vector<unsigned char> row(8, 255);
+    imageBinary.setRow(0, row.data());
+    expectSetSaveImages(false);
+    mImageProcManager->setLowMemoryMode(true);
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageReceiver, isImageBorrowed).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageBinary).Times(1).WillOnce(Return(imageBinary));
+    EXPECT_CALL(*mMockImageReceiver, releaseImage).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, copyImageBuffer(_, 8, 2, 8, OpenCvWrapper::cImageTypeGray))
+        .Times(1)
+        .WillOnce(Return(image));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessBinaryImage).Times(1);
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(0);
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImageBands).Times(0);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image
+    ASSERT_TRUE(mImageProcManager->processImage("image.pbm"));
+}
+
+/**
+ * @brief Tests that the pages of a multi-page image are processed one at a time, each one with its output files in
+ * its own folder.
+ */
+TEST_F(ImageProcManagerTest, processesImagePagesSuccessfully)
+{
+    ImageMat image{};
+    const auto outputDirectory{std::filesystem::temp_directory_path() / "cs_ut_image_proc_manager_pages"};
+    std::filesystem::remove_all(outputDirectory);
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, setImageFilePath("sheets.tiff")).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, getNumImagePages).Times(1).WillOnce(Return(2));
+    EXPECT_CALL(*mMockImageReceiver, setImagePage(0)).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, setImagePage(1)).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(2).WillRepeatedly(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(2).WillRepeatedly(Return(image));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(2);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockImageWriter, setOutputDirectory((outputDirectory / "page_001").string())).Times(1);
+    EXPECT_CALL(*mMockImageWriter, setOutputDirectory((outputDirectory / "page_002").string())).Times(1);
+
+    // Process pages
+    mImageProcManager->setOutputDirectory(outputDirectory.string());
+    ASSERT_TRUE(mImageProcManager->processImagePages("sheets.tiff"));
+    EXPECT_TRUE(std::filesystem::is_directory(outputDirectory / "page_001"));
+    EXPECT_TRUE(std::filesystem::is_directory(outputDirectory / "page_002"));
+    EXPECT_EQ(mImageProcManager->getOutputDirectory(), outputDirectory.string());
+
+    std::filesystem::remove_all(outputDirectory);
+}
+
+/**
+ * @brief Tests that a page that fails does not stop the processing of the next pages.
+ */
+TEST_F(ImageProcManagerTest, processImagePagesFailsWhenPageFailed)
+{
+    ImageMat image{};
+    const auto outputDirectory{std::filesystem::temp_directory_path() / "cs_ut_image_proc_manager_pages"};
+    std::filesystem::remove_all(outputDirectory);
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, getNumImagePages).Times(1).WillOnce(Return(2));
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(2).WillOnce(Return(false)).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(2).WillRepeatedly(Return(true));
+
+    // Process pages
+    mImageProcManager->setOutputDirectory(outputDirectory.string());
+    ASSERT_FALSE(mImageProcManager->processImagePages("sheets.tiff"));
+    EXPECT_EQ(mImageProcManager->getLastStatus(), ProcessingStatus::FAILED);
+
+    std::filesystem::remove_all(outputDirectory);
+}
+
+/**
+ * @brief Tests that a file with a single page is processed as a single image, in the output directory.
+ */
+TEST_F(ImageProcManagerTest, processesSinglePageAsImage)
+{
+    ImageMat image{};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, getNumImagePages).Times(1).WillOnce(Return(1));
+    EXPECT_CALL(*mMockImageReceiver, setImagePage).Times(0);
+    EXPECT_CALL(*mMockImageWriter, setOutputDirectory(std::string{})).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process pages
+    ASSERT_TRUE(mImageProcManager->processImagePages("circuit.png"));
+}
+
+/**
+ * @brief Tests the names of the folders of the output files of the pages.
+ */
+TEST_F(ImageProcManagerTest, getsPageDirectoryName)
+{
+    EXPECT_EQ(ImageProcManager::getPageDirectoryName(0), "page_001");
+    EXPECT_EQ(ImageProcManager::getPageDirectoryName(41), "page_042");
+}
+
+/**
+ * @brief Tests that processing of an image buffer occurs successfully.
+ */
+TEST_F(ImageProcManagerTest, processesBufferSuccessfully)
+{
+    ImageMat image{};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, setImageFilePath).Times(0);
+    EXPECT_CALL(*mMockImageReceiver, setImageBuffer).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(1);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image
+    const std::vector<unsigned char> imageBuffer{0x89, 'P', 'N', 'G'};
+    ASSERT_TRUE(mImageProcManager->processImageBuffer(imageBuffer));
+}
+
+/**
+ * @brief Tests that processing of a buffer of raw pixels occurs successfully.
+ */
+TEST_F(ImageProcManagerTest, processesRawBufferSuccessfully)
+{
+    ImageMat image{};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, setImageFilePath).Times(0);
+    EXPECT_CALL(*mMockImageReceiver, setRawImageBuffer).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image
+    const std::vector<unsigned char> pixels(3, 0);
+    ASSERT_TRUE(mImageProcManager->processRawImageBuffer({pixels.data(), 1, 1, 3, OpenCvWrapper::PixelFormat::BGR}));
+}
+
+/**
+ * @brief Tests that a buffer of raw pixels borrowed by the initial image is released after the generation of the
+ * images with ROI, once.
+ */
+TEST_F(ImageProcManagerTest, releasesBorrowedRawBufferAfterRoiGeneration)
+{
+    ImageMat image{};
+    auto numReleases{0};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageReceiver, isImageBorrowed).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce([&numReleases]() {
+        EXPECT_EQ(numReleases, 0);
+        return true;
+    });
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce([&numReleases]() {
+        EXPECT_EQ(numReleases, 1);
+        return true;
+    });
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image
+    const std::vector<unsigned char> pixels(3, 0);
+    ASSERT_TRUE(mImageProcManager->processRawImageBuffer({pixels.data(), 1, 1, 3, OpenCvWrapper::PixelFormat::BGR},
+                                                         [&numReleases]() { ++numReleases; }));
+    EXPECT_EQ(numReleases, 1);
+}
+
+/**
+ * @brief Tests that a buffer of raw pixels converted on reception is released before the preprocessing.
+ */
+TEST_F(ImageProcManagerTest, releasesConvertedRawBufferAfterReception)
+{
+    ImageMat image{};
+    auto numReleases{0};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageReceiver, isImageBorrowed).WillRepeatedly(Return(false));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(1).WillOnce([&numReleases]() {
+        EXPECT_EQ(numReleases, 1);
+    });
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(false));
+
+    // Process image
+    const std::vector<unsigned char> pixels(1, 0);
+    ASSERT_FALSE(mImageProcManager->processRawImageBuffer({pixels.data(), 1, 1, 1, OpenCvWrapper::PixelFormat::GRAY},
+                                                          [&numReleases]() { ++numReleases; }));
+    EXPECT_EQ(numReleases, 1);
+}
+
+/**
+ * @brief Tests that a buffer of raw pixels is released when the processing fails before using it.
+ */
+TEST_F(ImageProcManagerTest, releasesRawBufferWhenProcessingFailed)
+{
+    auto numReleases{0};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(false));
+
+    // Process image
+    const std::vector<unsigned char> pixels(3, 0);
+    ASSERT_FALSE(mImageProcManager->processRawImageBuffer({pixels.data(), 1, 1, 3, OpenCvWrapper::PixelFormat::BGR},
+                                                          [&numReleases]() { ++numReleases; }));
+    EXPECT_EQ(numReleases, 1);
+}
+
+#ifdef COROUTINES_SUPPORTED
+/**
+ * @brief Tests that asynchronous processing occurs successfully on the executor.
+ */
+TEST_F(ImageProcManagerTest, processesAsyncSuccessfully)
+{
+    ImageMat image{};
+    const nlohmann::ordered_json segmentationMap = {{"components", nlohmann::ordered_json::array()}};
+    common::ThreadPool executor{2};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, setImageFilePath).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(1);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(0);
+    EXPECT_CALL(*mMockImageWriter, whenFlushed)
+        .Times(1)
+        .WillOnce([](const std::uint64_t, std::function<void(bool)> onFlushed) { onFlushed(true); });
+    EXPECT_CALL(*mMockSegmentationMap, getSegmentationMap).WillRepeatedly(ReturnRef(segmentationMap));
+
+    // Process image
+    std::promise<bool> success{};
+    common::startTask<bool>(
+        mImageProcManager->processImageAsync("", executor),
+        [&success](bool value) { success.set_value(value); },
+        [&success](std::exception_ptr exception) { success.set_exception(exception); });
+
+    ASSERT_TRUE(success.get_future().get());
+    EXPECT_TRUE(mImageProcManager->getResult().mSuccess);
+}
+
+/**
+ * @brief Tests that asynchronous processing stops at the stage that failed.
+ */
+TEST_F(ImageProcManagerTest, processAsyncFailsWhenImageSegmentationFailed)
+{
+    ImageMat image{};
+    common::ThreadPool executor{2};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(false));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(0);
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(0);
+    EXPECT_CALL(*mMockImageWriter, whenFlushed)
+        .Times(1)
+        .WillOnce([](const std::uint64_t, std::function<void(bool)> onFlushed) { onFlushed(true); });
+
+    // Process image
+    std::promise<bool> success{};
+    common::startTask<bool>(
+        mImageProcManager->processImageAsync("", executor),
+        [&success](bool value) { success.set_value(value); },
+        [&success](std::exception_ptr exception) { success.set_exception(exception); });
+
+    ASSERT_FALSE(success.get_future().get());
+}
+
+/**
+ * @brief Tests that asynchronous processing awaits the images of its job, without blocking a thread, and fails when
+ * they fail to be written.
+ */
+TEST_F(ImageProcManagerTest, processAsyncFailsWhenImagesWriteFailed)
+{
+    ImageMat image{};
+    const nlohmann::ordered_json segmentationMap = {{"components", nlohmann::ordered_json::array()}};
+    common::ThreadPool executor{1};
+    std::function<void(bool)> flushCallback{};
+    std::promise<void> flushAwaited{};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, getSegmentationMap).WillRepeatedly(ReturnRef(segmentationMap));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(0);
+    EXPECT_CALL(*mMockImageWriter, whenFlushed)
+        .Times(1)
+        .WillOnce([&flushCallback, &flushAwaited](const std::uint64_t jobId, std::function<void(bool)> onFlushed) {
+            EXPECT_NE(jobId, 0);
+            flushCallback = std::move(onFlushed);
+            flushAwaited.set_value();
+        });
+
+    // Process image, which is suspended until the images are written
+    std::promise<bool> success{};
+    common::startTask<bool>(
+        mImageProcManager->processImageAsync("", executor),
+        [&success](bool value) { success.set_value(value); },
+        [&success](std::exception_ptr exception) { success.set_exception(exception); });
+    flushAwaited.get_future().wait();
+
+    // The thread of the executor is not held by the coroutine
+    std::promise<void> executorFree{};
+    executor.execute([&executorFree]() { executorFree.set_value(); });
+    executorFree.get_future().wait();
+
+    // Images written with a failure
+    flushCallback(false);
+    ASSERT_FALSE(success.get_future().get());
+    EXPECT_EQ(mImageProcManager->getLastStatus(), ProcessingStatus::FAILED);
+}
+#endif
+
+/**
+ * @brief Tests that processing keeps the result in memory without writing the output files.
+ */
+TEST_F(ImageProcManagerTest, processesWithoutWritingOutputFiles)
+{
+    ImageMat image{};
+    const nlohmann::ordered_json segmentationMap = {{"components", nlohmann::ordered_json::array()}};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockRoiSegmentation, setWriteImages(false)).Times(1);
+    EXPECT_CALL(*mMockRoiSegmentation, setEncodeImages(true)).Times(1);
+    EXPECT_CALL(*mMockRoiSegmentation, clearRoiImages).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(0);
+    EXPECT_CALL(*mMockSegmentationMap, getSegmentationMap).WillRepeatedly(ReturnRef(segmentationMap));
+
+    // Process image
+    mImageProcManager->setWriteOutputFiles(false);
+    mImageProcManager->setEncodeRoiImages(true);
+    ASSERT_TRUE(mImageProcManager->processImage(""));
+
+    // Result
+    const auto result{mImageProcManager->getResult()};
+    EXPECT_TRUE(result.mSuccess);
+    EXPECT_EQ(result.mSegmentationMap, segmentationMap);
+    EXPECT_TRUE(result.mComponents.empty());
+    EXPECT_TRUE(result.mRoiImages.empty());
+    EXPECT_FALSE(mImageProcManager->getWriteOutputFiles());
+    EXPECT_TRUE(mImageProcManager->getEncodeRoiImages());
+}
+
+/**
+ * @brief Tests that the result of a failed processing has no elements.
+ */
+TEST_F(ImageProcManagerTest, getsResultOfFailedProcessing)
+{
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(false));
+    EXPECT_CALL(*mMockSchematicSegmentation, getComponents).Times(0);
+
+    // Process image
+    ASSERT_FALSE(mImageProcManager->processImage(""));
+
+    // Result
+    const auto result{mImageProcManager->getResult()};
+    EXPECT_FALSE(result.mSuccess);
+    EXPECT_TRUE(result.mSegmentationMap.is_null());
+}
+
 /**
  * @brief Tests that processing fails when image reception failed.
  */
@@ -180,6 +638,7 @@ TEST_F(ImageProcManagerTest, processFailsWhenImageReceptionFailed)
     EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(false));
     EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(0);
     EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(0);
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
 
     // Process image
     const std::string imageFilePath{""};
@@ -310,6 +769,94 @@ TEST_F(ImageProcManagerTest, processFailsWhenSegmentationMapWriteFailed)
     ASSERT_FALSE(mImageProcManager->processImage(imageFilePath));
 }
 
+/**
+ * @brief Tests that processing stops with a distinct status when the token is cancelled.
+ */
+TEST_F(ImageProcManagerTest, processStopsWhenCancelled)
+{
+    auto cancellationToken{std::make_shared<common::CancellationToken>()};
+    cancellationToken->cancel();
+    mImageProcManager->setCancellationToken(cancellationToken);
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(0);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(0);
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image
+    const std::string imageFilePath{""};
+    ASSERT_FALSE(mImageProcManager->processImage(imageFilePath));
+    EXPECT_EQ(mImageProcManager->getLastStatus(), ProcessingStatus::CANCELLED);
+    EXPECT_EQ(mImageProcManager->getResult().mStatus, ProcessingStatus::CANCELLED);
+    EXPECT_EQ(common::CancellationToken::getCurrent(), nullptr);
+}
+
+/**
+ * @brief Tests that processing stops at the next stage when the deadline expires during a stage.
+ */
+TEST_F(ImageProcManagerTest, processStopsWhenDeadlineExceeded)
+{
+    ImageMat image{};
+    auto cancellationToken{std::make_shared<common::CancellationToken>()};
+    mImageProcManager->setCancellationToken(cancellationToken);
+
+    // Setup expectations and behavior (the deadline expires during the reception)
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce([&cancellationToken]() {
+        cancellationToken->setDeadline(common::CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+        return true;
+    });
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(0);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(0);
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image
+    const std::string imageFilePath{""};
+    ASSERT_FALSE(mImageProcManager->processImage(imageFilePath));
+    EXPECT_EQ(mImageProcManager->getLastStatus(), ProcessingStatus::DEADLINE_EXCEEDED);
+}
+
+/**
+ * @brief Tests that the status of a processing failed without being stopped is a failure.
+ */
+TEST_F(ImageProcManagerTest, processFailsWithFailedStatus)
+{
+    mImageProcManager->setCancellationToken(std::make_shared<common::CancellationToken>());
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(false));
+
+    // Process image
+    const std::string imageFilePath{""};
+    ASSERT_FALSE(mImageProcManager->processImage(imageFilePath));
+    EXPECT_EQ(mImageProcManager->getLastStatus(), ProcessingStatus::FAILED);
+}
+
+/**
+ * @brief Tests that processing fails when writing of images failed.
+ */
+TEST_F(ImageProcManagerTest, processFailsWhenImageWritingFailed)
+{
+    ImageMat image{};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, setImageFilePath).Times(1);
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(1);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(false));
+
+    // Process image
+    const std::string imageFilePath{""};
+    ASSERT_FALSE(mImageProcManager->processImage(imageFilePath));
+}
+
 /**
  * @brief Tests that the log mode is defined correctly.
  */
@@ -341,3 +888,385 @@ TEST_F(ImageProcManagerTest, setsSaveImages)
 
     EXPECT_EQ(mImageProcManager->getSaveImages(), saveImages);
 }
+
+/**
+ * @brief Tests that the preset is set in the preprocessing and segmentation.
+ */
+TEST_F(ImageProcManagerTest, setsPreset)
+{
+    constexpr auto preset{common::Preset::ACCURATE};
+
+    // Setup expectations
+    EXPECT_CALL(*mMockImagePreprocessing, setPreset(preset)).Times(1);
+    EXPECT_CALL(*mMockImageSegmentation, setPreset(preset)).Times(1);
+
+    // Set preset
+    mImageProcManager->setPreset(preset);
+
+    EXPECT_EQ(mImageProcManager->getPreset(), preset);
+}
+
+/**
+ * @brief Tests that the images are not saved in low-memory mode, and are saved again out of it.
+ */
+TEST_F(ImageProcManagerTest, setsLowMemoryMode)
+{
+    expectSetSaveImages(true);
+    mImageProcManager->setSaveImages(true);
+
+    // Setup expectations
+    EXPECT_CALL(*mMockImagePreprocessing, setSaveImages(false)).Times(1);
+    EXPECT_CALL(*mMockImageSegmentation, setSaveImages(false)).Times(1);
+
+    // Set low-memory mode
+    mImageProcManager->setLowMemoryMode(true);
+
+    EXPECT_TRUE(mImageProcManager->getLowMemoryMode());
+    EXPECT_TRUE(mImageProcManager->getSaveImages());
+
+    // Setup expectations
+    EXPECT_CALL(*mMockImagePreprocessing, setSaveImages(true)).Times(1);
+    EXPECT_CALL(*mMockImageSegmentation, setSaveImages(true)).Times(1);
+
+    // Unset low-memory mode
+    mImageProcManager->setLowMemoryMode(false);
+
+    EXPECT_FALSE(mImageProcManager->getLowMemoryMode());
+}
+
+/**
+ * @brief Tests that the size of the tiles is set, and that a size of 0 segments the images as a whole.
+ */
+TEST_F(ImageProcManagerTest, setsTileSize)
+{
+    EXPECT_EQ(mImageProcManager->getTileSize(), 0);
+
+    // Set the size of the tiles
+    mImageProcManager->setTileSize(4096, 2);
+
+    EXPECT_EQ(mImageProcManager->getTileSize(), 4096);
+
+    // Unset the size of the tiles
+    mImageProcManager->setTileSize(0, 2);
+
+    EXPECT_EQ(mImageProcManager->getTileSize(), 0);
+}
+
+/**
+ * @brief Tests that the height of the bands is defined, and that a negative height preprocesses the images as a whole.
+ */
+TEST_F(ImageProcManagerTest, setsBandHeight)
+{
+    EXPECT_EQ(mImageProcManager->getBandHeight(), 0);
+
+    mImageProcManager->setBandHeight(512);
+
+    EXPECT_EQ(mImageProcManager->getBandHeight(), 512);
+
+    mImageProcManager->setBandHeight(-1);
+
+    EXPECT_EQ(mImageProcManager->getBandHeight(), 0);
+}
+
+/**
+ * @brief Tests that in low-memory mode the encoded image is released after being decoded, and the initial image is
+ * not saved.
+ */
+TEST_F(ImageProcManagerTest, processesInLowMemoryMode)
+{
+    ImageMat image{};
+    expectSetSaveImages(true);
+    mImageProcManager->setSaveImages(true);
+    expectSetSaveImages(false);
+    mImageProcManager->setLowMemoryMode(true);
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockImageReceiver, releaseImage).Times(2);
+    EXPECT_CALL(*mMockImageWriter, writeImage).Times(0);
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(0);
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImageBands(_, _, ImagePreprocessing::cBandHeightDefault))
+        .Times(1);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image buffer
+    ASSERT_TRUE(mImageProcManager->processImageBuffer({0x89, 'P', 'N', 'G'}));
+}
+
+/**
+ * @brief Tests that the image received is released at the end of each processing, even if it failed.
+ */
+TEST_F(ImageProcManagerTest, releasesImageAfterProcessing)
+{
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(false));
+    EXPECT_CALL(*mMockImageReceiver, releaseImage).Times(1);
+
+    // Process image
+    ASSERT_FALSE(mImageProcManager->processImage("image.png"));
+}
+
+/**
+ * @brief Tests that the peak memory is estimated from the dimensions of the image.
+ */
+TEST_F(ImageProcManagerTest, estimatesPeakMemory)
+{
+    const ImageDimensions dimensions{1000, 500};
+    constexpr std::size_t numPixels{1000 * 500};
+
+    EXPECT_EQ(ImageProcManager::estimatePeakMemory(dimensions, false), numPixels * ImageProcManager::cBytesPerPixel);
+    EXPECT_EQ(ImageProcManager::estimatePeakMemory(dimensions, true),
+              numPixels * (ImageProcManager::cBytesPerPixel + ImageProcManager::cSavedImagesBytesPerPixel));
+    EXPECT_EQ(ImageProcManager::estimatePeakMemory(dimensions, false, 1024),
+              numPixels * ImageProcManager::cBytesPerPixel + 1024);
+}
+
+/**
+ * @brief Tests that the output directory is defined for the images and the segmentation map.
+ */
+TEST_F(ImageProcManagerTest, setsOutputDirectory)
+{
+    const std::string outputDirectory{"output"};
+
+    // Setup expectations
+    EXPECT_CALL(*mMockSegmentationMap, setOutputDirectory(outputDirectory)).Times(1);
+
+    // Set output directory
+    mImageProcManager->setOutputDirectory(outputDirectory);
+    EXPECT_EQ(mImageProcManager->getOutputDirectory(), outputDirectory);
+}
+
+/**
+ * @brief Tests that the output directory is defined for the images of each job, since the image writer can be shared
+ * with other managers.
+ */
+TEST_F(ImageProcManagerTest, setsOutputDirectoryOfJob)
+{
+    const std::string outputDirectory{"output"};
+
+    // Setup expectations
+    EXPECT_CALL(*mMockImageWriter, setOutputDirectory).Times(0);
+    mImageProcManager->setOutputDirectory(outputDirectory);
+    Mock::VerifyAndClearExpectations(mMockImageWriter.get());
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(false));
+    EXPECT_CALL(*mMockImageWriter, setOutputDirectory(outputDirectory)).Times(1);
+    EXPECT_CALL(*mMockImageWriter, flush).Times(1).WillOnce(Return(true));
+
+    // Process image
+    ASSERT_FALSE(mImageProcManager->processImage(""));
+}
+
+/**
+ * @brief Tests that the result of an image found in the result cache is restored, skipping the other stages.
+ */
+TEST_F(ImageProcManagerTest, restoresResultFromCache)
+{
+    ImageMat image{};
+    const nlohmann::ordered_json segmentationMap = {{"components", nlohmann::ordered_json::array()}};
+    constexpr std::uint64_t imageHash{0x42};
+
+    // Result of the image, stored before
+    const auto cacheDirectory{std::filesystem::temp_directory_path() / "cs_ut_image_proc_manager_cache"};
+    std::filesystem::remove_all(cacheDirectory);
+    auto resultCache{std::make_shared<ResultCache>(cacheDirectory.string(), 1024 * 1024, mLogger)};
+    ASSERT_TRUE(resultCache->open());
+    RoiImage roiImage{};
+    roiImage.mFileName = "roi_component_R1_1.png";
+    roiImage.mEncodedImage = {0x89, 'P', 'N', 'G'};
+    ASSERT_TRUE(resultCache->store(ResultCache::makeKey(imageHash, common::Preset::BALANCED),
+                                   segmentationMap,
+                                   {roiImage},
+                                   cacheDirectory.string()));
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, hashImage).Times(1).WillOnce(Return(imageHash));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(0);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(0);
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(0);
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(0);
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(0);
+    EXPECT_CALL(*mMockSegmentationMap, setSegmentationMap(segmentationMap)).Times(1);
+    EXPECT_CALL(*mMockSegmentationMap, getSegmentationMap).WillRepeatedly(ReturnRef(segmentationMap));
+
+    // Process image
+    mImageProcManager->setResultCache(resultCache);
+    mImageProcManager->setWriteOutputFiles(false);
+    mImageProcManager->setEncodeRoiImages(true);
+    ASSERT_TRUE(mImageProcManager->processImage(""));
+
+    // Result
+    EXPECT_TRUE(mImageProcManager->isResultFromCache());
+    const auto result{mImageProcManager->getResult()};
+    EXPECT_TRUE(result.mSuccess);
+    EXPECT_EQ(result.mSegmentationMap, segmentationMap);
+    ASSERT_EQ(result.mRoiImages.size(), 1);
+    EXPECT_EQ(result.mRoiImages[0].mEncodedImage, roiImage.mEncodedImage);
+    EXPECT_EQ(resultCache->getStatistics().mHits, 1);
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+/**
+ * @brief Tests that the result of a near-duplicate of an image not found in the result cache is restored, skipping the
+ * other stages.
+ */
+TEST_F(ImageProcManagerTest, restoresResultOfNearDuplicateFromCache)
+{
+    ImageMat image{};
+    const nlohmann::ordered_json segmentationMap = {
+        {"nodes", nlohmann::ordered_json::array({{{"id", "N1"}, {"position", {{"x", 10}, {"y", 20}}}}})}};
+
+    // Thumbnail of the image and of its near-duplicate: a loop of wires
+    constexpr int size{ImageFingerprint::cThumbnailSize};
+    std::vector<unsigned char> thumbnail(size * size, 220);
+    for (int i{6}; i <= 25; ++i) {
+        thumbnail.at(6 * size + i) = 20;
+        thumbnail.at(25 * size + i) = 20;
+        thumbnail.at(i * size + 6) = 20;
+        thumbnail.at(i * size + 25) = 20;
+    }
+
+    // Result of the near-duplicate, stored and indexed before
+    const auto cacheDirectory{std::filesystem::temp_directory_path() / "cs_ut_image_proc_manager_cache"};
+    std::filesystem::remove_all(cacheDirectory);
+    auto resultCache{std::make_shared<ResultCache>(cacheDirectory.string(), 1024 * 1024, mLogger)};
+    ASSERT_TRUE(resultCache->open());
+    const auto nearDuplicateKey{ResultCache::makeKey(0x42, common::Preset::BALANCED)};
+    RoiImage roiImage{};
+    roiImage.mFileName = "roi_component_R1_1.png";
+    roiImage.mRoi = Rectangle{600, 10, 100, 20};
+    roiImage.mEncodedImage = {0x89, 'P', 'N', 'G'};
+    ASSERT_TRUE(resultCache->store(nearDuplicateKey, segmentationMap, {roiImage}, cacheDirectory.string()));
+    auto nearDuplicateIndex{std::make_shared<NearDuplicateIndex>(
+        (cacheDirectory / NearDuplicateIndex::cIndexFile).string(), mLogger)};
+    ASSERT_TRUE(nearDuplicateIndex->open());
+    nearDuplicateIndex->add(nearDuplicateKey, NearDuplicateIndex::makeFingerprint(thumbnail, 640, 480));
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, hashImage).Times(1).WillOnce(Return(0x43));
+    EXPECT_CALL(*mMockOpenCvWrapper, thumbnailImage).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageRow).WillRepeatedly([&thumbnail](ImageMat&, const int row) {
+        return thumbnail.data() + row * size;
+    });
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageWidth).WillRepeatedly(Return(640));
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageHeight).WillRepeatedly(Return(480));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(0);
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(0);
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(0);
+    EXPECT_CALL(*mMockSegmentationMap, setSegmentationMap(segmentationMap)).Times(1);
+    EXPECT_CALL(*mMockSegmentationMap, getSegmentationMap).WillRepeatedly(ReturnRef(segmentationMap));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiImages)
+        .Times(1)
+        .WillOnce([](ImageMat&, std::vector<RoiImage> roiImages) {
+            // Cropped again from the image, at the ROI clipped to it
+            EXPECT_EQ(roiImages.size(), 1);
+            EXPECT_EQ(roiImages.at(0).mRoi.x + roiImages.at(0).mRoi.width, 640);
+            return true;
+        });
+
+    // Process image
+    mImageProcManager->setResultCache(resultCache);
+    mImageProcManager->setNearDuplicateIndex(nearDuplicateIndex);
+    mImageProcManager->setWriteOutputFiles(false);
+    mImageProcManager->setEncodeRoiImages(true);
+    ASSERT_TRUE(mImageProcManager->processImage(""));
+
+    // Result
+    EXPECT_TRUE(mImageProcManager->isResultFromCache());
+    EXPECT_EQ(resultCache->getStatistics().mMisses, 1);
+    EXPECT_EQ(resultCache->getStatistics().mHits, 1);
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+/**
+ * @brief Tests that the result of an image not found in the result cache is stored in it.
+ */
+TEST_F(ImageProcManagerTest, storesResultInCache)
+{
+    ImageMat image{};
+    const nlohmann::ordered_json segmentationMap = {{"components", nlohmann::ordered_json::array()}};
+
+    const auto cacheDirectory{std::filesystem::temp_directory_path() / "cs_ut_image_proc_manager_cache"};
+    std::filesystem::remove_all(cacheDirectory);
+    auto resultCache{std::make_shared<ResultCache>(cacheDirectory.string(), 1024 * 1024, mLogger)};
+    ASSERT_TRUE(resultCache->open());
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockImageReceiver, receiveImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, getImageReceived).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, hashImage).Times(1).WillOnce(Return(0x43));
+    EXPECT_CALL(*mMockImageSegmentation, segmentImage).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockRoiSegmentation, generateRoiLabels).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, generateSegmentationMap).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSegmentationMap, getSegmentationMap).WillRepeatedly(ReturnRef(segmentationMap));
+
+    // Process image
+    mImageProcManager->setResultCache(resultCache);
+    mImageProcManager->setWriteOutputFiles(false);
+    mImageProcManager->setEncodeRoiImages(true);
+    ASSERT_TRUE(mImageProcManager->processImage(""));
+
+    // Result stored
+    EXPECT_FALSE(mImageProcManager->isResultFromCache());
+    EXPECT_EQ(resultCache->getStatistics().mMisses, 1);
+    EXPECT_EQ(resultCache->getStatistics().mStores, 1);
+    CachedResult cachedResult{};
+    EXPECT_TRUE(resultCache->find(ResultCache::makeKey(0x43, common::Preset::BALANCED), cachedResult));
+    EXPECT_EQ(cachedResult.mSegmentationMap, segmentationMap);
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+/**
+ * @brief Tests that the image preprocessed is checkpointed, and restored from its checkpoint by the next processing of
+ * the same image.
+ */
+TEST_F(ImageProcManagerTest, resumesFromStageCheckpoints)
+{
+    ImageMat image{};
+    const std::vector<unsigned char> pixels(4 * 2, 255);
+
+    const auto checkpointsDirectory{std::filesystem::temp_directory_path() / "cs_ut_image_proc_manager_checkpoints"};
+    std::filesystem::remove_all(checkpointsDirectory);
+    const auto stageCheckpoints{
+        std::make_shared<StageCheckpoints>(checkpointsDirectory.string(), mMockOpenCvWrapper, mLogger)};
+    ASSERT_TRUE(stageCheckpoints->open());
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockImageReceiver, receiveImage).WillByDefault(Return(true));
+    ON_CALL(*mMockImageReceiver, getImageReceived).WillByDefault(Return(image));
+    ON_CALL(*mMockOpenCvWrapper, hashImage).WillByDefault(Return(0x42));
+    ON_CALL(*mMockOpenCvWrapper, getImageWidth).WillByDefault(Return(4));
+    ON_CALL(*mMockOpenCvWrapper, getImageHeight).WillByDefault(Return(2));
+    ON_CALL(*mMockOpenCvWrapper, getImageSizeBytes).WillByDefault(Return(pixels.size()));
+    ON_CALL(*mMockOpenCvWrapper, getImageRow).WillByDefault(Return(pixels.data()));
+    ON_CALL(*mMockImageSegmentation, segmentImage).WillByDefault(Return(true));
+    ON_CALL(*mMockRoiSegmentation, generateRoiComponents).WillByDefault(Return(true));
+    ON_CALL(*mMockRoiSegmentation, generateRoiLabels).WillByDefault(Return(true));
+    ON_CALL(*mMockSegmentationMap, generateSegmentationMap).WillByDefault(Return(true));
+    ON_CALL(*mMockSegmentationMap, writeSegmentationMapJsonFile).WillByDefault(Return(true));
+    EXPECT_CALL(*mMockImagePreprocessing, preprocessImage).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, copyImageBuffer(_, 4, 2, 4, _)).Times(1);
+
+    // Process image twice, the second time from the checkpoint
+    mImageProcManager->setStageCheckpoints(stageCheckpoints);
+    EXPECT_EQ(mImageProcManager->getStageCheckpoints(), stageCheckpoints);
+    ASSERT_TRUE(mImageProcManager->processImage(""));
+    ASSERT_TRUE(mImageProcManager->processImage(""));
+
+    std::filesystem::remove_all(checkpointsDirectory);
+}
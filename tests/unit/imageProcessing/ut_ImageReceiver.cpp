@@ -5,9 +5,12 @@
 #include "imageProcessing/ImageReceiver.h"
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace testing;
 using namespace circuitSegmentation;
@@ -79,3 +82,300 @@ TEST_F(ImageReceiverTest, setsImageFilePath)
 
     EXPECT_EQ(filePath, mImageReceiver->getImageFilePath());
 }
+
+/**
+ * @brief Tests that when a page is set, only that page of the image file is read.
+ */
+TEST_F(ImageReceiverTest, receivesImagePageSuccessfully)
+{
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, readImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, readImagePage("sheets.tiff", 2)).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, isImageEmpty).Times(1).WillOnce(Return(false));
+
+    // Receive image
+    mImageReceiver->setImageFilePath("sheets.tiff");
+    mImageReceiver->setImagePage(2);
+    EXPECT_TRUE(mImageReceiver->receiveImage());
+}
+
+/**
+ * @brief Tests that the page is reset when the image file path is set, and the pages of the file are counted.
+ */
+TEST_F(ImageReceiverTest, setsImagePage)
+{
+    EXPECT_CALL(*mMockOpenCvWrapper, countImagePages("sheets.tiff")).Times(1).WillOnce(Return(3));
+
+    mImageReceiver->setImageFilePath("sheets.tiff");
+    mImageReceiver->setImagePage(1);
+    EXPECT_EQ(mImageReceiver->getImagePage(), 1);
+    EXPECT_EQ(mImageReceiver->getNumImagePages(), 3);
+
+    mImageReceiver->setImageFilePath("sheets.tiff");
+    EXPECT_EQ(mImageReceiver->getImagePage(), imageProcessing::ImageReceiver::cNoPage);
+}
+
+/**
+ * @brief Tests that the pages of a TIFF file are counted from its header, without OpenCV.
+ */
+TEST_F(ImageReceiverTest, countsImagePagesFromHeader)
+{
+    // Little-endian TIFF with two pages of 4x3 pixels (the second directory without entries)
+    const auto filePath{std::filesystem::temp_directory_path() / "cs_ut_image_receiver.tiff"};
+    {
+        const std::vector<unsigned char> tiff{'I',  'I',  0x2A, 0x00, 0x08, 0x00, 0x00, 0x00, 0x02, 0x00,
+                                              0x00, 0x01, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00,
+                                              0x00, 0x00, 0x01, 0x01, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00,
+                                              0x03, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                              0x00, 0x00, 0x00, 0x00};
+        std::ofstream file{filePath, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(tiff.data()), static_cast<std::streamsize>(tiff.size()));
+    }
+    mImageReceiver->setImageFilePath(filePath.string());
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, countImagePages).Times(0);
+
+    EXPECT_EQ(mImageReceiver->getNumImagePages(), 2);
+
+    imageProcessing::ImageInfo info{};
+    EXPECT_TRUE(mImageReceiver->probeImage(info));
+    EXPECT_EQ(info.mDimensions.mWidth, 4);
+    EXPECT_EQ(info.mDimensions.mHeight, 3);
+    EXPECT_EQ(info.mNumPages, 2);
+
+    std::filesystem::remove(filePath);
+}
+
+/**
+ * @brief Tests that the image is probed from the header of its buffer or from the buffer of raw pixels, without
+ * decoding it.
+ */
+TEST_F(ImageReceiverTest, probesImage)
+{
+    imageProcessing::ImageInfo info{};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, readImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, decodeImage).Times(0);
+
+    // No source
+    EXPECT_FALSE(mImageReceiver->probeImage(info));
+
+    // PGM in a buffer
+    const std::string pgm{"P5 640 480 255\n"};
+    mImageReceiver->setImageBuffer(std::vector<unsigned char>(pgm.begin(), pgm.end()));
+    EXPECT_TRUE(mImageReceiver->probeImage(info));
+    EXPECT_EQ(info.mDimensions.mWidth, 640);
+    EXPECT_EQ(info.mChannels, 1);
+    EXPECT_EQ(info.mDepth, 8);
+
+    // Raw pixels
+    const std::vector<unsigned char> pixels(4 * 2 * 4);
+    mImageReceiver->setRawImageBuffer(imageProcessing::RawImageBuffer{
+        .mData = pixels.data(),
+        .mWidth = 4,
+        .mHeight = 2,
+        .mStride = 16,
+        .mFormat = computerVision::OpenCvWrapper::PixelFormat::RGBA});
+    EXPECT_TRUE(mImageReceiver->probeImage(info));
+    EXPECT_EQ(info.mDimensions.mHeight, 2);
+    EXPECT_EQ(info.mChannels, 4);
+    EXPECT_EQ(info.mNumPages, 1);
+
+    // Nonexistent file
+    mImageReceiver->setImageFilePath("nonexistent.png");
+    EXPECT_FALSE(mImageReceiver->probeImage(info));
+}
+
+/**
+ * @brief Tests that when an image buffer is set, the image is decoded from the buffer instead of read from file.
+ */
+TEST_F(ImageReceiverTest, receivesImageFromBufferSuccessfully)
+{
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, readImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, decodeImage).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, isImageEmpty).Times(1).WillOnce(Return(false));
+
+    // Receive image
+    mImageReceiver->setImageBuffer({0x89, 'P', 'N', 'G'});
+    EXPECT_TRUE(mImageReceiver->receiveImage());
+}
+
+/**
+ * @brief Tests when the image decoded from the buffer is empty, the image is received unsuccessfully.
+ */
+TEST_F(ImageReceiverTest, receivesImageFromBufferUnsuccessfully)
+{
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, decodeImage).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, isImageEmpty).Times(1).WillOnce(Return(true));
+
+    // Receive image
+    mImageReceiver->setImageBuffer({0x00});
+    EXPECT_FALSE(mImageReceiver->receiveImage());
+}
+
+/**
+ * @brief Tests that when a buffer of raw pixels is set, the image is wrapped from the buffer.
+ */
+TEST_F(ImageReceiverTest, receivesImageFromRawBufferSuccessfully)
+{
+    const std::vector<unsigned char> pixels(4 * 2 * 3, 0);
+    const imageProcessing::RawImageBuffer buffer{
+        pixels.data(), 4, 2, 4 * 3, computerVision::OpenCvWrapper::PixelFormat::BGR};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, readImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, decodeImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper,
+                wrapImageBuffer(pixels.data(), 4, 2, 4 * 3, computerVision::OpenCvWrapper::PixelFormat::BGR))
+        .Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, isImageEmpty).Times(1).WillOnce(Return(false));
+
+    // Receive image
+    mImageReceiver->setRawImageBuffer(buffer);
+    EXPECT_TRUE(mImageReceiver->receiveImage());
+}
+
+/**
+ * @brief Tests when the image wrapped from the buffer of raw pixels is empty, the image is received unsuccessfully.
+ */
+TEST_F(ImageReceiverTest, receivesImageFromRawBufferUnsuccessfully)
+{
+    const std::vector<unsigned char> pixels(4, 0);
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, wrapImageBuffer).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, isImageEmpty).Times(1).WillOnce(Return(true));
+
+    // Receive image
+    mImageReceiver->setRawImageBuffer({pixels.data(), 4, 1, 1, computerVision::OpenCvWrapper::PixelFormat::GRAY});
+    EXPECT_FALSE(mImageReceiver->receiveImage());
+}
+
+/**
+ * @brief Tests that the image buffers and the image file path replace each other.
+ */
+TEST_F(ImageReceiverTest, setsImageBuffer)
+{
+    const std::vector<unsigned char> buffer{0x89, 'P', 'N', 'G'};
+
+    mImageReceiver->setImageFilePath("image.png");
+    mImageReceiver->setImageBuffer(buffer);
+    EXPECT_EQ(buffer, mImageReceiver->getImageBuffer());
+    EXPECT_TRUE(mImageReceiver->getImageFilePath().empty());
+
+    mImageReceiver->setImageFilePath("image.png");
+    EXPECT_TRUE(mImageReceiver->getImageBuffer().empty());
+
+    const std::vector<unsigned char> pixels(3, 0);
+    mImageReceiver->setImageBuffer(buffer);
+    mImageReceiver->setRawImageBuffer({pixels.data(), 1, 1, 3, computerVision::OpenCvWrapper::PixelFormat::BGR});
+    EXPECT_EQ(mImageReceiver->getRawImageBuffer().mData, pixels.data());
+    EXPECT_TRUE(mImageReceiver->getImageBuffer().empty());
+
+    mImageReceiver->setImageFilePath("image.png");
+    EXPECT_EQ(mImageReceiver->getRawImageBuffer().mData, nullptr);
+}
+
+/**
+ * @brief Tests that the image and the buffer with the encoded image are released.
+ */
+TEST_F(ImageReceiverTest, releasesImage)
+{
+    mImageReceiver->setImageBuffer(std::vector<unsigned char>(1024, 0));
+    mImageReceiver->releaseImage();
+
+    EXPECT_TRUE(mImageReceiver->getImageBuffer().empty());
+    EXPECT_EQ(mImageReceiver->getImageBuffer().capacity(), 0U);
+    EXPECT_TRUE(mImageReceiver->getImageReceived().empty());
+}
+
+/**
+ * @brief Tests that only the image wrapped from raw pixels in BGR format borrows the buffer.
+ */
+TEST_F(ImageReceiverTest, checksImageBorrowed)
+{
+    const std::vector<unsigned char> pixels(3, 0);
+
+    mImageReceiver->setRawImageBuffer({pixels.data(), 1, 1, 3, computerVision::OpenCvWrapper::PixelFormat::BGR});
+    EXPECT_TRUE(mImageReceiver->isImageBorrowed());
+
+    mImageReceiver->setRawImageBuffer({pixels.data(), 1, 1, 3, computerVision::OpenCvWrapper::PixelFormat::RGB});
+    EXPECT_FALSE(mImageReceiver->isImageBorrowed());
+
+    mImageReceiver->setImageFilePath("image.png");
+    EXPECT_FALSE(mImageReceiver->isImageBorrowed());
+}
+
+#ifdef __linux__
+/**
+ * @brief Tests that a PGM file is received from its pixels mapped in memory, without decoding, and that the image
+ * borrows them until it is released.
+ */
+TEST_F(ImageReceiverTest, receivesMappedPgmImage)
+{
+    const auto filePath{std::filesystem::temp_directory_path() / "cs_ut_image_receiver.pgm"};
+    {
+        std::ofstream file{filePath, std::ios::binary};
+        file << "P5 4 2 255\n" << std::string(8, '\x80');
+    }
+    mImageReceiver->setImageFilePath(filePath.string());
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, readImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, viewImageBuffer(_, 4, 2, 4, computerVision::OpenCvWrapper::cImageTypeGray))
+        .Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, isImageEmpty).Times(1).WillOnce(Return(false));
+
+    // Receive image
+    EXPECT_TRUE(mImageReceiver->receiveImage());
+    EXPECT_TRUE(mImageReceiver->isImageBorrowed());
+    EXPECT_EQ(mImageReceiver->getImageBinary().getSizeBytes(), 0U);
+
+    mImageReceiver->releaseImage();
+    EXPECT_FALSE(mImageReceiver->isImageBorrowed());
+
+    std::filesystem::remove(filePath);
+}
+
+/**
+ * @brief Tests that a PBM file is received as a binary image, with black lines on a white background for the image
+ * received.
+ */
+TEST_F(ImageReceiverTest, receivesMappedPbmImage)
+{
+    const auto filePath{std::filesystem::temp_directory_path() / "cs_ut_image_receiver.pbm"};
+    {
+        std::ofstream file{filePath, std::ios::binary};
+        file << "P4 10 2\n" << std::string{'\x80', '\x40', '\x00', '\x00'};
+    }
+    mImageReceiver->setImageFilePath(filePath.string());
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, readImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, copyImageBuffer(_, 10, 2, 10, computerVision::OpenCvWrapper::cImageTypeGray))
+        .Times(1)
+        .WillOnce([](const unsigned char* data, const int, const int, const std::size_t, const int) {
+            EXPECT_EQ(data[0], 0);
+            EXPECT_EQ(data[1], 255);
+            EXPECT_EQ(data[9], 0);
+            return computerVision::ImageMat{};
+        });
+    EXPECT_CALL(*mMockOpenCvWrapper, isImageEmpty).Times(1).WillOnce(Return(false));
+
+    // Receive image
+    EXPECT_TRUE(mImageReceiver->receiveImage());
+    EXPECT_FALSE(mImageReceiver->isImageBorrowed());
+
+    const auto imageBinary{mImageReceiver->getImageBinary()};
+    EXPECT_TRUE(imageBinary.getPixel(0, 0));
+    EXPECT_FALSE(imageBinary.getPixel(1, 0));
+    EXPECT_TRUE(imageBinary.getPixel(9, 0));
+    EXPECT_FALSE(imageBinary.getPixel(0, 1));
+
+    std::filesystem::remove(filePath);
+}
+#endif
@@ -9,9 +9,12 @@
 #include "mocks/schematicSegmentation/MockConnectionDetection.h"
 #include "mocks/schematicSegmentation/MockLabelDetection.h"
 #include "mocks/schematicSegmentation/MockSchematicSegmentation.h"
+#include <cstdint>
+#include <filesystem>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
 
 using namespace testing;
 using namespace circuitSegmentation;
@@ -31,10 +34,10 @@ protected:
     {
         mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
-        mMockComponentDetection = std::make_shared<NiceMock<MockComponentDetection>>(nullptr, nullptr);
-        mMockConnectionDetection = std::make_shared<NiceMock<MockConnectionDetection>>(nullptr, nullptr);
-        mMockLabelDetection = std::make_shared<NiceMock<MockLabelDetection>>(nullptr, nullptr);
-        mMockSchematicSegmentation = std::make_shared<NiceMock<MockSchematicSegmentation>>(nullptr, nullptr);
+        mMockComponentDetection = std::make_shared<NiceMock<MockComponentDetection>>(nullptr, nullptr, nullptr);
+        mMockConnectionDetection = std::make_shared<NiceMock<MockConnectionDetection>>(nullptr, nullptr, nullptr);
+        mMockLabelDetection = std::make_shared<NiceMock<MockLabelDetection>>(nullptr, nullptr, nullptr);
+        mMockSchematicSegmentation = std::make_shared<NiceMock<MockSchematicSegmentation>>(nullptr, nullptr, nullptr);
 
         mImageSegmentation = std::make_unique<imageProcessing::ImageSegmentation>(mMockOpenCvWrapper,
                                                                                   mLogger,
@@ -234,3 +237,96 @@ TEST_F(ImageSegmentationTest, setsSaveImages)
 
     EXPECT_EQ(saveImages, mImageSegmentation->getSaveImages());
 }
+
+/**
+ * @brief Tests that the preset is set in the detections.
+ */
+TEST_F(ImageSegmentationTest, setsPreset)
+{
+    constexpr auto preset{common::Preset::FAST};
+
+    // Setup expectations
+    EXPECT_CALL(*mMockComponentDetection, setPreset(preset)).Times(1);
+    EXPECT_CALL(*mMockConnectionDetection, setPreset(preset)).Times(1);
+    EXPECT_CALL(*mMockLabelDetection, setPreset(preset)).Times(1);
+
+    mImageSegmentation->setPreset(preset);
+
+    EXPECT_EQ(mImageSegmentation->getPreset(), preset);
+}
+
+/**
+ * @brief Tests that deterministic IDs are assigned to the elements segmented, with the dimensions of the image, only
+ * when enabled.
+ */
+TEST_F(ImageSegmentationTest, assignsDeterministicIds)
+{
+    constexpr auto imgWidth{640};
+    constexpr auto imgHeight{480};
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockConnectionDetection, detectConnections).WillByDefault(Return(true));
+    ON_CALL(*mMockComponentDetection, detectComponents).WillByDefault(Return(true));
+    ON_CALL(*mMockConnectionDetection, updateConnections).WillByDefault(Return(true));
+    ON_CALL(*mMockConnectionDetection, detectNodesUpdateConnections).WillByDefault(Return(true));
+    ON_CALL(*mMockSchematicSegmentation, updateDetectedComponents).WillByDefault(Return(true));
+    ON_CALL(*mMockOpenCvWrapper, getImageWidth).WillByDefault(Return(imgWidth));
+    ON_CALL(*mMockOpenCvWrapper, getImageHeight).WillByDefault(Return(imgHeight));
+    EXPECT_CALL(*mMockSchematicSegmentation, assignDeterministicIds(imgWidth, imgHeight)).Times(1);
+
+    // Segment image without and with deterministic IDs
+    ImageMat image{};
+    EXPECT_FALSE(mImageSegmentation->getDeterministicIds());
+    ASSERT_TRUE(mImageSegmentation->segmentImage(image, image));
+
+    mImageSegmentation->setDeterministicIds(true);
+    EXPECT_TRUE(mImageSegmentation->getDeterministicIds());
+    ASSERT_TRUE(mImageSegmentation->segmentImage(image, image));
+}
+
+/**
+ * @brief Tests that the elements detected are checkpointed, and restored from their checkpoint by the next
+ * segmentation of the same image, which only detects the labels.
+ */
+TEST_F(ImageSegmentationTest, resumesFromCheckpoint)
+{
+    constexpr std::uint64_t imageHash{0x42};
+    const std::vector<circuit::Component> components(1);
+    const std::vector<circuit::Connection> connections(2);
+    const std::vector<circuit::Node> nodes(1);
+
+    const auto checkpointsDirectory{std::filesystem::temp_directory_path() / "cs_ut_image_segmentation_checkpoints"};
+    std::filesystem::remove_all(checkpointsDirectory);
+    const auto stageCheckpoints{std::make_shared<imageProcessing::StageCheckpoints>(
+        checkpointsDirectory.string(), mMockOpenCvWrapper, mLogger)};
+    ASSERT_TRUE(stageCheckpoints->open());
+    mImageSegmentation->setCheckpoints(stageCheckpoints, imageHash);
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockSchematicSegmentation, getComponents).WillByDefault(ReturnRef(components));
+    ON_CALL(*mMockSchematicSegmentation, getConnections).WillByDefault(ReturnRef(connections));
+    ON_CALL(*mMockSchematicSegmentation, getNodes).WillByDefault(ReturnRef(nodes));
+    EXPECT_CALL(*mMockConnectionDetection, detectConnections).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockComponentDetection, detectComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockConnectionDetection, updateConnections).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockConnectionDetection, detectNodesUpdateConnections).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSchematicSegmentation, updateDetectedComponents).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockSchematicSegmentation, setElements)
+        .Times(1)
+        .WillOnce([&components, &connections, &nodes](std::vector<circuit::Component> componentsRestored,
+                                                      std::vector<circuit::Connection> connectionsRestored,
+                                                      std::vector<circuit::Node> nodesRestored) {
+            ASSERT_EQ(componentsRestored.size(), components.size());
+            EXPECT_EQ(componentsRestored[0].mId, components[0].mId);
+            EXPECT_EQ(connectionsRestored.size(), connections.size());
+            EXPECT_EQ(nodesRestored.size(), nodes.size());
+        });
+    EXPECT_CALL(*mMockLabelDetection, detectLabels).Times(2).WillRepeatedly(Return(true));
+
+    // Segment image twice, the second time from the checkpoint
+    ImageMat image{};
+    ASSERT_TRUE(mImageSegmentation->segmentImage(image, image));
+    ASSERT_TRUE(mImageSegmentation->segmentImage(image, image));
+
+    std::filesystem::remove_all(checkpointsDirectory);
+}
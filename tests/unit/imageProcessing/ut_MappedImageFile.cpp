@@ -0,0 +1,225 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/MappedImageFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+namespace {
+
+/**
+ * @brief Makes the contents of a file from a header and pixels.
+ *
+ * @param header Header.
+ * @param numPixelBytes Number of bytes of pixels after the header.
+ *
+ * @return Contents of the file.
+ */
+std::vector<unsigned char> makeFile(const std::string& header, const std::size_t numPixelBytes)
+{
+    std::vector<unsigned char> file(header.begin(), header.end());
+    file.resize(file.size() + numPixelBytes, 0xAA);
+
+    return file;
+}
+
+/**
+ * @brief Makes the contents of a raw image file.
+ *
+ * @param header Header.
+ * @param numPixelBytes Number of bytes of pixels after the header.
+ *
+ * @return Contents of the file.
+ */
+std::vector<unsigned char> makeRawFile(const imageProcessing::RawImageFileHeader& header,
+                                       const std::size_t numPixelBytes)
+{
+    std::vector<unsigned char> file(imageProcessing::MappedImageFile::cRawPixelsOffset + numPixelBytes, 0);
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    return file;
+}
+
+} // namespace
+
+/**
+ * @brief Tests that the layout of a binary PGM file is read, skipping its comments.
+ */
+TEST(MappedImageFileTest, readsPgmLayout)
+{
+    const std::string header{"P5\n# Scanner\n640 480\n255\n"};
+    const auto file{makeFile(header, 640 * 480)};
+    imageProcessing::MappedImageLayout layout{};
+
+    ASSERT_TRUE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    EXPECT_EQ(layout.mOffset, header.size());
+    EXPECT_EQ(layout.mWidth, 640);
+    EXPECT_EQ(layout.mHeight, 480);
+    EXPECT_EQ(layout.mStride, 640);
+    EXPECT_EQ(layout.mFormat, computerVision::OpenCvWrapper::PixelFormat::GRAY);
+    EXPECT_FALSE(layout.mBinary);
+}
+
+/**
+ * @brief Tests that the layout of a PBM file has its rows packed to whole bytes.
+ */
+TEST(MappedImageFileTest, readsPbmLayout)
+{
+    const std::string header{"P4 13 2\n"};
+    const auto file{makeFile(header, 2 * 2)};
+    imageProcessing::MappedImageLayout layout{};
+
+    ASSERT_TRUE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    EXPECT_EQ(layout.mOffset, header.size());
+    EXPECT_EQ(layout.mWidth, 13);
+    EXPECT_EQ(layout.mStride, 2);
+    EXPECT_TRUE(layout.mBinary);
+}
+
+/**
+ * @brief Tests that the layout of a binary PPM file is in RGB.
+ */
+TEST(MappedImageFileTest, readsPpmLayout)
+{
+    const auto file{makeFile("P6 4 4 255\n", 4 * 4 * 3)};
+    imageProcessing::MappedImageLayout layout{};
+
+    ASSERT_TRUE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    EXPECT_EQ(layout.mStride, 12);
+    EXPECT_EQ(layout.mFormat, computerVision::OpenCvWrapper::PixelFormat::RGB);
+}
+
+/**
+ * @brief Tests that the PNM files that cannot be used in place are not supported.
+ */
+TEST(MappedImageFileTest, doesNotReadUnsupportedPnmLayout)
+{
+    imageProcessing::MappedImageLayout layout{};
+
+    // 16 bits per pixel
+    auto file{makeFile("P5 4 4 65535\n", 4 * 4 * 2)};
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    // Pixels missing
+    file = makeFile("P5 4 4 255\n", 4 * 4 - 1);
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    // ASCII pixels
+    file = makeFile("P2 4 4 255\n", 4 * 4);
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    // Encoded image (PNG)
+    file = makeFile("\x89PNG\r\n\x1a\n", 64);
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+}
+
+/**
+ * @brief Tests that the layout of a raw image file is read from its header.
+ */
+TEST(MappedImageFileTest, readsRawLayout)
+{
+    const imageProcessing::RawImageFileHeader header{
+        .mMagic = imageProcessing::MappedImageFile::cRawMagic,
+        .mVersion = imageProcessing::MappedImageFile::cRawVersion,
+        .mFormat = static_cast<std::uint32_t>(computerVision::OpenCvWrapper::PixelFormat::BGR),
+        .mWidth = 10,
+        .mHeight = 3,
+        .mReserved = 0,
+        .mStride = 32};
+    // The last row without its padding
+    const auto file{makeRawFile(header, 32 * 2 + 30)};
+    imageProcessing::MappedImageLayout layout{};
+
+    ASSERT_TRUE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    EXPECT_EQ(layout.mOffset, imageProcessing::MappedImageFile::cRawPixelsOffset);
+    EXPECT_EQ(layout.mWidth, 10);
+    EXPECT_EQ(layout.mHeight, 3);
+    EXPECT_EQ(layout.mStride, 32);
+    EXPECT_EQ(layout.mFormat, computerVision::OpenCvWrapper::PixelFormat::BGR);
+    EXPECT_FALSE(layout.mBinary);
+}
+
+/**
+ * @brief Tests that an invalid raw image file header is not read.
+ */
+TEST(MappedImageFileTest, doesNotReadInvalidRawLayout)
+{
+    const imageProcessing::RawImageFileHeader header{
+        .mMagic = imageProcessing::MappedImageFile::cRawMagic,
+        .mVersion = imageProcessing::MappedImageFile::cRawVersion,
+        .mFormat = static_cast<std::uint32_t>(computerVision::OpenCvWrapper::PixelFormat::RGBA),
+        .mWidth = 10,
+        .mHeight = 3,
+        .mReserved = 0,
+        .mStride = 40};
+    imageProcessing::MappedImageLayout layout{};
+
+    // Pixels missing
+    auto file{makeRawFile(header, 40 * 3 - 1)};
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    // Stride smaller than a row
+    auto invalidHeader{header};
+    invalidHeader.mStride = 39;
+    file = makeRawFile(invalidHeader, 40 * 3);
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    // Unknown format
+    invalidHeader = header;
+    invalidHeader.mFormat = 5;
+    file = makeRawFile(invalidHeader, 40 * 3);
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+
+    // Other version
+    invalidHeader = header;
+    invalidHeader.mVersion = 2;
+    file = makeRawFile(invalidHeader, 40 * 3);
+    EXPECT_FALSE(imageProcessing::MappedImageFile::readLayout(file.data(), file.size(), layout));
+}
+
+#ifdef __linux__
+/**
+ * @brief Tests that a PGM file is mapped, with its pixels in place, and that other files are not mapped.
+ */
+TEST(MappedImageFileTest, mapsPgmFile)
+{
+    const auto filePath{std::filesystem::temp_directory_path() / "cs_ut_mapped_image_file.pgm"};
+    const std::string header{"P5 3 2 255\n"};
+    {
+        std::ofstream file{filePath, std::ios::binary};
+        file << header << "abcdef";
+    }
+
+    {
+        const imageProcessing::MappedImageFile mappedFile{filePath.string()};
+
+        ASSERT_TRUE(mappedFile.isMapped());
+        EXPECT_EQ(mappedFile.getLayout().mWidth, 3);
+        EXPECT_EQ(std::string(reinterpret_cast<const char*>(mappedFile.getPixels()), 6), "abcdef");
+    }
+
+    // Unsupported format
+    {
+        std::ofstream file{filePath, std::ios::binary};
+        file << "P2 3 2 255\n1 2 3 4 5 6";
+    }
+    EXPECT_FALSE(imageProcessing::MappedImageFile{filePath.string()}.isMapped());
+
+    // Missing file
+    std::filesystem::remove(filePath);
+    EXPECT_FALSE(imageProcessing::MappedImageFile{filePath.string()}.isMapped());
+    EXPECT_EQ(imageProcessing::MappedImageFile{filePath.string()}.getPixels(), nullptr);
+}
+#endif
@@ -0,0 +1,273 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/NearDuplicateIndex.h"
+#include "logging/Logger.h"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of NearDuplicateIndex.
+ */
+class NearDuplicateIndexTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+        mIndexDirectory = std::filesystem::temp_directory_path() / "cs_ut_near_duplicate_index";
+        std::filesystem::remove_all(mIndexDirectory);
+        std::filesystem::create_directories(mIndexDirectory);
+        mIndexFilePath = (mIndexDirectory / imageProcessing::NearDuplicateIndex::cIndexFile).string();
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mIndexDirectory);
+    }
+
+    /**
+     * @brief Makes the grayscale thumbnail of a schematic: a loop of wires with a component in its left side.
+     *
+     * @param shiftX Shift of the x coordinates of the schematic, in pixels of the thumbnail.
+     * @param shiftY Shift of the y coordinates of the schematic, in pixels of the thumbnail.
+     * @param background Gray level of the background (the exposure).
+     *
+     * @return Thumbnail.
+     */
+    static std::vector<unsigned char> makeThumbnail(const int shiftX, const int shiftY, const unsigned char background)
+    {
+        constexpr int size{imageProcessing::ImageFingerprint::cThumbnailSize};
+
+        std::vector<unsigned char> thumbnail(size * size, background);
+        const auto setPixel = [&](const int column, const int row) {
+            if (column + shiftX >= 0 && column + shiftX < size && row + shiftY >= 0 && row + shiftY < size) {
+                thumbnail.at((row + shiftY) * size + column + shiftX) = 20;
+            }
+        };
+        for (int i{6}; i <= 25; ++i) {
+            setPixel(i, 6);
+            setPixel(i, 25);
+            setPixel(6, i);
+            setPixel(25, i);
+        }
+        for (int row{12}; row <= 18; ++row) {
+            for (int column{4}; column <= 8; ++column) {
+                setPixel(column, row);
+            }
+        }
+
+        return thumbnail;
+    }
+
+protected:
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Folder of the index. */
+    std::filesystem::path mIndexDirectory;
+    /** Path of the index file. */
+    std::string mIndexFilePath;
+};
+
+/**
+ * @brief Tests that the fingerprint has the foreground of the thumbnail, regardless of the exposure.
+ */
+TEST_F(NearDuplicateIndexTest, makesFingerprint)
+{
+    const auto fingerprint{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(0, 0, 220), 640, 480)};
+    const auto fingerprintBrighter{
+        imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(0, 0, 250), 640, 480)};
+
+    EXPECT_EQ(fingerprint.mWidth, 640);
+    EXPECT_EQ(fingerprint.mHeight, 480);
+    EXPECT_TRUE(fingerprint.mThumbnail.test(6 * imageProcessing::ImageFingerprint::cThumbnailSize + 10));
+    EXPECT_FALSE(fingerprint.mThumbnail.test(0));
+    EXPECT_NE(fingerprint.mHash, 0);
+    EXPECT_EQ(fingerprint.mHash, fingerprintBrighter.mHash);
+    EXPECT_EQ(fingerprint.mThumbnail, fingerprintBrighter.mThumbnail);
+}
+
+/**
+ * @brief Tests that the fingerprint of a blank image has no foreground.
+ */
+TEST_F(NearDuplicateIndexTest, makesFingerprintOfBlankImage)
+{
+    constexpr int size{imageProcessing::ImageFingerprint::cThumbnailSize};
+
+    const auto fingerprint{
+        imageProcessing::NearDuplicateIndex::makeFingerprint(std::vector<unsigned char>(size * size, 200), 640, 480)};
+
+    EXPECT_TRUE(fingerprint.mThumbnail.none());
+    EXPECT_EQ(fingerprint.mHash, 0);
+}
+
+/**
+ * @brief Tests that the fingerprint of a shifted image is aligned, with the transform of its coordinates.
+ */
+TEST_F(NearDuplicateIndexTest, alignsShiftedFingerprint)
+{
+    const auto prior{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(0, 0, 220), 640, 480)};
+    const auto current{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(2, -1, 230), 640, 480)};
+
+    imageProcessing::ImageTransform transform{};
+    const auto aligned{imageProcessing::NearDuplicateIndex::alignFingerprints(
+        prior, current, imageProcessing::NearDuplicateIndex::cMinOverlapDefault, transform)};
+
+    EXPECT_TRUE(aligned);
+    EXPECT_DOUBLE_EQ(transform.mScaleX, 1.0);
+    EXPECT_DOUBLE_EQ(transform.mScaleY, 1.0);
+    EXPECT_DOUBLE_EQ(transform.mOffsetX, 40.0);
+    EXPECT_DOUBLE_EQ(transform.mOffsetY, -15.0);
+}
+
+/**
+ * @brief Tests that the fingerprint of another schematic is not aligned.
+ */
+TEST_F(NearDuplicateIndexTest, doesNotAlignOtherFingerprint)
+{
+    constexpr int size{imageProcessing::ImageFingerprint::cThumbnailSize};
+
+    // A diagonal wire
+    std::vector<unsigned char> thumbnail(size * size, 220);
+    for (int i{0}; i < size; ++i) {
+        thumbnail.at(i * size + i) = 20;
+    }
+
+    const auto prior{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(0, 0, 220), 640, 480)};
+    const auto current{imageProcessing::NearDuplicateIndex::makeFingerprint(thumbnail, 640, 480)};
+
+    imageProcessing::ImageTransform transform{};
+    const auto aligned{imageProcessing::NearDuplicateIndex::alignFingerprints(
+        prior, current, imageProcessing::NearDuplicateIndex::cMinOverlapDefault, transform)};
+
+    EXPECT_FALSE(aligned);
+}
+
+/**
+ * @brief Tests that the near-duplicates found are processed as the image, without the image itself.
+ */
+TEST_F(NearDuplicateIndexTest, findsNearDuplicatesProcessedAsImage)
+{
+    const auto prior{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(0, 0, 220), 640, 480)};
+    const auto current{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(1, 0, 200), 640, 480)};
+
+    imageProcessing::NearDuplicateIndex nearDuplicateIndex{mIndexFilePath, mLogger};
+    ASSERT_TRUE(nearDuplicateIndex.open());
+    nearDuplicateIndex.add("0000000000000001_balanced", prior);
+    nearDuplicateIndex.add("0000000000000001_fast", prior);
+    nearDuplicateIndex.add("0000000000000002_balanced", current);
+
+    const auto nearDuplicates{nearDuplicateIndex.find(current, "0000000000000002_balanced")};
+
+    ASSERT_EQ(nearDuplicates.size(), 1);
+    EXPECT_EQ(nearDuplicates.at(0).mKey, "0000000000000001_balanced");
+    EXPECT_DOUBLE_EQ(nearDuplicates.at(0).mTransform.mOffsetX, 20.0);
+}
+
+/**
+ * @brief Tests that the fingerprints removed are not found.
+ */
+TEST_F(NearDuplicateIndexTest, doesNotFindRemovedFingerprints)
+{
+    const auto fingerprint{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(0, 0, 220), 640, 480)};
+
+    imageProcessing::NearDuplicateIndex nearDuplicateIndex{mIndexFilePath, mLogger};
+    ASSERT_TRUE(nearDuplicateIndex.open());
+    nearDuplicateIndex.add("0000000000000001_balanced", fingerprint);
+    nearDuplicateIndex.remove("0000000000000001_balanced");
+
+    EXPECT_EQ(nearDuplicateIndex.getNumEntries(), 0);
+    EXPECT_TRUE(nearDuplicateIndex.find(fingerprint, "0000000000000002_balanced").empty());
+}
+
+/**
+ * @brief Tests that the fingerprints added are read by an index opened later (e.g. by the next run).
+ */
+TEST_F(NearDuplicateIndexTest, readsFingerprintsOfPreviousRuns)
+{
+    const auto fingerprint{imageProcessing::NearDuplicateIndex::makeFingerprint(makeThumbnail(0, 0, 220), 640, 480)};
+    {
+        imageProcessing::NearDuplicateIndex nearDuplicateIndex{mIndexFilePath, mLogger};
+        ASSERT_TRUE(nearDuplicateIndex.open());
+        nearDuplicateIndex.add("0000000000000001_balanced", fingerprint);
+    }
+
+    imageProcessing::NearDuplicateIndex nearDuplicateIndex{mIndexFilePath, mLogger};
+    ASSERT_TRUE(nearDuplicateIndex.open());
+
+    EXPECT_EQ(nearDuplicateIndex.getNumEntries(), 1);
+    const auto nearDuplicates{nearDuplicateIndex.find(fingerprint, "0000000000000002_balanced")};
+    ASSERT_EQ(nearDuplicates.size(), 1);
+    EXPECT_EQ(nearDuplicates.at(0).mKey, "0000000000000001_balanced");
+    EXPECT_EQ(nearDuplicates.at(0).mDistance, 0);
+}
+
+/**
+ * @brief Tests that the positions of the segmentation map and the ROI of the images are transformed.
+ */
+TEST_F(NearDuplicateIndexTest, transformsResult)
+{
+    imageProcessing::CachedResult result{};
+    result.mSegmentationMap["components"] = nlohmann::ordered_json::array(
+        {{{"id", "R1"},
+          {"position", {{"x", 100}, {"y", 50}}},
+          {"label", {{"id", "L1"}, {"position", {{"x", 0}, {"y", 0}}}}}}});
+    result.mSegmentationMap["nodes"] =
+        nlohmann::ordered_json::array({{{"id", "N1"}, {"position", {{"x", 10}, {"y", 20}}}}});
+    schematicSegmentation::RoiImage roiImage{};
+    roiImage.mRoi = computerVision::Rectangle{10, 20, 30, 40};
+    result.mRoiImages.push_back(roiImage);
+
+    imageProcessing::NearDuplicateIndex::transformResult(
+        imageProcessing::ImageTransform{2.0, 1.0, 5.0, -10.0}, result, 1000, 1000);
+
+    const auto& component{result.mSegmentationMap["components"][0]};
+    EXPECT_EQ(component["position"]["x"], 205);
+    EXPECT_EQ(component["position"]["y"], 40);
+    EXPECT_EQ(component["label"]["position"]["x"], 0);
+    EXPECT_EQ(component["label"]["position"]["y"], 0);
+    EXPECT_EQ(result.mSegmentationMap["nodes"][0]["position"]["x"], 25);
+    EXPECT_EQ(result.mSegmentationMap["nodes"][0]["position"]["y"], 10);
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.x, 25);
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.y, 10);
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.width, 60);
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.height, 40);
+}
+
+/**
+ * @brief Tests that the ROI of the images are clipped to the image, and removed when outside of it.
+ */
+TEST_F(NearDuplicateIndexTest, clipsRoiOfResultToImage)
+{
+    imageProcessing::CachedResult result{};
+    schematicSegmentation::RoiImage roiImage{};
+    roiImage.mElementId = "R1";
+    roiImage.mRoi = computerVision::Rectangle{90, 40, 30, 20};
+    result.mRoiImages.push_back(roiImage);
+    roiImage.mElementId = "R2";
+    roiImage.mRoi = computerVision::Rectangle{150, 10, 10, 10};
+    result.mRoiImages.push_back(roiImage);
+
+    imageProcessing::NearDuplicateIndex::transformResult(
+        imageProcessing::ImageTransform{1.0, 1.0, 0.0, 0.0}, result, 100, 50);
+
+    ASSERT_EQ(result.mRoiImages.size(), 1);
+    EXPECT_EQ(result.mRoiImages.at(0).mElementId, "R1");
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.x, 90);
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.y, 40);
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.width, 10);
+    EXPECT_EQ(result.mRoiImages.at(0).mRoi.height, 10);
+}
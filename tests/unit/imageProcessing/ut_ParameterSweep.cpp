@@ -0,0 +1,224 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/ParameterSweep.h"
+#include "logging/Logger.h"
+#include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "mocks/imageProcessing/MockImageReceiver.h"
+#include <filesystem>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::computerVision;
+using namespace circuitSegmentation::imageProcessing;
+
+/**
+ * @brief Test class of ParameterSweep.
+ */
+class ParameterSweepTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+        mMockImageReceiver = std::make_shared<NiceMock<MockImageReceiver>>(mMockOpenCvWrapper, mLogger);
+        mImageWriter = std::make_shared<output::ImageWriter>(mMockOpenCvWrapper, mLogger);
+        mSweepDirectory = std::filesystem::temp_directory_path() / "cs_ut_parameter_sweep";
+        std::filesystem::remove_all(mSweepDirectory);
+        std::filesystem::create_directories(mSweepDirectory);
+
+        mParameterSweep
+            = std::make_unique<ParameterSweep>(mMockImageReceiver, mMockOpenCvWrapper, mImageWriter, mLogger, 2);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mSweepDirectory);
+    }
+
+protected:
+    /** Parameter sweep. */
+    std::unique_ptr<ParameterSweep> mParameterSweep;
+    /** Image receiver. */
+    std::shared_ptr<NiceMock<MockImageReceiver>> mMockImageReceiver;
+    /** OpenCV wrapper. */
+    std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Folder of the files of the sweep. */
+    std::filesystem::path mSweepDirectory;
+};
+
+/**
+ * @brief Tests that the combinations are the cartesian product of the values, ordered by the stages, over the
+ * parameters of the preset.
+ */
+TEST_F(ParameterSweepTest, parsesConfig)
+{
+    const auto config = nlohmann::ordered_json::parse(R"({
+        "images": ["a.png", "b.png"],
+        "preset": "fast",
+        "parameters": {
+            "labelBoxMinArea": [40, 60],
+            "thresholdBlockSize": [15, 21],
+            "connectionMinLength": [10, 20, 30]
+        }
+    })");
+
+    ASSERT_TRUE(mParameterSweep->parseConfig(config, common::Preset::BALANCED));
+
+    EXPECT_EQ(mParameterSweep->getImagePaths(), (std::vector<std::string>{"a.png", "b.png"}));
+    EXPECT_EQ(mParameterSweep->getOutputPath(), ParameterSweep::cDefaultOutputPath);
+    EXPECT_EQ(mParameterSweep->getNumCombinations(), 12U);
+    EXPECT_EQ(mParameterSweep->getNumVariants(ParameterSweep::SweepStage::PREPROCESSING), 2U);
+    EXPECT_EQ(mParameterSweep->getNumVariants(ParameterSweep::SweepStage::CONNECTIONS), 6U);
+    EXPECT_EQ(mParameterSweep->getNumVariants(ParameterSweep::SweepStage::COMPONENTS), 6U);
+    EXPECT_EQ(mParameterSweep->getNumVariants(ParameterSweep::SweepStage::LABELS), 12U);
+
+    // The parameters of the last stages vary first
+    const auto first{mParameterSweep->getCombination(0)};
+    EXPECT_EQ(first.mPreprocessing.mThresholdBlockSize, 15);
+    EXPECT_DOUBLE_EQ(first.mConnectionDetection.mConnectionMinLength, 10);
+    EXPECT_EQ(first.mLabelDetection.mBoxMinArea, 40);
+    EXPECT_EQ(mParameterSweep->getCombination(1).mLabelDetection.mBoxMinArea, 60);
+    EXPECT_DOUBLE_EQ(mParameterSweep->getCombination(2).mConnectionDetection.mConnectionMinLength, 20);
+    const auto last{mParameterSweep->getCombination(11)};
+    EXPECT_EQ(last.mPreprocessing.mThresholdBlockSize, 21);
+    EXPECT_DOUBLE_EQ(last.mConnectionDetection.mConnectionMinLength, 30);
+    EXPECT_EQ(last.mLabelDetection.mBoxMinArea, 60);
+
+    // Parameters not swept
+    const auto fastPreprocessing{ImagePreprocessing::getParameters(common::Preset::FAST)};
+    EXPECT_EQ(first.mPreprocessing.mFilterKernelSize, fastPreprocessing.mFilterKernelSize);
+    EXPECT_EQ(first.mComponentDetection.mBoxMinArea, schematicSegmentation::ComponentDetection::cBoxMinArea);
+}
+
+/**
+ * @brief Tests that an invalid configuration is rejected.
+ */
+TEST_F(ParameterSweepTest, rejectsInvalidConfig)
+{
+    const std::vector<std::string> configs{
+        R"([])",
+        R"({"parameters": {}})",
+        R"({"images": ["a.png"], "preset": "fastest"})",
+        R"({"images": ["a.png"], "parameters": {"unknown": [1]}})",
+        R"({"images": ["a.png"], "parameters": {"thresholdBlockSize": [20]}})",
+        R"({"images": ["a.png"], "parameters": {"componentBoxMinArea": [100.5]}})",
+        R"({"images": ["a.png"], "parameters": {"connectionMinLength": []}})",
+        R"({"images": ["a.png"], "parameters": {"connectionMinLength": ["10"]}})",
+        R"({"images": ["a.png"], "output": ""})",
+    };
+
+    for (const auto& config : configs) {
+        EXPECT_FALSE(mParameterSweep->parseConfig(nlohmann::ordered_json::parse(config), common::Preset::BALANCED))
+            << config;
+    }
+}
+
+/**
+ * @brief Tests that the folders of images are expanded to their files, in order.
+ */
+TEST_F(ParameterSweepTest, expandsImageFolders)
+{
+    std::ofstream{mSweepDirectory / "b.png"} << "b";
+    std::ofstream{mSweepDirectory / "a.png"} << "a";
+    const auto configPath{mSweepDirectory / "sweep.json"};
+    std::ofstream{configPath} << nlohmann::ordered_json{{"images", {mSweepDirectory.string(), "c.png"}},
+                                                        {"output", "results.csv"}};
+
+    ASSERT_TRUE(mParameterSweep->loadConfig(configPath.string(), common::Preset::BALANCED));
+
+    EXPECT_EQ(mParameterSweep->getImagePaths(),
+              (std::vector<std::string>{(mSweepDirectory / "a.png").string(),
+                                        (mSweepDirectory / "b.png").string(),
+                                        configPath.string(),
+                                        "c.png"}));
+    EXPECT_EQ(mParameterSweep->getOutputPath(), "results.csv");
+    EXPECT_EQ(mParameterSweep->getNumCombinations(), 1U);
+    EXPECT_FALSE(mParameterSweep->loadConfig(configPath.string() + ".missing", common::Preset::BALANCED));
+}
+
+/**
+ * @brief Tests that each upstream result is computed once for all the combinations that share it, and that the
+ * results are written for each combination.
+ */
+TEST_F(ParameterSweepTest, sharesUpstreamResults)
+{
+    const auto outputPath{mSweepDirectory / "sweep.csv"};
+    auto config = nlohmann::ordered_json::parse(R"({
+        "images": ["a.png"],
+        "parameters": {
+            "thresholdBlockSize": [15, 21],
+            "connectionMinLength": [10, 20],
+            "componentBoxMinArea": [100, 200, 300]
+        }
+    })");
+    config["output"] = outputPath.string();
+    ASSERT_TRUE(mParameterSweep->parseConfig(config, common::Preset::BALANCED));
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockImageReceiver, receiveImage).WillByDefault(Return(true));
+    EXPECT_CALL(*mMockImageReceiver, setImageFilePath("a.png")).Times(1);
+    // Preprocessing once for each block size
+    EXPECT_CALL(*mMockOpenCvWrapper, adaptiveThresholdImage(_, _, _, _, _, 15, _)).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, adaptiveThresholdImage(_, _, _, _, _, 21, _)).Times(1);
+    // Detection of connections once for each block size and minimum length (two searches of contours each), where
+    // no connections are found, so the components are not detected
+    EXPECT_CALL(*mMockOpenCvWrapper, findContours).Times(2 * 2 * 2);
+
+    ASSERT_TRUE(mParameterSweep->run());
+
+    const auto& results{mParameterSweep->getResults()};
+    ASSERT_EQ(results.size(), 12U);
+    for (std::size_t i{0}; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].mImagePath, "a.png");
+        EXPECT_EQ(results[i].mCombination, i);
+        EXPECT_FALSE(results[i].mSuccess);
+    }
+
+    // Header and a row for each combination
+    std::ifstream outputFile{outputPath};
+    std::vector<std::string> lines{};
+    for (std::string line{}; std::getline(outputFile, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 13U);
+    EXPECT_EQ(lines[0].rfind("image,combination,filterKernelSize,thresholdBlockSize,", 0), 0U);
+    EXPECT_EQ(lines[1].rfind("a.png,0,9,15,4,11,4,10,7,3,100,", 0), 0U);
+    EXPECT_EQ(lines[12].rfind("a.png,11,9,21,4,11,4,20,7,3,300,", 0), 0U);
+}
+
+/**
+ * @brief Tests that an image that is not received is skipped.
+ */
+TEST_F(ParameterSweepTest, skipsImagesNotReceived)
+{
+    auto config = nlohmann::ordered_json::parse(R"({"images": ["a.png"]})");
+    config["output"] = (mSweepDirectory / "sweep.csv").string();
+    ASSERT_TRUE(mParameterSweep->parseConfig(config, common::Preset::BALANCED));
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockImageReceiver, receiveImage).WillByDefault(Return(false));
+    EXPECT_CALL(*mMockOpenCvWrapper, adaptiveThresholdImage).Times(0);
+
+    EXPECT_FALSE(mParameterSweep->run());
+    EXPECT_TRUE(mParameterSweep->getResults().empty());
+    EXPECT_TRUE(std::filesystem::exists(mSweepDirectory / "sweep.csv"));
+}
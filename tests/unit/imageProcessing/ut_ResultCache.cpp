@@ -0,0 +1,232 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/ResultCache.h"
+#include "logging/Logger.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Test class of ResultCache.
+ */
+class ResultCacheTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+        mCacheDirectory = std::filesystem::temp_directory_path() / "cs_ut_result_cache";
+        std::filesystem::remove_all(mCacheDirectory);
+
+        mSegmentationMap["components"] = nlohmann::ordered_json::array({{{"id", "R1"}}});
+
+        schematicSegmentation::RoiImage roiImage{};
+        roiImage.mKind = schematicSegmentation::RoiImage::Kind::LABEL;
+        roiImage.mElementId = "R1";
+        roiImage.mIndex = 1;
+        roiImage.mRoi = computerVision::Rectangle{10, 20, 30, 40};
+        roiImage.mFileName = "roi_label_R1_1.png";
+        roiImage.mEncodedImage = std::vector<unsigned char>(100, 0xAB);
+        mRoiImages.push_back(roiImage);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mCacheDirectory);
+    }
+
+protected:
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Cache folder. */
+    std::filesystem::path mCacheDirectory;
+    /** Segmentation map of the results. */
+    nlohmann::ordered_json mSegmentationMap{};
+    /** Images with ROI of the results. */
+    std::vector<schematicSegmentation::RoiImage> mRoiImages{};
+};
+
+/**
+ * @brief Tests that the key depends on the hash of the image, on the preset and on the deterministic IDs.
+ */
+TEST_F(ResultCacheTest, makesKey)
+{
+    EXPECT_EQ(imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST), "0000000000001234_fast");
+    EXPECT_NE(imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST),
+              imageProcessing::ResultCache::makeKey(0x1234, common::Preset::ACCURATE));
+    EXPECT_EQ(imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, true),
+              "0000000000001234_fast_deterministic");
+}
+
+/**
+ * @brief Tests that the key of a result segmented by tiles or preprocessed by bands differs from the whole image.
+ */
+TEST_F(ResultCacheTest, makesKeyOfTilesAndBands)
+{
+    const auto wholeKey{imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, false, 0, 0)};
+    const auto tiledKey{imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, false, 1024, 0)};
+    const auto bandKey{imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, false, 0, 256)};
+
+    EXPECT_EQ(wholeKey, "0000000000001234_fast");
+    EXPECT_EQ(tiledKey, "0000000000001234_fast_tile1024");
+    EXPECT_EQ(bandKey, "0000000000001234_fast_band256");
+    EXPECT_NE(tiledKey, imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, false, 2048, 0));
+    EXPECT_NE(bandKey, imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, false, 0, 128));
+    EXPECT_EQ(imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, true, 1024, 0),
+              "0000000000001234_fast_deterministic_tile1024");
+}
+
+/**
+ * @brief Tests that a result of the whole image is not found for the image segmented by tiles, and the reverse.
+ */
+TEST_F(ResultCacheTest, keepsResultsOfTilesApart)
+{
+    imageProcessing::ResultCache resultCache{mCacheDirectory.string(), 1024 * 1024, mLogger};
+    const auto wholeKey{imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST)};
+    const auto tiledKey{imageProcessing::ResultCache::makeKey(0x1234, common::Preset::FAST, false, 1024)};
+    ASSERT_TRUE(resultCache.open());
+
+    ASSERT_TRUE(resultCache.store(wholeKey, mSegmentationMap, mRoiImages, ""));
+
+    imageProcessing::CachedResult cachedResult{};
+    EXPECT_FALSE(resultCache.find(tiledKey, cachedResult));
+    EXPECT_TRUE(resultCache.find(wholeKey, cachedResult));
+}
+
+/**
+ * @brief Tests that a result stored is found, with its segmentation map and images with ROI, and counted as a hit.
+ */
+TEST_F(ResultCacheTest, findsResultStored)
+{
+    imageProcessing::ResultCache resultCache{mCacheDirectory.string(), 1024 * 1024, mLogger};
+    ASSERT_TRUE(resultCache.open());
+
+    imageProcessing::CachedResult result{};
+    EXPECT_FALSE(resultCache.find("key", result));
+    EXPECT_TRUE(resultCache.store("key", mSegmentationMap, mRoiImages, ""));
+    ASSERT_TRUE(resultCache.find("key", result));
+
+    EXPECT_EQ(result.mSegmentationMap, mSegmentationMap);
+    ASSERT_EQ(result.mRoiImages.size(), 1U);
+    EXPECT_EQ(result.mRoiImages[0].mKind, schematicSegmentation::RoiImage::Kind::LABEL);
+    EXPECT_EQ(result.mRoiImages[0].mElementId, "R1");
+    EXPECT_EQ(result.mRoiImages[0].mIndex, 1U);
+    EXPECT_EQ(result.mRoiImages[0].mRoi.x, 10);
+    EXPECT_EQ(result.mRoiImages[0].mRoi.height, 40);
+    EXPECT_EQ(result.mRoiImages[0].mFileName, "roi_label_R1_1.png");
+    EXPECT_EQ(result.mRoiImages[0].mEncodedImage, mRoiImages[0].mEncodedImage);
+
+    const auto statistics{resultCache.getStatistics()};
+    EXPECT_EQ(statistics.mHits, 1U);
+    EXPECT_EQ(statistics.mMisses, 1U);
+    EXPECT_EQ(statistics.mStores, 1U);
+    EXPECT_EQ(statistics.mEntries, 1U);
+    EXPECT_GT(statistics.mBytes, 100U);
+    EXPECT_DOUBLE_EQ(resultCache.getHitRate(), 0.5);
+}
+
+/**
+ * @brief Tests that the images with ROI that are not encoded are copied from their files.
+ */
+TEST_F(ResultCacheTest, storesRoiImageFiles)
+{
+    const auto sourceDirectory{mCacheDirectory / "source"};
+    std::filesystem::create_directories(sourceDirectory);
+    std::ofstream{sourceDirectory / mRoiImages[0].mFileName} << "png";
+    mRoiImages[0].mEncodedImage.clear();
+
+    imageProcessing::ResultCache resultCache{(mCacheDirectory / "cache").string(), 1024 * 1024, mLogger};
+    ASSERT_TRUE(resultCache.open());
+    EXPECT_TRUE(resultCache.store("key", mSegmentationMap, mRoiImages, sourceDirectory.string()));
+
+    imageProcessing::CachedResult result{};
+    ASSERT_TRUE(resultCache.find("key", result));
+    ASSERT_EQ(result.mRoiImages.size(), 1U);
+    EXPECT_EQ(std::string(result.mRoiImages[0].mEncodedImage.begin(), result.mRoiImages[0].mEncodedImage.end()),
+              "png");
+
+    // Files missing
+    EXPECT_FALSE(resultCache.store("other", mSegmentationMap, mRoiImages, mCacheDirectory.string()));
+    EXPECT_FALSE(resultCache.find("other", result));
+}
+
+/**
+ * @brief Tests that the least recently used results are evicted when a result does not fit.
+ */
+TEST_F(ResultCacheTest, evictsLeastRecentlyUsed)
+{
+    std::size_t resultBytes{0};
+    {
+        imageProcessing::ResultCache probeCache{mCacheDirectory.string(), 1024 * 1024, mLogger};
+        ASSERT_TRUE(probeCache.open());
+        ASSERT_TRUE(probeCache.store("probe", mSegmentationMap, mRoiImages, ""));
+        resultBytes = probeCache.getStatistics().mBytes;
+    }
+    std::filesystem::remove_all(mCacheDirectory);
+
+    // Room for two results
+    imageProcessing::ResultCache resultCache{mCacheDirectory.string(), resultBytes * 2, mLogger};
+    ASSERT_TRUE(resultCache.open());
+    EXPECT_TRUE(resultCache.store("first", mSegmentationMap, mRoiImages, ""));
+    EXPECT_TRUE(resultCache.store("second", mSegmentationMap, mRoiImages, ""));
+
+    imageProcessing::CachedResult result{};
+    EXPECT_TRUE(resultCache.find("first", result));
+    EXPECT_TRUE(resultCache.store("third", mSegmentationMap, mRoiImages, ""));
+
+    EXPECT_TRUE(resultCache.find("first", result));
+    EXPECT_FALSE(resultCache.find("second", result));
+    EXPECT_TRUE(resultCache.find("third", result));
+    EXPECT_FALSE(std::filesystem::exists(mCacheDirectory / "second"));
+    EXPECT_EQ(resultCache.getStatistics().mEvictions, 1U);
+    EXPECT_LE(resultCache.getStatistics().mBytes, resultBytes * 2);
+}
+
+/**
+ * @brief Tests that a result larger than the cache is not stored.
+ */
+TEST_F(ResultCacheTest, doesNotStoreOversizedResult)
+{
+    imageProcessing::ResultCache resultCache{mCacheDirectory.string(), 50, mLogger};
+    ASSERT_TRUE(resultCache.open());
+
+    EXPECT_FALSE(resultCache.store("key", mSegmentationMap, mRoiImages, ""));
+    EXPECT_EQ(resultCache.getStatistics().mEntries, 0U);
+}
+
+/**
+ * @brief Tests that the results persist across runs, and that incomplete results are removed.
+ */
+TEST_F(ResultCacheTest, persistsResults)
+{
+    {
+        imageProcessing::ResultCache resultCache{mCacheDirectory.string(), 1024 * 1024, mLogger};
+        ASSERT_TRUE(resultCache.open());
+        ASSERT_TRUE(resultCache.store("key", mSegmentationMap, mRoiImages, ""));
+    }
+    std::filesystem::create_directories(mCacheDirectory / ".interrupted.1");
+    std::filesystem::create_directories(mCacheDirectory / "incomplete");
+
+    imageProcessing::ResultCache resultCache{mCacheDirectory.string(), 1024 * 1024, mLogger};
+    ASSERT_TRUE(resultCache.open());
+
+    imageProcessing::CachedResult result{};
+    EXPECT_TRUE(resultCache.find("key", result));
+    EXPECT_EQ(resultCache.getStatistics().mEntries, 1U);
+    EXPECT_FALSE(std::filesystem::exists(mCacheDirectory / ".interrupted.1"));
+    EXPECT_FALSE(std::filesystem::exists(mCacheDirectory / "incomplete"));
+}
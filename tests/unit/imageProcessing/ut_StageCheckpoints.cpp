@@ -0,0 +1,254 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/StageCheckpoints.h"
+#include "logging/Logger.h"
+#include "mocks/computerVision/MockOpenCvWrapper.h"
+#include <filesystem>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::computerVision;
+using namespace circuitSegmentation::imageProcessing;
+
+/**
+ * @brief Test class of StageCheckpoints.
+ */
+class StageCheckpointsTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+        mCheckpointsDirectory = std::filesystem::temp_directory_path() / "cs_ut_stage_checkpoints";
+        std::filesystem::remove_all(mCheckpointsDirectory);
+
+        mStageCheckpoints
+            = std::make_unique<StageCheckpoints>(mCheckpointsDirectory.string(), mMockOpenCvWrapper, mLogger);
+        ASSERT_TRUE(mStageCheckpoints->open());
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mCheckpointsDirectory);
+    }
+
+    /**
+     * @brief Sets up the elements of a circuit, with a component, a connection and a node.
+     */
+    void setupElements()
+    {
+        circuit::Component component{};
+        component.mType = "resistor";
+        component.mBoundingBox = Rectangle{10, 20, 30, 40};
+        component.mPosition.mX = 10;
+        circuit::Port port{};
+        port.mOwnerId = component.mId;
+        port.mPosition.mX = 0.5;
+        component.mPorts.push_back(port);
+        mComponents.push_back(component);
+
+        circuit::Connection connection{};
+        connection.mStartId = port.mId;
+        connection.mWire = {{1, 2}, {3, 4}, {5, 6}};
+        mConnections.push_back(connection);
+
+        circuit::Node node{};
+        node.setType(circuit::Node::NodeType::VIRTUAL);
+        node.mConnectionIds = {connection.mId};
+        node.mLabel.mName = "N1";
+        node.mLabel.mIsNameHidden = false;
+        mNodes.push_back(node);
+    }
+
+protected:
+    /** Stage checkpoints. */
+    std::unique_ptr<StageCheckpoints> mStageCheckpoints;
+    /** OpenCV wrapper. */
+    std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Checkpoints folder. */
+    std::filesystem::path mCheckpointsDirectory;
+    /** Components of the circuit. */
+    std::vector<circuit::Component> mComponents{};
+    /** Connections of the circuit. */
+    std::vector<circuit::Connection> mConnections{};
+    /** Nodes of the circuit. */
+    std::vector<circuit::Node> mNodes{};
+};
+
+/**
+ * @brief Tests that the key depends on the stage, the image and the parameters.
+ */
+TEST_F(StageCheckpointsTest, makesKey)
+{
+    EXPECT_EQ(StageCheckpoints::makeKey(CheckpointStage::PREPROCESSING, 0x12, 0x34),
+              "preprocessing_0000000000000012_0000000000000034");
+    EXPECT_NE(StageCheckpoints::makeKey(CheckpointStage::DETECTION, 0x12, 0x34),
+              StageCheckpoints::makeKey(CheckpointStage::PREPROCESSING, 0x12, 0x34));
+}
+
+/**
+ * @brief Tests that the parameters of the detection include the parameters of the preprocessing, and differ between
+ * presets whose parameters differ.
+ */
+TEST_F(StageCheckpointsTest, hashesParameters)
+{
+    EXPECT_NE(StageCheckpoints::hashPreprocessingParameters(common::Preset::FAST),
+              StageCheckpoints::hashPreprocessingParameters(common::Preset::BALANCED));
+    EXPECT_NE(StageCheckpoints::hashDetectionParameters(common::Preset::BALANCED),
+              StageCheckpoints::hashPreprocessingParameters(common::Preset::BALANCED));
+    EXPECT_EQ(StageCheckpoints::hashDetectionParameters(common::Preset::ACCURATE),
+              StageCheckpoints::hashDetectionParameters(common::Preset::ACCURATE));
+}
+
+/**
+ * @brief Tests that the parameters of an image preprocessed by bands differ from the image preprocessed as a whole,
+ * and between heights of the bands.
+ */
+TEST_F(StageCheckpointsTest, hashesParametersOfBands)
+{
+    const auto wholeHash{StageCheckpoints::hashPreprocessingParameters(common::Preset::BALANCED)};
+
+    EXPECT_EQ(StageCheckpoints::hashPreprocessingParameters(common::Preset::BALANCED, 0), wholeHash);
+    EXPECT_NE(StageCheckpoints::hashPreprocessingParameters(common::Preset::BALANCED, 256), wholeHash);
+    EXPECT_NE(StageCheckpoints::hashPreprocessingParameters(common::Preset::BALANCED, 256),
+              StageCheckpoints::hashPreprocessingParameters(common::Preset::BALANCED, 128));
+    EXPECT_NE(StageCheckpoints::hashDetectionParameters(common::Preset::BALANCED, 256),
+              StageCheckpoints::hashDetectionParameters(common::Preset::BALANCED));
+}
+
+/**
+ * @brief Tests that an image stored is loaded with the same dimensions, type and pixels.
+ */
+TEST_F(StageCheckpointsTest, loadsImageStored)
+{
+    constexpr int width{4};
+    constexpr int height{2};
+    constexpr int type{0};
+    const std::vector<unsigned char> pixels{1, 2, 3, 4, 5, 6, 7, 8};
+    ImageMat image{};
+    ImageMat imageLoaded{};
+    std::vector<unsigned char> pixelsLoaded{};
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockOpenCvWrapper, getImageWidth).WillByDefault(Return(width));
+    ON_CALL(*mMockOpenCvWrapper, getImageHeight).WillByDefault(Return(height));
+    ON_CALL(*mMockOpenCvWrapper, getImageType).WillByDefault(Return(type));
+    ON_CALL(*mMockOpenCvWrapper, getImageSizeBytes).WillByDefault(Return(pixels.size()));
+    ON_CALL(*mMockOpenCvWrapper, getImageRow).WillByDefault([&pixels](ImageMat&, const int row) {
+        return pixels.data() + row * width;
+    });
+    EXPECT_CALL(*mMockOpenCvWrapper, copyImageBuffer(_, width, height, width, type))
+        .Times(1)
+        .WillOnce([&pixelsLoaded, &imageLoaded](const unsigned char* data, const int, const int, const std::size_t,
+                                                const int) {
+            pixelsLoaded.assign(data, data + width * height);
+            return imageLoaded;
+        });
+
+    const auto key{StageCheckpoints::makeKey(CheckpointStage::PREPROCESSING, 1, 2)};
+    EXPECT_FALSE(mStageCheckpoints->loadImage(key, image));
+    ASSERT_TRUE(mStageCheckpoints->storeImage(key, image));
+    ASSERT_TRUE(mStageCheckpoints->loadImage(key, image));
+    EXPECT_EQ(pixelsLoaded, pixels);
+}
+
+/**
+ * @brief Tests that the elements stored are loaded with the same fields.
+ */
+TEST_F(StageCheckpointsTest, loadsElementsStored)
+{
+    setupElements();
+
+    const auto key{StageCheckpoints::makeKey(CheckpointStage::DETECTION, 1, 2)};
+    ASSERT_TRUE(mStageCheckpoints->storeElements(key, mComponents, mConnections, mNodes));
+
+    std::vector<circuit::Component> components{};
+    std::vector<circuit::Connection> connections{};
+    std::vector<circuit::Node> nodes{};
+    ASSERT_TRUE(mStageCheckpoints->loadElements(key, components, connections, nodes));
+
+    ASSERT_EQ(components.size(), 1U);
+    EXPECT_EQ(components[0].mId, mComponents[0].mId);
+    EXPECT_EQ(components[0].mType, "resistor");
+    EXPECT_EQ(components[0].mBoundingBox, mComponents[0].mBoundingBox);
+    EXPECT_EQ(components[0].mPosition.mX, 10);
+    EXPECT_EQ(components[0].mLabel.mOwnerId, mComponents[0].mId);
+    ASSERT_EQ(components[0].mPorts.size(), 1U);
+    EXPECT_EQ(components[0].mPorts[0].mId, mComponents[0].mPorts[0].mId);
+    EXPECT_DOUBLE_EQ(components[0].mPorts[0].mPosition.mX, 0.5);
+
+    ASSERT_EQ(connections.size(), 1U);
+    EXPECT_EQ(connections[0].mId, mConnections[0].mId);
+    EXPECT_EQ(connections[0].mStartId, mComponents[0].mPorts[0].mId);
+    EXPECT_EQ(connections[0].mWire, mConnections[0].mWire);
+
+    ASSERT_EQ(nodes.size(), 1U);
+    EXPECT_EQ(nodes[0].mType, "virtual");
+    EXPECT_EQ(nodes[0].mConnectionIds, mNodes[0].mConnectionIds);
+    EXPECT_EQ(nodes[0].mLabel.mName, "N1");
+    EXPECT_FALSE(nodes[0].mLabel.mIsNameHidden);
+    EXPECT_TRUE(nodes[0].mLabel.mIsValueHidden);
+}
+
+/**
+ * @brief Tests that a checkpoint corrupted, truncated or of another stage is not loaded.
+ */
+TEST_F(StageCheckpointsTest, ignoresInvalidCheckpoints)
+{
+    setupElements();
+
+    const auto key{StageCheckpoints::makeKey(CheckpointStage::DETECTION, 1, 2)};
+    ASSERT_TRUE(mStageCheckpoints->storeElements(key, mComponents, mConnections, mNodes));
+    const auto path{mStageCheckpoints->getCheckpointPath(key)};
+    const auto size{std::filesystem::file_size(path)};
+
+    std::vector<circuit::Component> components{};
+    std::vector<circuit::Connection> connections{};
+    std::vector<circuit::Node> nodes{};
+
+    // Another stage
+    ImageMat image{};
+    EXPECT_FALSE(mStageCheckpoints->loadImage(key, image));
+
+    // Corrupted payload
+    {
+        std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(static_cast<std::streamoff>(size - 1));
+        file.put('\x7F');
+    }
+    EXPECT_FALSE(mStageCheckpoints->loadElements(key, components, connections, nodes));
+
+    // Truncated
+    std::filesystem::resize_file(path, size / 2);
+    EXPECT_FALSE(mStageCheckpoints->loadElements(key, components, connections, nodes));
+    EXPECT_TRUE(components.empty());
+}
+
+/**
+ * @brief Tests that the checkpoints left incomplete are removed when the checkpoints are opened.
+ */
+TEST_F(StageCheckpointsTest, removesIncompleteCheckpoints)
+{
+    std::ofstream{mCheckpointsDirectory / ".interrupted.ckpt.1"} << "incomplete";
+
+    ASSERT_TRUE(mStageCheckpoints->open());
+
+    EXPECT_FALSE(std::filesystem::exists(mCheckpointsDirectory / ".interrupted.ckpt.1"));
+}
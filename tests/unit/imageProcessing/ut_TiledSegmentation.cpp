@@ -0,0 +1,123 @@
+/**
+ * @file
+ */
+
+#include "imageProcessing/TiledSegmentation.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+
+/**
+ * @brief Tests that an image is split in overlapping tiles, the last ones aligned to the borders of the image.
+ */
+TEST(TiledSegmentationTest, makesTiles)
+{
+    const auto tiles{imageProcessing::TiledSegmentation::makeTiles(2500, 1500, 1000, 200)};
+
+    // Columns at 0, 800 and 1500, rows at 0 and 500
+    ASSERT_EQ(tiles.size(), 6);
+    EXPECT_EQ(tiles.at(0).x, 0);
+    EXPECT_EQ(tiles.at(0).y, 0);
+    EXPECT_EQ(tiles.at(1).x, 800);
+    EXPECT_EQ(tiles.at(2).x, 1500);
+    EXPECT_EQ(tiles.at(3).x, 0);
+    EXPECT_EQ(tiles.at(3).y, 500);
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(tile.width, 1000);
+        EXPECT_EQ(tile.height, 1000);
+    }
+}
+
+/**
+ * @brief Tests that an image smaller than a tile is a single tile.
+ */
+TEST(TiledSegmentationTest, makesSingleTileOfSmallImage)
+{
+    const auto tiles{imageProcessing::TiledSegmentation::makeTiles(640, 480, 1000, 200)};
+
+    ASSERT_EQ(tiles.size(), 1);
+    EXPECT_EQ(tiles.at(0).x, 0);
+    EXPECT_EQ(tiles.at(0).y, 0);
+    EXPECT_EQ(tiles.at(0).width, 640);
+    EXPECT_EQ(tiles.at(0).height, 480);
+}
+
+/**
+ * @brief Tests that the overlap of the tiles is at most half of their size.
+ */
+TEST(TiledSegmentationTest, makesTilesWithOverlapLimited)
+{
+    const auto tiles{imageProcessing::TiledSegmentation::makeTiles(1000, 100, 100, 80)};
+
+    ASSERT_GE(tiles.size(), 2);
+    EXPECT_EQ(tiles.at(1).x - tiles.at(0).x, 50);
+}
+
+/**
+ * @brief Tests that the boxes of an element detected in different tiles are merged, but not the boxes of a tile.
+ */
+TEST(TiledSegmentationTest, mergesBoxesOfDifferentTiles)
+{
+    const std::vector<imageProcessing::TileBox> boxes{
+        // Component cut by the border of tile 0, and detected whole in tile 1
+        {0, computerVision::Rectangle{950, 100, 50, 40}},
+        {1, computerVision::Rectangle{950, 100, 80, 40}},
+        // Adjacent components of tile 1
+        {1, computerVision::Rectangle{1100, 100, 40, 40}},
+        {1, computerVision::Rectangle{1120, 100, 40, 40}},
+        // Component only touching a component of another tile
+        {0, computerVision::Rectangle{960, 139, 40, 40}},
+    };
+
+    const auto merged{
+        imageProcessing::TiledSegmentation::mergeBoxes(boxes, imageProcessing::TiledSegmentation::cBoxMinOverlap)};
+
+    ASSERT_EQ(merged.size(), 4);
+    EXPECT_EQ(merged.at(0).x, 950);
+    EXPECT_EQ(merged.at(0).width, 80);
+    EXPECT_EQ(merged.at(0).height, 40);
+    EXPECT_EQ(merged.at(1).x, 1100);
+    EXPECT_EQ(merged.at(2).x, 1120);
+    EXPECT_EQ(merged.at(3).x, 960);
+}
+
+/**
+ * @brief Tests that the fragments of a wire crossing the border of a tile are stitched.
+ */
+TEST(TiledSegmentationTest, stitchesWiresCrossingTiles)
+{
+    // Horizontal wire from x = 500 to 1500, in tiles overlapping from x = 800 to 1000
+    const std::vector<imageProcessing::TileWire> wires{
+        {0, circuit::Wire{{500, 300}, {999, 300}, {999, 301}, {500, 301}}},
+        {1, circuit::Wire{{800, 300}, {1500, 300}, {1500, 301}, {800, 301}}},
+        // Parallel wire of tile 1, far from the others
+        {1, circuit::Wire{{800, 400}, {1500, 400}, {1500, 401}, {800, 401}}},
+    };
+
+    const auto stitched{
+        imageProcessing::TiledSegmentation::stitchWires(wires, imageProcessing::TiledSegmentation::cWireMaxDistance)};
+
+    ASSERT_EQ(stitched.size(), 2);
+    EXPECT_EQ(stitched.at(0).size(), 8);
+    EXPECT_EQ(stitched.at(0).front().x, 500);
+    EXPECT_EQ(stitched.at(1).size(), 4);
+    EXPECT_EQ(stitched.at(1).front().y, 400);
+}
+
+/**
+ * @brief Tests that the wires of a tile are not stitched, even if they are near.
+ */
+TEST(TiledSegmentationTest, doesNotStitchWiresOfSameTile)
+{
+    const std::vector<imageProcessing::TileWire> wires{
+        {0, circuit::Wire{{100, 100}, {200, 100}, {200, 101}, {100, 101}}},
+        {0, circuit::Wire{{100, 102}, {200, 102}, {200, 103}, {100, 103}}},
+    };
+
+    const auto stitched{
+        imageProcessing::TiledSegmentation::stitchWires(wires, imageProcessing::TiledSegmentation::cWireMaxDistance)};
+
+    EXPECT_EQ(stitched.size(), 2);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file
+ */
+
+#include "logging/LogFormat.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace circuitSegmentation::logging;
+
+/**
+ * @brief Tests that the placeholders are replaced by the arguments, in order.
+ */
+TEST(LogFormatTest, replacesPlaceholdersByArguments)
+{
+    const std::string id{"a1b2"};
+
+    const auto msg{formatLog("Label {} at {} of {}", id, 3, "component")};
+
+    EXPECT_EQ("Label a1b2 at 3 of component", msg);
+}
+
+/**
+ * @brief Tests that the arguments of the supported types are formatted.
+ */
+TEST(LogFormatTest, formatsArgumentTypes)
+{
+    constexpr std::size_t size{42};
+    constexpr double distance{1.5};
+
+    const auto msg{formatLog("{} {} {} {} {}", size, -7, distance, true, 'x')};
+
+    EXPECT_EQ("42 -7 " + std::to_string(distance) + " true x", msg);
+}
+
+/**
+ * @brief Tests that the escaped braces are formatted as braces.
+ */
+TEST(LogFormatTest, formatsEscapedBraces)
+{
+    const auto msg{formatLog("Point at {{{}, {}}}", 10, 20)};
+
+    EXPECT_EQ("Point at {10, 20}", msg);
+}
+
+/**
+ * @brief Tests that the placeholders without arguments are kept and the arguments without placeholders are ignored.
+ */
+TEST(LogFormatTest, handlesMismatchedArguments)
+{
+    EXPECT_EQ("1 and {}", formatLog("{} and {}", 1));
+    EXPECT_EQ("1 only", formatLog("{} only", 1, 2));
+}
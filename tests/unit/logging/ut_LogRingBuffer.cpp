@@ -0,0 +1,133 @@
+/**
+ * @file
+ */
+
+#include "logging/LogRingBuffer.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace circuitSegmentation::logging;
+
+/**
+ * @brief Test class of LogRingBuffer.
+ */
+class LogRingBufferTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mRingBuffer = std::make_unique<LogRingBuffer>(cCapacity);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+    /**
+     * @brief Builds a record with a message.
+     *
+     * @param msg Message.
+     * @return Record.
+     */
+    LogRecord buildRecord(const std::string& msg)
+    {
+        LogRecord record{};
+        record.mMsg = msg;
+        return record;
+    }
+
+protected:
+    /** Capacity of the ring buffer. */
+    static constexpr std::size_t cCapacity{4};
+
+    /** Ring buffer. */
+    std::unique_ptr<LogRingBuffer> mRingBuffer;
+};
+
+/**
+ * @brief Tests that the ring buffer has the capacity requested.
+ */
+TEST_F(LogRingBufferTest, hasCapacity)
+{
+    EXPECT_EQ(cCapacity, mRingBuffer->getCapacity());
+    EXPECT_EQ(0U, mRingBuffer->getSize());
+}
+
+/**
+ * @brief Tests that the records are popped in the order they were pushed.
+ */
+TEST_F(LogRingBufferTest, popsRecordsInOrder)
+{
+    for (auto i{0}; i < 10; ++i) {
+        auto record{buildRecord(std::to_string(i))};
+        ASSERT_TRUE(mRingBuffer->push(record));
+
+        LogRecord popped{};
+        ASSERT_TRUE(mRingBuffer->pop(popped));
+        EXPECT_EQ(std::to_string(i), popped.mMsg);
+    }
+}
+
+/**
+ * @brief Tests that a record is not pushed when the ring buffer is full.
+ */
+TEST_F(LogRingBufferTest, doesNotPushWhenFull)
+{
+    for (std::size_t i{0}; i < cCapacity; ++i) {
+        auto record{buildRecord("message")};
+        ASSERT_TRUE(mRingBuffer->push(record));
+    }
+
+    auto record{buildRecord("message")};
+    EXPECT_FALSE(mRingBuffer->push(record));
+    EXPECT_EQ(cCapacity, mRingBuffer->getSize());
+
+    // The record is kept by the caller
+    EXPECT_EQ("message", record.mMsg);
+}
+
+/**
+ * @brief Tests that a record is not popped when the ring buffer is empty.
+ */
+TEST_F(LogRingBufferTest, doesNotPopWhenEmpty)
+{
+    LogRecord record{};
+
+    EXPECT_FALSE(mRingBuffer->pop(record));
+}
+
+/**
+ * @brief Tests that the records are transferred in order from a producer thread to a consumer thread.
+ */
+TEST_F(LogRingBufferTest, transfersRecordsBetweenThreads)
+{
+    constexpr auto numRecords{10000};
+
+    std::thread producer{[this]() {
+        for (auto i{0}; i < numRecords; ++i) {
+            auto record{buildRecord(std::to_string(i))};
+            while (!mRingBuffer->push(record)) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    auto numPopped{0};
+    LogRecord record{};
+    while (numPopped < numRecords) {
+        if (mRingBuffer->pop(record)) {
+            ASSERT_EQ(std::to_string(numPopped), record.mMsg);
+            ++numPopped;
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(0U, mRingBuffer->getSize());
+}
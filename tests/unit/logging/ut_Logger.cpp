@@ -4,15 +4,41 @@
 
 #include "logging/Logger.h"
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <gtest/gtest.h>
 #include <iomanip>
 #include <memory>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace circuitSegmentation::logging;
 
+/**
+ * @brief Argument of a log message that counts how many times it is formatted.
+ */
+struct CountedArg
+{
+    /** Number of times formatted. */
+    int& mCount;
+};
+
+/**
+ * @brief Formats the counted argument.
+ *
+ * @param os Output stream.
+ * @param arg Argument.
+ * @return Output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const CountedArg& arg)
+{
+    ++arg.mCount;
+    return os << "counted";
+}
+
 /**
  * @brief Test class of Logger.
  */
@@ -191,6 +217,10 @@ TEST_F(LoggerTest, noInfoLog)
  */
 TEST_F(LoggerTest, logsDebug)
 {
+    if constexpr (!Logger::cDebugLogsEnabled) {
+        GTEST_SKIP() << "Debug and verbose logs stripped at compile time";
+    }
+
     mLogger->setLogLevel(Logger::LogLevel::DEBUG);
 
     const std::string msg{"A debug message"};
@@ -221,6 +251,10 @@ TEST_F(LoggerTest, noDebugLog)
  */
 TEST_F(LoggerTest, logsVerbose)
 {
+    if constexpr (!Logger::cDebugLogsEnabled) {
+        GTEST_SKIP() << "Debug and verbose logs stripped at compile time";
+    }
+
     mLogger->setLogLevel(Logger::LogLevel::VERBOSE);
 
     const std::string msg{"A verbose message"};
@@ -245,3 +279,134 @@ TEST_F(LoggerTest, noVerboseLog)
 
     EXPECT_TRUE(mStream.str().empty());
 }
+
+/**
+ * @brief Tests that the logger is synchronous by default.
+ */
+TEST_F(LoggerTest, hasSynchronousModeByDefault)
+{
+    EXPECT_EQ(Logger::LogMode::SYNCHRONOUS, mLogger->getLogMode());
+}
+
+/**
+ * @brief Tests that the job ID of the thread is logged with the message.
+ */
+TEST_F(LoggerTest, logsJobId)
+{
+    constexpr std::uint64_t jobId{7};
+    Logger::setJobId(jobId);
+
+    const std::string msg{"An information message"};
+    mLogger->logInfo(msg);
+
+    Logger::setJobId(0);
+
+    // Expected message
+    const std::string dateTime{mStream.str().substr(0, cDateTimeLength)};
+    const std::string expectMsg{dateTime + expectLog("INFO", "[job 7] " + msg)};
+
+    EXPECT_EQ(expectMsg, mStream.str());
+}
+
+/**
+ * @brief Tests that the messages logged in asynchronous mode are written when the logger is flushed.
+ */
+TEST_F(LoggerTest, logsAsynchronouslyOnFlush)
+{
+    std::ostringstream stream{};
+    Logger logger{stream, Logger::LogLevel::VERBOSE, Logger::LogMode::ASYNCHRONOUS};
+
+    const std::string msg{"An information message"};
+    logger.logInfo(msg);
+    logger.flush();
+
+    // Expected message
+    const std::string dateTime{stream.str().substr(0, cDateTimeLength)};
+    const std::string expectMsg{dateTime + expectLog("INFO", msg)};
+
+    EXPECT_EQ(Logger::LogMode::ASYNCHRONOUS, logger.getLogMode());
+    EXPECT_EQ(expectMsg, stream.str());
+}
+
+/**
+ * @brief Tests that the messages logged in asynchronous mode by multiple threads are all written, keeping the order
+ * of each thread.
+ *
+ * Scenario: several threads log more messages than the capacity of their ring buffers, then the logger is destroyed.
+ * Expected: all the messages are written and the messages of each thread are in the order they were logged.
+ */
+TEST_F(LoggerTest, logsAsynchronouslyFromMultipleThreads)
+{
+    constexpr auto numThreads{4};
+    constexpr auto numMsgs{static_cast<int>(LogRingBuffer::cCapacityDefault) * 3};
+    std::ostringstream stream{};
+
+    {
+        Logger logger{stream, Logger::LogLevel::VERBOSE, Logger::LogMode::ASYNCHRONOUS};
+
+        std::vector<std::thread> threads{};
+        for (auto t{0}; t < numThreads; ++t) {
+            threads.emplace_back([&logger, t]() {
+                for (auto i{0}; i < numMsgs; ++i) {
+                    logger.logInfo(std::to_string(t) + " " + std::to_string(i));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Check the messages of each thread
+    std::vector<int> nextMsg(numThreads, 0);
+    std::istringstream lines{stream.str()};
+    std::string line{};
+    auto numLines{0};
+    while (std::getline(lines, line)) {
+        std::istringstream fields{line.substr(cDateTimeLength + std::string("[INFO] ").size())};
+        int t{0};
+        int i{0};
+        fields >> t >> i;
+
+        ASSERT_EQ(nextMsg.at(t), i);
+        ++nextMsg.at(t);
+        ++numLines;
+    }
+
+    EXPECT_EQ(numThreads * numMsgs, numLines);
+}
+
+/**
+ * @brief Tests the log for messages with a format string and arguments.
+ */
+TEST_F(LoggerTest, logsFormattedMessage)
+{
+    mLogger->setLogLevel(Logger::LogLevel::INFO);
+
+    mLogger->logInfo("Found {} components at {{{}, {}}}", 3, 10, 20);
+
+    // Expected message
+    const std::string dateTime{mStream.str().substr(0, cDateTimeLength)};
+    const std::string expectMsg{dateTime + expectLog("INFO", "Found 3 components at {10, 20}")};
+
+    EXPECT_EQ(expectMsg, mStream.str());
+}
+
+/**
+ * @brief Tests that the message is not formatted when its log level is not enabled.
+ */
+TEST_F(LoggerTest, noFormatWhenLevelDisabled)
+{
+    mLogger->setLogLevel(Logger::LogLevel::INFO);
+
+    int count{0};
+    mLogger->logDebug("Argument {}", CountedArg{count});
+    mLogger->logVerbose("Argument {}", CountedArg{count});
+
+    EXPECT_EQ(0, count);
+    EXPECT_TRUE(mStream.str().empty());
+
+    mLogger->logInfo("Argument {}", CountedArg{count});
+
+    EXPECT_EQ(1, count);
+}
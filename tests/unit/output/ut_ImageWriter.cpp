@@ -0,0 +1,406 @@
+/**
+ * @file
+ */
+
+#include "common/Task.h"
+#include "common/ThreadPool.h"
+#include "logging/Logger.h"
+#include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "output/ImageWriter.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace circuitSegmentation;
+using namespace circuitSegmentation::computerVision;
+
+#ifdef COROUTINES_SUPPORTED
+namespace {
+
+/**
+ * @brief Flushes the images of the job of the calling thread in a coroutine.
+ *
+ * @param imageWriter Image writer.
+ * @param executor Executor where the coroutine is resumed.
+ *
+ * @return Task with the result of the flush.
+ */
+common::Task<bool> flushImages(output::ImageWriter& imageWriter, common::Executor& executor)
+{
+    auto imagesFlushed{imageWriter.flushAsync(executor)};
+    logging::Logger::setJobId(0);
+
+    co_return co_await imagesFlushed;
+}
+
+} // namespace
+#endif
+
+/**
+ * @brief Test class of ImageWriter.
+ */
+class ImageWriterTest : public testing::Test
+{
+protected:
+    /**
+     * @brief Test suite setup.
+     */
+    void SetUp() override
+    {
+        mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
+        mLogger = std::make_shared<logging::Logger>(std::cout);
+
+        mImageWriter = std::make_unique<output::ImageWriter>(mMockOpenCvWrapper, mLogger, cNumThreads, cMemoryBudget);
+    }
+
+    /**
+     * @brief Test suite teardown.
+     */
+    void TearDown() override {}
+
+protected:
+    /** Number of threads for writing images. */
+    static constexpr unsigned int cNumThreads{2};
+    /** Budget of memory for images waiting to be written, in bytes. */
+    static constexpr std::size_t cMemoryBudget{100};
+
+    /** OpenCV wrapper. */
+    std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
+    /** Logger. */
+    std::shared_ptr<logging::Logger> mLogger;
+    /** Image writer. */
+    std::unique_ptr<output::ImageWriter> mImageWriter;
+};
+
+/**
+ * @brief Tests that the writer has the number of threads and memory budget requested.
+ */
+TEST_F(ImageWriterTest, hasThreadsAndMemoryBudget)
+{
+    EXPECT_EQ(mImageWriter->getNumThreads(), cNumThreads);
+    EXPECT_EQ(mImageWriter->getMemoryBudget(), cMemoryBudget);
+}
+
+/**
+ * @brief Tests that the images are written to the output directory.
+ */
+TEST_F(ImageWriterTest, writesImageToOutputDirectory)
+{
+    const std::string outputDirectory{"output"};
+    const std::string fileName{"image.png"};
+    const auto filePath{(std::filesystem::path{outputDirectory} / fileName).string()};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage(filePath, _)).Times(1).WillOnce(Return(true));
+
+    // Write image
+    mImageWriter->setOutputDirectory(outputDirectory);
+    EXPECT_EQ(mImageWriter->getOutputDirectory(), outputDirectory);
+    auto written{mImageWriter->writeImage(fileName, ImageMat{})};
+
+    EXPECT_TRUE(written.get());
+    EXPECT_TRUE(mImageWriter->flush());
+}
+
+/**
+ * @brief Tests that an image is written successfully.
+ */
+TEST_F(ImageWriterTest, writesImageSuccessfully)
+{
+    const std::string fileName{"image.png"};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage(fileName, _)).Times(1).WillOnce(Return(true));
+
+    // Write image
+    auto written{mImageWriter->writeImage(fileName, ImageMat{})};
+
+    EXPECT_TRUE(written.get());
+    EXPECT_TRUE(mImageWriter->flush());
+}
+
+/**
+ * @brief Tests that the failure to write an image is reported by the future and by the flush.
+ *
+ * Scenario: the writing of an image fails, then the writer is flushed twice.
+ * Expected: the first flush reports the failure, the second flush succeeds as there are no new failures.
+ */
+TEST_F(ImageWriterTest, reportsFailureToWriteImage)
+{
+    const std::string fileName{"image.png"};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage(fileName, _)).Times(1).WillOnce(Return(false));
+
+    // Write image
+    auto written{mImageWriter->writeImage(fileName, ImageMat{})};
+
+    EXPECT_FALSE(written.get());
+    EXPECT_FALSE(mImageWriter->flush());
+    EXPECT_TRUE(mImageWriter->flush());
+}
+
+/**
+ * @brief Tests that an image is encoded to memory successfully, without writing a file.
+ */
+TEST_F(ImageWriterTest, encodesImageSuccessfully)
+{
+    const std::vector<unsigned char> buffer{0x89, 'P', 'N', 'G'};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, encodeImage(output::ImageWriter::cEncodedImageExtension, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<2>(buffer), Return(true)));
+
+    // Encode image
+    auto encoded{mImageWriter->encodeImage(ImageMat{})};
+
+    EXPECT_EQ(encoded.get(), buffer);
+    EXPECT_TRUE(mImageWriter->flush());
+}
+
+/**
+ * @brief Tests that the failure to encode an image is reported by an empty buffer and by the flush.
+ */
+TEST_F(ImageWriterTest, reportsFailureToEncodeImage)
+{
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, encodeImage).Times(1).WillOnce(Return(false));
+
+    // Encode image
+    auto encoded{mImageWriter->encodeImage(ImageMat{})};
+
+    EXPECT_TRUE(encoded.get().empty());
+    EXPECT_FALSE(mImageWriter->flush());
+}
+
+/**
+ * @brief Tests that the flush waits for all the images to be written.
+ */
+TEST_F(ImageWriterTest, flushWaitsForAllImages)
+{
+    constexpr auto numImages{20};
+    std::atomic<int> imagesWritten{0};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(numImages).WillRepeatedly(Invoke([&imagesWritten]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        ++imagesWritten;
+        return true;
+    }));
+
+    // Write images
+    for (auto i{0}; i < numImages; ++i) {
+        mImageWriter->writeImage("image_" + std::to_string(i) + ".png", ImageMat{});
+    }
+
+    EXPECT_TRUE(mImageWriter->flush());
+    EXPECT_EQ(imagesWritten, numImages);
+}
+
+/**
+ * @brief Tests that writing an image blocks while the memory budget is exhausted.
+ *
+ * Scenario: an image using most of the memory budget is being written, and a second image is submitted.
+ * Expected: the submission of the second image only returns after the first image is written.
+ */
+TEST_F(ImageWriterTest, blocksWhenMemoryBudgetExhausted)
+{
+    constexpr std::size_t imageBytes{cMemoryBudget - 1};
+    std::promise<void> releaseFirstImage{};
+    auto releaseFirstImageFuture{releaseFirstImage.get_future().share()};
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockOpenCvWrapper, getImageSizeBytes).WillByDefault(Return(imageBytes));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage("image_1.png", _))
+        .Times(1)
+        .WillOnce(Invoke([releaseFirstImageFuture]() {
+            releaseFirstImageFuture.wait();
+            return true;
+        }));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage("image_2.png", _)).Times(1).WillOnce(Return(true));
+
+    // Write first image, which waits to be released
+    mImageWriter->writeImage("image_1.png", ImageMat{});
+
+    // Write second image in another thread, as it blocks
+    std::atomic<bool> secondImageSubmitted{false};
+    std::thread submitter{[this, &secondImageSubmitted]() {
+        mImageWriter->writeImage("image_2.png", ImageMat{});
+        secondImageSubmitted = true;
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    EXPECT_FALSE(secondImageSubmitted);
+
+    // Release first image
+    releaseFirstImage.set_value();
+    submitter.join();
+
+    EXPECT_TRUE(secondImageSubmitted);
+    EXPECT_TRUE(mImageWriter->flush());
+}
+
+/**
+ * @brief Tests that an image bigger than the memory budget is written when there are no other images in flight.
+ */
+TEST_F(ImageWriterTest, writesImageBiggerThanMemoryBudget)
+{
+    constexpr std::size_t imageBytes{cMemoryBudget * 10};
+
+    // Setup expectations and behavior
+    ON_CALL(*mMockOpenCvWrapper, getImageSizeBytes).WillByDefault(Return(imageBytes));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(2).WillRepeatedly(Return(true));
+
+    // Write images
+    auto written1{mImageWriter->writeImage("image_1.png", ImageMat{})};
+    auto written2{mImageWriter->writeImage("image_2.png", ImageMat{})};
+
+    EXPECT_TRUE(written1.get());
+    EXPECT_TRUE(written2.get());
+}
+
+/**
+ * @brief Tests that the images in flight are written before the writer is destroyed.
+ */
+TEST_F(ImageWriterTest, writesImagesOnDestruction)
+{
+    constexpr auto numImages{10};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(numImages).WillRepeatedly(Return(true));
+
+    // Write images
+    for (auto i{0}; i < numImages; ++i) {
+        mImageWriter->writeImage("image_" + std::to_string(i) + ".png", ImageMat{});
+    }
+
+    // Destroy writer
+    mImageWriter.reset();
+}
+
+/**
+ * @brief Tests that the images of the jobs sharing the writer are written to the output directories of the jobs.
+ *
+ * Scenario: a job sets its own output directory, and another job does not.
+ * Expected: the images of the first job are written to its directory, the ones of the other job to the directory set
+ * without a job, and the directory of the first job is cleared by its flush.
+ */
+TEST_F(ImageWriterTest, writesImagesOfJobsToTheirOutputDirectories)
+{
+    const auto filePath1{(std::filesystem::path{"job_1"} / "image.png").string()};
+    const auto filePath2{(std::filesystem::path{"output"} / "image.png").string()};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage(filePath1, _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage(filePath2, _)).Times(1).WillOnce(Return(true));
+
+    // Write images of the jobs
+    mImageWriter->setOutputDirectory("output");
+    logging::Logger::setJobId(1);
+    mImageWriter->setOutputDirectory("job_1");
+    EXPECT_EQ(mImageWriter->getOutputDirectory(), "job_1");
+    mImageWriter->writeImage("image.png", ImageMat{});
+    EXPECT_TRUE(mImageWriter->flush());
+    EXPECT_EQ(mImageWriter->getOutputDirectory(), "output");
+    logging::Logger::setJobId(2);
+    mImageWriter->writeImage("image.png", ImageMat{});
+    EXPECT_TRUE(mImageWriter->flush());
+    logging::Logger::setJobId(0);
+}
+
+/**
+ * @brief Tests that the flush of a job only reports the failures of its own images.
+ */
+TEST_F(ImageWriterTest, reportsFailuresOfJob)
+{
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage("image_1.png", _)).Times(1).WillOnce(Return(false));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage("image_2.png", _)).Times(1).WillOnce(Return(true));
+
+    // Write images of the jobs
+    logging::Logger::setJobId(1);
+    auto written1{mImageWriter->writeImage("image_1.png", ImageMat{})};
+    logging::Logger::setJobId(2);
+    auto written2{mImageWriter->writeImage("image_2.png", ImageMat{})};
+
+    EXPECT_FALSE(written1.get());
+    EXPECT_TRUE(written2.get());
+    EXPECT_TRUE(mImageWriter->flush());
+    logging::Logger::setJobId(1);
+    EXPECT_FALSE(mImageWriter->flush());
+    logging::Logger::setJobId(0);
+}
+
+/**
+ * @brief Tests that the callback of the flush of a job is called when its last image is written.
+ *
+ * Scenario: an image of a job is being written when the callback is given.
+ * Expected: the callback is not called before the image is written, and then it is called with the result.
+ */
+TEST_F(ImageWriterTest, callsCallbackWhenImagesOfJobWritten)
+{
+    std::promise<void> releaseImage{};
+    auto releaseImageFuture{releaseImage.get_future().share()};
+    std::promise<bool> flushed{};
+    auto flushedFuture{flushed.get_future()};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(1).WillOnce(Invoke([releaseImageFuture]() {
+        releaseImageFuture.wait();
+        return false;
+    }));
+
+    // Write image of the job, which waits to be released
+    logging::Logger::setJobId(1);
+    mImageWriter->writeImage("image.png", ImageMat{});
+    logging::Logger::setJobId(0);
+    mImageWriter->whenFlushed(1, [&flushed](const bool success) { flushed.set_value(success); });
+
+    EXPECT_EQ(flushedFuture.wait_for(std::chrono::milliseconds{100}), std::future_status::timeout);
+
+    // Release image
+    releaseImage.set_value();
+    EXPECT_FALSE(flushedFuture.get());
+
+    // Without images, the callback is called at once
+    auto called{false};
+    mImageWriter->whenFlushed(1, [&called](const bool success) { called = success; });
+    EXPECT_TRUE(called);
+}
+
+#ifdef COROUTINES_SUPPORTED
+/**
+ * @brief Tests that a coroutine awaiting the flush of its job is resumed on the executor when the images are written.
+ */
+TEST_F(ImageWriterTest, resumesCoroutineWhenImagesOfJobWritten)
+{
+    common::ThreadPool executor{1};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(1).WillOnce(Invoke([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        return true;
+    }));
+
+    // Write image of the job and flush it in a coroutine
+    std::promise<bool> success{};
+    logging::Logger::setJobId(1);
+    mImageWriter->writeImage("image.png", ImageMat{});
+    common::startTask<bool>(
+        flushImages(*mImageWriter, executor),
+        [&success](bool value) { success.set_value(value); },
+        [&success](std::exception_ptr exception) { success.set_exception(exception); });
+
+    EXPECT_EQ(logging::Logger::getJobId(), 0);
+    EXPECT_TRUE(success.get_future().get());
+}
+#endif
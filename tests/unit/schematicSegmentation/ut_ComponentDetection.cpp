@@ -4,6 +4,7 @@
 
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "output/ImageWriter.h"
 #include "schematicSegmentation/ComponentDetection.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -26,8 +27,10 @@ protected:
     {
         mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
+        mImageWriter = std::make_shared<output::ImageWriter>(mMockOpenCvWrapper, mLogger);
 
-        mComponentDetection = std::make_unique<schematicSegmentation::ComponentDetection>(mMockOpenCvWrapper, mLogger);
+        mComponentDetection
+            = std::make_unique<schematicSegmentation::ComponentDetection>(mMockOpenCvWrapper, mImageWriter, mLogger);
 
         setupDummyConnection();
     }
@@ -148,6 +151,8 @@ protected:
     std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
     /** Dummy connections to be used in tests. */
     std::vector<circuit::Connection> mDummyConnections;
 };
@@ -190,6 +195,30 @@ TEST_F(ComponentDetectionTest, detectsMultipleComponents)
     EXPECT_EQ(componentsDetected, expectedComponents);
 }
 
+/**
+ * @brief Tests that the components detected in a previous image are discarded.
+ */
+TEST_F(ComponentDetectionTest, detectsComponentsOfLastImageOnly)
+{
+    constexpr auto expectedComponents{1};
+
+    // Detect components in a previous image
+    ImageMat image{};
+    setupDetectComponents(expectedComponents);
+    ASSERT_TRUE(mComponentDetection->detectComponents(image, image, mDummyConnections, false));
+    Mock::VerifyAndClearExpectations(mMockOpenCvWrapper.get());
+
+    // Setup expectations and behavior
+    setupDetectComponents(expectedComponents);
+
+    // Detect components
+    ASSERT_TRUE(mComponentDetection->detectComponents(image, image, mDummyConnections, false));
+
+    // Number of components detected
+    const auto componentsDetected{mComponentDetection->getDetectedComponents().size()};
+    EXPECT_EQ(componentsDetected, expectedComponents);
+}
+
 /**
  * @brief Tests that no components are detected when there are no components contours found.
  */
@@ -243,6 +272,40 @@ TEST_F(ComponentDetectionTest, detectsNoComponentsWhenSmallArea)
     EXPECT_EQ(componentsDetected, expectedComponents);
 }
 
+/**
+ * @brief Tests that the components are detected with the minimum area of the parameters set.
+ */
+TEST_F(ComponentDetectionTest, detectsNoComponentsWithParametersSet)
+{
+    auto parameters{schematicSegmentation::ComponentDetection::getParameters(common::Preset::BALANCED)};
+    parameters.mBoxMinArea = schematicSegmentation::ComponentDetection::cBoxMinArea + 1;
+    mComponentDetection->setParameters(parameters);
+
+    constexpr auto imgWidth{100};
+    constexpr auto imgHeight{100};
+    const Rectangle rect{0, 0, 10, 10};
+    // Area is the default minimum, but smaller than the minimum set
+    const auto rectArea{schematicSegmentation::ComponentDetection::cBoxMinArea};
+
+    constexpr auto componentsContours{2};
+
+    // Setup expectations and behavior
+    expectRemoveConnections();
+    expectMorphOperations();
+    onFindContours(componentsContours);
+    EXPECT_CALL(*mMockOpenCvWrapper, findContours).Times(1);
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageWidth).Times(componentsContours).WillRepeatedly(Return(imgWidth));
+    EXPECT_CALL(*mMockOpenCvWrapper, getImageHeight).Times(componentsContours).WillRepeatedly(Return(imgHeight));
+    EXPECT_CALL(*mMockOpenCvWrapper, boundingRect).Times(componentsContours).WillRepeatedly(Return(rect));
+    EXPECT_CALL(*mMockOpenCvWrapper, rectangleArea).Times(componentsContours).WillRepeatedly(Return(rectArea));
+    EXPECT_CALL(*mMockOpenCvWrapper, contains).Times(0);
+
+    // Detect components
+    ImageMat image{};
+    ASSERT_FALSE(mComponentDetection->detectComponents(image, image, mDummyConnections, false));
+    EXPECT_TRUE(mComponentDetection->getDetectedComponents().empty());
+}
+
 /**
  * @brief Tests that no components are detected when there are no intersection points with connections.
  */
@@ -288,13 +351,16 @@ TEST_F(ComponentDetectionTest, savesImagesWhenDetectsComponents)
 
     // Setup expectations and behavior
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(2 + expectedComponents);
-    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(2).WillRepeatedly(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(3).WillRepeatedly(Return(image));
     EXPECT_CALL(*mMockOpenCvWrapper, rectangle).Times(expectedComponents);
     setupDetectComponents(expectedComponents);
 
     // Detect components
     ImageMat img{};
     ASSERT_TRUE(mComponentDetection->detectComponents(img, img, mDummyConnections, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -308,13 +374,16 @@ TEST_F(ComponentDetectionTest, savesNoImagesWhenNoDetectedComponents)
 
     // Setup expectations and behavior
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(2);
-    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(2).WillRepeatedly(Return(image));
     EXPECT_CALL(*mMockOpenCvWrapper, rectangle).Times(0);
     setupDetectComponents(expectedComponents);
 
     // Detect components
     ImageMat img{};
     ASSERT_FALSE(mComponentDetection->detectComponents(img, img, mDummyConnections, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -472,3 +541,27 @@ TEST_F(ComponentDetectionTest, returnsNoBoxWhenCheckContourNoPoints)
     // A box should not be returned
     ASSERT_FALSE(mComponentDetection->checkContour(img, contour, mDummyConnections).has_value());
 }
+
+/**
+ * @brief Tests that the components are detected with the morphological closing iterations of the preset.
+ */
+TEST_F(ComponentDetectionTest, detectsComponentsWithFastPreset)
+{
+    const auto parameters{schematicSegmentation::ComponentDetection::getParameters(common::Preset::FAST)};
+    EXPECT_LT(parameters.mMorphCloseIter,
+              schematicSegmentation::ComponentDetection::getParameters(common::Preset::BALANCED).mMorphCloseIter);
+
+    mComponentDetection->setPreset(common::Preset::FAST);
+    EXPECT_EQ(mComponentDetection->getPreset(), common::Preset::FAST);
+
+    // Setup expectations and behavior
+    setupDetectComponents(1);
+    // Morphological closing only with the iterations of the preset
+    EXPECT_CALL(*mMockOpenCvWrapper,
+                morphologyEx(_, _, OpenCvWrapper::MorphTypes::MORPH_CLOSE, _, Ne(parameters.mMorphCloseIter)))
+        .Times(0);
+
+    // Detect components
+    ImageMat image{};
+    ASSERT_TRUE(mComponentDetection->detectComponents(image, image, mDummyConnections, false));
+}
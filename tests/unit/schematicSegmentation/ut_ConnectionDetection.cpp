@@ -4,6 +4,7 @@
 
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "output/ImageWriter.h"
 #include "schematicSegmentation/ConnectionDetection.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -26,9 +27,10 @@ protected:
     {
         mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
+        mImageWriter = std::make_shared<output::ImageWriter>(mMockOpenCvWrapper, mLogger);
 
         mConnectionDetection
-            = std::make_unique<schematicSegmentation::ConnectionDetection>(mMockOpenCvWrapper, mLogger);
+            = std::make_unique<schematicSegmentation::ConnectionDetection>(mMockOpenCvWrapper, mImageWriter, mLogger);
     }
 
     /**
@@ -171,6 +173,8 @@ protected:
     std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
     /** Dummy connections to be used in tests. */
     std::vector<circuit::Connection> mDummyConnections;
 };
@@ -258,6 +262,32 @@ TEST_F(ConnectionDetectionTest, detectsNoConnectionsWhenSmallArea)
     EXPECT_EQ(connectionsDetected, expectedConnections);
 }
 
+/**
+ * @brief Tests that the connections are detected with the minimum length of the parameters set.
+ */
+TEST_F(ConnectionDetectionTest, detectsNoConnectionsWithParametersSet)
+{
+    auto parameters{schematicSegmentation::ConnectionDetection::getParameters(common::Preset::BALANCED)};
+    parameters.mConnectionMinLength = schematicSegmentation::ConnectionDetection::cConnectionMinLength + 1;
+    mConnectionDetection->setParameters(parameters);
+
+    // Length is the default minimum, but smaller than the minimum set
+    constexpr auto contLength{schematicSegmentation::ConnectionDetection::cConnectionMinLength};
+    constexpr auto connectionsContours{2};
+
+    // Setup expectations and behavior
+    expectOperationsImageOnlyConnections();
+    onFindContours(connectionsContours);
+    expectRemoveBoundingBoxComponents(connectionsContours);
+    EXPECT_CALL(*mMockOpenCvWrapper, findContours).Times(2);
+    EXPECT_CALL(*mMockOpenCvWrapper, arcLength).Times(connectionsContours).WillRepeatedly(Return(contLength));
+
+    // Detect connections
+    ImageMat image{};
+    ASSERT_FALSE(mConnectionDetection->detectConnections(image, image, false));
+    EXPECT_TRUE(mConnectionDetection->getDetectedConnections().empty());
+}
+
 /**
  * @brief Tests that the image with detected connections is saved during processing, when connections are detected.
  */
@@ -274,6 +304,9 @@ TEST_F(ConnectionDetectionTest, savesImagesWhenDetectsConnections)
     // Detect connections
     ImageMat image{};
     ASSERT_TRUE(mConnectionDetection->detectConnections(image, image, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -293,6 +326,9 @@ TEST_F(ConnectionDetectionTest, savesNoImagesWhenNoDetectedConnections)
     // Detect connections
     ImageMat image{};
     ASSERT_FALSE(mConnectionDetection->detectConnections(image, image, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -399,6 +435,9 @@ TEST_F(ConnectionDetectionTest, savesImagesWhenDetectsConnectionsWhenUpdate)
     ImageMat image{};
     const std::vector<circuit::Component> components{circuit::Component{}};
     ASSERT_TRUE(mConnectionDetection->updateConnections(image, image, components, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -419,6 +458,9 @@ TEST_F(ConnectionDetectionTest, savesNoImagesWhenNoDetectedConnectionsWhenUpdate
     ImageMat image{};
     const std::vector<circuit::Component> components{circuit::Component{}};
     ASSERT_FALSE(mConnectionDetection->updateConnections(image, image, components, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -627,6 +669,9 @@ TEST_F(ConnectionDetectionTest, savesImagesWhenDetectsConnectionsAndNodes)
     ImageMat image{};
     const std::vector<circuit::Component> components{circuit::Component{}, circuit::Component{}, circuit::Component{}};
     ASSERT_TRUE(mConnectionDetection->detectNodesUpdateConnections(image, image, components, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -659,6 +704,9 @@ TEST_F(ConnectionDetectionTest, savesImagesWhenDetectsConnectionsButNoNodes)
     ImageMat image{};
     const std::vector<circuit::Component> components{circuit::Component{}, circuit::Component{}};
     ASSERT_TRUE(mConnectionDetection->detectNodesUpdateConnections(image, image, components, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -688,3 +736,27 @@ TEST_F(ConnectionDetectionTest, savesNoImagesWhenNoDetectedConnectionsAndNodes)
     const std::vector<circuit::Component> components{};
     ASSERT_FALSE(mConnectionDetection->detectNodesUpdateConnections(image, image, components, saveImages));
 }
+
+/**
+ * @brief Tests that the connections are detected with the morphological closing iterations of the preset.
+ */
+TEST_F(ConnectionDetectionTest, detectsConnectionsWithFastPreset)
+{
+    const auto parameters{schematicSegmentation::ConnectionDetection::getParameters(common::Preset::FAST)};
+    EXPECT_LT(parameters.mMorphCloseIter,
+              schematicSegmentation::ConnectionDetection::getParameters(common::Preset::BALANCED).mMorphCloseIter);
+
+    mConnectionDetection->setPreset(common::Preset::FAST);
+    EXPECT_EQ(mConnectionDetection->getPreset(), common::Preset::FAST);
+
+    // Setup expectations and behavior
+    setupDetectedConnections(1);
+    // Morphological closing only with the iterations of the preset
+    EXPECT_CALL(*mMockOpenCvWrapper,
+                morphologyEx(_, _, OpenCvWrapper::MorphTypes::MORPH_CLOSE, _, Ne(parameters.mMorphCloseIter)))
+        .Times(0);
+
+    // Detect connections
+    ImageMat image{};
+    ASSERT_TRUE(mConnectionDetection->detectConnections(image, image, false));
+}
@@ -4,6 +4,7 @@
 
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "output/ImageWriter.h"
 #include "schematicSegmentation/LabelDetection.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -26,8 +27,10 @@ protected:
     {
         mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
+        mImageWriter = std::make_shared<output::ImageWriter>(mMockOpenCvWrapper, mLogger);
 
-        mLabelDetection = std::make_unique<schematicSegmentation::LabelDetection>(mMockOpenCvWrapper, mLogger);
+        mLabelDetection
+            = std::make_unique<schematicSegmentation::LabelDetection>(mMockOpenCvWrapper, mImageWriter, mLogger);
 
         setupDummyComponent();
         setupDummyConnection();
@@ -170,6 +173,8 @@ protected:
     std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
     /** Dummy components to be used in tests. */
     std::vector<circuit::Component> mDummyComponents;
     /** Dummy connections to be used in tests. */
@@ -214,6 +219,30 @@ TEST_F(LabelDetectionTest, detectsMultipleLabels)
     EXPECT_EQ(labelsDetected, expectedLabels);
 }
 
+/**
+ * @brief Tests that the labels detected in a previous image are discarded.
+ */
+TEST_F(LabelDetectionTest, detectsLabelsOfLastImageOnly)
+{
+    constexpr auto expectedLabels{1};
+
+    // Detect labels in a previous image
+    ImageMat image{};
+    setupDetectLabels(expectedLabels);
+    ASSERT_TRUE(mLabelDetection->detectLabels(image, image, mDummyComponents, mDummyConnections, false));
+    Mock::VerifyAndClearExpectations(mMockOpenCvWrapper.get());
+
+    // Setup expectations and behavior
+    setupDetectLabels(expectedLabels);
+
+    // Detect labels
+    ASSERT_TRUE(mLabelDetection->detectLabels(image, image, mDummyComponents, mDummyConnections, false));
+
+    // Number of labels detected
+    const auto labelsDetected{mLabelDetection->getDetectedLabels().size()};
+    EXPECT_EQ(labelsDetected, expectedLabels);
+}
+
 /**
  * @brief Tests that no labels are detected when there are no labels contours found.
  */
@@ -277,13 +306,16 @@ TEST_F(LabelDetectionTest, savesImagesWhenDetectsLabels)
 
     // Setup expectations and behavior
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(3 + expectedLabels);
-    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(2).WillRepeatedly(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(4).WillRepeatedly(Return(image));
     EXPECT_CALL(*mMockOpenCvWrapper, rectangle).Times(1 + expectedLabels);
     setupDetectLabels(expectedLabels);
 
     // Detect labels
     ImageMat img{};
     ASSERT_TRUE(mLabelDetection->detectLabels(img, img, mDummyComponents, mDummyConnections, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -297,13 +329,16 @@ TEST_F(LabelDetectionTest, savesNoImagesWhenNoDetectedLabels)
 
     // Setup expectations and behavior
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(3);
-    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(1).WillOnce(Return(image));
+    EXPECT_CALL(*mMockOpenCvWrapper, cloneImage).Times(3).WillRepeatedly(Return(image));
     EXPECT_CALL(*mMockOpenCvWrapper, rectangle).Times(1);
     setupDetectLabels(expectedLabels);
 
     // Detect components
     ImageMat img{};
     ASSERT_FALSE(mLabelDetection->detectLabels(img, img, mDummyComponents, mDummyConnections, saveImages));
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -381,3 +416,27 @@ TEST_F(LabelDetectionTest, returnsNoBoxWhenCheckContourSmallArea)
     // A box should not be returned
     ASSERT_FALSE(mLabelDetection->checkContour(img, contour).has_value());
 }
+
+/**
+ * @brief Tests that the labels are detected with the morphological closing iterations of the preset.
+ */
+TEST_F(LabelDetectionTest, detectsLabelsWithFastPreset)
+{
+    const auto parameters{schematicSegmentation::LabelDetection::getParameters(common::Preset::FAST)};
+    EXPECT_LT(parameters.mMorphCloseIter,
+              schematicSegmentation::LabelDetection::getParameters(common::Preset::BALANCED).mMorphCloseIter);
+
+    mLabelDetection->setPreset(common::Preset::FAST);
+    EXPECT_EQ(mLabelDetection->getPreset(), common::Preset::FAST);
+
+    // Setup expectations and behavior
+    setupDetectLabels(1);
+    // Morphological closing only with the iterations of the preset
+    EXPECT_CALL(*mMockOpenCvWrapper,
+                morphologyEx(_, _, OpenCvWrapper::MorphTypes::MORPH_CLOSE, _, Ne(parameters.mMorphCloseIter)))
+        .Times(0);
+
+    // Detect labels
+    ImageMat image{};
+    ASSERT_TRUE(mLabelDetection->detectLabels(image, image, mDummyComponents, mDummyConnections, false));
+}
@@ -4,10 +4,12 @@
 
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "output/ImageWriter.h"
 #include "schematicSegmentation/RoiSegmentation.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
 
 using namespace testing;
 using namespace circuitSegmentation;
@@ -26,8 +28,10 @@ protected:
     {
         mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
+        mImageWriter = std::make_shared<output::ImageWriter>(mMockOpenCvWrapper, mLogger);
 
-        mRoiSegmentation = std::make_unique<schematicSegmentation::RoiSegmentation>(mMockOpenCvWrapper, mLogger);
+        mRoiSegmentation
+            = std::make_unique<schematicSegmentation::RoiSegmentation>(mMockOpenCvWrapper, mImageWriter, mLogger);
     }
 
     /**
@@ -133,6 +137,8 @@ protected:
     std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
     /** Dummy components to be used in tests. */
     std::vector<circuit::Component> mDummyComponents;
     /** Dummy connections to be used in tests. */
@@ -162,7 +168,7 @@ TEST_F(RoiSegmentationTest, reportsSuccessOnGenerationRoiComponents)
     const std::string expectFilePath2{"roi_component_" + mDummyComponents.at(1).mId + ".png"};
 
     // Setup expectations and behavior
-    EXPECT_CALL(*mMockOpenCvWrapper, cropImage).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(2).WillRepeatedly(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePath1, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePath2, _)).Times(1).WillOnce(Return(true));
 
@@ -193,7 +199,7 @@ TEST_F(RoiSegmentationTest, reportsUnsuccessOnGenerationRoiComponentsWhenCrop)
     const std::string expectFilePath2{"roi_component_" + mDummyComponents.at(1).mId + ".png"};
 
     // Setup expectations and behavior
-    EXPECT_CALL(*mMockOpenCvWrapper, cropImage).Times(2).WillOnce(Return(false)).WillOnce(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(2).WillOnce(Return(false)).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePath1, _)).Times(0);
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePath2, _)).Times(1).WillOnce(Return(true));
 
@@ -226,7 +232,7 @@ TEST_F(RoiSegmentationTest, reportsUnsuccessOnGenerationRoiComponentsWhenWrite)
     const std::string expectFilePath3{"roi_component_" + mDummyComponents.at(2).mId + ".png"};
 
     // Setup expectations and behavior
-    EXPECT_CALL(*mMockOpenCvWrapper, cropImage).Times(3).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(3).WillRepeatedly(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePath1, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePath2, _)).Times(1).WillOnce(Return(false));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePath3, _)).Times(1).WillOnce(Return(true));
@@ -236,6 +242,45 @@ TEST_F(RoiSegmentationTest, reportsUnsuccessOnGenerationRoiComponentsWhenWrite)
     ASSERT_FALSE(mRoiSegmentation->generateRoiComponents(img, mDummyComponents));
 }
 
+/**
+ * @brief Tests that images with ROI given are cropped again from the initial image.
+ *
+ * Scenario:
+ * - 2 images with ROI are given, with the encoded image of a prior result
+ * - Image is successfully cropped and written for both ROI
+ *
+ * Expected:
+ * - Generation reports success
+ * - Files with images have the names given
+ * - Images with ROI are replaced by the ones given, without the prior encoded image
+ */
+TEST_F(RoiSegmentationTest, generatesRoiImagesGiven)
+{
+    // Setup images with ROI
+    std::vector<schematicSegmentation::RoiImage> roiImages(2);
+    roiImages.at(0).mRoi = Rectangle{0, 0, 10, 10};
+    roiImages.at(0).mFileName = "roi_component_1.png";
+    roiImages.at(0).mEncodedImage = {1, 2, 3};
+    roiImages.at(1).mRoi = Rectangle{5, 5, 10, 10};
+    roiImages.at(1).mFileName = "roi_component_2.png";
+
+    // Setup expectations and behavior
+    mRoiSegmentation->setWriteImages(true);
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage("roi_component_1.png", _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage("roi_component_2.png", _)).Times(1).WillOnce(Return(true));
+
+    // Generate images with ROI given
+    ImageMat img{};
+    ASSERT_TRUE(mRoiSegmentation->generateRoiImages(img, roiImages));
+
+    const auto& generated{mRoiSegmentation->getRoiImages()};
+    ASSERT_EQ(generated.size(), 2);
+    EXPECT_EQ(generated.at(0).mFileName, "roi_component_1.png");
+    EXPECT_TRUE(generated.at(0).mEncodedImage.empty());
+    EXPECT_EQ(generated.at(1).mFileName, "roi_component_2.png");
+}
+
 /**
  * @brief Tests that generation of images with ROI reports success when they are successfully generated for all
  * labels.
@@ -267,7 +312,7 @@ TEST_F(RoiSegmentationTest, reportsSuccessOnGenerationRoiLabels)
     const std::string expectFilePathNode2{"roi_label_" + mDummyNodes.at(1).mId + "_1.png"};
 
     // Setup expectations and behavior
-    EXPECT_CALL(*mMockOpenCvWrapper, cropImage).Times(6).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(6).WillRepeatedly(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathComponent1, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathComponent2, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathConnection1, _)).Times(1).WillOnce(Return(true));
@@ -308,7 +353,7 @@ TEST_F(RoiSegmentationTest, reportsSuccessOnGenerationRoiLabelsMultiple)
     const std::string expectFilePathNodeLabel2{"roi_label_" + mDummyNodes.back().mId + "_2.png"};
 
     // Setup expectations and behavior
-    EXPECT_CALL(*mMockOpenCvWrapper, cropImage).Times(6).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(6).WillRepeatedly(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathComponentLabel1, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathComponentLabel2, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathConnectionLabel1, _)).Times(1).WillOnce(Return(true));
@@ -353,7 +398,7 @@ TEST_F(RoiSegmentationTest, reportsUnsuccessOnGenerationRoiLabelsWhenCrop)
     const std::string expectFilePathNode2{"roi_label_" + mDummyNodes.at(1).mId + "_1.png"};
 
     // Setup expectations and behavior
-    EXPECT_CALL(*mMockOpenCvWrapper, cropImage)
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView)
         .Times(6)
         .WillOnce(Return(true))
         .WillOnce(Return(false))
@@ -402,7 +447,7 @@ TEST_F(RoiSegmentationTest, reportsUnsuccessOnGenerationRoiLabelsWhenWrite)
     const std::string expectFilePathNode2{"roi_label_" + mDummyNodes.at(1).mId + "_1.png"};
 
     // Setup expectations and behavior
-    EXPECT_CALL(*mMockOpenCvWrapper, cropImage).Times(6).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(6).WillRepeatedly(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathComponent1, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathComponent2, _)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mMockOpenCvWrapper, writeImage(expectFilePathConnection1, _)).Times(1).WillOnce(Return(true));
@@ -414,3 +459,50 @@ TEST_F(RoiSegmentationTest, reportsUnsuccessOnGenerationRoiLabelsWhenWrite)
     ImageMat img{};
     ASSERT_FALSE(mRoiSegmentation->generateRoiLabels(img, mDummyComponents, mDummyConnections, mDummyNodes));
 }
+
+/**
+ * @brief Tests that images with ROI are encoded to memory without writing files, when enabled.
+ *
+ * Scenario:
+ * - 1 component with 1 label is passed to generate images with ROI
+ * - Writing of files is disabled and encoding to memory is enabled
+ *
+ * Expected:
+ * - No files are written
+ * - Images with ROI have the ROI, the file name and the encoded image
+ */
+TEST_F(RoiSegmentationTest, encodesRoiImagesWithoutWriting)
+{
+    // Setup components
+    setupDummyComponent(1);
+    const std::vector<unsigned char> encodedImage{0x89, 'P', 'N', 'G'};
+
+    // Setup expectations and behavior
+    EXPECT_CALL(*mMockOpenCvWrapper, cropImageView).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mMockOpenCvWrapper, writeImage).Times(0);
+    EXPECT_CALL(*mMockOpenCvWrapper, encodeImage)
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<2>(encodedImage), Return(true)));
+
+    // Generate ROI for components and labels
+    mRoiSegmentation->setWriteImages(false);
+    mRoiSegmentation->setEncodeImages(true);
+    ImageMat img{};
+    ASSERT_TRUE(mRoiSegmentation->generateRoiComponents(img, mDummyComponents));
+    ASSERT_TRUE(mRoiSegmentation->generateRoiLabels(img, mDummyComponents, mDummyConnections, mDummyNodes));
+
+    // Images with ROI
+    const auto& roiImages{mRoiSegmentation->getRoiImages()};
+    ASSERT_EQ(roiImages.size(), 2U);
+    EXPECT_EQ(roiImages.at(0).mKind, schematicSegmentation::RoiImage::Kind::COMPONENT);
+    EXPECT_EQ(roiImages.at(0).mFileName, "roi_component_" + mDummyComponents.at(0).mId + ".png");
+    EXPECT_EQ(roiImages.at(0).mRoi, mDummyComponents.at(0).mBoundingBox);
+    EXPECT_EQ(roiImages.at(0).mEncodedImage, encodedImage);
+    EXPECT_EQ(roiImages.at(1).mKind, schematicSegmentation::RoiImage::Kind::LABEL);
+    EXPECT_EQ(roiImages.at(1).mIndex, 1U);
+    EXPECT_EQ(roiImages.at(1).mEncodedImage, encodedImage);
+
+    // Clear
+    mRoiSegmentation->clearRoiImages();
+    EXPECT_TRUE(mRoiSegmentation->getRoiImages().empty());
+}
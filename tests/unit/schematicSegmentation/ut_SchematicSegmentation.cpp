@@ -4,6 +4,7 @@
 
 #include "logging/Logger.h"
 #include "mocks/computerVision/MockOpenCvWrapper.h"
+#include "output/ImageWriter.h"
 #include "schematicSegmentation/SchematicSegmentation.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -26,9 +27,10 @@ protected:
     {
         mMockOpenCvWrapper = std::make_shared<NiceMock<MockOpenCvWrapper>>();
         mLogger = std::make_shared<logging::Logger>(std::cout);
+        mImageWriter = std::make_shared<output::ImageWriter>(mMockOpenCvWrapper, mLogger);
 
         mSchematicSegmentation
-            = std::make_unique<schematicSegmentation::SchematicSegmentation>(mMockOpenCvWrapper, mLogger);
+            = std::make_unique<schematicSegmentation::SchematicSegmentation>(mMockOpenCvWrapper, mImageWriter, mLogger);
     }
 
     /**
@@ -126,6 +128,38 @@ protected:
         });
     }
 
+    /**
+     * @brief Sets the elements of a circuit with a component connected to a node, with new random IDs.
+     *
+     * @param xComponent X coordinate for component box.
+     */
+    void setConnectedCircuit(const int& xComponent)
+    {
+        circuit::Component component{};
+        component.mType = "R";
+        component.mBoundingBox = Rectangle{xComponent, 40, cDimension, cDimension};
+
+        circuit::Connection connection{};
+        connection.mWire = circuit::Wire{{xComponent + cDimension, 45}, {100, 45}};
+
+        circuit::Node node{};
+        node.mPosition.mX = 100;
+        node.mPosition.mY = 45;
+
+        circuit::Port port{};
+        port.mOwnerId = component.mId;
+        port.mConnectionId = connection.mId;
+        port.mPosition.mX = 1;
+        port.mPosition.mY = 0.5;
+        component.mPorts.push_back(port);
+
+        connection.mStartId = port.mId;
+        connection.mEndId = node.mId;
+        node.mConnectionIds.push_back(connection.mId);
+
+        mSchematicSegmentation->setElements({component}, {connection}, {node});
+    }
+
 protected:
     /** Dimension for width and height for boxes of components to be used in tests. */
     static constexpr auto cDimension{10};
@@ -136,6 +170,8 @@ protected:
     std::shared_ptr<NiceMock<MockOpenCvWrapper>> mMockOpenCvWrapper;
     /** Logger. */
     std::shared_ptr<logging::Logger> mLogger;
+    /** Image writer. */
+    std::shared_ptr<output::ImageWriter> mImageWriter;
     /** Dummy components to be used in tests. */
     std::vector<circuit::Component> mDummyComponents;
     /** Dummy connections to be used in tests. */
@@ -409,6 +445,9 @@ TEST_F(SchematicSegmentationTest, savesImagesWhenDetectsComponentConnectionPoint
     // Detect component connection points
     ImageMat img{};
     mSchematicSegmentation->detectComponentConnections(img, img, mDummyComponents, mDummyConnections, {}, saveImages);
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -581,6 +620,24 @@ TEST_F(SchematicSegmentationTest, updatesDetectedComponentsEmpty)
     EXPECT_EQ(detectedComponents.size(), 0);
 }
 
+/**
+ * @brief Tests that the elements set (e.g. from a checkpoint) replace the elements segmented.
+ */
+TEST_F(SchematicSegmentationTest, setsElements)
+{
+    setupDummyComponent(5, 5);
+    setupDummyConnection(10, 10);
+    std::vector<circuit::Node> nodes(2);
+
+    // Set elements
+    mSchematicSegmentation->setElements(mDummyComponents, mDummyConnections, nodes);
+
+    EXPECT_EQ(mSchematicSegmentation->getComponents().size(), 1);
+    EXPECT_EQ(mSchematicSegmentation->getConnections().size(), 1);
+    EXPECT_EQ(mSchematicSegmentation->getNodes().size(), 2);
+    EXPECT_TRUE(mSchematicSegmentation->getLabels().empty());
+}
+
 /**
  * @brief Tests that a label is associated to the closest element.
  *
@@ -945,6 +1002,9 @@ TEST_F(SchematicSegmentationTest, savesImagesWhenBoxesWhileAssociatingLabels)
 
     // Associate labels
     mSchematicSegmentation->associateLabels(img, img, mDummyLabels, saveImages);
+
+    // Wait for the images to be written
+    mImageWriter->flush();
 }
 
 /**
@@ -1069,3 +1129,116 @@ TEST_F(SchematicSegmentationTest, calculatesPortPositionMiddle)
     EXPECT_DOUBLE_EQ(positionBottom25Perc.mX, expectedBottom25PercX);
     EXPECT_DOUBLE_EQ(positionBottom25Perc.mY, expectedBottom25PercY);
 }
+
+/**
+ * @brief Tests that the deterministic IDs are the same for the same circuit, whatever its random IDs.
+ *
+ * Scenario:
+ * - 1 component, A, with a port connected to connection B
+ * - 1 connection, B, from the port of component A to node C
+ * - 1 node, C
+ * - The circuit is segmented twice, with different random IDs
+ *
+ * Expected:
+ * - The IDs of the elements are the same in both segmentations
+ */
+TEST_F(SchematicSegmentationTest, assignsSameDeterministicIds)
+{
+    constexpr auto imgWidth{200};
+    constexpr auto imgHeight{100};
+    constexpr auto xComponent{40};
+
+    setConnectedCircuit(xComponent);
+    mSchematicSegmentation->assignDeterministicIds(imgWidth, imgHeight);
+    const auto firstComponents{mSchematicSegmentation->getComponents()};
+    const auto firstConnections{mSchematicSegmentation->getConnections()};
+    const auto firstNodes{mSchematicSegmentation->getNodes()};
+
+    setConnectedCircuit(xComponent);
+    mSchematicSegmentation->assignDeterministicIds(imgWidth, imgHeight);
+    const auto secondComponents{mSchematicSegmentation->getComponents()};
+    const auto secondConnections{mSchematicSegmentation->getConnections()};
+    const auto secondNodes{mSchematicSegmentation->getNodes()};
+
+    EXPECT_EQ(firstComponents.back().mId, secondComponents.back().mId);
+    EXPECT_EQ(firstComponents.back().mLabel.mId, secondComponents.back().mLabel.mId);
+    EXPECT_EQ(firstComponents.back().mPorts.back().mId, secondComponents.back().mPorts.back().mId);
+    EXPECT_EQ(firstConnections.back().mId, secondConnections.back().mId);
+    EXPECT_EQ(firstConnections.back().mLabel.mId, secondConnections.back().mLabel.mId);
+    EXPECT_EQ(firstNodes.back().mId, secondNodes.back().mId);
+    EXPECT_EQ(firstNodes.back().mLabel.mId, secondNodes.back().mLabel.mId);
+}
+
+/**
+ * @brief Tests that the references between the elements are updated with the deterministic IDs.
+ *
+ * Scenario:
+ * - 1 component, A, with a port connected to connection B
+ * - 1 connection, B, from the port of component A to node C
+ * - 1 node, C
+ *
+ * Expected:
+ * - Port of component A has the ID of component A as owner and the ID of connection B as connection
+ * - Connection B starts at the port of component A and ends at node C
+ * - Node C has the ID of connection B
+ * - The labels of the elements have the IDs of the elements as owner
+ */
+TEST_F(SchematicSegmentationTest, updatesReferencesWithDeterministicIds)
+{
+    setConnectedCircuit(40);
+    mSchematicSegmentation->assignDeterministicIds(200, 100);
+
+    const auto component{mSchematicSegmentation->getComponents().back()};
+    const auto connection{mSchematicSegmentation->getConnections().back()};
+    const auto node{mSchematicSegmentation->getNodes().back()};
+
+    EXPECT_EQ(component.mPorts.back().mOwnerId, component.mId);
+    EXPECT_EQ(component.mPorts.back().mConnectionId, connection.mId);
+    EXPECT_EQ(connection.mStartId, component.mPorts.back().mId);
+    EXPECT_EQ(connection.mEndId, node.mId);
+    EXPECT_EQ(node.mConnectionIds.size(), 1);
+    EXPECT_EQ(node.mConnectionIds.back(), connection.mId);
+    EXPECT_EQ(component.mLabel.mOwnerId, component.mId);
+    EXPECT_EQ(connection.mLabel.mOwnerId, connection.mId);
+    EXPECT_EQ(node.mLabel.mOwnerId, node.mId);
+}
+
+/**
+ * @brief Tests that a small shift of an element keeps its deterministic ID, and that the image dimensions change it.
+ *
+ * Expected:
+ * - Component shifted by 1 pixel keeps its ID
+ * - Component in an image with other dimensions gets another ID
+ */
+TEST_F(SchematicSegmentationTest, keepsDeterministicIdsOnSmallShift)
+{
+    setConnectedCircuit(40);
+    mSchematicSegmentation->assignDeterministicIds(200, 100);
+    const auto componentId{mSchematicSegmentation->getComponents().back().mId};
+
+    setConnectedCircuit(41);
+    mSchematicSegmentation->assignDeterministicIds(200, 100);
+    EXPECT_EQ(mSchematicSegmentation->getComponents().back().mId, componentId);
+
+    setConnectedCircuit(40);
+    mSchematicSegmentation->assignDeterministicIds(300, 100);
+    EXPECT_NE(mSchematicSegmentation->getComponents().back().mId, componentId);
+}
+
+/**
+ * @brief Tests that elements with the same role and geometry get different deterministic IDs.
+ *
+ * Expected:
+ * - Two nodes at the same position get different IDs
+ */
+TEST_F(SchematicSegmentationTest, assignsUniqueDeterministicIds)
+{
+    std::vector<circuit::Node> nodes(2);
+    mSchematicSegmentation->setElements({}, {}, nodes);
+
+    mSchematicSegmentation->assignDeterministicIds(200, 100);
+
+    const auto& deterministicNodes{mSchematicSegmentation->getNodes()};
+    EXPECT_NE(deterministicNodes.at(0).mId, deterministicNodes.at(1).mId);
+    EXPECT_NE(deterministicNodes.at(0).mLabel.mId, deterministicNodes.at(1).mLabel.mId);
+}
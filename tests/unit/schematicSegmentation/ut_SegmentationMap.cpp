@@ -5,6 +5,7 @@
 #include "logging/Logger.h"
 #include "schematicSegmentation/SegmentationMap.h"
 #include "schematicSegmentation/SegmentationUtils.h"
+#include <filesystem>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <memory>
@@ -368,3 +369,31 @@ TEST_F(SegmentationMapTest, writesEmptyMap)
     // Write map
     ASSERT_TRUE(mSegmentationMap->writeSegmentationMapJsonFile());
 }
+
+/**
+ * @brief Tests that the segmentation map is written to the output directory.
+ */
+TEST_F(SegmentationMapTest, writesMapToOutputDirectory)
+{
+    const auto outputDirectory{std::filesystem::temp_directory_path() / "cs_ut_segmentation_map"};
+    std::filesystem::create_directories(outputDirectory);
+
+    // Write map
+    mSegmentationMap->setOutputDirectory(outputDirectory.string());
+    EXPECT_EQ(mSegmentationMap->getOutputDirectory(), outputDirectory.string());
+    ASSERT_TRUE(mSegmentationMap->writeSegmentationMapJsonFile());
+
+    EXPECT_TRUE(std::filesystem::exists(outputDirectory / mSegmentationMap->cSegmentationMapFile));
+
+    std::filesystem::remove_all(outputDirectory);
+}
+
+/**
+ * @brief Tests that the segmentation map is not written when the output directory does not exist.
+ */
+TEST_F(SegmentationMapTest, writesMapToNonExistentOutputDirectory)
+{
+    // Write map
+    mSegmentationMap->setOutputDirectory("non_existent_directory/");
+    EXPECT_FALSE(mSegmentationMap->writeSegmentationMapJsonFile());
+}